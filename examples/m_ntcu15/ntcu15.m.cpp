@@ -0,0 +1,316 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntccfg_bind.h>
+#include <ntcf_system.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslmt_semaphore.h>
+#include <bsls_atomic.h>
+#include <bsls_timeutil.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
+using namespace BloombergLP;
+
+namespace example {
+
+//
+// Measuring the Cost of Connection Churn
+//
+// This example measures the rate at which an interface can connect, accept,
+// and close TCP/IPv4 connections over the loopback device, and the number of
+// allocations from the default allocator made per connection, both with and
+// without recycling closed sockets (see the 'socketRecycling' field of
+// 'ntca::InterfaceConfig'). Optionally, each socket may also be configured to
+// measure its own metrics, to assess the cost of per-socket metrics on socket
+// creation.
+//
+
+// Provide an allocator that counts the number of allocations it makes.
+class CountingAllocator : public bslma::Allocator
+{
+    bsls::AtomicUint64 d_numAllocations;
+    bslma::Allocator*  d_allocator_p;
+
+  public:
+    // Create a new counting allocator that supplies memory from the specified
+    // 'basicAllocator'.
+    explicit CountingAllocator(bslma::Allocator* basicAllocator)
+    : d_numAllocations(0)
+    , d_allocator_p(basicAllocator)
+    {
+    }
+
+    // Return a newly allocated block of at least the specified 'size'.
+    void* allocate(size_type size) BSLS_KEYWORD_OVERRIDE
+    {
+        ++d_numAllocations;
+        return d_allocator_p->allocate(size);
+    }
+
+    // Return the block at the specified 'address' to this allocator.
+    void deallocate(void* address) BSLS_KEYWORD_OVERRIDE
+    {
+        d_allocator_p->deallocate(address);
+    }
+
+    // Return the number of allocations made by this allocator.
+    bsl::uint64_t numAllocations() const
+    {
+        return d_numAllocations.load();
+    }
+};
+
+void processConnect(bslmt::Semaphore*                       semaphore,
+                    const bsl::shared_ptr<ntci::Connector>& connector,
+                    const ntca::ConnectEvent&               event)
+{
+    NTCCFG_WARNING_UNUSED(connector);
+
+    BSLS_ASSERT_OPT(event.type() == ntca::ConnectEventType::e_COMPLETE);
+    semaphore->post();
+}
+
+void processAccept(bslmt::Semaphore*                          semaphore,
+                   bsl::shared_ptr<ntci::StreamSocket>*       result,
+                   const bsl::shared_ptr<ntci::Acceptor>&     acceptor,
+                   const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+                   const ntca::AcceptEvent&                   event)
+{
+    NTCCFG_WARNING_UNUSED(acceptor);
+
+    BSLS_ASSERT_OPT(event.type() == ntca::AcceptEventType::e_COMPLETE);
+    *result = streamSocket;
+    semaphore->post();
+}
+
+void processClose(bslmt::Semaphore* semaphore)
+{
+    semaphore->post();
+}
+
+// Connect, accept, and close the specified 'numConnections' through an
+// interface that recycles closed sockets according to the specified
+// 'recycling' flag and measures per-socket metrics according to the specified
+// 'metrics' flag, and print the results. Allocate memory from the specified
+// 'allocator'.
+void execute(bsl::size_t        numConnections,
+             bool               recycling,
+             bool               metrics,
+             CountingAllocator* allocator)
+{
+    ntsa::Error      error;
+    bslmt::Semaphore semaphore;
+
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setThreadName("churn");
+    interfaceConfig.setMinThreads(1);
+    interfaceConfig.setMaxThreads(1);
+    interfaceConfig.setSocketRecycling(recycling);
+    interfaceConfig.setSocketMetrics(metrics);
+    interfaceConfig.setSocketMetricsPerHandle(metrics);
+
+    bsl::shared_ptr<ntci::Interface> interface =
+        ntcf::System::createInterface(interfaceConfig);
+
+    error = interface->start();
+    BSLS_ASSERT_OPT(!error);
+
+    ntca::ListenerSocketOptions listenerSocketOptions;
+    listenerSocketOptions.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+    listenerSocketOptions.setSourceEndpoint(
+        ntsa::Endpoint(ntsa::Ipv4Address::loopback(), 0));
+
+    bsl::shared_ptr<ntci::ListenerSocket> listenerSocket =
+        interface->createListenerSocket(listenerSocketOptions);
+
+    error = listenerSocket->open();
+    BSLS_ASSERT_OPT(!error);
+
+    error = listenerSocket->listen();
+    BSLS_ASSERT_OPT(!error);
+
+    ntca::StreamSocketOptions streamSocketOptions;
+    streamSocketOptions.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+
+    const bsl::uint64_t numAllocationsBefore = allocator->numAllocations();
+    const bsls::Types::Int64 startTime = bsls::TimeUtil::getTimer();
+
+    for (bsl::size_t i = 0; i < numConnections; ++i) {
+        bsl::shared_ptr<ntci::StreamSocket> clientSocket =
+            interface->createStreamSocket(streamSocketOptions);
+
+        error = clientSocket->connect(
+            listenerSocket->sourceEndpoint(),
+            ntca::ConnectOptions(),
+            clientSocket->createConnectCallback(
+                NTCCFG_BIND(&processConnect,
+                            &semaphore,
+                            NTCCFG_BIND_PLACEHOLDER_1,
+                            NTCCFG_BIND_PLACEHOLDER_2)));
+        BSLS_ASSERT_OPT(!error);
+
+        semaphore.wait();
+
+        bsl::shared_ptr<ntci::StreamSocket> serverSocket;
+
+        error = listenerSocket->accept(
+            ntca::AcceptOptions(),
+            listenerSocket->createAcceptCallback(
+                NTCCFG_BIND(&processAccept,
+                            &semaphore,
+                            &serverSocket,
+                            NTCCFG_BIND_PLACEHOLDER_1,
+                            NTCCFG_BIND_PLACEHOLDER_2,
+                            NTCCFG_BIND_PLACEHOLDER_3)));
+        BSLS_ASSERT_OPT(!error || error == ntsa::Error::e_WOULD_BLOCK);
+
+        semaphore.wait();
+
+        clientSocket->close(clientSocket->createCloseCallback(
+            NTCCFG_BIND(&processClose, &semaphore)));
+
+        semaphore.wait();
+
+        serverSocket->close(serverSocket->createCloseCallback(
+            NTCCFG_BIND(&processClose, &semaphore)));
+
+        semaphore.wait();
+    }
+
+    const bsls::Types::Int64 stopTime = bsls::TimeUtil::getTimer();
+    const bsl::uint64_t numAllocationsAfter = allocator->numAllocations();
+
+    listenerSocket->close(listenerSocket->createCloseCallback(
+        NTCCFG_BIND(&processClose, &semaphore)));
+
+    semaphore.wait();
+
+    interface->shutdown();
+    interface->linger();
+
+    const double elapsedSeconds =
+        static_cast<double>(stopTime - startTime) / 1000000000.0;
+
+    bsl::cout << "Recycling: " << (recycling ? "enabled " : "disabled")
+              << " Metrics: " << (metrics ? "enabled " : "disabled")
+              << " Connections: " << numConnections
+              << " Rate: " << (numConnections / elapsedSeconds) << "/s"
+              << " Allocations per connection: "
+              << (static_cast<double>(numAllocationsAfter -
+                                      numAllocationsBefore) /
+                  numConnections)
+              << bsl::endl;
+}
+
+}  // close namespace example
+
+void help()
+{
+    bsl::cout << "usage: ntcu15.tsk [-v <level>] [-n <connections>] [-m]"
+              << bsl::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int         verbosity      = 0;
+    bsl::size_t numConnections = 1000;
+    bool        metrics        = false;
+    {
+        int i = 1;
+        while (i < argc) {
+            if ((0 == std::strcmp(argv[i], "-?")) ||
+                (0 == std::strcmp(argv[i], "--help")))
+            {
+                help();
+                return 0;
+            }
+
+            if (0 == std::strcmp(argv[i], "-v") ||
+                0 == std::strcmp(argv[i], "--verbosity"))
+            {
+                ++i;
+                if (i >= argc) {
+                    help();
+                    return 1;
+                }
+                verbosity = std::atoi(argv[i]);
+                ++i;
+                continue;
+            }
+
+            if (0 == std::strcmp(argv[i], "-n") ||
+                0 == std::strcmp(argv[i], "--connections"))
+            {
+                ++i;
+                if (i >= argc) {
+                    help();
+                    return 1;
+                }
+                numConnections = static_cast<bsl::size_t>(std::atoi(argv[i]));
+                ++i;
+                continue;
+            }
+
+            if (0 == std::strcmp(argv[i], "-m") ||
+                0 == std::strcmp(argv[i], "--metrics"))
+            {
+                metrics = true;
+                ++i;
+                continue;
+            }
+
+            bsl::cerr << "Invalid option: " << argv[i] << bsl::endl;
+            return 1;
+        }
+    }
+
+    switch (verbosity) {
+    case 0:
+        break;
+    case 1:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_ERROR);
+        break;
+    case 2:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_WARN);
+        break;
+    case 3:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_INFO);
+        break;
+    case 4:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_DEBUG);
+        break;
+    default:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_TRACE);
+        break;
+    }
+
+    ntcf::System::initialize();
+    ntcf::System::ignore(ntscfg::Signal::e_PIPE);
+
+    example::CountingAllocator defaultAllocator(
+        &bslma::NewDeleteAllocator::singleton());
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&defaultAllocator);
+    {
+        example::execute(numConnections, false, metrics, &defaultAllocator);
+        example::execute(numConnections, true, metrics, &defaultAllocator);
+    }
+
+    return 0;
+}
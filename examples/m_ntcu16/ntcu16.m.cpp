@@ -0,0 +1,456 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcf_system.h>
+#include <ntci_monitorable.h>
+#include <ntcs_openmetrics.h>
+#include <bdld_datum.h>
+#include <bdld_manageddatum.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bsls_timeutil.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+
+namespace example {
+
+//
+// Measuring the Cost of Exposing Statistics in the OpenMetrics Format
+//
+// This example measures the time to publish the statistics of a large number
+// of monitorable objects (by default, 100,000, each reporting the statistics
+// of a socket) to an 'ntcs::OpenMetricsPublisher' and to assemble its
+// snapshot, and the time to retrieve that snapshot, as an HTTP endpoint does
+// for each scrape. For comparison, it also measures the time to format the
+// same statistics from scratch during each collection, resolving the name,
+// labels, and type of each statistic every time.
+//
+
+// Describe a statistic measured by each object in this example.
+struct StatisticMetadata {
+    const char*                      prefix;
+    const char*                      name;
+    const char*                      description;
+    ntci::Monitorable::StatisticType type;
+};
+
+// clang-format off
+const StatisticMetadata STATISTICS[] = {
+    { "socket", "bytesSent",          "Bytes sent",
+      ntci::Monitorable::e_SUM },
+    { "socket", "bytesReceived",      "Bytes received",
+      ntci::Monitorable::e_SUM },
+    { "socket", "writeQueueSize",     "Write queue size",
+      ntci::Monitorable::e_GAUGE },
+    { "socket", "readQueueSize",      "Read queue size",
+      ntci::Monitorable::e_GAUGE },
+    { "socket", "txDelay.count",      "Transmit delay count",
+      ntci::Monitorable::e_SUM },
+    { "socket", "txDelay.total",      "Transmit delay total",
+      ntci::Monitorable::e_SUM },
+    { "socket", "txDelay.min",        "Transmit delay minimum",
+      ntci::Monitorable::e_MINIMUM },
+    { "socket", "txDelay.avg",        "Transmit delay average",
+      ntci::Monitorable::e_AVERAGE },
+    { "socket", "txDelay.max",        "Transmit delay maximum",
+      ntci::Monitorable::e_MAXIMUM },
+    { "socket", "txDelay.p50",        "Transmit delay",
+      ntci::Monitorable::e_PERCENTILE },
+    { "socket", "txDelay.p90",        "Transmit delay",
+      ntci::Monitorable::e_PERCENTILE },
+    { "socket", "txDelay.p99",        "Transmit delay",
+      ntci::Monitorable::e_PERCENTILE },
+    { "socket", "txDelay.p999",       "Transmit delay",
+      ntci::Monitorable::e_PERCENTILE },
+    { "socket", "rxDelay.count",      "Receive delay count",
+      ntci::Monitorable::e_SUM },
+    { "socket", "rxDelay.total",      "Receive delay total",
+      ntci::Monitorable::e_SUM },
+    { "socket", "rxDelay.avg",        "Receive delay average",
+      ntci::Monitorable::e_AVERAGE }
+};
+// clang-format on
+
+const int NUM_STATISTICS =
+    static_cast<int>(sizeof STATISTICS / sizeof STATISTICS[0]);
+
+// Provide a monitorable object reporting synthetic statistics.
+class Object : public ntci::Monitorable
+{
+    bsl::string d_name;
+    unsigned    d_seed;
+
+  private:
+    Object(const Object&) BSLS_KEYWORD_DELETED;
+    Object& operator=(const Object&) BSLS_KEYWORD_DELETED;
+
+  public:
+    // Create a new object having the specified 'name'.
+    explicit Object(const bsl::string& name)
+    : d_name(name)
+    , d_seed(static_cast<unsigned>(name.size()))
+    {
+    }
+
+    // Destroy this object.
+    ~Object() BSLS_KEYWORD_OVERRIDE
+    {
+    }
+
+    // Load into the specified 'result' the statistics of this object.
+    void getStats(bdld::ManagedDatum* result) BSLS_KEYWORD_OVERRIDE
+    {
+        bdld::DatumMutableArrayRef array;
+        bdld::Datum::createUninitializedArray(&array,
+                                              NUM_STATISTICS,
+                                              result->allocator());
+
+        for (int ordinal = 0; ordinal < NUM_STATISTICS; ++ordinal) {
+            d_seed = d_seed * 1103515245 + 12345;
+            const int value = static_cast<int>((d_seed >> 8) & 0xFFFF);
+
+            if (STATISTICS[ordinal].type == ntci::Monitorable::e_SUM) {
+                array.data()[ordinal] = bdld::Datum::createInteger64(
+                    value, result->allocator());
+            }
+            else {
+                array.data()[ordinal] =
+                    bdld::Datum::createDouble(value / 16.0);
+            }
+        }
+
+        *array.length() = NUM_STATISTICS;
+
+        result->adopt(bdld::Datum::adoptArray(array));
+    }
+
+    // Return the prefix of the field at the specified 'ordinal'.
+    const char* getFieldPrefix(int ordinal) const BSLS_KEYWORD_OVERRIDE
+    {
+        return ordinal < NUM_STATISTICS ? STATISTICS[ordinal].prefix : 0;
+    }
+
+    // Return the name of the field at the specified 'ordinal'.
+    const char* getFieldName(int ordinal) const BSLS_KEYWORD_OVERRIDE
+    {
+        return ordinal < NUM_STATISTICS ? STATISTICS[ordinal].name : 0;
+    }
+
+    // Return the description of the field at the specified 'ordinal'.
+    const char* getFieldDescription(int ordinal) const BSLS_KEYWORD_OVERRIDE
+    {
+        return ordinal < NUM_STATISTICS ? STATISTICS[ordinal].description
+                                        : 0;
+    }
+
+    // Return the type of the field at the specified 'ordinal'.
+    StatisticType getFieldType(int ordinal) const BSLS_KEYWORD_OVERRIDE
+    {
+        return ordinal < NUM_STATISTICS ? STATISTICS[ordinal].type
+                                        : ntci::Monitorable::e_AVERAGE;
+    }
+
+    // Return the tags of the field at the specified 'ordinal'.
+    int getFieldTags(int ordinal) const BSLS_KEYWORD_OVERRIDE
+    {
+        NTCCFG_WARNING_UNUSED(ordinal);
+        return ntci::Monitorable::e_NAME;
+    }
+
+    // Return the ordinal of the specified 'fieldName'.
+    int getFieldOrdinal(const char* fieldName) const BSLS_KEYWORD_OVERRIDE
+    {
+        for (int ordinal = 0; ordinal < NUM_STATISTICS; ++ordinal) {
+            if (0 == bsl::strcmp(fieldName, STATISTICS[ordinal].name)) {
+                return ordinal;
+            }
+        }
+        return -1;
+    }
+
+    // Return the number of statistics reported by this object.
+    int numOrdinals() const BSLS_KEYWORD_OVERRIDE
+    {
+        return NUM_STATISTICS;
+    }
+
+    // Return the name of this object.
+    const char* objectName() const BSLS_KEYWORD_OVERRIDE
+    {
+        return d_name.c_str();
+    }
+};
+
+// Provide a publisher that formats every statistic from scratch during
+// each collection.
+class NaivePublisher : public ntci::MonitorablePublisher
+{
+    bsl::ostringstream d_stream;
+    bsl::string        d_snapshot;
+
+  public:
+    // Create a new publisher.
+    NaivePublisher()
+    : d_stream()
+    , d_snapshot()
+    {
+    }
+
+    // Destroy this object.
+    ~NaivePublisher() BSLS_KEYWORD_OVERRIDE
+    {
+    }
+
+    // Format the specified 'statistics' of the specified 'monitorable'
+    // object and, if the specified 'final' flag is true, the snapshot.
+    void publish(const bsl::shared_ptr<ntci::Monitorable>& monitorable,
+                 const bdld::Datum&                        statistics,
+                 const bsls::TimeInterval&                 time,
+                 bool final) BSLS_KEYWORD_OVERRIDE
+    {
+        NTCCFG_WARNING_UNUSED(time);
+
+        for (int ordinal = 0;
+             ordinal < static_cast<int>(statistics.theArray().length());
+             ++ordinal)
+        {
+            const bdld::Datum& datum = statistics.theArray().data()[ordinal];
+
+            double value = 0;
+            if (datum.isDouble()) {
+                value = datum.theDouble();
+            }
+            else if (datum.isInteger64()) {
+                value = static_cast<double>(datum.theInteger64());
+            }
+            else {
+                continue;
+            }
+
+            bsl::string name = "ntc_";
+            name += monitorable->getFieldPrefix(ordinal);
+            name += "_";
+            name += monitorable->getFieldName(ordinal);
+            for (bsl::size_t i = 0; i < name.size(); ++i) {
+                if (name[i] == '.') {
+                    name[i] = '_';
+                }
+            }
+
+            d_stream << name << "{object=\"" << monitorable->objectName()
+                     << "\",id=\"" << monitorable->objectId().value()
+                     << "\"} " << value << "\n";
+        }
+
+        if (final) {
+            d_stream << "# EOF\n";
+            d_snapshot = d_stream.str();
+            d_stream.str("");
+        }
+    }
+
+    // Return the most recent snapshot.
+    const bsl::string& snapshot() const
+    {
+        return d_snapshot;
+    }
+};
+
+// Return the elapsed time, in milliseconds, since the specified 'startTime'.
+double elapsed(bsls::Types::Int64 startTime)
+{
+    return static_cast<double>(bsls::TimeUtil::getTimer() - startTime) /
+           1000000.0;
+}
+
+// Publish the statistics of the specified 'objects' to the specified
+// 'publisher' as a single collection. Use the specified 'stats' to hold
+// the statistics of each object.
+void collect(ntci::MonitorablePublisher*                  publisher,
+             const bsl::vector<bsl::shared_ptr<Object> >& objects,
+             bdld::ManagedDatum*                          stats)
+{
+    const bsls::TimeInterval now;
+
+    for (bsl::size_t i = 0; i < objects.size(); ++i) {
+        objects[i]->getStats(stats);
+        publisher->publish(objects[i],
+                           stats->datum(),
+                           now,
+                           i + 1 == objects.size());
+    }
+}
+
+// Measure the specified 'numCollections' collections of the statistics of
+// the specified 'numObjects' objects and print the results.
+void execute(bsl::size_t numObjects, bsl::size_t numCollections)
+{
+    bsl::vector<bsl::shared_ptr<Object> > objects;
+    objects.reserve(numObjects);
+
+    for (bsl::size_t i = 0; i < numObjects; ++i) {
+        bsl::ostringstream ss;
+        ss << "socket-" << i;
+
+        bsl::shared_ptr<Object> object;
+        object.createInplace(bslma::Default::allocator(), ss.str());
+
+        objects.push_back(object);
+    }
+
+    bdld::ManagedDatum stats;
+
+    // Measure the cost of collecting the statistics alone.
+
+    {
+        const bsls::Types::Int64 startTime = bsls::TimeUtil::getTimer();
+        for (bsl::size_t i = 0; i < objects.size(); ++i) {
+            objects[i]->getStats(&stats);
+        }
+
+        bsl::cout << "Objects: " << numObjects
+                  << " Statistics: " << numObjects * NUM_STATISTICS
+                  << " Collect: " << elapsed(startTime) << " ms"
+                  << bsl::endl;
+    }
+
+    ntcs::OpenMetricsPublisher openMetricsPublisher;
+    NaivePublisher             naivePublisher;
+
+    for (bsl::size_t collection = 0; collection < numCollections; ++collection)
+    {
+        bsls::Types::Int64 startTime = bsls::TimeUtil::getTimer();
+        collect(&openMetricsPublisher, objects, &stats);
+        const double openMetricsTime = elapsed(startTime);
+
+        startTime = bsls::TimeUtil::getTimer();
+        bsl::shared_ptr<const bsl::string> snapshot =
+            openMetricsPublisher.snapshot();
+        const double snapshotTime = elapsed(startTime);
+
+        startTime = bsls::TimeUtil::getTimer();
+        collect(&naivePublisher, objects, &stats);
+        const double naiveTime = elapsed(startTime);
+
+        bsl::cout << "Collection: " << collection
+                  << " OpenMetrics: " << openMetricsTime << " ms"
+                  << " Snapshot: " << snapshotTime << " ms"
+                  << " Size: " << snapshot->size()
+                  << " Naive: " << naiveTime << " ms"
+                  << " Size: " << naivePublisher.snapshot().size()
+                  << bsl::endl;
+    }
+}
+
+}  // close namespace example
+
+void help()
+{
+    bsl::cout << "usage: ntcu16.tsk [-v <level>] [-n <objects>] "
+                 "[-c <collections>]"
+              << bsl::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int         verbosity      = 0;
+    bsl::size_t numObjects     = 100000;
+    bsl::size_t numCollections = 5;
+    {
+        int i = 1;
+        while (i < argc) {
+            if ((0 == std::strcmp(argv[i], "-?")) ||
+                (0 == std::strcmp(argv[i], "--help")))
+            {
+                help();
+                return 0;
+            }
+
+            if (0 == std::strcmp(argv[i], "-v") ||
+                0 == std::strcmp(argv[i], "--verbosity"))
+            {
+                ++i;
+                if (i >= argc) {
+                    help();
+                    return 1;
+                }
+                verbosity = std::atoi(argv[i]);
+                ++i;
+                continue;
+            }
+
+            if (0 == std::strcmp(argv[i], "-n") ||
+                0 == std::strcmp(argv[i], "--objects"))
+            {
+                ++i;
+                if (i >= argc) {
+                    help();
+                    return 1;
+                }
+                numObjects = static_cast<bsl::size_t>(std::atoi(argv[i]));
+                ++i;
+                continue;
+            }
+
+            if (0 == std::strcmp(argv[i], "-c") ||
+                0 == std::strcmp(argv[i], "--collections"))
+            {
+                ++i;
+                if (i >= argc) {
+                    help();
+                    return 1;
+                }
+                numCollections = static_cast<bsl::size_t>(std::atoi(argv[i]));
+                ++i;
+                continue;
+            }
+
+            bsl::cerr << "Invalid option: " << argv[i] << bsl::endl;
+            return 1;
+        }
+    }
+
+    switch (verbosity) {
+    case 0:
+        break;
+    case 1:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_ERROR);
+        break;
+    case 2:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_WARN);
+        break;
+    case 3:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_INFO);
+        break;
+    case 4:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_DEBUG);
+        break;
+    default:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_TRACE);
+        break;
+    }
+
+    ntcf::System::initialize();
+
+    example::execute(numObjects, numCollections);
+
+    return 0;
+}
@@ -0,0 +1,1327 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntccfg_bind.h>
+#include <ntci_metric.h>
+#include <ntcf_system.h>
+#include <bdlbb_blob.h>
+#include <bdlbb_blobutil.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadutil.h>
+#include <bsls_atomic.h>
+#include <bsls_timeinterval.h>
+#include <bsls_timeutil.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_deque.h>
+#include <bsl_iomanip.h>
+#include <bsl_iostream.h>
+#include <bsl_limits.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+
+namespace example {
+
+//
+// Measuring Throughput and Latency Across Drivers
+//
+// This example is a benchmark of the throughput and latency of four
+// workloads over the loopback device, run on each driver supported by the
+// current platform (for example, 'select', 'poll', 'epoll', and 'iouring' on
+// Linux):
+//
+// echo:     Each client connection sends messages of a fixed size and the
+//           server sends each byte it receives back to the client. Each
+//           message completes when the client has received it back.
+//
+// rpc:      Each client connection sends requests of a fixed size and the
+//           server responds to each request with a response of a, possibly
+//           different, fixed size.
+//
+// stream:   Each client connection sends messages of a fixed size as fast
+//           as the connection allows, and the server consumes them.
+//
+// datagram: Each client socket sends UDP datagrams of a fixed size to a
+//           single server socket that sends each datagram back to its
+//           sender.
+//
+// Each client keeps a configurable number of messages in flight. The
+// client and the server each run in an interface with a configurable number
+// of threads. Each run lasts for a configurable duration, after which the
+// number of messages and bytes completed during the run, and the
+// distribution of the latency of each message from its send to its
+// completion, are reported as a JSON document on standard output so that
+// the results of different builds may be compared. The bytes of a message
+// count the payload received by the application in each direction: for
+// example, an echoed message of 64 bytes counts 128 bytes. The latency of
+// the stream workload is not measured, and is reported as null.
+//
+
+// Enumerate the workloads.
+struct Workload {
+    enum Value { e_ECHO, e_RPC, e_STREAM, e_DATAGRAM };
+
+    // Return the string representation of the specified 'value'.
+    static const char* toString(Value value)
+    {
+        switch (value) {
+        case e_ECHO:
+            return "echo";
+        case e_RPC:
+            return "rpc";
+        case e_STREAM:
+            return "stream";
+        case e_DATAGRAM:
+            return "datagram";
+        }
+
+        return "unknown";
+    }
+
+    // Load into the specified 'result' the workload named by the specified
+    // 'name'. Return true if 'name' identifies a workload, otherwise return
+    // false.
+    static bool fromString(Value* result, const bsl::string& name)
+    {
+        if (name == "echo") {
+            *result = e_ECHO;
+        }
+        else if (name == "rpc") {
+            *result = e_RPC;
+        }
+        else if (name == "stream") {
+            *result = e_STREAM;
+        }
+        else if (name == "datagram") {
+            *result = e_DATAGRAM;
+        }
+        else {
+            return false;
+        }
+
+        return true;
+    }
+};
+
+// Describe the parameters of a benchmark run.
+struct Parameters {
+    bsl::string        d_driverName;
+    Workload::Value    d_workload;
+    bsl::size_t        d_numConnections;
+    bsl::size_t        d_messageSize;
+    bsl::size_t        d_responseSize;
+    bsl::size_t        d_pipeline;
+    bsl::size_t        d_numThreads;
+    bsls::TimeInterval d_duration;
+
+    Parameters()
+    : d_driverName()
+    , d_workload(Workload::e_ECHO)
+    , d_numConnections(16)
+    , d_messageSize(64)
+    , d_responseSize(64)
+    , d_pipeline(1)
+    , d_numThreads(1)
+    , d_duration(2, 0)
+    {
+    }
+};
+
+// Provide the results of a benchmark run, updated concurrently by each
+// connection.
+class Result
+{
+    bsls::AtomicBool       d_running;
+    bsls::AtomicUint64     d_numMessages;
+    bsls::AtomicUint64     d_numBytes;
+    bsls::AtomicUint64     d_latencyTotal;
+    bsls::AtomicUint64     d_latencyMaximum;
+    ntci::MetricHistogram  d_latency;
+
+  private:
+    Result(const Result&) BSLS_KEYWORD_DELETED;
+    Result& operator=(const Result&) BSLS_KEYWORD_DELETED;
+
+  public:
+    // Create new results. Latencies are recorded in nanoseconds and
+    // counted from 2^6 nanoseconds.
+    Result()
+    : d_running(false)
+    , d_numMessages(0)
+    , d_numBytes(0)
+    , d_latencyTotal(0)
+    , d_latencyMaximum(0)
+    , d_latency(6)
+    {
+    }
+
+    // Begin recording.
+    void start()
+    {
+        d_running = true;
+    }
+
+    // Stop recording.
+    void stop()
+    {
+        d_running = false;
+    }
+
+    // Record the completion of a message having the specified 'numBytes'
+    // and the specified 'latency', in nanoseconds, if recording.
+    void recordMessage(bsl::size_t numBytes, bsls::Types::Int64 latency)
+    {
+        if (!d_running) {
+            return;
+        }
+
+        const bsl::uint64_t value =
+            latency > 0 ? static_cast<bsl::uint64_t>(latency) : 0;
+
+        d_numMessages.addRelaxed(1);
+        d_numBytes.addRelaxed(numBytes);
+        d_latencyTotal.addRelaxed(value);
+        d_latency.update(static_cast<double>(value));
+
+        bsl::uint64_t maximum = d_latencyMaximum.loadRelaxed();
+        while (value > maximum) {
+            const bsl::uint64_t previous =
+                d_latencyMaximum.testAndSwap(maximum, value);
+            if (previous == maximum) {
+                break;
+            }
+            maximum = previous;
+        }
+    }
+
+    // Record the specified 'numBytes' consumed without completing a
+    // message whose latency is measured, if recording.
+    void recordBytes(bsl::size_t numBytes)
+    {
+        if (!d_running) {
+            return;
+        }
+
+        d_numBytes.addRelaxed(numBytes);
+    }
+
+    // Return true if recording, otherwise return false.
+    bool isRunning() const
+    {
+        return d_running;
+    }
+
+    // Return the number of messages completed.
+    bsl::uint64_t numMessages() const
+    {
+        return d_numMessages.load();
+    }
+
+    // Return the number of bytes completed.
+    bsl::uint64_t numBytes() const
+    {
+        return d_numBytes.load();
+    }
+
+    // Return the total latency of each message, in nanoseconds.
+    bsl::uint64_t latencyTotal() const
+    {
+        return d_latencyTotal.load();
+    }
+
+    // Return the maximum latency of any message, in nanoseconds.
+    bsl::uint64_t latencyMaximum() const
+    {
+        return d_latencyMaximum.load();
+    }
+
+    // Load into the specified 'result' the estimates of each of the
+    // specified 'numQuantiles' 'quantiles' of the latency of each message,
+    // in nanoseconds. Return the number of latencies recorded.
+    bsl::uint64_t loadLatency(double*       result,
+                              const double* quantiles,
+                              bsl::size_t   numQuantiles)
+    {
+        return d_latency.load(result, quantiles, numQuantiles);
+    }
+};
+
+// Provide the client side of a stream socket connection.
+class StreamClient : public ntccfg::Shared<StreamClient>
+{
+    bsl::shared_ptr<ntci::StreamSocket> d_streamSocket_sp;
+    bsl::shared_ptr<bdlbb::Blob>        d_request_sp;
+    Parameters                          d_parameters;
+    Result*                             d_result_p;
+    bslmt::Mutex                        d_mutex;
+    bsl::deque<bsls::Types::Int64>      d_sendTimes;
+
+  private:
+    StreamClient(const StreamClient&) BSLS_KEYWORD_DELETED;
+    StreamClient& operator=(const StreamClient&) BSLS_KEYWORD_DELETED;
+
+  private:
+    // Send the next message, if the benchmark is running.
+    void send();
+
+    // Receive the next response.
+    void receive();
+
+    // Process the completion of the send of a message by the specified
+    // 'sender' described by the specified 'event'.
+    void processSend(const bsl::shared_ptr<ntci::Sender>& sender,
+                     const ntca::SendEvent&               event);
+
+    // Process the receipt of the specified 'data' by the specified
+    // 'receiver' described by the specified 'event'.
+    void processReceive(const bsl::shared_ptr<ntci::Receiver>& receiver,
+                        const bsl::shared_ptr<bdlbb::Blob>&    data,
+                        const ntca::ReceiveEvent&              event);
+
+  public:
+    // Create a new client of the specified 'streamSocket' that sends the
+    // specified 'request' according to the specified 'parameters' and
+    // records each completed message in the specified 'result'.
+    StreamClient(const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+                 const bsl::shared_ptr<bdlbb::Blob>&        request,
+                 const Parameters&                          parameters,
+                 Result*                                    result)
+    : d_streamSocket_sp(streamSocket)
+    , d_request_sp(request)
+    , d_parameters(parameters)
+    , d_result_p(result)
+    , d_mutex()
+    , d_sendTimes()
+    {
+    }
+
+    // Begin sending messages.
+    void start()
+    {
+        if (d_parameters.d_workload != Workload::e_STREAM) {
+            this->receive();
+        }
+
+        for (bsl::size_t i = 0; i < d_parameters.d_pipeline; ++i) {
+            this->send();
+        }
+    }
+
+    // Return the stream socket.
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket() const
+    {
+        return d_streamSocket_sp;
+    }
+};
+
+void StreamClient::send()
+{
+    if (!d_result_p->isRunning()) {
+        return;
+    }
+
+    ntsa::Error error;
+
+    if (d_parameters.d_workload == Workload::e_STREAM) {
+        error = d_streamSocket_sp->send(
+            *d_request_sp,
+            ntca::SendOptions(),
+            NTCCFG_BIND(&StreamClient::processSend,
+                        this->getSelf(this),
+                        NTCCFG_BIND_PLACEHOLDER_1,
+                        NTCCFG_BIND_PLACEHOLDER_2));
+    }
+    else {
+        {
+            bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+            d_sendTimes.push_back(bsls::TimeUtil::getTimer());
+        }
+
+        error = d_streamSocket_sp->send(*d_request_sp, ntca::SendOptions());
+    }
+
+    if (error && error != ntsa::Error::e_CANCELLED) {
+        bsl::cerr << "Failed to send: " << error << bsl::endl;
+    }
+}
+
+void StreamClient::receive()
+{
+    ntca::ReceiveOptions receiveOptions;
+    receiveOptions.setMinSize(d_parameters.d_responseSize);
+    receiveOptions.setMaxSize(d_parameters.d_responseSize);
+
+    d_streamSocket_sp->receive(
+        receiveOptions,
+        NTCCFG_BIND(&StreamClient::processReceive,
+                    this->getSelf(this),
+                    NTCCFG_BIND_PLACEHOLDER_1,
+                    NTCCFG_BIND_PLACEHOLDER_2,
+                    NTCCFG_BIND_PLACEHOLDER_3));
+}
+
+void StreamClient::processSend(const bsl::shared_ptr<ntci::Sender>& sender,
+                               const ntca::SendEvent&               event)
+{
+    NTCCFG_WARNING_UNUSED(sender);
+
+    if (event.type() != ntca::SendEventType::e_COMPLETE) {
+        return;
+    }
+
+    this->send();
+}
+
+void StreamClient::processReceive(
+    const bsl::shared_ptr<ntci::Receiver>& receiver,
+    const bsl::shared_ptr<bdlbb::Blob>&    data,
+    const ntca::ReceiveEvent&              event)
+{
+    NTCCFG_WARNING_UNUSED(receiver);
+    NTCCFG_WARNING_UNUSED(data);
+
+    if (event.type() != ntca::ReceiveEventType::e_COMPLETE) {
+        return;
+    }
+
+    const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+
+    bsls::Types::Int64 sendTime = now;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        if (!d_sendTimes.empty()) {
+            sendTime = d_sendTimes.front();
+            d_sendTimes.pop_front();
+        }
+    }
+
+    d_result_p->recordMessage(
+        d_parameters.d_messageSize + d_parameters.d_responseSize,
+        now - sendTime);
+
+    this->receive();
+    this->send();
+}
+
+// Provide the server side of a stream socket connection.
+class StreamServer : public ntccfg::Shared<StreamServer>
+{
+    bsl::shared_ptr<ntci::StreamSocket> d_streamSocket_sp;
+    bsl::shared_ptr<bdlbb::Blob>        d_response_sp;
+    Parameters                          d_parameters;
+    Result*                             d_result_p;
+
+  private:
+    StreamServer(const StreamServer&) BSLS_KEYWORD_DELETED;
+    StreamServer& operator=(const StreamServer&) BSLS_KEYWORD_DELETED;
+
+  private:
+    // Process the receipt of the specified 'data' by the specified
+    // 'receiver' described by the specified 'event'.
+    void processReceive(const bsl::shared_ptr<ntci::Receiver>& receiver,
+                        const bsl::shared_ptr<bdlbb::Blob>&    data,
+                        const ntca::ReceiveEvent&              event);
+
+  public:
+    // Create a new server of the specified 'streamSocket' that responds to
+    // each request with the specified 'response' according to the specified
+    // 'parameters', and records each consumed byte of a stream in the
+    // specified 'result'.
+    StreamServer(const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+                 const bsl::shared_ptr<bdlbb::Blob>&        response,
+                 const Parameters&                          parameters,
+                 Result*                                    result)
+    : d_streamSocket_sp(streamSocket)
+    , d_response_sp(response)
+    , d_parameters(parameters)
+    , d_result_p(result)
+    {
+    }
+
+    // Receive the next request, or the next data of a stream.
+    void receive();
+
+    // Return the stream socket.
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket() const
+    {
+        return d_streamSocket_sp;
+    }
+};
+
+void StreamServer::receive()
+{
+    ntca::ReceiveOptions receiveOptions;
+
+    if (d_parameters.d_workload == Workload::e_RPC) {
+        receiveOptions.setMinSize(d_parameters.d_messageSize);
+        receiveOptions.setMaxSize(d_parameters.d_messageSize);
+    }
+    else {
+        receiveOptions.setMinSize(1);
+        receiveOptions.setMaxSize(bsl::numeric_limits<int>::max());
+    }
+
+    d_streamSocket_sp->receive(
+        receiveOptions,
+        NTCCFG_BIND(&StreamServer::processReceive,
+                    this->getSelf(this),
+                    NTCCFG_BIND_PLACEHOLDER_1,
+                    NTCCFG_BIND_PLACEHOLDER_2,
+                    NTCCFG_BIND_PLACEHOLDER_3));
+}
+
+void StreamServer::processReceive(
+    const bsl::shared_ptr<ntci::Receiver>& receiver,
+    const bsl::shared_ptr<bdlbb::Blob>&    data,
+    const ntca::ReceiveEvent&              event)
+{
+    NTCCFG_WARNING_UNUSED(receiver);
+
+    if (event.type() != ntca::ReceiveEventType::e_COMPLETE) {
+        return;
+    }
+
+    if (d_parameters.d_workload == Workload::e_ECHO) {
+        d_streamSocket_sp->send(*data, ntca::SendOptions());
+    }
+    else if (d_parameters.d_workload == Workload::e_RPC) {
+        d_streamSocket_sp->send(*d_response_sp, ntca::SendOptions());
+    }
+    else {
+        d_result_p->recordBytes(static_cast<bsl::size_t>(data->length()));
+    }
+
+    this->receive();
+}
+
+// Provide the server side of the datagram workload.
+class DatagramServer : public ntccfg::Shared<DatagramServer>
+{
+    bsl::shared_ptr<ntci::DatagramSocket> d_datagramSocket_sp;
+
+  private:
+    DatagramServer(const DatagramServer&) BSLS_KEYWORD_DELETED;
+    DatagramServer& operator=(const DatagramServer&) BSLS_KEYWORD_DELETED;
+
+  private:
+    // Process the receipt of the specified 'data' by the specified
+    // 'receiver' described by the specified 'event'.
+    void processReceive(const bsl::shared_ptr<ntci::Receiver>& receiver,
+                        const bsl::shared_ptr<bdlbb::Blob>&    data,
+                        const ntca::ReceiveEvent&              event);
+
+  public:
+    // Create a new server of the specified 'datagramSocket'.
+    explicit DatagramServer(
+        const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket)
+    : d_datagramSocket_sp(datagramSocket)
+    {
+    }
+
+    // Receive the next datagram.
+    void receive()
+    {
+        d_datagramSocket_sp->receive(
+            ntca::ReceiveOptions(),
+            NTCCFG_BIND(&DatagramServer::processReceive,
+                        this->getSelf(this),
+                        NTCCFG_BIND_PLACEHOLDER_1,
+                        NTCCFG_BIND_PLACEHOLDER_2,
+                        NTCCFG_BIND_PLACEHOLDER_3));
+    }
+
+    // Return the datagram socket.
+    const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket() const
+    {
+        return d_datagramSocket_sp;
+    }
+};
+
+void DatagramServer::processReceive(
+    const bsl::shared_ptr<ntci::Receiver>& receiver,
+    const bsl::shared_ptr<bdlbb::Blob>&    data,
+    const ntca::ReceiveEvent&              event)
+{
+    NTCCFG_WARNING_UNUSED(receiver);
+
+    if (event.type() != ntca::ReceiveEventType::e_COMPLETE) {
+        return;
+    }
+
+    if (event.context().endpoint().has_value()) {
+        ntca::SendOptions sendOptions;
+        sendOptions.setEndpoint(event.context().endpoint().value());
+
+        d_datagramSocket_sp->send(*data, sendOptions);
+    }
+
+    this->receive();
+}
+
+// Provide the client side of the datagram workload.
+class DatagramClient : public ntccfg::Shared<DatagramClient>
+{
+    bsl::shared_ptr<ntci::DatagramSocket> d_datagramSocket_sp;
+    bsl::shared_ptr<bdlbb::Blob>          d_request_sp;
+    ntsa::Endpoint                        d_serverEndpoint;
+    Parameters                            d_parameters;
+    Result*                               d_result_p;
+    bslmt::Mutex                          d_mutex;
+    bsl::deque<bsls::Types::Int64>        d_sendTimes;
+
+  private:
+    DatagramClient(const DatagramClient&) BSLS_KEYWORD_DELETED;
+    DatagramClient& operator=(const DatagramClient&) BSLS_KEYWORD_DELETED;
+
+  private:
+    // Send the next datagram, if the benchmark is running.
+    void send();
+
+    // Receive the next datagram.
+    void receive();
+
+    // Process the receipt of the specified 'data' by the specified
+    // 'receiver' described by the specified 'event'.
+    void processReceive(const bsl::shared_ptr<ntci::Receiver>& receiver,
+                        const bsl::shared_ptr<bdlbb::Blob>&    data,
+                        const ntca::ReceiveEvent&              event);
+
+  public:
+    // Create a new client of the specified 'datagramSocket' that sends the
+    // specified 'request' to the specified 'serverEndpoint' according to
+    // the specified 'parameters' and records each completed message in the
+    // specified 'result'.
+    DatagramClient(
+        const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket,
+        const bsl::shared_ptr<bdlbb::Blob>&          request,
+        const ntsa::Endpoint&                        serverEndpoint,
+        const Parameters&                            parameters,
+        Result*                                      result)
+    : d_datagramSocket_sp(datagramSocket)
+    , d_request_sp(request)
+    , d_serverEndpoint(serverEndpoint)
+    , d_parameters(parameters)
+    , d_result_p(result)
+    , d_mutex()
+    , d_sendTimes()
+    {
+    }
+
+    // Begin sending datagrams.
+    void start()
+    {
+        this->receive();
+
+        for (bsl::size_t i = 0; i < d_parameters.d_pipeline; ++i) {
+            this->send();
+        }
+    }
+
+    // Return the datagram socket.
+    const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket() const
+    {
+        return d_datagramSocket_sp;
+    }
+};
+
+void DatagramClient::send()
+{
+    if (!d_result_p->isRunning()) {
+        return;
+    }
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_sendTimes.push_back(bsls::TimeUtil::getTimer());
+    }
+
+    ntca::SendOptions sendOptions;
+    sendOptions.setEndpoint(d_serverEndpoint);
+
+    ntsa::Error error = d_datagramSocket_sp->send(*d_request_sp, sendOptions);
+    if (error && error != ntsa::Error::e_CANCELLED) {
+        bsl::cerr << "Failed to send: " << error << bsl::endl;
+    }
+}
+
+void DatagramClient::receive()
+{
+    d_datagramSocket_sp->receive(
+        ntca::ReceiveOptions(),
+        NTCCFG_BIND(&DatagramClient::processReceive,
+                    this->getSelf(this),
+                    NTCCFG_BIND_PLACEHOLDER_1,
+                    NTCCFG_BIND_PLACEHOLDER_2,
+                    NTCCFG_BIND_PLACEHOLDER_3));
+}
+
+void DatagramClient::processReceive(
+    const bsl::shared_ptr<ntci::Receiver>& receiver,
+    const bsl::shared_ptr<bdlbb::Blob>&    data,
+    const ntca::ReceiveEvent&              event)
+{
+    NTCCFG_WARNING_UNUSED(receiver);
+    NTCCFG_WARNING_UNUSED(data);
+
+    if (event.type() != ntca::ReceiveEventType::e_COMPLETE) {
+        return;
+    }
+
+    const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+
+    // Datagrams are echoed in the order they are sent unless one is lost,
+    // in which case the latency of each subsequent datagram is measured
+    // from the send of an earlier one: loss is rare enough over the
+    // loopback device to ignore.
+
+    bsls::Types::Int64 sendTime = now;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        if (!d_sendTimes.empty()) {
+            sendTime = d_sendTimes.front();
+            d_sendTimes.pop_front();
+        }
+    }
+
+    d_result_p->recordMessage(2 * d_parameters.d_messageSize, now - sendTime);
+
+    this->receive();
+    this->send();
+}
+
+// Provide the state of a benchmark run shared with the callbacks that
+// establish its connections.
+class Benchmark
+{
+    typedef bsl::vector<bsl::shared_ptr<StreamServer> >   StreamServerVector;
+    typedef bsl::vector<bsl::shared_ptr<StreamClient> >   StreamClientVector;
+    typedef bsl::vector<bsl::shared_ptr<DatagramClient> > DatagramClientVector;
+
+    Parameters                            d_parameters;
+    Result                                d_result;
+    bsl::shared_ptr<ntci::Interface>      d_clientInterface_sp;
+    bsl::shared_ptr<ntci::Interface>      d_serverInterface_sp;
+    bsl::shared_ptr<bdlbb::Blob>          d_request_sp;
+    bsl::shared_ptr<bdlbb::Blob>          d_response_sp;
+    bsl::shared_ptr<ntci::ListenerSocket> d_listenerSocket_sp;
+    bslmt::Mutex                          d_mutex;
+    StreamServerVector                    d_streamServers;
+    StreamClientVector                    d_streamClients;
+    bsl::shared_ptr<DatagramServer>       d_datagramServer_sp;
+    DatagramClientVector                  d_datagramClients;
+    bslmt::Semaphore                      d_semaphore;
+
+  private:
+    Benchmark(const Benchmark&) BSLS_KEYWORD_DELETED;
+    Benchmark& operator=(const Benchmark&) BSLS_KEYWORD_DELETED;
+
+  private:
+    // Accept the next connection.
+    void accept();
+
+    // Process the acceptance of the specified 'streamSocket' by the
+    // specified 'acceptor' described by the specified 'event'.
+    void processAccept(const bsl::shared_ptr<ntci::Acceptor>&     acceptor,
+                       const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+                       const ntca::AcceptEvent&                   event);
+
+    // Process the connection of the specified 'connector' described by the
+    // specified 'event'.
+    void processConnect(const bsl::shared_ptr<ntci::Connector>& connector,
+                        const ntca::ConnectEvent&               event);
+
+    // Return a new blob of the specified 'size' allocated from the
+    // specified 'interface'.
+    static bsl::shared_ptr<bdlbb::Blob> createBlob(
+        const bsl::shared_ptr<ntci::Interface>& interface,
+        bsl::size_t                             size);
+
+    // Create a new interface named by the specified 'name'.
+    bsl::shared_ptr<ntci::Interface> createInterface(const char* name) const;
+
+    // Establish the connections of a stream workload.
+    void setupStream();
+
+    // Establish the sockets of the datagram workload.
+    void setupDatagram();
+
+    // Close each socket.
+    void teardown();
+
+  public:
+    // Create a new benchmark according to the specified 'parameters'.
+    explicit Benchmark(const Parameters& parameters);
+
+    // Run the benchmark and print its results as a JSON object to the
+    // specified 'stream'.
+    void run(bsl::ostream& stream);
+};
+
+Benchmark::Benchmark(const Parameters& parameters)
+: d_parameters(parameters)
+, d_result()
+, d_clientInterface_sp()
+, d_serverInterface_sp()
+, d_request_sp()
+, d_response_sp()
+, d_listenerSocket_sp()
+, d_mutex()
+, d_streamServers()
+, d_streamClients()
+, d_datagramServer_sp()
+, d_datagramClients()
+, d_semaphore()
+{
+    if (d_parameters.d_workload != Workload::e_RPC) {
+        d_parameters.d_responseSize = d_parameters.d_messageSize;
+    }
+}
+
+bsl::shared_ptr<bdlbb::Blob> Benchmark::createBlob(
+    const bsl::shared_ptr<ntci::Interface>& interface,
+    bsl::size_t                             size)
+{
+    bsl::shared_ptr<bdlbb::Blob> blob = interface->createOutgoingBlob();
+
+    bsl::vector<char> data(size, 'X');
+    bdlbb::BlobUtil::append(blob.get(), data.data(), static_cast<int>(size));
+
+    return blob;
+}
+
+bsl::shared_ptr<ntci::Interface> Benchmark::createInterface(
+    const char* name) const
+{
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setThreadName(name);
+    interfaceConfig.setDriverName(d_parameters.d_driverName);
+    interfaceConfig.setMinThreads(d_parameters.d_numThreads);
+    interfaceConfig.setMaxThreads(d_parameters.d_numThreads);
+
+    bsl::shared_ptr<ntci::Interface> interface =
+        ntcf::System::createInterface(interfaceConfig);
+
+    ntsa::Error error = interface->start();
+    BSLS_ASSERT_OPT(!error);
+
+    return interface;
+}
+
+void Benchmark::accept()
+{
+    d_listenerSocket_sp->accept(
+        ntca::AcceptOptions(),
+        NTCCFG_BIND(&Benchmark::processAccept,
+                    this,
+                    NTCCFG_BIND_PLACEHOLDER_1,
+                    NTCCFG_BIND_PLACEHOLDER_2,
+                    NTCCFG_BIND_PLACEHOLDER_3));
+}
+
+void Benchmark::processAccept(
+    const bsl::shared_ptr<ntci::Acceptor>&     acceptor,
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const ntca::AcceptEvent&                   event)
+{
+    NTCCFG_WARNING_UNUSED(acceptor);
+
+    if (event.type() != ntca::AcceptEventType::e_COMPLETE) {
+        return;
+    }
+
+    bsl::shared_ptr<StreamServer> streamServer;
+    streamServer.createInplace(bslma::Default::allocator(),
+                               streamSocket,
+                               d_response_sp,
+                               d_parameters,
+                               &d_result);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_streamServers.push_back(streamServer);
+    }
+
+    streamServer->receive();
+
+    d_semaphore.post();
+
+    this->accept();
+}
+
+void Benchmark::processConnect(
+    const bsl::shared_ptr<ntci::Connector>& connector,
+    const ntca::ConnectEvent&               event)
+{
+    NTCCFG_WARNING_UNUSED(connector);
+
+    BSLS_ASSERT_OPT(event.type() == ntca::ConnectEventType::e_COMPLETE);
+    d_semaphore.post();
+}
+
+void Benchmark::setupStream()
+{
+    ntsa::Error error;
+
+    ntca::ListenerSocketOptions listenerSocketOptions;
+    listenerSocketOptions.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+    listenerSocketOptions.setSourceEndpoint(
+        ntsa::Endpoint(ntsa::Ipv4Address::loopback(), 0));
+    listenerSocketOptions.setBacklog(
+        static_cast<int>(d_parameters.d_numConnections));
+
+    d_listenerSocket_sp =
+        d_serverInterface_sp->createListenerSocket(listenerSocketOptions);
+
+    error = d_listenerSocket_sp->open();
+    BSLS_ASSERT_OPT(!error);
+
+    error = d_listenerSocket_sp->listen();
+    BSLS_ASSERT_OPT(!error);
+
+    this->accept();
+
+    ntca::StreamSocketOptions streamSocketOptions;
+    streamSocketOptions.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+    streamSocketOptions.setNoDelay(true);
+
+    for (bsl::size_t i = 0; i < d_parameters.d_numConnections; ++i) {
+        bsl::shared_ptr<ntci::StreamSocket> streamSocket =
+            d_clientInterface_sp->createStreamSocket(streamSocketOptions);
+
+        error = streamSocket->connect(
+            d_listenerSocket_sp->sourceEndpoint(),
+            ntca::ConnectOptions(),
+            NTCCFG_BIND(&Benchmark::processConnect,
+                        this,
+                        NTCCFG_BIND_PLACEHOLDER_1,
+                        NTCCFG_BIND_PLACEHOLDER_2));
+        BSLS_ASSERT_OPT(!error);
+
+        bsl::shared_ptr<StreamClient> streamClient;
+        streamClient.createInplace(bslma::Default::allocator(),
+                                   streamSocket,
+                                   d_request_sp,
+                                   d_parameters,
+                                   &d_result);
+
+        d_streamClients.push_back(streamClient);
+    }
+
+    // Wait for each connection to be both connected and accepted.
+
+    for (bsl::size_t i = 0; i < 2 * d_parameters.d_numConnections; ++i) {
+        d_semaphore.wait();
+    }
+}
+
+void Benchmark::setupDatagram()
+{
+    ntsa::Error error;
+
+    ntca::DatagramSocketOptions datagramSocketOptions;
+    datagramSocketOptions.setTransport(ntsa::Transport::e_UDP_IPV4_DATAGRAM);
+    datagramSocketOptions.setSourceEndpoint(
+        ntsa::Endpoint(ntsa::Ipv4Address::loopback(), 0));
+
+    bsl::shared_ptr<ntci::DatagramSocket> serverSocket =
+        d_serverInterface_sp->createDatagramSocket(datagramSocketOptions);
+
+    error = serverSocket->open();
+    BSLS_ASSERT_OPT(!error);
+
+    d_datagramServer_sp.createInplace(bslma::Default::allocator(),
+                                      serverSocket);
+    d_datagramServer_sp->receive();
+
+    for (bsl::size_t i = 0; i < d_parameters.d_numConnections; ++i) {
+        bsl::shared_ptr<ntci::DatagramSocket> clientSocket =
+            d_clientInterface_sp->createDatagramSocket(datagramSocketOptions);
+
+        error = clientSocket->open();
+        BSLS_ASSERT_OPT(!error);
+
+        bsl::shared_ptr<DatagramClient> datagramClient;
+        datagramClient.createInplace(bslma::Default::allocator(),
+                                     clientSocket,
+                                     d_request_sp,
+                                     serverSocket->sourceEndpoint(),
+                                     d_parameters,
+                                     &d_result);
+
+        d_datagramClients.push_back(datagramClient);
+    }
+}
+
+void Benchmark::teardown()
+{
+    for (bsl::size_t i = 0; i < d_streamClients.size(); ++i) {
+        ntci::StreamSocketCloseGuard guard(
+            d_streamClients[i]->streamSocket());
+    }
+
+    for (bsl::size_t i = 0; i < d_datagramClients.size(); ++i) {
+        ntci::DatagramSocketCloseGuard guard(
+            d_datagramClients[i]->datagramSocket());
+    }
+
+    if (d_listenerSocket_sp) {
+        ntci::ListenerSocketCloseGuard guard(d_listenerSocket_sp);
+    }
+
+    StreamServerVector streamServers;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        streamServers.swap(d_streamServers);
+    }
+
+    for (bsl::size_t i = 0; i < streamServers.size(); ++i) {
+        ntci::StreamSocketCloseGuard guard(streamServers[i]->streamSocket());
+    }
+
+    if (d_datagramServer_sp) {
+        ntci::DatagramSocketCloseGuard guard(
+            d_datagramServer_sp->datagramSocket());
+    }
+
+    d_streamClients.clear();
+    d_datagramClients.clear();
+    d_datagramServer_sp.reset();
+    d_listenerSocket_sp.reset();
+}
+
+void Benchmark::run(bsl::ostream& stream)
+{
+    d_serverInterface_sp = this->createInterface("server");
+    d_clientInterface_sp = this->createInterface("client");
+
+    d_request_sp  = Benchmark::createBlob(d_clientInterface_sp,
+                                         d_parameters.d_messageSize);
+    d_response_sp = Benchmark::createBlob(d_serverInterface_sp,
+                                          d_parameters.d_responseSize);
+
+    if (d_parameters.d_workload == Workload::e_DATAGRAM) {
+        this->setupDatagram();
+    }
+    else {
+        this->setupStream();
+    }
+
+    d_result.start();
+
+    const bsls::Types::Int64 startTime = bsls::TimeUtil::getTimer();
+
+    for (bsl::size_t i = 0; i < d_streamClients.size(); ++i) {
+        d_streamClients[i]->start();
+    }
+
+    for (bsl::size_t i = 0; i < d_datagramClients.size(); ++i) {
+        d_datagramClients[i]->start();
+    }
+
+    bslmt::ThreadUtil::sleep(d_parameters.d_duration);
+
+    d_result.stop();
+
+    const bsls::Types::Int64 stopTime = bsls::TimeUtil::getTimer();
+
+    this->teardown();
+
+    d_clientInterface_sp->shutdown();
+    d_clientInterface_sp->linger();
+
+    d_serverInterface_sp->shutdown();
+    d_serverInterface_sp->linger();
+
+    const double elapsedSeconds =
+        static_cast<double>(stopTime - startTime) / 1000000000.0;
+
+    bsl::uint64_t numMessages = d_result.numMessages();
+    const bsl::uint64_t numBytes = d_result.numBytes();
+
+    if (d_parameters.d_workload == Workload::e_STREAM) {
+        numMessages = numBytes / d_parameters.d_messageSize;
+    }
+
+    stream << "{\"driver\":\"" << d_parameters.d_driverName << "\""
+           << ",\"workload\":\"" << Workload::toString(d_parameters.d_workload)
+           << "\""
+           << ",\"connections\":" << d_parameters.d_numConnections
+           << ",\"messageSize\":" << d_parameters.d_messageSize
+           << ",\"responseSize\":" << d_parameters.d_responseSize
+           << ",\"pipeline\":" << d_parameters.d_pipeline
+           << ",\"threads\":" << d_parameters.d_numThreads
+           << ",\"duration\":" << elapsedSeconds
+           << ",\"messages\":" << numMessages
+           << ",\"bytes\":" << numBytes << ",\"messagesPerSecond\":"
+           << static_cast<double>(numMessages) / elapsedSeconds
+           << ",\"megabytesPerSecond\":"
+           << static_cast<double>(numBytes) / elapsedSeconds / 1000000.0
+           << ",\"latency\":";
+
+    // Latencies are reported in microseconds.
+
+    const double k_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+    const bsl::size_t k_NUM_QUANTILES =
+        sizeof k_QUANTILES / sizeof k_QUANTILES[0];
+
+    double quantiles[k_NUM_QUANTILES] = {0, 0, 0, 0};
+
+    const bsl::uint64_t numLatencies =
+        d_result.loadLatency(quantiles, k_QUANTILES, k_NUM_QUANTILES);
+
+    if (numLatencies == 0) {
+        stream << "null";
+    }
+    else {
+        stream << "{\"mean\":"
+               << static_cast<double>(d_result.latencyTotal()) /
+                      static_cast<double>(numLatencies) / 1000.0
+               << ",\"p50\":" << quantiles[0] / 1000.0
+               << ",\"p90\":" << quantiles[1] / 1000.0
+               << ",\"p99\":" << quantiles[2] / 1000.0
+               << ",\"p999\":" << quantiles[3] / 1000.0 << ",\"max\":"
+               << static_cast<double>(d_result.latencyMaximum()) / 1000.0
+               << "}";
+    }
+
+    stream << "}";
+}
+
+}  // close namespace example
+
+void help()
+{
+    bsl::cout
+        << "usage: ntcu17.tsk [-v <level>] [-d <driver>] [-w <workload>]"
+           " [-c <connections>] [-s <size>] [-r <size>] [-p <depth>]"
+           " [-t <threads>] [-D <seconds>]\n"
+           "\n"
+           "    -d, --driver       The driver to benchmark, or 'all' for"
+           " each supported\n"
+           "                       driver (default: all)\n"
+           "    -w, --workload     One of 'echo', 'rpc', 'stream',"
+           " 'datagram', or 'all'\n"
+           "                       (default: all)\n"
+           "    -c, --connections  The number of connections (default:"
+           " 16)\n"
+           "    -s, --size         The size of each message, in bytes"
+           " (default: 64)\n"
+           "    -r, --response     The size of each response of the 'rpc'"
+           " workload, in\n"
+           "                       bytes (default: 64)\n"
+           "    -p, --pipeline     The number of messages in flight per"
+           " connection\n"
+           "                       (default: 1)\n"
+           "    -t, --threads      The number of threads of the client and"
+           " of the\n"
+           "                       server (default: 1)\n"
+           "    -D, --duration     The duration of each run, in seconds"
+           " (default: 2)\n"
+        << bsl::flush;
+}
+
+int main(int argc, char** argv)
+{
+    int                 verbosity    = 0;
+    bsl::string         driverName   = "all";
+    bsl::string         workloadName = "all";
+    example::Parameters parameters;
+    {
+        int i = 1;
+        while (i < argc) {
+            if ((0 == std::strcmp(argv[i], "-?")) ||
+                (0 == std::strcmp(argv[i], "--help")))
+            {
+                help();
+                return 0;
+            }
+
+            if (i + 1 >= argc) {
+                help();
+                return 1;
+            }
+
+            const char* option = argv[i];
+            const char* value  = argv[i + 1];
+            i += 2;
+
+            if (0 == std::strcmp(option, "-v") ||
+                0 == std::strcmp(option, "--verbosity"))
+            {
+                verbosity = std::atoi(value);
+            }
+            else if (0 == std::strcmp(option, "-d") ||
+                     0 == std::strcmp(option, "--driver"))
+            {
+                driverName = value;
+            }
+            else if (0 == std::strcmp(option, "-w") ||
+                     0 == std::strcmp(option, "--workload"))
+            {
+                workloadName = value;
+            }
+            else if (0 == std::strcmp(option, "-c") ||
+                     0 == std::strcmp(option, "--connections"))
+            {
+                parameters.d_numConnections =
+                    static_cast<bsl::size_t>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(option, "-s") ||
+                     0 == std::strcmp(option, "--size"))
+            {
+                parameters.d_messageSize =
+                    static_cast<bsl::size_t>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(option, "-r") ||
+                     0 == std::strcmp(option, "--response"))
+            {
+                parameters.d_responseSize =
+                    static_cast<bsl::size_t>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(option, "-p") ||
+                     0 == std::strcmp(option, "--pipeline"))
+            {
+                parameters.d_pipeline =
+                    static_cast<bsl::size_t>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(option, "-t") ||
+                     0 == std::strcmp(option, "--threads"))
+            {
+                parameters.d_numThreads =
+                    static_cast<bsl::size_t>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(option, "-D") ||
+                     0 == std::strcmp(option, "--duration"))
+            {
+                parameters.d_duration.setInterval(std::atoi(value), 0);
+            }
+            else {
+                bsl::cerr << "Invalid option: " << option << bsl::endl;
+                return 1;
+            }
+        }
+    }
+
+    if (parameters.d_numConnections == 0 || parameters.d_messageSize == 0 ||
+        parameters.d_responseSize == 0 || parameters.d_pipeline == 0 ||
+        parameters.d_numThreads == 0)
+    {
+        help();
+        return 1;
+    }
+
+    switch (verbosity) {
+    case 0:
+        break;
+    case 1:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_ERROR);
+        break;
+    case 2:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_WARN);
+        break;
+    case 3:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_INFO);
+        break;
+    case 4:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_DEBUG);
+        break;
+    default:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_TRACE);
+        break;
+    }
+
+    ntcf::System::initialize();
+    ntcf::System::ignore(ntscfg::Signal::e_PIPE);
+
+    bsl::vector<bsl::string> driverNames;
+    if (driverName == "all") {
+        ntcf::System::loadDriverSupport(&driverNames, false);
+    }
+    else if (ntcf::System::testDriverSupport(driverName, false)) {
+        driverNames.push_back(driverName);
+    }
+    else {
+        bsl::cerr << "Unsupported driver: " << driverName << bsl::endl;
+        return 1;
+    }
+
+    bsl::vector<example::Workload::Value> workloads;
+    if (workloadName == "all") {
+        workloads.push_back(example::Workload::e_ECHO);
+        workloads.push_back(example::Workload::e_RPC);
+        workloads.push_back(example::Workload::e_STREAM);
+        workloads.push_back(example::Workload::e_DATAGRAM);
+    }
+    else {
+        example::Workload::Value workload;
+        if (!example::Workload::fromString(&workload, workloadName)) {
+            bsl::cerr << "Invalid workload: " << workloadName << bsl::endl;
+            return 1;
+        }
+        workloads.push_back(workload);
+    }
+
+    // The largest payload of a UDP datagram over IPv4.
+
+    const bsl::size_t k_MAX_DATAGRAM_SIZE = 65507;
+
+    bsl::cout << "{\"runs\":[";
+
+    bool first = true;
+    for (bsl::size_t i = 0; i < driverNames.size(); ++i) {
+        for (bsl::size_t j = 0; j < workloads.size(); ++j) {
+            example::Parameters runParameters = parameters;
+            runParameters.d_driverName        = driverNames[i];
+            runParameters.d_workload          = workloads[j];
+
+            if (runParameters.d_workload == example::Workload::e_DATAGRAM &&
+                runParameters.d_messageSize > k_MAX_DATAGRAM_SIZE)
+            {
+                bsl::cerr << "Skipping datagram workload: message size "
+                          << runParameters.d_messageSize
+                          << " exceeds the maximum datagram size"
+                          << bsl::endl;
+                continue;
+            }
+
+            bsl::cerr << "Running "
+                      << example::Workload::toString(runParameters.d_workload)
+                      << " on " << runParameters.d_driverName << bsl::endl;
+
+            if (!first) {
+                bsl::cout << ",";
+            }
+            first = false;
+
+            bsl::cout << "\n";
+
+            example::Benchmark benchmark(runParameters);
+            benchmark.run(bsl::cout);
+
+            bsl::cout << bsl::flush;
+        }
+    }
+
+    bsl::cout << "\n]}" << bsl::endl;
+
+    return 0;
+}
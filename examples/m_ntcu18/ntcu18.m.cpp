@@ -0,0 +1,967 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntccfg_bind.h>
+#include <ntci_metric.h>
+#include <ntcq_receive.h>
+#include <ntcq_send.h>
+#include <ntcq_zerocopy.h>
+#include <ntcs_chronology.h>
+#include <ntcs_datapool.h>
+#include <ntcs_driver.h>
+#include <ntcs_ratelimiter.h>
+#include <ntcs_strand.h>
+#include <ntcf_system.h>
+#include <bdlbb_blob.h>
+#include <bdlbb_blobutil.h>
+#include <bdlf_bind.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslmt_barrier.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+#include <bsls_atomic.h>
+#include <bsls_systemtime.h>
+#include <bsls_timeinterval.h>
+#include <bsls_timeutil.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+
+namespace example {
+
+//
+// Microbenchmarking the Core Data Structures
+//
+// This example measures the rate of the operations of the data structures
+// on the hot path of each socket and each reactor or proactor thread:
+//
+// sendQueue:     Push an entry onto, and pop an entry from, the write queue
+//                of a stream socket, at a shallow and a deep queue depth.
+//
+// receiveQueue:  Push an entry onto, and pop an entry from, the read queue
+//                of a datagram socket.
+//
+// zeroCopyQueue: Push a zero-copy send, frame it, complete it, and pop its
+//                completion.
+//
+// chronology:    Reschedule a timer among few and among many other
+//                scheduled timers, so that the cost of the skip list
+//                lookup across a working set larger than the cache is
+//                visible, and defer and announce a function.
+//
+// strand:        Execute a function on a strand, from one thread and from
+//                many threads at once.
+//
+// dataPool:      Create and release incoming blobs and outgoing data.
+//
+// rateLimiter:   Test and submit to a rate limiter, from one thread and
+//                from many threads at once.
+//
+// metric:        Update a metric and a metric histogram, from one thread
+//                and from many threads at once, both when the threads share
+//                one object and when each thread updates its own object.
+//
+// Each benchmark is run for a fixed number of iterations per thread. The
+// number of nanoseconds per operation, the number of operations per
+// second, and the number of allocations per operation are reported as a
+// JSON document on standard output so that the results of different builds
+// may be compared.
+//
+
+// Provide an allocator that counts the number of allocations it makes.
+class CountingAllocator : public bslma::Allocator
+{
+    bsls::AtomicUint64 d_numAllocations;
+    bslma::Allocator*  d_allocator_p;
+
+  public:
+    // Create a new counting allocator that supplies memory from the specified
+    // 'basicAllocator'.
+    explicit CountingAllocator(bslma::Allocator* basicAllocator)
+    : d_numAllocations(0)
+    , d_allocator_p(basicAllocator)
+    {
+    }
+
+    // Return a newly allocated block of at least the specified 'size'.
+    void* allocate(size_type size) BSLS_KEYWORD_OVERRIDE
+    {
+        d_numAllocations.addRelaxed(1);
+        return d_allocator_p->allocate(size);
+    }
+
+    // Return the block at the specified 'address' to this allocator.
+    void deallocate(void* address) BSLS_KEYWORD_OVERRIDE
+    {
+        d_allocator_p->deallocate(address);
+    }
+
+    // Return the number of allocations made by this allocator.
+    bsl::uint64_t numAllocations() const
+    {
+        return d_numAllocations.load();
+    }
+};
+
+// Define a type alias for a function that performs the specified number of
+// iterations of a benchmark on the thread having the specified index.
+typedef bsl::function<void(bsl::size_t threadIndex, bsl::size_t count)>
+    Workload;
+
+// Provide a runner of benchmarks that reports the results of each as a
+// JSON object.
+class Runner
+{
+    CountingAllocator* d_allocator_p;
+    bsl::size_t        d_numIterations;
+    bsl::size_t        d_numThreads;
+    bsl::string        d_filter;
+    bool               d_first;
+
+  private:
+    // Run the specified 'workload' once on each of the specified
+    // 'numThreads' threads, each released at the same time, and return the
+    // elapsed nanoseconds.
+    bsls::Types::Int64 execute(const Workload& workload,
+                               bsl::size_t     numThreads);
+
+  public:
+    // Create a new runner that performs the specified 'numIterations' of
+    // each benchmark on each thread, runs each contended benchmark on the
+    // specified 'numThreads', runs only those benchmarks whose name
+    // contains the specified 'filter', and counts the allocations from the
+    // specified 'allocator'.
+    Runner(CountingAllocator* allocator,
+           bsl::size_t        numIterations,
+           bsl::size_t        numThreads,
+           const bsl::string& filter)
+    : d_allocator_p(allocator)
+    , d_numIterations(numIterations)
+    , d_numThreads(numThreads)
+    , d_filter(filter)
+    , d_first(true)
+    {
+    }
+
+    // Run the specified 'workload' on one thread and report its results
+    // under the specified 'name'.
+    void run(const char* name, const Workload& workload)
+    {
+        this->run(name, workload, 1);
+    }
+
+    // Run the specified 'workload' on the specified 'numThreads' and report
+    // its results under the specified 'name'.
+    void run(const char*     name,
+             const Workload& workload,
+             bsl::size_t     numThreads);
+
+    // Return the number of threads on which to run a contended benchmark.
+    bsl::size_t numThreads() const
+    {
+        return d_numThreads;
+    }
+
+    // Return the number of iterations of each benchmark on each thread.
+    bsl::size_t numIterations() const
+    {
+        return d_numIterations;
+    }
+
+    // Return the allocator whose allocations are counted.
+    bslma::Allocator* allocator() const
+    {
+        return d_allocator_p;
+    }
+};
+
+bsls::Types::Int64 Runner::execute(const Workload& workload,
+                                   bsl::size_t     numThreads)
+{
+    if (numThreads == 1) {
+        const bsls::Types::Int64 startTime = bsls::TimeUtil::getTimer();
+        workload(0, d_numIterations);
+        return bsls::TimeUtil::getTimer() - startTime;
+    }
+
+    struct Thread {
+        static void main(bslmt::Barrier* barrier,
+                         const Workload* workload,
+                         bsl::size_t     threadIndex,
+                         bsl::size_t     count)
+        {
+            barrier->wait();
+            (*workload)(threadIndex, count);
+        }
+    };
+
+    bslmt::Barrier     barrier(static_cast<int>(numThreads + 1));
+    bslmt::ThreadGroup threadGroup;
+
+    for (bsl::size_t i = 0; i < numThreads; ++i) {
+        int rc = threadGroup.addThread(bdlf::BindUtil::bind(&Thread::main,
+                                                            &barrier,
+                                                            &workload,
+                                                            i,
+                                                            d_numIterations));
+        BSLS_ASSERT_OPT(rc == 0);
+    }
+
+    barrier.wait();
+
+    const bsls::Types::Int64 startTime = bsls::TimeUtil::getTimer();
+    threadGroup.joinAll();
+    return bsls::TimeUtil::getTimer() - startTime;
+}
+
+void Runner::run(const char*     name,
+                 const Workload& workload,
+                 bsl::size_t     numThreads)
+{
+    if (!d_filter.empty() && bsl::strstr(name, d_filter.c_str()) == 0) {
+        return;
+    }
+
+    bsl::cerr << "Running " << name << " on " << numThreads << " thread(s)"
+              << bsl::endl;
+
+    // Warm up the caches, the pools, and the branch predictors before
+    // measuring.
+
+    this->execute(workload, numThreads);
+
+    const bsl::uint64_t allocationsBefore = d_allocator_p->numAllocations();
+
+    const bsls::Types::Int64 elapsed = this->execute(workload, numThreads);
+
+    const bsl::uint64_t numAllocations =
+        d_allocator_p->numAllocations() - allocationsBefore;
+
+    const double numOperations =
+        static_cast<double>(d_numIterations * numThreads);
+
+    if (!d_first) {
+        bsl::cout << ",";
+    }
+    d_first = false;
+
+    bsl::cout << "\n{\"name\":\"" << name << "\""
+              << ",\"threads\":" << numThreads
+              << ",\"operations\":" << d_numIterations * numThreads
+              << ",\"nanosecondsPerOperation\":"
+              << static_cast<double>(elapsed) /
+                     static_cast<double>(d_numIterations)
+              << ",\"operationsPerSecond\":"
+              << numOperations * 1000000000.0 / static_cast<double>(elapsed)
+              << ",\"allocationsPerOperation\":"
+              << static_cast<double>(numAllocations) / numOperations << "}"
+              << bsl::flush;
+}
+
+// Provide an interruptor that does nothing, to drive a chronology directly
+// from the benchmark thread.
+class Interruptor : public ntcs::Interruptor
+{
+  public:
+    // Do nothing.
+    void interruptOne() BSLS_KEYWORD_OVERRIDE
+    {
+    }
+
+    // Do nothing.
+    void interruptAll() BSLS_KEYWORD_OVERRIDE
+    {
+    }
+
+    // Return the handle of the calling thread.
+    bslmt::ThreadUtil::Handle threadHandle() const BSLS_KEYWORD_OVERRIDE
+    {
+        return bslmt::ThreadUtil::self();
+    }
+
+    // Return 0.
+    bsl::size_t threadIndex() const BSLS_KEYWORD_OVERRIDE
+    {
+        return 0;
+    }
+};
+
+// Provide an executor that invokes each function immediately on the
+// calling thread.
+class Executor : public ntci::Executor
+{
+  public:
+    // Invoke the specified 'functor'.
+    void execute(const Functor& functor) BSLS_KEYWORD_OVERRIDE
+    {
+        functor();
+    }
+
+    // Invoke each function in the specified 'functorSequence' then the
+    // specified 'functor'.
+    void moveAndExecute(FunctorSequence* functorSequence,
+                        const Functor&   functor) BSLS_KEYWORD_OVERRIDE
+    {
+        FunctorSequence sequence;
+        sequence.swap(*functorSequence);
+
+        for (FunctorSequence::iterator it = sequence.begin();
+             it != sequence.end();
+             ++it)
+        {
+            (*it)();
+        }
+
+        if (functor) {
+            functor();
+        }
+    }
+};
+
+// Provide a generator of a pseudo-random sequence, cheap enough not to
+// perturb the measurement of the operation it selects inputs for.
+class Random
+{
+    bsl::uint64_t d_state;
+
+  public:
+    // Create a new sequence determined by the specified 'seed'.
+    explicit Random(bsl::uint64_t seed)
+    : d_state(seed | 1)
+    {
+    }
+
+    // Return the next number in the sequence.
+    bsl::uint64_t next()
+    {
+        d_state ^= d_state << 13;
+        d_state ^= d_state >> 7;
+        d_state ^= d_state << 17;
+        return d_state;
+    }
+};
+
+// Do nothing.
+void processSend(const bsl::shared_ptr<ntci::Sender>& sender,
+                 const ntca::SendEvent&               event)
+{
+    NTCCFG_WARNING_UNUSED(sender);
+    NTCCFG_WARNING_UNUSED(event);
+}
+
+// Do nothing.
+void processTimer(const bsl::shared_ptr<ntci::Timer>& timer,
+                  const ntca::TimerEvent&             event)
+{
+    NTCCFG_WARNING_UNUSED(timer);
+    NTCCFG_WARNING_UNUSED(event);
+}
+
+// Increment the specified 'counter'.
+void increment(bsl::uint64_t* counter)
+{
+    ++*counter;
+}
+
+// Push onto and pop from the specified 'sendQueue' an entry of the
+// specified 'data' the specified 'count' number of times.
+void runSendQueue(ntcq::SendQueue*                   sendQueue,
+                  const bsl::shared_ptr<ntsa::Data>& data,
+                  bsl::size_t                        count)
+{
+    for (bsl::size_t i = 0; i < count; ++i) {
+        ntcq::SendQueueEntry entry;
+        entry.setId(sendQueue->generateEntryId());
+        entry.setData(data);
+        entry.setLength(data->size());
+
+        sendQueue->pushEntry(entry);
+        sendQueue->popEntry();
+    }
+}
+
+// Benchmark the send queue.
+void benchmarkSendQueue(Runner* runner)
+{
+    bslma::Allocator* allocator = runner->allocator();
+
+    bsl::shared_ptr<ntcs::DataPool> dataPool;
+    dataPool.createInplace(allocator, allocator);
+
+    bsl::shared_ptr<bdlbb::Blob> blob = dataPool->createOutgoingBlob();
+    bdlbb::BlobUtil::append(blob.get(), "0123456789abcdef", 16);
+
+    bsl::shared_ptr<ntsa::Data> data;
+    data.createInplace(allocator, *blob, allocator);
+
+    const bsl::size_t k_DEPTH[] = {1, 4096};
+
+    for (bsl::size_t i = 0; i < 2; ++i) {
+        ntcq::SendQueue sendQueue(allocator);
+
+        for (bsl::size_t j = 1; j < k_DEPTH[i]; ++j) {
+            ntcq::SendQueueEntry entry;
+            entry.setId(sendQueue.generateEntryId());
+            entry.setData(data);
+            entry.setLength(data->size());
+
+            sendQueue.pushEntry(entry);
+        }
+
+        runner->run(i == 0 ? "sendQueue.pushPop.depth1"
+                           : "sendQueue.pushPop.depth4096",
+                    bdlf::BindUtil::bind(&runSendQueue,
+                                         &sendQueue,
+                                         data,
+                                         bdlf::PlaceHolders::_2));
+    }
+}
+
+// Push onto and pop from the specified 'receiveQueue' an entry of the
+// specified 'data' the specified 'count' number of times.
+void runReceiveQueue(ntcq::ReceiveQueue*                 receiveQueue,
+                     const bsl::shared_ptr<bdlbb::Blob>& data,
+                     bsl::size_t                         count)
+{
+    for (bsl::size_t i = 0; i < count; ++i) {
+        ntcq::ReceiveQueueEntry entry;
+        entry.setData(data);
+        entry.setLength(static_cast<bsl::size_t>(data->length()));
+        entry.setTimestamp(0);
+
+        receiveQueue->pushEntry(entry);
+        receiveQueue->popEntry();
+    }
+}
+
+// Benchmark the receive queue.
+void benchmarkReceiveQueue(Runner* runner)
+{
+    bslma::Allocator* allocator = runner->allocator();
+
+    bsl::shared_ptr<ntcs::DataPool> dataPool;
+    dataPool.createInplace(allocator, allocator);
+
+    bsl::shared_ptr<bdlbb::Blob> blob = dataPool->createIncomingBlob();
+    bdlbb::BlobUtil::append(blob.get(), "0123456789abcdef", 16);
+
+    ntcq::ReceiveQueue receiveQueue(allocator);
+
+    runner->run("receiveQueue.pushPop",
+                bdlf::BindUtil::bind(&runReceiveQueue,
+                                     &receiveQueue,
+                                     blob,
+                                     bdlf::PlaceHolders::_2));
+}
+
+// Push, frame, complete, and pop a zero-copy send of the specified 'blob'
+// on the specified 'zeroCopyQueue' the specified 'count' number of times,
+// using the specified 'group' and 'counter' to track the sequence of
+// sends.
+void runZeroCopyQueue(ntcq::ZeroCopyQueue*      zeroCopyQueue,
+                      const bdlbb::Blob*        blob,
+                      const ntci::SendCallback* callback,
+                      ntcq::SendCounter*        group,
+                      bsl::size_t               count)
+{
+    for (bsl::size_t i = 0; i < count; ++i) {
+        const ntcq::ZeroCopyCounter counter =
+            zeroCopyQueue->push(*group,
+                                *blob,
+                                ntca::SendContext(),
+                                *callback);
+
+        zeroCopyQueue->frame(*group);
+
+        zeroCopyQueue->update(ntsa::ZeroCopy(static_cast<bsl::uint32_t>(
+                                                 counter),
+                                             static_cast<bsl::uint32_t>(
+                                                 counter),
+                                             ntsa::ZeroCopyType::e_AVOIDED));
+
+        ntca::SendContext  context;
+        ntci::SendCallback completion;
+        zeroCopyQueue->pop(&context, &completion);
+
+        ++*group;
+    }
+}
+
+// Benchmark the zero-copy queue.
+void benchmarkZeroCopyQueue(Runner* runner)
+{
+    bslma::Allocator* allocator = runner->allocator();
+
+    bsl::shared_ptr<ntcs::DataPool> dataPool;
+    dataPool.createInplace(allocator, allocator);
+
+    bsl::shared_ptr<bdlbb::Blob> blob = dataPool->createOutgoingBlob();
+    bdlbb::BlobUtil::append(blob.get(), "0123456789abcdef", 16);
+
+    ntci::SendCallback callback(ntci::SendFunction(&processSend), allocator);
+
+    ntcq::ZeroCopyQueue zeroCopyQueue(dataPool, allocator);
+    ntcq::SendCounter   group = 0;
+
+    runner->run("zeroCopyQueue.pushUpdatePop",
+                bdlf::BindUtil::bind(&runZeroCopyQueue,
+                                     &zeroCopyQueue,
+                                     blob.get(),
+                                     &callback,
+                                     &group,
+                                     bdlf::PlaceHolders::_2));
+}
+
+// Reschedule a timer selected at random from the specified 'timers' to a
+// deadline selected at random within the next hour, the specified 'count'
+// number of times, using the specified 'random' sequence.
+void runChronologyReschedule(
+    const bsl::vector<bsl::shared_ptr<ntci::Timer> >* timers,
+    Random*                                           random,
+    bsl::size_t                                       count)
+{
+    const bsls::TimeInterval now = bsls::SystemTime::nowMonotonicClock();
+
+    for (bsl::size_t i = 0; i < count; ++i) {
+        const bsl::uint64_t value = random->next();
+
+        const bsl::shared_ptr<ntci::Timer>& timer =
+            (*timers)[value % timers->size()];
+
+        bsls::TimeInterval deadline = now;
+        deadline.addSeconds(3600);
+        deadline.addNanoseconds(
+            static_cast<bsls::Types::Int64>(value % 3600000000000ULL));
+
+        timer->schedule(deadline);
+    }
+}
+
+// Defer a function to, then announce, the specified 'chronology' the
+// specified 'count' number of times, incrementing the specified
+// 'counter'.
+void runChronologyDefer(ntcs::Chronology* chronology,
+                        bsl::uint64_t*    counter,
+                        bsl::size_t       count)
+{
+    for (bsl::size_t i = 0; i < count; ++i) {
+        chronology->execute(bdlf::BindUtil::bind(&increment, counter));
+        chronology->announce();
+    }
+}
+
+// Benchmark the chronology.
+void benchmarkChronology(Runner* runner)
+{
+    bslma::Allocator* allocator = runner->allocator();
+
+    Interruptor interruptor;
+
+    const bsl::size_t k_NUM_TIMERS[] = {16, 65536};
+
+    for (bsl::size_t i = 0; i < 2; ++i) {
+        ntcs::Chronology chronology(&interruptor, allocator);
+
+        ntca::TimerOptions timerOptions;
+        timerOptions.setOneShot(false);
+
+        ntci::TimerCallback timerCallback(ntci::TimerFunction(&processTimer),
+                                          allocator);
+
+        bsl::vector<bsl::shared_ptr<ntci::Timer> > timers(allocator);
+        timers.reserve(k_NUM_TIMERS[i]);
+
+        Random random(i + 1);
+
+        for (bsl::size_t j = 0; j < k_NUM_TIMERS[i]; ++j) {
+            timers.push_back(chronology.createTimer(timerOptions,
+                                                    timerCallback,
+                                                    allocator));
+        }
+
+        runChronologyReschedule(&timers, &random, timers.size());
+
+        runner->run(i == 0 ? "chronology.reschedule.timers16"
+                           : "chronology.reschedule.timers65536",
+                    bdlf::BindUtil::bind(&runChronologyReschedule,
+                                         &timers,
+                                         &random,
+                                         bdlf::PlaceHolders::_2));
+
+        for (bsl::size_t j = 0; j < timers.size(); ++j) {
+            timers[j]->close();
+        }
+
+        chronology.announce();
+        timers.clear();
+        chronology.clear();
+    }
+
+    {
+        ntcs::Chronology chronology(&interruptor, allocator);
+        bsl::uint64_t    counter = 0;
+
+        runner->run("chronology.deferAnnounce",
+                    bdlf::BindUtil::bind(&runChronologyDefer,
+                                         &chronology,
+                                         &counter,
+                                         bdlf::PlaceHolders::_2));
+    }
+}
+
+// Execute a function that increments the specified 'counter' on the
+// specified 'strand' the specified 'count' number of times.
+void runStrand(ntcs::Strand*       strand,
+               bsls::AtomicUint64* counter,
+               bsl::size_t         count)
+{
+    for (bsl::size_t i = 0; i < count; ++i) {
+        strand->execute(bdlf::BindUtil::bind(&bsls::AtomicUint64::addRelaxed,
+                                             counter,
+                                             1));
+    }
+}
+
+// Benchmark the strand.
+void benchmarkStrand(Runner* runner)
+{
+    bslma::Allocator* allocator = runner->allocator();
+
+    bsl::shared_ptr<Executor> executor;
+    executor.createInplace(allocator);
+
+    bsl::shared_ptr<ntcs::Strand> strand;
+    strand.createInplace(allocator, executor, allocator);
+
+    bsls::AtomicUint64 counter(0);
+
+    Workload workload = bdlf::BindUtil::bind(&runStrand,
+                                             strand.get(),
+                                             &counter,
+                                             bdlf::PlaceHolders::_2);
+
+    runner->run("strand.execute", workload);
+    runner->run("strand.execute.contended", workload, runner->numThreads());
+}
+
+// Create and release an incoming blob and an outgoing data container from
+// the specified 'dataPool' the specified 'count' number of times.
+void runDataPool(ntcs::DataPool* dataPool, bsl::size_t count)
+{
+    for (bsl::size_t i = 0; i < count; ++i) {
+        bsl::shared_ptr<bdlbb::Blob> blob = dataPool->createIncomingBlob();
+        bsl::shared_ptr<ntsa::Data>  data = dataPool->createOutgoingData();
+    }
+}
+
+// Create the specified 'count' number of incoming blobs from the specified
+// 'dataPool' before releasing any, so that the pool must grow and each
+// access touches memory not recently used.
+void runDataPoolWorkingSet(ntcs::DataPool* dataPool, bsl::size_t count)
+{
+    bsl::vector<bsl::shared_ptr<bdlbb::Blob> > blobs;
+    blobs.reserve(count);
+
+    for (bsl::size_t i = 0; i < count; ++i) {
+        blobs.push_back(dataPool->createIncomingBlob());
+    }
+}
+
+// Benchmark the data pool.
+void benchmarkDataPool(Runner* runner)
+{
+    bslma::Allocator* allocator = runner->allocator();
+
+    ntcs::DataPool dataPool(allocator);
+
+    Workload workload = bdlf::BindUtil::bind(&runDataPool,
+                                             &dataPool,
+                                             bdlf::PlaceHolders::_2);
+
+    runner->run("dataPool.create", workload);
+    runner->run("dataPool.create.contended", workload, runner->numThreads());
+
+    runner->run("dataPool.create.workingSet",
+                bdlf::BindUtil::bind(&runDataPoolWorkingSet,
+                                     &dataPool,
+                                     bdlf::PlaceHolders::_2));
+}
+
+// Test whether the specified 'rateLimiter' would exceed its bandwidth and,
+// if not, submit a unit to it, the specified 'count' number of times.
+void runRateLimiter(ntcs::RateLimiter* rateLimiter, bsl::size_t count)
+{
+    for (bsl::size_t i = 0; i < count; ++i) {
+        const bsls::TimeInterval now = bsls::SystemTime::nowMonotonicClock();
+        if (!rateLimiter->wouldExceedBandwidth(now)) {
+            rateLimiter->submit(1);
+        }
+    }
+}
+
+// Benchmark the rate limiter.
+void benchmarkRateLimiter(Runner* runner)
+{
+    ntcs::RateLimiter rateLimiter(1000000000,
+                                  bsls::TimeInterval(1, 0),
+                                  1000000000,
+                                  bsls::TimeInterval(0, 1000000),
+                                  bsls::SystemTime::nowMonotonicClock());
+
+    Workload workload = bdlf::BindUtil::bind(&runRateLimiter,
+                                             &rateLimiter,
+                                             bdlf::PlaceHolders::_2);
+
+    runner->run("rateLimiter.submit", workload);
+    runner->run("rateLimiter.submit.contended",
+                workload,
+                runner->numThreads());
+}
+
+// Update the metric in the specified 'metrics' at the specified
+// 'threadIndex' times the specified 'stride' the specified 'count' number
+// of times.
+void runMetric(bsl::vector<bsl::shared_ptr<ntci::Metric> >* metrics,
+               bsl::size_t                                  stride,
+               bsl::size_t                                  threadIndex,
+               bsl::size_t                                  count)
+{
+    ntci::Metric* metric = (*metrics)[threadIndex * stride].get();
+
+    for (bsl::size_t i = 0; i < count; ++i) {
+        metric->update(static_cast<double>(i & 1023));
+    }
+}
+
+// Update the histogram in the specified 'histograms' at the specified
+// 'threadIndex' times the specified 'stride' the specified 'count' number
+// of times.
+void runMetricHistogram(
+    bsl::vector<bsl::shared_ptr<ntci::MetricHistogram> >* histograms,
+    bsl::size_t                                           stride,
+    bsl::size_t                                           threadIndex,
+    bsl::size_t                                           count)
+{
+    ntci::MetricHistogram* histogram =
+        (*histograms)[threadIndex * stride].get();
+
+    for (bsl::size_t i = 0; i < count; ++i) {
+        histogram->update(static_cast<double>(i & 1023));
+    }
+}
+
+// Benchmark the metrics.
+void benchmarkMetric(Runner* runner)
+{
+    bslma::Allocator* allocator = runner->allocator();
+
+    const bsl::size_t numThreads = runner->numThreads();
+
+    bsl::vector<bsl::shared_ptr<ntci::Metric> > metrics(allocator);
+    bsl::vector<bsl::shared_ptr<ntci::MetricHistogram> > histograms(
+        allocator);
+
+    for (bsl::size_t i = 0; i < numThreads; ++i) {
+        bsl::shared_ptr<ntci::Metric> metric;
+        metric.createInplace(allocator);
+        metrics.push_back(metric);
+
+        bsl::shared_ptr<ntci::MetricHistogram> histogram;
+        histogram.createInplace(allocator, 0);
+        histograms.push_back(histogram);
+    }
+
+    // A stride of zero directs every thread to the same object; a stride of
+    // one directs each thread to its own.
+
+    runner->run("metric.update",
+                bdlf::BindUtil::bind(&runMetric,
+                                     &metrics,
+                                     0,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2));
+
+    runner->run("metric.update.contended.shared",
+                bdlf::BindUtil::bind(&runMetric,
+                                     &metrics,
+                                     0,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2),
+                numThreads);
+
+    runner->run("metric.update.contended.private",
+                bdlf::BindUtil::bind(&runMetric,
+                                     &metrics,
+                                     1,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2),
+                numThreads);
+
+    runner->run("metricHistogram.update",
+                bdlf::BindUtil::bind(&runMetricHistogram,
+                                     &histograms,
+                                     0,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2));
+
+    runner->run("metricHistogram.update.contended.shared",
+                bdlf::BindUtil::bind(&runMetricHistogram,
+                                     &histograms,
+                                     0,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2),
+                numThreads);
+
+    runner->run("metricHistogram.update.contended.private",
+                bdlf::BindUtil::bind(&runMetricHistogram,
+                                     &histograms,
+                                     1,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2),
+                numThreads);
+}
+
+}  // close namespace example
+
+void help()
+{
+    bsl::cout << "usage: ntcu18.tsk [-v <level>] [-n <iterations>]"
+                 " [-t <threads>] [-f <filter>]\n"
+                 "\n"
+                 "    -n, --iterations  The number of iterations of each"
+                 " benchmark on each\n"
+                 "                      thread (default: 100000)\n"
+                 "    -t, --threads     The number of threads of each"
+                 " contended benchmark\n"
+                 "                      (default: 4)\n"
+                 "    -f, --filter      Run only the benchmarks whose name"
+                 " contains this\n"
+                 "                      string (default: run all)\n"
+              << bsl::flush;
+}
+
+int main(int argc, char** argv)
+{
+    int         verbosity     = 0;
+    bsl::size_t numIterations = 100000;
+    bsl::size_t numThreads    = 4;
+    bsl::string filter;
+    {
+        int i = 1;
+        while (i < argc) {
+            if ((0 == std::strcmp(argv[i], "-?")) ||
+                (0 == std::strcmp(argv[i], "--help")))
+            {
+                help();
+                return 0;
+            }
+
+            if (i + 1 >= argc) {
+                help();
+                return 1;
+            }
+
+            const char* option = argv[i];
+            const char* value  = argv[i + 1];
+            i += 2;
+
+            if (0 == std::strcmp(option, "-v") ||
+                0 == std::strcmp(option, "--verbosity"))
+            {
+                verbosity = std::atoi(value);
+            }
+            else if (0 == std::strcmp(option, "-n") ||
+                     0 == std::strcmp(option, "--iterations"))
+            {
+                numIterations = static_cast<bsl::size_t>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(option, "-t") ||
+                     0 == std::strcmp(option, "--threads"))
+            {
+                numThreads = static_cast<bsl::size_t>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(option, "-f") ||
+                     0 == std::strcmp(option, "--filter"))
+            {
+                filter = value;
+            }
+            else {
+                bsl::cerr << "Invalid option: " << option << bsl::endl;
+                return 1;
+            }
+        }
+    }
+
+    if (numIterations == 0 || numThreads == 0) {
+        help();
+        return 1;
+    }
+
+    switch (verbosity) {
+    case 0:
+        break;
+    case 1:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_ERROR);
+        break;
+    case 2:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_WARN);
+        break;
+    case 3:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_INFO);
+        break;
+    case 4:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_DEBUG);
+        break;
+    default:
+        bsls::Log::setSeverityThreshold(bsls::LogSeverity::e_TRACE);
+        break;
+    }
+
+    ntcf::System::initialize();
+
+    // Count every allocation, including those each data structure makes
+    // from the default allocator rather than the allocator it is given.
+
+    example::CountingAllocator allocator(
+        &bslma::NewDeleteAllocator::singleton());
+
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&allocator);
+
+    example::Runner runner(&allocator, numIterations, numThreads, filter);
+
+    bsl::cout << "{\"benchmarks\":[";
+
+    example::benchmarkSendQueue(&runner);
+    example::benchmarkReceiveQueue(&runner);
+    example::benchmarkZeroCopyQueue(&runner);
+    example::benchmarkChronology(&runner);
+    example::benchmarkStrand(&runner);
+    example::benchmarkDataPool(&runner);
+    example::benchmarkRateLimiter(&runner);
+    example::benchmarkMetric(&runner);
+
+    bsl::cout << "\n]}" << bsl::endl;
+
+    return 0;
+}
@@ -28,6 +28,7 @@ bool ConnectContext::equals(const ConnectContext& other) const
     return (d_endpoint == other.d_endpoint && d_name == other.d_name &&
             d_latency == other.d_latency && d_source == other.d_source &&
             d_nameServer == other.d_nameServer &&
+            d_ipAddressType == other.d_ipAddressType &&
             d_attemptsRemaining == other.d_attemptsRemaining &&
             d_error == other.d_error);
 }
@@ -74,6 +75,14 @@ bool ConnectContext::less(const ConnectContext& other) const
         return false;
     }
 
+    if (d_ipAddressType < other.d_ipAddressType) {
+        return true;
+    }
+
+    if (other.d_ipAddressType < d_ipAddressType) {
+        return false;
+    }
+
     if (d_attemptsRemaining < other.d_attemptsRemaining) {
         return true;
     }
@@ -112,6 +121,10 @@ bsl::ostream& ConnectContext::print(bsl::ostream& stream,
         printer.printAttribute("nameServer", d_nameServer);
     }
 
+    if (!d_ipAddressType.isNull()) {
+        printer.printAttribute("ipAddressType", d_ipAddressType);
+    }
+
     if (d_error) {
         printer.printAttribute("attemptsRemaining", d_attemptsRemaining);
         printer.printAttribute("error", d_error);
@@ -24,6 +24,7 @@ BSLS_IDENT("$Id: $")
 #include <ntcscm_version.h>
 #include <ntsa_endpoint.h>
 #include <ntsa_error.h>
+#include <ntsa_ipaddresstype.h>
 #include <bdlb_nullablevalue.h>
 #include <bslh_hash.h>
 #include <bsls_timeinterval.h>
@@ -52,6 +53,12 @@ namespace ntca {
 /// @li @b nameServer:
 /// The endpoint of the name server that resolved the domain name, if any.
 ///
+/// @li @b ipAddressType:
+/// The address family of the endpoint to which the socket was connected, if
+/// the endpoint is an IP endpoint. When connecting according to the
+/// "Happy Eyeballs" strategy, this attribute indicates which address family
+/// won the race.
+///
 /// @li @b attemptsRemaining:
 /// The number of connection retry attempts remaining.
 ///
@@ -69,6 +76,7 @@ class ConnectContext
     bdlb::NullableValue<bsls::TimeInterval>          d_latency;
     bdlb::NullableValue<ntca::ResolverSource::Value> d_source;
     bdlb::NullableValue<ntsa::Endpoint>              d_nameServer;
+    bdlb::NullableValue<ntsa::IpAddressType::Value>  d_ipAddressType;
     bsl::size_t                                      d_attemptsRemaining;
     ntsa::Error                                      d_error;
 
@@ -116,6 +124,10 @@ class ConnectContext
     /// the specified 'value'.
     void setNameServer(const ntsa::Endpoint& value);
 
+    /// Set the address family of the endpoint to which the socket was
+    /// connected to the specified 'value'.
+    void setIpAddressType(ntsa::IpAddressType::Value value);
+
     /// Set the number of connection retry attempts remaining to the
     /// specified 'value'.
     void setAttemptsRemaining(bsl::size_t value);
@@ -140,6 +152,11 @@ class ConnectContext
     /// name.
     const bdlb::NullableValue<ntsa::Endpoint>& nameServer() const;
 
+    /// Return the address family of the endpoint to which the socket was
+    /// connected.
+    const bdlb::NullableValue<ntsa::IpAddressType::Value>& ipAddressType()
+        const;
+
     /// Return the number of connection retry attempts remaining.
     bsl::size_t attemptsRemaining() const;
 
@@ -213,6 +230,7 @@ ConnectContext::ConnectContext(bslma::Allocator* basicAllocator)
 , d_latency()
 , d_source()
 , d_nameServer()
+, d_ipAddressType()
 , d_attemptsRemaining(0)
 , d_error()
 {
@@ -226,6 +244,7 @@ ConnectContext::ConnectContext(const ConnectContext& original,
 , d_latency(original.d_latency)
 , d_source(original.d_source)
 , d_nameServer(original.d_nameServer)
+, d_ipAddressType(original.d_ipAddressType)
 , d_attemptsRemaining(original.d_attemptsRemaining)
 , d_error(original.d_error)
 {
@@ -245,6 +264,7 @@ ConnectContext& ConnectContext::operator=(const ConnectContext& other)
         d_latency           = other.d_latency;
         d_source            = other.d_source;
         d_nameServer        = other.d_nameServer;
+        d_ipAddressType     = other.d_ipAddressType;
         d_attemptsRemaining = other.d_attemptsRemaining;
         d_error             = other.d_error;
     }
@@ -259,6 +279,7 @@ void ConnectContext::reset()
     d_latency.reset();
     d_source.reset();
     d_nameServer.reset();
+    d_ipAddressType.reset();
     d_attemptsRemaining = 0;
     d_error             = ntsa::Error();
 }
@@ -293,6 +314,12 @@ void ConnectContext::setNameServer(const ntsa::Endpoint& value)
     d_nameServer = value;
 }
 
+NTCCFG_INLINE
+void ConnectContext::setIpAddressType(ntsa::IpAddressType::Value value)
+{
+    d_ipAddressType = value;
+}
+
 NTCCFG_INLINE
 void ConnectContext::setAttemptsRemaining(bsl::size_t value)
 {
@@ -336,6 +363,13 @@ const bdlb::NullableValue<ntsa::Endpoint>& ConnectContext::nameServer() const
     return d_nameServer;
 }
 
+NTCCFG_INLINE
+const bdlb::NullableValue<ntsa::IpAddressType::Value>& ConnectContext::
+    ipAddressType() const
+{
+    return d_ipAddressType;
+}
+
 NTCCFG_INLINE
 bsl::size_t ConnectContext::attemptsRemaining() const
 {
@@ -382,6 +416,7 @@ void hashAppend(HASH_ALGORITHM& algorithm, const ConnectContext& value)
     hashAppend(algorithm, value.latency());
     hashAppend(algorithm, value.source());
     hashAppend(algorithm, value.nameServer());
+    hashAppend(algorithm, value.ipAddressType());
     hashAppend(algorithm, value.attemptsRemaining());
     hashAppend(algorithm, value.error());
 }
@@ -53,7 +53,11 @@ namespace ntca {
 /// resolution: either resolve every time and pick one address given by
 /// resolver, or resolve once and save address list, retrying each address in
 /// order. In both cases, IP address filters and port filers, if defined, may
-/// reorder, prune, and even adjust the results of name resolution.
+/// reorder, prune, and even adjust the results of name resolution. The
+/// "Happy Eyeballs" strategy resolves the IPv6 and IPv4 addresses in
+/// parallel and interleaves them by address family, so that a broken path
+/// for one family costs at most one retry interval before the other family
+/// is tried.
 ///
 /// @li @b retryCount:
 /// The number of additional attempts to attempt to connect, if and when the
@@ -64,6 +68,8 @@ namespace ntca {
 /// The interval between connection attempts, if and when the initial attempt
 /// fails and the retry count is greater than zero. The default value is null,
 /// which indicates an implementation-chosen default retry interval is used.
+/// When connecting according to the "Happy Eyeballs" strategy, this interval
+/// is the "connection attempt delay" and defaults to 250 milliseconds.
 ///
 /// @li @b retryBackoff
 /// The geometric or exponential backoff policy, with optional jitter.
@@ -30,6 +30,7 @@ int ConnectStrategy::fromInt(ConnectStrategy::Value* result, int number)
     switch (number) {
     case ConnectStrategy::e_RESOLVE_INTO_SINGLE:
     case ConnectStrategy::e_RESOLVE_INTO_LIST:
+    case ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS:
         *result = static_cast<ConnectStrategy::Value>(number);
         return 0;
     default:
@@ -50,6 +51,13 @@ int ConnectStrategy::fromString(ConnectStrategy::Value*  result,
         return 0;
     }
 
+    if (bdlb::String::areEqualCaseless(string,
+                                       "RESOLVE_INTO_HAPPY_EYEBALLS"))
+    {
+        *result = e_RESOLVE_INTO_HAPPY_EYEBALLS;
+        return 0;
+    }
+
     return -1;
 }
 
@@ -62,6 +70,9 @@ const char* ConnectStrategy::toString(ConnectStrategy::Value value)
     case e_RESOLVE_INTO_LIST: {
         return "RESOLVE_INTO_LIST";
     } break;
+    case e_RESOLVE_INTO_HAPPY_EYEBALLS: {
+        return "RESOLVE_INTO_HAPPY_EYEBALLS";
+    } break;
     }
 
     BSLS_ASSERT(!"invalid enumerator");
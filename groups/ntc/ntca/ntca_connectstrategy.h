@@ -48,7 +48,15 @@ class ConnectStrategy
         /// save the IP address list, retry each IP address in order, only
         /// re-resolving after a connection attempt has been tried to each
         /// address and failed.
-        e_RESOLVE_INTO_LIST
+        e_RESOLVE_INTO_LIST,
+
+        /// Resolve the name into its IPv6 and IPv4 addresses in parallel,
+        /// interleave the results by address family (preferring IPv6), and
+        /// try each address in order, moving on to the next address when
+        /// the current attempt fails, or racing the next address against
+        /// the current attempt when it has not completed within the retry
+        /// interval, as described by "Happy Eyeballs" (RFC 8305).
+        e_RESOLVE_INTO_HAPPY_EYEBALLS
     };
 
     /// Return the string representation exactly matching the enumerator
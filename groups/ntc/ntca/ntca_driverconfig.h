@@ -24,6 +24,7 @@ BSLS_IDENT("$Id: $")
 #include <ntcscm_version.h>
 #include <bdlb_nullablevalue.h>
 #include <bslh_hash.h>
+#include <bsls_timeinterval.h>
 #include <bsl_iosfwd.h>
 #include <bsl_string.h>
 
@@ -97,6 +98,13 @@ namespace ntca {
 /// occurred. The default value is null, indicating that only one cycle is
 /// performed.
 ///
+/// @li @b stallThreshold:
+/// The maximum duration of a callback dispatched by an I/O thread, beyond
+/// which the callback is flagged as stalling the I/O thread: it is logged
+/// along with the socket to which it was dispatched, and counted in the
+/// statistics of the stall detector of the thread. The default value is null,
+/// indicating that callbacks are not measured.
+///
 /// @li @b metricCollection:
 /// The flag that indicates the collection of metrics is enabled or disabled.
 ///
@@ -122,6 +130,7 @@ class DriverConfig
     bdlb::NullableValue<bsl::size_t>           d_maxEventsPerWait;
     bdlb::NullableValue<bsl::size_t>           d_maxTimersPerWait;
     bdlb::NullableValue<bsl::size_t>           d_maxCyclesPerWait;
+    bdlb::NullableValue<bsls::TimeInterval>    d_stallThreshold;
     bdlb::NullableValue<bool>                  d_metricCollection;
     bdlb::NullableValue<bool>                  d_metricCollectionPerWaiter;
     bdlb::NullableValue<bool>                  d_metricCollectionPerSocket;
@@ -193,6 +202,11 @@ class DriverConfig
     /// 'value'.
     void setMaxCyclesPerWait(bsl::size_t value);
 
+    /// Set the maximum duration of a callback dispatched by an I/O thread,
+    /// beyond which the callback is flagged as stalling the I/O thread, to the
+    /// specified value.
+    void setStallThreshold(const bsls::TimeInterval& value);
+
     /// Set the collection of metrics to be enabled or disabled according
     /// to the specified 'value'.
     void setMetricCollection(bool value);
@@ -239,6 +253,10 @@ class DriverConfig
     /// null, only one cycle is performed.
     const bdlb::NullableValue<bsl::size_t>& maxCyclesPerWait() const;
 
+    /// Return the maximum duration of a callback dispatched by an I/O thread,
+    /// beyond which the callback is flagged as stalling the I/O thread.
+    const bdlb::NullableValue<bsls::TimeInterval>& stallThreshold() const;
+
     /// Return the flag that indicates the collection of metrics is enabled
     /// or disabled.
     const bdlb::NullableValue<bool>& metricCollection() const;
@@ -322,6 +340,7 @@ void hashAppend(HASH_ALGORITHM& algorithm, const DriverConfig& value)
     hashAppend(algorithm, value.maxEventsPerWait());
     hashAppend(algorithm, value.maxTimersPerWait());
     hashAppend(algorithm, value.maxCyclesPerWait());
+    hashAppend(algorithm, value.stallThreshold());
     hashAppend(algorithm, value.metricCollection());
     hashAppend(algorithm, value.metricCollectionPerWaiter());
     hashAppend(algorithm, value.metricCollectionPerSocket());
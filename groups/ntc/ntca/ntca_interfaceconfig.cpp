@@ -35,6 +35,7 @@ InterfaceConfig::InterfaceConfig(bslma::Allocator* basicAllocator)
 , d_maxEventsPerWait()
 , d_maxTimersPerWait()
 , d_maxCyclesPerWait()
+, d_stallThreshold()
 , d_maxConnections()
 , d_backlog()
 , d_acceptQueueLowWatermark()
@@ -75,6 +76,7 @@ InterfaceConfig::InterfaceConfig(bslma::Allocator* basicAllocator)
 , d_driverMetricsPerWaiter()
 , d_socketMetrics()
 , d_socketMetricsPerHandle()
+, d_socketRecycling()
 , d_resolverEnabled()
 , d_resolverConfig(basicAllocator)
 , d_compressionConfig()
@@ -94,6 +96,7 @@ InterfaceConfig::InterfaceConfig(const InterfaceConfig& other,
 , d_maxEventsPerWait(other.d_maxEventsPerWait)
 , d_maxTimersPerWait(other.d_maxTimersPerWait)
 , d_maxCyclesPerWait(other.d_maxCyclesPerWait)
+, d_stallThreshold(other.d_stallThreshold)
 , d_maxConnections(other.d_maxConnections)
 , d_backlog(other.d_backlog)
 , d_acceptQueueLowWatermark(other.d_acceptQueueLowWatermark)
@@ -134,6 +137,7 @@ InterfaceConfig::InterfaceConfig(const InterfaceConfig& other,
 , d_driverMetricsPerWaiter(other.d_driverMetricsPerWaiter)
 , d_socketMetrics(other.d_socketMetrics)
 , d_socketMetricsPerHandle(other.d_socketMetricsPerHandle)
+, d_socketRecycling(other.d_socketRecycling)
 , d_resolverEnabled(other.d_resolverEnabled)
 , d_resolverConfig(other.d_resolverConfig, basicAllocator)
 , d_compressionConfig(other.d_compressionConfig)
@@ -158,6 +162,7 @@ InterfaceConfig& InterfaceConfig::operator=(const InterfaceConfig& other)
         d_maxEventsPerWait         = other.d_maxEventsPerWait;
         d_maxTimersPerWait         = other.d_maxTimersPerWait;
         d_maxCyclesPerWait         = other.d_maxCyclesPerWait;
+        d_stallThreshold           = other.d_stallThreshold;
         d_maxConnections           = other.d_maxConnections;
         d_backlog                  = other.d_backlog;
         d_acceptQueueLowWatermark  = other.d_acceptQueueLowWatermark;
@@ -200,6 +205,7 @@ InterfaceConfig& InterfaceConfig::operator=(const InterfaceConfig& other)
         d_driverMetricsPerWaiter    = other.d_driverMetricsPerWaiter;
         d_socketMetrics             = other.d_socketMetrics;
         d_socketMetricsPerHandle    = other.d_socketMetricsPerHandle;
+        d_socketRecycling           = other.d_socketRecycling;
         d_resolverEnabled           = other.d_resolverEnabled;
         d_resolverConfig            = other.d_resolverConfig;
         d_compressionConfig         = other.d_compressionConfig;
@@ -221,6 +227,7 @@ void InterfaceConfig::reset()
     d_maxEventsPerWait.reset();
     d_maxTimersPerWait.reset();
     d_maxCyclesPerWait.reset();
+    d_stallThreshold.reset();
     d_maxConnections.reset();
     d_backlog.reset();
     d_acceptQueueLowWatermark.reset();
@@ -261,6 +268,7 @@ void InterfaceConfig::reset()
     d_driverMetricsPerWaiter.reset();
     d_socketMetrics.reset();
     d_socketMetricsPerHandle.reset();
+    d_socketRecycling.reset();
     d_resolverEnabled.reset();
     d_resolverConfig.reset();
     d_compressionConfig.reset();
@@ -317,6 +325,11 @@ void InterfaceConfig::setMaxCyclesPerWait(bsl::size_t value)
     d_maxCyclesPerWait = value;
 }
 
+void InterfaceConfig::setStallThreshold(const bsls::TimeInterval& value)
+{
+    d_stallThreshold = value;
+}
+
 void InterfaceConfig::setMaxConnections(bsl::size_t value)
 {
     d_maxConnections = value;
@@ -517,6 +530,11 @@ void InterfaceConfig::setSocketMetricsPerHandle(bool value)
     d_socketMetricsPerHandle = value;
 }
 
+void InterfaceConfig::setSocketRecycling(bool value)
+{
+    d_socketRecycling = value;
+}
+
 void InterfaceConfig::setResolverEnabled(bool value)
 {
     d_resolverEnabled = value;
@@ -592,6 +610,12 @@ const bdlb::NullableValue<bsl::size_t>& InterfaceConfig::maxCyclesPerWait()
     return d_maxCyclesPerWait;
 }
 
+const bdlb::NullableValue<bsls::TimeInterval>& InterfaceConfig::
+    stallThreshold() const
+{
+    return d_stallThreshold;
+}
+
 const bdlb::NullableValue<bsl::size_t>& InterfaceConfig::maxConnections() const
 {
     return d_maxConnections;
@@ -810,6 +834,11 @@ const bdlb::NullableValue<bool>& InterfaceConfig::socketMetricsPerHandle()
     return d_socketMetricsPerHandle;
 }
 
+const bdlb::NullableValue<bool>& InterfaceConfig::socketRecycling() const
+{
+    return d_socketRecycling;
+}
+
 const bdlb::NullableValue<bool>& InterfaceConfig::resolverEnabled() const
 {
     return d_resolverEnabled;
@@ -845,6 +874,7 @@ bool InterfaceConfig::equals(const InterfaceConfig& other) const
            d_maxEventsPerWait == other.d_maxEventsPerWait &&
            d_maxTimersPerWait == other.d_maxTimersPerWait &&
            d_maxCyclesPerWait == other.d_maxCyclesPerWait &&
+           d_stallThreshold == other.d_stallThreshold &&
            d_maxConnections == other.d_maxConnections &&
            d_backlog == other.d_backlog &&
            d_acceptQueueLowWatermark == other.d_acceptQueueLowWatermark &&
@@ -886,6 +916,7 @@ bool InterfaceConfig::equals(const InterfaceConfig& other) const
            d_driverMetricsPerWaiter == other.d_driverMetricsPerWaiter &&
            d_socketMetrics == other.d_socketMetrics &&
            d_socketMetricsPerHandle == other.d_socketMetricsPerHandle &&
+           d_socketRecycling == other.d_socketRecycling &&
            d_resolverEnabled == other.d_resolverEnabled &&
            d_resolverConfig == other.d_resolverConfig &&
            d_compressionConfig == other.d_compressionConfig &&
@@ -928,6 +959,10 @@ bsl::ostream& InterfaceConfig::print(bsl::ostream& stream,
         printer.printAttribute("maxCyclesPerWait", d_maxCyclesPerWait);
     }
 
+    if (!d_stallThreshold.isNull()) {
+        printer.printAttribute("stallThreshold", d_stallThreshold);
+    }
+
     if (!d_maxConnections.isNull()) {
         printer.printAttribute("maxConnections", d_maxConnections);
     }
@@ -1103,6 +1138,10 @@ bsl::ostream& InterfaceConfig::print(bsl::ostream& stream,
                                d_socketMetricsPerHandle);
     }
 
+    if (!d_socketRecycling.isNull()) {
+        printer.printAttribute("socketRecycling", d_socketRecycling);
+    }
+
     if (!d_resolverEnabled.isNull()) {
         printer.printAttribute("resolverEnabled", d_resolverEnabled);
     }
@@ -98,6 +98,13 @@ namespace ntca {
 /// occurred. The default value is null, indicating that only one cycle is
 /// performed.
 ///
+/// @li @b stallThreshold:
+/// The maximum duration of a callback dispatched by an I/O thread, beyond
+/// which the callback is flagged as stalling the I/O thread: it is logged
+/// along with the socket to which it was dispatched, and counted in the
+/// statistics of the stall detector of the thread. The default value is null,
+/// indicating that callbacks are not measured.
+///
 /// @li @b maxConnections:
 /// The maximum number of supported simultaneous connections.
 ///
@@ -290,6 +297,12 @@ namespace ntca {
 /// The flag that indicates socket metrics per handle (i.e. descriptor) should
 /// be collected.
 ///
+/// @li @b socketRecycling:
+/// The flag that indicates closed stream sockets, and the memory of other
+/// closed sockets, should be recycled for the sockets subsequently created or
+/// accepted by this interface. The default value is null, indicating that
+/// each socket is constructed and allocated independently.
+///
 /// @li @b resolverEnabled:
 /// The flag that indicates this interface should run an asynchronous resolver.
 /// The default value is null, indicating that a default resolver is *not* run.
@@ -320,6 +333,9 @@ class InterfaceConfig
     /// Defines a type alias for a nullable boolean type.
     typedef bdlb::NullableValue<bool> NullableBool;
 
+    /// Defines a type alias for a nullable time interval.
+    typedef bdlb::NullableValue<bsls::TimeInterval> NullableTimeInterval;
+
     /// Defines a type alias for a nullable IP address.
     typedef bdlb::NullableValue<ntsa::IpAddress> NullableIpAddress;
 
@@ -345,6 +361,7 @@ class InterfaceConfig
     NullableSize                d_maxEventsPerWait;
     NullableSize                d_maxTimersPerWait;
     NullableSize                d_maxCyclesPerWait;
+    NullableTimeInterval        d_stallThreshold;
     NullableSize                d_maxConnections;
     NullableSize                d_backlog;
     NullableSize                d_acceptQueueLowWatermark;
@@ -385,6 +402,7 @@ class InterfaceConfig
     NullableBool                d_driverMetricsPerWaiter;
     NullableBool                d_socketMetrics;
     NullableBool                d_socketMetricsPerHandle;
+    NullableBool                d_socketRecycling;
     NullableBool                d_resolverEnabled;
     NullableResolverConfig      d_resolverConfig;
     NullableCompressionConfig   d_compressionConfig;
@@ -452,6 +470,11 @@ class InterfaceConfig
     /// 'value'.
     void setMaxCyclesPerWait(bsl::size_t value);
 
+    /// Set the maximum duration of a callback dispatched by an I/O thread,
+    /// beyond which the callback is flagged as stalling the I/O thread, to the
+    /// specified value.
+    void setStallThreshold(const bsls::TimeInterval& value);
+
     /// Set the maximum number of concurrently supported connections to
     /// the specified 'value'.
     void setMaxConnections(bsl::size_t value);
@@ -594,6 +617,11 @@ class InterfaceConfig
     /// collected to the specified 'value'.
     void setSocketMetricsPerHandle(bool value);
 
+    /// Set the flag that indicates closed stream sockets, and the memory of
+    /// other closed sockets, should be recycled for subsequently created or
+    /// accepted sockets to the specified 'value'.
+    void setSocketRecycling(bool value);
+
     /// Set the flag that indicates this interface should run an
     /// asynchronous resolver to the specified 'value'. The default value is
     /// null, indicating that a default resolver is *not* run.
@@ -650,6 +678,10 @@ class InterfaceConfig
     /// null, only one cycle is performed.
     const bdlb::NullableValue<bsl::size_t>& maxCyclesPerWait() const;
 
+    /// Return the maximum duration of a callback dispatched by an I/O thread,
+    /// beyond which the callback is flagged as stalling the I/O thread.
+    const bdlb::NullableValue<bsls::TimeInterval>& stallThreshold() const;
+
     /// Return the maximum number of concurrently supported connections.
     const bdlb::NullableValue<bsl::size_t>& maxConnections() const;
 
@@ -788,6 +820,11 @@ class InterfaceConfig
     /// collected to the specified 'value'.
     const bdlb::NullableValue<bool>& socketMetricsPerHandle() const;
 
+    /// Return the flag that indicates closed stream sockets, and the memory
+    /// of other closed sockets, should be recycled for subsequently created
+    /// or accepted sockets.
+    const bdlb::NullableValue<bool>& socketRecycling() const;
+
     /// Return the flag that indicates this interface should run an
     /// asynchronous resolver. The default value is null, indicating that a
     /// default resolver is *not* run.
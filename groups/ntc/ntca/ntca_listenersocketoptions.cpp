@@ -60,6 +60,7 @@ ListenerSocketOptions::ListenerSocketOptions(bslma::Allocator* basicAllocator)
 , d_timestampOutgoingData()
 , d_timestampIncomingData()
 , d_zeroCopyThreshold()
+, d_hibernationTimeout()
 , d_loadBalancingOptions()
 , d_compressionConfig()
 , d_serializationConfig(basicAllocator)
@@ -103,6 +104,7 @@ ListenerSocketOptions::ListenerSocketOptions(
 , d_timestampOutgoingData(other.d_timestampOutgoingData)
 , d_timestampIncomingData(other.d_timestampIncomingData)
 , d_zeroCopyThreshold(other.d_zeroCopyThreshold)
+, d_hibernationTimeout(other.d_hibernationTimeout)
 , d_loadBalancingOptions(other.d_loadBalancingOptions)
 , d_compressionConfig(other.d_compressionConfig)
 , d_serializationConfig(other.d_serializationConfig, basicAllocator)
@@ -153,6 +155,7 @@ ListenerSocketOptions& ListenerSocketOptions::operator=(
         d_timestampOutgoingData     = other.d_timestampOutgoingData;
         d_timestampIncomingData     = other.d_timestampIncomingData;
         d_zeroCopyThreshold         = other.d_zeroCopyThreshold;
+        d_hibernationTimeout        = other.d_hibernationTimeout;
         d_loadBalancingOptions      = other.d_loadBalancingOptions;
         d_compressionConfig         = other.d_compressionConfig;
         d_serializationConfig       = other.d_serializationConfig;
@@ -334,6 +337,12 @@ void ListenerSocketOptions::setZeroCopyThreshold(bsl::size_t value)
     d_zeroCopyThreshold = value;
 }
 
+void ListenerSocketOptions::setHibernationTimeout(
+    const bsls::TimeInterval& value)
+{
+    d_hibernationTimeout = value;
+}
+
 void ListenerSocketOptions::setLoadBalancingOptions(
     const ntca::LoadBalancingOptions& value)
 {
@@ -544,6 +553,12 @@ const bdlb::NullableValue<bsl::size_t>& ListenerSocketOptions::
     return d_zeroCopyThreshold;
 }
 
+const bdlb::NullableValue<bsls::TimeInterval>& ListenerSocketOptions::
+    hibernationTimeout() const
+{
+    return d_hibernationTimeout;
+}
+
 const ntca::LoadBalancingOptions& ListenerSocketOptions::loadBalancingOptions()
     const
 {
@@ -605,6 +620,7 @@ bsl::ostream& ListenerSocketOptions::print(bsl::ostream& stream,
     printer.printAttribute("timestampOutgoingData", d_timestampOutgoingData);
     printer.printAttribute("timestampIncomingData", d_timestampIncomingData);
     printer.printAttribute("zeroCopyThreshold", d_zeroCopyThreshold);
+    printer.printAttribute("hibernationTimeout", d_hibernationTimeout);
     printer.printAttribute("loadBalancingOptions", d_loadBalancingOptions);
 
     if (d_compressionConfig.has_value()) {
@@ -657,6 +673,7 @@ bool operator==(const ListenerSocketOptions& lhs,
            lhs.timestampOutgoingData() == rhs.timestampOutgoingData() &&
            lhs.timestampIncomingData() == rhs.timestampIncomingData() &&
            lhs.zeroCopyThreshold() == rhs.zeroCopyThreshold() &&
+           lhs.hibernationTimeout() == rhs.hibernationTimeout() &&
            lhs.loadBalancingOptions() == rhs.loadBalancingOptions() &&
            lhs.compressionConfig() == rhs.compressionConfig() &&
            lhs.serializationConfig() == rhs.serializationConfig();
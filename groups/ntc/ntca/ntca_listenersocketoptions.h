@@ -27,6 +27,7 @@ BSLS_IDENT("$Id: $")
 #include <ntsa_endpoint.h>
 #include <ntsa_transport.h>
 #include <bdlb_nullablevalue.h>
+#include <bsls_timeinterval.h>
 #include <bsl_iosfwd.h>
 
 namespace BloombergLP {
@@ -205,6 +206,17 @@ namespace ntca {
 /// The minimum number of bytes that must be available to send in order to
 /// attempt a zero-copy send.
 ///
+/// @li @b hibernationTimeout:
+/// The duration of inactivity after which a connected stream socket releases
+/// the buffer capacity retained by its read and write queues, collapses its
+/// per-socket metrics into the metrics of its interface, and closes its idle
+/// timers. Each resource is lazily restored when the socket next becomes
+/// active, and restored per-socket metrics are registered under a new object
+/// name. Only sockets driven by a reactor hibernate: a socket driven by a
+/// proactor always has a receive outstanding into its receive buffer, which
+/// cannot be released without cancelling that receive. If not specified,
+/// stream sockets never hibernate.
+///
 /// @li @b loadBalancingOptions:
 /// The configurable parameters used select a reactor or proactor that drives
 /// the I/O for the socket.
@@ -258,6 +270,7 @@ class ListenerSocketOptions
     bdlb::NullableValue<bool>           d_timestampOutgoingData;
     bdlb::NullableValue<bool>           d_timestampIncomingData;
     bdlb::NullableValue<bsl::size_t>    d_zeroCopyThreshold;
+    bdlb::NullableValue<bsls::TimeInterval> d_hibernationTimeout;
     ntca::LoadBalancingOptions          d_loadBalancingOptions;
     bdlb::NullableValue<ntca::CompressionConfig> d_compressionConfig;
     bdlb::NullableValue<ntca::SerializationConfig> d_serializationConfig;
@@ -402,6 +415,10 @@ class ListenerSocketOptions
     /// to attempt a zero-copy send to the specified 'value'.
     void setZeroCopyThreshold(size_t value);
 
+    /// Set the duration of inactivity after which a connected stream socket
+    /// hibernates to the specified 'value'.
+    void setHibernationTimeout(const bsls::TimeInterval& value);
+
     /// Set the load balancing options to the specified 'value'.
     void setLoadBalancingOptions(const ntca::LoadBalancingOptions& value);
 
@@ -523,6 +540,10 @@ class ListenerSocketOptions
     /// order to attempt a zero-copy send.
     const bdlb::NullableValue<bsl::size_t>& zeroCopyThreshold() const;
 
+    /// Return the duration of inactivity after which a connected stream
+    /// socket hibernates.
+    const bdlb::NullableValue<bsls::TimeInterval>& hibernationTimeout() const;
+
     /// Return the load balancing options.
     const ntca::LoadBalancingOptions& loadBalancingOptions() const;
 
@@ -32,6 +32,7 @@ ProactorConfig::ProactorConfig(bslma::Allocator* basicAllocator)
 , d_maxEventsPerWait()
 , d_maxTimersPerWait()
 , d_maxCyclesPerWait()
+, d_stallThreshold()
 , d_metricCollection()
 , d_metricCollectionPerWaiter()
 , d_metricCollectionPerSocket()
@@ -48,6 +49,7 @@ ProactorConfig::ProactorConfig(const ProactorConfig& original,
 , d_maxEventsPerWait(original.d_maxEventsPerWait)
 , d_maxTimersPerWait(original.d_maxTimersPerWait)
 , d_maxCyclesPerWait(original.d_maxCyclesPerWait)
+, d_stallThreshold(original.d_stallThreshold)
 , d_metricCollection(original.d_metricCollection)
 , d_metricCollectionPerWaiter(original.d_metricCollectionPerWaiter)
 , d_metricCollectionPerSocket(original.d_metricCollectionPerSocket)
@@ -69,6 +71,7 @@ ProactorConfig& ProactorConfig::operator=(const ProactorConfig& other)
         d_maxEventsPerWait          = other.d_maxEventsPerWait;
         d_maxTimersPerWait          = other.d_maxTimersPerWait;
         d_maxCyclesPerWait          = other.d_maxCyclesPerWait;
+        d_stallThreshold            = other.d_stallThreshold;
         d_metricCollection          = other.d_metricCollection;
         d_metricCollectionPerWaiter = other.d_metricCollectionPerWaiter;
         d_metricCollectionPerSocket = other.d_metricCollectionPerSocket;
@@ -87,6 +90,7 @@ void ProactorConfig::reset()
     d_maxEventsPerWait.reset();
     d_maxTimersPerWait.reset();
     d_maxCyclesPerWait.reset();
+    d_stallThreshold.reset();
     d_metricCollection.reset();
     d_metricCollectionPerWaiter.reset();
     d_metricCollectionPerSocket.reset();
@@ -132,6 +136,11 @@ void ProactorConfig::setMaxCyclesPerWait(bsl::size_t value)
     d_maxCyclesPerWait = value;
 }
 
+void ProactorConfig::setStallThreshold(const bsls::TimeInterval& value)
+{
+    d_stallThreshold = value;
+}
+
 void ProactorConfig::setMetricCollection(bool value)
 {
     d_metricCollection = value;
@@ -191,6 +200,12 @@ const bdlb::NullableValue<bsl::size_t>& ProactorConfig::maxCyclesPerWait()
     return d_maxCyclesPerWait;
 }
 
+const bdlb::NullableValue<bsls::TimeInterval>& ProactorConfig::stallThreshold()
+    const
+{
+    return d_stallThreshold;
+}
+
 const bdlb::NullableValue<bool>& ProactorConfig::metricCollection() const
 {
     return d_metricCollection;
@@ -218,6 +233,7 @@ bool ProactorConfig::equals(const ProactorConfig& other) const
            d_maxEventsPerWait == other.d_maxEventsPerWait &&
            d_maxTimersPerWait == other.d_maxTimersPerWait &&
            d_maxCyclesPerWait == other.d_maxCyclesPerWait &&
+           d_stallThreshold == other.d_stallThreshold &&
            d_metricCollection == other.d_metricCollection &&
            d_metricCollectionPerWaiter == other.d_metricCollectionPerWaiter &&
            d_metricCollectionPerSocket == other.d_metricCollectionPerSocket;
@@ -281,6 +297,14 @@ bool ProactorConfig::less(const ProactorConfig& other) const
         return false;
     }
 
+    if (d_stallThreshold < other.d_stallThreshold) {
+        return true;
+    }
+
+    if (other.d_stallThreshold < d_stallThreshold) {
+        return false;
+    }
+
     if (d_metricCollection < other.d_metricCollection) {
         return true;
     }
@@ -314,6 +338,7 @@ bsl::ostream& ProactorConfig::print(bsl::ostream& stream,
     printer.printAttribute("maxEventsPerWait", d_maxEventsPerWait);
     printer.printAttribute("maxTimersPerWait", d_maxTimersPerWait);
     printer.printAttribute("maxCyclesPerWait", d_maxCyclesPerWait);
+    printer.printAttribute("stallThreshold", d_stallThreshold);
     printer.printAttribute("metricCollection", d_metricCollection);
     printer.printAttribute("metricCollectionPerWaiter",
                            d_metricCollectionPerWaiter);
@@ -32,6 +32,7 @@ ReactorConfig::ReactorConfig(bslma::Allocator* basicAllocator)
 , d_maxEventsPerWait()
 , d_maxTimersPerWait()
 , d_maxCyclesPerWait()
+, d_stallThreshold()
 , d_metricCollection()
 , d_metricCollectionPerWaiter()
 , d_metricCollectionPerSocket()
@@ -52,6 +53,7 @@ ReactorConfig::ReactorConfig(const ReactorConfig& original,
 , d_maxEventsPerWait(original.d_maxEventsPerWait)
 , d_maxTimersPerWait(original.d_maxTimersPerWait)
 , d_maxCyclesPerWait(original.d_maxCyclesPerWait)
+, d_stallThreshold(original.d_stallThreshold)
 , d_metricCollection(original.d_metricCollection)
 , d_metricCollectionPerWaiter(original.d_metricCollectionPerWaiter)
 , d_metricCollectionPerSocket(original.d_metricCollectionPerSocket)
@@ -77,6 +79,7 @@ ReactorConfig& ReactorConfig::operator=(const ReactorConfig& other)
         d_maxEventsPerWait          = other.d_maxEventsPerWait;
         d_maxTimersPerWait          = other.d_maxTimersPerWait;
         d_maxCyclesPerWait          = other.d_maxCyclesPerWait;
+        d_stallThreshold            = other.d_stallThreshold;
         d_metricCollection          = other.d_metricCollection;
         d_metricCollectionPerWaiter = other.d_metricCollectionPerWaiter;
         d_metricCollectionPerSocket = other.d_metricCollectionPerSocket;
@@ -99,6 +102,7 @@ void ReactorConfig::reset()
     d_maxEventsPerWait.reset();
     d_maxTimersPerWait.reset();
     d_maxCyclesPerWait.reset();
+    d_stallThreshold.reset();
     d_metricCollection.reset();
     d_metricCollectionPerWaiter.reset();
     d_metricCollectionPerSocket.reset();
@@ -148,6 +152,11 @@ void ReactorConfig::setMaxCyclesPerWait(bsl::size_t value)
     d_maxCyclesPerWait = value;
 }
 
+void ReactorConfig::setStallThreshold(const bsls::TimeInterval& value)
+{
+    d_stallThreshold = value;
+}
+
 void ReactorConfig::setMetricCollection(bool value)
 {
     d_metricCollection = value;
@@ -224,6 +233,12 @@ const bdlb::NullableValue<bsl::size_t>& ReactorConfig::maxCyclesPerWait() const
     return d_maxCyclesPerWait;
 }
 
+const bdlb::NullableValue<bsls::TimeInterval>& ReactorConfig::stallThreshold()
+    const
+{
+    return d_stallThreshold;
+}
+
 const bdlb::NullableValue<bool>& ReactorConfig::metricCollection() const
 {
     return d_metricCollection;
@@ -272,6 +287,7 @@ bool ReactorConfig::equals(const ReactorConfig& other) const
            d_maxEventsPerWait == other.d_maxEventsPerWait &&
            d_maxTimersPerWait == other.d_maxTimersPerWait &&
            d_maxCyclesPerWait == other.d_maxCyclesPerWait &&
+           d_stallThreshold == other.d_stallThreshold &&
            d_metricCollection == other.d_metricCollection &&
            d_metricCollectionPerWaiter == other.d_metricCollectionPerWaiter &&
            d_metricCollectionPerSocket == other.d_metricCollectionPerSocket &&
@@ -346,6 +362,14 @@ bool ReactorConfig::less(const ReactorConfig& other) const
         return false;
     }
 
+    if (d_stallThreshold < other.d_stallThreshold) {
+        return true;
+    }
+
+    if (other.d_stallThreshold < d_stallThreshold) {
+        return false;
+    }
+
     if (d_metricCollection < other.d_metricCollection) {
         return true;
     }
@@ -411,6 +435,7 @@ bsl::ostream& ReactorConfig::print(bsl::ostream& stream,
     printer.printAttribute("maxEventsPerWait", d_maxEventsPerWait);
     printer.printAttribute("maxTimersPerWait", d_maxTimersPerWait);
     printer.printAttribute("maxCyclesPerWait", d_maxCyclesPerWait);
+    printer.printAttribute("stallThreshold", d_stallThreshold);
     printer.printAttribute("metricCollection", d_metricCollection);
     printer.printAttribute("metricCollectionPerWaiter",
                            d_metricCollectionPerWaiter);
@@ -28,12 +28,19 @@ ResolverConfig::ResolverConfig(bslma::Allocator* basicAllocator)
 , d_hostDatabasePath(basicAllocator)
 , d_portDatabaseEnabled()
 , d_portDatabasePath(basicAllocator)
+, d_databaseReloadInterval()
 , d_positiveCacheEnabled()
 , d_positiveCacheMinTimeToLive()
 , d_positiveCacheMaxTimeToLive()
 , d_negativeCacheEnabled()
 , d_negativeCacheMinTimeToLive()
 , d_negativeCacheMaxTimeToLive()
+, d_cacheMaxEntries()
+, d_cacheSnapshotPath(basicAllocator)
+, d_cacheSnapshotInterval()
+, d_endpointCacheEnabled()
+, d_endpointCacheMaxEntries()
+, d_endpointCacheMaxTimeToLive()
 , d_clientEnabled()
 , d_clientSpecificationPath(basicAllocator)
 , d_clientRemoteEndpointList(basicAllocator)
@@ -43,9 +50,12 @@ ResolverConfig::ResolverConfig(bslma::Allocator* basicAllocator)
 , d_clientRotate()
 , d_clientDots()
 , d_clientDebug()
+, d_clientHedgeDelay()
+, d_clientHedgePercentile()
 , d_systemEnabled()
 , d_systemMinThreads()
 , d_systemMaxThreads()
+, d_blockingEnabled()
 , d_serverEnabled()
 , d_serverSourceEndpointList(basicAllocator)
 {
@@ -57,12 +67,19 @@ ResolverConfig::ResolverConfig(const ResolverConfig& original,
 , d_hostDatabasePath(original.d_hostDatabasePath, basicAllocator)
 , d_portDatabaseEnabled(original.d_portDatabaseEnabled)
 , d_portDatabasePath(original.d_portDatabasePath, basicAllocator)
+, d_databaseReloadInterval(original.d_databaseReloadInterval)
 , d_positiveCacheEnabled(original.d_positiveCacheEnabled)
 , d_positiveCacheMinTimeToLive(original.d_positiveCacheMinTimeToLive)
 , d_positiveCacheMaxTimeToLive(original.d_positiveCacheMaxTimeToLive)
 , d_negativeCacheEnabled(original.d_negativeCacheEnabled)
 , d_negativeCacheMinTimeToLive(original.d_negativeCacheMinTimeToLive)
 , d_negativeCacheMaxTimeToLive(original.d_negativeCacheMaxTimeToLive)
+, d_cacheMaxEntries(original.d_cacheMaxEntries)
+, d_cacheSnapshotPath(original.d_cacheSnapshotPath, basicAllocator)
+, d_cacheSnapshotInterval(original.d_cacheSnapshotInterval)
+, d_endpointCacheEnabled(original.d_endpointCacheEnabled)
+, d_endpointCacheMaxEntries(original.d_endpointCacheMaxEntries)
+, d_endpointCacheMaxTimeToLive(original.d_endpointCacheMaxTimeToLive)
 , d_clientEnabled(original.d_clientEnabled)
 , d_clientSpecificationPath(original.d_clientSpecificationPath, basicAllocator)
 , d_clientRemoteEndpointList(original.d_clientRemoteEndpointList,
@@ -73,9 +90,12 @@ ResolverConfig::ResolverConfig(const ResolverConfig& original,
 , d_clientRotate(original.d_clientRotate)
 , d_clientDots(original.d_clientDots)
 , d_clientDebug(original.d_clientDebug)
+, d_clientHedgeDelay(original.d_clientHedgeDelay)
+, d_clientHedgePercentile(original.d_clientHedgePercentile)
 , d_systemEnabled(original.d_systemEnabled)
 , d_systemMinThreads(original.d_systemMinThreads)
 , d_systemMaxThreads(original.d_systemMaxThreads)
+, d_blockingEnabled(original.d_blockingEnabled)
 , d_serverEnabled(original.d_serverEnabled)
 , d_serverSourceEndpointList(original.d_serverSourceEndpointList,
                              basicAllocator)
@@ -93,12 +113,19 @@ ResolverConfig& ResolverConfig::operator=(const ResolverConfig& other)
         d_hostDatabasePath           = other.d_hostDatabasePath;
         d_portDatabaseEnabled        = other.d_portDatabaseEnabled;
         d_portDatabasePath           = other.d_portDatabasePath;
+        d_databaseReloadInterval     = other.d_databaseReloadInterval;
         d_positiveCacheEnabled       = other.d_positiveCacheEnabled;
         d_positiveCacheMinTimeToLive = other.d_positiveCacheMinTimeToLive;
         d_positiveCacheMaxTimeToLive = other.d_positiveCacheMaxTimeToLive;
         d_negativeCacheEnabled       = other.d_negativeCacheEnabled;
         d_negativeCacheMinTimeToLive = other.d_negativeCacheMinTimeToLive;
         d_negativeCacheMaxTimeToLive = other.d_negativeCacheMaxTimeToLive;
+        d_cacheMaxEntries            = other.d_cacheMaxEntries;
+        d_cacheSnapshotPath          = other.d_cacheSnapshotPath;
+        d_cacheSnapshotInterval      = other.d_cacheSnapshotInterval;
+        d_endpointCacheEnabled       = other.d_endpointCacheEnabled;
+        d_endpointCacheMaxEntries    = other.d_endpointCacheMaxEntries;
+        d_endpointCacheMaxTimeToLive = other.d_endpointCacheMaxTimeToLive;
         d_clientEnabled              = other.d_clientEnabled;
         d_clientSpecificationPath    = other.d_clientSpecificationPath;
         d_clientRemoteEndpointList   = other.d_clientRemoteEndpointList;
@@ -108,9 +135,12 @@ ResolverConfig& ResolverConfig::operator=(const ResolverConfig& other)
         d_clientRotate               = other.d_clientRotate;
         d_clientDots                 = other.d_clientDots;
         d_clientDebug                = other.d_clientDebug;
+        d_clientHedgeDelay           = other.d_clientHedgeDelay;
+        d_clientHedgePercentile      = other.d_clientHedgePercentile;
         d_systemEnabled              = other.d_systemEnabled;
         d_systemMinThreads           = other.d_systemMinThreads;
         d_systemMaxThreads           = other.d_systemMaxThreads;
+        d_blockingEnabled            = other.d_blockingEnabled;
         d_serverEnabled              = other.d_serverEnabled;
         d_serverSourceEndpointList   = other.d_serverSourceEndpointList;
     }
@@ -124,12 +154,19 @@ void ResolverConfig::reset()
     d_hostDatabasePath.reset();
     d_portDatabaseEnabled.reset();
     d_portDatabasePath.reset();
+    d_databaseReloadInterval.reset();
     d_positiveCacheEnabled.reset();
     d_positiveCacheMinTimeToLive.reset();
     d_positiveCacheMaxTimeToLive.reset();
     d_negativeCacheEnabled.reset();
     d_negativeCacheMinTimeToLive.reset();
     d_negativeCacheMaxTimeToLive.reset();
+    d_cacheMaxEntries.reset();
+    d_cacheSnapshotPath.reset();
+    d_cacheSnapshotInterval.reset();
+    d_endpointCacheEnabled.reset();
+    d_endpointCacheMaxEntries.reset();
+    d_endpointCacheMaxTimeToLive.reset();
     d_clientEnabled.reset();
     d_clientSpecificationPath.reset();
     d_clientRemoteEndpointList.clear();
@@ -139,9 +176,12 @@ void ResolverConfig::reset()
     d_clientRotate.reset();
     d_clientDots.reset();
     d_clientDebug.reset();
+    d_clientHedgeDelay.reset();
+    d_clientHedgePercentile.reset();
     d_systemEnabled.reset();
     d_systemMinThreads.reset();
     d_systemMaxThreads.reset();
+    d_blockingEnabled.reset();
     d_serverEnabled.reset();
     d_serverSourceEndpointList.clear();
 }
@@ -166,6 +206,11 @@ void ResolverConfig::setPortDatabasePath(const bsl::string& value)
     d_portDatabasePath = value;
 }
 
+void ResolverConfig::setDatabaseReloadInterval(bsl::size_t value)
+{
+    d_databaseReloadInterval = value;
+}
+
 void ResolverConfig::setPositiveCacheEnabled(bool value)
 {
     d_positiveCacheEnabled = value;
@@ -196,6 +241,36 @@ void ResolverConfig::setNegativeCacheMaxTimeToLive(bsl::size_t value)
     d_negativeCacheMaxTimeToLive = value;
 }
 
+void ResolverConfig::setCacheMaxEntries(bsl::size_t value)
+{
+    d_cacheMaxEntries = value;
+}
+
+void ResolverConfig::setCacheSnapshotPath(const bsl::string& value)
+{
+    d_cacheSnapshotPath = value;
+}
+
+void ResolverConfig::setCacheSnapshotInterval(bsl::size_t value)
+{
+    d_cacheSnapshotInterval = value;
+}
+
+void ResolverConfig::setEndpointCacheEnabled(bool value)
+{
+    d_endpointCacheEnabled = value;
+}
+
+void ResolverConfig::setEndpointCacheMaxEntries(bsl::size_t value)
+{
+    d_endpointCacheMaxEntries = value;
+}
+
+void ResolverConfig::setEndpointCacheMaxTimeToLive(bsl::size_t value)
+{
+    d_endpointCacheMaxTimeToLive = value;
+}
+
 void ResolverConfig::setClientEnabled(bool value)
 {
     d_clientEnabled = value;
@@ -243,6 +318,16 @@ void ResolverConfig::setClientDebug(bool value)
     d_clientDebug = value;
 }
 
+void ResolverConfig::setClientHedgeDelay(bsl::size_t value)
+{
+    d_clientHedgeDelay = value;
+}
+
+void ResolverConfig::setClientHedgePercentile(bsl::size_t value)
+{
+    d_clientHedgePercentile = value;
+}
+
 void ResolverConfig::setSystemEnabled(bool value)
 {
     d_systemEnabled = value;
@@ -258,6 +343,11 @@ void ResolverConfig::setSystemMaxThreads(bsl::size_t value)
     d_systemMaxThreads = value;
 }
 
+void ResolverConfig::setBlockingEnabled(bool value)
+{
+    d_blockingEnabled = value;
+}
+
 void ResolverConfig::setServerEnabled(bool value)
 {
     d_serverEnabled = value;
@@ -290,6 +380,12 @@ const bdlb::NullableValue<bsl::string>& ResolverConfig::portDatabasePath()
     return d_portDatabasePath;
 }
 
+const bdlb::NullableValue<bsl::size_t>& ResolverConfig::
+    databaseReloadInterval() const
+{
+    return d_databaseReloadInterval;
+}
+
 const bdlb::NullableValue<bool>& ResolverConfig::positiveCacheEnabled() const
 {
     return d_positiveCacheEnabled;
@@ -324,6 +420,41 @@ const bdlb::NullableValue<bsl::size_t>& ResolverConfig::
     return d_negativeCacheMaxTimeToLive;
 }
 
+const bdlb::NullableValue<bsl::size_t>& ResolverConfig::cacheMaxEntries()
+    const
+{
+    return d_cacheMaxEntries;
+}
+
+const bdlb::NullableValue<bsl::string>& ResolverConfig::cacheSnapshotPath()
+    const
+{
+    return d_cacheSnapshotPath;
+}
+
+const bdlb::NullableValue<bsl::size_t>& ResolverConfig::
+    cacheSnapshotInterval() const
+{
+    return d_cacheSnapshotInterval;
+}
+
+const bdlb::NullableValue<bool>& ResolverConfig::endpointCacheEnabled() const
+{
+    return d_endpointCacheEnabled;
+}
+
+const bdlb::NullableValue<bsl::size_t>& ResolverConfig::
+    endpointCacheMaxEntries() const
+{
+    return d_endpointCacheMaxEntries;
+}
+
+const bdlb::NullableValue<bsl::size_t>& ResolverConfig::
+    endpointCacheMaxTimeToLive() const
+{
+    return d_endpointCacheMaxTimeToLive;
+}
+
 const bdlb::NullableValue<bool>& ResolverConfig::clientEnabled() const
 {
     return d_clientEnabled;
@@ -371,6 +502,18 @@ const bdlb::NullableValue<bool>& ResolverConfig::clientDebug() const
     return d_clientDebug;
 }
 
+const bdlb::NullableValue<bsl::size_t>& ResolverConfig::clientHedgeDelay()
+    const
+{
+    return d_clientHedgeDelay;
+}
+
+const bdlb::NullableValue<bsl::size_t>& ResolverConfig::
+    clientHedgePercentile() const
+{
+    return d_clientHedgePercentile;
+}
+
 const bdlb::NullableValue<bool>& ResolverConfig::systemEnabled() const
 {
     return d_systemEnabled;
@@ -388,6 +531,11 @@ const bdlb::NullableValue<bsl::size_t>& ResolverConfig::systemMaxThreads()
     return d_systemMaxThreads;
 }
 
+const bdlb::NullableValue<bool>& ResolverConfig::blockingEnabled() const
+{
+    return d_blockingEnabled;
+}
+
 const bdlb::NullableValue<bool>& ResolverConfig::serverEnabled() const
 {
     return d_serverEnabled;
@@ -405,6 +553,7 @@ bool ResolverConfig::equals(const ResolverConfig& other) const
            d_hostDatabasePath == other.d_hostDatabasePath &&
            d_portDatabaseEnabled == other.d_portDatabaseEnabled &&
            d_portDatabasePath == other.d_portDatabasePath &&
+           d_databaseReloadInterval == other.d_databaseReloadInterval &&
            d_positiveCacheEnabled == other.d_positiveCacheEnabled &&
            d_positiveCacheMinTimeToLive ==
                other.d_positiveCacheMinTimeToLive &&
@@ -415,6 +564,13 @@ bool ResolverConfig::equals(const ResolverConfig& other) const
                other.d_negativeCacheMinTimeToLive &&
            d_negativeCacheMaxTimeToLive ==
                other.d_negativeCacheMaxTimeToLive &&
+           d_cacheMaxEntries == other.d_cacheMaxEntries &&
+           d_cacheSnapshotPath == other.d_cacheSnapshotPath &&
+           d_cacheSnapshotInterval == other.d_cacheSnapshotInterval &&
+           d_endpointCacheEnabled == other.d_endpointCacheEnabled &&
+           d_endpointCacheMaxEntries == other.d_endpointCacheMaxEntries &&
+           d_endpointCacheMaxTimeToLive ==
+               other.d_endpointCacheMaxTimeToLive &&
            d_clientEnabled == other.d_clientEnabled &&
            d_clientSpecificationPath == other.d_clientSpecificationPath &&
            d_clientRemoteEndpointList == other.d_clientRemoteEndpointList &&
@@ -424,9 +580,12 @@ bool ResolverConfig::equals(const ResolverConfig& other) const
            d_clientRotate == other.d_clientRotate &&
            d_clientDots == other.d_clientDots &&
            d_clientDebug == other.d_clientDebug &&
+           d_clientHedgeDelay == other.d_clientHedgeDelay &&
+           d_clientHedgePercentile == other.d_clientHedgePercentile &&
            d_systemEnabled == other.d_systemEnabled &&
            d_systemMinThreads == other.d_systemMinThreads &&
            d_systemMaxThreads == other.d_systemMaxThreads &&
+           d_blockingEnabled == other.d_blockingEnabled &&
            d_serverEnabled == other.d_serverEnabled &&
            d_serverSourceEndpointList == other.d_serverSourceEndpointList;
 }
@@ -454,6 +613,11 @@ bsl::ostream& ResolverConfig::print(bsl::ostream& stream,
         printer.printAttribute("portDatabasePath", d_portDatabasePath);
     }
 
+    if (!d_databaseReloadInterval.isNull()) {
+        printer.printAttribute("databaseReloadInterval",
+                               d_databaseReloadInterval);
+    }
+
     if (!d_positiveCacheEnabled.isNull()) {
         printer.printAttribute("positiveCacheEnabled", d_positiveCacheEnabled);
     }
@@ -482,6 +646,33 @@ bsl::ostream& ResolverConfig::print(bsl::ostream& stream,
                                d_negativeCacheMaxTimeToLive);
     }
 
+    if (!d_cacheMaxEntries.isNull()) {
+        printer.printAttribute("cacheMaxEntries", d_cacheMaxEntries);
+    }
+
+    if (!d_cacheSnapshotPath.isNull()) {
+        printer.printAttribute("cacheSnapshotPath", d_cacheSnapshotPath);
+    }
+
+    if (!d_cacheSnapshotInterval.isNull()) {
+        printer.printAttribute("cacheSnapshotInterval",
+                               d_cacheSnapshotInterval);
+    }
+
+    if (!d_endpointCacheEnabled.isNull()) {
+        printer.printAttribute("endpointCacheEnabled", d_endpointCacheEnabled);
+    }
+
+    if (!d_endpointCacheMaxEntries.isNull()) {
+        printer.printAttribute("endpointCacheMaxEntries",
+                               d_endpointCacheMaxEntries);
+    }
+
+    if (!d_endpointCacheMaxTimeToLive.isNull()) {
+        printer.printAttribute("endpointCacheMaxTimeToLive",
+                               d_endpointCacheMaxTimeToLive);
+    }
+
     if (!d_clientEnabled.isNull()) {
         printer.printAttribute("clientEnabled", d_clientEnabled);
     }
@@ -521,6 +712,15 @@ bsl::ostream& ResolverConfig::print(bsl::ostream& stream,
         printer.printAttribute("clientDebug", d_clientDebug);
     }
 
+    if (!d_clientHedgeDelay.isNull()) {
+        printer.printAttribute("clientHedgeDelay", d_clientHedgeDelay);
+    }
+
+    if (!d_clientHedgePercentile.isNull()) {
+        printer.printAttribute("clientHedgePercentile",
+                               d_clientHedgePercentile);
+    }
+
     if (!d_systemEnabled.isNull()) {
         printer.printAttribute("systemEnabled", d_systemEnabled);
     }
@@ -533,6 +733,10 @@ bsl::ostream& ResolverConfig::print(bsl::ostream& stream,
         printer.printAttribute("systemMaxThreads", d_systemMaxThreads);
     }
 
+    if (!d_blockingEnabled.isNull()) {
+        printer.printAttribute("blockingEnabled", d_blockingEnabled);
+    }
+
     if (!d_serverEnabled.isNull()) {
         printer.printAttribute("serverEnabled", d_serverEnabled);
     }
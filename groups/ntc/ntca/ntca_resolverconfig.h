@@ -75,6 +75,13 @@ namespace ntca {
 /// path is "/etc/services"; on Windows, the default path is
 /// "C:\Windows\System32\drivers\etc\services".
 ///
+/// @li @b databaseReloadInterval:
+/// The interval, in seconds, at which the files from which the host and port
+/// databases were loaded are checked for modification, and reloaded if
+/// modified. Lookups continue against the previous entries while a reload is
+/// in progress. The default value is null, indicating the databases are
+/// loaded once and never reloaded.
+///
 /// @li @b positiveCacheEnabled:
 /// The flag indicating a cache of positive results should be maintained. A
 /// positive result is a successful resolution. The default value is null,
@@ -101,6 +108,44 @@ namespace ntca {
 /// The maximum time-to-live that any negative result is cached. The default
 /// value is null, indicating no maximum time-to-live is enforced.
 ///
+/// @li @b cacheMaxEntries:
+/// The maximum number of domain name to IP address associations retained by
+/// the cache. When the limit is reached, the least recently used association
+/// is evicted. The default value is null, indicating the implementation
+/// selects a reasonable limit.
+///
+/// @li @b cacheSnapshotPath:
+/// The path to the file that stores a snapshot of the positive cache. When
+/// set, the snapshot is loaded when the resolver starts, with the remaining
+/// time-to-live of each entry reduced by the wall time elapsed since the
+/// snapshot was saved, and the snapshot is saved when the resolver is shut
+/// down. The default value is null, indicating the cache is not persisted.
+///
+/// @li @b cacheSnapshotInterval:
+/// The interval, in seconds, at which the snapshot of the positive cache is
+/// periodically saved, in addition to when the resolver is shut down. The
+/// default value is null, indicating the snapshot is only saved when the
+/// resolver is shut down. This value is ignored unless the
+/// 'cacheSnapshotPath' is set.
+///
+/// @li @b endpointCacheEnabled:
+/// The flag indicating that endpoints resolved from text that names a host
+/// or service are cached, keyed by the text and the options, so that
+/// subsequent resolutions of the same text complete without being parsed
+/// and without consulting the overrides, databases, caches, or the DNS
+/// client. The default value is null, indicating endpoints are not cached.
+///
+/// @li @b endpointCacheMaxEntries:
+/// The maximum number of entries in the endpoint cache. When the cache is
+/// full, the least recently used entry is evicted. The default value is
+/// null, indicating a limit of 1024 entries.
+///
+/// @li @b endpointCacheMaxTimeToLive:
+/// The maximum time-to-live, in seconds, of each entry in the endpoint
+/// cache. Entries resolved by the DNS client expire no later than the
+/// time-to-live of their records. The default value is null, indicating a
+/// maximum of 60 seconds.
+///
 /// @li @b clientEnabled:
 /// The flag that indicates a DNS client should run. The default value is null,
 /// which indicates a DNS client is run.
@@ -155,6 +200,20 @@ namespace ntca {
 /// client. The default value is null, indicating the value is defined by the
 /// system's DNS client configuration.
 ///
+/// @li @b clientHedgeDelay:
+/// The delay, in milliseconds, after which a query sent by the DNS client that
+/// has not yet been answered is also sent to the next name server, with the
+/// first answer received taken as the result. The default value is null,
+/// indicating the value is defined by the system's DNS client configuration,
+/// where queries are not hedged unless otherwise specified.
+///
+/// @li @b clientHedgePercentile:
+/// The percentile, from 1 to 99, of the latencies observed by the DNS client
+/// from each name server after which a query to that name server is hedged to
+/// the next name server. Until enough latencies are observed, the hedge delay
+/// is used instead. The default value is null, indicating the value is
+/// defined by the system's DNS client configuration.
+///
 /// @li @b systemEnabled:
 /// The flag indicating that name resolution by blocking system calls made by a
 /// dedicated thread pool is enabled. When blocking system calls by a dedicated
@@ -177,6 +236,17 @@ namespace ntca {
 /// indicating the thread pool as one maximum thread. Note that the thread pool
 /// grows and shrinks on-demand.
 ///
+/// @li @b blockingEnabled:
+/// The flag indicating the resolver may call blocking system functions. When
+/// blocking is disabled, the resolver never dispatches a resolution to a
+/// thread pool: it answers only from its overrides, host database, port
+/// database, cache, and DNS client, and completes every resolution on the
+/// threads driving its interface. The host database and DNS client are then
+/// enabled, unless configured explicitly, according to the "hosts" entry of
+/// "/etc/nsswitch.conf", and the DNS client is configured from
+/// "/etc/resolv.conf". The default value is null, indicating blocking system
+/// functions may be called.
+///
 /// @li @b serverEnabled:
 /// The flag that indicates a DNS server should run. The default value is null,
 /// which indicates a DNS server is *not* run.
@@ -195,12 +265,19 @@ class ResolverConfig
     bdlb::NullableValue<bsl::string> d_hostDatabasePath;
     bdlb::NullableValue<bool>        d_portDatabaseEnabled;
     bdlb::NullableValue<bsl::string> d_portDatabasePath;
+    bdlb::NullableValue<bsl::size_t> d_databaseReloadInterval;
     bdlb::NullableValue<bool>        d_positiveCacheEnabled;
     bdlb::NullableValue<bsl::size_t> d_positiveCacheMinTimeToLive;
     bdlb::NullableValue<bsl::size_t> d_positiveCacheMaxTimeToLive;
     bdlb::NullableValue<bool>        d_negativeCacheEnabled;
     bdlb::NullableValue<bsl::size_t> d_negativeCacheMinTimeToLive;
     bdlb::NullableValue<bsl::size_t> d_negativeCacheMaxTimeToLive;
+    bdlb::NullableValue<bsl::size_t> d_cacheMaxEntries;
+    bdlb::NullableValue<bsl::string> d_cacheSnapshotPath;
+    bdlb::NullableValue<bsl::size_t> d_cacheSnapshotInterval;
+    bdlb::NullableValue<bool>        d_endpointCacheEnabled;
+    bdlb::NullableValue<bsl::size_t> d_endpointCacheMaxEntries;
+    bdlb::NullableValue<bsl::size_t> d_endpointCacheMaxTimeToLive;
     bdlb::NullableValue<bool>        d_clientEnabled;
     bdlb::NullableValue<bsl::string> d_clientSpecificationPath;
     bsl::vector<ntsa::Endpoint>      d_clientRemoteEndpointList;
@@ -210,9 +287,12 @@ class ResolverConfig
     bdlb::NullableValue<bool>        d_clientRotate;
     bdlb::NullableValue<bsl::size_t> d_clientDots;
     bdlb::NullableValue<bool>        d_clientDebug;
+    bdlb::NullableValue<bsl::size_t> d_clientHedgeDelay;
+    bdlb::NullableValue<bsl::size_t> d_clientHedgePercentile;
     bdlb::NullableValue<bool>        d_systemEnabled;
     bdlb::NullableValue<bsl::size_t> d_systemMinThreads;
     bdlb::NullableValue<bsl::size_t> d_systemMaxThreads;
+    bdlb::NullableValue<bool>        d_blockingEnabled;
     bdlb::NullableValue<bool>        d_serverEnabled;
     bsl::vector<ntsa::Endpoint>      d_serverSourceEndpointList;
 
@@ -270,6 +350,12 @@ class ResolverConfig
     /// "C:\Windows\System32\drivers\etc\services".
     void setPortDatabasePath(const bsl::string& value);
 
+    /// Set the interval, in seconds, at which the files from which the host
+    /// and port databases were loaded are checked for modification, and
+    /// reloaded if modified, to the specified 'value'. The default value is
+    /// null, indicating the databases are never reloaded.
+    void setDatabaseReloadInterval(bsl::size_t value);
+
     /// Set the flag indicating the positive cache is enabled to the
     /// specified 'value'. The positive cache remembers results from
     /// successful resolutions. The default value is null, indicating a
@@ -302,6 +388,40 @@ class ResolverConfig
     /// indicating no maximum time-to-live is enforced.
     void setNegativeCacheMaxTimeToLive(bsl::size_t value);
 
+    /// Set the maximum number of domain name to IP address associations
+    /// retained by the cache to the specified 'value'. When the limit is
+    /// reached, the least recently used association is evicted. The default
+    /// value is null, indicating the implementation selects a reasonable
+    /// limit.
+    void setCacheMaxEntries(bsl::size_t value);
+
+    /// Set the path to the file that stores a snapshot of the positive
+    /// cache to the specified 'value'. The snapshot is loaded when the
+    /// resolver starts and saved when the resolver is shut down. The
+    /// default value is null, indicating the cache is not persisted.
+    void setCacheSnapshotPath(const bsl::string& value);
+
+    /// Set the interval, in seconds, at which the snapshot of the positive
+    /// cache is periodically saved to the specified 'value'. The default
+    /// value is null, indicating the snapshot is only saved when the
+    /// resolver is shut down.
+    void setCacheSnapshotInterval(bsl::size_t value);
+
+    /// Set the flag indicating that endpoints resolved from text that names
+    /// a host or service are cached to the specified 'value'. The default
+    /// value is null, indicating endpoints are not cached.
+    void setEndpointCacheEnabled(bool value);
+
+    /// Set the maximum number of entries in the endpoint cache to the
+    /// specified 'value'. The default value is null, indicating a limit of
+    /// 1024 entries.
+    void setEndpointCacheMaxEntries(bsl::size_t value);
+
+    /// Set the maximum time-to-live, in seconds, of each entry in the
+    /// endpoint cache to the specified 'value'. The default value is null,
+    /// indicating a maximum of 60 seconds.
+    void setEndpointCacheMaxTimeToLive(bsl::size_t value);
+
     /// Set the flag indicating the DNS client is enabled to the specified
     /// 'value'. When the DNS client is enabled, if a resolution is neither
     /// found in a database nor a cache the remote name servers are
@@ -368,6 +488,20 @@ class ResolverConfig
     /// configuration.
     void setClientDebug(bool value);
 
+    /// Set the delay, in milliseconds, after which a query sent by the DNS
+    /// client that has not yet been answered is also sent to the next name
+    /// server to the specified 'value'. The default value is null,
+    /// indicating the value is defined by the system's DNS client
+    /// configuration.
+    void setClientHedgeDelay(bsl::size_t value);
+
+    /// Set the percentile, from 1 to 99, of the latencies observed from
+    /// each name server after which a query to that name server is hedged
+    /// to the next name server to the specified 'value'. The default value
+    /// is null, indicating the value is defined by the system's DNS client
+    /// configuration.
+    void setClientHedgePercentile(bsl::size_t value);
+
     /// Set the flag indicating that name resolution by blocking system
     /// calls made by a dedicated thread pool is enabled to the specified
     /// 'value'. When blocking system calls by a dedicated thread pool are
@@ -394,6 +528,14 @@ class ResolverConfig
     /// shrinks on-demand.
     void setSystemMaxThreads(bsl::size_t value);
 
+    /// Set the flag indicating the resolver may call blocking system
+    /// functions to the specified 'value'. When blocking is disabled, the
+    /// resolver answers only from its overrides, databases, cache, and DNS
+    /// client, and never dispatches a resolution to a thread pool. The
+    /// default value is null, indicating blocking system functions may be
+    /// called.
+    void setBlockingEnabled(bool value);
+
     /// Set the flag indicating the DNS server is enabled to the specified
     /// 'value'. The default value is null, which indicates a DNS server is
     /// *not* run.
@@ -432,6 +574,12 @@ class ResolverConfig
     ///  Windows, the path is "C:\Windows\System32\drivers\etc\services".
     const bdlb::NullableValue<bsl::string>& portDatabasePath() const;
 
+    /// Return the interval, in seconds, at which the files from which the
+    /// host and port databases were loaded are checked for modification,
+    /// and reloaded if modified. The default value is null, indicating the
+    /// databases are never reloaded.
+    const bdlb::NullableValue<bsl::size_t>& databaseReloadInterval() const;
+
     /// Return the flag indicating the positive cache is enabled. The
     /// positive cache remembers results from successful resolutions. The
     /// default value is null, indicating a positive cache should *not* be
@@ -464,6 +612,36 @@ class ResolverConfig
     /// time-to-live is enforced.
     const bdlb::NullableValue<bsl::size_t>& negativeCacheMaxTimeToLive() const;
 
+    /// Return the maximum number of domain name to IP address associations
+    /// retained by the cache. The default value is null, indicating the
+    /// implementation selects a reasonable limit.
+    const bdlb::NullableValue<bsl::size_t>& cacheMaxEntries() const;
+
+    /// Return the path to the file that stores a snapshot of the positive
+    /// cache. The default value is null, indicating the cache is not
+    /// persisted.
+    const bdlb::NullableValue<bsl::string>& cacheSnapshotPath() const;
+
+    /// Return the interval, in seconds, at which the snapshot of the
+    /// positive cache is periodically saved. The default value is null,
+    /// indicating the snapshot is only saved when the resolver is shut down.
+    const bdlb::NullableValue<bsl::size_t>& cacheSnapshotInterval() const;
+
+    /// Return the flag indicating that endpoints resolved from text that
+    /// names a host or service are cached. The default value is null,
+    /// indicating endpoints are not cached.
+    const bdlb::NullableValue<bool>& endpointCacheEnabled() const;
+
+    /// Return the maximum number of entries in the endpoint cache. The
+    /// default value is null, indicating a limit of 1024 entries.
+    const bdlb::NullableValue<bsl::size_t>& endpointCacheMaxEntries() const;
+
+    /// Return the maximum time-to-live, in seconds, of each entry in the
+    /// endpoint cache. The default value is null, indicating a maximum of 60
+    /// seconds.
+    const bdlb::NullableValue<bsl::size_t>& endpointCacheMaxTimeToLive()
+        const;
+
     /// Return the flag indicating the DNS client is enabled. When the DNS
     /// client is enabled, if a resolution is neither found in a database
     /// nor a cache the remote name servers are requested to perform the
@@ -526,6 +704,18 @@ class ResolverConfig
     /// defined by the system's DNS client configuration.
     const bdlb::NullableValue<bool>& clientDebug() const;
 
+    /// Return the delay, in milliseconds, after which a query sent by the
+    /// DNS client that has not yet been answered is also sent to the next
+    /// name server. The default value is null, indicating the value is
+    /// defined by the system's DNS client configuration.
+    const bdlb::NullableValue<bsl::size_t>& clientHedgeDelay() const;
+
+    /// Return the percentile, from 1 to 99, of the latencies observed from
+    /// each name server after which a query to that name server is hedged
+    /// to the next name server. The default value is null, indicating the
+    /// value is defined by the system's DNS client configuration.
+    const bdlb::NullableValue<bsl::size_t>& clientHedgePercentile() const;
+
     /// Return the flag indicating that name resolution by blocking system
     /// calls made by a dedicated thread pool is enabled. When blocking
     /// system calls by a dedicated thread pool are enabled, if a
@@ -550,6 +740,13 @@ class ResolverConfig
     /// thread. Note that the thread pool grows and shrinks on-demand.
     const bdlb::NullableValue<bsl::size_t>& systemMaxThreads() const;
 
+    /// Return the flag indicating the resolver may call blocking system
+    /// functions. When blocking is disabled, the resolver answers only from
+    /// its overrides, databases, cache, and DNS client, and never
+    /// dispatches a resolution to a thread pool. The default value is null,
+    /// indicating blocking system functions may be called.
+    const bdlb::NullableValue<bool>& blockingEnabled() const;
+
     /// Return the flag indicating the DNS server is enabled. The default
     /// value is null, which indicates a DNS server is *not* run.
     const bdlb::NullableValue<bool>& serverEnabled() const;
@@ -54,6 +54,7 @@ StreamSocketOptions::StreamSocketOptions(bslma::Allocator* basicAllocator)
 , d_timestampOutgoingData()
 , d_timestampIncomingData()
 , d_zeroCopyThreshold()
+, d_hibernationTimeout()
 , d_loadBalancingOptions()
 , d_compressionConfig()
 , d_serializationConfig(basicAllocator)
@@ -92,6 +93,7 @@ StreamSocketOptions::StreamSocketOptions(const StreamSocketOptions& other,
 , d_timestampOutgoingData(other.d_timestampOutgoingData)
 , d_timestampIncomingData(other.d_timestampIncomingData)
 , d_zeroCopyThreshold(other.d_zeroCopyThreshold)
+, d_hibernationTimeout(other.d_hibernationTimeout)
 , d_loadBalancingOptions(other.d_loadBalancingOptions)
 , d_compressionConfig(other.d_compressionConfig)
 , d_serializationConfig(other.d_serializationConfig, basicAllocator)
@@ -138,6 +140,7 @@ StreamSocketOptions& StreamSocketOptions::operator=(
         d_timestampOutgoingData     = other.d_timestampOutgoingData;
         d_timestampIncomingData     = other.d_timestampIncomingData;
         d_zeroCopyThreshold         = other.d_zeroCopyThreshold;
+        d_hibernationTimeout        = other.d_hibernationTimeout;
         d_loadBalancingOptions      = other.d_loadBalancingOptions;
         d_compressionConfig         = other.d_compressionConfig;
         d_serializationConfig       = other.d_serializationConfig;
@@ -299,6 +302,12 @@ void StreamSocketOptions::setZeroCopyThreshold(size_t value)
     d_zeroCopyThreshold = value;
 }
 
+void StreamSocketOptions::setHibernationTimeout(
+    const bsls::TimeInterval& value)
+{
+    d_hibernationTimeout = value;
+}
+
 void StreamSocketOptions::setLoadBalancingOptions(
     const ntca::LoadBalancingOptions& value)
 {
@@ -486,6 +495,12 @@ const bdlb::NullableValue<bsl::size_t>& StreamSocketOptions::
     return d_zeroCopyThreshold;
 }
 
+const bdlb::NullableValue<bsls::TimeInterval>& StreamSocketOptions::
+    hibernationTimeout() const
+{
+    return d_hibernationTimeout;
+}
+
 const ntca::LoadBalancingOptions& StreamSocketOptions::loadBalancingOptions()
     const
 {
@@ -547,6 +562,7 @@ bsl::ostream& StreamSocketOptions::print(bsl::ostream& stream,
     printer.printAttribute("timestampOutgoingData", d_timestampOutgoingData);
     printer.printAttribute("timestampIncomingData", d_timestampIncomingData);
     printer.printAttribute("zeroCopyThreshold", d_zeroCopyThreshold);
+    printer.printAttribute("hibernationTimeout", d_hibernationTimeout);
     printer.printAttribute("loadBalancingOptions", d_loadBalancingOptions);
 
     if (d_compressionConfig.has_value()) {
@@ -594,6 +610,7 @@ bool operator==(const StreamSocketOptions& lhs, const StreamSocketOptions& rhs)
            lhs.timestampOutgoingData() == rhs.timestampOutgoingData() &&
            lhs.timestampIncomingData() == rhs.timestampIncomingData() &&
            lhs.zeroCopyThreshold() == rhs.zeroCopyThreshold() &&
+           lhs.hibernationTimeout() == rhs.hibernationTimeout() &&
            lhs.loadBalancingOptions() == rhs.loadBalancingOptions() &&
            lhs.compressionConfig() == rhs.compressionConfig() &&
            lhs.serializationConfig() == rhs.serializationConfig();
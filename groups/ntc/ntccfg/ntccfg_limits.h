@@ -114,6 +114,13 @@ namespace ntccfg {
 /// @ingroup module_ntccfg
 #define NTCCFG_DEFAULT_STREAM_SOCKET_MAX_INCOMING_TRANSFER_SIZE 524288
 
+/// The default minimum interval, in milliseconds, between samples of the
+/// TCP_INFO state of a stream socket, when socket metrics are collected.
+/// The default value is 1000.
+///
+/// @ingroup module_ntccfg
+#define NTCCFG_DEFAULT_STREAM_SOCKET_TCP_INFO_INTERVAL 1000
+
 /// The default write queue low watermark limit for a datagram socket, in
 /// bytes. The default value is 0.
 ///
@@ -246,6 +253,20 @@ namespace ntccfg {
 /// @ingroup module_ntccfg
 #define NTCCFG_DEFAULT_SOCKET_METRICS_PER_HANDLE false
 
+/// The default behavior to recycle closed stream sockets, and the memory of
+/// other closed sockets, for subsequently created or accepted sockets. The
+/// default value is false.
+///
+/// @ingroup module_ntccfg
+#define NTCCFG_DEFAULT_SOCKET_RECYCLING false
+
+/// The default maximum number of closed stream sockets retained by an
+/// interface for reuse when socket recycling is enabled. The default value
+/// is 1024.
+///
+/// @ingroup module_ntccfg
+#define NTCCFG_DEFAULT_SOCKET_POOL_CAPACITY 1024
+
 /// The default number of scatter/gather buffers stored in a buffer array
 /// arena. The default value is 64.
 ///
@@ -27,6 +27,8 @@ BSLS_IDENT_RCSID(ntcd_machine_cpp, "$Id$ $CSID$")
 #include <bslma_default.h>
 #include <bslmt_lockguard.h>
 #include <bsls_assert.h>
+#include <bsls_systemtime.h>
+#include <bsls_types.h>
 #include <bsl_ostream.h>
 
 #define NTCD_SESSION_LOG_OUTGOING_PACKET_QUEUE_ENQUEUE_ERROR(machine,         \
@@ -1402,6 +1404,366 @@ bool operator<(const Binding& lhs, const Binding& rhs)
     return lhs.less(rhs);
 }
 
+Impairment::Impairment()
+: d_latency()
+, d_jitter()
+, d_bandwidth(0)
+, d_lossProbability(0.0)
+, d_reorderProbability(0.0)
+, d_seed(1)
+{
+}
+
+Impairment::Impairment(const Impairment& original)
+: d_latency(original.d_latency)
+, d_jitter(original.d_jitter)
+, d_bandwidth(original.d_bandwidth)
+, d_lossProbability(original.d_lossProbability)
+, d_reorderProbability(original.d_reorderProbability)
+, d_seed(original.d_seed)
+{
+}
+
+Impairment::~Impairment()
+{
+}
+
+Impairment& Impairment::operator=(const Impairment& other)
+{
+    if (this != &other) {
+        d_latency            = other.d_latency;
+        d_jitter             = other.d_jitter;
+        d_bandwidth          = other.d_bandwidth;
+        d_lossProbability    = other.d_lossProbability;
+        d_reorderProbability = other.d_reorderProbability;
+        d_seed               = other.d_seed;
+    }
+
+    return *this;
+}
+
+void Impairment::reset()
+{
+    d_latency            = bsls::TimeInterval();
+    d_jitter             = bsls::TimeInterval();
+    d_bandwidth          = 0;
+    d_lossProbability    = 0.0;
+    d_reorderProbability = 0.0;
+    d_seed               = 1;
+}
+
+void Impairment::setLatency(const bsls::TimeInterval& latency)
+{
+    d_latency = latency;
+}
+
+void Impairment::setJitter(const bsls::TimeInterval& jitter)
+{
+    d_jitter = jitter;
+}
+
+void Impairment::setBandwidth(bsl::size_t bandwidth)
+{
+    d_bandwidth = bandwidth;
+}
+
+void Impairment::setLossProbability(double lossProbability)
+{
+    d_lossProbability = lossProbability;
+}
+
+void Impairment::setReorderProbability(double reorderProbability)
+{
+    d_reorderProbability = reorderProbability;
+}
+
+void Impairment::setSeed(bsl::uint64_t seed)
+{
+    d_seed = seed;
+}
+
+const bsls::TimeInterval& Impairment::latency() const
+{
+    return d_latency;
+}
+
+const bsls::TimeInterval& Impairment::jitter() const
+{
+    return d_jitter;
+}
+
+bsl::size_t Impairment::bandwidth() const
+{
+    return d_bandwidth;
+}
+
+double Impairment::lossProbability() const
+{
+    return d_lossProbability;
+}
+
+double Impairment::reorderProbability() const
+{
+    return d_reorderProbability;
+}
+
+bsl::uint64_t Impairment::seed() const
+{
+    return d_seed;
+}
+
+bool Impairment::isNone() const
+{
+    return d_latency <= bsls::TimeInterval() &&
+           d_jitter <= bsls::TimeInterval() && d_bandwidth == 0 &&
+           d_lossProbability <= 0.0 && d_reorderProbability <= 0.0;
+}
+
+bool Impairment::equals(const Impairment& other) const
+{
+    return d_latency == other.d_latency && d_jitter == other.d_jitter &&
+           d_bandwidth == other.d_bandwidth &&
+           d_lossProbability == other.d_lossProbability &&
+           d_reorderProbability == other.d_reorderProbability &&
+           d_seed == other.d_seed;
+}
+
+bsl::ostream& Impairment::print(bsl::ostream& stream,
+                                int           level,
+                                int           spacesPerLevel) const
+{
+    bslim::Printer printer(&stream, level, spacesPerLevel);
+    printer.start();
+    printer.printAttribute("latency", d_latency);
+    printer.printAttribute("jitter", d_jitter);
+    printer.printAttribute("bandwidth", d_bandwidth);
+    printer.printAttribute("lossProbability", d_lossProbability);
+    printer.printAttribute("reorderProbability", d_reorderProbability);
+    printer.printAttribute("seed", d_seed);
+    printer.end();
+    return stream;
+}
+
+bsl::ostream& operator<<(bsl::ostream& stream, const Impairment& object)
+{
+    return object.print(stream, 0, -1);
+}
+
+bool operator==(const Impairment& lhs, const Impairment& rhs)
+{
+    return lhs.equals(rhs);
+}
+
+bool operator!=(const Impairment& lhs, const Impairment& rhs)
+{
+    return !operator==(lhs, rhs);
+}
+
+// The minimum retransmission timeout is the default minimum of the Linux TCP
+// stack; the minimum reorder delay ensures a packet held back on a link
+// without latency is still overtaken.
+
+const bsls::TimeInterval Link::k_MIN_RETRANSMISSION_TIMEOUT(0, 200000000);
+const bsls::TimeInterval Link::k_MIN_REORDER_DELAY(0, 1000000);
+
+double Link::random()
+{
+    // Generate the next number in the SplitMix64 sequence and scale its
+    // upper 53 bits into [0.0, 1.0).
+
+    bsl::uint64_t z = (d_random += 0x9E3779B97F4A7C15ULL);
+    z               = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z               = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z               = z ^ (z >> 31);
+
+    return static_cast<double>(z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+Link::Link(bslma::Allocator* basicAllocator)
+: d_storage(basicAllocator)
+, d_idleTime()
+, d_lastDeliveryTime()
+, d_random(0)
+, d_seeded(false)
+, d_numPacketsLost(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+Link::~Link()
+{
+}
+
+bool Link::transmit(const bsl::shared_ptr<ntcd::Packet>& packet,
+                    const ntcd::Impairment&              impairment,
+                    bool                                 ordered,
+                    const bsls::TimeInterval&            now)
+{
+    if (!d_seeded) {
+        d_random = impairment.seed();
+        d_seeded = true;
+    }
+
+    // Serialize the packet after any packet still being serialized, at the
+    // bandwidth of the link.
+
+    if (d_idleTime < now) {
+        d_idleTime = now;
+    }
+
+    if (impairment.bandwidth() != 0) {
+        const double nanoseconds = static_cast<double>(packet->cost()) *
+                                   1000000000.0 /
+                                   static_cast<double>(impairment.bandwidth());
+
+        d_idleTime.addNanoseconds(
+            static_cast<bsls::Types::Int64>(nanoseconds));
+    }
+
+    // The packet arrives one latency, plus jitter, after its last byte is
+    // serialized.
+
+    bsls::TimeInterval deliveryTime = d_idleTime;
+    deliveryTime += impairment.latency();
+
+    if (impairment.jitter() > bsls::TimeInterval()) {
+        deliveryTime.addNanoseconds(static_cast<bsls::Types::Int64>(
+            this->random() *
+            static_cast<double>(impairment.jitter().totalNanoseconds())));
+    }
+
+    const bool isData = packet->type() == ntcd::PacketType::e_PUSH;
+
+    if (isData && impairment.lossProbability() > 0.0 &&
+        this->random() < impairment.lossProbability())
+    {
+        ++d_numPacketsLost;
+
+        if (!ordered) {
+            return false;
+        }
+
+        // Approximate the retransmission timeout of a reliable transport
+        // from the round-trip time and its variation.
+
+        bsls::TimeInterval retransmissionTimeout;
+        retransmissionTimeout.addNanoseconds(
+            2 * impairment.latency().totalNanoseconds() +
+            4 * impairment.jitter().totalNanoseconds());
+
+        if (retransmissionTimeout < k_MIN_RETRANSMISSION_TIMEOUT) {
+            retransmissionTimeout = k_MIN_RETRANSMISSION_TIMEOUT;
+        }
+
+        deliveryTime += retransmissionTimeout;
+    }
+
+    if (ordered) {
+        if (deliveryTime < d_lastDeliveryTime) {
+            deliveryTime = d_lastDeliveryTime;
+        }
+    }
+    else if (isData && impairment.reorderProbability() > 0.0 &&
+             this->random() < impairment.reorderProbability())
+    {
+        bsls::TimeInterval reorderDelay = impairment.latency();
+        reorderDelay += impairment.jitter();
+
+        if (reorderDelay < k_MIN_REORDER_DELAY) {
+            reorderDelay = k_MIN_REORDER_DELAY;
+        }
+
+        deliveryTime += reorderDelay;
+    }
+
+    if (d_lastDeliveryTime < deliveryTime) {
+        d_lastDeliveryTime = deliveryTime;
+    }
+
+    d_storage.insert(Storage::value_type(deliveryTime, packet));
+
+    return true;
+}
+
+bool Link::deliver(bsl::shared_ptr<ntcd::Packet>* result,
+                   bsls::TimeInterval*            deliveryTime,
+                   const bsls::TimeInterval&      now)
+{
+    if (d_storage.empty()) {
+        return false;
+    }
+
+    Storage::iterator it = d_storage.begin();
+    if (now < it->first) {
+        return false;
+    }
+
+    *deliveryTime = it->first;
+    *result       = it->second;
+
+    d_storage.erase(it);
+
+    return true;
+}
+
+void Link::retry(const bsl::shared_ptr<ntcd::Packet>& packet,
+                 const bsls::TimeInterval&            deliveryTime)
+{
+    d_storage.insert(d_storage.lower_bound(deliveryTime),
+                     Storage::value_type(deliveryTime, packet));
+}
+
+void Link::reset()
+{
+    d_storage.clear();
+    d_idleTime         = bsls::TimeInterval();
+    d_lastDeliveryTime = bsls::TimeInterval();
+    d_random           = 0;
+    d_seeded           = false;
+    d_numPacketsLost   = 0;
+}
+
+bool Link::isIdle(const bsls::TimeInterval& now) const
+{
+    return d_idleTime <= now;
+}
+
+bool Link::deadline(bsls::TimeInterval*       result,
+                    const bsls::TimeInterval& now,
+                    bool                      pending) const
+{
+    bool found = false;
+
+    if (!d_storage.empty() && now < d_storage.begin()->first) {
+        *result = d_storage.begin()->first;
+        found   = true;
+    }
+
+    if (pending && now < d_idleTime) {
+        if (!found || d_idleTime < *result) {
+            *result = d_idleTime;
+            found   = true;
+        }
+    }
+
+    return found;
+}
+
+bool Link::empty() const
+{
+    return d_storage.empty();
+}
+
+bsl::size_t Link::size() const
+{
+    return d_storage.size();
+}
+
+bsl::size_t Link::numPacketsLost() const
+{
+    return d_numPacketsLost;
+}
+
 PortMap::PortMap(bslma::Allocator* basicAllocator)
 : d_mutex()
 , d_bitset()
@@ -1714,6 +2076,8 @@ void Session::reset()
     d_backlog          = 0;
     d_tsKey            = 0;
 
+    d_link.reset();
+
     d_socketOptions.reset();
 
     d_socketOptions.setReuseAddress(k_DEFAULT_REUSE_ADDRESS);
@@ -2082,6 +2446,12 @@ class Session::Impl
         bsl::shared_ptr<bsl::list<ntsa::Notification> > errorQueue,
         bsl::uint32_t                                   idIncrement);
 
+    /// For the specified 'packet' generate ntsa::Timestamp with type e_SENT,
+    /// if the packet has an id, then put it into the specified 'errorQueue'.
+    static void generateTransmitTimestampSent(
+        const ntcd::Packet&                                     packet,
+        const bsl::shared_ptr<bsl::list<ntsa::Notification> >& errorQueue);
+
     /// For the specified 'packet' set current time as a timestamp.
     static void generateReceiveTimestamp(ntcd::Packet* packet);
 };
@@ -2103,6 +2473,22 @@ void Session::Impl::generateTransmitTimestampScheduled(
     errorQueue->push_back(n);
 }
 
+void Session::Impl::generateTransmitTimestampSent(
+    const ntcd::Packet&                                     packet,
+    const bsl::shared_ptr<bsl::list<ntsa::Notification> >& errorQueue)
+{
+    if (!packet.id().has_value()) {
+        return;
+    }
+
+    ntsa::Notification n;
+    ntsa::Timestamp&   t = n.makeTimestamp();
+    t.setType(ntsa::TimestampType::e_SENT);
+    t.setTime(bdlt::CurrentTime::now());
+    t.setId(packet.id().value());
+    errorQueue->push_back(n);
+}
+
 void Session::Impl::generateReceiveTimestamp(ntcd::Packet* packet)
 {
     packet->setRxTimestamp(bdlt::CurrentTime::now());
@@ -2161,6 +2547,7 @@ Session::Session(const bsl::shared_ptr<ntcd::Machine>& machine,
 , d_notificationsActive(false)
 , d_backlog(0)
 , d_feedbackQueue(bslma::Default::allocator(basicAllocator))
+, d_link(bslma::Default::allocator(basicAllocator))
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     this->reset();
@@ -3580,27 +3967,73 @@ ntsa::Error Session::step(bool block)
     typedef ntcd::PacketQueue::PacketVector PacketVector;
     PacketVector                            packetsToRetransmit;
 
+    bsl::size_t numPacketsTransmitted = 0;
     bsl::size_t numPacketsTransferred = 0;
 
     ntsa::TransportMode::Value transportMode =
         ntsa::Transport::getMode(d_transport);
 
+    const bool timestampOutgoingData =
+        d_socketOptions.timestampOutgoingData().value_or(false);
+
+    // When any link is impaired, or packets are still in flight over this
+    // session's link, move outgoing packets onto the link only while it is
+    // idle, so a slow link leaves them in the send buffer, then transfer
+    // only those packets whose delivery time has elapsed.
+
+    const bool impaired = d_machine_sp->isImpaired() || !d_link.empty();
+
+    bsls::TimeInterval now;
+    if (impaired) {
+        now = bsls::SystemTime::nowMonotonicClock();
+
+        while (d_link.isIdle(now)) {
+            bsl::shared_ptr<ntcd::Packet> packet;
+            error =
+                d_outgoingPacketQueue_sp->dequeue(&d_mutex, &packet, false);
+            if (error) {
+                break;
+            }
+
+            ++numPacketsTransmitted;
+
+            if (timestampOutgoingData) {
+                Impl::generateTransmitTimestampSent(*packet,
+                                                    d_socketErrorQueue_sp);
+            }
+
+            ntcd::Impairment impairment;
+            d_machine_sp->lookupImpairment(&impairment,
+                                           packet->sourceEndpoint(),
+                                           packet->remoteEndpoint());
+
+            d_link.transmit(packet,
+                            impairment,
+                            transportMode == ntsa::TransportMode::e_STREAM,
+                            now);
+        }
+    }
+
     while (true) {
         bsl::shared_ptr<ntcd::Packet> packet;
-        error = d_outgoingPacketQueue_sp->dequeue(&d_mutex, &packet, block);
-        if (error) {
-            break;
+        bsls::TimeInterval            deliveryTime;
+
+        if (impaired) {
+            if (!d_link.deliver(&packet, &deliveryTime, now)) {
+                break;
+            }
         }
+        else {
+            error =
+                d_outgoingPacketQueue_sp->dequeue(&d_mutex, &packet, block);
+            if (error) {
+                break;
+            }
 
-        if (d_socketOptions.timestampOutgoingData().value_or(false) &&
-            packet->id().has_value())
-        {
-            ntsa::Notification n;
-            ntsa::Timestamp&   t = n.makeTimestamp();
-            t.setType(ntsa::TimestampType::e_SENT);
-            t.setTime(bdlt::CurrentTime::now());
-            t.setId(packet->id().value());
-            d_socketErrorQueue_sp->push_back(n);
+            if (timestampOutgoingData) {
+                Impl::generateTransmitTimestampSent(*packet,
+                                                    d_socketErrorQueue_sp);
+            }
         }
 
         NTCD_SESSION_LOG_TRANSFERRING_PACKET(d_machine_sp, this, packet);
@@ -3665,6 +4098,18 @@ ntsa::Error Session::step(bool block)
                                                         remoteSession,
                                                         error);
 
+            if (impaired) {
+                // A datagram that arrives at a full receive buffer is
+                // dropped; stream data waits at the head of the link.
+
+                if (transportMode == ntsa::TransportMode::e_STREAM) {
+                    d_link.retry(packet, deliveryTime);
+                    break;
+                }
+
+                continue;
+            }
+
             packetsToRetransmit.push_back(packet);
 
             if (transportMode == ntsa::TransportMode::e_DATAGRAM) {
@@ -3684,6 +4129,16 @@ ntsa::Error Session::step(bool block)
         d_outgoingPacketQueue_sp->retry(packetsToRetransmit);
     }
 
+    if (impaired) {
+        bsls::TimeInterval deadline;
+        if (d_link.deadline(&deadline,
+                            now,
+                            !d_outgoingPacketQueue_sp->empty()))
+        {
+            d_machine_sp->schedule(deadline);
+        }
+    }
+
     bool newFeedback = false;
     if (d_socketOptions.timestampOutgoingData().value_or(false)) {
         ntsa::Timestamp ts;
@@ -3697,7 +4152,9 @@ ntsa::Error Session::step(bool block)
 
     NTCD_SESSION_LOG_STEP_COMPLETE(d_machine_sp, this);
 
-    if (numPacketsTransferred == 0 && !newFeedback) {
+    if (numPacketsTransmitted == 0 && numPacketsTransferred == 0 &&
+        !newFeedback)
+    {
         update.dismiss();
     }
 
@@ -5207,7 +5664,7 @@ const int Machine::k_DEFAULT_BLOB_BUFFER_SIZE = 4096;
 
 Machine::Machine(bslma::Allocator* basicAllocator)
 : d_mutex()
-, d_condition()
+, d_condition(bsls::SystemClockType::e_MONOTONIC)
 , d_name("localhost", basicAllocator)
 , d_ipAddressList(basicAllocator)
 , d_blobBufferFactory(k_DEFAULT_BLOB_BUFFER_SIZE, basicAllocator)
@@ -5220,6 +5677,10 @@ Machine::Machine(bslma::Allocator* basicAllocator)
 , d_sessionByTcpBindingMap(basicAllocator)
 , d_sessionByUdpBindingMap(basicAllocator)
 , d_sessionByLocalBindingMap(basicAllocator)
+, d_impairmentMap(basicAllocator)
+, d_impairment()
+, d_impaired(false)
+, d_deadline()
 , d_threadGroup(basicAllocator)
 , d_stop(false)
 , d_update(false)
@@ -5787,6 +6248,73 @@ void Machine::updateNoLock(const bsl::shared_ptr<ntcd::Session>& session)
     }
 }
 
+void Machine::schedule(const bsls::TimeInterval& deadline)
+{
+    ntccfg::ConditionMutexGuard lock(&d_mutex);
+
+    if (d_deadline == bsls::TimeInterval() || deadline < d_deadline) {
+        d_deadline = deadline;
+        d_condition.broadcast();
+    }
+}
+
+void Machine::setImpairment(const ntcd::Impairment& impairment)
+{
+    ntccfg::ConditionMutexGuard lock(&d_mutex);
+
+    d_impairment = impairment;
+    d_impaired   = !d_impairmentMap.empty() || !d_impairment.isNone();
+}
+
+void Machine::setImpairment(const ntcd::Binding&    binding,
+                            const ntcd::Impairment& impairment)
+{
+    ntccfg::ConditionMutexGuard lock(&d_mutex);
+
+    d_impairmentMap[binding] = impairment;
+    d_impaired               = true;
+}
+
+void Machine::resetImpairment()
+{
+    ntccfg::ConditionMutexGuard lock(&d_mutex);
+
+    d_impairmentMap.clear();
+    d_impairment.reset();
+    d_impaired = false;
+}
+
+bool Machine::lookupImpairment(ntcd::Impairment*     result,
+                               const ntsa::Endpoint& sourceEndpoint,
+                               const ntsa::Endpoint& remoteEndpoint) const
+{
+    ntccfg::ConditionMutexGuard lock(&d_mutex);
+
+    if (!d_impairmentMap.empty()) {
+        const ntcd::Binding candidates[3] = {
+            ntcd::Binding(sourceEndpoint, remoteEndpoint),
+            ntcd::Binding(sourceEndpoint, ntsa::Endpoint()),
+            ntcd::Binding(ntsa::Endpoint(), remoteEndpoint)};
+
+        for (bsl::size_t i = 0; i < 3; ++i) {
+            ImpairmentMap::const_iterator it =
+                d_impairmentMap.find(candidates[i]);
+            if (it != d_impairmentMap.end()) {
+                *result = it->second;
+                return !result->isNone();
+            }
+        }
+    }
+
+    *result = d_impairment;
+    return !result->isNone();
+}
+
+bool Machine::isImpaired() const
+{
+    return d_impaired;
+}
+
 ntsa::Error Machine::run()
 {
     bslmt::ThreadAttributes threadAttributes;
@@ -5830,14 +6358,31 @@ ntsa::Error Machine::step(bool block)
                 break;
             }
 
-            if (block) {
-                d_condition.wait(&d_mutex);
+            const bool scheduled = d_deadline != bsls::TimeInterval();
+
+            if (scheduled &&
+                d_deadline <= bsls::SystemTime::nowMonotonicClock())
+            {
+                break;
             }
-            else {
+
+            if (!block) {
                 return ntsa::Error();
             }
+
+            if (scheduled) {
+                d_condition.timedWait(&d_mutex, d_deadline);
+            }
+            else {
+                d_condition.wait(&d_mutex);
+            }
         }
 
+        // Each session with packets in flight schedules its next deadline
+        // as it is stepped.
+
+        d_deadline = bsls::TimeInterval();
+
         sessions.reserve(d_sessionByHandleMap.size());
 
         for (SessionByHandleMap::iterator it = d_sessionByHandleMap.begin();
@@ -47,7 +47,9 @@ BSLS_IDENT("$Id: $")
 #include <bslmt_threadgroup.h>
 #include <bslmt_threadutil.h>
 #include <bsls_atomic.h>
+#include <bsls_timeinterval.h>
 #include <bsl_bitset.h>
+#include <bsl_cstdint.h>
 #include <bsl_iosfwd.h>
 #include <bsl_list.h>
 #include <bsl_map.h>
@@ -554,6 +556,260 @@ void hashAppend(HASH_ALGORITHM& algorithm, const Binding& value)
     hashAppend(algorithm, value.remoteEndpoint());
 }
 
+/// @internal @brief
+/// Describe the impairment of a simulated link.
+///
+/// @details
+/// An impairment models the behavior of a wide-area network between two
+/// endpoints on a simulated machine: each packet is delayed by the one-way
+/// latency plus a uniformly-distributed jitter, paced to the bandwidth of the
+/// link, and dropped or reordered with the configured probabilities. The
+/// random decisions are drawn from a generator seeded by the seed, so a
+/// simulation run with the same impairment is reproducible. Loss and
+/// reordering are applied only to data on datagram transports: lost stream
+/// data is instead delayed by a simulated retransmission timeout, and
+/// stream data is always delivered in order.
+///
+/// @par Attributes
+/// This class is composed of the following attributes.
+///
+/// @li @b latency:
+/// The one-way delay of each packet. The default value is zero.
+///
+/// @li @b jitter:
+/// The maximum additional, uniformly-distributed delay of each packet. The
+/// default value is zero.
+///
+/// @li @b bandwidth:
+/// The maximum number of bytes per second transmitted over the link, or zero
+/// for no limit. The default value is zero.
+///
+/// @li @b lossProbability:
+/// The probability, in the range [0.0, 1.0], that a packet is lost. The
+/// default value is zero.
+///
+/// @li @b reorderProbability:
+/// The probability, in the range [0.0, 1.0], that a packet is held back so
+/// that packets sent after it are delivered before it. The default value is
+/// zero.
+///
+/// @li @b seed:
+/// The seed of the generator of random decisions. The default value is one.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcd
+class Impairment
+{
+    bsls::TimeInterval d_latency;
+    bsls::TimeInterval d_jitter;
+    bsl::size_t        d_bandwidth;
+    double             d_lossProbability;
+    double             d_reorderProbability;
+    bsl::uint64_t      d_seed;
+
+  public:
+    /// Create a new impairment that does not impair a link.
+    Impairment();
+
+    /// Create a new impairment having the same value as the specified
+    /// 'original' object.
+    Impairment(const Impairment& original);
+
+    /// Destroy this object.
+    ~Impairment();
+
+    /// Assign the value of the specified 'other' object to this object.
+    /// Return a reference to this modifiable object.
+    Impairment& operator=(const Impairment& other);
+
+    /// Reset the value of this object to its value upon default
+    /// construction.
+    void reset();
+
+    /// Set the one-way latency to the specified 'latency'.
+    void setLatency(const bsls::TimeInterval& latency);
+
+    /// Set the maximum jitter to the specified 'jitter'.
+    void setJitter(const bsls::TimeInterval& jitter);
+
+    /// Set the bandwidth, in bytes per second, to the specified
+    /// 'bandwidth'. Specify zero for no limit.
+    void setBandwidth(bsl::size_t bandwidth);
+
+    /// Set the loss probability to the specified 'lossProbability'.
+    void setLossProbability(double lossProbability);
+
+    /// Set the reorder probability to the specified 'reorderProbability'.
+    void setReorderProbability(double reorderProbability);
+
+    /// Set the seed of the generator of random decisions to the specified
+    /// 'seed'.
+    void setSeed(bsl::uint64_t seed);
+
+    /// Return the one-way latency.
+    const bsls::TimeInterval& latency() const;
+
+    /// Return the maximum jitter.
+    const bsls::TimeInterval& jitter() const;
+
+    /// Return the bandwidth, in bytes per second, or zero for no limit.
+    bsl::size_t bandwidth() const;
+
+    /// Return the loss probability.
+    double lossProbability() const;
+
+    /// Return the reorder probability.
+    double reorderProbability() const;
+
+    /// Return the seed of the generator of random decisions.
+    bsl::uint64_t seed() const;
+
+    /// Return true if this impairment has no effect on a link, otherwise
+    /// return false.
+    bool isNone() const;
+
+    /// Return true if this object has the same value as the specified
+    /// 'other' object, otherwise return false.
+    bool equals(const Impairment& other) const;
+
+    /// Format this object to the specified output 'stream' at the
+    /// optionally specified indentation 'level' and return a reference to
+    /// the modifiable 'stream'.  If 'level' is specified, optionally
+    /// specify 'spacesPerLevel', the number of spaces per indentation level
+    /// for this and all of its nested objects.  Each line is indented by
+    /// the absolute value of 'level * spacesPerLevel'.  If 'level' is
+    /// negative, suppress indentation of the first line.  If
+    /// 'spacesPerLevel' is negative, suppress line breaks and format the
+    /// entire output on one line.  If 'stream' is initially invalid, this
+    /// operation has no effect.  Note that a trailing newline is provided
+    /// in multiline mode only.
+    bsl::ostream& print(bsl::ostream& stream,
+                        int           level          = 0,
+                        int           spacesPerLevel = 4) const;
+};
+
+/// Write the specified 'object' to the specified 'stream'. Return
+/// a modifiable reference to the 'stream'.
+///
+/// @related ntcd::Impairment
+bsl::ostream& operator<<(bsl::ostream& stream, const Impairment& object);
+
+/// Return true if the specified 'lhs' has the same value as the specified
+/// 'rhs', otherwise return false.
+///
+/// @related ntcd::Impairment
+bool operator==(const Impairment& lhs, const Impairment& rhs);
+
+/// Return true if the specified 'lhs' does not have the same value as the
+/// specified 'rhs', otherwise return false.
+///
+/// @related ntcd::Impairment
+bool operator!=(const Impairment& lhs, const Impairment& rhs);
+
+/// @internal @brief
+/// Provide the packets in flight over a simulated, impaired link.
+///
+/// @details
+/// A link holds each packet transmitted by a session until its delivery
+/// time, computed from the impairment in effect when the packet is
+/// transmitted. The link is busy while it serializes a packet at its
+/// bandwidth; a session should leave packets in its outgoing packet queue
+/// until the link is idle so that a slow link fills the send buffer and
+/// applies backpressure to the sender.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcd
+class Link
+{
+    /// This typedef defines a map of packets indexed by delivery time.
+    typedef bsl::multimap<bsls::TimeInterval, bsl::shared_ptr<ntcd::Packet> >
+        Storage;
+
+    Storage            d_storage;
+    bsls::TimeInterval d_idleTime;
+    bsls::TimeInterval d_lastDeliveryTime;
+    bsl::uint64_t      d_random;
+    bool               d_seeded;
+    bsl::size_t        d_numPacketsLost;
+    bslma::Allocator*  d_allocator_p;
+
+    static const bsls::TimeInterval k_MIN_RETRANSMISSION_TIMEOUT;
+    static const bsls::TimeInterval k_MIN_REORDER_DELAY;
+
+  private:
+    Link(const Link&) BSLS_KEYWORD_DELETED;
+    Link& operator=(const Link&) BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Return the next random number in the range [0.0, 1.0).
+    double random();
+
+  public:
+    /// Create a new link. Optionally specify a 'basicAllocator' used to
+    /// supply memory. If 'basicAllocator' is 0, the currently installed
+    /// default allocator is used.
+    explicit Link(bslma::Allocator* basicAllocator = 0);
+
+    /// Destroy this object.
+    ~Link();
+
+    /// Transmit the specified 'packet' at the specified 'now' over this link
+    /// impaired by the specified 'impairment'. If the specified 'ordered'
+    /// flag is true, deliver the packet no earlier than any packet
+    /// previously transmitted and model loss as a retransmission delay.
+    /// Return true if the packet is in flight, and false if the packet is
+    /// lost.
+    bool transmit(const bsl::shared_ptr<ntcd::Packet>& packet,
+                  const ntcd::Impairment&              impairment,
+                  bool                                 ordered,
+                  const bsls::TimeInterval&            now);
+
+    /// Load into the specified 'result' the packet having the earliest
+    /// delivery time, if that time is not later than the specified 'now',
+    /// remove it from the link, and load its delivery time into the
+    /// specified 'deliveryTime'. Return true if such a packet is found,
+    /// otherwise return false.
+    bool deliver(bsl::shared_ptr<ntcd::Packet>* result,
+                 bsls::TimeInterval*            deliveryTime,
+                 const bsls::TimeInterval&      now);
+
+    /// Return the specified 'packet' previously delivered at the specified
+    /// 'deliveryTime' to the front of the packets in flight.
+    void retry(const bsl::shared_ptr<ntcd::Packet>& packet,
+               const bsls::TimeInterval&            deliveryTime);
+
+    /// Discard all packets in flight and reset the link to its state upon
+    /// construction.
+    void reset();
+
+    /// Return true if the link has finished serializing each packet
+    /// previously transmitted at the specified 'now', otherwise return
+    /// false.
+    bool isIdle(const bsls::TimeInterval& now) const;
+
+    /// Load into the specified 'result' the earliest time after the
+    /// specified 'now' at which a packet in flight is due to be delivered
+    /// or, if the specified 'pending' flag is true, the link becomes idle.
+    /// Return true if such a time exists, otherwise return false.
+    bool deadline(bsls::TimeInterval*       result,
+                  const bsls::TimeInterval& now,
+                  bool                      pending) const;
+
+    /// Return true if there are no packets in flight, otherwise return
+    /// false.
+    bool empty() const;
+
+    /// Return the number of packets in flight.
+    bsl::size_t size() const;
+
+    /// Return the number of packets lost by this link.
+    bsl::size_t numPacketsLost() const;
+};
+
 /// @internal @brief
 /// Provide a map of simulated ports in use on a simulated machine.
 ///
@@ -733,6 +989,7 @@ class Session : public ntsi::DatagramSocket,
     bsls::AtomicBool                            d_notificationsActive;
     bsl::size_t                                 d_backlog;
     bdlcc::SingleConsumerQueue<ntsa::Timestamp> d_feedbackQueue;
+    ntcd::Link                                  d_link;
     bslma::Allocator*                           d_allocator_p;
 
     static const bool        k_DEFAULT_REUSE_ADDRESS;
@@ -1217,6 +1474,9 @@ class Machine : public ntccfg::Shared<Machine>
     typedef bsl::map<ntcd::Binding, bsl::weak_ptr<ntcd::Session> >
         SessionByBindingMap;
 
+    /// Define a type alias for a map of impairments indexed by binding.
+    typedef bsl::map<ntcd::Binding, ntcd::Impairment> ImpairmentMap;
+
     mutable ntccfg::ConditionMutex d_mutex;
     mutable ntccfg::Condition      d_condition;
     bsl::string                    d_name;
@@ -1231,6 +1491,10 @@ class Machine : public ntccfg::Shared<Machine>
     SessionByBindingMap            d_sessionByTcpBindingMap;
     SessionByBindingMap            d_sessionByUdpBindingMap;
     SessionByBindingMap            d_sessionByLocalBindingMap;
+    ImpairmentMap                  d_impairmentMap;
+    ntcd::Impairment               d_impairment;
+    bsls::AtomicBool               d_impaired;
+    bsls::TimeInterval             d_deadline;
     bslmt::ThreadGroup             d_threadGroup;
     bsls::AtomicBool               d_stop;
     bsls::AtomicBool               d_update;
@@ -1336,6 +1600,39 @@ class Machine : public ntccfg::Shared<Machine>
     /// not acquire a lock on the internal mutex.
     void updateNoLock(const bsl::shared_ptr<ntcd::Session>& session);
 
+    /// Require an update to the simulation no later than the specified
+    /// 'deadline', in terms of the monotonic clock, i.e. unblock the next
+    /// call to step the simulation once the 'deadline' elapses.
+    void schedule(const bsls::TimeInterval& deadline);
+
+    /// Impair each link on this machine not otherwise impaired by the
+    /// specified 'impairment'.
+    void setImpairment(const ntcd::Impairment& impairment);
+
+    /// Impair the link described by the specified 'binding' by the specified
+    /// 'impairment'. The impairment applies to packets sent from the source
+    /// endpoint of the 'binding' to its remote endpoint; leave either
+    /// endpoint undefined to match any endpoint. The impairment of the most
+    /// specific binding matching a packet takes precedence.
+    void setImpairment(const ntcd::Binding&    binding,
+                       const ntcd::Impairment& impairment);
+
+    /// Remove all impairments from the links on this machine. Note that
+    /// packets already in flight are still delivered at their scheduled
+    /// time.
+    void resetImpairment();
+
+    /// Load into the specified 'result' the impairment of packets sent from
+    /// the specified 'sourceEndpoint' to the specified 'remoteEndpoint'.
+    /// Return true if such packets are impaired, otherwise return false.
+    bool lookupImpairment(ntcd::Impairment*     result,
+                          const ntsa::Endpoint& sourceEndpoint,
+                          const ntsa::Endpoint& remoteEndpoint) const;
+
+    /// Return true if any link on this machine is impaired, otherwise return
+    /// false.
+    bool isImpaired() const;
+
     /// Start a background thread and continuously step the simulation
     /// of each session on this machine, as necessary, until the machine
     /// is stopped.
@@ -22,6 +22,10 @@ BSLS_IDENT_RCSID(ntcd_machine_t_cpp, "$Id$ $CSID$")
 
 #include <ntcd_datautil.h>
 #include <ntci_log.h>
+#include <ntcq_send.h>
+#include <ntcs_flowcontrolcontext.h>
+#include <ntcs_flowcontrolstate.h>
+#include <bsls_systemtime.h>
 
 using namespace BloombergLP;
 
@@ -31,6 +35,20 @@ namespace ntcd {
 // Provide tests for 'ntcd::Machine'.
 class MachineTest
 {
+    // Copy as much of the specified 'writeQueue' as possible to the send
+    // buffer of the specified 'session'. Apply flow control in the send
+    // direction in the specified 'flowControlState', and lose interest in
+    // the writability of the 'session' in the specified 'monitor', if the
+    // 'writeQueue' becomes empty. Increment the specified
+    // 'numLowWatermarkEvents' if the 'writeQueue' is drained down to its
+    // low watermark after breaching its high watermark.
+    static void flushWriteQueue(
+        ntcq::SendQueue*                      writeQueue,
+        ntcs::FlowControlState*               flowControlState,
+        bsl::size_t*                          numLowWatermarkEvents,
+        const bsl::shared_ptr<ntcd::Monitor>& monitor,
+        const bsl::shared_ptr<ntcd::Session>& session);
+
   public:
     // Concern: Opening and closing handles.
     static void verifyOpen();
@@ -92,8 +110,81 @@ class MachineTest
 
     // Concern: Sending and receiving data larger than socket buffer sizes.
     static void verifySendBufferOverflow();
+
+    // Concern: Impairments are resolved by the most specific binding.
+    static void verifyImpairmentLookup();
+
+    // Concern: Packets over an impaired link are delayed by its latency.
+    static void verifyImpairmentLatency();
+
+    // Concern: Datagrams over a lossy link are dropped.
+    static void verifyImpairmentLoss();
+
+    // Concern: Packets over an impaired link are paced to its bandwidth.
+    static void verifyImpairmentBandwidth();
+
+    // Concern: A stream writing faster than the bandwidth of an impaired
+    // link backs up into its write queue, breaching the high watermark of
+    // the write queue, then drains down to its low watermark as the link
+    // carries the data.
+    static void verifyImpairmentBandwidthWatermark();
 };
 
+void MachineTest::flushWriteQueue(
+    ntcq::SendQueue*                      writeQueue,
+    ntcs::FlowControlState*               flowControlState,
+    bsl::size_t*                          numLowWatermarkEvents,
+    const bsl::shared_ptr<ntcd::Monitor>& monitor,
+    const bsl::shared_ptr<ntcd::Session>& session)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    while (writeQueue->hasEntry()) {
+        ntcq::SendQueueEntry& entry = writeQueue->frontEntry();
+
+        ntsa::SendContext context;
+        ntsa::SendOptions options;
+
+        error = session->send(&context, *entry.data(), options);
+        if (error) {
+            NTSCFG_TEST_EQ(error, ntsa::Error(ntsa::Error::e_WOULD_BLOCK));
+            break;
+        }
+
+        NTSCFG_TEST_GT(context.bytesSent(), 0);
+
+        if (context.bytesSent() == entry.length()) {
+            writeQueue->popEntry();
+        }
+        else {
+            writeQueue->popSize(context.bytesSent());
+        }
+    }
+
+    if (writeQueue->authorizeLowWatermarkEvent()) {
+        NTCI_LOG_STREAM_DEBUG << "Write queue low watermark: size = "
+                              << writeQueue->size() << NTCI_LOG_STREAM_END;
+
+        ++(*numLowWatermarkEvents);
+    }
+
+    if (!writeQueue->hasEntry()) {
+        ntcs::FlowControlContext context;
+        if (flowControlState->apply(&context,
+                                    ntca::FlowControlType::e_SEND,
+                                    false))
+        {
+            if (!context.enableSend()) {
+                error =
+                    monitor->hide(session, ntca::ReactorEventType::e_WRITABLE);
+                NTSCFG_TEST_OK(error);
+            }
+        }
+    }
+}
+
 NTSCFG_TEST_FUNCTION(ntcd::MachineTest::verifyOpen)
 {
 #if NTC_BUILD_FROM_CONTINUOUS_INTEGRATION == 0
@@ -4319,5 +4410,723 @@ NTSCFG_TEST_FUNCTION(ntcd::MachineTest::verifySendBufferOverflow)
 #endif
 }
 
+NTSCFG_TEST_FUNCTION(ntcd::MachineTest::verifyImpairmentLookup)
+{
+    bsl::shared_ptr<ntcd::Machine> machine;
+    machine.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    const ntsa::Endpoint source("127.0.0.1:1000");
+    const ntsa::Endpoint remote("127.0.0.1:2000");
+    const ntsa::Endpoint other("127.0.0.1:3000");
+
+    ntcd::Impairment impairment;
+    NTSCFG_TEST_TRUE(impairment.isNone());
+
+    NTSCFG_TEST_FALSE(machine->isImpaired());
+    NTSCFG_TEST_FALSE(machine->lookupImpairment(&impairment, source, remote));
+
+    ntcd::Impairment machineImpairment;
+    machineImpairment.setLatency(bsls::TimeInterval(0, 1000000));
+
+    ntcd::Impairment sourceImpairment;
+    sourceImpairment.setBandwidth(1000);
+
+    ntcd::Impairment linkImpairment;
+    linkImpairment.setLossProbability(0.5);
+    linkImpairment.setSeed(7);
+
+    NTSCFG_TEST_FALSE(machineImpairment.isNone());
+    NTSCFG_TEST_NE(machineImpairment, sourceImpairment);
+
+    machine->setImpairment(machineImpairment);
+    machine->setImpairment(ntcd::Binding(source, ntsa::Endpoint()),
+                           sourceImpairment);
+    machine->setImpairment(ntcd::Binding(source, remote), linkImpairment);
+
+    NTSCFG_TEST_TRUE(machine->isImpaired());
+
+    NTSCFG_TEST_TRUE(machine->lookupImpairment(&impairment, source, remote));
+    NTSCFG_TEST_EQ(impairment, linkImpairment);
+
+    NTSCFG_TEST_TRUE(machine->lookupImpairment(&impairment, source, other));
+    NTSCFG_TEST_EQ(impairment, sourceImpairment);
+
+    NTSCFG_TEST_TRUE(machine->lookupImpairment(&impairment, remote, source));
+    NTSCFG_TEST_EQ(impairment, machineImpairment);
+
+    machine->resetImpairment();
+
+    NTSCFG_TEST_FALSE(machine->isImpaired());
+    NTSCFG_TEST_FALSE(machine->lookupImpairment(&impairment, source, remote));
+    NTSCFG_TEST_TRUE(impairment.isNone());
+}
+
+NTSCFG_TEST_FUNCTION(ntcd::MachineTest::verifyImpairmentLatency)
+{
+#if NTC_BUILD_FROM_CONTINUOUS_INTEGRATION == 0
+
+    NTCI_LOG_CONTEXT();
+    NTCI_LOG_CONTEXT_GUARD_OWNER("main");
+
+    const bsls::TimeInterval LATENCY(0, 50000000);
+
+    ntsa::Error error;
+
+    // Create a machine whose links are delayed by the latency.
+
+    bsl::shared_ptr<ntcd::Machine> machine;
+    machine.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    ntcd::Impairment impairment;
+    impairment.setLatency(LATENCY);
+
+    machine->setImpairment(impairment);
+
+    error = machine->run();
+    NTSCFG_TEST_OK(error);
+
+    // Create a client and a server.
+
+    bsl::shared_ptr<ntcd::Session> client =
+        machine->createSession(NTSCFG_TEST_ALLOCATOR);
+
+    error = client->open(ntsa::Transport::e_UDP_IPV4_DATAGRAM);
+    NTSCFG_TEST_OK(error);
+
+    error = client->bind(
+        ntsa::Endpoint(ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)),
+        false);
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcd::Session> server =
+        machine->createSession(NTSCFG_TEST_ALLOCATOR);
+
+    error = server->open(ntsa::Transport::e_UDP_IPV4_DATAGRAM);
+    NTSCFG_TEST_OK(error);
+
+    error = server->bind(
+        ntsa::Endpoint(ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)),
+        false);
+    NTSCFG_TEST_OK(error);
+
+    ntsa::Endpoint serverSourceEndpoint;
+    error = server->sourceEndpoint(&serverSourceEndpoint);
+    NTSCFG_TEST_OK(error);
+
+    // Send data from the client to the server.
+
+    const char CLIENT_DATA = 'C';
+
+    const bsls::TimeInterval startTime =
+        bsls::SystemTime::nowMonotonicClock();
+
+    {
+        ntsa::Data data(ntsa::ConstBuffer(&CLIENT_DATA, 1));
+
+        ntsa::SendContext context;
+        ntsa::SendOptions options;
+
+        options.setEndpoint(serverSourceEndpoint);
+
+        error = client->send(&context, data, options);
+        NTSCFG_TEST_OK(error);
+    }
+
+    // Receive data at the server, blocking until it is delivered, and
+    // ensure it is not delivered before the latency elapses.
+
+    {
+        char remoteData = 0;
+
+        ntsa::Data data(ntsa::MutableBuffer(&remoteData, 1));
+
+        ntsa::ReceiveContext context;
+        ntsa::ReceiveOptions options;
+
+        error = server->receive(&context, &data, options);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(context.bytesReceived(), 1);
+        NTSCFG_TEST_EQ(remoteData, CLIENT_DATA);
+    }
+
+    const bsls::TimeInterval elapsed =
+        bsls::SystemTime::nowMonotonicClock() - startTime;
+
+    NTCI_LOG_STREAM_DEBUG << "Datagram delivered after "
+                          << elapsed.totalMilliseconds() << " ms"
+                          << NTCI_LOG_STREAM_END;
+
+    NTSCFG_TEST_GE(elapsed, LATENCY);
+
+    error = client->close();
+    NTSCFG_TEST_OK(error);
+
+    error = server->close();
+    NTSCFG_TEST_OK(error);
+
+    machine->stop();
+
+#endif
+}
+
+NTSCFG_TEST_FUNCTION(ntcd::MachineTest::verifyImpairmentLoss)
+{
+#if NTC_BUILD_FROM_CONTINUOUS_INTEGRATION == 0
+
+    NTCI_LOG_CONTEXT();
+    NTCI_LOG_CONTEXT_GUARD_OWNER("main");
+
+    ntsa::Error error;
+
+    // Create a machine.
+
+    bsl::shared_ptr<ntcd::Machine> machine;
+    machine.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    // Create a client and a non-blocking server.
+
+    bsl::shared_ptr<ntcd::Session> client =
+        machine->createSession(NTSCFG_TEST_ALLOCATOR);
+
+    error = client->open(ntsa::Transport::e_UDP_IPV4_DATAGRAM);
+    NTSCFG_TEST_OK(error);
+
+    error = client->bind(
+        ntsa::Endpoint(ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)),
+        false);
+    NTSCFG_TEST_OK(error);
+
+    ntsa::Endpoint clientSourceEndpoint;
+    error = client->sourceEndpoint(&clientSourceEndpoint);
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcd::Session> server =
+        machine->createSession(NTSCFG_TEST_ALLOCATOR);
+
+    error = server->open(ntsa::Transport::e_UDP_IPV4_DATAGRAM);
+    NTSCFG_TEST_OK(error);
+
+    error = server->bind(
+        ntsa::Endpoint(ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)),
+        false);
+    NTSCFG_TEST_OK(error);
+
+    error = server->setBlocking(false);
+    NTSCFG_TEST_OK(error);
+
+    ntsa::Endpoint serverSourceEndpoint;
+    error = server->sourceEndpoint(&serverSourceEndpoint);
+    NTSCFG_TEST_OK(error);
+
+    // Lose every datagram sent from the client to the server.
+
+    ntcd::Impairment impairment;
+    impairment.setLossProbability(1.0);
+
+    machine->setImpairment(
+        ntcd::Binding(clientSourceEndpoint, serverSourceEndpoint),
+        impairment);
+
+    for (bsl::size_t iteration = 0; iteration < 2; ++iteration) {
+        const char CLIENT_DATA = 'C';
+
+        {
+            ntsa::Data data(ntsa::ConstBuffer(&CLIENT_DATA, 1));
+
+            ntsa::SendContext context;
+            ntsa::SendOptions options;
+
+            options.setEndpoint(serverSourceEndpoint);
+
+            error = client->send(&context, data, options);
+            NTSCFG_TEST_OK(error);
+        }
+
+        error = machine->step(false);
+        NTSCFG_TEST_OK(error);
+
+        char remoteData = 0;
+
+        ntsa::Data data(ntsa::MutableBuffer(&remoteData, 1));
+
+        ntsa::ReceiveContext context;
+        ntsa::ReceiveOptions options;
+
+        error = server->receive(&context, &data, options);
+
+        if (iteration == 0) {
+            // The datagram is lost.
+
+            NTSCFG_TEST_ERROR(error, ntsa::Error::e_WOULD_BLOCK);
+
+            machine->resetImpairment();
+        }
+        else {
+            // The datagram is delivered once the impairment is removed.
+
+            NTSCFG_TEST_OK(error);
+            NTSCFG_TEST_EQ(remoteData, CLIENT_DATA);
+        }
+    }
+
+    error = client->close();
+    NTSCFG_TEST_OK(error);
+
+    error = server->close();
+    NTSCFG_TEST_OK(error);
+
+#endif
+}
+
+NTSCFG_TEST_FUNCTION(ntcd::MachineTest::verifyImpairmentBandwidth)
+{
+#if NTC_BUILD_FROM_CONTINUOUS_INTEGRATION == 0
+
+    NTCI_LOG_CONTEXT();
+    NTCI_LOG_CONTEXT_GUARD_OWNER("main");
+
+    const bsl::size_t BANDWIDTH      = 100000;
+    const bsl::size_t DATAGRAM_SIZE  = 1000;
+    const bsl::size_t DATAGRAM_COUNT = 10;
+
+    const bsls::TimeInterval DURATION(0, 100000000);
+
+    ntsa::Error error;
+
+    // Create a machine whose links are limited to the bandwidth.
+
+    bsl::shared_ptr<ntcd::Machine> machine;
+    machine.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    ntcd::Impairment impairment;
+    impairment.setBandwidth(BANDWIDTH);
+
+    machine->setImpairment(impairment);
+
+    error = machine->run();
+    NTSCFG_TEST_OK(error);
+
+    // Create a client and a server.
+
+    bsl::shared_ptr<ntcd::Session> client =
+        machine->createSession(NTSCFG_TEST_ALLOCATOR);
+
+    error = client->open(ntsa::Transport::e_UDP_IPV4_DATAGRAM);
+    NTSCFG_TEST_OK(error);
+
+    error = client->bind(
+        ntsa::Endpoint(ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)),
+        false);
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcd::Session> server =
+        machine->createSession(NTSCFG_TEST_ALLOCATOR);
+
+    error = server->open(ntsa::Transport::e_UDP_IPV4_DATAGRAM);
+    NTSCFG_TEST_OK(error);
+
+    error = server->bind(
+        ntsa::Endpoint(ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)),
+        false);
+    NTSCFG_TEST_OK(error);
+
+    ntsa::Endpoint serverSourceEndpoint;
+    error = server->sourceEndpoint(&serverSourceEndpoint);
+    NTSCFG_TEST_OK(error);
+
+    // Send a burst of datagrams from the client to the server, then
+    // receive each one at the server and ensure the burst takes at least
+    // as long as the link needs to serialize it.
+
+    bsl::vector<char> clientData(DATAGRAM_SIZE, 'C', NTSCFG_TEST_ALLOCATOR);
+    bsl::vector<char> serverData(DATAGRAM_SIZE, 0, NTSCFG_TEST_ALLOCATOR);
+
+    const bsls::TimeInterval startTime =
+        bsls::SystemTime::nowMonotonicClock();
+
+    for (bsl::size_t i = 0; i < DATAGRAM_COUNT; ++i) {
+        ntsa::Data data(
+            ntsa::ConstBuffer(&clientData.front(), clientData.size()));
+
+        ntsa::SendContext context;
+        ntsa::SendOptions options;
+
+        options.setEndpoint(serverSourceEndpoint);
+
+        error = client->send(&context, data, options);
+        NTSCFG_TEST_OK(error);
+    }
+
+    for (bsl::size_t i = 0; i < DATAGRAM_COUNT; ++i) {
+        ntsa::Data data(
+            ntsa::MutableBuffer(&serverData.front(), serverData.size()));
+
+        ntsa::ReceiveContext context;
+        ntsa::ReceiveOptions options;
+
+        error = server->receive(&context, &data, options);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(context.bytesReceived(), DATAGRAM_SIZE);
+    }
+
+    const bsls::TimeInterval elapsed =
+        bsls::SystemTime::nowMonotonicClock() - startTime;
+
+    NTCI_LOG_STREAM_DEBUG << "Burst delivered after "
+                          << elapsed.totalMilliseconds() << " ms"
+                          << NTCI_LOG_STREAM_END;
+
+    NTSCFG_TEST_GE(elapsed, DURATION);
+
+    error = client->close();
+    NTSCFG_TEST_OK(error);
+
+    error = server->close();
+    NTSCFG_TEST_OK(error);
+
+    machine->stop();
+
+#endif
+}
+
+NTSCFG_TEST_FUNCTION(ntcd::MachineTest::verifyImpairmentBandwidthWatermark)
+{
+#if NTC_BUILD_FROM_CONTINUOUS_INTEGRATION == 0
+
+    NTCI_LOG_CONTEXT();
+    NTCI_LOG_CONTEXT_GUARD_OWNER("main");
+
+    const bsl::size_t BANDWIDTH           = 256 * 1024;
+    const bsl::size_t MESSAGE_SIZE        = 4 * 1024;
+    const bsl::size_t MESSAGE_COUNT       = 32;
+    const bsl::size_t DATA_SIZE           = MESSAGE_SIZE * MESSAGE_COUNT;
+    const bsl::size_t SEND_BUFFER_SIZE    = 16 * 1024;
+    const bsl::size_t RECEIVE_BUFFER_SIZE = DATA_SIZE;
+    const bsl::size_t LOW_WATERMARK       = 8 * 1024;
+    const bsl::size_t HIGH_WATERMARK      = 32 * 1024;
+
+    ntsa::Error error;
+
+    // Create a blob buffer factory.
+
+    bdlbb::PooledBlobBufferFactory blobBufferFactory(1024,
+                                                     NTSCFG_TEST_ALLOCATOR);
+
+    // Create a machine whose links are limited to the bandwidth.
+
+    bsl::shared_ptr<ntcd::Machine> machine;
+    machine.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    ntcd::Impairment impairment;
+    impairment.setBandwidth(BANDWIDTH);
+
+    machine->setImpairment(impairment);
+
+    // Run the machine.
+
+    error = machine->run();
+    NTSCFG_TEST_OK(error);
+
+    // Create a monitor.
+
+    bsl::shared_ptr<ntcd::Monitor> monitor =
+        machine->createMonitor(NTSCFG_TEST_ALLOCATOR);
+
+    // Create a listener bound to any port on the IPv4 loopback address and
+    // begin listening for connections.
+
+    bsl::shared_ptr<ntcd::Session> listener =
+        machine->createSession(NTSCFG_TEST_ALLOCATOR);
+
+    error = listener->open(ntsa::Transport::e_TCP_IPV4_STREAM);
+    NTSCFG_TEST_OK(error);
+
+    error = listener->setBlocking(false);
+    NTSCFG_TEST_OK(error);
+
+    error = listener->bind(
+        ntsa::Endpoint(ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)),
+        false);
+    NTSCFG_TEST_OK(error);
+
+    ntsa::Endpoint listenerSourceEndpoint;
+    error = listener->sourceEndpoint(&listenerSourceEndpoint);
+    NTSCFG_TEST_OK(error);
+
+    error = listener->listen(0);
+    NTSCFG_TEST_OK(error);
+
+    error = monitor->add(listener);
+    NTSCFG_TEST_OK(error);
+
+    // Create a client and connect it to the listener.
+
+    bsl::shared_ptr<ntcd::Session> client =
+        machine->createSession(NTSCFG_TEST_ALLOCATOR);
+
+    error = client->open(ntsa::Transport::e_TCP_IPV4_STREAM);
+    NTSCFG_TEST_OK(error);
+
+    error = client->setBlocking(false);
+    NTSCFG_TEST_OK(error);
+
+    error = client->connect(listenerSourceEndpoint);
+    NTSCFG_TEST_OK(error);
+
+    error = monitor->add(client);
+    NTSCFG_TEST_OK(error);
+
+    // Block until the client is writable, once it is connected.
+
+    error = monitor->show(client, ntca::ReactorEventType::e_WRITABLE);
+    NTSCFG_TEST_OK(error);
+
+    while (true) {
+        bsl::vector<ntca::ReactorEvent> events;
+        error = monitor->dequeue(&events);
+        NTSCFG_TEST_OK(error);
+
+        bool satisfied = false;
+        for (bsl::size_t i = 0; i < events.size(); ++i) {
+            const ntca::ReactorEvent& event = events[i];
+
+            if (event.handle() == client->handle() && event.isWritable()) {
+                satisfied = true;
+                break;
+            }
+        }
+
+        if (satisfied) {
+            break;
+        }
+    }
+
+    error = monitor->hide(client, ntca::ReactorEventType::e_WRITABLE);
+    NTSCFG_TEST_OK(error);
+
+    // Block until the listener is readable, then accept a server from the
+    // listener.
+
+    error = monitor->show(listener, ntca::ReactorEventType::e_READABLE);
+    NTSCFG_TEST_OK(error);
+
+    while (true) {
+        bsl::vector<ntca::ReactorEvent> events;
+        error = monitor->dequeue(&events);
+        NTSCFG_TEST_OK(error);
+
+        bool satisfied = false;
+        for (bsl::size_t i = 0; i < events.size(); ++i) {
+            const ntca::ReactorEvent& event = events[i];
+
+            if (event.handle() == listener->handle() && event.isReadable()) {
+                satisfied = true;
+                break;
+            }
+        }
+
+        if (satisfied) {
+            break;
+        }
+    }
+
+    error = monitor->hide(listener, ntca::ReactorEventType::e_READABLE);
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcd::Session> server;
+    error = listener->accept(&server);
+    NTSCFG_TEST_OK(error);
+
+    error = server->setBlocking(false);
+    NTSCFG_TEST_OK(error);
+
+    error = monitor->add(server);
+    NTSCFG_TEST_OK(error);
+
+    // Set the send buffer size for the client and the receive buffer size
+    // for the server, so that only the link limits the rate at which the
+    // data leaves the client.
+
+    {
+        ntsa::SocketOption option;
+        option.makeSendBufferSize(SEND_BUFFER_SIZE);
+
+        error = client->setOption(option);
+        NTSCFG_TEST_OK(error);
+    }
+
+    {
+        ntsa::SocketOption option;
+        option.makeReceiveBufferSize(RECEIVE_BUFFER_SIZE);
+
+        error = server->setOption(option);
+        NTSCFG_TEST_OK(error);
+    }
+
+    // Model the write queue of a stream socket: each message is copied to
+    // the send buffer of the client as far as possible, the remainder is
+    // queued, and interest in writability is gained while the queue is
+    // non-empty.
+
+    ntcq::SendQueue        writeQueue(NTSCFG_TEST_ALLOCATOR);
+    ntcs::FlowControlState flowControlState;
+
+    writeQueue.setLowWatermark(LOW_WATERMARK);
+    writeQueue.setHighWatermark(HIGH_WATERMARK);
+
+    bsl::size_t numHighWatermarkEvents = 0;
+    bsl::size_t numLowWatermarkEvents  = 0;
+
+    // Write a burst of messages faster than the link can carry them.
+
+    for (bsl::size_t i = 0; i < MESSAGE_COUNT; ++i) {
+        bdlbb::Blob message(&blobBufferFactory);
+        ntcd::DataUtil::generateData(&message, MESSAGE_SIZE, i * MESSAGE_SIZE);
+
+        bsl::shared_ptr<ntsa::Data> data;
+        data.createInplace(NTSCFG_TEST_ALLOCATOR,
+                           message,
+                           NTSCFG_TEST_ALLOCATOR);
+
+        ntcq::SendQueueEntry entry(NTSCFG_TEST_ALLOCATOR);
+        entry.setId(writeQueue.generateEntryId());
+        entry.setData(data);
+        entry.setLength(MESSAGE_SIZE);
+
+        if (writeQueue.pushEntry(entry)) {
+            ntcs::FlowControlContext context;
+            if (flowControlState.relax(&context,
+                                       ntca::FlowControlType::e_SEND,
+                                       false))
+            {
+                if (context.enableSend()) {
+                    error = monitor->show(client,
+                                          ntca::ReactorEventType::e_WRITABLE);
+                    NTSCFG_TEST_OK(error);
+                }
+            }
+        }
+
+        MachineTest::flushWriteQueue(&writeQueue,
+                                     &flowControlState,
+                                     &numLowWatermarkEvents,
+                                     monitor,
+                                     client);
+
+        if (writeQueue.authorizeHighWatermarkEvent()) {
+            NTCI_LOG_STREAM_DEBUG << "Write queue high watermark: size = "
+                                  << writeQueue.size() << NTCI_LOG_STREAM_END;
+
+            ++numHighWatermarkEvents;
+        }
+    }
+
+    // Ensure the burst backed up behind the link into the write queue,
+    // breaching its high watermark exactly once.
+
+    NTSCFG_TEST_EQ(numHighWatermarkEvents, 1);
+    NTSCFG_TEST_EQ(numLowWatermarkEvents, 0);
+    NTSCFG_TEST_TRUE(writeQueue.isHighWatermarkViolated());
+
+    // Flush the write queue when the client is writable and receive data at
+    // the server when the server is readable, until the write queue is
+    // empty and the server has received all data.
+
+    error = monitor->show(server, ntca::ReactorEventType::e_READABLE);
+    NTSCFG_TEST_OK(error);
+
+    bdlbb::Blob serverData(&blobBufferFactory);
+
+    bool serverDone = false;
+
+    while (writeQueue.hasEntry() || !serverDone) {
+        bsl::vector<ntca::ReactorEvent> events;
+        error = monitor->dequeue(&events);
+        NTSCFG_TEST_OK(error);
+
+        for (bsl::size_t i = 0; i < events.size(); ++i) {
+            const ntca::ReactorEvent& event = events[i];
+
+            if (event.handle() == client->handle()) {
+                NTSCFG_TEST_TRUE(event.isWritable());
+
+                MachineTest::flushWriteQueue(&writeQueue,
+                                             &flowControlState,
+                                             &numLowWatermarkEvents,
+                                             monitor,
+                                             client);
+            }
+            else if (event.handle() == server->handle()) {
+                NTSCFG_TEST_TRUE(event.isReadable());
+                NTSCFG_TEST_FALSE(serverDone);
+
+                const int size = serverData.length();
+
+                if (serverData.totalSize() == size) {
+                    serverData.setLength(
+                        size + NTCCFG_WARNING_NARROW(int, MESSAGE_SIZE));
+                    serverData.setLength(size);
+                }
+
+                ntsa::ReceiveContext context;
+                ntsa::ReceiveOptions options;
+
+                error = server->receive(&context, &serverData, options);
+                if (error) {
+                    NTSCFG_TEST_EQ(error,
+                                   ntsa::Error(ntsa::Error::e_WOULD_BLOCK));
+                }
+                else if (serverData.length() == DATA_SIZE) {
+                    error =
+                        monitor->hide(server,
+                                      ntca::ReactorEventType::e_READABLE);
+                    NTSCFG_TEST_OK(error);
+
+                    serverDone = true;
+                }
+            }
+        }
+    }
+
+    // Ensure the write queue drained down to its low watermark exactly
+    // once, and all data arrived in order.
+
+    NTSCFG_TEST_EQ(numHighWatermarkEvents, 1);
+    NTSCFG_TEST_EQ(numLowWatermarkEvents, 1);
+    NTSCFG_TEST_EQ(writeQueue.size(), 0);
+
+    bdlbb::Blob clientData(&blobBufferFactory);
+    ntcd::DataUtil::generateData(&clientData, DATA_SIZE);
+
+    NTSCFG_TEST_EQ(serverData.length(), DATA_SIZE);
+    NTSCFG_TEST_EQ(bdlbb::BlobUtil::compare(clientData, serverData), 0);
+
+    // Close the sockets and stop the machine.
+
+    error = monitor->remove(client);
+    NTSCFG_TEST_OK(error);
+
+    error = monitor->remove(server);
+    NTSCFG_TEST_OK(error);
+
+    error = monitor->remove(listener);
+    NTSCFG_TEST_OK(error);
+
+    error = client->close();
+    NTSCFG_TEST_OK(error);
+
+    error = server->close();
+    NTSCFG_TEST_OK(error);
+
+    error = listener->close();
+    NTSCFG_TEST_OK(error);
+
+    machine->stop();
+
+#endif
+}
+
 }  // close namespace ntcd
 }  // close namespace BloombergLP
@@ -16,16 +16,22 @@
 #include <ntcdns_cache.h>
 
 #include <ntcdns_compat.h>
+#include <ntcdns_protocol.h>
 #include <ntci_log.h>
 #include <ntsa_host.h>
 #include <ntsu_resolverutil.h>
 
+#include <bdls_filesystemutil.h>
 #include <bslim_printer.h>
 #include <bslma_allocator.h>
 #include <bslma_default.h>
 #include <bslmt_lockguard.h>
 #include <bsls_assert.h>
 
+#include <bsl_cerrno.h>
+#include <bsl_cstring.h>
+#include <bsl_limits.h>
+
 namespace BloombergLP {
 namespace ntcdns {
 
@@ -38,6 +44,9 @@ CacheHostEntry::CacheHostEntry(bslma::Allocator* basicAllocator)
 , d_expiration()
 , d_iteratorByDomainName()
 , d_iteratorByIpAddress()
+, d_iteratorByRecency()
+, d_numHits(0)
+, d_refreshPending(false)
 {
 }
 
@@ -87,6 +96,22 @@ void CacheHostEntry::setIteratorByIpAddress(
     d_iteratorByIpAddress = value;
 }
 
+void CacheHostEntry::setIteratorByRecency(
+    ntcdns::CacheHostEntryListIterator value)
+{
+    d_iteratorByRecency = value;
+}
+
+void CacheHostEntry::setNumHits(bsl::size_t value)
+{
+    d_numHits = value;
+}
+
+void CacheHostEntry::setRefreshPending(bool value)
+{
+    d_refreshPending = value;
+}
+
 const bsl::string& CacheHostEntry::domainName() const
 {
     return d_domainName;
@@ -129,6 +154,21 @@ ntcdns::CacheHostEntryByIpAddressIterator CacheHostEntry::iteratorByIpAddress()
     return d_iteratorByIpAddress;
 }
 
+ntcdns::CacheHostEntryListIterator CacheHostEntry::iteratorByRecency() const
+{
+    return d_iteratorByRecency;
+}
+
+bsl::size_t CacheHostEntry::numHits() const
+{
+    return d_numHits;
+}
+
+bool CacheHostEntry::refreshPending() const
+{
+    return d_refreshPending;
+}
+
 bsl::ostream& CacheHostEntry::print(bsl::ostream& stream,
                                     int           level,
                                     int           spacesPerLevel) const
@@ -141,6 +181,8 @@ bsl::ostream& CacheHostEntry::print(bsl::ostream& stream,
     printer.printAttribute("timeToLive", d_timeToLive);
     printer.printAttribute("lastUpdate", d_lastUpdate);
     printer.printAttribute("expiration", d_expiration);
+    printer.printAttribute("numHits", d_numHits);
+    printer.printAttribute("refreshPending", d_refreshPending);
     printer.end();
     return stream;
 }
@@ -150,6 +192,41 @@ bsl::ostream& operator<<(bsl::ostream& stream, const CacheHostEntry& object)
     return object.print(stream, 0, -1);
 }
 
+/// Describe a partition of the host entries in a cache.
+class Cache::Shard
+{
+    Shard(const Shard&) BSLS_KEYWORD_DELETED;
+    Shard& operator=(const Shard&) BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Create a new shard. Optionally specify a 'basicAllocator' used to
+    /// supply memory. If 'basicAllocator' is 0, the currently installed
+    /// default allocator is used.
+    explicit Shard(bslma::Allocator* basicAllocator = 0);
+
+    /// Destroy this object.
+    ~Shard();
+
+    Mutex                              d_mutex;
+    ntcdns::CacheHostEntryByDomainName d_cacheEntryByDomainName;
+    ntcdns::CacheHostEntryByIpAddress  d_cacheEntryByIpAddress;
+    ntcdns::CacheHostEntryList         d_cacheEntryList;
+    bsl::size_t                        d_cacheEntryCount;
+};
+
+Cache::Shard::Shard(bslma::Allocator* basicAllocator)
+: d_mutex()
+, d_cacheEntryByDomainName(basicAllocator)
+, d_cacheEntryByIpAddress(basicAllocator)
+, d_cacheEntryList(basicAllocator)
+, d_cacheEntryCount(0)
+{
+}
+
+Cache::Shard::~Shard()
+{
+}
+
 const bool        Cache::k_DEFAULT_POSITIVE_CACHE_ENABLED          = true;
 const bsl::size_t Cache::k_DEFAULT_POSITIVE_CACHE_MIN_TIME_TO_LIVE = 0;
 const bsl::size_t Cache::k_DEFAULT_POSITIVE_CACHE_MAX_TIME_TO_LIVE =
@@ -158,36 +235,199 @@ const bool        Cache::k_DEFAULT_NEGATIVE_CACHE_ENABLED          = true;
 const bsl::size_t Cache::k_DEFAULT_NEGATIVE_CACHE_MIN_TIME_TO_LIVE = 0;
 const bsl::size_t Cache::k_DEFAULT_NEGATIVE_CACHE_MAX_TIME_TO_LIVE =
     (bsl::size_t)(-1);
+const bsl::size_t Cache::k_DEFAULT_NUM_SHARDS        = 16;
+const bsl::size_t Cache::k_DEFAULT_MAX_ENTRIES       = 65536;
+const double      Cache::k_DEFAULT_REFRESH_THRESHOLD = 0.1;
+const bsl::size_t Cache::k_DEFAULT_REFRESH_MIN_HITS  = 2;
+
+// The snapshot begins with a header containing the magic number, the
+// version, the number of entries, and the time the snapshot was saved, in
+// seconds since the Unix epoch. Each entry follows as its absolute
+// expiration, in seconds since the Unix epoch, the address family (4 or 6)
+// and bytes of its IP address, the address family (0, 4, or 6), bytes, and
+// port of its name server, and the length and characters of its domain name.
+// All integers are stored in network byte order.
+
+const bsl::uint32_t Cache::k_SNAPSHOT_MAGIC       = 0x4e544443;
+const bsl::uint32_t Cache::k_SNAPSHOT_VERSION     = 1;
+const bsl::size_t   Cache::k_SNAPSHOT_HEADER_SIZE = 20;
+
+const ntci::MetricMetadata Cache::STATISTICS[] = {
+#if NTCI_METRIC_PREFIX
+    NTCI_METRIC_METADATA_GAUGE(Entries),
+    NTCI_METRIC_METADATA_TOTAL(Hits),
+    NTCI_METRIC_METADATA_TOTAL(Misses),
+    NTCI_METRIC_METADATA_TOTAL(Evictions),
+    NTCI_METRIC_METADATA_TOTAL(Expirations),
+    NTCI_METRIC_METADATA_TOTAL(Refreshes),
+#else
+    NTCI_METRIC_METADATA_GAUGE(entries),
+    NTCI_METRIC_METADATA_TOTAL(hits),
+    NTCI_METRIC_METADATA_TOTAL(misses),
+    NTCI_METRIC_METADATA_TOTAL(evictions),
+    NTCI_METRIC_METADATA_TOTAL(expirations),
+    NTCI_METRIC_METADATA_TOTAL(refreshes),
+#endif
+};
+
+Cache::Shard* Cache::lookupShard(const bsl::string& domainName) const
+{
+    if (d_shardVector.size() == 1) {
+        return d_shardVector.front().get();
+    }
+
+    const bsl::size_t hash = bsl::hash<bsl::string>()(domainName);
+    return d_shardVector[hash % d_shardVector.size()].get();
+}
 
 void Cache::privateRemove(
+    Shard*                                         shard,
     const bsl::shared_ptr<ntcdns::CacheHostEntry>& cacheEntry)
 {
     BSLS_ASSERT_OPT(cacheEntry->iteratorByDomainName() !=
-                    d_cacheEntryByDomainName.end());
+                    shard->d_cacheEntryByDomainName.end());
+
+    shard->d_cacheEntryByDomainName.erase(cacheEntry->iteratorByDomainName());
+    cacheEntry->setIteratorByDomainName(shard->d_cacheEntryByDomainName.end());
 
-    BSLS_ASSERT_OPT(cacheEntry->iteratorByIpAddress() !=
-                    d_cacheEntryByIpAddress.end());
+    // An entry whose IP address was already indexed by the entry for a
+    // different domain name when it was inserted is not itself indexed by
+    // its IP address.
+
+    if (cacheEntry->iteratorByIpAddress() !=
+        shard->d_cacheEntryByIpAddress.end())
+    {
+        shard->d_cacheEntryByIpAddress.erase(
+            cacheEntry->iteratorByIpAddress());
+        cacheEntry->setIteratorByIpAddress(
+            shard->d_cacheEntryByIpAddress.end());
+    }
 
-    d_cacheEntryByDomainName.erase(cacheEntry->iteratorByDomainName());
+    shard->d_cacheEntryList.erase(cacheEntry->iteratorByRecency());
 
-    d_cacheEntryByIpAddress.erase(cacheEntry->iteratorByIpAddress());
+    --shard->d_cacheEntryCount;
+}
 
-    --d_cacheEntryCount;
+void Cache::privateTouch(
+    Shard*                                         shard,
+    const bsl::shared_ptr<ntcdns::CacheHostEntry>& cacheEntry)
+{
+    shard->d_cacheEntryList.splice(shard->d_cacheEntryList.begin(),
+                                   shard->d_cacheEntryList,
+                                   cacheEntry->iteratorByRecency());
+}
+
+void Cache::privateEvict(Shard* shard, const bsls::TimeInterval& now)
+{
+    NTCI_LOG_CONTEXT();
+
+    if (d_maxEntriesPerShard == 0) {
+        return;
+    }
+
+    while (shard->d_cacheEntryCount > d_maxEntriesPerShard) {
+        BSLS_ASSERT_OPT(!shard->d_cacheEntryList.empty());
+
+        bsl::shared_ptr<ntcdns::CacheHostEntry> cacheEntry =
+            shard->d_cacheEntryList.back();
+
+        Cache::privateRemove(shard, cacheEntry);
+
+        if (now >= cacheEntry->expiration()) {
+            ++d_numExpirations;
+        }
+        else {
+            ++d_numEvictions;
+        }
+
+        NTCI_LOG_STREAM_TRACE << "DNS cache evicted host entry "
+                              << *cacheEntry << ": the limit of "
+                              << d_maxEntriesPerShard
+                              << " entries per shard has been reached"
+                              << NTCI_LOG_STREAM_END;
+    }
 }
 
 Cache::Cache(bslma::Allocator* basicAllocator)
-: d_mutex()
-, d_cacheEntryByDomainName(basicAllocator)
-, d_cacheEntryByIpAddress(basicAllocator)
-, d_cacheEntryCount(0)
+: d_shardVector(basicAllocator)
+, d_maxEntries(k_DEFAULT_MAX_ENTRIES)
+, d_maxEntriesPerShard(0)
+, d_refreshThreshold(k_DEFAULT_REFRESH_THRESHOLD)
+, d_refreshMinHits(k_DEFAULT_REFRESH_MIN_HITS)
+, d_refreshCallback(bsl::allocator_arg, basicAllocator)
 , d_positiveCacheEnabled(k_DEFAULT_POSITIVE_CACHE_ENABLED)
 , d_positiveCacheMinTimeToLive(k_DEFAULT_POSITIVE_CACHE_MIN_TIME_TO_LIVE)
 , d_positiveCacheMaxTimeToLive(k_DEFAULT_POSITIVE_CACHE_MAX_TIME_TO_LIVE)
 , d_negativeCacheEnabled(k_DEFAULT_NEGATIVE_CACHE_ENABLED)
 , d_negativeCacheMinTimeToLive(k_DEFAULT_NEGATIVE_CACHE_MIN_TIME_TO_LIVE)
 , d_negativeCacheMaxTimeToLive(k_DEFAULT_NEGATIVE_CACHE_MAX_TIME_TO_LIVE)
+, d_numHits(0)
+, d_numMisses(0)
+, d_numEvictions(0)
+, d_numExpirations(0)
+, d_numRefreshes(0)
+, d_hits()
+, d_misses()
+, d_evictions()
+, d_expirations()
+, d_refreshes()
+, d_prefix("cache", basicAllocator)
+, d_objectName("dns", basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
+    d_shardVector.reserve(k_DEFAULT_NUM_SHARDS);
+
+    for (bsl::size_t i = 0; i < k_DEFAULT_NUM_SHARDS; ++i) {
+        bsl::shared_ptr<Shard> shard;
+        shard.createInplace(d_allocator_p, d_allocator_p);
+
+        d_shardVector.push_back(shard);
+    }
+
+    this->setMaxEntries(d_maxEntries);
+}
+
+Cache::Cache(bsl::size_t numShards, bslma::Allocator* basicAllocator)
+: d_shardVector(basicAllocator)
+, d_maxEntries(k_DEFAULT_MAX_ENTRIES)
+, d_maxEntriesPerShard(0)
+, d_refreshThreshold(k_DEFAULT_REFRESH_THRESHOLD)
+, d_refreshMinHits(k_DEFAULT_REFRESH_MIN_HITS)
+, d_refreshCallback(bsl::allocator_arg, basicAllocator)
+, d_positiveCacheEnabled(k_DEFAULT_POSITIVE_CACHE_ENABLED)
+, d_positiveCacheMinTimeToLive(k_DEFAULT_POSITIVE_CACHE_MIN_TIME_TO_LIVE)
+, d_positiveCacheMaxTimeToLive(k_DEFAULT_POSITIVE_CACHE_MAX_TIME_TO_LIVE)
+, d_negativeCacheEnabled(k_DEFAULT_NEGATIVE_CACHE_ENABLED)
+, d_negativeCacheMinTimeToLive(k_DEFAULT_NEGATIVE_CACHE_MIN_TIME_TO_LIVE)
+, d_negativeCacheMaxTimeToLive(k_DEFAULT_NEGATIVE_CACHE_MAX_TIME_TO_LIVE)
+, d_numHits(0)
+, d_numMisses(0)
+, d_numEvictions(0)
+, d_numExpirations(0)
+, d_numRefreshes(0)
+, d_hits()
+, d_misses()
+, d_evictions()
+, d_expirations()
+, d_refreshes()
+, d_prefix("cache", basicAllocator)
+, d_objectName("dns", basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    if (numShards == 0) {
+        numShards = 1;
+    }
+
+    d_shardVector.reserve(numShards);
+
+    for (bsl::size_t i = 0; i < numShards; ++i) {
+        bsl::shared_ptr<Shard> shard;
+        shard.createInplace(d_allocator_p, d_allocator_p);
+
+        d_shardVector.push_back(shard);
+    }
+
+    this->setMaxEntries(d_maxEntries);
 }
 
 Cache::~Cache()
@@ -224,13 +464,46 @@ void Cache::setNegativeCacheMaxTimeToLive(bsl::size_t value)
     d_negativeCacheMaxTimeToLive = value;
 }
 
+void Cache::setMaxEntries(bsl::size_t value)
+{
+    d_maxEntries = value;
+
+    if (value == 0) {
+        d_maxEntriesPerShard = 0;
+    }
+    else {
+        const bsl::size_t numShards = d_shardVector.size();
+        d_maxEntriesPerShard        = (value + numShards - 1) / numShards;
+    }
+}
+
+void Cache::setRefreshThreshold(double value)
+{
+    d_refreshThreshold = value;
+}
+
+void Cache::setRefreshMinHits(bsl::size_t value)
+{
+    d_refreshMinHits = value;
+}
+
+void Cache::setRefreshCallback(const RefreshCallback& callback)
+{
+    d_refreshCallback = callback;
+}
+
 void Cache::clear()
 {
-    LockGuard lock(&d_mutex);
+    for (bsl::size_t i = 0; i < d_shardVector.size(); ++i) {
+        Shard* shard = d_shardVector[i].get();
+
+        LockGuard lock(&shard->d_mutex);
 
-    d_cacheEntryByDomainName.clear();
-    d_cacheEntryByIpAddress.clear();
-    d_cacheEntryCount = 0;
+        shard->d_cacheEntryByDomainName.clear();
+        shard->d_cacheEntryByIpAddress.clear();
+        shard->d_cacheEntryList.clear();
+        shard->d_cacheEntryCount = 0;
+    }
 }
 
 void Cache::updateHost(const bsl::string&        domainName,
@@ -244,15 +517,17 @@ void Cache::updateHost(const bsl::string&        domainName,
     bsl::shared_ptr<ntcdns::CacheHostEntry> newCacheEntry;
     bool                                    oldCacheEntryUpdated = false;
 
-    LockGuard lock(&d_mutex);
+    Shard* shard = this->lookupShard(domainName);
+
+    LockGuard lock(&shard->d_mutex);
 
     {
         bool mustInsert = true;
 
         ntcdns::CacheHostEntryByDomainNameIteratorPair range =
-            d_cacheEntryByDomainName.equal_range(domainName);
+            shard->d_cacheEntryByDomainName.equal_range(domainName);
 
-        if (range.first != d_cacheEntryByDomainName.end()) {
+        if (range.first != shard->d_cacheEntryByDomainName.end()) {
             ntcdns::CacheHostEntryByDomainNameIterator it = range.first;
             ntcdns::CacheHostEntryByDomainNameIterator et = range.second;
 
@@ -271,6 +546,10 @@ void Cache::updateHost(const bsl::string&        domainName,
                         cacheEntry->setLastUpdate(now);
                         cacheEntry->setExpiration(
                             now + bsls::TimeInterval(timeToLive, 0));
+                        cacheEntry->setNumHits(0);
+                        cacheEntry->setRefreshPending(false);
+
+                        Cache::privateTouch(shard, cacheEntry);
 
                         NTCI_LOG_STREAM_TRACE
                             << "DNS cache updated host entry " << *cacheEntry
@@ -292,7 +571,8 @@ void Cache::updateHost(const bsl::string&        domainName,
 
                     BSLS_ASSERT_OPT(jt == cacheEntry->iteratorByDomainName());
 
-                    this->privateRemove(cacheEntry);
+                    Cache::privateRemove(shard, cacheEntry);
+                    ++d_numExpirations;
 
                     NTCI_LOG_STREAM_TRACE
                         << "DNS cache removed host entry " << *cacheEntry
@@ -319,17 +599,22 @@ void Cache::updateHost(const bsl::string&        domainName,
                     now + bsls::TimeInterval(timeToLive, 0));
 
                 newCacheEntry->setIteratorByDomainName(
-                    d_cacheEntryByDomainName.end());
+                    shard->d_cacheEntryByDomainName.end());
 
                 newCacheEntry->setIteratorByIpAddress(
-                    d_cacheEntryByIpAddress.end());
+                    shard->d_cacheEntryByIpAddress.end());
 
-                ++d_cacheEntryCount;
+                newCacheEntry->setIteratorByRecency(
+                    shard->d_cacheEntryList.insert(
+                        shard->d_cacheEntryList.begin(),
+                        newCacheEntry));
+
+                ++shard->d_cacheEntryCount;
             }
 
             ntcdns::CacheHostEntryByDomainNameIterator
                 newCacheEntryIteratorByDomainName =
-                    d_cacheEntryByDomainName.insert(
+                    shard->d_cacheEntryByDomainName.insert(
                         ntcdns::CacheHostEntryByDomainName::value_type(
                             domainName,
                             newCacheEntry));
@@ -346,9 +631,9 @@ void Cache::updateHost(const bsl::string&        domainName,
         bool mustInsert = true;
 
         ntcdns::CacheHostEntryByIpAddressIterator it =
-            d_cacheEntryByIpAddress.find(ipAddress);
+            shard->d_cacheEntryByIpAddress.find(ipAddress);
 
-        if (it != d_cacheEntryByIpAddress.end()) {
+        if (it != shard->d_cacheEntryByIpAddress.end()) {
             const bsl::shared_ptr<ntcdns::CacheHostEntry>& cacheEntry =
                 it->second;
 
@@ -359,6 +644,10 @@ void Cache::updateHost(const bsl::string&        domainName,
                     cacheEntry->setLastUpdate(now);
                     cacheEntry->setExpiration(
                         now + bsls::TimeInterval(timeToLive, 0));
+                    cacheEntry->setNumHits(0);
+                    cacheEntry->setRefreshPending(false);
+
+                    Cache::privateTouch(shard, cacheEntry);
 
                     NTCI_LOG_STREAM_TRACE << "DNS cache updated host entry "
                                           << *cacheEntry
@@ -375,7 +664,8 @@ void Cache::updateHost(const bsl::string&        domainName,
 
                 BSLS_ASSERT_OPT(it == cacheEntry->iteratorByIpAddress());
 
-                this->privateRemove(cacheEntry);
+                Cache::privateRemove(shard, cacheEntry);
+                ++d_numExpirations;
 
                 NTCI_LOG_STREAM_TRACE
                     << "DNS cache removed host entry " << *cacheEntry
@@ -401,16 +691,21 @@ void Cache::updateHost(const bsl::string&        domainName,
                     now + bsls::TimeInterval(timeToLive, 0));
 
                 newCacheEntry->setIteratorByDomainName(
-                    d_cacheEntryByDomainName.end());
+                    shard->d_cacheEntryByDomainName.end());
 
                 newCacheEntry->setIteratorByIpAddress(
-                    d_cacheEntryByIpAddress.end());
+                    shard->d_cacheEntryByIpAddress.end());
+
+                newCacheEntry->setIteratorByRecency(
+                    shard->d_cacheEntryList.insert(
+                        shard->d_cacheEntryList.begin(),
+                        newCacheEntry));
 
-                ++d_cacheEntryCount;
+                ++shard->d_cacheEntryCount;
             }
 
             bsl::pair<ntcdns::CacheHostEntryByIpAddressIterator, bool>
-                insertResult = d_cacheEntryByIpAddress.insert(
+                insertResult = shard->d_cacheEntryByIpAddress.insert(
                     ntcdns::CacheHostEntryByIpAddress::value_type(
                         ipAddress,
                         newCacheEntry));
@@ -427,6 +722,10 @@ void Cache::updateHost(const bsl::string&        domainName,
                                   << *newCacheEntry << NTCI_LOG_STREAM_END;
         }
     }
+
+    if (newCacheEntry) {
+        this->privateEvict(shard, now);
+    }
 }
 
 ntsa::Error Cache::getIpAddress(ntca::GetIpAddressContext*       context,
@@ -453,6 +752,7 @@ ntsa::Error Cache::getIpAddress(ntca::GetIpAddressContext*       context,
     bsl::vector<ntsa::IpAddress>            ipAddressList;
     bdlb::NullableValue<ntsa::Endpoint>     nameServer;
     bdlb::NullableValue<bsls::TimeInterval> timeToLive;
+    bool                                    refresh = false;
 
     bdlb::NullableValue<ntsa::IpAddressType::Value> ipAddressType;
     error = ntcdns::Compat::convert(&ipAddressType, options);
@@ -460,92 +760,139 @@ ntsa::Error Cache::getIpAddress(ntca::GetIpAddressContext*       context,
         return error;
     }
 
-    LockGuard lock(&d_mutex);
-
     bsl::string key = domainName;
 
-    ntcdns::CacheHostEntryByDomainNameIteratorPair range =
-        d_cacheEntryByDomainName.equal_range(key);
+    Shard* shard = this->lookupShard(key);
 
-    if (range.first == d_cacheEntryByDomainName.end()) {
-        NTCI_LOG_STREAM_TRACE
-            << "DNS cache found no host entry for domain name '" << domainName
-            << "'" << NTCI_LOG_STREAM_END;
-        return ntsa::Error(ntsa::Error::e_EOF);
-    }
-
-    ntcdns::CacheHostEntryByDomainNameIterator it = range.first;
-    ntcdns::CacheHostEntryByDomainNameIterator et = range.second;
+    {
+        LockGuard lock(&shard->d_mutex);
 
-    while (true) {
-        if (it == et) {
-            break;
+        ntcdns::CacheHostEntryByDomainNameIteratorPair range =
+            shard->d_cacheEntryByDomainName.equal_range(key);
+
+        if (range.first == shard->d_cacheEntryByDomainName.end()) {
+            NTCI_LOG_STREAM_TRACE << "DNS cache found no host entry for "
+                                  << "domain name '" << domainName << "'"
+                                  << NTCI_LOG_STREAM_END;
+            ++d_numMisses;
+            return ntsa::Error(ntsa::Error::e_EOF);
         }
 
-        const bsl::shared_ptr<ntcdns::CacheHostEntry>& cacheEntry = it->second;
-
-        if (now >= cacheEntry->expiration()) {
-            ntcdns::CacheHostEntryByDomainNameIterator jt = it;
+        ntcdns::CacheHostEntryByDomainNameIterator it = range.first;
+        ntcdns::CacheHostEntryByDomainNameIterator et = range.second;
 
-            bsl::shared_ptr<ntcdns::CacheHostEntry> cacheEntry = jt->second;
+        while (true) {
+            if (it == et) {
+                break;
+            }
 
-            ++it;
+            const bsl::shared_ptr<ntcdns::CacheHostEntry>& cacheEntry =
+                it->second;
 
-            BSLS_ASSERT_OPT(jt == cacheEntry->iteratorByDomainName());
+            if (now >= cacheEntry->expiration()) {
+                ntcdns::CacheHostEntryByDomainNameIterator jt = it;
 
-            const_cast<Cache*>(this)->privateRemove(cacheEntry);
+                bsl::shared_ptr<ntcdns::CacheHostEntry> cacheEntry =
+                    jt->second;
 
-            NTCI_LOG_STREAM_TRACE
-                << "DNS cache removed host entry " << *cacheEntry
-                << ": expiration at " << cacheEntry->expiration()
-                << " is greater than or equal to now at " << now
-                << NTCI_LOG_STREAM_END;
-        }
-        else {
-            if (ipAddressType.isNull() ||
-                cacheEntry->ipAddress().type() == ipAddressType.value())
-            {
-                if (bsl::find(ipAddressList.begin(),
-                              ipAddressList.end(),
-                              cacheEntry->ipAddress()) == ipAddressList.end())
-                {
-                    NTCI_LOG_STREAM_TRACE
-                        << "DNS cache found host entry " << *cacheEntry
-                        << " for domain name '" << domainName << "'"
-                        << NTCI_LOG_STREAM_END;
-                    ipAddressList.push_back(cacheEntry->ipAddress());
+                ++it;
 
-                    if (nameServer.isNull()) {
-                        nameServer.makeValue(cacheEntry->nameServer());
-                    }
-                    else if (nameServer.value() != cacheEntry->nameServer()) {
-                        // MRM: Warn
-                    }
+                BSLS_ASSERT_OPT(jt == cacheEntry->iteratorByDomainName());
 
-                    bsls::TimeInterval newTimeToLive =
-                        cacheEntry->expiration() - now;
+                Cache::privateRemove(shard, cacheEntry);
+                ++d_numExpirations;
 
-                    if (timeToLive.isNull()) {
-                        timeToLive.makeValue(newTimeToLive);
-                    }
-                    else if (timeToLive.value() > newTimeToLive) {
-                        // MRM: Warn
-                        timeToLive.makeValue(newTimeToLive);
+                NTCI_LOG_STREAM_TRACE
+                    << "DNS cache removed host entry " << *cacheEntry
+                    << ": expiration at " << cacheEntry->expiration()
+                    << " is greater than or equal to now at " << now
+                    << NTCI_LOG_STREAM_END;
+            }
+            else {
+                if (ipAddressType.isNull() ||
+                    cacheEntry->ipAddress().type() == ipAddressType.value())
+                {
+                    if (bsl::find(ipAddressList.begin(),
+                                  ipAddressList.end(),
+                                  cacheEntry->ipAddress()) ==
+                        ipAddressList.end())
+                    {
+                        NTCI_LOG_STREAM_TRACE
+                            << "DNS cache found host entry " << *cacheEntry
+                            << " for domain name '" << domainName << "'"
+                            << NTCI_LOG_STREAM_END;
+                        ipAddressList.push_back(cacheEntry->ipAddress());
+
+                        if (nameServer.isNull()) {
+                            nameServer.makeValue(cacheEntry->nameServer());
+                        }
+                        else if (nameServer.value() !=
+                                 cacheEntry->nameServer())
+                        {
+                            // MRM: Warn
+                        }
+
+                        bsls::TimeInterval newTimeToLive =
+                            cacheEntry->expiration() - now;
+
+                        if (timeToLive.isNull()) {
+                            timeToLive.makeValue(newTimeToLive);
+                        }
+                        else if (timeToLive.value() > newTimeToLive) {
+                            // MRM: Warn
+                            timeToLive.makeValue(newTimeToLive);
+                        }
+
+                        Cache::privateTouch(shard, cacheEntry);
+
+                        cacheEntry->setNumHits(cacheEntry->numHits() + 1);
+
+                        // Refresh a hot entry that is about to expire, at
+                        // most once per update, so that lookups continue
+                        // to be satisfied from the cache.
+
+                        if (d_refreshCallback && d_refreshThreshold > 0 &&
+                            !cacheEntry->refreshPending() &&
+                            cacheEntry->numHits() >= d_refreshMinHits)
+                        {
+                            const bsls::TimeInterval refreshWindow(
+                                d_refreshThreshold *
+                                static_cast<double>(
+                                    cacheEntry->timeToLive()));
+
+                            if (newTimeToLive <= refreshWindow) {
+                                cacheEntry->setRefreshPending(true);
+                                refresh = true;
+                            }
+                        }
                     }
                 }
+                ++it;
             }
-            ++it;
         }
     }
 
-    if (ipAddressType.isNull()) {
-        ntsu::ResolverUtil::sortIpAddressList(&ipAddressList);
-    }
-
     if (ipAddressList.empty()) {
+        ++d_numMisses;
         return ntsa::Error(ntsa::Error::e_EOF);
     }
 
+    ++d_numHits;
+
+    if (refresh) {
+        NTCI_LOG_STREAM_TRACE << "DNS cache refreshing host entries for "
+                              << "domain name '" << domainName
+                              << "' ahead of their expiration"
+                              << NTCI_LOG_STREAM_END;
+
+        ++d_numRefreshes;
+        d_refreshCallback(key, options);
+    }
+
+    if (ipAddressType.isNull()) {
+        ntsu::ResolverUtil::sortIpAddressList(&ipAddressList);
+    }
+
     if (options.ipAddressFilter().has_value()) {
         if (options.ipAddressFilter().value()) {
             options.ipAddressFilter().value()(&ipAddressList);
@@ -611,56 +958,71 @@ ntsa::Error Cache::getDomainName(ntca::GetDomainNameContext*       context,
     bdlb::NullableValue<ntsa::Endpoint>     nameServer;
     bdlb::NullableValue<bsls::TimeInterval> timeToLive;
 
-    LockGuard lock(&d_mutex);
+    // Host entries are partitioned by domain name, so an IP address may be
+    // indexed by any shard.
 
-    ntcdns::CacheHostEntryByIpAddressIterator it =
-        d_cacheEntryByIpAddress.find(ipAddress);
+    for (bsl::size_t i = 0; i < d_shardVector.size(); ++i) {
+        Shard* shard = d_shardVector[i].get();
 
-    if (it == d_cacheEntryByIpAddress.end()) {
-        return ntsa::Error(ntsa::Error::e_EOF);
-    }
+        LockGuard lock(&shard->d_mutex);
 
-    bsl::shared_ptr<ntcdns::CacheHostEntry> cacheEntry = it->second;
+        ntcdns::CacheHostEntryByIpAddressIterator it =
+            shard->d_cacheEntryByIpAddress.find(ipAddress);
 
-    if (now >= cacheEntry->expiration()) {
-        BSLS_ASSERT_OPT(it == cacheEntry->iteratorByIpAddress());
+        if (it == shard->d_cacheEntryByIpAddress.end()) {
+            continue;
+        }
 
-        const_cast<Cache*>(this)->privateRemove(cacheEntry);
+        bsl::shared_ptr<ntcdns::CacheHostEntry> cacheEntry = it->second;
 
-        NTCI_LOG_STREAM_TRACE << "DNS cache removed host entry " << *cacheEntry
-                              << ": expiration at " << cacheEntry->expiration()
-                              << " is greater than or equal to now at " << now
-                              << NTCI_LOG_STREAM_END;
-    }
-    else {
-        NTCI_LOG_STREAM_TRACE << "DNS cache found host entry " << *cacheEntry
-                              << " for IP address " << ipAddress
-                              << NTCI_LOG_STREAM_END;
+        if (now >= cacheEntry->expiration()) {
+            BSLS_ASSERT_OPT(it == cacheEntry->iteratorByIpAddress());
 
-        domainName = cacheEntry->domainName();
+            Cache::privateRemove(shard, cacheEntry);
+            ++d_numExpirations;
 
-        if (nameServer.isNull()) {
-            nameServer.makeValue(cacheEntry->nameServer());
-        }
-        else if (nameServer.value() != cacheEntry->nameServer()) {
-            // MRM: Warn
+            NTCI_LOG_STREAM_TRACE
+                << "DNS cache removed host entry " << *cacheEntry
+                << ": expiration at " << cacheEntry->expiration()
+                << " is greater than or equal to now at " << now
+                << NTCI_LOG_STREAM_END;
         }
+        else {
+            NTCI_LOG_STREAM_TRACE << "DNS cache found host entry "
+                                  << *cacheEntry << " for IP address "
+                                  << ipAddress << NTCI_LOG_STREAM_END;
 
-        bsls::TimeInterval newTimeToLive = cacheEntry->expiration() - now;
+            domainName = cacheEntry->domainName();
 
-        if (timeToLive.isNull()) {
-            timeToLive.makeValue(newTimeToLive);
-        }
-        else if (timeToLive.value() > newTimeToLive) {
-            // MRM: Warn
-            timeToLive.makeValue(newTimeToLive);
+            if (nameServer.isNull()) {
+                nameServer.makeValue(cacheEntry->nameServer());
+            }
+            else if (nameServer.value() != cacheEntry->nameServer()) {
+                // MRM: Warn
+            }
+
+            bsls::TimeInterval newTimeToLive = cacheEntry->expiration() - now;
+
+            if (timeToLive.isNull()) {
+                timeToLive.makeValue(newTimeToLive);
+            }
+            else if (timeToLive.value() > newTimeToLive) {
+                // MRM: Warn
+                timeToLive.makeValue(newTimeToLive);
+            }
+
+            Cache::privateTouch(shard, cacheEntry);
+            break;
         }
     }
 
     if (domainName.empty()) {
+        ++d_numMisses;
         return ntsa::Error(ntsa::Error::e_EOF);
     }
 
+    ++d_numHits;
+
     context->setIpAddress(ipAddress);
     context->setSource(ntca::ResolverSource::e_CACHE);
 
@@ -713,9 +1075,534 @@ ntsa::Error Cache::getServiceName(ntca::GetServiceNameContext*       context,
     return ntsa::Error(ntsa::Error::e_EOF);
 }
 
+ntsa::Error Cache::encodeSnapshot(bsl::vector<bsl::uint8_t>* result,
+                                  const bsls::TimeInterval&  now) const
+{
+    ntsa::Error error;
+
+    result->clear();
+    result->resize(k_SNAPSHOT_HEADER_SIZE);
+
+    bsl::uint32_t numEntries = 0;
+
+    for (bsl::size_t i = 0; i < d_shardVector.size(); ++i) {
+        Shard* shard = d_shardVector[i].get();
+
+        LockGuard lock(&shard->d_mutex);
+
+        // Compute the size of the unexpired entries in this shard so that
+        // they may be encoded without growing the result more than once.
+
+        bsl::size_t shardSize = 0;
+
+        for (ntcdns::CacheHostEntryList::const_iterator it =
+                 shard->d_cacheEntryList.begin();
+             it != shard->d_cacheEntryList.end();
+             ++it)
+        {
+            const ntcdns::CacheHostEntry& cacheEntry = **it;
+
+            if (now >= cacheEntry.expiration()) {
+                continue;
+            }
+
+            if (cacheEntry.domainName().size() > 0xFFFF) {
+                continue;
+            }
+
+            shardSize += 8 + 1 + 1 + 2 + cacheEntry.domainName().size();
+            shardSize += cacheEntry.ipAddress().isV4() ? 4 : 16;
+
+            if (cacheEntry.nameServer().isIp()) {
+                shardSize +=
+                    cacheEntry.nameServer().ip().host().isV4() ? 6 : 18;
+            }
+        }
+
+        if (shardSize == 0) {
+            continue;
+        }
+
+        const bsl::size_t offset = result->size();
+        result->resize(offset + shardSize);
+
+        ntcdns::MemoryEncoder encoder(result->data() + offset, shardSize);
+
+        // Encode the entries from the least recently used to the most
+        // recently used, so that inserting them in order when the snapshot
+        // is decoded restores their recency.
+
+        for (ntcdns::CacheHostEntryList::const_reverse_iterator it =
+                 shard->d_cacheEntryList.rbegin();
+             it != shard->d_cacheEntryList.rend();
+             ++it)
+        {
+            const ntcdns::CacheHostEntry& cacheEntry = **it;
+
+            if (now >= cacheEntry.expiration()) {
+                continue;
+            }
+
+            if (cacheEntry.domainName().size() > 0xFFFF) {
+                continue;
+            }
+
+            const bsl::uint64_t expiration =
+                static_cast<bsl::uint64_t>(cacheEntry.expiration().seconds());
+
+            error = encoder.encodeUint32(
+                static_cast<bsl::uint32_t>(expiration >> 32));
+            if (error) {
+                return error;
+            }
+
+            error = encoder.encodeUint32(
+                static_cast<bsl::uint32_t>(expiration & 0xFFFFFFFF));
+            if (error) {
+                return error;
+            }
+
+            bsl::uint8_t address[16];
+
+            const ntsa::IpAddress& ipAddress = cacheEntry.ipAddress();
+            if (ipAddress.isV4()) {
+                error = encoder.encodeUint8(4);
+                if (error) {
+                    return error;
+                }
+
+                error = encoder.encodeRaw(
+                    address,
+                    ipAddress.v4().copyTo(address, sizeof address));
+                if (error) {
+                    return error;
+                }
+            }
+            else {
+                error = encoder.encodeUint8(6);
+                if (error) {
+                    return error;
+                }
+
+                error = encoder.encodeRaw(
+                    address,
+                    ipAddress.v6().copyTo(address, sizeof address));
+                if (error) {
+                    return error;
+                }
+            }
+
+            const ntsa::Endpoint& nameServer = cacheEntry.nameServer();
+            if (nameServer.isIp()) {
+                const ntsa::IpAddress& host = nameServer.ip().host();
+                if (host.isV4()) {
+                    error = encoder.encodeUint8(4);
+                    if (error) {
+                        return error;
+                    }
+
+                    error = encoder.encodeRaw(
+                        address,
+                        host.v4().copyTo(address, sizeof address));
+                    if (error) {
+                        return error;
+                    }
+                }
+                else {
+                    error = encoder.encodeUint8(6);
+                    if (error) {
+                        return error;
+                    }
+
+                    error = encoder.encodeRaw(
+                        address,
+                        host.v6().copyTo(address, sizeof address));
+                    if (error) {
+                        return error;
+                    }
+                }
+
+                error = encoder.encodeUint16(nameServer.ip().port());
+                if (error) {
+                    return error;
+                }
+            }
+            else {
+                error = encoder.encodeUint8(0);
+                if (error) {
+                    return error;
+                }
+            }
+
+            const bsl::string& domainName = cacheEntry.domainName();
+
+            error = encoder.encodeUint16(
+                static_cast<bsl::uint16_t>(domainName.size()));
+            if (error) {
+                return error;
+            }
+
+            error = encoder.encodeRaw(domainName.data(), domainName.size());
+            if (error) {
+                return error;
+            }
+
+            ++numEntries;
+        }
+
+        BSLS_ASSERT(encoder.position() == shardSize);
+    }
+
+    const bsl::uint64_t saveTime = static_cast<bsl::uint64_t>(now.seconds());
+
+    ntcdns::MemoryEncoder encoder(result->data(), k_SNAPSHOT_HEADER_SIZE);
+
+    error = encoder.encodeUint32(k_SNAPSHOT_MAGIC);
+    if (error) {
+        return error;
+    }
+
+    error = encoder.encodeUint32(k_SNAPSHOT_VERSION);
+    if (error) {
+        return error;
+    }
+
+    error = encoder.encodeUint32(numEntries);
+    if (error) {
+        return error;
+    }
+
+    error = encoder.encodeUint32(static_cast<bsl::uint32_t>(saveTime >> 32));
+    if (error) {
+        return error;
+    }
+
+    error = encoder.encodeUint32(
+        static_cast<bsl::uint32_t>(saveTime & 0xFFFFFFFF));
+    if (error) {
+        return error;
+    }
+
+    return ntsa::Error();
+}
+
+ntsa::Error Cache::decodeSnapshot(bsl::size_t*              numEntries,
+                                  const void*               data,
+                                  bsl::size_t               size,
+                                  const bsls::TimeInterval& now)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    *numEntries = 0;
+
+    ntcdns::MemoryDecoder decoder(static_cast<const bsl::uint8_t*>(data),
+                                  size);
+
+    bsl::uint32_t magic = 0;
+    error               = decoder.decodeUint32(&magic);
+    if (error) {
+        return error;
+    }
+
+    bsl::uint32_t version = 0;
+    error                 = decoder.decodeUint32(&version);
+    if (error) {
+        return error;
+    }
+
+    if (magic != k_SNAPSHOT_MAGIC || version != k_SNAPSHOT_VERSION) {
+        NTCI_LOG_STREAM_WARN << "DNS cache snapshot has an unsupported format"
+                             << NTCI_LOG_STREAM_END;
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    bsl::uint32_t count = 0;
+    error               = decoder.decodeUint32(&count);
+    if (error) {
+        return error;
+    }
+
+    error = decoder.advance(8);
+    if (error) {
+        return error;
+    }
+
+    if (!d_positiveCacheEnabled) {
+        return ntsa::Error();
+    }
+
+    // Reuse the same domain name, IP address, and name server for every
+    // entry, so that decoding does not allocate memory per entry other than
+    // for the entry inserted into the cache itself.
+
+    bsl::string     domainName(d_allocator_p);
+    ntsa::IpAddress ipAddress;
+    ntsa::Endpoint  nameServer;
+
+    for (bsl::uint32_t i = 0; i < count; ++i) {
+        bsl::uint32_t expirationHigh = 0;
+        error                        = decoder.decodeUint32(&expirationHigh);
+        if (error) {
+            return error;
+        }
+
+        bsl::uint32_t expirationLow = 0;
+        error                       = decoder.decodeUint32(&expirationLow);
+        if (error) {
+            return error;
+        }
+
+        const bsls::Types::Int64 expiration = static_cast<bsls::Types::Int64>(
+            (static_cast<bsl::uint64_t>(expirationHigh) << 32) |
+            expirationLow);
+
+        bsl::uint8_t family = 0;
+        error               = decoder.decodeUint8(&family);
+        if (error) {
+            return error;
+        }
+
+        if (family == 4) {
+            if (decoder.end() - decoder.current() < 4) {
+                return ntsa::Error(ntsa::Error::e_EOF);
+            }
+
+            ipAddress.makeV4().copyFrom(decoder.current(), 4);
+
+            error = decoder.advance(4);
+            if (error) {
+                return error;
+            }
+        }
+        else if (family == 6) {
+            if (decoder.end() - decoder.current() < 16) {
+                return ntsa::Error(ntsa::Error::e_EOF);
+            }
+
+            ipAddress.makeV6().copyFrom(decoder.current(), 16);
+
+            error = decoder.advance(16);
+            if (error) {
+                return error;
+            }
+        }
+        else {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        bsl::uint8_t nameServerFamily = 0;
+        error = decoder.decodeUint8(&nameServerFamily);
+        if (error) {
+            return error;
+        }
+
+        if (nameServerFamily == 4 || nameServerFamily == 6) {
+            const bsl::size_t addressSize = nameServerFamily == 4 ? 4 : 16;
+
+            if (static_cast<bsl::size_t>(decoder.end() - decoder.current()) <
+                addressSize)
+            {
+                return ntsa::Error(ntsa::Error::e_EOF);
+            }
+
+            ntsa::IpAddress host;
+            if (nameServerFamily == 4) {
+                host.makeV4().copyFrom(decoder.current(), addressSize);
+            }
+            else {
+                host.makeV6().copyFrom(decoder.current(), addressSize);
+            }
+
+            error = decoder.advance(addressSize);
+            if (error) {
+                return error;
+            }
+
+            bsl::uint16_t port = 0;
+            error              = decoder.decodeUint16(&port);
+            if (error) {
+                return error;
+            }
+
+            nameServer = ntsa::Endpoint(ntsa::IpEndpoint(host, port));
+        }
+        else if (nameServerFamily == 0) {
+            nameServer.reset();
+        }
+        else {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        bsl::uint16_t domainNameSize = 0;
+        error = decoder.decodeUint16(&domainNameSize);
+        if (error) {
+            return error;
+        }
+
+        if (static_cast<bsl::size_t>(decoder.end() - decoder.current()) <
+            domainNameSize)
+        {
+            return ntsa::Error(ntsa::Error::e_EOF);
+        }
+
+        domainName.assign(reinterpret_cast<const char*>(decoder.current()),
+                          domainNameSize);
+
+        error = decoder.advance(domainNameSize);
+        if (error) {
+            return error;
+        }
+
+        if (expiration <= now.seconds()) {
+            continue;
+        }
+
+        const bsl::size_t timeToLive =
+            static_cast<bsl::size_t>(expiration - now.seconds());
+
+        this->updateHost(domainName, ipAddress, nameServer, timeToLive, now);
+
+        ++(*numEntries);
+    }
+
+    return ntsa::Error();
+}
+
+ntsa::Error Cache::saveSnapshot(const bsl::string&        path,
+                                const bsls::TimeInterval& now) const
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+    int         rc;
+
+    bsl::vector<bsl::uint8_t> data(d_allocator_p);
+    error = this->encodeSnapshot(&data, now);
+    if (error) {
+        return error;
+    }
+
+    if (data.size() > static_cast<bsl::size_t>(
+                          bsl::numeric_limits<int>::max()))
+    {
+        return ntsa::Error(ntsa::Error::e_LIMIT);
+    }
+
+    bsl::string temporaryPath(path, d_allocator_p);
+    temporaryPath.append(".tmp");
+
+    bdls::FilesystemUtil::FileDescriptor file =
+        bdls::FilesystemUtil::open(temporaryPath,
+                                   bdls::FilesystemUtil::e_OPEN_OR_CREATE,
+                                   bdls::FilesystemUtil::e_WRITE_ONLY,
+                                   bdls::FilesystemUtil::e_TRUNCATE);
+
+    if (file == bdls::FilesystemUtil::k_INVALID_FD) {
+        error = ntsa::Error::last();
+        NTCI_LOG_STREAM_ERROR << "Failed to open '" << temporaryPath
+                              << "': " << error << NTCI_LOG_STREAM_END;
+        return error;
+    }
+
+    const char* position     = reinterpret_cast<const char*>(data.data());
+    int         numBytesLeft = static_cast<int>(data.size());
+
+    while (numBytesLeft > 0) {
+        int numBytesWritten =
+            bdls::FilesystemUtil::write(file, position, numBytesLeft);
+        if (numBytesWritten < 0) {
+            error = ntsa::Error::last();
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+            if (error.number() == EINTR) {
+                continue;
+            }
+#endif
+
+            NTCI_LOG_STREAM_ERROR << "Failed to write '" << temporaryPath
+                                  << "': " << error << NTCI_LOG_STREAM_END;
+
+            bdls::FilesystemUtil::close(file);
+            bdls::FilesystemUtil::remove(temporaryPath);
+            return error;
+        }
+
+        numBytesLeft -= numBytesWritten;
+        position     += numBytesWritten;
+    }
+
+    rc = bdls::FilesystemUtil::close(file);
+    if (rc != 0) {
+        error = ntsa::Error::last();
+        NTCI_LOG_STREAM_ERROR << "Failed to close '" << temporaryPath
+                              << "': " << error << NTCI_LOG_STREAM_END;
+        bdls::FilesystemUtil::remove(temporaryPath);
+        return error;
+    }
+
+    rc = bdls::FilesystemUtil::move(temporaryPath, path);
+    if (rc != 0) {
+        error = ntsa::Error::last();
+        NTCI_LOG_STREAM_ERROR << "Failed to rename '" << temporaryPath
+                              << "' to '" << path << "': " << error
+                              << NTCI_LOG_STREAM_END;
+        bdls::FilesystemUtil::remove(temporaryPath);
+        return error;
+    }
+
+    NTCI_LOG_STREAM_DEBUG << "Saved DNS cache snapshot of " << data.size()
+                          << " bytes to '" << path << "'"
+                          << NTCI_LOG_STREAM_END;
+
+    return ntsa::Error();
+}
+
+ntsa::Error Cache::loadSnapshot(bsl::size_t*              numEntries,
+                                const bsl::string&        path,
+                                const bsls::TimeInterval& now)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    *numEntries = 0;
+
+    ntcdns::File file(d_allocator_p);
+    error = file.load(path);
+    if (error) {
+        return error;
+    }
+
+    error = this->decodeSnapshot(numEntries, file.data(), file.size(), now);
+    if (error) {
+        NTCI_LOG_STREAM_WARN << "Failed to decode DNS cache snapshot '"
+                             << path << "': " << error
+                             << NTCI_LOG_STREAM_END;
+        file.close();
+        return error;
+    }
+
+    NTCI_LOG_STREAM_DEBUG << "Loaded " << *numEntries
+                          << " entries from DNS cache snapshot '" << path
+                          << "'" << NTCI_LOG_STREAM_END;
+
+    return file.close();
+}
+
 bsl::size_t Cache::numHostEntries() const
 {
-    return d_cacheEntryCount;
+    bsl::size_t result = 0;
+
+    for (bsl::size_t i = 0; i < d_shardVector.size(); ++i) {
+        Shard* shard = d_shardVector[i].get();
+
+        LockGuard lock(&shard->d_mutex);
+        result += shard->d_cacheEntryCount;
+    }
+
+    return result;
 }
 
 bsl::size_t Cache::numPortEntries() const
@@ -723,5 +1610,133 @@ bsl::size_t Cache::numPortEntries() const
     return 0;
 }
 
+bsl::size_t Cache::numShards() const
+{
+    return d_shardVector.size();
+}
+
+bsl::size_t Cache::maxEntries() const
+{
+    return d_maxEntries;
+}
+
+bsl::uint64_t Cache::numHits() const
+{
+    return d_numHits.load();
+}
+
+bsl::uint64_t Cache::numMisses() const
+{
+    return d_numMisses.load();
+}
+
+bsl::uint64_t Cache::numEvictions() const
+{
+    return d_numEvictions.load();
+}
+
+bsl::uint64_t Cache::numExpirations() const
+{
+    return d_numExpirations.load();
+}
+
+bsl::uint64_t Cache::numRefreshes() const
+{
+    return d_numRefreshes.load();
+}
+
+void Cache::getStats(bdld::ManagedDatum* result)
+{
+    d_hits.update(static_cast<double>(d_numHits.load()));
+    d_misses.update(static_cast<double>(d_numMisses.load()));
+    d_evictions.update(static_cast<double>(d_numEvictions.load()));
+    d_expirations.update(static_cast<double>(d_numExpirations.load()));
+    d_refreshes.update(static_cast<double>(d_numRefreshes.load()));
+
+    bdld::DatumMutableArrayRef array;
+    bdld::Datum::createUninitializedArray(&array,
+                                          numOrdinals(),
+                                          result->allocator());
+
+    bsl::size_t index = 0;
+
+    array.data()[index++] = bdld::Datum::createDouble(
+        static_cast<double>(this->numHostEntries()));
+
+    d_hits.collectTotal(&array, &index);
+    d_misses.collectTotal(&array, &index);
+    d_evictions.collectTotal(&array, &index);
+    d_expirations.collectTotal(&array, &index);
+    d_refreshes.collectTotal(&array, &index);
+
+    *array.length() = numOrdinals();
+
+    result->adopt(bdld::Datum::adoptArray(array));
+}
+
+const char* Cache::getFieldPrefix(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return d_prefix.c_str();
+}
+
+const char* Cache::getFieldName(int ordinal) const
+{
+    if (ordinal < numOrdinals()) {
+        return Cache::STATISTICS[ordinal].d_name;
+    }
+    else {
+        return 0;
+    }
+}
+
+const char* Cache::getFieldDescription(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return "";
+}
+
+ntci::Monitorable::StatisticType Cache::getFieldType(int ordinal) const
+{
+    if (ordinal < numOrdinals()) {
+        return Cache::STATISTICS[ordinal].d_type;
+    }
+    else {
+        return ntci::Monitorable::e_AVERAGE;
+    }
+}
+
+int Cache::getFieldTags(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return ntci::Monitorable::e_ANONYMOUS;
+}
+
+int Cache::getFieldOrdinal(const char* fieldName) const
+{
+    int result = 0;
+
+    for (int ordinal = 0; ordinal < numOrdinals(); ++ordinal) {
+        if (bsl::strcmp(Cache::STATISTICS[ordinal].d_name, fieldName) == 0) {
+            result = ordinal;
+        }
+    }
+
+    return result;
+}
+
+int Cache::numOrdinals() const
+{
+    return sizeof Cache::STATISTICS / sizeof Cache::STATISTICS[0];
+}
+
+const char* Cache::objectName() const
+{
+    return d_objectName.c_str();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
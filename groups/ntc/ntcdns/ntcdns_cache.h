@@ -19,6 +19,8 @@
 #include <ntcdns_database.h>
 #include <ntcdns_utility.h>
 #include <ntcdns_vocabulary.h>
+#include <ntci_metric.h>
+#include <ntci_monitorable.h>
 #include <ntcscm_version.h>
 
 #include <ntsa_domainname.h>
@@ -28,8 +30,12 @@
 #include <ntsa_port.h>
 
 #include <bslmt_mutex.h>
+#include <bsls_atomic.h>
 #include <bsls_timeinterval.h>
 
+#include <bsl_cstdint.h>
+#include <bsl_functional.h>
+#include <bsl_list.h>
 #include <bsl_map.h>
 #include <bsl_memory.h>
 #include <bsl_string.h>
@@ -88,6 +94,21 @@ typedef bsl::unordered_map<ntsa::IpAddress,
 /// @ingroup module_ntcdns
 typedef CacheHostEntryByIpAddress::iterator CacheHostEntryByIpAddressIterator;
 
+/// @internal @brief
+/// Define a type alias for a list of cached entries ordered from the most
+/// recently used to the least recently used.
+///
+/// @ingroup module_ntcdns
+typedef bsl::list<bsl::shared_ptr<ntcdns::CacheHostEntry> >
+    CacheHostEntryList;
+
+/// @internal @brief
+/// Define a type alias to an element in a list of cached entries ordered
+/// from the most recently used to the least recently used.
+///
+/// @ingroup module_ntcdns
+typedef CacheHostEntryList::iterator CacheHostEntryListIterator;
+
 /// @internal @brief
 /// Describe a cached association between a domain name and an IP address.
 ///
@@ -106,6 +127,9 @@ class CacheHostEntry
 
     ntcdns::CacheHostEntryByDomainNameIterator d_iteratorByDomainName;
     ntcdns::CacheHostEntryByIpAddressIterator  d_iteratorByIpAddress;
+    ntcdns::CacheHostEntryListIterator         d_iteratorByRecency;
+    bsl::size_t                                d_numHits;
+    bool                                       d_refreshPending;
 
   private:
     CacheHostEntry(const CacheHostEntry&) BSLS_KEYWORD_DELETED;
@@ -150,6 +174,18 @@ class CacheHostEntry
     void setIteratorByIpAddress(
         ntcdns::CacheHostEntryByIpAddressIterator value);
 
+    /// Set the iterator to the entry in the list ordered by recency of use
+    /// to the specified 'value'.
+    void setIteratorByRecency(ntcdns::CacheHostEntryListIterator value);
+
+    /// Set the number of times this entry has been found by a lookup since
+    /// it was last updated to the specified 'value'.
+    void setNumHits(bsl::size_t value);
+
+    /// Set the flag indicating a refresh of this entry has been requested
+    /// but not yet completed to the specified 'value'.
+    void setRefreshPending(bool value);
+
     /// Return the domain name.
     const bsl::string& domainName() const;
 
@@ -176,6 +212,18 @@ class CacheHostEntry
     /// Return the iterator to the entry in the map keyed by IP address.
     ntcdns::CacheHostEntryByIpAddressIterator iteratorByIpAddress() const;
 
+    /// Return the iterator to the entry in the list ordered by recency of
+    /// use.
+    ntcdns::CacheHostEntryListIterator iteratorByRecency() const;
+
+    /// Return the number of times this entry has been found by a lookup
+    /// since it was last updated.
+    bsl::size_t numHits() const;
+
+    /// Return the flag indicating a refresh of this entry has been requested
+    /// but not yet completed.
+    bool refreshPending() const;
+
     /// Format this object to the specified output 'stream' at the
     /// optionally specified indentation 'level' and return a reference to
     /// the modifiable 'stream'.  If 'level' is specified, optionally
@@ -201,29 +249,69 @@ bsl::ostream& operator<<(bsl::ostream& stream, const CacheHostEntry& object);
 /// @internal @brief
 /// Provide a cache of names, addresses, and ports.
 ///
+/// @details
+/// Host entries are partitioned into shards by the hash of their domain name,
+/// each guarded by its own mutex, so that concurrent lookups of different
+/// names rarely contend. Each shard retains at most its share of the maximum
+/// number of entries, evicting its least recently used entry to make room for
+/// a new one. When a lookup finds an entry that has been found at least
+/// a minimum number of times since it was last updated, and whose remaining
+/// time-to-live is within a fraction of its original time-to-live, the
+/// refresh callback, if any, is invoked once so the entry may be resolved
+/// again before it expires.
+///
 /// @par Thread Safety
 /// This class is thread safe.
 ///
 /// @ingroup module_ntcdns
-class Cache
+class Cache : public ntci::Monitorable
 {
+  public:
+    /// Define a type alias for a function invoked to resolve the specified
+    /// 'domainName' according to the specified 'options' before the cached
+    /// IP addresses assigned to that domain name expire.
+    typedef bsl::function<void(const bsl::string&               domainName,
+                               const ntca::GetIpAddressOptions& options)>
+        RefreshCallback;
+
+  private:
+    /// This class describes a partition of the host entries.
+    class Shard;
+
+    /// Define a type alias for a vector of shards.
+    typedef bsl::vector<bsl::shared_ptr<Shard> > ShardVector;
+
     /// Define a type alias for a mutex.
     typedef ntccfg::Mutex Mutex;
 
     /// Define a type alias for a mutex lock guard.
     typedef ntccfg::LockGuard LockGuard;
 
-    mutable Mutex                              d_mutex;
-    mutable ntcdns::CacheHostEntryByDomainName d_cacheEntryByDomainName;
-    mutable ntcdns::CacheHostEntryByIpAddress  d_cacheEntryByIpAddress;
-    mutable bsl::size_t                        d_cacheEntryCount;
-    bool                                       d_positiveCacheEnabled;
-    bsl::size_t                                d_positiveCacheMinTimeToLive;
-    bsl::size_t                                d_positiveCacheMaxTimeToLive;
-    bool                                       d_negativeCacheEnabled;
-    bsl::size_t                                d_negativeCacheMinTimeToLive;
-    bsl::size_t                                d_negativeCacheMaxTimeToLive;
-    bslma::Allocator*                          d_allocator_p;
+    ShardVector                d_shardVector;
+    bsl::size_t                d_maxEntries;
+    bsl::size_t                d_maxEntriesPerShard;
+    double                     d_refreshThreshold;
+    bsl::size_t                d_refreshMinHits;
+    RefreshCallback            d_refreshCallback;
+    bool                       d_positiveCacheEnabled;
+    bsl::size_t                d_positiveCacheMinTimeToLive;
+    bsl::size_t                d_positiveCacheMaxTimeToLive;
+    bool                       d_negativeCacheEnabled;
+    bsl::size_t                d_negativeCacheMinTimeToLive;
+    bsl::size_t                d_negativeCacheMaxTimeToLive;
+    mutable bsls::AtomicUint64 d_numHits;
+    mutable bsls::AtomicUint64 d_numMisses;
+    mutable bsls::AtomicUint64 d_numEvictions;
+    mutable bsls::AtomicUint64 d_numExpirations;
+    mutable bsls::AtomicUint64 d_numRefreshes;
+    ntci::MetricTotal          d_hits;
+    ntci::MetricTotal          d_misses;
+    ntci::MetricTotal          d_evictions;
+    ntci::MetricTotal          d_expirations;
+    ntci::MetricTotal          d_refreshes;
+    bsl::string                d_prefix;
+    bsl::string                d_objectName;
+    bslma::Allocator*          d_allocator_p;
 
     static const bool        k_DEFAULT_POSITIVE_CACHE_ENABLED;
     static const bsl::size_t k_DEFAULT_POSITIVE_CACHE_MIN_TIME_TO_LIVE;
@@ -231,24 +319,58 @@ class Cache
     static const bool        k_DEFAULT_NEGATIVE_CACHE_ENABLED;
     static const bsl::size_t k_DEFAULT_NEGATIVE_CACHE_MIN_TIME_TO_LIVE;
     static const bsl::size_t k_DEFAULT_NEGATIVE_CACHE_MAX_TIME_TO_LIVE;
+    static const bsl::size_t k_DEFAULT_NUM_SHARDS;
+    static const bsl::size_t k_DEFAULT_MAX_ENTRIES;
+    static const double      k_DEFAULT_REFRESH_THRESHOLD;
+    static const bsl::size_t k_DEFAULT_REFRESH_MIN_HITS;
+
+    static const bsl::uint32_t k_SNAPSHOT_MAGIC;
+    static const bsl::uint32_t k_SNAPSHOT_VERSION;
+    static const bsl::size_t   k_SNAPSHOT_HEADER_SIZE;
+
+    static const struct ntci::MetricMetadata STATISTICS[];
 
   private:
     Cache(const Cache&) BSLS_KEYWORD_DELETED;
     Cache& operator=(const Cache&) BSLS_KEYWORD_DELETED;
 
   private:
-    /// Remove the specified 'cacheEntry'.
-    void privateRemove(
+    /// Return the shard that holds the host entries for the specified
+    /// 'domainName'.
+    Shard* lookupShard(const bsl::string& domainName) const;
+
+    /// Remove the specified 'cacheEntry' from the specified 'shard'.
+    static void privateRemove(
+        Shard*                                         shard,
         const bsl::shared_ptr<ntcdns::CacheHostEntry>& cacheEntry);
 
+    /// Mark the specified 'cacheEntry' in the specified 'shard' as the most
+    /// recently used.
+    static void privateTouch(
+        Shard*                                         shard,
+        const bsl::shared_ptr<ntcdns::CacheHostEntry>& cacheEntry);
+
+    /// Remove the least recently used entries from the specified 'shard'
+    /// until its number of entries is within its share of the limit,
+    /// counting each removed entry that has expired at the specified 'now'
+    /// as an expiration rather than an eviction.
+    void privateEvict(Shard* shard, const bsls::TimeInterval& now);
+
   public:
     /// Create a new object. Optionally specify a 'basicAllocator' used to
     /// supply memory. If 'basicAllocator' is 0, the currently installed
     /// default allocator is used.
     explicit Cache(bslma::Allocator* basicAllocator = 0);
 
+    /// Create a new object partitioned into the specified 'numShards'.
+    /// Optionally specify a 'basicAllocator' used to supply memory. If
+    /// 'basicAllocator' is 0, the currently installed default allocator is
+    /// used.
+    explicit Cache(bsl::size_t       numShards,
+                   bslma::Allocator* basicAllocator = 0);
+
     /// Destroy this object.
-    ~Cache();
+    ~Cache() BSLS_KEYWORD_OVERRIDE;
 
     /// Clear the cache.
     void clear();
@@ -285,6 +407,30 @@ class Cache
     /// indicating no maximum time-to-live is enforced.
     void setNegativeCacheMaxTimeToLive(bsl::size_t value);
 
+    /// Set the maximum number of host entries to the specified 'value'. The
+    /// limit is divided evenly among the shards, rounding up, so the total
+    /// number of entries may slightly exceed a 'value' that is not a
+    /// multiple of the number of shards. A 'value' of zero indicates no
+    /// limit is enforced. Note that this function should be called before
+    /// the cache is used.
+    void setMaxEntries(bsl::size_t value);
+
+    /// Set the fraction of its time-to-live that must remain, at most, for a
+    /// hot entry to be refreshed ahead of its expiration to the specified
+    /// 'value'. A 'value' of zero disables refresh-ahead.
+    void setRefreshThreshold(double value);
+
+    /// Set the minimum number of times an entry must be found by a lookup
+    /// since it was last updated to be considered hot to the specified
+    /// 'value'.
+    void setRefreshMinHits(bsl::size_t value);
+
+    /// Set the function invoked to refresh hot entries ahead of their
+    /// expiration to the specified 'callback'. The 'callback' is invoked
+    /// without any lock held by this object. Note that this function should
+    /// be called before the cache is used.
+    void setRefreshCallback(const RefreshCallback& callback);
+
     /// Insert or update the host entry for the specified 'domainName' to be
     /// associated with the specified 'ipAddress' starting from the
     /// specified 'now' for the specified 'timeToLive'.
@@ -334,11 +480,111 @@ class Cache
                                const ntca::GetServiceNameOptions& options,
                                const bsls::TimeInterval&          now) const;
 
+    /// Load into the specified 'result' a snapshot of the host entries that
+    /// have not expired at the specified 'now'. Each entry is stored with
+    /// its absolute expiration, so the remaining time-to-live of each entry
+    /// may be adjusted by the wall time elapsed until the snapshot is
+    /// decoded. Entries are stored from least to most recently used. Return
+    /// the error.
+    ntsa::Error encodeSnapshot(bsl::vector<bsl::uint8_t>* result,
+                               const bsls::TimeInterval&  now) const;
+
+    /// Insert each host entry in the snapshot defined by the specified
+    /// 'data' having the specified 'size' that has not expired at the
+    /// specified 'now', with its time-to-live set to the time remaining
+    /// until its original expiration. Load into the specified 'numEntries'
+    /// the number of entries inserted. Return the error. Note that entries
+    /// are not inserted unless the positive cache is enabled.
+    ntsa::Error decodeSnapshot(bsl::size_t*              numEntries,
+                               const void*               data,
+                               bsl::size_t               size,
+                               const bsls::TimeInterval& now);
+
+    /// Save a snapshot of the host entries that have not expired at the
+    /// specified 'now' to the file at the specified 'path'. The snapshot is
+    /// first written to a temporary file then renamed to 'path', so a
+    /// concurrent or interrupted save never leaves a partial snapshot at
+    /// 'path'. Return the error.
+    ntsa::Error saveSnapshot(const bsl::string&        path,
+                             const bsls::TimeInterval& now) const;
+
+    /// Load the snapshot stored in the file at the specified 'path',
+    /// inserting each host entry that has not expired at the specified
+    /// 'now'. Load into the specified 'numEntries' the number of entries
+    /// inserted. Return the error.
+    ntsa::Error loadSnapshot(bsl::size_t*              numEntries,
+                             const bsl::string&        path,
+                             const bsls::TimeInterval& now);
+
     /// Return the number of cached domain name to IP address associations.
     bsl::size_t numHostEntries() const;
 
     /// Return the number of cached service name to port associations.
     bsl::size_t numPortEntries() const;
+
+    /// Return the number of shards.
+    bsl::size_t numShards() const;
+
+    /// Return the maximum number of host entries.
+    bsl::size_t maxEntries() const;
+
+    /// Return the number of lookups that found at least one unexpired
+    /// entry.
+    bsl::uint64_t numHits() const;
+
+    /// Return the number of lookups that found no unexpired entry.
+    bsl::uint64_t numMisses() const;
+
+    /// Return the number of entries removed to make room for new entries.
+    bsl::uint64_t numEvictions() const;
+
+    /// Return the number of entries removed because they expired.
+    bsl::uint64_t numExpirations() const;
+
+    /// Return the number of refreshes requested ahead of expiration.
+    bsl::uint64_t numRefreshes() const;
+
+    /// Load into the specified 'result' the statistics measured since the
+    /// last call to this function.
+    void getStats(bdld::ManagedDatum* result) BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the prefix corresponding to the field at the specified
+    /// 'ordinal' position, or 0 if no field at the 'ordinal' position
+    /// exists.
+    const char* getFieldPrefix(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the field name corresponding to the field at the specified
+    /// 'ordinal' position, or 0 if no field at the 'ordinal' position
+    /// exists.
+    const char* getFieldName(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the field description corresponding to the field at the
+    /// specified 'ordinal' position, or 0 if no field at the 'ordinal'
+    /// position exists.
+    const char* getFieldDescription(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the type of the statistic at the specified 'ordinal'
+    /// position, or e_AVERAGE if no field at the 'ordinal' position exists
+    /// or the type is otherwise unknown.
+    ntci::Monitorable::StatisticType getFieldType(int ordinal) const
+        BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the flags that indicate which indexes to apply to the
+    /// statistic at the specified 'ordinal' position.
+    int getFieldTags(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the ordinal of the specified 'fieldName', or a negative value
+    /// if no field identified by 'fieldName' exists.
+    int getFieldOrdinal(const char* fieldName) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the maximum number of elements in a datum resulting from
+    /// a call to 'getStats()'.
+    int numOrdinals() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the human-readable name of the monitorable object, or 0 or
+    /// the empty string if no such human-readable name has been assigned to
+    /// the monitorable object.
+    const char* objectName() const BSLS_KEYWORD_OVERRIDE;
 };
 
 }  // close package namespace
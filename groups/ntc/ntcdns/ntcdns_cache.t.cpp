@@ -23,6 +23,11 @@ BSLS_IDENT_RCSID(ntcdns_cache_t_cpp, "$Id$ $CSID$")
 #include <ntcdns_utility.h>
 #include <ntci_log.h>
 
+#include <bdlf_bind.h>
+#include <bdlf_placeholder.h>
+
+#include <bsl_sstream.h>
+
 using namespace BloombergLP;
 
 namespace BloombergLP {
@@ -52,6 +57,18 @@ class CacheTest
         const bsl::string&                domainName,
         const ntca::GetDomainNameContext& context);
 
+    // Append the specified 'domainName' to the specified 'result' to record
+    // a request to refresh the 'domainName' according to the specified
+    // 'options'.
+    static void processRefresh(bsl::vector<bsl::string>*        result,
+                               const bsl::string&               domainName,
+                               const ntca::GetIpAddressOptions& options);
+
+    // Return the number of IP addresses assigned to the specified
+    // 'domainName' found in the specified 'cache', or 0 if none are found.
+    static bsl::size_t lookup(const ntcdns::Cache& cache,
+                              const bsl::string&   domainName);
+
   public:
     // TODO
     static void verifyCase1();
@@ -64,6 +81,20 @@ class CacheTest
 
     // TODO
     static void verifyCase4();
+
+    // Verify the least recently used entry is evicted when the maximum
+    // number of entries is reached.
+    static void verifyEviction();
+
+    // Verify hot entries are refreshed once ahead of their expiration.
+    static void verifyRefreshAhead();
+
+    // Verify the statistics reported through the monitorable interface.
+    static void verifyStatistics();
+
+    // Verify unexpired entries are restored from a snapshot with their
+    // remaining time-to-live.
+    static void verifySnapshot();
 };
 
 int CacheTest::s_now = 0;
@@ -128,6 +159,34 @@ void CacheTest::processGetDomainNameResult(
     }
 }
 
+void CacheTest::processRefresh(bsl::vector<bsl::string>*        result,
+                               const bsl::string&               domainName,
+                               const ntca::GetIpAddressOptions& options)
+{
+    NTCCFG_WARNING_UNUSED(options);
+
+    result->push_back(domainName);
+}
+
+bsl::size_t CacheTest::lookup(const ntcdns::Cache& cache,
+                              const bsl::string&   domainName)
+{
+    ntca::GetIpAddressContext context;
+    ntca::GetIpAddressOptions options;
+
+    bsl::vector<ntsa::IpAddress> ipAddressList;
+    ntsa::Error                  error = cache.getIpAddress(&context,
+                                           &ipAddressList,
+                                           domainName,
+                                           options,
+                                           CacheTest::getNow());
+    if (error) {
+        return 0;
+    }
+
+    return ipAddressList.size();
+}
+
 NTSCFG_TEST_FUNCTION(ntcdns::CacheTest::verifyCase1)
 {
     // Concern: Test 'getIpAddress' insertion, lookup, and expiration.
@@ -689,5 +748,311 @@ NTSCFG_TEST_FUNCTION(ntcdns::CacheTest::verifyCase4)
     NTSCFG_TEST_EQ(cache.numHostEntries(), 1);
 }
 
+NTSCFG_TEST_FUNCTION(ntcdns::CacheTest::verifyEviction)
+{
+    // Concern: The least recently used entry is evicted when the maximum
+    // number of entries is reached.
+
+    const ntsa::Endpoint NAME_SERVER("127.0.0.1:53");
+    const bsl::size_t    TTL = 60;
+
+    // Create a cache with a single shard so the order of eviction is
+    // exact, limited to two entries.
+
+    ntcdns::Cache cache(1, NTSCFG_TEST_ALLOCATOR);
+    cache.setMaxEntries(2);
+
+    NTSCFG_TEST_EQ(cache.numShards(), 1);
+    NTSCFG_TEST_EQ(cache.maxEntries(), 2);
+
+    cache.updateHost("a.example.com",
+                     ntsa::IpAddress("10.0.0.1"),
+                     NAME_SERVER,
+                     TTL,
+                     CacheTest::getNow());
+
+    cache.updateHost("b.example.com",
+                     ntsa::IpAddress("10.0.0.2"),
+                     NAME_SERVER,
+                     TTL,
+                     CacheTest::getNow());
+
+    NTSCFG_TEST_EQ(cache.numHostEntries(), 2);
+
+    // Look up "a.example.com" so that "b.example.com" becomes the least
+    // recently used entry.
+
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, "a.example.com"), 1);
+
+    // Insert a third entry and ensure "b.example.com" is evicted.
+
+    cache.updateHost("c.example.com",
+                     ntsa::IpAddress("10.0.0.3"),
+                     NAME_SERVER,
+                     TTL,
+                     CacheTest::getNow());
+
+    NTSCFG_TEST_EQ(cache.numHostEntries(), 2);
+    NTSCFG_TEST_EQ(cache.numEvictions(), 1);
+
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, "a.example.com"), 1);
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, "b.example.com"), 0);
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, "c.example.com"), 1);
+
+    // Ensure the evicted entry is no longer found by its IP address.
+
+    {
+        ntca::GetDomainNameContext context;
+        ntca::GetDomainNameOptions options;
+
+        bsl::string domainName;
+        ntsa::Error error = cache.getDomainName(&context,
+                                                &domainName,
+                                                ntsa::IpAddress("10.0.0.2"),
+                                                options,
+                                                CacheTest::getNow());
+        NTSCFG_TEST_ERROR(error, ntsa::Error::e_EOF);
+    }
+
+    // Create a sharded cache and ensure the number of entries remains
+    // bounded.
+
+    ntcdns::Cache shardedCache(4, NTSCFG_TEST_ALLOCATOR);
+    shardedCache.setMaxEntries(8);
+
+    for (bsl::size_t i = 0; i < 100; ++i) {
+        bsl::stringstream ss;
+        ss << "host-" << i << ".example.com";
+
+        ntsa::IpAddress ipAddress(ntsa::Ipv4Address(
+            static_cast<bsl::uint32_t>(0x0A000000 + i)));
+
+        shardedCache.updateHost(ss.str(),
+                                ipAddress,
+                                NAME_SERVER,
+                                TTL,
+                                CacheTest::getNow());
+
+        NTSCFG_TEST_LE(shardedCache.numHostEntries(), 8);
+    }
+
+    NTSCFG_TEST_EQ(shardedCache.numEvictions(),
+                   100 - shardedCache.numHostEntries());
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::CacheTest::verifyRefreshAhead)
+{
+    // Concern: An entry found at least twice since it was last updated is
+    // refreshed once its remaining time-to-live falls within 10% of its
+    // time-to-live, and only once until it is updated again.
+
+    const bsl::string     DOMAIN_NAME("test.example.com");
+    const ntsa::Endpoint  NAME_SERVER("127.0.0.1:53");
+    const ntsa::IpAddress IP_ADDRESS("192.168.0.101");
+    const bsl::size_t     TTL = 10;
+
+    bsl::vector<bsl::string> refreshList(NTSCFG_TEST_ALLOCATOR);
+
+    ntcdns::Cache cache(NTSCFG_TEST_ALLOCATOR);
+    cache.setRefreshCallback(bdlf::BindUtil::bind(&CacheTest::processRefresh,
+                                                  &refreshList,
+                                                  bdlf::PlaceHolders::_1,
+                                                  bdlf::PlaceHolders::_2));
+
+    cache.updateHost(DOMAIN_NAME,
+                     IP_ADDRESS,
+                     NAME_SERVER,
+                     TTL,
+                     CacheTest::getNow());
+
+    // Look up the entry at T 0: the entry is neither hot nor close to
+    // expiring.
+
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, DOMAIN_NAME), 1);
+    NTSCFG_TEST_EQ(refreshList.size(), 0);
+
+    // Advance time to T 9 and look up the entry: the entry is now hot and
+    // within 1 second of expiring, so a refresh is requested.
+
+    for (bsl::size_t i = 0; i < TTL - 1; ++i) {
+        CacheTest::advanceNow();
+    }
+
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, DOMAIN_NAME), 1);
+    NTSCFG_TEST_EQ(refreshList.size(), 1);
+    NTSCFG_TEST_EQ(refreshList[0], DOMAIN_NAME);
+
+    // Look up the entry again and ensure no further refresh is requested
+    // while the first is pending.
+
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, DOMAIN_NAME), 1);
+    NTSCFG_TEST_EQ(refreshList.size(), 1);
+    NTSCFG_TEST_EQ(cache.numRefreshes(), 1);
+
+    // Complete the refresh and ensure the entry's lifetime is extended.
+
+    cache.updateHost(DOMAIN_NAME,
+                     IP_ADDRESS,
+                     NAME_SERVER,
+                     TTL,
+                     CacheTest::getNow());
+
+    CacheTest::advanceNow();
+
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, DOMAIN_NAME), 1);
+    NTSCFG_TEST_EQ(refreshList.size(), 1);
+    NTSCFG_TEST_EQ(cache.numExpirations(), 0);
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::CacheTest::verifyStatistics)
+{
+    // Concern: Hits and misses are counted and reported as totals since the
+    // last collection.
+
+    const bsl::string     DOMAIN_NAME("test.example.com");
+    const ntsa::Endpoint  NAME_SERVER("127.0.0.1:53");
+    const ntsa::IpAddress IP_ADDRESS("192.168.0.101");
+    const bsl::size_t     TTL = 60;
+
+    ntcdns::Cache cache(NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, DOMAIN_NAME), 0);
+
+    cache.updateHost(DOMAIN_NAME,
+                     IP_ADDRESS,
+                     NAME_SERVER,
+                     TTL,
+                     CacheTest::getNow());
+
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, DOMAIN_NAME), 1);
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, DOMAIN_NAME), 1);
+
+    NTSCFG_TEST_EQ(cache.numHits(), 2);
+    NTSCFG_TEST_EQ(cache.numMisses(), 1);
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        cache.getStats(&stats);
+
+        NTSCFG_TEST_TRUE(stats->isArray());
+        NTSCFG_TEST_EQ(stats->theArray().length(), cache.numOrdinals());
+
+        NTSCFG_TEST_EQ(stats->theArray()[0].theDouble(), 1);
+        NTSCFG_TEST_EQ(stats->theArray()[1].theDouble(), 2);
+        NTSCFG_TEST_EQ(stats->theArray()[2].theDouble(), 1);
+    }
+
+    NTSCFG_TEST_EQ(CacheTest::lookup(cache, DOMAIN_NAME), 1);
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        cache.getStats(&stats);
+
+        NTSCFG_TEST_EQ(stats->theArray()[1].theDouble(), 1);
+        NTSCFG_TEST_EQ(stats->theArray()[2].theDouble(), 0);
+    }
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::CacheTest::verifySnapshot)
+{
+    // Concern: Entries that have not expired by the time a snapshot is
+    // decoded are restored with the time remaining until their original
+    // expiration, and entries that have expired are skipped.
+
+    const ntsa::Endpoint  NAME_SERVER("127.0.0.1:53");
+    const ntsa::IpAddress IP_ADDRESS_V4("192.168.0.101");
+    const ntsa::IpAddress IP_ADDRESS_V6("::1");
+
+    const bsls::TimeInterval now = CacheTest::getNow();
+
+    ntcdns::Cache source(NTSCFG_TEST_ALLOCATOR);
+
+    source.updateHost("long.example.com", IP_ADDRESS_V4, NAME_SERVER, 60, now);
+    source.updateHost("long.example.com", IP_ADDRESS_V6, NAME_SERVER, 60, now);
+    source.updateHost("short.example.com",
+                      IP_ADDRESS_V4,
+                      ntsa::Endpoint(),
+                      10,
+                      now);
+    source.updateHost("expired.example.com",
+                      IP_ADDRESS_V4,
+                      NAME_SERVER,
+                      1,
+                      now - bsls::TimeInterval(2, 0));
+
+    bsl::vector<bsl::uint8_t> snapshot(NTSCFG_TEST_ALLOCATOR);
+    ntsa::Error               error = source.encodeSnapshot(&snapshot, now);
+    NTSCFG_TEST_OK(error);
+
+    {
+        ntcdns::Cache destination(NTSCFG_TEST_ALLOCATOR);
+
+        bsl::size_t numEntries = 0;
+        error = destination.decodeSnapshot(&numEntries,
+                                           snapshot.data(),
+                                           snapshot.size(),
+                                           now + bsls::TimeInterval(5, 0));
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_EQ(numEntries, 3);
+        NTSCFG_TEST_EQ(destination.numHostEntries(), 3);
+
+        NTSCFG_TEST_EQ(CacheTest::lookup(destination, "long.example.com"), 2);
+        NTSCFG_TEST_EQ(CacheTest::lookup(destination, "short.example.com"),
+                       1);
+        NTSCFG_TEST_EQ(
+            CacheTest::lookup(destination, "expired.example.com"), 0);
+
+        ntca::GetIpAddressContext    context;
+        ntca::GetIpAddressOptions    options;
+        bsl::vector<ntsa::IpAddress> ipAddressList;
+
+        error = destination.getIpAddress(&context,
+                                         &ipAddressList,
+                                         "short.example.com",
+                                         options,
+                                         now + bsls::TimeInterval(5, 0));
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_EQ(context.timeToLive().value(), 5);
+    }
+
+    {
+        ntcdns::Cache destination(NTSCFG_TEST_ALLOCATOR);
+
+        bsl::size_t numEntries = 0;
+        error = destination.decodeSnapshot(&numEntries,
+                                           snapshot.data(),
+                                           snapshot.size(),
+                                           now + bsls::TimeInterval(30, 0));
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_EQ(numEntries, 2);
+        NTSCFG_TEST_EQ(destination.numHostEntries(), 2);
+    }
+
+    {
+        ntcdns::Cache destination(NTSCFG_TEST_ALLOCATOR);
+
+        bsl::size_t numEntries = 0;
+        error = destination.decodeSnapshot(&numEntries,
+                                           snapshot.data(),
+                                           snapshot.size() - 1,
+                                           now);
+        NTSCFG_TEST_TRUE(error);
+    }
+
+    {
+        ntcdns::Cache destination(NTSCFG_TEST_ALLOCATOR);
+
+        snapshot[0] ^= 0xFF;
+
+        bsl::size_t numEntries = 0;
+        error = destination.decodeSnapshot(&numEntries,
+                                           snapshot.data(),
+                                           snapshot.size(),
+                                           now);
+        NTSCFG_TEST_EQ(error, ntsa::Error(ntsa::Error::e_INVALID));
+        NTSCFG_TEST_EQ(numEntries, 0);
+    }
+}
+
 }  // close namespace ntcdns
 }  // close namespace BloombergLP
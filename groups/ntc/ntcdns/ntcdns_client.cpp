@@ -36,6 +36,7 @@
 #include <bsls_atomic.h>
 #include <bsls_platform.h>
 
+#include <bsl_algorithm.h>
 #include <bsl_ostream.h>
 
 #define NTCDNS_CLIENT_LOG_STARTING(configuration)                             \
@@ -109,6 +110,23 @@
             << (expectedServerIndex) << NTCI_LOG_STREAM_END;                  \
     } while (false)
 
+#define NTCDNS_CLIENT_OPERATION_LOG_HEDGE(name, endpoint, delay)             \
+    do {                                                                      \
+        NTCI_LOG_STREAM_DEBUG << "Hedging request for " << (name)             \
+                              << " to " << (endpoint)                         \
+                              << ": no response after " << (delay)            \
+                              << NTCI_LOG_STREAM_END;                         \
+    } while (false)
+
+#define NTCDNS_CLIENT_SERVER_LOG_HEDGED_RESPONSE(response, endpoint)          \
+    do {                                                                      \
+        NTCI_LOG_STREAM_DEBUG << "Ignoring response " << (response)           \
+                              << " from " << (endpoint)                       \
+                              << ": the operation has been hedged to "        \
+                                 "another name server"                        \
+                              << NTCI_LOG_STREAM_END;                         \
+    } while (false)
+
 #define NTCDNS_CLIENT_OPERATION_LOG_REDUNDANT_RESPONSE(response)              \
     do {                                                                      \
         NTCI_LOG_STREAM_DEBUG << "Ignoring response " << (response)           \
@@ -192,6 +210,68 @@ ClientOperation::~ClientOperation()
 {
 }
 
+void ClientOperation::processRequestSent(
+    const bsl::shared_ptr<ntcdns::ClientNameServer>& nameServer,
+    const bsl::shared_ptr<ntci::TimerFactory>&       timerFactory,
+    const bsls::TimeInterval&                        now)
+{
+    NTCCFG_WARNING_UNUSED(nameServer);
+    NTCCFG_WARNING_UNUSED(timerFactory);
+    NTCCFG_WARNING_UNUSED(now);
+}
+
+ntsa::Error ClientOperation::sendStreamRequest(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const ntsa::Endpoint&                      endpoint,
+    const ntcdns::Message&                     request)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    // Messages sent over TCP are prefixed by a two byte length field in
+    // network byte order, per RFC 1035 section 4.2.2.
+
+    enum { k_LENGTH_SIZE = 2, k_CAPACITY = 512 };
+
+    bsl::uint8_t buffer[k_LENGTH_SIZE + k_CAPACITY];
+
+    ntcdns::MemoryEncoder encoder(buffer + k_LENGTH_SIZE, k_CAPACITY);
+
+    bsl::size_t p0 = encoder.position();
+
+    error = request.encode(&encoder);
+    if (error) {
+        NTCDNS_CLIENT_OPERATION_LOG_ENCODE_FAILURE(request, error);
+        return error;
+    }
+
+    bsl::size_t p1          = encoder.position();
+    bsl::size_t requestSize = p1 - p0;
+
+    buffer[0] = static_cast<bsl::uint8_t>((requestSize >> 8) & 0xFF);
+    buffer[1] = static_cast<bsl::uint8_t>((requestSize >> 0) & 0xFF);
+
+    bsl::shared_ptr<bdlbb::Blob> requestBlob =
+        streamSocket->createOutgoingBlob();
+
+    bdlbb::BlobUtil::append(
+        requestBlob.get(),
+        reinterpret_cast<const char*>(buffer),
+        static_cast<int>(k_LENGTH_SIZE + requestSize));
+
+    NTCDNS_CLIENT_OPERATION_LOG_SEND_OBJECT(request, endpoint);
+    NTCDNS_CLIENT_OPERATION_LOG_SEND_BYTES(requestBlob, endpoint);
+
+    error = streamSocket->send(*requestBlob, ntca::SendOptions());
+    if (error) {
+        NTCDNS_CLIENT_OPERATION_LOG_SEND_FAILURE(request, error);
+        return error;
+    }
+
+    return ntsa::Error();
+}
+
 ClientGetIpAddressOperation::ClientGetIpAddressOperation(
     const bsl::shared_ptr<ntci::Resolver>& resolver,
     const bsl::string&                     name,
@@ -207,11 +287,14 @@ ClientGetIpAddressOperation::ClientGetIpAddressOperation(
 , d_name(name, basicAllocator)
 , d_serverList(serverList, basicAllocator)
 , d_serverIndex(0)
+, d_sendTimeList(serverList.size(), bsls::TimeInterval(), basicAllocator)
 , d_searchList(searchList, basicAllocator)
 , d_searchIndex(0)
 , d_options(options)
 , d_callback(callback, basicAllocator)
+, d_waiterList(basicAllocator)
 , d_timer_sp()
+, d_numHedges(0)
 , d_cache_sp(cache)
 , d_pending(true)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
@@ -222,38 +305,87 @@ ClientGetIpAddressOperation::~ClientGetIpAddressOperation()
 {
 }
 
-ntsa::Error ClientGetIpAddressOperation::sendRequest(
-    const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket,
-    const ntsa::Endpoint&                        endpoint,
-    bsl::uint16_t                                transactionId)
+void ClientGetIpAddressOperation::complete(
+    const bsl::shared_ptr<ntci::Resolver>& resolver,
+    const ntca::GetIpAddressOptions&       options,
+    const ntci::GetIpAddressCallback&      callback,
+    const bsl::vector<ntsa::IpAddress>&    ipAddressList,
+    const ntca::GetIpAddressContext&       context)
 {
-    NTCI_LOG_CONTEXT();
+    bsl::vector<ntsa::IpAddress> result(ipAddressList);
+    ntca::GetIpAddressContext    resultContext(context);
 
-    ntsa::Error error;
+    if (!result.empty()) {
+        if (options.ipAddressFilter().has_value()) {
+            if (options.ipAddressFilter().value()) {
+                options.ipAddressFilter().value()(&result);
+            }
+        }
+    }
 
-    if (d_searchIndex >= d_searchList.size()) {
-        return ntsa::Error(ntsa::Error::e_INVALID);
+    ntca::GetIpAddressEvent event;
+
+    if (result.empty()) {
+        event.setType(ntca::GetIpAddressEventType::e_ERROR);
+        if (!resultContext.error()) {
+            resultContext.setError(ntsa::Error(ntsa::Error::e_EOF));
+        }
+    }
+    else {
+        event.setType(ntca::GetIpAddressEventType::e_COMPLETE);
+
+        if (!options.ipAddressSelector().isNull()) {
+            ntsa::IpAddress ipAddress =
+                result[options.ipAddressSelector().value() % result.size()];
+            result.clear();
+            result.push_back(ipAddress);
+        }
     }
 
+    event.setContext(resultContext);
+
+    callback(resolver, result, event, ntci::Strand::unknown());
+}
+
+bool ClientGetIpAddressOperation::join(
+    const bsl::shared_ptr<ntci::Resolver>& resolver,
+    const ntca::GetIpAddressOptions&       options,
+    const ntci::GetIpAddressCallback&      callback)
+{
+    LockGuard lock(&d_mutex);
+
     if (!d_pending) {
-        NTCDNS_CLIENT_OPERATION_LOG_SEND_REFUSAL();
-        return ntsa::Error(ntsa::Error::e_CANCELLED);
+        return false;
     }
 
-    ntcdns::Message request;
+    d_waiterList.resize(d_waiterList.size() + 1);
 
-    request.setId(transactionId);
-    request.setDirection(ntcdns::Direction::e_REQUEST);
-    request.setOperation(ntcdns::Operation::e_STANDARD);
+    Waiter& waiter       = d_waiterList.back();
+    waiter.d_resolver_sp = resolver;
+    waiter.d_options     = options;
+    waiter.d_callback    = callback;
 
-    request.setAa(false);
-    request.setAd(false);
-    request.setCd(false);
-    request.setRa(false);
-    request.setRd(true);
-    request.setTc(false);
+    return true;
+}
 
-    ntcdns::Question& question = request.addQd();
+ntsa::Error ClientGetIpAddressOperation::createRequest(
+    ntcdns::Message* result,
+    bsl::uint16_t    transactionId)
+{
+    ntsa::Error error;
+
+    result->setId(transactionId);
+    result->setDirection(ntcdns::Direction::e_REQUEST);
+    result->setOperation(ntcdns::Operation::e_STANDARD);
+
+    result->setAa(false);
+    result->setAd(false);
+    result->setCd(false);
+    result->setRa(false);
+    result->setRd(true);
+    result->setTc(false);
+
+    ntcdns::Question& question = result->addQd();
 
     question.setName(d_searchList[d_searchIndex]);
 
@@ -280,6 +412,33 @@ ntsa::Error ClientGetIpAddressOperation::sendRequest(
 
     question.setClassification(ntcdns::Classification::e_INTERNET);
 
+    return ntsa::Error();
+}
+
+ntsa::Error ClientGetIpAddressOperation::sendRequest(
+    const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket,
+    const ntsa::Endpoint&                        endpoint,
+    bsl::uint16_t                                transactionId)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    if (d_searchIndex >= d_searchList.size()) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    if (!d_pending) {
+        NTCDNS_CLIENT_OPERATION_LOG_SEND_REFUSAL();
+        return ntsa::Error(ntsa::Error::e_CANCELLED);
+    }
+
+    ntcdns::Message request;
+    error = this->createRequest(&request, transactionId);
+    if (error) {
+        return error;
+    }
+
     bsl::shared_ptr<bdlbb::Blob> requestBlob =
         datagramSocket->createOutgoingBlob();
 
@@ -328,26 +487,181 @@ ntsa::Error ClientGetIpAddressOperation::sendRequest(
     const ntsa::Endpoint&                      endpoint,
     bsl::uint16_t                              transactionId)
 {
-    NTCCFG_WARNING_UNUSED(streamSocket);
-    NTCCFG_WARNING_UNUSED(endpoint);
-    NTCCFG_WARNING_UNUSED(transactionId);
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    if (d_searchIndex >= d_searchList.size()) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    if (!d_pending) {
+        NTCDNS_CLIENT_OPERATION_LOG_SEND_REFUSAL();
+        return ntsa::Error(ntsa::Error::e_CANCELLED);
+    }
+
+    ntcdns::Message request;
+    error = this->createRequest(&request, transactionId);
+    if (error) {
+        return error;
+    }
 
-    return ntsa::Error(ntsa::Error::e_NOT_IMPLEMENTED);
+    return ClientOperation::sendStreamRequest(streamSocket,
+                                              endpoint,
+                                              request);
+}
+
+void ClientGetIpAddressOperation::processHedgeTimer(
+    const bsl::shared_ptr<ntci::Timer>& timer,
+    const ntca::TimerEvent&             event)
+{
+    NTCI_LOG_CONTEXT();
+
+    if (event.type() != ntca::TimerEventType::e_DEADLINE) {
+        return;
+    }
+
+    timer->close();
+
+    bsl::shared_ptr<ntcdns::ClientNameServer> nameServer;
+    bsls::TimeInterval                        elapsed;
+    {
+        LockGuard lock(&d_mutex);
+
+        if (timer != d_timer_sp) {
+            return;
+        }
+
+        d_timer_sp.reset();
+
+        if (!d_pending || d_serverIndex + 1 >= d_serverList.size()) {
+            return;
+        }
+
+        nameServer = d_serverList[d_serverIndex];
+        elapsed    = event.context().now() - d_sendTimeList[d_serverIndex];
+    }
+
+    NTCDNS_CLIENT_OPERATION_LOG_HEDGE(d_name, nameServer->endpoint(), elapsed);
+
+    // The name server has not answered within the hedge delay: record that
+    // duration as a lower bound of its latency so that it ranks behind name
+    // servers that answer faster, and race the request on the next name
+    // server without abandoning the request already sent. The first answer
+    // completes the operation.
+
+    nameServer->recordLatency(elapsed);
+
+    bsl::shared_ptr<ClientGetIpAddressOperation> self = this->getSelf(this);
+
+    while (true) {
+        bsl::shared_ptr<ntcdns::ClientNameServer> nextServer =
+            this->tryNextServer();
+        if (!nextServer) {
+            break;
+        }
+
+        {
+            LockGuard lock(&d_mutex);
+            ++d_numHedges;
+        }
+
+        ntsa::Error error = nextServer->initiate(self);
+        if (!error) {
+            break;
+        }
+    }
+}
+
+void ClientGetIpAddressOperation::completeHedge(
+    const bsl::shared_ptr<ntcdns::ClientNameServer>& nameServer)
+{
+    bsl::shared_ptr<ntci::Timer> timer;
+    ServerList                   abandonList(d_allocator_p);
+    {
+        LockGuard lock(&d_mutex);
+
+        timer.swap(d_timer_sp);
+
+        if (d_numHedges > 0) {
+            for (bsl::size_t i = 0;
+                 i <= d_serverIndex && i < d_serverList.size();
+                 ++i)
+            {
+                if (d_serverList[i] != nameServer) {
+                    abandonList.push_back(d_serverList[i]);
+                }
+            }
+        }
+
+        d_serverList.clear();
+    }
+
+    if (timer) {
+        timer->close();
+    }
+
+    if (!abandonList.empty()) {
+        bsl::shared_ptr<ClientGetIpAddressOperation> self =
+            this->getSelf(this);
+
+        for (ServerList::const_iterator it = abandonList.begin();
+             it != abandonList.end();
+             ++it)
+        {
+            (*it)->abandon(self);
+        }
+    }
 }
 
 void ClientGetIpAddressOperation::processResponse(
-    const ntcdns::Message&    response,
-    const ntsa::Endpoint&     endpoint,
-    bsl::size_t               serverIndex,
-    const bsls::TimeInterval& now)
+    const ntcdns::MessageView& response,
+    const ntsa::Endpoint&      endpoint,
+    bsl::size_t                serverIndex,
+    const bsls::TimeInterval&  now)
 {
     NTCI_LOG_CONTEXT();
 
     ntsa::Error error;
 
-    if (serverIndex != d_serverIndex) {
+    // Accept the response from any name server to which the request has
+    // been sent: when the request is hedged, the first answer wins.
+
+    bsl::shared_ptr<ntcdns::ClientNameServer> nameServer;
+    bsl::shared_ptr<ntcdns::ClientNameServer> currentServer;
+    bsls::TimeInterval                        sendTime;
+    {
+        LockGuard lock(&d_mutex);
+
+        for (bsl::size_t i = 0;
+             i <= d_serverIndex && i < d_serverList.size();
+             ++i)
+        {
+            if (d_serverList[i]->index() == serverIndex) {
+                nameServer = d_serverList[i];
+                sendTime   = d_sendTimeList[i];
+                break;
+            }
+        }
+
+        if (d_serverIndex < d_serverList.size()) {
+            currentServer = d_serverList[d_serverIndex];
+        }
+    }
+
+    if (!nameServer) {
+        // The request has not been sent to the name server that responded,
+        // or the operation has already completed and released its name
+        // servers.
+
+        if (!currentServer) {
+            NTCDNS_CLIENT_OPERATION_LOG_REDUNDANT_RESPONSE(response);
+            return;
+        }
+
+        const bsl::size_t expectedServerIndex = currentServer->index();
         NTCDNS_CLIENT_OPERATION_LOG_STALE_RESPONSE(response,
-                                                   d_serverIndex,
+                                                   expectedServerIndex,
                                                    serverIndex);
         return;
     }
@@ -357,19 +671,22 @@ void ClientGetIpAddressOperation::processResponse(
         return;
     }
 
-    if (d_timer_sp) {
-        d_timer_sp->close();
+    if (sendTime != bsls::TimeInterval() && now >= sendTime) {
+        nameServer->recordLatency(now - sendTime);
     }
 
+    this->completeHedge(nameServer);
+
     bsl::vector<ntsa::IpAddress> ipAddressList;
     ntca::GetIpAddressContext    context;
 
     context.setSource(ntca::ResolverSource::e_SERVER);
     context.setNameServer(endpoint);
 
-    if (response.qdcount() > 0) {
-        const ntcdns::Question& question = response.qd(0);
-        context.setDomainName(question.name());
+    if (!response.question().isNull()) {
+        bsl::string domainName;
+        response.question().load(&domainName);
+        context.setDomainName(domainName);
     }
 
     bdlb::NullableValue<ntsa::IpAddressType::Value> ipAddressType;
@@ -377,99 +694,66 @@ void ClientGetIpAddressOperation::processResponse(
 
     bdlb::NullableValue<bsl::size_t> timeToLive;
 
-    if (response.ancount() > 0) {
-        for (bsl::size_t i = 0; i < response.ancount(); ++i) {
-            const ntcdns::ResourceRecord& answer = response.an(i);
-
-            if (answer.rdata().isIpv4Value()) {
-                BSLMF_ASSERT(sizeof answer.rdata().ipv4() == 4);
-                ntsa::Ipv4Address ipv4Address;
-                ipv4Address.copyFrom(&answer.rdata().ipv4(),
-                                     sizeof answer.rdata().ipv4());
+    // Walk the answer section directly over the response payload: only the
+    // records that carry an address are interpreted, and nothing is copied
+    // other than the addresses themselves.
 
-                ntsa::IpAddress ipAddress(ipv4Address);
+    ntcdns::MemoryDecoder decoder(response.data(), response.size());
+    decoder.seek(response.answerOffset());
 
-                if (ipAddressType.isNull() ||
-                    ipAddressType.value() == ntsa::IpAddressType::e_V4)
-                {
-                    ipAddressList.push_back(ipAddress);
+    for (bsl::size_t i = 0; i < response.ancount(); ++i) {
+        ntcdns::ResourceRecordView answer;
+        error = answer.decode(&decoder);
+        if (error) {
+            break;
+        }
 
-                    if (timeToLive.isNull()) {
-                        timeToLive.makeValue(answer.ttl());
-                    }
-                    else {
-                        bsl::size_t timeToLiveValue = timeToLive.value();
-                        if (timeToLiveValue != answer.ttl()) {
-                            NTCDNS_CLIENT_OPERATION_LOG_TTL_MISMATCH(
-                                answer.ttl(),
-                                timeToLiveValue);
-                            if (answer.ttl() < timeToLiveValue) {
-                                timeToLive = answer.ttl();
-                            }
-                        }
-                    }
-                }
+        if (!answer.isIpv4() && !answer.isIpv6()) {
+            continue;
+        }
 
-                if (d_cache_sp) {
-                    d_cache_sp->updateHost(context.domainName(),
-                                           ipAddress,
-                                           endpoint,
-                                           answer.ttl(),
-                                           now);
-
-                    if (d_name != context.domainName()) {
-                        d_cache_sp->updateHost(d_name,
-                                               ipAddress,
-                                               endpoint,
-                                               answer.ttl(),
-                                               now);
-                    }
-                }
-            }
-            else if (answer.rdata().isIpv6Value()) {
-                BSLMF_ASSERT(sizeof answer.rdata().ipv6() == 16);
-                ntsa::Ipv6Address ipv6Address;
-                ipv6Address.copyFrom(&answer.rdata().ipv6(),
-                                     sizeof answer.rdata().ipv6());
+        ntsa::IpAddress ipAddress;
+        error = answer.loadIpAddress(&ipAddress);
+        if (error) {
+            continue;
+        }
 
-                ntsa::IpAddress ipAddress(ipv6Address);
+        const bsl::size_t answerTimeToLive = answer.ttl();
 
-                if (ipAddressType.isNull() ||
-                    ipAddressType.value() == ntsa::IpAddressType::e_V6)
-                {
-                    ipAddressList.push_back(ipAddress);
+        if (ipAddressType.isNull() ||
+            ipAddressType.value() == ipAddress.type())
+        {
+            ipAddressList.push_back(ipAddress);
 
-                    if (timeToLive.isNull()) {
-                        timeToLive.makeValue(answer.ttl());
-                    }
-                    else {
-                        bsl::size_t timeToLiveValue = timeToLive.value();
-                        if (timeToLiveValue != answer.ttl()) {
-                            NTCDNS_CLIENT_OPERATION_LOG_TTL_MISMATCH(
-                                answer.ttl(),
-                                timeToLiveValue);
-                            if (answer.ttl() < timeToLiveValue) {
-                                timeToLive = answer.ttl();
-                            }
-                        }
+            if (timeToLive.isNull()) {
+                timeToLive.makeValue(answerTimeToLive);
+            }
+            else {
+                bsl::size_t timeToLiveValue = timeToLive.value();
+                if (timeToLiveValue != answerTimeToLive) {
+                    NTCDNS_CLIENT_OPERATION_LOG_TTL_MISMATCH(
+                        answerTimeToLive,
+                        timeToLiveValue);
+                    if (answerTimeToLive < timeToLiveValue) {
+                        timeToLive = answerTimeToLive;
                     }
                 }
+            }
+        }
 
-                if (d_cache_sp) {
-                    d_cache_sp->updateHost(context.domainName(),
-                                           ipAddress,
-                                           endpoint,
-                                           answer.ttl(),
-                                           now);
-
-                    if (d_name != context.domainName()) {
-                        d_cache_sp->updateHost(d_name,
-                                               ipAddress,
-                                               endpoint,
-                                               answer.ttl(),
-                                               now);
-                    }
-                }
+        if (d_cache_sp) {
+            d_cache_sp->updateHost(context.domainName(),
+                                   ipAddress,
+                                   endpoint,
+                                   answerTimeToLive,
+                                   now);
+
+            if (d_name != context.domainName()) {
+                d_cache_sp->updateHost(d_name,
+                                       ipAddress,
+                                       endpoint,
+                                       answerTimeToLive,
+                                       now);
             }
         }
     }
@@ -478,43 +762,36 @@ void ClientGetIpAddressOperation::processResponse(
         ntsu::ResolverUtil::sortIpAddressList(&ipAddressList);
     }
 
-    if (!ipAddressList.empty()) {
-        if (d_options.ipAddressFilter().has_value()) {
-            if (d_options.ipAddressFilter().value()) {
-                d_options.ipAddressFilter().value()(&ipAddressList);
-            }
-        }
+    if (!ipAddressList.empty() && !timeToLive.isNull()) {
+        context.setTimeToLive(timeToLive.value());
     }
 
-    ntca::GetIpAddressEvent event;
+    // Fan out the result to the initiator and each caller that joined the
+    // operation, applying the options of each to its own copy.
 
-    if (ipAddressList.empty()) {
-        event.setType(ntca::GetIpAddressEventType::e_ERROR);
-        context.setError(ntsa::Error(ntsa::Error::e_EOF));
+    WaiterList waiterList;
+    {
+        LockGuard lock(&d_mutex);
+        waiterList.swap(d_waiterList);
     }
-    else {
-        event.setType(ntca::GetIpAddressEventType::e_COMPLETE);
 
-        if (!timeToLive.isNull()) {
-            context.setTimeToLive(timeToLive.value());
-        }
+    ClientGetIpAddressOperation::complete(d_resolver_sp,
+                                          d_options,
+                                          d_callback,
+                                          ipAddressList,
+                                          context);
+    d_callback.reset();
 
-        if (!d_options.ipAddressSelector().isNull()) {
-            ntsa::IpAddress ipAddress =
-                ipAddressList[d_options.ipAddressSelector().value() %
-                              ipAddressList.size()];
-            ipAddressList.clear();
-            ipAddressList.push_back(ipAddress);
-        }
+    for (bsl::size_t i = 0; i < waiterList.size(); ++i) {
+        const Waiter& waiter = waiterList[i];
+        ClientGetIpAddressOperation::complete(waiter.d_resolver_sp,
+                                              waiter.d_options,
+                                              waiter.d_callback,
+                                              ipAddressList,
+                                              context);
     }
 
-    event.setContext(context);
-
-    d_callback(d_resolver_sp, ipAddressList, event, ntci::Strand::unknown());
-    d_callback.reset();
-
     d_resolver_sp.reset();
-    d_serverList.clear();
 }
 
 void ClientGetIpAddressOperation::processError(const ntsa::Error& error)
@@ -523,9 +800,7 @@ void ClientGetIpAddressOperation::processError(const ntsa::Error& error)
         return;
     }
 
-    if (d_timer_sp) {
-        d_timer_sp->close();
-    }
+    this->completeHedge(bsl::shared_ptr<ntcdns::ClientNameServer>());
 
     bsl::vector<ntsa::IpAddress> ipAddressList;
 
@@ -533,15 +808,29 @@ void ClientGetIpAddressOperation::processError(const ntsa::Error& error)
     context.setDomainName(d_name);
     context.setError(error);
 
-    ntca::GetIpAddressEvent event;
-    event.setType(ntca::GetIpAddressEventType::e_ERROR);
-    event.setContext(context);
+    WaiterList waiterList;
+    {
+        LockGuard lock(&d_mutex);
+        waiterList.swap(d_waiterList);
+    }
 
-    d_callback(d_resolver_sp, ipAddressList, event, ntci::Strand::unknown());
+    ClientGetIpAddressOperation::complete(d_resolver_sp,
+                                          d_options,
+                                          d_callback,
+                                          ipAddressList,
+                                          context);
     d_callback.reset();
 
+    for (bsl::size_t i = 0; i < waiterList.size(); ++i) {
+        const Waiter& waiter = waiterList[i];
+        ClientGetIpAddressOperation::complete(waiter.d_resolver_sp,
+                                              waiter.d_options,
+                                              waiter.d_callback,
+                                              ipAddressList,
+                                              context);
+    }
+
     d_resolver_sp.reset();
-    d_serverList.clear();
 }
 
 bsl::shared_ptr<ntcdns::ClientNameServer> ClientGetIpAddressOperation::
@@ -551,7 +840,7 @@ bsl::shared_ptr<ntcdns::ClientNameServer> ClientGetIpAddressOperation::
 
     bsl::shared_ptr<ntcdns::ClientNameServer> result;
 
-    if (d_serverIndex < d_serverList.size() - 1) {
+    if (d_serverIndex + 1 < d_serverList.size()) {
         ++d_serverIndex;
         d_searchIndex = 0;
         result        = d_serverList[d_serverIndex];
@@ -572,6 +861,81 @@ bool ClientGetIpAddressOperation::tryNextSearch()
     return false;
 }
 
+void ClientGetIpAddressOperation::processRequestSent(
+    const bsl::shared_ptr<ntcdns::ClientNameServer>& nameServer,
+    const bsl::shared_ptr<ntci::TimerFactory>&       timerFactory,
+    const bsls::TimeInterval&                        now)
+{
+    if (!d_pending) {
+        return;
+    }
+
+    bsl::shared_ptr<ntci::Timer> previousTimer;
+    bsl::shared_ptr<ntci::Timer> timer;
+    bsls::TimeInterval           delay;
+    {
+        LockGuard lock(&d_mutex);
+
+        if (d_serverIndex >= d_serverList.size()) {
+            return;
+        }
+
+        if (d_serverList[d_serverIndex] != nameServer) {
+            return;
+        }
+
+        d_sendTimeList[d_serverIndex] = now;
+
+        if (d_serverIndex + 1 >= d_serverList.size()) {
+            return;
+        }
+
+        if (!nameServer->hedgeDelay(&delay)) {
+            return;
+        }
+
+        ntca::TimerOptions timerOptions;
+        timerOptions.setOneShot(true);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+
+        ntci::TimerCallback timerCallback = timerFactory->createTimerCallback(
+            bdlf::BindUtil::bind(
+                &ClientGetIpAddressOperation::processHedgeTimer,
+                this->getSelf(this),
+                bdlf::PlaceHolders::_1,
+                bdlf::PlaceHolders::_2),
+            d_allocator_p);
+
+        timer = timerFactory->createTimer(timerOptions,
+                                          timerCallback,
+                                          d_allocator_p);
+
+        previousTimer.swap(d_timer_sp);
+        d_timer_sp = timer;
+    }
+
+    if (previousTimer) {
+        previousTimer->close();
+    }
+
+    timer->schedule(now + delay);
+}
+
+bsl::shared_ptr<ntcdns::ClientNameServer> ClientGetIpAddressOperation::
+    currentServer() const
+{
+    LockGuard lock(&d_mutex);
+
+    bsl::shared_ptr<ntcdns::ClientNameServer> result;
+
+    if (d_serverIndex < d_serverList.size()) {
+        result = d_serverList[d_serverIndex];
+    }
+
+    return result;
+}
+
 const bsl::string& ClientGetIpAddressOperation::name() const
 {
     return d_name;
@@ -594,6 +958,18 @@ bsl::size_t ClientGetIpAddressOperation::searchIndex() const
     return d_searchIndex;
 }
 
+bsl::size_t ClientGetIpAddressOperation::numWaiters() const
+{
+    LockGuard lock(&d_mutex);
+    return d_waiterList.size();
+}
+
+bsl::size_t ClientGetIpAddressOperation::numHedges() const
+{
+    LockGuard lock(&d_mutex);
+    return d_numHedges;
+}
+
 ClientGetDomainNameOperation::ClientGetDomainNameOperation(
     const bsl::shared_ptr<ntci::Resolver>& resolver,
     const ntsa::IpAddress&                 ipAddress,
@@ -621,34 +997,22 @@ ClientGetDomainNameOperation::~ClientGetDomainNameOperation()
 {
 }
 
-ntsa::Error ClientGetDomainNameOperation::sendRequest(
-    const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket,
-    const ntsa::Endpoint&                        endpoint,
-    bsl::uint16_t                                transactionId)
+ntsa::Error ClientGetDomainNameOperation::createRequest(
+    ntcdns::Message* result,
+    bsl::uint16_t    transactionId)
 {
-    NTCI_LOG_CONTEXT();
-
-    ntsa::Error error;
-
-    if (!d_pending) {
-        NTCDNS_CLIENT_OPERATION_LOG_SEND_REFUSAL();
-        return ntsa::Error(ntsa::Error::e_CANCELLED);
-    }
-
-    ntcdns::Message request;
-
-    request.setId(transactionId);
-    request.setDirection(ntcdns::Direction::e_REQUEST);
-    request.setOperation(ntcdns::Operation::e_STANDARD);
+    result->setId(transactionId);
+    result->setDirection(ntcdns::Direction::e_REQUEST);
+    result->setOperation(ntcdns::Operation::e_STANDARD);
 
-    request.setAa(false);
-    request.setAd(false);
-    request.setCd(false);
-    request.setRa(false);
-    request.setRd(true);
-    request.setTc(false);
+    result->setAa(false);
+    result->setAd(false);
+    result->setCd(false);
+    result->setRa(false);
+    result->setRd(true);
+    result->setTc(false);
 
-    ntcdns::Question& question = request.addQd();
+    ntcdns::Question& question = result->addQd();
 
     if (d_ipAddress.isV4()) {
         bsl::string arpaName;
@@ -680,6 +1044,29 @@ ntsa::Error ClientGetDomainNameOperation::sendRequest(
         return ntsa::Error(ntsa::Error::e_INVALID);
     }
 
+    return ntsa::Error();
+}
+
+ntsa::Error ClientGetDomainNameOperation::sendRequest(
+    const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket,
+    const ntsa::Endpoint&                        endpoint,
+    bsl::uint16_t                                transactionId)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    if (!d_pending) {
+        NTCDNS_CLIENT_OPERATION_LOG_SEND_REFUSAL();
+        return ntsa::Error(ntsa::Error::e_CANCELLED);
+    }
+
+    ntcdns::Message request;
+    error = this->createRequest(&request, transactionId);
+    if (error) {
+        return error;
+    }
+
     bsl::shared_ptr<bdlbb::Blob> requestBlob =
         datagramSocket->createOutgoingBlob();
 
@@ -728,18 +1115,31 @@ ntsa::Error ClientGetDomainNameOperation::sendRequest(
     const ntsa::Endpoint&                      endpoint,
     bsl::uint16_t                              transactionId)
 {
-    NTCCFG_WARNING_UNUSED(streamSocket);
-    NTCCFG_WARNING_UNUSED(endpoint);
-    NTCCFG_WARNING_UNUSED(transactionId);
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    if (!d_pending) {
+        NTCDNS_CLIENT_OPERATION_LOG_SEND_REFUSAL();
+        return ntsa::Error(ntsa::Error::e_CANCELLED);
+    }
 
-    return ntsa::Error(ntsa::Error::e_NOT_IMPLEMENTED);
+    ntcdns::Message request;
+    error = this->createRequest(&request, transactionId);
+    if (error) {
+        return error;
+    }
+
+    return ClientOperation::sendStreamRequest(streamSocket,
+                                              endpoint,
+                                              request);
 }
 
 void ClientGetDomainNameOperation::processResponse(
-    const ntcdns::Message&    response,
-    const ntsa::Endpoint&     endpoint,
-    bsl::size_t               serverIndex,
-    const bsls::TimeInterval& now)
+    const ntcdns::MessageView& response,
+    const ntsa::Endpoint&      endpoint,
+    bsl::size_t                serverIndex,
+    const bsls::TimeInterval&  now)
 {
     NTCCFG_WARNING_UNUSED(now);
 
@@ -770,26 +1170,37 @@ void ClientGetDomainNameOperation::processResponse(
 
     bdlb::NullableValue<bsl::size_t> timeToLive;
 
-    if (response.ancount() > 0) {
-        for (bsl::size_t i = 0; i < response.ancount(); ++i) {
-            const ntcdns::ResourceRecord& answer = response.an(i);
+    ntcdns::MemoryDecoder decoder(response.data(), response.size());
+    decoder.seek(response.answerOffset());
 
-            if (timeToLive.isNull()) {
-                timeToLive.makeValue(answer.ttl());
-            }
-            else {
-                bsl::size_t timeToLiveValue = timeToLive.value();
-                if (timeToLiveValue != answer.ttl()) {
-                    NTCDNS_CLIENT_OPERATION_LOG_TTL_MISMATCH(answer.ttl(),
-                                                             timeToLiveValue);
-                    if (answer.ttl() < timeToLiveValue) {
-                        timeToLive = answer.ttl();
-                    }
+    for (bsl::size_t i = 0; i < response.ancount(); ++i) {
+        ntcdns::ResourceRecordView answer;
+        ntsa::Error                error = answer.decode(&decoder);
+        if (error) {
+            break;
+        }
+
+        const bsl::size_t answerTimeToLive = answer.ttl();
+
+        if (timeToLive.isNull()) {
+            timeToLive.makeValue(answerTimeToLive);
+        }
+        else {
+            bsl::size_t timeToLiveValue = timeToLive.value();
+            if (timeToLiveValue != answerTimeToLive) {
+                NTCDNS_CLIENT_OPERATION_LOG_TTL_MISMATCH(answerTimeToLive,
+                                                         timeToLiveValue);
+                if (answerTimeToLive < timeToLiveValue) {
+                    timeToLive = answerTimeToLive;
                 }
             }
+        }
 
-            if (answer.rdata().isPointerValue()) {
-                domainName = answer.rdata().pointer().ptrdname();
+        if (answer.isPointer()) {
+            ntcdns::NameView nameView;
+            error = answer.loadDomainName(&nameView);
+            if (!error) {
+                nameView.load(&domainName);
             }
         }
     }
@@ -856,6 +1267,20 @@ bool ClientGetDomainNameOperation::tryNextSearch()
     return false;
 }
 
+bsl::shared_ptr<ntcdns::ClientNameServer> ClientGetDomainNameOperation::
+    currentServer() const
+{
+    LockGuard lock(&d_mutex);
+
+    bsl::shared_ptr<ntcdns::ClientNameServer> result;
+
+    if (d_serverIndex < d_serverList.size()) {
+        result = d_serverList[d_serverIndex];
+    }
+
+    return result;
+}
+
 const ntsa::IpAddress& ClientGetDomainNameOperation::ipAddress() const
 {
     return d_ipAddress;
@@ -884,6 +1309,11 @@ class ClientNameServer::Impl
     // Return a unique transaction ID.
     static bsl::uint16_t generateTransactionId();
 
+    // Initiate the specified 'operation' on the next name server it has not
+    // yet tried, or fail the operation if all name servers have been tried.
+    static void tryNextServer(
+        const bsl::shared_ptr<ntcdns::ClientOperation>& operation);
+
   private:
     static bsls::AtomicUint s_generation;
 };
@@ -915,8 +1345,41 @@ bsl::uint16_t ClientNameServer::Impl::generateTransactionId()
     return result;
 }
 
+void ClientNameServer::Impl::tryNextServer(
+    const bsl::shared_ptr<ntcdns::ClientOperation>& operation)
+{
+    ntsa::Error error;
+
+    while (true) {
+        bsl::shared_ptr<ntcdns::ClientNameServer> nameServer =
+            operation->tryNextServer();
+
+        if (nameServer) {
+            error = nameServer->initiate(operation);
+            if (error) {
+                continue;
+            }
+            else {
+                break;
+            }
+        }
+        else {
+            operation->processError(ntsa::Error(ntsa::Error::e_EOF));
+            break;
+        }
+    }
+}
+
 const bsl::size_t ClientNameServer::k_UDP_MAX_PAYLOAD_SIZE = 65527;
 
+const bsl::size_t ClientNameServer::k_TCP_LENGTH_PREFIX_SIZE = 2;
+
+const bsls::TimeInterval ClientNameServer::k_TCP_IDLE_TIMEOUT(10, 0);
+
+const bsl::size_t ClientNameServer::k_LATENCY_SAMPLE_CAPACITY = 64;
+
+const bsl::size_t ClientNameServer::k_LATENCY_SAMPLE_MINIMUM = 8;
+
 void ClientNameServer::processReadQueueLowWatermark(
     const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket,
     const ntca::ReadQueueEvent&                  event)
@@ -938,115 +1401,45 @@ void ClientNameServer::processReadQueueLowWatermark(
         error = datagramSocket->receive(&receiveContext,
                                         responseBlob.get(),
                                         receiveOptions);
-        if (error) {
-            if (error != ntsa::Error(ntsa::Error::e_EOF)) {
-                NTCDNS_CLIENT_SERVER_LOG_RECEIVE_FAILURE(error);
-            }
-            return;
-        }
-
-        if (!receiveContext.endpoint().isNull()) {
-            endpoint = receiveContext.endpoint().value();
-        }
-    }
-
-    BSLS_ASSERT_OPT(responseBlob->numDataBuffers() == 1);
-    BSLS_ASSERT_OPT(responseBlob->numBuffers() == 1);
-
-    NTCDNS_CLIENT_SERVER_LOG_RECEIVE_BYTES(responseBlob, endpoint);
-
-    ntcdns::Message response(d_allocator_p);
-
-    ntcdns::MemoryDecoder decoder(
-        reinterpret_cast<bsl::uint8_t*>(responseBlob->buffer(0).data()),
-        responseBlob->length());
-
-    error = response.decode(&decoder);
-    if (error) {
-        NTCDNS_CLIENT_OPERATION_LOG_DECODE_FAILURE(error);
-        return;
-    }
-
-    NTCDNS_CLIENT_OPERATION_LOG_RECEIVE_OBJECT(response, endpoint);
-
-    bsl::shared_ptr<ntcdns::ClientOperation> operation;
-    if (!d_operationMap.remove(&operation, response.id())) {
-        NTCDNS_CLIENT_OPERATION_LOG_UNEXPECTED_RESPONSE(response, endpoint);
-        return;
-    }
-
-    bool tryNextServer = false;
-
-    if (response.error() == ntcdns::Error::e_OK) {
-        operation->processResponse(response,
-                                   d_endpoint,
-                                   d_index,
-                                   datagramSocket->currentTime());
-    }
-    else if (response.tc()) {
-        // MRM: If truncated, try on TCP socket.
-    }
-    else {
-        if (response.error() == ntcdns::Error::e_NAME_ERROR) {
-            // MRM: Name was not found on this name server. Try again with a
-            // different name prefixed with the next scope.
-
-            if (operation->tryNextSearch()) {
-                bsl::uint16_t transactionId =
-                    ClientNameServer::Impl::generateTransactionId();
-
-                if (!d_operationMap.add(transactionId, operation)) {
-                    operation->processError(
-                        ntsa::Error(ntsa::Error::e_INVALID));
-                    return;
-                }
-
-                error = operation->sendRequest(datagramSocket,
-                                               d_endpoint,
-                                               transactionId);
-                if (error) {
-                    d_operationMap.remove(transactionId);
-                    tryNextServer = true;
-                }
-            }
-            else {
-                tryNextServer = true;
-            }
-        }
-        else if (response.error() == ntcdns::Error::e_REFUSED ||
-                 response.error() == ntcdns::Error::e_SERVER_FAILURE ||
-                 response.error() == ntcdns::Error::e_NOT_IMPLEMENTED)
-        {
-            tryNextServer = true;
-        }
-        else if (response.error() == ntcdns::Error::e_FORMAT_ERROR) {
-            operation->processError(ntsa::Error(ntsa::Error::e_INVALID));
+        if (error) {
+            if (error != ntsa::Error(ntsa::Error::e_EOF)) {
+                NTCDNS_CLIENT_SERVER_LOG_RECEIVE_FAILURE(error);
+            }
+            return;
         }
-        else {
-            operation->processError(ntsa::Error(ntsa::Error::e_INVALID));
+
+        if (!receiveContext.endpoint().isNull()) {
+            endpoint = receiveContext.endpoint().value();
         }
     }
 
-    if (tryNextServer) {
-        while (true) {
-            bsl::shared_ptr<ntcdns::ClientNameServer> nameServer =
-                operation->tryNextServer();
+    BSLS_ASSERT_OPT(responseBlob->numDataBuffers() == 1);
+    BSLS_ASSERT_OPT(responseBlob->numBuffers() == 1);
 
-            if (nameServer) {
-                error = nameServer->initiate(operation);
-                if (error) {
-                    continue;
-                }
-                else {
-                    break;
-                }
-            }
-            else {
-                operation->processError(ntsa::Error(ntsa::Error::e_EOF));
-                break;
-            }
-        }
+    NTCDNS_CLIENT_SERVER_LOG_RECEIVE_BYTES(responseBlob, endpoint);
+
+    ntcdns::MessageView response;
+
+    error = response.decode(
+        reinterpret_cast<const bsl::uint8_t*>(responseBlob->buffer(0).data()),
+        static_cast<bsl::size_t>(responseBlob->length()));
+    if (error) {
+        NTCDNS_CLIENT_OPERATION_LOG_DECODE_FAILURE(error);
+        return;
+    }
+
+    NTCDNS_CLIENT_OPERATION_LOG_RECEIVE_OBJECT(response, endpoint);
+
+    bsl::shared_ptr<ntcdns::ClientOperation> operation;
+    if (!d_operationMap.remove(&operation, response.id())) {
+        NTCDNS_CLIENT_OPERATION_LOG_UNEXPECTED_RESPONSE(response, endpoint);
+        return;
     }
+
+    this->processResponse(operation,
+                          response,
+                          datagramSocket->currentTime(),
+                          false);
 }
 
 void ClientNameServer::processReadQueueHighWatermark(
@@ -1137,8 +1530,120 @@ void ClientNameServer::processReadQueueLowWatermark(
     const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
     const ntca::ReadQueueEvent&                event)
 {
-    NTCCFG_WARNING_UNUSED(streamSocket);
     NTCCFG_WARNING_UNUSED(event);
+
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    const ntsa::Endpoint& endpoint = d_endpoint;
+
+    // Each message is preceded by its length. Alternate between reading the
+    // length and reading the message, and wait for the read queue to fill
+    // to the required size whenever not enough data is yet available.
+
+    while (true) {
+        bsl::size_t size = d_streamResponseSize;
+        if (size == 0) {
+            size = k_TCP_LENGTH_PREFIX_SIZE;
+        }
+
+        bsl::shared_ptr<bdlbb::Blob> responseBlob =
+            streamSocket->createIncomingBlob();
+
+        ntca::ReceiveContext receiveContext;
+        ntca::ReceiveOptions receiveOptions;
+        receiveOptions.setSize(size);
+
+        error = streamSocket->receive(&receiveContext,
+                                      responseBlob.get(),
+                                      receiveOptions);
+        if (error) {
+            if (error == ntsa::Error(ntsa::Error::e_WOULD_BLOCK)) {
+                streamSocket->setReadQueueLowWatermark(size);
+            }
+            else if (error != ntsa::Error(ntsa::Error::e_EOF)) {
+                NTCDNS_CLIENT_SERVER_LOG_RECEIVE_FAILURE(error);
+            }
+            return;
+        }
+
+        if (d_streamResponseSize == 0) {
+            bsl::uint8_t prefix[k_TCP_LENGTH_PREFIX_SIZE];
+            bdlbb::BlobUtil::copy(reinterpret_cast<char*>(prefix),
+                                  *responseBlob,
+                                  0,
+                                  static_cast<int>(sizeof prefix));
+
+            d_streamResponseSize =
+                (static_cast<bsl::size_t>(prefix[0]) << 8) |
+                (static_cast<bsl::size_t>(prefix[1]) << 0);
+
+            if (d_streamResponseSize == 0) {
+                NTCDNS_CLIENT_OPERATION_LOG_DECODE_FAILURE(
+                    ntsa::Error(ntsa::Error::e_INVALID));
+                streamSocket->shutdown(ntsa::ShutdownType::e_BOTH,
+                                       ntsa::ShutdownMode::e_IMMEDIATE);
+                return;
+            }
+
+            continue;
+        }
+
+        d_streamResponseSize = 0;
+
+        NTCDNS_CLIENT_SERVER_LOG_RECEIVE_BYTES(responseBlob, endpoint);
+
+        // Decode the message in place if it was received into a single
+        // buffer, otherwise gather it into a buffer reused across messages.
+
+        const bsl::uint8_t* data = 0;
+
+        if (responseBlob->numDataBuffers() == 1) {
+            data = reinterpret_cast<const bsl::uint8_t*>(
+                responseBlob->buffer(0).data());
+        }
+        else {
+            d_streamResponseBuffer.resize(size);
+            bdlbb::BlobUtil::copy(
+                reinterpret_cast<char*>(&d_streamResponseBuffer.front()),
+                *responseBlob,
+                0,
+                static_cast<int>(size));
+            data = &d_streamResponseBuffer.front();
+        }
+
+        ntcdns::MessageView response;
+
+        error = response.decode(data, size);
+        if (error) {
+            NTCDNS_CLIENT_OPERATION_LOG_DECODE_FAILURE(error);
+            continue;
+        }
+
+        NTCDNS_CLIENT_OPERATION_LOG_RECEIVE_OBJECT(response, endpoint);
+
+        bsl::shared_ptr<ntcdns::ClientOperation> operation;
+        if (!d_streamOperationMap.remove(&operation, response.id())) {
+            NTCDNS_CLIENT_OPERATION_LOG_UNEXPECTED_RESPONSE(response,
+                                                            endpoint);
+            continue;
+        }
+
+        this->processResponse(operation,
+                              response,
+                              streamSocket->currentTime(),
+                              true);
+
+        if (d_streamOperationMap.empty() && d_streamOperationQueue.empty()) {
+            LockGuard streamSocketLock(&d_streamSocketMutex);
+
+            if (streamSocket == d_streamSocket_sp && d_streamIdleTimer_sp) {
+                d_streamIdleTimer_sp->schedule(streamSocket->currentTime() +
+                                               d_streamIdleTimeout);
+            }
+        }
+    }
 }
 
 void ClientNameServer::processReadQueueHighWatermark(
@@ -1156,7 +1661,7 @@ void ClientNameServer::processWriteQueueLowWatermark(
     NTCCFG_WARNING_UNUSED(streamSocket);
     NTCCFG_WARNING_UNUSED(event);
 
-    this->flush();
+    this->flushStream();
 }
 
 void ClientNameServer::processWriteQueueHighWatermark(
@@ -1197,24 +1702,35 @@ void ClientNameServer::processShutdownComplete(
 {
     NTCCFG_WARNING_UNUSED(event);
 
-    ntccfg::ConditionMutexGuard stateSocketLock(&d_stateMutex);
+    bool failFlag = false;
 
-    LockGuard datagramSocketLock(&d_datagramSocketMutex);
+    {
+        ntccfg::ConditionMutexGuard stateSocketLock(&d_stateMutex);
 
-    LockGuard streamSocketLock(&d_streamSocketMutex);
+        LockGuard datagramSocketLock(&d_datagramSocketMutex);
 
-    if (streamSocket == d_streamSocket_sp) {
-        d_streamSocket_sp->registerSession(
-            bsl::shared_ptr<ntci::StreamSocketSession>());
-        d_streamSocket_sp.reset();
+        LockGuard streamSocketLock(&d_streamSocketMutex);
 
-        if (!d_datagramSocket_sp && !d_streamSocket_sp) {
-            if (d_state == e_STATE_STOPPING) {
-                d_state = e_STATE_STOPPED;
-                d_stateCondition.signal();
+        if (streamSocket == d_streamSocket_sp) {
+            this->closeStreamSocket();
+
+            if (!d_datagramSocket_sp && !d_streamSocket_sp) {
+                if (d_state == e_STATE_STOPPING) {
+                    d_state = e_STATE_STOPPED;
+                    d_stateCondition.signal();
+                }
             }
+
+            failFlag = d_state == e_STATE_STARTED;
         }
     }
+
+    // The name server closed the connection, or the connection failed,
+    // while requests may still be outstanding on it.
+
+    if (failFlag) {
+        this->failStreamOperations();
+    }
 }
 
 void ClientNameServer::processError(
@@ -1337,7 +1853,15 @@ ntsa::Error ClientNameServer::createStreamSocket()
         return ntsa::Error(ntsa::Error::e_INVALID);
     }
 
-    streamSocketOptions.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+    if (d_endpoint.isLocal()) {
+        streamSocketOptions.setTransport(ntsa::Transport::e_LOCAL_STREAM);
+    }
+    else if (d_endpoint.ip().host().isV6()) {
+        streamSocketOptions.setTransport(ntsa::Transport::e_TCP_IPV6_STREAM);
+    }
+    else {
+        streamSocketOptions.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+    }
 
     bsl::shared_ptr<ntci::StreamSocket> streamSocket =
         d_streamSocketFactory_sp->createStreamSocket(streamSocketOptions,
@@ -1345,100 +1869,281 @@ ntsa::Error ClientNameServer::createStreamSocket()
 
     error = streamSocket->registerSession(self);
     if (error) {
+        streamSocket->close();
         return error;
     }
 
     error = streamSocket->open();
     if (error) {
+        streamSocket->close();
+        return error;
+    }
+
+    ntca::ConnectOptions connectOptions;
+
+    ntci::ConnectCallback connectCallback =
+        streamSocket->createConnectCallback(
+            bdlf::BindUtil::bind(
+                &ClientNameServer::processStreamSocketConnected,
+                self,
+                streamSocket,
+                bdlf::PlaceHolders::_1,
+                bdlf::PlaceHolders::_2),
+            d_allocator_p);
+
+    error = streamSocket->connect(d_endpoint, connectOptions, connectCallback);
+    if (error) {
+        streamSocket->close();
         return error;
     }
 
-    ntca::ConnectOptions connectOptions;
-
-    ntci::ConnectCallback connectCallback =
-        streamSocket->createConnectCallback(
-            bdlf::BindUtil::bind(
-                &ClientNameServer::processStreamSocketConnected,
-                self,
-                streamSocket,
-                bdlf::PlaceHolders::_1,
-                bdlf::PlaceHolders::_2),
-            d_allocator_p);
-
-    error = streamSocket->connect(d_endpoint, connectOptions, connectCallback);
-    if (error) {
-        return error;
+    return ntsa::Error();
+}
+
+void ClientNameServer::processDatagramSocketConnected(
+    const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket,
+    const bsl::shared_ptr<ntci::Connector>&      connector,
+    const ntca::ConnectEvent&                    event)
+{
+    NTCCFG_WARNING_UNUSED(connector);
+
+    ntsa::Error error;
+
+    bsl::shared_ptr<ClientNameServer> self = this->getSelf(this);
+
+    if (event.context().error()) {
+        // MRM
+        return;
+    }
+
+    LockGuard datagramSocketLock(&d_datagramSocketMutex);
+
+    d_datagramSocket_sp = datagramSocket;
+
+    error = d_datagramSocket_sp->relaxFlowControl(
+        ntca::FlowControlType::e_RECEIVE);
+    if (error) {
+        d_datagramSocket_sp->close();
+        d_datagramSocket_sp.reset();
+        return;
+    }
+
+    this->flush();
+}
+
+void ClientNameServer::processStreamSocketConnected(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const bsl::shared_ptr<ntci::Connector>&    connector,
+    const ntca::ConnectEvent&                  event)
+{
+    NTCCFG_WARNING_UNUSED(connector);
+
+    ntsa::Error error;
+
+    bsl::shared_ptr<ClientNameServer> self = this->getSelf(this);
+
+    {
+        LockGuard streamSocketLock(&d_streamSocketMutex);
+
+        d_streamConnecting = false;
+
+        if (!event.context().error()) {
+            d_streamSocket_sp    = streamSocket;
+            d_streamResponseSize = 0;
+
+            error = d_streamSocket_sp->setReadQueueLowWatermark(
+                k_TCP_LENGTH_PREFIX_SIZE);
+            if (!error) {
+                error = d_streamSocket_sp->relaxFlowControl(
+                    ntca::FlowControlType::e_RECEIVE);
+            }
+
+            if (!error) {
+                ntca::TimerOptions timerOptions;
+                timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+                timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+
+                ntci::TimerCallback timerCallback =
+                    d_streamSocket_sp->createTimerCallback(
+                        bdlf::BindUtil::bind(
+                            &ClientNameServer::processStreamSocketIdle,
+                            self,
+                            bdlf::PlaceHolders::_1,
+                            bdlf::PlaceHolders::_2),
+                        d_allocator_p);
+
+                d_streamIdleTimer_sp = d_streamSocket_sp->createTimer(
+                    timerOptions,
+                    timerCallback,
+                    d_allocator_p);
+            }
+            else {
+                this->closeStreamSocket();
+            }
+        }
+        else {
+            streamSocket->registerSession(
+                bsl::shared_ptr<ntci::StreamSocketSession>());
+            streamSocket->close();
+            error = event.context().error();
+        }
+    }
+
+    if (error) {
+        this->failStreamOperations();
+        return;
+    }
+
+    this->flushStream();
+}
+
+void ClientNameServer::processStreamSocketIdle(
+    const bsl::shared_ptr<ntci::Timer>& timer,
+    const ntca::TimerEvent&             event)
+{
+    if (event.type() != ntca::TimerEventType::e_DEADLINE) {
+        return;
+    }
+
+    LockGuard streamSocketLock(&d_streamSocketMutex);
+
+    if (timer != d_streamIdleTimer_sp) {
+        return;
+    }
+
+    if (!d_streamOperationMap.empty() || !d_streamOperationQueue.empty()) {
+        return;
+    }
+
+    if (d_streamSocket_sp) {
+        d_streamSocket_sp->shutdown(ntsa::ShutdownType::e_BOTH,
+                                    ntsa::ShutdownMode::e_GRACEFUL);
+    }
+
+    this->closeStreamSocket();
+}
+
+void ClientNameServer::processResponse(
+    const bsl::shared_ptr<ntcdns::ClientOperation>& operation,
+    const ntcdns::MessageView&                      response,
+    const bsls::TimeInterval&                       now,
+    bool                                            stream)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    bool tryNextServer = false;
+
+    if (response.tc() || response.error() != ntcdns::Error::e_OK) {
+        // If the operation has been hedged to another name server, let that
+        // name server answer rather than retry or fail over from this one.
+
+        if (operation->currentServer().get() != this) {
+            NTCDNS_CLIENT_SERVER_LOG_HEDGED_RESPONSE(response, d_endpoint);
+            return;
+        }
+    }
+
+    if (response.tc() && !stream) {
+        // The response was truncated to fit in a UDP datagram: retry the
+        // request over TCP to the same name server.
+
+        error = this->initiateStream(operation);
+        if (error) {
+            tryNextServer = true;
+        }
+    }
+    else if (response.error() == ntcdns::Error::e_OK) {
+        operation->processResponse(response, d_endpoint, d_index, now);
+    }
+    else {
+        if (response.error() == ntcdns::Error::e_NAME_ERROR) {
+            // MRM: Name was not found on this name server. Try again with a
+            // different name prefixed with the next scope.
+
+            if (operation->tryNextSearch()) {
+                if (stream) {
+                    error = this->initiateStream(operation);
+                    if (error) {
+                        tryNextServer = true;
+                    }
+                }
+                else {
+                    d_operationQueue.push(operation);
+                    this->flush();
+                }
+            }
+            else {
+                tryNextServer = true;
+            }
+        }
+        else if (response.error() == ntcdns::Error::e_REFUSED ||
+                 response.error() == ntcdns::Error::e_SERVER_FAILURE ||
+                 response.error() == ntcdns::Error::e_NOT_IMPLEMENTED)
+        {
+            tryNextServer = true;
+        }
+        else if (response.error() == ntcdns::Error::e_FORMAT_ERROR) {
+            operation->processError(ntsa::Error(ntsa::Error::e_INVALID));
+        }
+        else {
+            operation->processError(ntsa::Error(ntsa::Error::e_INVALID));
+        }
+    }
+
+    if (tryNextServer) {
+        ClientNameServer::Impl::tryNextServer(operation);
     }
-
-    return ntsa::Error();
 }
 
-void ClientNameServer::processDatagramSocketConnected(
-    const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket,
-    const bsl::shared_ptr<ntci::Connector>&      connector,
-    const ntca::ConnectEvent&                    event)
+void ClientNameServer::failStreamOperations()
 {
-    NTCCFG_WARNING_UNUSED(connector);
-
-    ntsa::Error error;
+    OperationVector operationVector(d_allocator_p);
 
-    bsl::shared_ptr<ClientNameServer> self = this->getSelf(this);
+    {
+        OperationMap operationMap(d_allocator_p);
+        operationMap.swap(&d_streamOperationMap);
 
-    if (event.context().error()) {
-        // MRM
-        return;
+        operationMap.values(&operationVector);
     }
 
-    LockGuard datagramSocketLock(&d_datagramSocketMutex);
-
-    d_datagramSocket_sp = datagramSocket;
+    {
+        OperationQueue operationQueue(d_allocator_p);
+        operationQueue.swap(&d_streamOperationQueue);
 
-    error = d_datagramSocket_sp->relaxFlowControl(
-        ntca::FlowControlType::e_RECEIVE);
-    if (error) {
-        d_datagramSocket_sp->close();
-        d_datagramSocket_sp.reset();
-        return;
+        operationQueue.load(&operationVector);
     }
 
-    this->flush();
+    for (OperationVector::iterator it = operationVector.begin();
+         it != operationVector.end();
+         ++it)
+    {
+        ClientNameServer::Impl::tryNextServer(*it);
+    }
 }
 
-void ClientNameServer::processStreamSocketConnected(
-    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
-    const bsl::shared_ptr<ntci::Connector>&    connector,
-    const ntca::ConnectEvent&                  event)
+void ClientNameServer::closeStreamSocket()
 {
-    NTCCFG_WARNING_UNUSED(connector);
-
-    ntsa::Error error;
-
-    bsl::shared_ptr<ClientNameServer> self = this->getSelf(this);
-
-    if (event.context().error()) {
-        // MRM
-        return;
+    if (d_streamIdleTimer_sp) {
+        d_streamIdleTimer_sp->close();
+        d_streamIdleTimer_sp.reset();
     }
 
-    LockGuard streamSocketLock(&d_streamSocketMutex);
-
-    d_streamSocket_sp = streamSocket;
-
-    error =
-        d_streamSocket_sp->relaxFlowControl(ntca::FlowControlType::e_RECEIVE);
-    if (error) {
+    if (d_streamSocket_sp) {
+        d_streamSocket_sp->registerSession(
+            bsl::shared_ptr<ntci::StreamSocketSession>());
         d_streamSocket_sp->close();
         d_streamSocket_sp.reset();
-        return;
     }
-
-    this->flush();
 }
 
 void ClientNameServer::flush()
 {
     ntsa::Error error;
 
+    bsl::shared_ptr<ClientNameServer> self = this->getSelf(this);
+
     bsl::shared_ptr<ntcdns::ClientOperation> operation;
     while (d_operationQueue.pop(&operation)) {
         bsl::uint16_t transactionId =
@@ -1453,27 +2158,112 @@ void ClientNameServer::flush()
                                        transactionId);
         if (error) {
             d_operationMap.remove(transactionId);
+            ClientNameServer::Impl::tryNextServer(operation);
+        }
+        else {
+            operation->processRequestSent(self,
+                                          d_datagramSocket_sp,
+                                          d_datagramSocket_sp->currentTime());
+        }
+    }
+}
+
+void ClientNameServer::flushStream()
+{
+    ntsa::Error error;
 
-            while (true) {
-                bsl::shared_ptr<ntcdns::ClientNameServer> nameServer =
-                    operation->tryNextServer();
+    OperationVector failedOperationVector(d_allocator_p);
+    OperationVector sentOperationVector(d_allocator_p);
 
-                if (nameServer) {
-                    error = nameServer->initiate(operation);
-                    if (error) {
-                        continue;
-                    }
-                    else {
-                        break;
-                    }
-                }
-                else {
-                    operation->processError(ntsa::Error(ntsa::Error::e_EOF));
-                    break;
-                }
+    bsl::shared_ptr<ClientNameServer>   self = this->getSelf(this);
+    bsl::shared_ptr<ntci::StreamSocket> streamSocket;
+
+    {
+        LockGuard streamSocketLock(&d_streamSocketMutex);
+
+        if (!d_streamSocket_sp) {
+            return;
+        }
+
+        streamSocket = d_streamSocket_sp;
+
+        bsl::shared_ptr<ntcdns::ClientOperation> operation;
+        while (d_streamOperationQueue.pop(&operation)) {
+            bsl::uint16_t transactionId =
+                ClientNameServer::Impl::generateTransactionId();
+
+            if (!d_streamOperationMap.add(transactionId, operation)) {
+                failedOperationVector.push_back(operation);
+                continue;
+            }
+
+            error = operation->sendRequest(d_streamSocket_sp,
+                                           d_endpoint,
+                                           transactionId);
+            if (error) {
+                d_streamOperationMap.remove(transactionId);
+                failedOperationVector.push_back(operation);
+            }
+            else {
+                sentOperationVector.push_back(operation);
+            }
+        }
+
+        if (d_streamIdleTimer_sp) {
+            d_streamIdleTimer_sp->cancel();
+        }
+    }
+
+    if (!sentOperationVector.empty()) {
+        const bsls::TimeInterval now = streamSocket->currentTime();
+
+        for (OperationVector::iterator it = sentOperationVector.begin();
+             it != sentOperationVector.end();
+             ++it)
+        {
+            (*it)->processRequestSent(self, streamSocket, now);
+        }
+    }
+
+    for (OperationVector::iterator it = failedOperationVector.begin();
+         it != failedOperationVector.end();
+         ++it)
+    {
+        ClientNameServer::Impl::tryNextServer(*it);
+    }
+}
+
+ntsa::Error ClientNameServer::initiateStream(
+    const bsl::shared_ptr<ntcdns::ClientOperation>& operation)
+{
+    ntsa::Error error;
+
+    bool flushFlag = false;
+
+    {
+        LockGuard streamSocketLock(&d_streamSocketMutex);
+
+        d_streamOperationQueue.push(operation);
+
+        if (d_streamSocket_sp) {
+            flushFlag = true;
+        }
+        else if (!d_streamConnecting) {
+            error = this->createStreamSocket();
+            if (error) {
+                d_streamOperationQueue.remove(operation);
+                return error;
             }
+
+            d_streamConnecting = true;
         }
     }
+
+    if (flushFlag) {
+        this->flushStream();
+    }
+
+    return ntsa::Error();
 }
 
 ClientNameServer::ClientNameServer(
@@ -1489,9 +2279,19 @@ ClientNameServer::ClientNameServer(
 , d_datagramSocketMutex()
 , d_datagramSocket_sp()
 , d_datagramSocketFactory_sp(datagramSocketFactory)
+, d_streamOperationQueue(basicAllocator)
+, d_streamOperationMap(basicAllocator)
 , d_streamSocketMutex()
 , d_streamSocket_sp()
 , d_streamSocketFactory_sp(streamSocketFactory)
+, d_streamIdleTimer_sp()
+, d_streamConnecting(false)
+, d_streamResponseSize(0)
+, d_streamResponseBuffer(basicAllocator)
+, d_streamIdleTimeout(k_TCP_IDLE_TIMEOUT)
+, d_latencyMutex()
+, d_latencyList(basicAllocator)
+, d_latencyCount(0)
 , d_stateMutex()
 , d_stateCondition()
 , d_state(e_STATE_STOPPED)
@@ -1503,6 +2303,11 @@ ClientNameServer::ClientNameServer(
     BSLS_ASSERT_OPT(d_datagramSocketFactory_sp);
     BSLS_ASSERT_OPT(d_streamSocketFactory_sp);
     BSLS_ASSERT_OPT(!d_endpoint.isUndefined());
+
+    if (!d_config.idleTimeout().isNull()) {
+        d_streamIdleTimeout.setTotalMilliseconds(
+            d_config.idleTimeout().value());
+    }
 }
 
 ClientNameServer::~ClientNameServer()
@@ -1546,6 +2351,10 @@ ntsa::Error ClientNameServer::initiate(
         return ntsa::Error(ntsa::Error::e_INVALID);
     }
 
+    if (d_config.useVc().valueOr(false)) {
+        return this->initiateStream(operation);
+    }
+
     bool flushFlag = false;
 
     d_operationQueue.push(operation);
@@ -1578,6 +2387,10 @@ void ClientNameServer::cancel(
         d_operationQueue.remove(operation);
     }
 
+    if (!d_streamOperationMap.removeValue(operation)) {
+        d_streamOperationQueue.remove(operation);
+    }
+
     operation->processError(ntsa::Error(ntsa::Error::e_CANCELLED));
 }
 
@@ -1599,6 +2412,20 @@ void ClientNameServer::cancelAll()
         operationQueue.load(&operationVector);
     }
 
+    {
+        OperationMap operationMap(d_allocator_p);
+        operationMap.swap(&d_streamOperationMap);
+
+        operationMap.values(&operationVector);
+    }
+
+    {
+        OperationQueue operationQueue(d_allocator_p);
+        operationQueue.swap(&d_streamOperationQueue);
+
+        operationQueue.load(&operationVector);
+    }
+
     for (OperationVector::iterator it = operationVector.begin();
          it != operationVector.end();
          ++it)
@@ -1614,12 +2441,19 @@ void ClientNameServer::abandon(
     if (!d_operationMap.removeValue(operation)) {
         d_operationQueue.remove(operation);
     }
+
+    if (!d_streamOperationMap.removeValue(operation)) {
+        d_streamOperationQueue.remove(operation);
+    }
 }
 
 void ClientNameServer::abandonAll()
 {
     d_operationMap.clear();
     d_operationQueue.clear();
+
+    d_streamOperationMap.clear();
+    d_streamOperationQueue.clear();
 }
 
 void ClientNameServer::shutdown()
@@ -1654,6 +2488,11 @@ void ClientNameServer::shutdown()
         }
 
         if (d_streamSocket_sp) {
+            if (d_streamIdleTimer_sp) {
+                d_streamIdleTimer_sp->close();
+                d_streamIdleTimer_sp.reset();
+            }
+
             d_streamSocket_sp->shutdown(ntsa::ShutdownType::e_BOTH,
                                         ntsa::ShutdownMode::e_IMMEDIATE);
             d_streamSocket_sp->close();
@@ -1674,6 +2513,9 @@ void ClientNameServer::linger()
     d_operationMap.clear();
     d_operationQueue.clear();
 
+    d_streamOperationMap.clear();
+    d_streamOperationQueue.clear();
+
     d_datagramSocket_sp.reset();
     d_streamSocket_sp.reset();
 
@@ -1683,13 +2525,83 @@ void ClientNameServer::linger()
     NTCDNS_CLIENT_SERVER_LOG_STOPPED(d_index, d_endpoint);
 }
 
+void ClientNameServer::recordLatency(const bsls::TimeInterval& latency)
+{
+    LockGuard lock(&d_latencyMutex);
+
+    if (d_latencyList.size() < k_LATENCY_SAMPLE_CAPACITY) {
+        d_latencyList.push_back(latency);
+    }
+    else {
+        d_latencyList[d_latencyCount % k_LATENCY_SAMPLE_CAPACITY] = latency;
+    }
+
+    ++d_latencyCount;
+}
+
+bool ClientNameServer::estimateLatency(bsls::TimeInterval* result,
+                                       bsl::size_t         percentile) const
+{
+    bsl::vector<bsls::TimeInterval> latencyList(d_allocator_p);
+    {
+        LockGuard lock(&d_latencyMutex);
+
+        if (d_latencyList.size() < k_LATENCY_SAMPLE_MINIMUM) {
+            return false;
+        }
+
+        latencyList = d_latencyList;
+    }
+
+    if (percentile < 1) {
+        percentile = 1;
+    }
+    else if (percentile > 99) {
+        percentile = 99;
+    }
+
+    bsl::vector<bsls::TimeInterval>::iterator nth =
+        latencyList.begin() + (latencyList.size() * percentile) / 100;
+
+    bsl::nth_element(latencyList.begin(), nth, latencyList.end());
+
+    *result = *nth;
+    return true;
+}
+
+bool ClientNameServer::hedgeDelay(bsls::TimeInterval* result) const
+{
+    const unsigned int delay = d_config.hedgeDelay().valueOr(0);
+
+    if (!d_config.hedgePercentile().isNull()) {
+        if (this->estimateLatency(result, d_config.hedgePercentile().value()))
+        {
+            return true;
+        }
+    }
+
+    if (delay == 0) {
+        return false;
+    }
+
+    result->setTotalMilliseconds(delay);
+    return true;
+}
+
 const ntsa::Endpoint& ClientNameServer::endpoint() const
 {
     return d_endpoint;
 }
 
+bsl::size_t ClientNameServer::index() const
+{
+    return d_index;
+}
+
 const ntsa::Port Client::k_DNS_PORT = 53;
 
+const bsl::size_t Client::k_GET_IP_ADDRESS_OPERATION_LIMIT = 64;
+
 ntsa::Error Client::initialize()
 {
     NTCI_LOG_CONTEXT();
@@ -1761,6 +2673,37 @@ ntsa::Error Client::initialize()
     return ntsa::Error();
 }
 
+void Client::rankServerList(ServerList* result) const
+{
+    typedef bsl::pair<bsls::TimeInterval, bsl::size_t> Rank;
+
+    bsl::vector<Rank>        rankList(d_allocator_p);
+    bsl::vector<bsl::size_t> unknownList(d_allocator_p);
+
+    for (bsl::size_t i = 0; i < d_serverList.size(); ++i) {
+        bsls::TimeInterval latency;
+        if (d_serverList[i]->estimateLatency(&latency, 50)) {
+            rankList.push_back(Rank(latency, i));
+        }
+        else {
+            unknownList.push_back(i);
+        }
+    }
+
+    bsl::sort(rankList.begin(), rankList.end());
+
+    result->clear();
+    result->reserve(d_serverList.size());
+
+    for (bsl::size_t i = 0; i < rankList.size(); ++i) {
+        result->push_back(d_serverList[rankList[i].second]);
+    }
+
+    for (bsl::size_t i = 0; i < unknownList.size(); ++i) {
+        result->push_back(d_serverList[unknownList[i]]);
+    }
+}
+
 Client::Client(
     const ntcdns::ClientConfig&                         configuration,
     const bsl::shared_ptr<ntcdns::Cache>&               cache,
@@ -1773,6 +2716,10 @@ Client::Client(
 , d_streamSocketFactory_sp(streamSocketFactory)
 , d_cache_sp(cache)
 , d_serverList(basicAllocator)
+, d_getIpAddressOperationMap(basicAllocator)
+, d_getIpAddressOperationLimit(k_GET_IP_ADDRESS_OPERATION_LIMIT)
+, d_numGetIpAddressIssued(0)
+, d_numGetIpAddressCoalesced(0)
 , d_state(e_STATE_STOPPED)
 , d_initialized(false)
 , d_config(configuration, basicAllocator)
@@ -1866,6 +2813,7 @@ void Client::linger()
     }
 
     d_serverList.clear();
+    d_getIpAddressOperationMap.clear();
     d_initialized = false;
 
     // MRM: d_datagramSocketFactory_sp.reset();
@@ -1934,18 +2882,60 @@ ntsa::Error Client::getIpAddress(
         }
     }
 
+    // Join an operation already in progress for the same name and type of
+    // IP address, if any, so that concurrent lookups share one query. The
+    // deadline is deliberately not part of the key: it differs for every
+    // connecting caller and is enforced by each caller's own connect timer.
+
+    bdlb::NullableValue<ntsa::IpAddressType::Value> ipAddressType;
+    error = ntcdns::Compat::convert(&ipAddressType, options);
+    if (error) {
+        return error;
+    }
+
+    const GetIpAddressKey key(name,
+                              ipAddressType.isNull()
+                                  ? ntsa::IpAddressType::e_UNDEFINED
+                                  : ipAddressType.value());
+
+    GetIpAddressOperationMap::iterator it =
+        d_getIpAddressOperationMap.find(key);
+
+    if (it != d_getIpAddressOperationMap.end()) {
+        bsl::shared_ptr<ntcdns::ClientGetIpAddressOperation> operation =
+            it->second.lock();
+        if (operation && operation->join(resolver, options, callback)) {
+            ++d_numGetIpAddressCoalesced;
+            return ntsa::Error();
+        }
+    }
+
+    // When hedging queries, try the name servers observed to be fastest
+    // first, so that the slowest are only raced when the fastest stall.
+
+    ServerList serverList(d_allocator_p);
+
+    if (d_config.hedgeDelay().valueOr(0) > 0 ||
+        !d_config.hedgePercentile().isNull())
+    {
+        this->rankServerList(&serverList);
+    }
+    else {
+        serverList = d_serverList;
+    }
+
     bsl::shared_ptr<ntcdns::ClientGetIpAddressOperation> operation;
     operation.createInplace(d_allocator_p,
                             resolver,
                             name,
-                            d_serverList,
+                            serverList,
                             searchList,
                             options,
                             callback,
                             d_cache_sp,
                             d_allocator_p);
 
-    bsl::shared_ptr<ntcdns::ClientNameServer> server = d_serverList.front();
+    bsl::shared_ptr<ntcdns::ClientNameServer> server = serverList.front();
 
     error = server->initiate(operation);
     if (error) {
@@ -1968,6 +2958,29 @@ ntsa::Error Client::getIpAddress(
         }
     }
 
+    // Purge the operations that have completed once the map grows to twice
+    // its size after the last purge, so the cost is amortized per lookup.
+
+    if (d_getIpAddressOperationMap.size() >= d_getIpAddressOperationLimit) {
+        GetIpAddressOperationMap::iterator current =
+            d_getIpAddressOperationMap.begin();
+        while (current != d_getIpAddressOperationMap.end()) {
+            if (current->second.expired()) {
+                current = d_getIpAddressOperationMap.erase(current);
+            }
+            else {
+                ++current;
+            }
+        }
+
+        d_getIpAddressOperationLimit =
+            bsl::max(k_GET_IP_ADDRESS_OPERATION_LIMIT,
+                     2 * d_getIpAddressOperationMap.size());
+    }
+
+    d_getIpAddressOperationMap[key] = operation;
+    ++d_numGetIpAddressIssued;
+
     return ntsa::Error();
 }
 
@@ -2028,5 +3041,15 @@ ntsa::Error Client::getDomainName(
     return ntsa::Error();
 }
 
+bsl::uint64_t Client::numGetIpAddressIssued() const
+{
+    return d_numGetIpAddressIssued.load();
+}
+
+bsl::uint64_t Client::numGetIpAddressCoalesced() const
+{
+    return d_numGetIpAddressCoalesced.load();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
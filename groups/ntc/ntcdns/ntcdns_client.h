@@ -52,8 +52,10 @@
 #include <bsl_functional.h>
 #include <bsl_iosfwd.h>
 #include <bsl_list.h>
+#include <bsl_map.h>
 #include <bsl_memory.h>
 #include <bsl_string.h>
+#include <bsl_utility.h>
 #include <bsl_unordered_map.h>
 #include <bsl_unordered_set.h>
 #include <bsl_vector.h>
@@ -104,10 +106,10 @@ class ClientOperation
     /// Invoke the response callback with the contents of the specified
     /// 'response' received from the specified 'endpoint' at the specified
     /// 'serverIndex'.
-    virtual void processResponse(const ntcdns::Message&    response,
-                                 const ntsa::Endpoint&     endpoint,
-                                 bsl::size_t               serverIndex,
-                                 const bsls::TimeInterval& now) = 0;
+    virtual void processResponse(const ntcdns::MessageView& response,
+                                 const ntsa::Endpoint&      endpoint,
+                                 bsl::size_t                serverIndex,
+                                 const bsls::TimeInterval&  now) = 0;
 
     /// Invoke the response callback with the specified 'error'.
     virtual void processError(const ntsa::Error& error) = 0;
@@ -120,9 +122,32 @@ class ClientOperation
     /// Return true if such a name exists, and false otherwise.
     virtual bool tryNextSearch() = 0;
 
+    /// Process the sending of a request to perform this operation to the
+    /// specified 'nameServer' at the specified 'now', scheduling any
+    /// timers using the specified 'timerFactory'. The default
+    /// implementation has no effect.
+    virtual void processRequestSent(
+        const bsl::shared_ptr<ntcdns::ClientNameServer>& nameServer,
+        const bsl::shared_ptr<ntci::TimerFactory>&       timerFactory,
+        const bsls::TimeInterval&                        now);
+
+    /// Return the name server currently targeted by this operation, or null
+    /// if the operation has completed.
+    virtual bsl::shared_ptr<ntcdns::ClientNameServer> currentServer()
+        const = 0;
+
   protected:
     // The maximum DNS payload size.
     static const bsl::size_t k_DNS_MAX_PAYLOAD_SIZE;
+
+    /// Encode the specified 'request' prefixed by its two-byte length, as
+    /// required for DNS messages carried over TCP, and send it through the
+    /// specified 'streamSocket' to the name server at the specified
+    /// 'endpoint'. Return the error.
+    static ntsa::Error sendStreamRequest(
+        const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+        const ntsa::Endpoint&                      endpoint,
+        const ntcdns::Message&                     request);
 };
 
 /// @internal @brief
@@ -153,17 +178,34 @@ class ClientGetIpAddressOperation
     /// Define a type alias for a mutex lock guard.
     typedef ntccfg::LockGuard LockGuard;
 
+    /// Describe a caller that joined the operation after it was initiated.
+    struct Waiter {
+        bsl::shared_ptr<ntci::Resolver> d_resolver_sp;
+        ntca::GetIpAddressOptions       d_options;
+        ntci::GetIpAddressCallback      d_callback;
+    };
+
+    /// Define a type alias for a list of callers that joined the operation.
+    typedef bsl::vector<Waiter> WaiterList;
+
+    /// Define a type alias for a list of the times at which a request was
+    /// last sent to each name server in the server list.
+    typedef bsl::vector<bsls::TimeInterval> SendTimeList;
+
     ntccfg::Object                  d_object;
     mutable Mutex                   d_mutex;
     bsl::shared_ptr<ntci::Resolver> d_resolver_sp;
     const bsl::string               d_name;
     ServerList                      d_serverList;
     bsl::size_t                     d_serverIndex;
+    SendTimeList                    d_sendTimeList;
     const SearchList                d_searchList;
     bsl::size_t                     d_searchIndex;
     const ntca::GetIpAddressOptions d_options;
     ntci::GetIpAddressCallback      d_callback;
+    WaiterList                      d_waiterList;
     bsl::shared_ptr<ntci::Timer>    d_timer_sp;
+    bsl::size_t                     d_numHedges;
     bsl::shared_ptr<ntcdns::Cache>  d_cache_sp;
     bsls::AtomicBool                d_pending;
     bslma::Allocator*               d_allocator_p;
@@ -174,6 +216,35 @@ class ClientGetIpAddressOperation
     ClientGetIpAddressOperation& operator=(const ClientGetIpAddressOperation&)
         BSLS_KEYWORD_DELETED;
 
+  private:
+    /// Apply the specified 'options' to a copy of the specified
+    /// 'ipAddressList' resolved in the specified 'context' and invoke the
+    /// specified 'callback' with the result on behalf of the specified
+    /// 'resolver'.
+    static void complete(const bsl::shared_ptr<ntci::Resolver>& resolver,
+                         const ntca::GetIpAddressOptions&       options,
+                         const ntci::GetIpAddressCallback&      callback,
+                         const bsl::vector<ntsa::IpAddress>&    ipAddressList,
+                         const ntca::GetIpAddressContext&       context);
+
+    /// Load into the specified 'result' the request for the current name
+    /// in the search list identified by the specified 'transactionId'.
+    /// Return the error.
+    ntsa::Error createRequest(ntcdns::Message* result,
+                              bsl::uint16_t    transactionId);
+
+    /// Process the expiration of the specified hedge 'timer' according to
+    /// the specified 'event': send a duplicate request to the next name
+    /// server, if any, without abandoning the request already sent.
+    void processHedgeTimer(const bsl::shared_ptr<ntci::Timer>& timer,
+                           const ntca::TimerEvent&             event);
+
+    /// Close the hedge timer, if any, and abandon this operation on each
+    /// name server to which it was sent other than the specified
+    /// 'nameServer', which answered it, if any.
+    void completeHedge(
+        const bsl::shared_ptr<ntcdns::ClientNameServer>& nameServer);
+
   public:
     /// Defines a type alias for a vector of endpoints.
     typedef bsl::vector<ntsa::Endpoint> EndpointList;
@@ -197,6 +268,15 @@ class ClientGetIpAddressOperation
     /// Destroy this object.
     ~ClientGetIpAddressOperation() BSLS_KEYWORD_OVERRIDE;
 
+    /// Join the specified 'callback' to this operation on behalf of the
+    /// specified 'resolver', so that it is invoked with the result of this
+    /// operation filtered and selected according to the specified
+    /// 'options'. Return true if the callback is joined, and false if this
+    /// operation has already completed.
+    bool join(const bsl::shared_ptr<ntci::Resolver>& resolver,
+              const ntca::GetIpAddressOptions&       options,
+              const ntci::GetIpAddressCallback&      callback);
+
     /// Send a request to perform this operation through the specified
     /// 'datagramSocket' to the name server at the specified 'endpoint'.
     /// Identify the request using the specified 'transactionId'. Return the
@@ -218,10 +298,10 @@ class ClientGetIpAddressOperation
     /// Invoke the response callback with the contents of the specified
     /// 'response' received from the specified 'endpoint' at the specified
     /// 'serverIndex'.
-    void processResponse(const ntcdns::Message&    response,
-                         const ntsa::Endpoint&     endpoint,
-                         bsl::size_t               serverIndex,
-                         const bsls::TimeInterval& now) BSLS_KEYWORD_OVERRIDE;
+    void processResponse(const ntcdns::MessageView& response,
+                         const ntsa::Endpoint&      endpoint,
+                         bsl::size_t                serverIndex,
+                         const bsls::TimeInterval&  now) BSLS_KEYWORD_OVERRIDE;
 
     /// Invoke the response callback with the specified 'error'.
     void processError(const ntsa::Error& error) BSLS_KEYWORD_OVERRIDE;
@@ -235,6 +315,21 @@ class ClientGetIpAddressOperation
     /// Return true if such a name exists, and false otherwise.
     bool tryNextSearch() BSLS_KEYWORD_OVERRIDE;
 
+    /// Process the sending of a request to perform this operation to the
+    /// specified 'nameServer' at the specified 'now': if that name server
+    /// is the one currently targeted and the client is configured to hedge
+    /// queries, schedule a timer using the specified 'timerFactory' after
+    /// which the request is also sent to the next name server.
+    void processRequestSent(
+        const bsl::shared_ptr<ntcdns::ClientNameServer>& nameServer,
+        const bsl::shared_ptr<ntci::TimerFactory>&       timerFactory,
+        const bsls::TimeInterval& now) BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the name server currently targeted by this operation, or null
+    /// if the operation has completed.
+    bsl::shared_ptr<ntcdns::ClientNameServer> currentServer() const
+        BSLS_KEYWORD_OVERRIDE;
+
     /// Return the name to resolve.
     const bsl::string& name() const;
 
@@ -246,6 +341,14 @@ class ClientGetIpAddressOperation
 
     /// Return the index of the current search domain being tried.
     bsl::size_t searchIndex() const;
+
+    /// Return the number of callers joined to this operation after it was
+    /// initiated.
+    bsl::size_t numWaiters() const;
+
+    /// Return the number of times a request for this operation was also
+    /// sent to the next name server before the previous one answered.
+    bsl::size_t numHedges() const;
 };
 
 /// @internal @brief
@@ -291,6 +394,13 @@ class ClientGetDomainNameOperation
     ClientGetDomainNameOperation& operator=(
         const ClientGetDomainNameOperation&) BSLS_KEYWORD_DELETED;
 
+  private:
+    /// Load into the specified 'result' the request for the domain name of
+    /// the IP address identified by the specified 'transactionId'. Return
+    /// the error.
+    ntsa::Error createRequest(ntcdns::Message* result,
+                              bsl::uint16_t    transactionId);
+
   public:
     /// Defines a type alias for a vector of endpoints.
     typedef bsl::vector<ntsa::Endpoint> EndpointList;
@@ -334,10 +444,10 @@ class ClientGetDomainNameOperation
     /// Invoke the response callback with the contents of the specified
     /// 'response' received from the specified 'endpoint' at the specified
     /// 'serverIndex'.
-    void processResponse(const ntcdns::Message&    response,
-                         const ntsa::Endpoint&     endpoint,
-                         bsl::size_t               serverIndex,
-                         const bsls::TimeInterval& now) BSLS_KEYWORD_OVERRIDE;
+    void processResponse(const ntcdns::MessageView& response,
+                         const ntsa::Endpoint&      endpoint,
+                         bsl::size_t                serverIndex,
+                         const bsls::TimeInterval&  now) BSLS_KEYWORD_OVERRIDE;
 
     /// Invoke the response callback with the specified 'error'.
     void processError(const ntsa::Error& error) BSLS_KEYWORD_OVERRIDE;
@@ -351,6 +461,11 @@ class ClientGetDomainNameOperation
     /// Return true if such a name exists, and false otherwise.
     bool tryNextSearch() BSLS_KEYWORD_OVERRIDE;
 
+    /// Return the name server currently targeted by this operation, or null
+    /// if the operation has completed.
+    bsl::shared_ptr<ntcdns::ClientNameServer> currentServer() const
+        BSLS_KEYWORD_OVERRIDE;
+
     /// Return the IP address to resolve.
     const ntsa::IpAddress& ipAddress() const;
 
@@ -408,9 +523,19 @@ class ClientNameServer : public ntci::DatagramSocketSession,
     Mutex                                        d_datagramSocketMutex;
     bsl::shared_ptr<ntci::DatagramSocket>        d_datagramSocket_sp;
     bsl::shared_ptr<ntci::DatagramSocketFactory> d_datagramSocketFactory_sp;
+    OperationQueue                               d_streamOperationQueue;
+    OperationMap                                 d_streamOperationMap;
     Mutex                                        d_streamSocketMutex;
     bsl::shared_ptr<ntci::StreamSocket>          d_streamSocket_sp;
     bsl::shared_ptr<ntci::StreamSocketFactory>   d_streamSocketFactory_sp;
+    bsl::shared_ptr<ntci::Timer>                 d_streamIdleTimer_sp;
+    bool                                         d_streamConnecting;
+    bsl::size_t                                  d_streamResponseSize;
+    bsl::vector<bsl::uint8_t>                    d_streamResponseBuffer;
+    bsls::TimeInterval                           d_streamIdleTimeout;
+    mutable Mutex                                d_latencyMutex;
+    bsl::vector<bsls::TimeInterval>              d_latencyList;
+    bsl::size_t                                  d_latencyCount;
     ntccfg::ConditionMutex                       d_stateMutex;
     ntccfg::Condition                            d_stateCondition;
     State                                        d_state;
@@ -422,6 +547,21 @@ class ClientNameServer : public ntci::DatagramSocketSession,
     /// The maximum UDP payload size.
     static const bsl::size_t k_UDP_MAX_PAYLOAD_SIZE;
 
+    /// The size of the length prefix of each DNS message sent over TCP.
+    static const bsl::size_t k_TCP_LENGTH_PREFIX_SIZE;
+
+    /// The default duration after which a TCP connection with no
+    /// outstanding requests is closed.
+    static const bsls::TimeInterval k_TCP_IDLE_TIMEOUT;
+
+    /// The maximum number of the most recent latencies retained to estimate
+    /// the latency of the name server.
+    static const bsl::size_t k_LATENCY_SAMPLE_CAPACITY;
+
+    /// The minimum number of latencies that must be observed before the
+    /// latency of the name server is estimated.
+    static const bsl::size_t k_LATENCY_SAMPLE_MINIMUM;
+
     class Impl;
 
   private:
@@ -562,9 +702,40 @@ class ClientNameServer : public ntci::DatagramSocketSession,
         const bsl::shared_ptr<ntci::Connector>&    connector,
         const ntca::ConnectEvent&                  event);
 
+    /// Process the expiration of the specified idle 'timer' of the stream
+    /// socket according to the specified 'event'.
+    void processStreamSocketIdle(const bsl::shared_ptr<ntci::Timer>& timer,
+                                 const ntca::TimerEvent&             event);
+
+    /// Process the specified 'response' to the specified 'operation'
+    /// received at the specified 'now' over the stream socket, if the
+    /// specified 'stream' flag is true, or over the datagram socket
+    /// otherwise.
+    void processResponse(
+        const bsl::shared_ptr<ntcdns::ClientOperation>& operation,
+        const ntcdns::MessageView&                      response,
+        const bsls::TimeInterval&                       now,
+        bool                                            stream);
+
+    /// Fail each operation sent or queued for sending over the stream
+    /// socket over to the next name server.
+    void failStreamOperations();
+
+    /// Close the stream socket and its idle timer, if any. The behavior is
+    /// undefined unless the stream socket mutex is locked.
+    void closeStreamSocket();
+
     /// Flush queued operations.
     void flush();
 
+    /// Flush operations queued for sending over the stream socket.
+    void flushStream();
+
+    /// Initiate the specified 'operation' over the stream socket, first
+    /// connecting the stream socket if necessary. Return the error.
+    ntsa::Error initiateStream(
+        const bsl::shared_ptr<ntcdns::ClientOperation>& operation);
+
   public:
     /// Create a new client name server for a client having the specified
     /// 'configuration' representing a name server at the specified 'index'
@@ -586,7 +757,10 @@ class ClientNameServer : public ntci::DatagramSocketSession,
     /// Start the name server.
     ntsa::Error start();
 
-    /// Initiate the specified 'operation'. Return the error.
+    /// Initiate the specified 'operation' over UDP, retrying over a
+    /// persistent TCP connection to the name server if the response is
+    /// truncated, or over that TCP connection alone if the client is
+    /// configured to use virtual circuits. Return the error.
     ntsa::Error initiate(
         const bsl::shared_ptr<ntcdns::ClientOperation>& operation);
 
@@ -611,8 +785,29 @@ class ClientNameServer : public ntci::DatagramSocketSession,
     /// Wait until the name server is stopped.
     void linger();
 
+    /// Record the specified 'latency' observed between sending a request to
+    /// the name server and receiving its response, or the duration after
+    /// which a request to the name server was hedged without a response.
+    void recordLatency(const bsls::TimeInterval& latency);
+
+    /// Load into the specified 'result' the specified 'percentile', from 1
+    /// to 99, of the latencies most recently observed from the name server.
+    /// Return true if enough latencies have been observed to estimate the
+    /// percentile, and false otherwise.
+    bool estimateLatency(bsls::TimeInterval* result,
+                         bsl::size_t         percentile) const;
+
+    /// Load into the specified 'result' the duration after which a request
+    /// sent to the name server that has not been answered is also sent to
+    /// the next name server. Return true if the client is configured to
+    /// hedge requests and such a duration is known, and false otherwise.
+    bool hedgeDelay(bsls::TimeInterval* result) const;
+
     /// The endpoint of the name server.
     const ntsa::Endpoint& endpoint() const;
+
+    /// Return the index of the name server in the client configuration.
+    bsl::size_t index() const;
 };
 
 /// @internal @brief
@@ -638,6 +833,17 @@ class Client : public ntccfg::Shared<Client>
     /// Define a type alias for a mutex lock guard.
     typedef ntccfg::LockGuard LockGuard;
 
+    /// Define a type alias for the key of a get IP address operation: the
+    /// name to resolve and the type of IP address queried.
+    typedef bsl::pair<bsl::string, ntsa::IpAddressType::Value>
+        GetIpAddressKey;
+
+    /// Define a type alias for a map of get IP address operations in
+    /// progress indexed by key.
+    typedef bsl::map<GetIpAddressKey,
+                     bsl::weak_ptr<ntcdns::ClientGetIpAddressOperation> >
+        GetIpAddressOperationMap;
+
     enum State {
         // This enumeration enumerates the states of operation.
 
@@ -652,6 +858,10 @@ class Client : public ntccfg::Shared<Client>
     bsl::shared_ptr<ntci::StreamSocketFactory>   d_streamSocketFactory_sp;
     bsl::shared_ptr<ntcdns::Cache>               d_cache_sp;
     ServerList                                   d_serverList;
+    GetIpAddressOperationMap                     d_getIpAddressOperationMap;
+    bsl::size_t                                  d_getIpAddressOperationLimit;
+    bsls::AtomicUint64                           d_numGetIpAddressIssued;
+    bsls::AtomicUint64                           d_numGetIpAddressCoalesced;
     State                                        d_state;
     bool                                         d_initialized;
     ntcdns::ClientConfig                         d_config;
@@ -660,6 +870,10 @@ class Client : public ntccfg::Shared<Client>
     // The default DNS port.
     static const ntsa::Port k_DNS_PORT;
 
+    // The minimum number of get IP address operations tracked before
+    // completed operations are purged.
+    static const bsl::size_t k_GET_IP_ADDRESS_OPERATION_LIMIT;
+
   private:
     Client(const Client&) BSLS_KEYWORD_DELETED;
     Client& operator=(const Client&) BSLS_KEYWORD_DELETED;
@@ -668,6 +882,12 @@ class Client : public ntccfg::Shared<Client>
     /// Initialize the mechanisms used by this object, if necessary.
     ntsa::Error initialize();
 
+    /// Load into the specified 'result' the name servers in the server
+    /// list ordered by their median observed latency, fastest first,
+    /// followed by the name servers whose latency is not yet known in
+    /// their configured order.
+    void rankServerList(ServerList* result) const;
+
   public:
     /// Create a new client having the specified 'configuration'. Optionally
     /// specify a 'basicAllocator' used to supply memory. If
@@ -695,7 +915,10 @@ class Client : public ntccfg::Shared<Client>
 
     /// Get the IP addresses assigned to the specified 'name' and invoke
     /// the specified 'callback' when resolution completes or an error
-    /// occurs. Return the error.
+    /// occurs. If an operation to get the IP addresses of the same 'name'
+    /// and type of IP address is already in progress, join that operation
+    /// rather than issue another query to the name servers. Return the
+    /// error.
     ntsa::Error getIpAddress(const bsl::shared_ptr<ntci::Resolver>& resolver,
                              const bsl::string&                     domainName,
                              const ntca::GetIpAddressOptions&       options,
@@ -708,6 +931,15 @@ class Client : public ntccfg::Shared<Client>
                               const ntsa::IpAddress&                 ipAddress,
                               const ntca::GetDomainNameOptions&      options,
                               const ntci::GetDomainNameCallback&     callback);
+
+    /// Return the number of get IP address operations issued to the name
+    /// servers.
+    bsl::uint64_t numGetIpAddressIssued() const;
+
+    /// Return the number of calls to get IP addresses that joined an
+    /// operation already in progress for the same name and type of IP
+    /// address rather than issuing their own.
+    bsl::uint64_t numGetIpAddressCoalesced() const;
 };
 
 }  // close package namespace
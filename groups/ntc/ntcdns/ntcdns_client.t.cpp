@@ -24,6 +24,7 @@ BSLS_IDENT_RCSID(ntcdns_client_t_cpp, "$Id$ $CSID$")
 #include <ntcdns_database.h>
 #include <ntcdns_utility.h>
 #include <ntci_log.h>
+#include <bdlf_bind.h>
 
 using namespace BloombergLP;
 
@@ -39,9 +40,28 @@ class ClientTest
         const ntca::GetIpAddressEvent&         event,
         bslmt::Semaphore*                      semaphore);
 
+    static void processGetIpAddressResultCapture(
+        const bsl::shared_ptr<ntci::Resolver>& resolver,
+        const bsl::vector<ntsa::IpAddress>&    ipAddressList,
+        const ntca::GetIpAddressEvent&         event,
+        bsl::vector<ntsa::IpAddress>*          resultIpAddressList,
+        ntca::GetIpAddressEvent*               resultEvent);
+
   public:
     // TODO
     static void verify();
+
+    // Concern: The result of a get IP address operation fans out to each
+    // caller joined to it, according to the options of each caller.
+    static void verifyGetIpAddressCoalescing();
+
+    // Concern: The failure of a get IP address operation fans out to each
+    // caller joined to it.
+    static void verifyGetIpAddressCoalescingError();
+
+    // Concern: A caller joins a get IP address operation regardless of its
+    // deadline.
+    static void verifyGetIpAddressCoalescingDeadline();
 };
 
 void ClientTest::processGetIpAddressResult(
@@ -75,6 +95,19 @@ void ClientTest::processGetIpAddressResult(
     semaphore->post();
 }
 
+void ClientTest::processGetIpAddressResultCapture(
+    const bsl::shared_ptr<ntci::Resolver>& resolver,
+    const bsl::vector<ntsa::IpAddress>&    ipAddressList,
+    const ntca::GetIpAddressEvent&         event,
+    bsl::vector<ntsa::IpAddress>*          resultIpAddressList,
+    ntca::GetIpAddressEvent*               resultEvent)
+{
+    NTCCFG_WARNING_UNUSED(resolver);
+
+    *resultIpAddressList = ipAddressList;
+    *resultEvent         = event;
+}
+
 NTSCFG_TEST_FUNCTION(ntcdns::ClientTest::verify)
 {
 // MRM: This test implementation is disable because of the difficulty
@@ -144,5 +177,310 @@ NTSCFG_TEST_FUNCTION(ntcdns::ClientTest::verify)
 #endif
 }
 
+NTSCFG_TEST_FUNCTION(ntcdns::ClientTest::verifyGetIpAddressCoalescing)
+{
+    const bsl::string NAME("example.com", NTSCFG_TEST_ALLOCATOR);
+    const bsl::size_t NUM_WAITERS      = 3;
+    const bsl::size_t NUM_IP_ADDRESSES = 2;
+
+    const char* const IP_ADDRESS[NUM_IP_ADDRESSES] = {"10.0.0.1",
+                                                      "10.0.0.2"};
+
+    bsl::vector<bsl::vector<ntsa::IpAddress> > resultIpAddressList(
+        NUM_WAITERS + 1,
+        NTSCFG_TEST_ALLOCATOR);
+    bsl::vector<ntca::GetIpAddressEvent> resultEvent(NUM_WAITERS + 1,
+                                                     NTSCFG_TEST_ALLOCATOR);
+
+    // Create an operation on behalf of the initiator, which selects the
+    // first IP address.
+
+    ntcdns::ClientGetIpAddressOperation::ServerList serverList(
+        NTSCFG_TEST_ALLOCATOR);
+
+    ntcdns::ClientGetIpAddressOperation::SearchList searchList(
+        NTSCFG_TEST_ALLOCATOR);
+    searchList.push_back(NAME);
+
+    ntca::GetIpAddressOptions initiatorOptions;
+    initiatorOptions.setIpAddressType(ntsa::IpAddressType::e_V4);
+    initiatorOptions.setIpAddressSelector(0);
+
+    ntci::GetIpAddressCallback initiatorCallback(
+        bdlf::BindUtil::bind(&ClientTest::processGetIpAddressResultCapture,
+                             bdlf::PlaceHolders::_1,
+                             bdlf::PlaceHolders::_2,
+                             bdlf::PlaceHolders::_3,
+                             &resultIpAddressList[0],
+                             &resultEvent[0]),
+        NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcdns::ClientGetIpAddressOperation> operation;
+    operation.createInplace(NTSCFG_TEST_ALLOCATOR,
+                            bsl::shared_ptr<ntci::Resolver>(),
+                            NAME,
+                            serverList,
+                            searchList,
+                            initiatorOptions,
+                            initiatorCallback,
+                            bsl::shared_ptr<ntcdns::Cache>(),
+                            NTSCFG_TEST_ALLOCATOR);
+
+    // Join callers that each select a different IP address, or none.
+
+    for (bsl::size_t i = 1; i <= NUM_WAITERS; ++i) {
+        ntca::GetIpAddressOptions options;
+        options.setIpAddressType(ntsa::IpAddressType::e_V4);
+        if (i < NUM_WAITERS) {
+            options.setIpAddressSelector(i);
+        }
+
+        ntci::GetIpAddressCallback callback(
+            bdlf::BindUtil::bind(
+                &ClientTest::processGetIpAddressResultCapture,
+                bdlf::PlaceHolders::_1,
+                bdlf::PlaceHolders::_2,
+                bdlf::PlaceHolders::_3,
+                &resultIpAddressList[i],
+                &resultEvent[i]),
+            NTSCFG_TEST_ALLOCATOR);
+
+        bool joined = operation->join(bsl::shared_ptr<ntci::Resolver>(),
+                                      options,
+                                      callback);
+        NTSCFG_TEST_TRUE(joined);
+    }
+
+    NTSCFG_TEST_EQ(operation->numWaiters(), NUM_WAITERS);
+
+    // Process a response containing each IP address.
+
+    ntcdns::Message response(NTSCFG_TEST_ALLOCATOR);
+    response.setDirection(ntcdns::Direction::e_RESPONSE);
+
+    ntcdns::Question& question = response.addQd();
+    question.setName(NAME);
+    question.setType(ntcdns::Type::e_A);
+    question.setClassification(ntcdns::Classification::e_INTERNET);
+
+    for (bsl::size_t i = 0; i < NUM_IP_ADDRESSES; ++i) {
+        ntsa::Ipv4Address ipv4Address(IP_ADDRESS[i]);
+
+        ntcdns::ResourceRecordData rdata;
+        ipv4Address.copyTo(&rdata.makeIpv4(), sizeof rdata.ipv4());
+
+        ntcdns::ResourceRecord& answer = response.addAn();
+        answer.setName(NAME);
+        answer.setClassification(ntcdns::Classification::e_INTERNET);
+        answer.setTtl(60);
+        answer.setRdata(rdata);
+    }
+
+    bsl::vector<bsl::uint8_t> buffer(512, NTSCFG_TEST_ALLOCATOR);
+
+    ntcdns::MemoryEncoder encoder(&buffer[0], buffer.size());
+
+    ntsa::Error error = response.encode(&encoder);
+    NTSCFG_TEST_OK(error);
+
+    ntcdns::MessageView responseView;
+    error = responseView.decode(&buffer[0], encoder.position());
+    NTSCFG_TEST_OK(error);
+
+    operation->processResponse(responseView,
+                               ntsa::Endpoint("127.0.0.1:53"),
+                               0,
+                               bsls::TimeInterval());
+
+    // Ensure each caller is completed with its own selection of the shared
+    // result.
+
+    for (bsl::size_t i = 0; i <= NUM_WAITERS; ++i) {
+        NTSCFG_TEST_EQ(resultEvent[i].type(),
+                       ntca::GetIpAddressEventType::e_COMPLETE);
+
+        if (i < NUM_WAITERS) {
+            NTSCFG_TEST_EQ(resultIpAddressList[i].size(), 1);
+            NTSCFG_TEST_EQ(
+                resultIpAddressList[i][0],
+                ntsa::IpAddress(IP_ADDRESS[i % NUM_IP_ADDRESSES]));
+        }
+        else {
+            NTSCFG_TEST_EQ(resultIpAddressList[i].size(), NUM_IP_ADDRESSES);
+        }
+    }
+
+    NTSCFG_TEST_EQ(operation->numWaiters(), 0);
+
+    // Ensure no caller may join the operation once it has completed.
+
+    bool joined = operation->join(bsl::shared_ptr<ntci::Resolver>(),
+                                  initiatorOptions,
+                                  initiatorCallback);
+    NTSCFG_TEST_FALSE(joined);
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::ClientTest::verifyGetIpAddressCoalescingError)
+{
+    const bsl::string NAME("example.com", NTSCFG_TEST_ALLOCATOR);
+
+    bsl::vector<ntsa::IpAddress> initiatorIpAddressList(NTSCFG_TEST_ALLOCATOR);
+    ntca::GetIpAddressEvent      initiatorEvent;
+
+    bsl::vector<ntsa::IpAddress> waiterIpAddressList(NTSCFG_TEST_ALLOCATOR);
+    ntca::GetIpAddressEvent      waiterEvent;
+
+    ntcdns::ClientGetIpAddressOperation::ServerList serverList(
+        NTSCFG_TEST_ALLOCATOR);
+
+    ntcdns::ClientGetIpAddressOperation::SearchList searchList(
+        NTSCFG_TEST_ALLOCATOR);
+    searchList.push_back(NAME);
+
+    ntca::GetIpAddressOptions options;
+
+    ntci::GetIpAddressCallback initiatorCallback(
+        bdlf::BindUtil::bind(&ClientTest::processGetIpAddressResultCapture,
+                             bdlf::PlaceHolders::_1,
+                             bdlf::PlaceHolders::_2,
+                             bdlf::PlaceHolders::_3,
+                             &initiatorIpAddressList,
+                             &initiatorEvent),
+        NTSCFG_TEST_ALLOCATOR);
+
+    ntci::GetIpAddressCallback waiterCallback(
+        bdlf::BindUtil::bind(&ClientTest::processGetIpAddressResultCapture,
+                             bdlf::PlaceHolders::_1,
+                             bdlf::PlaceHolders::_2,
+                             bdlf::PlaceHolders::_3,
+                             &waiterIpAddressList,
+                             &waiterEvent),
+        NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcdns::ClientGetIpAddressOperation> operation;
+    operation.createInplace(NTSCFG_TEST_ALLOCATOR,
+                            bsl::shared_ptr<ntci::Resolver>(),
+                            NAME,
+                            serverList,
+                            searchList,
+                            options,
+                            initiatorCallback,
+                            bsl::shared_ptr<ntcdns::Cache>(),
+                            NTSCFG_TEST_ALLOCATOR);
+
+    bool joined = operation->join(bsl::shared_ptr<ntci::Resolver>(),
+                                  options,
+                                  waiterCallback);
+    NTSCFG_TEST_TRUE(joined);
+
+    operation->processError(ntsa::Error(ntsa::Error::e_CONNECTION_TIMEOUT));
+
+    NTSCFG_TEST_EQ(initiatorEvent.type(),
+                   ntca::GetIpAddressEventType::e_ERROR);
+    NTSCFG_TEST_EQ(initiatorEvent.context().error(),
+                   ntsa::Error(ntsa::Error::e_CONNECTION_TIMEOUT));
+    NTSCFG_TEST_TRUE(initiatorIpAddressList.empty());
+
+    NTSCFG_TEST_EQ(waiterEvent.type(), ntca::GetIpAddressEventType::e_ERROR);
+    NTSCFG_TEST_EQ(waiterEvent.context().error(),
+                   ntsa::Error(ntsa::Error::e_CONNECTION_TIMEOUT));
+    NTSCFG_TEST_TRUE(waiterIpAddressList.empty());
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::ClientTest::verifyGetIpAddressCoalescingDeadline)
+{
+    const bsl::string NAME("example.com", NTSCFG_TEST_ALLOCATOR);
+
+    const bsls::TimeInterval DEADLINE(1000, 0);
+
+    bsl::vector<ntsa::IpAddress> initiatorIpAddressList(NTSCFG_TEST_ALLOCATOR);
+    ntca::GetIpAddressEvent      initiatorEvent;
+
+    bsl::vector<ntsa::IpAddress> waiterIpAddressList(NTSCFG_TEST_ALLOCATOR);
+    ntca::GetIpAddressEvent      waiterEvent;
+
+    ntcdns::ClientGetIpAddressOperation::ServerList serverList(
+        NTSCFG_TEST_ALLOCATOR);
+
+    ntcdns::ClientGetIpAddressOperation::SearchList searchList(
+        NTSCFG_TEST_ALLOCATOR);
+    searchList.push_back(NAME);
+
+    ntca::GetIpAddressOptions initiatorOptions;
+    initiatorOptions.setIpAddressType(ntsa::IpAddressType::e_V4);
+    initiatorOptions.setDeadline(DEADLINE);
+
+    ntci::GetIpAddressCallback initiatorCallback(
+        bdlf::BindUtil::bind(&ClientTest::processGetIpAddressResultCapture,
+                             bdlf::PlaceHolders::_1,
+                             bdlf::PlaceHolders::_2,
+                             bdlf::PlaceHolders::_3,
+                             &initiatorIpAddressList,
+                             &initiatorEvent),
+        NTSCFG_TEST_ALLOCATOR);
+
+    ntci::GetIpAddressCallback waiterCallback(
+        bdlf::BindUtil::bind(&ClientTest::processGetIpAddressResultCapture,
+                             bdlf::PlaceHolders::_1,
+                             bdlf::PlaceHolders::_2,
+                             bdlf::PlaceHolders::_3,
+                             &waiterIpAddressList,
+                             &waiterEvent),
+        NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcdns::ClientGetIpAddressOperation> operation;
+    operation.createInplace(NTSCFG_TEST_ALLOCATOR,
+                            bsl::shared_ptr<ntci::Resolver>(),
+                            NAME,
+                            serverList,
+                            searchList,
+                            initiatorOptions,
+                            initiatorCallback,
+                            bsl::shared_ptr<ntcdns::Cache>(),
+                            NTSCFG_TEST_ALLOCATOR);
+
+    // Ensure callers having an earlier deadline, a later deadline, or no
+    // deadline at all join the operation, since connect deadlines differ for
+    // every caller.
+
+    {
+        ntca::GetIpAddressOptions options(initiatorOptions);
+        options.setDeadline(DEADLINE - bsls::TimeInterval(1, 0));
+
+        bool joined = operation->join(bsl::shared_ptr<ntci::Resolver>(),
+                                      options,
+                                      waiterCallback);
+        NTSCFG_TEST_TRUE(joined);
+    }
+
+    {
+        ntca::GetIpAddressOptions options(initiatorOptions);
+        options.setDeadline(DEADLINE + bsls::TimeInterval(1, 0));
+
+        bool joined = operation->join(bsl::shared_ptr<ntci::Resolver>(),
+                                      options,
+                                      waiterCallback);
+        NTSCFG_TEST_TRUE(joined);
+    }
+
+    {
+        ntca::GetIpAddressOptions options;
+        options.setIpAddressType(ntsa::IpAddressType::e_V4);
+
+        bool joined = operation->join(bsl::shared_ptr<ntci::Resolver>(),
+                                      options,
+                                      waiterCallback);
+        NTSCFG_TEST_TRUE(joined);
+    }
+
+    NTSCFG_TEST_EQ(operation->numWaiters(), 3);
+
+    operation->processError(ntsa::Error(ntsa::Error::e_CONNECTION_TIMEOUT));
+
+    NTSCFG_TEST_EQ(initiatorEvent.type(),
+                   ntca::GetIpAddressEventType::e_ERROR);
+    NTSCFG_TEST_EQ(waiterEvent.type(), ntca::GetIpAddressEventType::e_ERROR);
+}
+
 }  // close namespace ntcdns
 }  // close namespace BloombergLP
@@ -18,18 +18,30 @@
 #include <ntcdns_compat.h>
 #include <ntcdns_utility.h>
 #include <ntci_log.h>
+#include <ntcs_threadutil.h>
 #include <ntsa_host.h>
 #include <ntsu_resolverutil.h>
 #include <bdlb_chartype.h>
+#include <bdlt_currenttime.h>
+#include <bdlt_epochutil.h>
 #include <bslma_allocator.h>
 #include <bslma_default.h>
+#include <bslma_rawdeleterproctor.h>
 #include <bslmt_lockguard.h>
+#include <bslmt_threadutil.h>
 #include <bsls_assert.h>
+#include <bsls_platform.h>
 #include <bsls_stopwatch.h>
 #include <bsls_timeinterval.h>
+#include <bsls_types.h>
 #include <bsl_iomanip.h>
 #include <bsl_iostream.h>
 
+#if defined(BSLS_PLATFORM_OS_UNIX)
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
 // Uncomment or set to 0 to print various diagnostics to standard output
 // while debugging.
 // #define NTCDNS_DATABASE_DEBUG_COUT 1
@@ -484,15 +496,311 @@ bsl::size_t HostDatabaseUtil::hashIpv6(const ntsa::Ipv6Address& ipv6Address)
     return result;
 }
 
-ntsa::Error HostDatabase::load(const bsl::shared_ptr<ntcdns::File>& file)
+DatabaseFileStamp::DatabaseFileStamp(bslma::Allocator* basicAllocator)
+: d_path(basicAllocator)
+, d_modificationTime()
+, d_size(0)
+, d_device(0)
+, d_inode(0)
+, d_changeTime(0)
+, d_stampTime(0)
+, d_contentHash(0)
+{
+}
+
+DatabaseFileStamp::~DatabaseFileStamp()
+{
+}
+
+void DatabaseFileStamp::reset()
+{
+    d_path.clear();
+    d_modificationTime = bdlt::Datetime();
+    d_size             = 0;
+    d_device           = 0;
+    d_inode            = 0;
+    d_changeTime       = 0;
+    d_stampTime        = 0;
+    d_contentHash      = 0;
+}
+
+ntsa::Error DatabaseFileStamp::load(const bslstl::StringRef& path)
+{
+    bsl::string pathString(path);
+
+    const bsls::Types::Int64 stampTime =
+        bdlt::CurrentTime::now().totalNanoseconds();
+
+    bdlt::Datetime modificationTime;
+    int            rc = bdls::FilesystemUtil::getLastModificationTime(
+        &modificationTime,
+        pathString.c_str());
+    if (rc != 0) {
+        return ntsa::Error(ntsa::Error::e_EOF);
+    }
+
+    bdls::FilesystemUtil::Offset size =
+        bdls::FilesystemUtil::getFileSize(pathString.c_str());
+    if (size < 0) {
+        return ntsa::Error(ntsa::Error::e_EOF);
+    }
+
+    bsls::Types::Uint64 device     = 0;
+    bsls::Types::Uint64 inode      = 0;
+    bsls::Types::Int64  changeTime = 0;
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+
+    struct ::stat status;
+    rc = ::stat(pathString.c_str(), &status);
+    if (rc != 0) {
+        return ntsa::Error(ntsa::Error::e_EOF);
+    }
+
+    device     = static_cast<bsls::Types::Uint64>(status.st_dev);
+    inode      = static_cast<bsls::Types::Uint64>(status.st_ino);
+    changeTime = static_cast<bsls::Types::Int64>(status.st_ctime) *
+                 1000 * 1000 * 1000;
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    changeTime += static_cast<bsls::Types::Int64>(status.st_ctim.tv_nsec);
+#elif defined(BSLS_PLATFORM_OS_DARWIN)
+    changeTime +=
+        static_cast<bsls::Types::Int64>(status.st_ctimespec.tv_nsec);
+#endif
+
+#endif
+
+    d_path             = pathString;
+    d_modificationTime = modificationTime;
+    d_size             = size;
+    d_device           = device;
+    d_inode            = inode;
+    d_changeTime       = changeTime;
+    d_stampTime        = stampTime;
+    d_contentHash      = 0;
+
+    return ntsa::Error();
+}
+
+void DatabaseFileStamp::setContent(const char* data, bsl::size_t size)
+{
+    // Compute the 64-bit FNV-1a hash of the content.
+
+    bsls::Types::Uint64 hash = 14695981039346656037ULL;
+
+    for (bsl::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    d_contentHash = hash;
+}
+
+const bsl::string& DatabaseFileStamp::path() const
+{
+    return d_path;
+}
+
+bsls::Types::Uint64 DatabaseFileStamp::contentHash() const
+{
+    return d_contentHash;
+}
+
+bool DatabaseFileStamp::isDefined() const
+{
+    return !d_path.empty();
+}
+
+bool DatabaseFileStamp::isRacy() const
+{
+    // Allow for file systems that record modification times to the second
+    // and for status change times taken from a coarse clock.
+
+    const bsls::Types::Int64 k_RESOLUTION = 2LL * 1000 * 1000 * 1000;
+
+    bsls::Types::Int64 lastChangeTime =
+        bdlt::EpochUtil::convertToTimeInterval(d_modificationTime)
+            .totalNanoseconds();
+
+    if (d_changeTime > lastChangeTime) {
+        lastChangeTime = d_changeTime;
+    }
+
+    return d_stampTime - lastChangeTime < k_RESOLUTION;
+}
+
+bool DatabaseFileStamp::equals(const DatabaseFileStamp& other) const
+{
+    return d_path == other.d_path &&
+           d_modificationTime == other.d_modificationTime &&
+           d_size == other.d_size && d_device == other.d_device &&
+           d_inode == other.d_inode && d_changeTime == other.d_changeTime;
+}
+
+DatabaseEpoch::DatabaseEpoch()
+: d_epoch(0)
+{
+}
+
+DatabaseEpoch::~DatabaseEpoch()
+{
+}
+
+bsl::size_t DatabaseEpoch::enter()
+{
+    const bsl::size_t shard = ntcs::ThreadUtil::shardIndex(k_NUM_SHARDS);
+
+    // Count the lookup in the generation of the current epoch. If a writer
+    // advanced the epoch in the meantime, the writer may have already
+    // observed the count of that generation, so count the lookup in the
+    // generation of the new epoch instead.
+
+    while (true) {
+        const bsls::Types::Uint64 epoch      = d_epoch.load();
+        const bsl::size_t         generation =
+            static_cast<bsl::size_t>(epoch & 1);
+
+        d_shard[shard].d_count[generation].add(1);
+
+        if (NTCCFG_LIKELY(d_epoch.load() == epoch)) {
+            return shard * 2 + generation;
+        }
+
+        d_shard[shard].d_count[generation].add(-1);
+    }
+}
+
+void DatabaseEpoch::leave(bsl::size_t token)
+{
+    d_shard[token / 2].d_count[token % 2].add(-1);
+}
+
+void DatabaseEpoch::synchronize()
+{
+    // Lookups announced after the epoch is advanced are counted in the
+    // other generation and observe only the index already published, so
+    // wait only for the generation of the previous epoch to drain.
+
+    const bsls::Types::Uint64 epoch      = d_epoch.add(1) - 1;
+    const bsl::size_t         generation =
+        static_cast<bsl::size_t>(epoch & 1);
+
+    for (bsl::size_t shard = 0; shard < k_NUM_SHARDS; ++shard) {
+        while (d_shard[shard].d_count[generation].load() != 0) {
+            bslmt::ThreadUtil::yield();
+        }
+    }
+}
+
+DatabaseEpochGuard::DatabaseEpochGuard(DatabaseEpoch* epoch)
+: d_epoch_p(epoch)
+, d_token(epoch->enter())
+{
+}
+
+DatabaseEpochGuard::~DatabaseEpochGuard()
+{
+    d_epoch_p->leave(d_token);
+}
+
+/// Provide an immutable index of the entries in a host database file.
+///
+/// @details
+/// Each index allocates from its own pool, so the memory of a superseded
+/// index is released at once, by the thread that publishes its
+/// replacement, without contending with the construction of that
+/// replacement.
+class HostDatabase::Index
+{
+    bdlma::MultipoolAllocator     d_pool;
+    IpAddressByDomainName         d_ipAddressByDomainName;
+    DomainNameByIpAddress         d_domainNameByIpAddress;
+    bsl::shared_ptr<ntcdns::File> d_file_sp;
+
+  private:
+    Index(const Index&) BSLS_KEYWORD_DELETED;
+    Index& operator=(const Index&) BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Create a new, empty index of the specified 'file'. Optionally
+    /// specify a 'basicAllocator' used to supply memory. If
+    /// 'basicAllocator' is 0, the currently installed default allocator is
+    /// used.
+    explicit Index(const bsl::shared_ptr<ntcdns::File>& file,
+                   bslma::Allocator*                    basicAllocator = 0);
+
+    /// Destroy this object.
+    ~Index();
+
+    /// Return the map of domain names to IP addresses.
+    IpAddressByDomainName& ipAddressByDomainName();
+
+    /// Return the map of IP addresses to domain names.
+    DomainNameByIpAddress& domainNameByIpAddress();
+
+    /// Return the map of domain names to IP addresses.
+    const IpAddressByDomainName& ipAddressByDomainName() const;
+
+    /// Return the map of IP addresses to domain names.
+    const DomainNameByIpAddress& domainNameByIpAddress() const;
+};
+
+HostDatabase::Index::Index(const bsl::shared_ptr<ntcdns::File>& file,
+                           bslma::Allocator*                    basicAllocator)
+: d_pool(8, basicAllocator)
+, d_ipAddressByDomainName(&d_pool)
+, d_domainNameByIpAddress(&d_pool)
+, d_file_sp(file)
+{
+}
+
+HostDatabase::Index::~Index()
+{
+}
+
+HostDatabase::IpAddressByDomainName& HostDatabase::Index::
+    ipAddressByDomainName()
+{
+    return d_ipAddressByDomainName;
+}
+
+HostDatabase::DomainNameByIpAddress& HostDatabase::Index::
+    domainNameByIpAddress()
+{
+    return d_domainNameByIpAddress;
+}
+
+const HostDatabase::IpAddressByDomainName& HostDatabase::Index::
+    ipAddressByDomainName() const
+{
+    return d_ipAddressByDomainName;
+}
+
+const HostDatabase::DomainNameByIpAddress& HostDatabase::Index::
+    domainNameByIpAddress() const
+{
+    return d_domainNameByIpAddress;
+}
+
+ntsa::Error HostDatabase::load(const bsl::shared_ptr<ntcdns::File>& file,
+                               const ntcdns::DatabaseFileStamp&     stamp)
 {
     bsls::Stopwatch stopwatch;
     stopwatch.start();
 
     Scanner scanner(file->data(), file->size());
 
-    IpAddressByDomainName ipAddressByDomainName(d_allocator_p);
-    DomainNameByIpAddress domainNameByIpAddress(d_allocator_p);
+    Index* index = new (*d_allocator_p) Index(file, d_allocator_p);
+
+    bslma::RawDeleterProctor<Index, bslma::Allocator> indexProctor(
+        index,
+        d_allocator_p);
+
+    IpAddressByDomainName& ipAddressByDomainName =
+        index->ipAddressByDomainName();
+    DomainNameByIpAddress& domainNameByIpAddress =
+        index->domainNameByIpAddress();
 
     if (file->size() > 1024 * 1024) {
         ipAddressByDomainName.reserve(1024 * 1024);
@@ -596,38 +904,60 @@ ntsa::Error HostDatabase::load(const bsl::shared_ptr<ntcdns::File>& file)
         << " milliseconds" << bsl::endl;
 #endif
 
+    // Publish the new index. Lookups never take the lock, so holding it
+    // while waiting for the lookups of the previous index to complete only
+    // serializes concurrent loads.
+
+    indexProctor.release();
+
     {
         LockGuard lock(&d_mutex);
 
-        d_ipAddressByDomainName.swap(ipAddressByDomainName);
-        d_domainNameByIpAddress.swap(domainNameByIpAddress);
-        d_file_sp = file;
+        this->publish(index);
+        d_stamp = stamp;
     }
 
     return ntsa::Error();
 }
 
+void HostDatabase::publish(Index* index)
+{
+    Index* previous = d_index_p.swap(index);
+
+    if (previous != 0) {
+        d_epoch.synchronize();
+        d_allocator_p->deleteObject(previous);
+    }
+}
+
+const HostDatabase::Index* HostDatabase::index() const
+{
+    return d_index_p.loadAcquire();
+}
+
 HostDatabase::HostDatabase(bslma::Allocator* basicAllocator)
 : d_mutex()
-, d_pool(8, basicAllocator)
-, d_ipAddressByDomainName(&d_pool)
-, d_domainNameByIpAddress(&d_pool)
-, d_file_sp()
-, d_allocator_p(&d_pool)
+, d_index_p(0)
+, d_epoch()
+, d_stamp(basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
 
 HostDatabase::~HostDatabase()
 {
+    Index* index = d_index_p.swap(0);
+    if (index != 0) {
+        d_allocator_p->deleteObject(index);
+    }
 }
 
 void HostDatabase::clear()
 {
     LockGuard guard(&d_mutex);
 
-    d_ipAddressByDomainName.clear();
-    d_domainNameByIpAddress.clear();
-    d_file_sp.reset();
+    this->publish(0);
+    d_stamp.reset();
 }
 
 ntsa::Error HostDatabase::load()
@@ -651,6 +981,12 @@ ntsa::Error HostDatabase::loadPath(const bslstl::StringRef& path)
 
     ntsa::Error error;
 
+    // Stamp the file before reading it, so that a modification made while
+    // it is read is detected by the next reload.
+
+    ntcdns::DatabaseFileStamp stamp(d_allocator_p);
+    stamp.load(path);
+
     bsl::shared_ptr<ntcdns::File> file;
     file.createInplace(d_allocator_p, d_allocator_p);
 
@@ -661,7 +997,9 @@ ntsa::Error HostDatabase::loadPath(const bslstl::StringRef& path)
         return error;
     }
 
-    error = this->load(file);
+    stamp.setContent(file->data(), file->size());
+
+    error = this->load(file, stamp);
     if (error) {
         NTCI_LOG_STREAM_ERROR << "Failed to parse host database '" << path
                               << "': " << error << NTCI_LOG_STREAM_END;
@@ -687,7 +1025,7 @@ ntsa::Error HostDatabase::loadText(const char* data, bsl::size_t size)
         return error;
     }
 
-    error = this->load(file);
+    error = this->load(file, ntcdns::DatabaseFileStamp(d_allocator_p));
     if (error) {
         NTCI_LOG_STREAM_ERROR << "Failed to parse host database: " << error
                               << NTCI_LOG_STREAM_END;
@@ -697,6 +1035,63 @@ ntsa::Error HostDatabase::loadText(const char* data, bsl::size_t size)
     return ntsa::Error();
 }
 
+ntsa::Error HostDatabase::reload(bool* reloaded)
+{
+    ntsa::Error error;
+
+    *reloaded = false;
+
+    ntcdns::DatabaseFileStamp current(d_allocator_p);
+    {
+        LockGuard lock(&d_mutex);
+        current = d_stamp;
+    }
+
+    if (!current.isDefined()) {
+        return ntsa::Error();
+    }
+
+    ntcdns::DatabaseFileStamp latest(d_allocator_p);
+    error = latest.load(current.path());
+    if (error) {
+        return error;
+    }
+
+    if (latest.equals(current) && !current.isRacy()) {
+        return ntsa::Error();
+    }
+
+    // The file may have changed: read it, but publish a new index only if
+    // its content actually differs.
+
+    bsl::shared_ptr<ntcdns::File> file;
+    file.createInplace(d_allocator_p, d_allocator_p);
+
+    error = file->load(current.path());
+    if (error) {
+        return error;
+    }
+
+    latest.setContent(file->data(), file->size());
+
+    if (latest.contentHash() == current.contentHash()) {
+        LockGuard lock(&d_mutex);
+        if (d_stamp.equals(current)) {
+            d_stamp = latest;
+        }
+        return ntsa::Error();
+    }
+
+    error = this->load(file, latest);
+    if (error) {
+        return error;
+    }
+
+    *reloaded = true;
+
+    return ntsa::Error();
+}
+
 ntsa::Error HostDatabase::getIpAddress(
     ntca::GetIpAddressContext*       context,
     bsl::vector<ntsa::IpAddress>*    result,
@@ -713,12 +1108,17 @@ ntsa::Error HostDatabase::getIpAddress(
     }
 
     {
-        LockGuard lock(&d_mutex);
+        ntcdns::DatabaseEpochGuard epochGuard(&d_epoch);
+
+        const Index* index = this->index();
+        if (!index) {
+            return ntsa::Error(ntsa::Error::e_EOF);
+        }
 
         IpAddressByDomainName::const_iterator it =
-            d_ipAddressByDomainName.find(domainName);
+            index->ipAddressByDomainName().find(domainName);
 
-        if (it == d_ipAddressByDomainName.end()) {
+        if (it == index->ipAddressByDomainName().end()) {
             return ntsa::Error(ntsa::Error::e_EOF);
         }
 
@@ -780,12 +1180,17 @@ ntsa::Error HostDatabase::getDomainName(
 {
     NTCCFG_WARNING_UNUSED(options);
 
-    LockGuard guard(&d_mutex);
+    ntcdns::DatabaseEpochGuard epochGuard(&d_epoch);
+
+    const Index* index = this->index();
+    if (!index) {
+        return ntsa::Error(ntsa::Error::e_EOF);
+    }
 
     DomainNameByIpAddress::const_iterator it =
-        d_domainNameByIpAddress.find(ipAddress);
+        index->domainNameByIpAddress().find(ipAddress);
 
-    if (it == d_domainNameByIpAddress.end()) {
+    if (it == index->domainNameByIpAddress().end()) {
         return ntsa::Error(ntsa::Error::e_EOF);
     }
 
@@ -813,7 +1218,122 @@ class PortDatabase::PortEntrySorter
     }
 };
 
-ntsa::Error PortDatabase::load(const bsl::shared_ptr<ntcdns::File>& file)
+/// Provide an immutable index of the entries in a port database file.
+///
+/// @details
+/// Each index allocates from its own pool, so the memory of a superseded
+/// index is released at once, by the thread that publishes its
+/// replacement.
+class PortDatabase::Index
+{
+    bdlma::MultipoolAllocator     d_pool;
+    PortByServiceName             d_tcpPortByServiceName;
+    ServiceNameByPort             d_tcpServiceNameByPort;
+    PortByServiceName             d_udpPortByServiceName;
+    ServiceNameByPort             d_udpServiceNameByPort;
+    bsl::shared_ptr<ntcdns::File> d_file_sp;
+
+  private:
+    Index(const Index&) BSLS_KEYWORD_DELETED;
+    Index& operator=(const Index&) BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Create a new, empty index of the specified 'file'. Optionally
+    /// specify a 'basicAllocator' used to supply memory. If
+    /// 'basicAllocator' is 0, the currently installed default allocator is
+    /// used.
+    explicit Index(const bsl::shared_ptr<ntcdns::File>& file,
+                   bslma::Allocator*                    basicAllocator = 0);
+
+    /// Destroy this object.
+    ~Index();
+
+    /// Return the map of service names to TCP ports.
+    PortByServiceName& tcpPortByServiceName();
+
+    /// Return the map of TCP ports to service names.
+    ServiceNameByPort& tcpServiceNameByPort();
+
+    /// Return the map of service names to UDP ports.
+    PortByServiceName& udpPortByServiceName();
+
+    /// Return the map of UDP ports to service names.
+    ServiceNameByPort& udpServiceNameByPort();
+
+    /// Return the map of service names to TCP ports.
+    const PortByServiceName& tcpPortByServiceName() const;
+
+    /// Return the map of TCP ports to service names.
+    const ServiceNameByPort& tcpServiceNameByPort() const;
+
+    /// Return the map of service names to UDP ports.
+    const PortByServiceName& udpPortByServiceName() const;
+
+    /// Return the map of UDP ports to service names.
+    const ServiceNameByPort& udpServiceNameByPort() const;
+};
+
+PortDatabase::Index::Index(const bsl::shared_ptr<ntcdns::File>& file,
+                           bslma::Allocator*                    basicAllocator)
+: d_pool(8, basicAllocator)
+, d_tcpPortByServiceName(&d_pool)
+, d_tcpServiceNameByPort(&d_pool)
+, d_udpPortByServiceName(&d_pool)
+, d_udpServiceNameByPort(&d_pool)
+, d_file_sp(file)
+{
+}
+
+PortDatabase::Index::~Index()
+{
+}
+
+PortDatabase::PortByServiceName& PortDatabase::Index::tcpPortByServiceName()
+{
+    return d_tcpPortByServiceName;
+}
+
+PortDatabase::ServiceNameByPort& PortDatabase::Index::tcpServiceNameByPort()
+{
+    return d_tcpServiceNameByPort;
+}
+
+PortDatabase::PortByServiceName& PortDatabase::Index::udpPortByServiceName()
+{
+    return d_udpPortByServiceName;
+}
+
+PortDatabase::ServiceNameByPort& PortDatabase::Index::udpServiceNameByPort()
+{
+    return d_udpServiceNameByPort;
+}
+
+const PortDatabase::PortByServiceName& PortDatabase::Index::
+    tcpPortByServiceName() const
+{
+    return d_tcpPortByServiceName;
+}
+
+const PortDatabase::ServiceNameByPort& PortDatabase::Index::
+    tcpServiceNameByPort() const
+{
+    return d_tcpServiceNameByPort;
+}
+
+const PortDatabase::PortByServiceName& PortDatabase::Index::
+    udpPortByServiceName() const
+{
+    return d_udpPortByServiceName;
+}
+
+const PortDatabase::ServiceNameByPort& PortDatabase::Index::
+    udpServiceNameByPort() const
+{
+    return d_udpServiceNameByPort;
+}
+
+ntsa::Error PortDatabase::load(const bsl::shared_ptr<ntcdns::File>& file,
+                               const ntcdns::DatabaseFileStamp&     stamp)
 {
     ntsa::Error error;
 
@@ -822,10 +1342,16 @@ ntsa::Error PortDatabase::load(const bsl::shared_ptr<ntcdns::File>& file)
 
     Scanner scanner(file->data(), file->size());
 
-    PortByServiceName tcpPortByServiceName(d_allocator_p);
-    ServiceNameByPort tcpServiceNameByPort(d_allocator_p);
-    PortByServiceName udpPortByServiceName(d_allocator_p);
-    ServiceNameByPort udpServiceNameByPort(d_allocator_p);
+    Index* index = new (*d_allocator_p) Index(file, d_allocator_p);
+
+    bslma::RawDeleterProctor<Index, bslma::Allocator> indexProctor(
+        index,
+        d_allocator_p);
+
+    PortByServiceName& tcpPortByServiceName = index->tcpPortByServiceName();
+    ServiceNameByPort& tcpServiceNameByPort = index->tcpServiceNameByPort();
+    PortByServiceName& udpPortByServiceName = index->udpPortByServiceName();
+    ServiceNameByPort& udpServiceNameByPort = index->udpServiceNameByPort();
 
     if (file->size() >= 1024 * 1024) {
         tcpPortByServiceName.reserve(1024);
@@ -1123,45 +1649,60 @@ ntsa::Error PortDatabase::load(const bsl::shared_ptr<ntcdns::File>& file)
         << " milliseconds" << bsl::endl;
 #endif
 
+    // Publish the new index. Lookups never take the lock, so holding it
+    // while waiting for the lookups of the previous index to complete only
+    // serializes concurrent loads.
+
+    indexProctor.release();
+
     {
         LockGuard lock(&d_mutex);
 
-        d_tcpPortByServiceName.swap(tcpPortByServiceName);
-        d_tcpServiceNameByPort.swap(tcpServiceNameByPort);
+        this->publish(index);
+        d_stamp = stamp;
+    }
+
+    return ntsa::Error();
+}
 
-        d_udpPortByServiceName.swap(udpPortByServiceName);
-        d_udpServiceNameByPort.swap(udpServiceNameByPort);
+void PortDatabase::publish(Index* index)
+{
+    Index* previous = d_index_p.swap(index);
 
-        d_file_sp = file;
+    if (previous != 0) {
+        d_epoch.synchronize();
+        d_allocator_p->deleteObject(previous);
     }
+}
 
-    return ntsa::Error();
+const PortDatabase::Index* PortDatabase::index() const
+{
+    return d_index_p.loadAcquire();
 }
 
 PortDatabase::PortDatabase(bslma::Allocator* basicAllocator)
 : d_mutex()
-, d_tcpPortByServiceName(basicAllocator)
-, d_tcpServiceNameByPort(basicAllocator)
-, d_udpPortByServiceName(basicAllocator)
-, d_udpServiceNameByPort(basicAllocator)
+, d_index_p(0)
+, d_epoch()
+, d_stamp(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
 
 PortDatabase::~PortDatabase()
 {
+    Index* index = d_index_p.swap(0);
+    if (index != 0) {
+        d_allocator_p->deleteObject(index);
+    }
 }
 
 void PortDatabase::clear()
 {
     LockGuard guard(&d_mutex);
 
-    d_tcpPortByServiceName.clear();
-    d_tcpServiceNameByPort.clear();
-    d_udpPortByServiceName.clear();
-    d_udpServiceNameByPort.clear();
-
-    d_file_sp.reset();
+    this->publish(0);
+    d_stamp.reset();
 }
 
 ntsa::Error PortDatabase::load()
@@ -1185,6 +1726,12 @@ ntsa::Error PortDatabase::loadPath(const bslstl::StringRef& path)
 
     ntsa::Error error;
 
+    // Stamp the file before reading it, so that a modification made while
+    // it is read is detected by the next reload.
+
+    ntcdns::DatabaseFileStamp stamp(d_allocator_p);
+    stamp.load(path);
+
     bsl::shared_ptr<ntcdns::File> file;
     file.createInplace(d_allocator_p, d_allocator_p);
 
@@ -1195,7 +1742,9 @@ ntsa::Error PortDatabase::loadPath(const bslstl::StringRef& path)
         return error;
     }
 
-    error = this->load(file);
+    stamp.setContent(file->data(), file->size());
+
+    error = this->load(file, stamp);
     if (error) {
         NTCI_LOG_STREAM_ERROR << "Failed to parse port database '" << path
                               << "': " << error << NTCI_LOG_STREAM_END;
@@ -1221,7 +1770,7 @@ ntsa::Error PortDatabase::loadText(const char* data, bsl::size_t size)
         return error;
     }
 
-    error = this->load(file);
+    error = this->load(file, ntcdns::DatabaseFileStamp(d_allocator_p));
     if (error) {
         NTCI_LOG_STREAM_ERROR << "Failed to parse port database: " << error
                               << NTCI_LOG_STREAM_END;
@@ -1231,6 +1780,63 @@ ntsa::Error PortDatabase::loadText(const char* data, bsl::size_t size)
     return ntsa::Error();
 }
 
+ntsa::Error PortDatabase::reload(bool* reloaded)
+{
+    ntsa::Error error;
+
+    *reloaded = false;
+
+    ntcdns::DatabaseFileStamp current(d_allocator_p);
+    {
+        LockGuard lock(&d_mutex);
+        current = d_stamp;
+    }
+
+    if (!current.isDefined()) {
+        return ntsa::Error();
+    }
+
+    ntcdns::DatabaseFileStamp latest(d_allocator_p);
+    error = latest.load(current.path());
+    if (error) {
+        return error;
+    }
+
+    if (latest.equals(current) && !current.isRacy()) {
+        return ntsa::Error();
+    }
+
+    // The file may have changed: read it, but publish a new index only if
+    // its content actually differs.
+
+    bsl::shared_ptr<ntcdns::File> file;
+    file.createInplace(d_allocator_p, d_allocator_p);
+
+    error = file->load(current.path());
+    if (error) {
+        return error;
+    }
+
+    latest.setContent(file->data(), file->size());
+
+    if (latest.contentHash() == current.contentHash()) {
+        LockGuard lock(&d_mutex);
+        if (d_stamp.equals(current)) {
+            d_stamp = latest;
+        }
+        return ntsa::Error();
+    }
+
+    error = this->load(file, latest);
+    if (error) {
+        return error;
+    }
+
+    *reloaded = true;
+
+    return ntsa::Error();
+}
+
 ntsa::Error PortDatabase::getPort(ntca::GetPortContext*       context,
                                   bsl::vector<ntsa::Port>*    result,
                                   const bslstl::StringRef&    serviceName,
@@ -1267,13 +1873,18 @@ ntsa::Error PortDatabase::getPort(ntca::GetPortContext*       context,
     }
 
     {
-        LockGuard lock(&d_mutex);
+        ntcdns::DatabaseEpochGuard epochGuard(&d_epoch);
+
+        const Index* index = this->index();
+        if (!index) {
+            return ntsa::Error(ntsa::Error::e_EOF);
+        }
 
         if (examineTcpPortList) {
             PortByServiceName::const_iterator it =
-                d_tcpPortByServiceName.find(serviceName);
+                index->tcpPortByServiceName().find(serviceName);
 
-            if (it != d_tcpPortByServiceName.end()) {
+            if (it != index->tcpPortByServiceName().end()) {
                 if (!examineUdpPortList) {
                     portList.insert(portList.end(),
                                     it->second.begin(),
@@ -1299,9 +1910,9 @@ ntsa::Error PortDatabase::getPort(ntca::GetPortContext*       context,
 
         if (examineUdpPortList) {
             PortByServiceName::const_iterator it =
-                d_udpPortByServiceName.find(serviceName);
+                index->udpPortByServiceName().find(serviceName);
 
-            if (it != d_udpPortByServiceName.end()) {
+            if (it != index->udpPortByServiceName().end()) {
                 if (!examineTcpPortList) {
                     portList.insert(portList.end(),
                                     it->second.begin(),
@@ -1360,7 +1971,12 @@ ntsa::Error PortDatabase::getServiceName(
     const ntsa::Port&                  port,
     const ntca::GetServiceNameOptions& options) const
 {
-    LockGuard lock(&d_mutex);
+    ntcdns::DatabaseEpochGuard epochGuard(&d_epoch);
+
+    const Index* index = this->index();
+    if (!index) {
+        return ntsa::Error(ntsa::Error::e_EOF);
+    }
 
     bool found = false;
 
@@ -1370,9 +1986,9 @@ ntsa::Error PortDatabase::getServiceName(
             options.transport().value() == ntsa::Transport::e_TCP_IPV6_STREAM)
         {
             ServiceNameByPort::const_iterator it =
-                d_tcpServiceNameByPort.find(port);
+                index->tcpServiceNameByPort().find(port);
 
-            if (it == d_tcpServiceNameByPort.end()) {
+            if (it == index->tcpServiceNameByPort().end()) {
                 return ntsa::Error(ntsa::Error::e_EOF);
             }
 
@@ -1387,9 +2003,9 @@ ntsa::Error PortDatabase::getServiceName(
                      ntsa::Transport::e_UDP_IPV6_DATAGRAM)
         {
             ServiceNameByPort::const_iterator it =
-                d_udpServiceNameByPort.find(port);
+                index->udpServiceNameByPort().find(port);
 
-            if (it == d_udpServiceNameByPort.end()) {
+            if (it == index->udpServiceNameByPort().end()) {
                 return ntsa::Error(ntsa::Error::e_EOF);
             }
 
@@ -1405,9 +2021,9 @@ ntsa::Error PortDatabase::getServiceName(
     else {
         if (!found) {
             ServiceNameByPort::const_iterator it =
-                d_tcpServiceNameByPort.find(port);
+                index->tcpServiceNameByPort().find(port);
 
-            if (it != d_tcpServiceNameByPort.end()) {
+            if (it != index->tcpServiceNameByPort().end()) {
                 if (!it->second.empty()) {
                     *result = it->second;
                     found   = true;
@@ -1417,9 +2033,9 @@ ntsa::Error PortDatabase::getServiceName(
 
         if (!found) {
             ServiceNameByPort::const_iterator it =
-                d_udpServiceNameByPort.find(port);
+                index->udpServiceNameByPort().find(port);
 
-            if (it != d_udpServiceNameByPort.end()) {
+            if (it != index->udpServiceNameByPort().end()) {
                 if (!it->second.empty()) {
                     *result = it->second;
                     found   = true;
@@ -1442,15 +2058,26 @@ void PortDatabase::dump(bsl::vector<ntcdns::PortEntry>* result) const
 {
     result->clear();
 
-    LockGuard lock(&d_mutex);
+    ntcdns::DatabaseEpochGuard epochGuard(&d_epoch);
+
+    const Index* index = this->index();
+    if (!index) {
+        return;
+    }
+
+    const ServiceNameByPort& tcpServiceNameByPort =
+        index->tcpServiceNameByPort();
+
+    const ServiceNameByPort& udpServiceNameByPort =
+        index->udpServiceNameByPort();
 
-    result->reserve(d_tcpServiceNameByPort.size() +
-                    d_udpServiceNameByPort.size());
+    result->reserve(tcpServiceNameByPort.size() +
+                    udpServiceNameByPort.size());
 
-    if (!d_tcpServiceNameByPort.empty()) {
+    if (!tcpServiceNameByPort.empty()) {
         for (ServiceNameByPort::const_iterator it =
-                 d_tcpServiceNameByPort.begin();
-             it != d_tcpServiceNameByPort.end();
+                 tcpServiceNameByPort.begin();
+             it != tcpServiceNameByPort.end();
              ++it)
         {
             ntcdns::PortEntry portEntry;
@@ -1462,10 +2089,10 @@ void PortDatabase::dump(bsl::vector<ntcdns::PortEntry>* result) const
         }
     }
 
-    if (!d_udpServiceNameByPort.empty()) {
+    if (!udpServiceNameByPort.empty()) {
         for (ServiceNameByPort::const_iterator it =
-                 d_udpServiceNameByPort.begin();
-             it != d_udpServiceNameByPort.end();
+                 udpServiceNameByPort.begin();
+             it != udpServiceNameByPort.end();
              ++it)
         {
             ntcdns::PortEntry portEntry;
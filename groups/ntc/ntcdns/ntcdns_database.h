@@ -32,6 +32,10 @@
 #include <ntsa_ipaddress.h>
 #include <ntsa_port.h>
 #include <bdlma_multipoolallocator.h>
+#include <bdls_filesystemutil.h>
+#include <bdlt_datetime.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
 #include <bslmt_mutex.h>
 #include <bsl_memory.h>
 #include <bsl_string.h>
@@ -57,9 +61,178 @@ struct HostDatabaseUtil {
     static bsl::size_t hashIpv6(const ntsa::Ipv6Address& ipv6Address);
 };
 
+/// @internal @brief
+/// Describe the identity of a version of a database file.
+///
+/// @details
+/// A database file is assumed to have changed when its modification time,
+/// its size, or, on Unix platforms, its device, inode number, or status
+/// change time differs from that recorded when it was last loaded. The
+/// inode number detects a file replaced by renaming another over it, and
+/// the status change time, which a process cannot set, detects a rewrite
+/// in place that preserves both the size and the modification time.
+///
+/// Timestamps have a finite resolution, so a file modified shortly after it
+/// was stamped may keep the same stamp. Such a stamp is said to be racy,
+/// and a racy stamp is confirmed by comparing the hash of the content of
+/// the file instead.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcdns
+class DatabaseFileStamp
+{
+    bsl::string                  d_path;
+    bdlt::Datetime               d_modificationTime;
+    bdls::FilesystemUtil::Offset d_size;
+    bsls::Types::Uint64          d_device;
+    bsls::Types::Uint64          d_inode;
+    bsls::Types::Int64           d_changeTime;
+    bsls::Types::Int64           d_stampTime;
+    bsls::Types::Uint64          d_contentHash;
+
+  public:
+    /// Create a new, empty file stamp. Optionally specify a
+    /// 'basicAllocator' used to supply memory. If 'basicAllocator' is 0,
+    /// the currently installed default allocator is used.
+    explicit DatabaseFileStamp(bslma::Allocator* basicAllocator = 0);
+
+    /// Destroy this object.
+    ~DatabaseFileStamp();
+
+    /// Reset the value of this object to its value upon default
+    /// construction.
+    void reset();
+
+    /// Load the modification time, size, and, on Unix platforms, the
+    /// device, inode number, and status change time, in nanoseconds, of the
+    /// file at the specified 'path'. Return the error.
+    ntsa::Error load(const bslstl::StringRef& path);
+
+    /// Record the hash of the specified 'data' having the specified 'size'
+    /// as the content of the file.
+    void setContent(const char* data, bsl::size_t size);
+
+    /// Return the path to the file.
+    const bsl::string& path() const;
+
+    /// Return the hash of the content of the file, or zero if no content
+    /// has been recorded.
+    bsls::Types::Uint64 contentHash() const;
+
+    /// Return true if the file has a path, otherwise return false.
+    bool isDefined() const;
+
+    /// Return true if the file was last modified so shortly before it was
+    /// stamped that a subsequent modification might not change the stamp,
+    /// otherwise return false.
+    bool isRacy() const;
+
+    /// Return true if this object describes the same path, timestamps,
+    /// size, and file identity as the specified 'other' object, otherwise
+    /// return false. Note that the content hashes are not compared.
+    bool equals(const DatabaseFileStamp& other) const;
+};
+
+/// @internal @brief
+/// Provide deferred reclamation of the published index of a database.
+///
+/// @details
+/// Readers announce each lookup in one of two generations of reader counts,
+/// selected by the parity of the current epoch, and sharded by the identity
+/// of the reading thread so that readers on different threads update
+/// different cache lines. Neither announcing nor retiring a lookup locks.
+/// A writer, having atomically published a new index, calls 'synchronize'
+/// to advance the epoch and wait until no reader remains in the generation
+/// that may still observe the previous index, after which the previous
+/// index may be destroyed.
+///
+/// @par Thread Safety
+/// This class is thread safe, but 'synchronize' must be externally
+/// serialized with respect to itself.
+///
+/// @ingroup module_ntcdns
+class DatabaseEpoch
+{
+    enum {
+        /// The number of shards of reader counts.
+        k_NUM_SHARDS = 16,
+
+        /// The assumed size of a cache line, in bytes.
+        k_CACHE_LINE_SIZE = 64
+    };
+
+    /// Describe the reader counts of each generation of a shard, padded to
+    /// occupy a cache line of its own.
+    struct Shard {
+        bsls::AtomicInt d_count[2];
+        char            d_padding[k_CACHE_LINE_SIZE - 2 * sizeof(int)];
+    };
+
+    bsls::AtomicUint64 d_epoch;
+    Shard              d_shard[k_NUM_SHARDS];
+
+  private:
+    DatabaseEpoch(const DatabaseEpoch&) BSLS_KEYWORD_DELETED;
+    DatabaseEpoch& operator=(const DatabaseEpoch&) BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Create a new epoch.
+    DatabaseEpoch();
+
+    /// Destroy this object.
+    ~DatabaseEpoch();
+
+    /// Announce a lookup by the calling thread. Return the token that
+    /// identifies the reader count incremented, to be supplied to 'leave'.
+    bsl::size_t enter();
+
+    /// Retire the lookup identified by the specified 'token'.
+    void leave(bsl::size_t token);
+
+    /// Advance the epoch, then wait until every lookup announced before the
+    /// epoch was advanced has been retired.
+    void synchronize();
+};
+
+/// @internal @brief
+/// Provide a guard to announce a lookup for the lifetime of the guard.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcdns
+class DatabaseEpochGuard
+{
+    DatabaseEpoch* d_epoch_p;
+    bsl::size_t    d_token;
+
+  private:
+    DatabaseEpochGuard(const DatabaseEpochGuard&) BSLS_KEYWORD_DELETED;
+    DatabaseEpochGuard& operator=(const DatabaseEpochGuard&)
+        BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Announce a lookup in the specified 'epoch'.
+    explicit DatabaseEpochGuard(DatabaseEpoch* epoch);
+
+    /// Retire the lookup.
+    ~DatabaseEpochGuard();
+};
+
 /// @internal @brief
 /// Provide a database of domain names and addresses.
 ///
+/// @details
+/// The entries of the database are held in an immutable index that refers
+/// to the text of the file from which they were parsed. Loading a file
+/// builds a new index without holding any lock, then publishes it by
+/// atomically swapping a single pointer. Lookups are lock-free: each
+/// announces itself to an 'ntcdns::DatabaseEpoch', loads the pointer, and
+/// searches the index it loaded. The previous index is destroyed by the
+/// loader once every lookup that may have observed it has completed.
+///
 /// @par Thread Safety
 /// This class is thread safe.
 ///
@@ -123,6 +296,9 @@ class HostDatabase
         unordered_map<ntsa::IpAddress, bslstl::StringRef, IpAddressHash>
             DomainNameByIpAddress;
 
+    /// Provide an immutable index of the entries in a host database file.
+    class Index;
+
     /// Define a type alias for a mutex.
     typedef ntccfg::Mutex Mutex;
 
@@ -130,10 +306,9 @@ class HostDatabase
     typedef ntccfg::LockGuard LockGuard;
 
     mutable Mutex                 d_mutex;
-    bdlma::MultipoolAllocator     d_pool;
-    IpAddressByDomainName         d_ipAddressByDomainName;
-    DomainNameByIpAddress         d_domainNameByIpAddress;
-    bsl::shared_ptr<ntcdns::File> d_file_sp;
+    bsls::AtomicPointer<Index>    d_index_p;
+    mutable ntcdns::DatabaseEpoch d_epoch;
+    ntcdns::DatabaseFileStamp     d_stamp;
     bslma::Allocator*             d_allocator_p;
 
   private:
@@ -141,9 +316,20 @@ class HostDatabase
     HostDatabase& operator=(const HostDatabase&) BSLS_KEYWORD_DELETED;
 
   private:
-    /// Load the DNS host database from the specified 'file'. Return the
-    /// error.
-    ntsa::Error load(const bsl::shared_ptr<ntcdns::File>& file);
+    /// Load the DNS host database from the specified 'file' identified by
+    /// the specified 'stamp'. Return the error.
+    ntsa::Error load(const bsl::shared_ptr<ntcdns::File>& file,
+                     const ntcdns::DatabaseFileStamp&     stamp);
+
+    /// Publish the specified 'index', which may be null, then destroy the
+    /// previously published index once no lookup may still observe it.
+    /// The behavior is undefined unless the mutex is locked.
+    void publish(Index* index);
+
+    /// Return the index currently published, or null if no index is
+    /// published. The behavior is undefined unless the lookup is announced
+    /// by a 'DatabaseEpochGuard' that outlives every use of the result.
+    const Index* index() const;
 
   public:
     /// Create a new host database. Optionally specify a 'basicAllocator'
@@ -169,6 +355,13 @@ class HostDatabase
     /// the specified 'size'. Return the error.
     ntsa::Error loadText(const char* data, bsl::size_t size);
 
+    /// Reload the DNS host database from the file at the path from which it
+    /// was last loaded if that file has been modified since. Load into the
+    /// specified 'reloaded' flag whether the database was reloaded. Return
+    /// the error. Note that lookups proceed concurrently with a reload and
+    /// observe either the previous or the new entries, never a mixture.
+    ntsa::Error reload(bool* reloaded);
+
     /// Load into the specified 'result' the IP address list assigned to the
     /// specified 'domainName' according to the specified 'options' and
     /// load into the specified 'context' the context of resolution. Return
@@ -191,6 +384,11 @@ class HostDatabase
 /// @internal @brief
 /// Provide a database of service names and ports.
 ///
+/// @details
+/// The entries of the database are held in an immutable index that is
+/// rebuilt and swapped in its entirety when the database is loaded, as
+/// described for 'ntcdns::HostDatabase'.
+///
 /// @par Thread Safety
 /// This class is thread safe.
 ///
@@ -237,6 +435,9 @@ class PortDatabase
     typedef bsl::unordered_map<ntsa::Port, bslstl::StringRef>
         ServiceNameByPort;
 
+    /// Provide an immutable index of the entries in a port database file.
+    class Index;
+
     /// Define a type alias for a mutex.
     typedef ntccfg::Mutex Mutex;
 
@@ -244,11 +445,9 @@ class PortDatabase
     typedef ntccfg::LockGuard LockGuard;
 
     mutable Mutex                 d_mutex;
-    PortByServiceName             d_tcpPortByServiceName;
-    ServiceNameByPort             d_tcpServiceNameByPort;
-    PortByServiceName             d_udpPortByServiceName;
-    ServiceNameByPort             d_udpServiceNameByPort;
-    bsl::shared_ptr<ntcdns::File> d_file_sp;
+    bsls::AtomicPointer<Index>    d_index_p;
+    mutable ntcdns::DatabaseEpoch d_epoch;
+    ntcdns::DatabaseFileStamp     d_stamp;
     bslma::Allocator*             d_allocator_p;
 
   private:
@@ -256,9 +455,20 @@ class PortDatabase
     PortDatabase& operator=(const PortDatabase&) BSLS_KEYWORD_DELETED;
 
   private:
-    /// Load the DNS port database from the specified 'file'. Return the
-    /// error.
-    ntsa::Error load(const bsl::shared_ptr<ntcdns::File>& file);
+    /// Load the DNS port database from the specified 'file' identified by
+    /// the specified 'stamp'. Return the error.
+    ntsa::Error load(const bsl::shared_ptr<ntcdns::File>& file,
+                     const ntcdns::DatabaseFileStamp&     stamp);
+
+    /// Publish the specified 'index', which may be null, then destroy the
+    /// previously published index once no lookup may still observe it.
+    /// The behavior is undefined unless the mutex is locked.
+    void publish(Index* index);
+
+    /// Return the index currently published, or null if no index is
+    /// published. The behavior is undefined unless the lookup is announced
+    /// by a 'DatabaseEpochGuard' that outlives every use of the result.
+    const Index* index() const;
 
   public:
     /// Create a new port database. Optionally specify a 'basicAllocator'
@@ -284,6 +494,13 @@ class PortDatabase
     /// the specified 'size'. Return the error.
     ntsa::Error loadText(const char* data, bsl::size_t size);
 
+    /// Reload the DNS port database from the file at the path from which it
+    /// was last loaded if that file has been modified since. Load into the
+    /// specified 'reloaded' flag whether the database was reloaded. Return
+    /// the error. Note that lookups proceed concurrently with a reload and
+    /// observe either the previous or the new entries, never a mixture.
+    ntsa::Error reload(bool* reloaded);
+
     /// Load into the specified 'result' the port list assigned to the
     /// specified 'serviceName' according to the specified 'options' and
     /// load into the specified 'context' the context of resolution. Return
@@ -24,6 +24,17 @@ BSLS_IDENT_RCSID(ntcdns_database_t_cpp, "$Id$ $CSID$")
 #include <ntcdns_utility.h>
 #include <ntci_log.h>
 #include <ntsa_host.h>
+#include <ntsa_temporary.h>
+#include <bdlf_bind.h>
+#include <bslmt_threadgroup.h>
+#include <bsls_atomic.h>
+#include <bsls_platform.h>
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
 
 using namespace BloombergLP;
 
@@ -44,6 +55,15 @@ class DatabaseTest
     /// Dump the specified 'portDatabase' to the log.
     static void dump(const ntcdns::PortDatabase& portDatabase);
 
+    /// Look up the entries of the specified 'hostDatabase' until the
+    /// specified 'done' flag is set, incrementing the specified
+    /// 'numInconsistent' for each lookup whose result matches neither of
+    /// the contents loaded by 'verifyConcurrentReload'.
+    static void lookupConcurrently(
+        const ntcdns::HostDatabase* hostDatabase,
+        bsls::AtomicBool*           done,
+        bsls::AtomicUint64*         numInconsistent);
+
   public:
     // TODO
     static void verifyCase1();
@@ -56,6 +76,17 @@ class DatabaseTest
 
     // TODO
     static void verifyCase4();
+
+    // Verify host and port databases reload only when their files change.
+    static void verifyReload();
+
+    // Verify a host database reloads a file rewritten in place with the
+    // same size and modification time.
+    static void verifyReloadRewriteInPlace();
+
+    // Verify lookups concurrent with reloads of a host database observe
+    // either the previous or the new entries, never a mixture.
+    static void verifyConcurrentReload();
 };
 
 /// Provide a host database for use by this test driver. This class is thread
@@ -794,6 +825,67 @@ void DatabaseTest::dump(const ntcdns::PortDatabase& portDatabase)
     }
 }
 
+void DatabaseTest::lookupConcurrently(
+    const ntcdns::HostDatabase* hostDatabase,
+    bsls::AtomicBool*           done,
+    bsls::AtomicUint64*         numInconsistent)
+{
+    const ntsa::IpAddress k_OLD_1("10.0.0.1");
+    const ntsa::IpAddress k_OLD_2("10.0.0.2");
+    const ntsa::IpAddress k_NEW_1("10.0.1.1");
+    const ntsa::IpAddress k_NEW_2("10.0.1.2");
+
+    const ntsa::IpAddress k_SHARED("10.0.0.3");
+
+    bsl::vector<ntsa::IpAddress> ipAddressList;
+    bsl::string                  domainName;
+
+    do {
+        {
+            ntca::GetIpAddressContext context;
+            ntca::GetIpAddressOptions options;
+
+            ipAddressList.clear();
+            ntsa::Error error = hostDatabase->getIpAddress(&context,
+                                                           &ipAddressList,
+                                                           "test-concurrent",
+                                                           options);
+
+            bool consistent = false;
+            if (!error && ipAddressList.size() == 2) {
+                const ntsa::IpAddress& first  = ipAddressList[0];
+                const ntsa::IpAddress& second = ipAddressList[1];
+
+                consistent = (first == k_OLD_1 && second == k_OLD_2) ||
+                             (first == k_OLD_2 && second == k_OLD_1) ||
+                             (first == k_NEW_1 && second == k_NEW_2) ||
+                             (first == k_NEW_2 && second == k_NEW_1);
+            }
+
+            if (!consistent) {
+                ++(*numInconsistent);
+            }
+        }
+
+        {
+            ntca::GetDomainNameContext context;
+            ntca::GetDomainNameOptions options;
+
+            domainName.clear();
+            ntsa::Error error = hostDatabase->getDomainName(&context,
+                                                            &domainName,
+                                                            k_SHARED,
+                                                            options);
+
+            if (error || (domainName != "test-concurrent-old" &&
+                          domainName != "test-concurrent-new"))
+            {
+                ++(*numInconsistent);
+            }
+        }
+    } while (!done->load());
+}
+
 NTSCFG_TEST_FUNCTION(ntcdns::DatabaseTest::verifyCase1)
 {
     // Concern: Host database configurations from user-defined text.
@@ -2156,5 +2248,244 @@ NTSCFG_TEST_FUNCTION(ntcdns::DatabaseTest::verifyCase4)
     }
 }
 
+NTSCFG_TEST_FUNCTION(ntcdns::DatabaseTest::verifyReload)
+{
+    // Concern: Host and port databases loaded from a path are reloaded when,
+    // and only when, the file changes.
+    // Plan: Load each database from a temporary file, verify a reload
+    // without a change is a no-op, grow the file with different entries,
+    // then verify the reload publishes the new entries.
+
+    ntsa::Error error;
+    bool        reloaded;
+
+    ntsa::TemporaryDirectory tempDirectory(NTSCFG_TEST_ALLOCATOR);
+
+    {
+        ntsa::TemporaryFile tempFile(&tempDirectory, NTSCFG_TEST_ALLOCATOR);
+
+        error = tempFile.write("10.0.0.1 test-reload-1\n");
+        NTSCFG_TEST_OK(error);
+
+        ntcdns::HostDatabase hostDatabase(NTSCFG_TEST_ALLOCATOR);
+
+        error = hostDatabase.loadPath(tempFile.path());
+        NTSCFG_TEST_OK(error);
+
+        reloaded = true;
+        error    = hostDatabase.reload(&reloaded);
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_FALSE(reloaded);
+
+        error = tempFile.write("10.0.0.2 test-reload-2 test-reload-alias\n");
+        NTSCFG_TEST_OK(error);
+
+        reloaded = false;
+        error    = hostDatabase.reload(&reloaded);
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_TRUE(reloaded);
+
+        {
+            ntca::GetIpAddressContext context;
+            ntca::GetIpAddressOptions options;
+
+            bsl::vector<ntsa::IpAddress> ipAddressList;
+            error = hostDatabase.getIpAddress(&context,
+                                              &ipAddressList,
+                                              "test-reload-2",
+                                              options);
+            NTSCFG_TEST_OK(error);
+
+            NTSCFG_TEST_EQ(ipAddressList.size(), 1);
+            NTSCFG_TEST_EQ(ipAddressList[0], ntsa::IpAddress("10.0.0.2"));
+        }
+
+        {
+            ntca::GetIpAddressContext context;
+            ntca::GetIpAddressOptions options;
+
+            bsl::vector<ntsa::IpAddress> ipAddressList;
+            error = hostDatabase.getIpAddress(&context,
+                                              &ipAddressList,
+                                              "test-reload-1",
+                                              options);
+            NTSCFG_TEST_ERROR(error, ntsa::Error::e_EOF);
+        }
+    }
+
+    {
+        ntsa::TemporaryFile tempFile(&tempDirectory, NTSCFG_TEST_ALLOCATOR);
+
+        error = tempFile.write("test-reload-1 10001/tcp\n");
+        NTSCFG_TEST_OK(error);
+
+        ntcdns::PortDatabase portDatabase(NTSCFG_TEST_ALLOCATOR);
+
+        error = portDatabase.loadPath(tempFile.path());
+        NTSCFG_TEST_OK(error);
+
+        reloaded = true;
+        error    = portDatabase.reload(&reloaded);
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_FALSE(reloaded);
+
+        error = tempFile.write("test-reload-2 10002/tcp test-reload-alias\n");
+        NTSCFG_TEST_OK(error);
+
+        reloaded = false;
+        error    = portDatabase.reload(&reloaded);
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_TRUE(reloaded);
+
+        {
+            ntca::GetPortContext context;
+            ntca::GetPortOptions options;
+
+            options.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+
+            bsl::vector<ntsa::Port> portList;
+            error = portDatabase.getPort(&context,
+                                         &portList,
+                                         "test-reload-2",
+                                         options);
+            NTSCFG_TEST_OK(error);
+
+            NTSCFG_TEST_EQ(portList.size(), 1);
+            NTSCFG_TEST_EQ(portList[0], 10002);
+        }
+
+        {
+            ntca::GetPortContext context;
+            ntca::GetPortOptions options;
+
+            options.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+
+            bsl::vector<ntsa::Port> portList;
+            error = portDatabase.getPort(&context,
+                                         &portList,
+                                         "test-reload-1",
+                                         options);
+            NTSCFG_TEST_ERROR(error, ntsa::Error::e_EOF);
+        }
+    }
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::DatabaseTest::verifyReloadRewriteInPlace)
+{
+    // Concern: A host database loaded from a path is reloaded when its file
+    // is rewritten in place with content of the same size and its
+    // modification time is restored.
+    // Plan: Load the database from a temporary file, rewrite the file with
+    // different entries of the same length, restore the original
+    // modification time, then verify the reload publishes the new entries.
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+
+    ntsa::Error error;
+    bool        reloaded;
+    int         rc;
+
+    ntsa::TemporaryDirectory tempDirectory(NTSCFG_TEST_ALLOCATOR);
+    ntsa::TemporaryFile tempFile(&tempDirectory, NTSCFG_TEST_ALLOCATOR);
+
+    error = tempFile.write("10.0.0.1 test-reload-1\n");
+    NTSCFG_TEST_OK(error);
+
+    struct ::stat status;
+    rc = ::stat(tempFile.path().c_str(), &status);
+    NTSCFG_TEST_EQ(rc, 0);
+
+    ntcdns::HostDatabase hostDatabase(NTSCFG_TEST_ALLOCATOR);
+
+    error = hostDatabase.loadPath(tempFile.path());
+    NTSCFG_TEST_OK(error);
+
+    error = tempFile.write("10.0.0.2 test-reload-2\n");
+    NTSCFG_TEST_OK(error);
+
+    struct ::timespec times[2];
+    times[0] = status.st_atim;
+    times[1] = status.st_mtim;
+
+    rc = ::utimensat(AT_FDCWD, tempFile.path().c_str(), times, 0);
+    NTSCFG_TEST_EQ(rc, 0);
+
+    reloaded = false;
+    error    = hostDatabase.reload(&reloaded);
+    NTSCFG_TEST_OK(error);
+    NTSCFG_TEST_TRUE(reloaded);
+
+    ntca::GetIpAddressContext context;
+    ntca::GetIpAddressOptions options;
+
+    bsl::vector<ntsa::IpAddress> ipAddressList;
+    error = hostDatabase.getIpAddress(&context,
+                                      &ipAddressList,
+                                      "test-reload-2",
+                                      options);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(ipAddressList.size(), 1);
+    NTSCFG_TEST_EQ(ipAddressList[0], ntsa::IpAddress("10.0.0.2"));
+
+#endif
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::DatabaseTest::verifyConcurrentReload)
+{
+    // Concern: Lookups concurrent with reloads of a host database observe
+    // either the previous or the new entries, never a mixture, and never
+    // an index that has been destroyed.
+    // Plan: Look up the entries of a host database from several threads
+    // while the main thread repeatedly loads one of two contents that
+    // assign different addresses to the same names, then verify every
+    // lookup found exactly the entries of one of the two contents.
+
+    const bsl::size_t k_NUM_THREADS = 4;
+    const bsl::size_t k_NUM_RELOADS = 1000;
+
+    const char k_OLD[] = "10.0.0.1 test-concurrent\n"
+                         "10.0.0.2 test-concurrent\n"
+                         "10.0.0.3 test-concurrent-old\n";
+
+    const char k_NEW[] = "10.0.1.1 test-concurrent\n"
+                         "10.0.1.2 test-concurrent\n"
+                         "10.0.0.3 test-concurrent-new\n";
+
+    ntsa::Error error;
+
+    ntcdns::HostDatabase hostDatabase(NTSCFG_TEST_ALLOCATOR);
+
+    error = hostDatabase.loadText(k_OLD, sizeof k_OLD - 1);
+    NTSCFG_TEST_OK(error);
+
+    bsls::AtomicBool   done(false);
+    bsls::AtomicUint64 numInconsistent(0);
+
+    bslmt::ThreadGroup threadGroup(NTSCFG_TEST_ALLOCATOR);
+    threadGroup.addThreads(
+        bdlf::BindUtil::bind(&DatabaseTest::lookupConcurrently,
+                             &hostDatabase,
+                             &done,
+                             &numInconsistent),
+        static_cast<int>(k_NUM_THREADS));
+
+    for (bsl::size_t i = 0; i < k_NUM_RELOADS; ++i) {
+        if (i % 2 == 0) {
+            error = hostDatabase.loadText(k_NEW, sizeof k_NEW - 1);
+        }
+        else {
+            error = hostDatabase.loadText(k_OLD, sizeof k_OLD - 1);
+        }
+
+        NTSCFG_TEST_OK(error);
+    }
+
+    done.store(true);
+    threadGroup.joinAll();
+
+    NTSCFG_TEST_EQ(numInconsistent.load(), 0);
+}
+
 }  // close namespace ntcdns
 }  // close namespace BloombergLP
@@ -0,0 +1,329 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcdns_endpointcache.h>
+
+#include <ntci_log.h>
+
+#include <bdlb_nullablevalue.h>
+#include <bdlma_localsequentialallocator.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bsls_assert.h>
+#include <bsls_types.h>
+
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ntcdns {
+
+namespace {
+
+/// Append to the specified 'result' the specified 'tag' followed by the
+/// decimal representation of the specified 'value', if 'value' is not null,
+/// then a separator.
+template <typename TYPE>
+void appendAttribute(bsl::string*                     result,
+                     char                             tag,
+                     const bdlb::NullableValue<TYPE>& value)
+{
+    if (!value.isNull()) {
+        char  buffer[24];
+        char* end     = buffer + sizeof buffer;
+        char* current = end;
+
+        bsl::uint64_t number = static_cast<bsl::uint64_t>(value.value());
+        do {
+            *--current = static_cast<char>('0' + (number % 10));
+            number /= 10;
+        } while (number != 0);
+
+        result->push_back(tag);
+        result->append(current, end);
+    }
+
+    result->push_back('\0');
+}
+
+}  // close unnamed namespace
+
+/// This class describes an entry in the cache.
+class EndpointCache::Entry
+{
+    Entry(const Entry&) BSLS_KEYWORD_DELETED;
+    Entry& operator=(const Entry&) BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Create a new entry. Optionally specify a 'basicAllocator' used to
+    /// supply memory. If 'basicAllocator' is 0, the currently installed
+    /// default allocator is used.
+    explicit Entry(bslma::Allocator* basicAllocator = 0);
+
+    /// Destroy this object.
+    ~Entry();
+
+    bsl::string                         d_key;
+    bsl::vector<ntsa::Endpoint>         d_endpointList;
+    bdlb::NullableValue<ntsa::Endpoint> d_nameServer;
+    bsls::TimeInterval                  d_expiration;
+    EndpointCache::EntryList::iterator  d_iteratorByRecency;
+};
+
+EndpointCache::Entry::Entry(bslma::Allocator* basicAllocator)
+: d_key(basicAllocator)
+, d_endpointList(basicAllocator)
+, d_nameServer()
+, d_expiration()
+, d_iteratorByRecency()
+{
+}
+
+EndpointCache::Entry::~Entry()
+{
+}
+
+const bsl::size_t EndpointCache::k_DEFAULT_MAX_ENTRIES      = 1024;
+const bsl::size_t EndpointCache::k_DEFAULT_MAX_TIME_TO_LIVE = 60;
+
+void EndpointCache::loadKey(bsl::string*                    result,
+                            const bslstl::StringRef&        text,
+                            const ntca::GetEndpointOptions& options)
+{
+    // The deadline is deliberately excluded: it differs between otherwise
+    // identical resolutions and does not affect their result.
+
+    result->assign(text.data(), text.length());
+    result->push_back('\0');
+
+    if (!options.ipAddressFallback().isNull()) {
+        result->append(options.ipAddressFallback().value().text());
+    }
+    result->push_back('\0');
+
+    appendAttribute(result, 't', options.ipAddressType());
+    appendAttribute(result, 's', options.ipAddressSelector());
+    appendAttribute(result, 'p', options.portFallback());
+    appendAttribute(result, 'q', options.portSelector());
+    appendAttribute(result, 'x', options.transport());
+}
+
+EndpointCache::EndpointCache(bslma::Allocator* basicAllocator)
+: d_mutex()
+, d_entryByKey(basicAllocator)
+, d_entryList(basicAllocator)
+, d_maxEntries(k_DEFAULT_MAX_ENTRIES)
+, d_maxTimeToLive(k_DEFAULT_MAX_TIME_TO_LIVE)
+, d_numHits(0)
+, d_numMisses(0)
+, d_numEvictions(0)
+, d_numExpirations(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+EndpointCache::~EndpointCache()
+{
+}
+
+void EndpointCache::clear()
+{
+    EntryByKey entryByKey(d_allocator_p);
+    EntryList  entryList(d_allocator_p);
+
+    {
+        LockGuard lock(&d_mutex);
+
+        d_entryByKey.swap(entryByKey);
+        d_entryList.swap(entryList);
+    }
+}
+
+void EndpointCache::setMaxEntries(bsl::size_t value)
+{
+    LockGuard lock(&d_mutex);
+
+    d_maxEntries = value;
+
+    while (d_entryList.size() > d_maxEntries) {
+        d_entryByKey.erase(d_entryList.back()->d_key);
+        d_entryList.pop_back();
+        ++d_numEvictions;
+    }
+}
+
+void EndpointCache::setMaxTimeToLive(bsl::size_t value)
+{
+    LockGuard lock(&d_mutex);
+
+    d_maxTimeToLive = value;
+}
+
+void EndpointCache::update(const bslstl::StringRef&        text,
+                           const ntca::GetEndpointOptions& options,
+                           const ntca::GetEndpointContext& context,
+                           const bsls::TimeInterval&       now)
+{
+    NTCI_LOG_CONTEXT();
+
+    if (!EndpointCache::isCacheable(options)) {
+        return;
+    }
+
+    if (context.endpointList().empty()) {
+        return;
+    }
+
+    bsl::shared_ptr<Entry> entry;
+    entry.createInplace(d_allocator_p, d_allocator_p);
+
+    EndpointCache::loadKey(&entry->d_key, text, options);
+
+    entry->d_endpointList = context.endpointList();
+    entry->d_nameServer   = context.nameServer();
+
+    LockGuard lock(&d_mutex);
+
+    bsl::size_t timeToLive = d_maxTimeToLive;
+    if (!context.timeToLive().isNull()) {
+        if (context.timeToLive().value() < timeToLive) {
+            timeToLive = context.timeToLive().value();
+        }
+    }
+
+    if (timeToLive == 0 || d_maxEntries == 0) {
+        return;
+    }
+
+    entry->d_expiration =
+        now +
+        bsls::TimeInterval(static_cast<bsls::Types::Int64>(timeToLive), 0);
+
+    EntryByKey::iterator it = d_entryByKey.find(entry->d_key);
+    if (it != d_entryByKey.end()) {
+        d_entryList.erase(it->second->d_iteratorByRecency);
+        d_entryByKey.erase(it);
+    }
+
+    while (d_entryList.size() >= d_maxEntries) {
+        const bsl::shared_ptr<Entry>& victim = d_entryList.back();
+
+        NTCI_LOG_STREAM_TRACE << "Endpoint cache evicted '"
+                              << victim->d_key.c_str()
+                              << "': the limit of " << d_maxEntries
+                              << " entries has been reached"
+                              << NTCI_LOG_STREAM_END;
+
+        d_entryByKey.erase(victim->d_key);
+        d_entryList.pop_back();
+        ++d_numEvictions;
+    }
+
+    d_entryList.push_front(entry);
+    entry->d_iteratorByRecency = d_entryList.begin();
+
+    d_entryByKey.insert(EntryByKey::value_type(entry->d_key, entry));
+}
+
+ntsa::Error EndpointCache::getEndpoint(
+    ntca::GetEndpointContext*       context,
+    const bslstl::StringRef&        text,
+    const ntca::GetEndpointOptions& options,
+    const bsls::TimeInterval&       now)
+{
+    if (!EndpointCache::isCacheable(options)) {
+        return ntsa::Error(ntsa::Error::e_EOF);
+    }
+
+    // Build the key on the stack so that a hit does not allocate.
+
+    bdlma::LocalSequentialAllocator<256> keyAllocator;
+    bsl::string                          key(&keyAllocator);
+
+    EndpointCache::loadKey(&key, text, options);
+
+    LockGuard lock(&d_mutex);
+
+    EntryByKey::iterator it = d_entryByKey.find(key);
+    if (it == d_entryByKey.end()) {
+        ++d_numMisses;
+        return ntsa::Error(ntsa::Error::e_EOF);
+    }
+
+    const bsl::shared_ptr<Entry> entry = it->second;
+
+    if (now >= entry->d_expiration) {
+        d_entryList.erase(entry->d_iteratorByRecency);
+        d_entryByKey.erase(it);
+        ++d_numExpirations;
+        ++d_numMisses;
+        return ntsa::Error(ntsa::Error::e_EOF);
+    }
+
+    if (entry->d_iteratorByRecency != d_entryList.begin()) {
+        d_entryList.splice(d_entryList.begin(),
+                           d_entryList,
+                           entry->d_iteratorByRecency);
+    }
+
+    ++d_numHits;
+
+    context->setAuthority(bsl::string(text));
+    context->setEndpointList(entry->d_endpointList);
+    context->setSource(ntca::ResolverSource::e_CACHE);
+
+    if (!entry->d_nameServer.isNull()) {
+        context->setNameServer(entry->d_nameServer.value());
+    }
+
+    context->setTimeToLive(
+        static_cast<bsl::size_t>((entry->d_expiration - now).seconds()));
+
+    return ntsa::Error();
+}
+
+bsl::size_t EndpointCache::numEntries() const
+{
+    LockGuard lock(&d_mutex);
+    return d_entryList.size();
+}
+
+bsl::uint64_t EndpointCache::numHits() const
+{
+    return d_numHits.load();
+}
+
+bsl::uint64_t EndpointCache::numMisses() const
+{
+    return d_numMisses.load();
+}
+
+bsl::uint64_t EndpointCache::numEvictions() const
+{
+    return d_numEvictions.load();
+}
+
+bsl::uint64_t EndpointCache::numExpirations() const
+{
+    return d_numExpirations.load();
+}
+
+bool EndpointCache::isCacheable(const ntca::GetEndpointOptions& options)
+{
+    return options.ipAddressFilter().isNull() &&
+           options.portFilter().isNull();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
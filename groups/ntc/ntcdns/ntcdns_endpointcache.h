@@ -0,0 +1,168 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCDNS_ENDPOINTCACHE
+#define INCLUDED_NTCDNS_ENDPOINTCACHE
+
+#include <ntca_getendpointcontext.h>
+#include <ntca_getendpointoptions.h>
+#include <ntccfg_mutex.h>
+#include <ntcscm_version.h>
+
+#include <ntsa_endpoint.h>
+#include <ntsa_error.h>
+
+#include <bsls_atomic.h>
+#include <bsls_timeinterval.h>
+
+#include <bsl_cstdint.h>
+#include <bsl_list.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_unordered_map.h>
+
+namespace BloombergLP {
+namespace ntcdns {
+
+/// @internal @brief
+/// Provide a bounded cache of endpoints resolved from text.
+///
+/// @details
+/// This class stores the endpoints to which text of the form
+/// '<host>:<service>' was resolved according to a set of options, so that
+/// subsequent resolutions of the same text with the same options complete
+/// with a single hash lookup, without parsing the text and without
+/// consulting the overrides, databases, caches, or name servers again. Each
+/// entry expires after the time-to-live of the records from which it was
+/// resolved, if known, but no later than the maximum time-to-live. When the
+/// cache is full, the least recently used entry is evicted to make room for a
+/// new one. Resolutions whose options specify an IP address filter or a port
+/// filter are never cached, since those filters are arbitrary functions that
+/// cannot be compared.
+///
+/// @par Thread Safety
+/// This class is thread safe.
+///
+/// @ingroup module_ntcdns
+class EndpointCache
+{
+    /// This class describes an entry in the cache.
+    class Entry;
+
+    /// Define a type alias for a list of entries, ordered from the most
+    /// recently used to the least recently used.
+    typedef bsl::list<bsl::shared_ptr<Entry> > EntryList;
+
+    /// Define a type alias for a map of keys to entries.
+    typedef bsl::unordered_map<bsl::string, bsl::shared_ptr<Entry> >
+        EntryByKey;
+
+    /// Define a type alias for a mutex.
+    typedef ntccfg::Mutex Mutex;
+
+    /// Define a type alias for a mutex lock guard.
+    typedef ntccfg::LockGuard LockGuard;
+
+    mutable Mutex              d_mutex;
+    EntryByKey                 d_entryByKey;
+    EntryList                  d_entryList;
+    bsl::size_t                d_maxEntries;
+    bsl::size_t                d_maxTimeToLive;
+    mutable bsls::AtomicUint64 d_numHits;
+    mutable bsls::AtomicUint64 d_numMisses;
+    mutable bsls::AtomicUint64 d_numEvictions;
+    mutable bsls::AtomicUint64 d_numExpirations;
+    bslma::Allocator*          d_allocator_p;
+
+  private:
+    EndpointCache(const EndpointCache&) BSLS_KEYWORD_DELETED;
+    EndpointCache& operator=(const EndpointCache&) BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Load into the specified 'result' the key identifying the resolution
+    /// of the specified 'text' according to the specified 'options'.
+    static void loadKey(bsl::string*                    result,
+                        const bslstl::StringRef&        text,
+                        const ntca::GetEndpointOptions& options);
+
+  public:
+    /// The default maximum number of entries.
+    static const bsl::size_t k_DEFAULT_MAX_ENTRIES;
+
+    /// The default maximum time-to-live of each entry, in seconds.
+    static const bsl::size_t k_DEFAULT_MAX_TIME_TO_LIVE;
+
+    /// Create a new endpoint cache. Optionally specify a 'basicAllocator'
+    /// used to supply memory. If 'basicAllocator' is 0, the currently
+    /// installed default allocator is used.
+    explicit EndpointCache(bslma::Allocator* basicAllocator = 0);
+
+    /// Destroy this object.
+    ~EndpointCache();
+
+    /// Remove all entries from the cache.
+    void clear();
+
+    /// Set the maximum number of entries to the specified 'value'. If
+    /// 'value' is zero, nothing is cached.
+    void setMaxEntries(bsl::size_t value);
+
+    /// Set the maximum time-to-live of each entry, in seconds, to the
+    /// specified 'value'. If 'value' is zero, nothing is cached.
+    void setMaxTimeToLive(bsl::size_t value);
+
+    /// Store the endpoints described by the specified 'context' as the
+    /// resolution of the specified 'text' according to the specified
+    /// 'options' at the specified 'now' time, unless the 'options' are not
+    /// cacheable or the 'context' describes no endpoints or a zero
+    /// time-to-live.
+    void update(const bslstl::StringRef&        text,
+                const ntca::GetEndpointOptions& options,
+                const ntca::GetEndpointContext& context,
+                const bsls::TimeInterval&       now);
+
+    /// Load into the specified 'context' the endpoints to which the
+    /// specified 'text' was resolved according to the specified 'options',
+    /// if that resolution is cached and has not expired at the specified
+    /// 'now' time. Return the error, notably 'ntsa::Error::e_EOF' if the
+    /// resolution is not cached.
+    ntsa::Error getEndpoint(ntca::GetEndpointContext*       context,
+                            const bslstl::StringRef&        text,
+                            const ntca::GetEndpointOptions& options,
+                            const bsls::TimeInterval&       now);
+
+    /// Return the number of entries in the cache.
+    bsl::size_t numEntries() const;
+
+    /// Return the number of lookups that found an unexpired entry.
+    bsl::uint64_t numHits() const;
+
+    /// Return the number of lookups that did not find an unexpired entry.
+    bsl::uint64_t numMisses() const;
+
+    /// Return the number of entries evicted to make room for a new entry.
+    bsl::uint64_t numEvictions() const;
+
+    /// Return the number of entries removed because they expired.
+    bsl::uint64_t numExpirations() const;
+
+    /// Return true if resolutions according to the specified 'options' may
+    /// be cached, otherwise return false.
+    static bool isCacheable(const ntca::GetEndpointOptions& options);
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
@@ -0,0 +1,274 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcdns_endpointcache_t_cpp, "$Id$ $CSID$")
+
+#include <ntcdns_endpointcache.h>
+
+#include <ntci_log.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcdns {
+
+// Provide tests for 'ntcdns::EndpointCache'.
+class EndpointCacheTest
+{
+    // Load into the specified 'result' a context describing the resolution
+    // of the specified 'text' to the specified 'endpoint' having the
+    // optionally specified 'timeToLive'.
+    static void load(ntca::GetEndpointContext*               result,
+                     const bsl::string&                      text,
+                     const bsl::string&                      endpoint,
+                     const bdlb::NullableValue<bsl::size_t>& timeToLive =
+                         bdlb::NullableValue<bsl::size_t>());
+
+    // Filter the specified 'ipAddressList'. Do nothing.
+    static void filter(bsl::vector<ntsa::IpAddress>* ipAddressList);
+
+  public:
+    // Verify resolutions are found only for the same text and options.
+    static void verifyLookup();
+
+    // Verify entries expire after the minimum of the time-to-live of their
+    // records and the maximum time-to-live.
+    static void verifyExpiration();
+
+    // Verify the least recently used entry is evicted when the cache is
+    // full.
+    static void verifyEviction();
+};
+
+void EndpointCacheTest::load(
+    ntca::GetEndpointContext*               result,
+    const bsl::string&                      text,
+    const bsl::string&                      endpoint,
+    const bdlb::NullableValue<bsl::size_t>& timeToLive)
+{
+    bsl::vector<ntsa::Endpoint> endpointList;
+    endpointList.push_back(ntsa::Endpoint(endpoint));
+
+    result->reset();
+    result->setAuthority(text);
+    result->setEndpointList(endpointList);
+    result->setSource(ntca::ResolverSource::e_SERVER);
+
+    if (!timeToLive.isNull()) {
+        result->setTimeToLive(timeToLive.value());
+    }
+}
+
+void EndpointCacheTest::filter(bsl::vector<ntsa::IpAddress>* ipAddressList)
+{
+    NTCCFG_WARNING_UNUSED(ipAddressList);
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::EndpointCacheTest::verifyLookup)
+{
+    ntsa::Error error;
+
+    const bsls::TimeInterval now(1000, 0);
+
+    ntcdns::EndpointCache endpointCache(NTSCFG_TEST_ALLOCATOR);
+
+    ntca::GetEndpointOptions options;
+    options.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+
+    {
+        ntca::GetEndpointContext context;
+        error = endpointCache.getEndpoint(&context,
+                                          "test.example.com:http",
+                                          options,
+                                          now);
+        NTSCFG_TEST_ERROR(error, ntsa::Error::e_EOF);
+    }
+
+    {
+        ntca::GetEndpointContext context;
+        EndpointCacheTest::load(&context,
+                                "test.example.com:http",
+                                "10.0.0.1:80",
+                                30);
+
+        endpointCache.update("test.example.com:http", options, context, now);
+        NTSCFG_TEST_EQ(endpointCache.numEntries(), 1);
+    }
+
+    {
+        ntca::GetEndpointOptions deadlineOptions(options);
+        deadlineOptions.setDeadline(now + bsls::TimeInterval(5, 0));
+
+        ntca::GetEndpointContext context;
+        error = endpointCache.getEndpoint(&context,
+                                          "test.example.com:http",
+                                          deadlineOptions,
+                                          now);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(context.authority(), "test.example.com:http");
+        NTSCFG_TEST_EQ(context.source(), ntca::ResolverSource::e_CACHE);
+        NTSCFG_TEST_EQ(context.endpointList().size(), 1);
+        NTSCFG_TEST_EQ(context.endpointList()[0],
+                       ntsa::Endpoint("10.0.0.1:80"));
+        NTSCFG_TEST_FALSE(context.timeToLive().isNull());
+        NTSCFG_TEST_EQ(context.timeToLive().value(), 30);
+    }
+
+    {
+        ntca::GetEndpointOptions otherOptions;
+        otherOptions.setTransport(ntsa::Transport::e_TCP_IPV6_STREAM);
+
+        ntca::GetEndpointContext context;
+        error = endpointCache.getEndpoint(&context,
+                                          "test.example.com:http",
+                                          otherOptions,
+                                          now);
+        NTSCFG_TEST_ERROR(error, ntsa::Error::e_EOF);
+    }
+
+    {
+        ntca::GetEndpointContext context;
+        error = endpointCache.getEndpoint(&context,
+                                          "test.example.com:https",
+                                          options,
+                                          now);
+        NTSCFG_TEST_ERROR(error, ntsa::Error::e_EOF);
+    }
+
+    {
+        ntca::GetEndpointOptions filterOptions(options);
+        filterOptions.setIpAddressFilter(&EndpointCacheTest::filter);
+
+        NTSCFG_TEST_FALSE(ntcdns::EndpointCache::isCacheable(filterOptions));
+
+        ntca::GetEndpointContext context;
+        error = endpointCache.getEndpoint(&context,
+                                          "test.example.com:http",
+                                          filterOptions,
+                                          now);
+        NTSCFG_TEST_ERROR(error, ntsa::Error::e_EOF);
+    }
+
+    NTSCFG_TEST_EQ(endpointCache.numHits(), 1);
+    NTSCFG_TEST_EQ(endpointCache.numMisses(), 3);
+
+    endpointCache.clear();
+    NTSCFG_TEST_EQ(endpointCache.numEntries(), 0);
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::EndpointCacheTest::verifyExpiration)
+{
+    ntsa::Error error;
+
+    const bsls::TimeInterval now(1000, 0);
+
+    ntcdns::EndpointCache endpointCache(NTSCFG_TEST_ALLOCATOR);
+    endpointCache.setMaxTimeToLive(60);
+
+    ntca::GetEndpointOptions options;
+
+    {
+        ntca::GetEndpointContext context;
+
+        EndpointCacheTest::load(&context, "short:80", "10.0.0.1:80", 5);
+        endpointCache.update("short:80", options, context, now);
+
+        EndpointCacheTest::load(&context, "long:80", "10.0.0.2:80", 3600);
+        endpointCache.update("long:80", options, context, now);
+
+        EndpointCacheTest::load(&context, "unknown:80", "10.0.0.3:80");
+        endpointCache.update("unknown:80", options, context, now);
+
+        EndpointCacheTest::load(&context, "zero:80", "10.0.0.4:80", 0);
+        endpointCache.update("zero:80", options, context, now);
+    }
+
+    NTSCFG_TEST_EQ(endpointCache.numEntries(), 3);
+
+    {
+        const bsls::TimeInterval later = now + bsls::TimeInterval(5, 0);
+
+        ntca::GetEndpointContext context;
+        error =
+            endpointCache.getEndpoint(&context, "short:80", options, later);
+        NTSCFG_TEST_ERROR(error, ntsa::Error::e_EOF);
+
+        error = endpointCache.getEndpoint(&context, "long:80", options, later);
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_EQ(context.timeToLive().value(), 55);
+
+        error =
+            endpointCache.getEndpoint(&context, "unknown:80", options, later);
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_EQ(context.timeToLive().value(), 55);
+    }
+
+    {
+        const bsls::TimeInterval later = now + bsls::TimeInterval(60, 0);
+
+        ntca::GetEndpointContext context;
+        error = endpointCache.getEndpoint(&context, "long:80", options, later);
+        NTSCFG_TEST_ERROR(error, ntsa::Error::e_EOF);
+    }
+
+    NTSCFG_TEST_EQ(endpointCache.numExpirations(), 2);
+    NTSCFG_TEST_EQ(endpointCache.numEntries(), 1);
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::EndpointCacheTest::verifyEviction)
+{
+    ntsa::Error error;
+
+    const bsls::TimeInterval now(1000, 0);
+
+    ntcdns::EndpointCache endpointCache(NTSCFG_TEST_ALLOCATOR);
+    endpointCache.setMaxEntries(2);
+
+    ntca::GetEndpointOptions options;
+    ntca::GetEndpointContext context;
+
+    EndpointCacheTest::load(&context, "a:80", "10.0.0.1:80");
+    endpointCache.update("a:80", options, context, now);
+
+    EndpointCacheTest::load(&context, "b:80", "10.0.0.2:80");
+    endpointCache.update("b:80", options, context, now);
+
+    // Touch "a:80" so that "b:80" becomes the least recently used entry.
+
+    error = endpointCache.getEndpoint(&context, "a:80", options, now);
+    NTSCFG_TEST_OK(error);
+
+    EndpointCacheTest::load(&context, "c:80", "10.0.0.3:80");
+    endpointCache.update("c:80", options, context, now);
+
+    NTSCFG_TEST_EQ(endpointCache.numEntries(), 2);
+    NTSCFG_TEST_EQ(endpointCache.numEvictions(), 1);
+
+    error = endpointCache.getEndpoint(&context, "a:80", options, now);
+    NTSCFG_TEST_OK(error);
+
+    error = endpointCache.getEndpoint(&context, "b:80", options, now);
+    NTSCFG_TEST_ERROR(error, ntsa::Error::e_EOF);
+
+    error = endpointCache.getEndpoint(&context, "c:80", options, now);
+    NTSCFG_TEST_OK(error);
+}
+
+}  // close namespace ntcdns
+}  // close namespace BloombergLP
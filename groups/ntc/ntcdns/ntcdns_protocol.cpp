@@ -155,10 +155,71 @@ ntsa::Error Validation::checkCoherentRdataLength(bsl::size_t expected,
     return ntsa::Error();
 }
 
+bool MemoryEncoder::matchDomainName(bsl::size_t              offset,
+                                    const bslstl::StringRef* labelArray,
+                                    bsl::size_t              numLabels) const
+{
+    const bsl::uint8_t* current = d_begin + offset;
+
+    bsl::size_t labelIndex = 0;
+    bsl::size_t numJumps   = 0;
+
+    while (true) {
+        if (current >= d_current) {
+            return false;
+        }
+
+        const bsl::uint8_t length = *current;
+
+        if (length == 0) {
+            return labelIndex == numLabels;
+        }
+
+        if ((length & 0xC0) == 0xC0) {
+            if (current + 1 >= d_current) {
+                return false;
+            }
+
+            const bsl::size_t maxJumps =
+                Validation::k_MAX_LABEL_RESOLUTION_RECURSION_DEPTH;
+
+            if (++numJumps > maxJumps) {
+                return false;
+            }
+
+            current = d_begin + (((length & 0x3F) << 8) | current[1]);
+            continue;
+        }
+
+        if (labelIndex == numLabels) {
+            return false;
+        }
+
+        const bslstl::StringRef& label = labelArray[labelIndex];
+
+        if (length != label.size()) {
+            return false;
+        }
+
+        if (current + 1 + length > d_current) {
+            return false;
+        }
+
+        if (0 != bsl::memcmp(current + 1, label.data(), length)) {
+            return false;
+        }
+
+        current += 1 + length;
+        ++labelIndex;
+    }
+}
+
 MemoryEncoder::MemoryEncoder(uint8_t* data, bsl::size_t size)
 : d_begin(data)
 , d_current(data)
 , d_end(data + size)
+, d_nameOffsetCount(0)
+, d_compress(true)
 {
 }
 
@@ -224,6 +285,9 @@ ntsa::Error MemoryEncoder::encodeDomainName(const bsl::string& value)
 {
     ntsa::Error error;
 
+    bslstl::StringRef labelArray[k_MAX_LABELS];
+    bsl::size_t       numLabels = 0;
+
     bdlb::Tokenizer tokenizer(value, ".", "");
 
     while (tokenizer.isValid()) {
@@ -234,6 +298,46 @@ ntsa::Error MemoryEncoder::encodeDomainName(const bsl::string& value)
             return error;
         }
 
+        if (numLabels == k_MAX_LABELS) {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        labelArray[numLabels++] = token;
+
+        ++tokenizer;
+    }
+
+    // Find the longest sequence of trailing labels that has already been
+    // encoded, if any. Only those labels that precede it are encoded
+    // literally, followed by a pointer to its earlier occurrence.
+
+    bsl::size_t numLiteralLabels = numLabels;
+    bsl::size_t pointerOffset    = 0;
+
+    if (d_compress) {
+        for (bsl::size_t i = 0; i < numLabels; ++i) {
+            for (bsl::size_t j = 0; j < d_nameOffsetCount; ++j) {
+                if (this->matchDomainName(d_nameOffsetArray[j],
+                                          labelArray + i,
+                                          numLabels - i))
+                {
+                    numLiteralLabels = i;
+                    pointerOffset    = d_nameOffsetArray[j];
+                    break;
+                }
+            }
+
+            if (numLiteralLabels != numLabels) {
+                break;
+            }
+        }
+    }
+
+    for (bsl::size_t i = 0; i < numLiteralLabels; ++i) {
+        const bslstl::StringRef& token = labelArray[i];
+
+        const bsl::size_t position = d_current - d_begin;
+
         bsl::uint8_t length = static_cast<bsl::uint8_t>(token.size());
 
         error = Validation::checkOverflow(d_end - d_current, sizeof length);
@@ -252,7 +356,17 @@ ntsa::Error MemoryEncoder::encodeDomainName(const bsl::string& value)
         bsl::memcpy(d_current, token.data(), token.size());
         d_current += token.size();
 
-        ++tokenizer;
+        if (d_compress && position <= k_MAX_POINTER_OFFSET &&
+            d_nameOffsetCount < k_MAX_NAME_OFFSETS)
+        {
+            d_nameOffsetArray[d_nameOffsetCount++] =
+                static_cast<bsl::uint16_t>(position);
+        }
+    }
+
+    if (numLiteralLabels != numLabels) {
+        return this->encodeUint16(
+            static_cast<bsl::uint16_t>(0xC000 | pointerOffset));
     }
 
     error = Validation::checkOverflow(d_end - d_current, 1);
@@ -348,6 +462,11 @@ ntsa::Error MemoryEncoder::encodeRaw(const void* value, bsl::size_t size)
     return ntsa::Error();
 }
 
+void MemoryEncoder::setCompressionEnabled(bool value)
+{
+    d_compress = value;
+}
+
 ntsa::Error MemoryEncoder::seek(bsl::size_t position)
 {
     bsl::uint8_t* target = d_begin + position;
@@ -812,6 +931,341 @@ bsl::size_t MemoryDecoder::capacity() const
     return d_end - d_begin;
 }
 
+ntsa::Error NameView::nextLabel(bslstl::StringRef* label,
+                                bsl::size_t*       position,
+                                bsl::size_t*       numJumps) const
+{
+    const bsl::size_t size = d_end - d_begin;
+
+    while (true) {
+        if (*position >= size) {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        const bsl::uint8_t length = d_begin[*position];
+
+        if (length == 0) {
+            label->reset();
+            return ntsa::Error();
+        }
+
+        if (length <= Validation::k_MAX_LABEL_LENGTH) {
+            if (*position + 1 + length > size) {
+                return ntsa::Error(ntsa::Error::e_INVALID);
+            }
+
+            label->assign(
+                reinterpret_cast<const char*>(d_begin + *position + 1),
+                length);
+
+            *position += 1 + length;
+            return ntsa::Error();
+        }
+
+        if ((length & 0xC0) != 0xC0) {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        if (*position + 1 >= size) {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        if (++(*numJumps) > Validation::k_MAX_LABEL_RESOLUTION_RECURSION_DEPTH)
+        {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        *position = ((length & 0x3F) << 8) | d_begin[*position + 1];
+    }
+}
+
+NameView::NameView()
+: d_begin(0)
+, d_end(0)
+, d_offset(0)
+{
+}
+
+NameView::NameView(const bsl::uint8_t* data,
+                   bsl::size_t         size,
+                   bsl::size_t         offset)
+: d_begin(data)
+, d_end(data + size)
+, d_offset(offset)
+{
+}
+
+ntsa::Error NameView::decode(MemoryDecoder* decoder)
+{
+    ntsa::Error error;
+
+    d_begin  = decoder->begin();
+    d_end    = decoder->end();
+    d_offset = decoder->position();
+
+    while (true) {
+        bsl::uint8_t length = 0;
+        error               = decoder->decodeUint8(&length);
+        if (error) {
+            return error;
+        }
+
+        if (length == 0) {
+            break;
+        }
+
+        if (length <= Validation::k_MAX_LABEL_LENGTH) {
+            error = decoder->advance(length);
+            if (error) {
+                return error;
+            }
+        }
+        else if ((length & 0xC0) == 0xC0) {
+            error = decoder->advance(1);
+            if (error) {
+                return error;
+            }
+
+            break;
+        }
+        else {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+    }
+
+    return ntsa::Error();
+}
+
+ntsa::Error NameView::load(bsl::string* result) const
+{
+    ntsa::Error error;
+
+    result->clear();
+
+    if (this->isNull()) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    bsl::size_t position = d_offset;
+    bsl::size_t numJumps = 0;
+
+    while (true) {
+        bslstl::StringRef label;
+        error = this->nextLabel(&label, &position, &numJumps);
+        if (error) {
+            return error;
+        }
+
+        if (label.isEmpty()) {
+            break;
+        }
+
+        if (!result->empty()) {
+            result->append(1, '.');
+        }
+
+        result->append(label.data(), label.length());
+    }
+
+    return ntsa::Error();
+}
+
+bool NameView::equals(const bslstl::StringRef& name) const
+{
+    if (this->isNull()) {
+        return false;
+    }
+
+    bsl::size_t position = d_offset;
+    bsl::size_t numJumps = 0;
+    bsl::size_t index    = 0;
+
+    while (true) {
+        bslstl::StringRef label;
+        ntsa::Error       error =
+            this->nextLabel(&label, &position, &numJumps);
+        if (error) {
+            return false;
+        }
+
+        if (label.isEmpty()) {
+            break;
+        }
+
+        if (index > 0) {
+            if (index >= name.length() || name[index] != '.') {
+                return false;
+            }
+
+            ++index;
+        }
+
+        if (name.length() - index < label.length()) {
+            return false;
+        }
+
+        if (!bdlb::String::areEqualCaseless(
+                label.data(),
+                static_cast<int>(label.length()),
+                name.data() + index,
+                static_cast<int>(label.length())))
+        {
+            return false;
+        }
+
+        index += label.length();
+    }
+
+    return index == name.length() ||
+           (index + 1 == name.length() && name[index] == '.');
+}
+
+bool NameView::isNull() const
+{
+    return d_begin == 0;
+}
+
+ResourceRecordView::ResourceRecordView()
+: d_name()
+, d_type(0)
+, d_class(0)
+, d_ttl(0)
+, d_begin(0)
+, d_end(0)
+, d_rdataOffset(0)
+, d_rdataLength(0)
+{
+}
+
+ntsa::Error ResourceRecordView::decode(MemoryDecoder* decoder)
+{
+    ntsa::Error error;
+
+    error = d_name.decode(decoder);
+    if (error) {
+        return error;
+    }
+
+    error = decoder->decodeUint16(&d_type);
+    if (error) {
+        return error;
+    }
+
+    error = decoder->decodeUint16(&d_class);
+    if (error) {
+        return error;
+    }
+
+    error = decoder->decodeUint32(&d_ttl);
+    if (error) {
+        return error;
+    }
+
+    bsl::uint16_t rdataLength = 0;
+    error                     = decoder->decodeUint16(&rdataLength);
+    if (error) {
+        return error;
+    }
+
+    d_begin       = decoder->begin();
+    d_end         = decoder->end();
+    d_rdataOffset = decoder->position();
+    d_rdataLength = rdataLength;
+
+    error = Validation::checkUnderflow(decoder->end() - decoder->current(),
+                                       rdataLength);
+    if (error) {
+        return error;
+    }
+
+    return decoder->advance(rdataLength);
+}
+
+ntsa::Error ResourceRecordView::loadIpAddress(ntsa::IpAddress* result) const
+{
+    if (this->isIpv4()) {
+        if (d_rdataLength != 4) {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        result->makeV4().copyFrom(d_begin + d_rdataOffset, d_rdataLength);
+        return ntsa::Error();
+    }
+
+    if (this->isIpv6()) {
+        if (d_rdataLength != 16) {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        result->makeV6().copyFrom(d_begin + d_rdataOffset, d_rdataLength);
+        return ntsa::Error();
+    }
+
+    return ntsa::Error(ntsa::Error::e_INVALID);
+}
+
+ntsa::Error ResourceRecordView::loadDomainName(ntcdns::NameView* result) const
+{
+    if (d_type != static_cast<bsl::uint16_t>(ntcdns::Type::e_CNAME) &&
+        d_type != static_cast<bsl::uint16_t>(ntcdns::Type::e_NS) &&
+        d_type != static_cast<bsl::uint16_t>(ntcdns::Type::e_PTR))
+    {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    if (d_rdataLength == 0) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    *result = ntcdns::NameView(d_begin, d_end - d_begin, d_rdataOffset);
+    return ntsa::Error();
+}
+
+const ntcdns::NameView& ResourceRecordView::name() const
+{
+    return d_name;
+}
+
+bsl::uint16_t ResourceRecordView::type() const
+{
+    return d_type;
+}
+
+bsl::uint16_t ResourceRecordView::classification() const
+{
+    return d_class;
+}
+
+bsl::uint32_t ResourceRecordView::ttl() const
+{
+    return d_ttl;
+}
+
+const bsl::uint8_t* ResourceRecordView::rdata() const
+{
+    return d_begin + d_rdataOffset;
+}
+
+bsl::size_t ResourceRecordView::rdataLength() const
+{
+    return d_rdataLength;
+}
+
+bool ResourceRecordView::isIpv4() const
+{
+    return d_type == static_cast<bsl::uint16_t>(ntcdns::Type::e_A);
+}
+
+bool ResourceRecordView::isIpv6() const
+{
+    return d_type == static_cast<bsl::uint16_t>(ntcdns::Type::e_AAAA);
+}
+
+bool ResourceRecordView::isPointer() const
+{
+    return d_type == static_cast<bsl::uint16_t>(ntcdns::Type::e_PTR);
+}
+
 Header::Header()
 : d_id(0)
 , d_direction(ntcdns::Direction::e_REQUEST)
@@ -2522,5 +2976,129 @@ bool operator!=(const Message& lhs, const Message& rhs)
     return !operator==(lhs, rhs);
 }
 
+MessageView::MessageView()
+: d_header()
+, d_question()
+, d_data(0)
+, d_size(0)
+, d_answerOffset(0)
+{
+}
+
+ntsa::Error MessageView::decode(const bsl::uint8_t* data, bsl::size_t size)
+{
+    ntsa::Error error;
+
+    ntcdns::MemoryDecoder decoder(data, size);
+
+    d_header.reset();
+    d_question = ntcdns::NameView();
+
+    d_data         = data;
+    d_size         = size;
+    d_answerOffset = 0;
+
+    error = d_header.decode(&decoder);
+    if (error) {
+        return error;
+    }
+
+    const bsl::size_t numQdRecords = d_header.qdcount();
+    for (bsl::size_t i = 0; i < numQdRecords; ++i) {
+        ntcdns::NameView name;
+        error = name.decode(&decoder);
+        if (error) {
+            return error;
+        }
+
+        // Skip the "QTYPE" and "QCLASS" fields.
+
+        error = Validation::checkUnderflow(decoder.end() - decoder.current(),
+                                           4);
+        if (error) {
+            return error;
+        }
+
+        error = decoder.advance(4);
+        if (error) {
+            return error;
+        }
+
+        if (i == 0) {
+            d_question = name;
+        }
+    }
+
+    d_answerOffset = decoder.position();
+
+    return ntsa::Error();
+}
+
+const ntcdns::Header& MessageView::header() const
+{
+    return d_header;
+}
+
+const ntcdns::NameView& MessageView::question() const
+{
+    return d_question;
+}
+
+bsl::uint16_t MessageView::id() const
+{
+    return d_header.id();
+}
+
+bool MessageView::tc() const
+{
+    return d_header.tc();
+}
+
+ntcdns::Error::Value MessageView::error() const
+{
+    return d_header.error();
+}
+
+bsl::size_t MessageView::qdcount() const
+{
+    return d_header.qdcount();
+}
+
+bsl::size_t MessageView::ancount() const
+{
+    return d_header.ancount();
+}
+
+bsl::size_t MessageView::answerOffset() const
+{
+    return d_answerOffset;
+}
+
+const bsl::uint8_t* MessageView::data() const
+{
+    return d_data;
+}
+
+bsl::size_t MessageView::size() const
+{
+    return d_size;
+}
+
+bsl::ostream& operator<<(bsl::ostream&              stream,
+                         const ntcdns::MessageView& object)
+{
+    stream << "[ header = " << object.d_header;
+
+    if (!object.d_question.isNull()) {
+        bsl::string name;
+        object.d_question.load(&name);
+        stream << " qd = " << name;
+    }
+
+    stream << " ]";
+
+    return stream;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
@@ -19,9 +19,11 @@
 #include <ntcdns_vocabulary.h>
 #include <ntcscm_version.h>
 #include <ntsa_error.h>
+#include <ntsa_ipaddress.h>
 #include <bdlb_bigendian.h>
 #include <bdlbb_blob.h>
 #include <bsls_platform.h>
+#include <bslstl_stringref.h>
 #include <bsl_memory.h>
 #include <bsl_ostream.h>
 #include <bsl_streambuf.h>
@@ -92,20 +94,53 @@ class Validation
 /// @internal @brief
 /// Provide an encoder of DNS vocabulary to a contiguous range of a memory.
 ///
+/// @details
+/// Domain names are compressed as described in RFC 1035 section 4.1.4: when
+/// the trailing labels of a domain name have already been encoded, they are
+/// replaced by a pointer to their earlier occurrence. The offsets of
+/// previously encoded labels are remembered in a fixed-size table, so
+/// compression requires no memory allocation. Note that compression assumes
+/// the data at 'begin()' is the start of the DNS message, and that the
+/// bytes of any domain name already encoded are never overwritten.
+///
 /// @par Thread Safety
 /// This class is not thread safe.
 ///
 /// @ingroup module_ntcdns
 class MemoryEncoder
 {
+    enum {
+        /// The maximum number of labels in a domain name.
+        k_MAX_LABELS = 128,
+
+        /// The maximum number of label offsets remembered for compression.
+        k_MAX_NAME_OFFSETS = 64,
+
+        /// The maximum offset that may be referenced by a compression
+        /// pointer.
+        k_MAX_POINTER_OFFSET = 0x3FFF
+    };
+
     bsl::uint8_t* d_begin;
     bsl::uint8_t* d_current;
     bsl::uint8_t* d_end;
+    bsl::uint16_t d_nameOffsetArray[k_MAX_NAME_OFFSETS];
+    bsl::size_t   d_nameOffsetCount;
+    bool          d_compress;
 
   private:
     MemoryEncoder(const MemoryEncoder&) BSLS_KEYWORD_DELETED;
     MemoryEncoder& operator=(const MemoryEncoder&) BSLS_KEYWORD_DELETED;
 
+  private:
+    /// Return true if the domain name previously encoded starting at the
+    /// specified 'offset' consists of exactly the labels in the specified
+    /// 'labelArray' having the specified 'numLabels', otherwise return
+    /// false.
+    bool matchDomainName(bsl::size_t              offset,
+                         const bslstl::StringRef* labelArray,
+                         bsl::size_t              numLabels) const;
+
   public:
     /// Create a new memory encoder to the specified 'data' having the
     /// specified 'size'.
@@ -133,7 +168,9 @@ class MemoryEncoder
     /// order. Return the error.
     ntsa::Error encodeUint32(const bdlb::BigEndianUint32& value);
 
-    /// Encode the specified domain name 'value'. Return the error.
+    /// Encode the specified domain name 'value', compressing its trailing
+    /// labels if they have already been encoded and compression is
+    /// enabled. Return the error.
     ntsa::Error encodeDomainName(const bsl::string& value);
 
     /// Encode the specified character string 'value'. Return the error.
@@ -143,6 +180,10 @@ class MemoryEncoder
     /// error.
     ntsa::Error encodeRdata(const bdlbb::Blob& value);
 
+    /// Set the flag indicating domain names are compressed to the specified
+    /// 'value'. The default value is true.
+    void setCompressionEnabled(bool value);
+
     /// Encode the specified raw 'value' having the specified 'size',
     /// exactly as it is represented. Return the error.
     ntsa::Error encodeRaw(const void* value, bsl::size_t size);
@@ -263,6 +304,133 @@ class MemoryDecoder
     bsl::size_t capacity() const;
 };
 
+/// @internal @brief
+/// Provide a view of a domain name encoded within a DNS message.
+///
+/// @details
+/// A name view refers to the encoded labels of a domain name in place,
+/// following compression pointers only when the name is compared or
+/// loaded, so that decoding a name neither copies nor allocates. The
+/// memory of the message must outlive the view.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcdns
+class NameView
+{
+    const bsl::uint8_t* d_begin;
+    const bsl::uint8_t* d_end;
+    bsl::size_t         d_offset;
+
+  private:
+    /// Load into the specified 'label' the next label of the name at the
+    /// specified 'position', following compression pointers and counting
+    /// each pointer followed in the specified 'numJumps', then advance the
+    /// 'position' past the label. Load an empty 'label' when the end of the
+    /// name is reached. Return the error.
+    ntsa::Error nextLabel(bslstl::StringRef* label,
+                          bsl::size_t*       position,
+                          bsl::size_t*       numJumps) const;
+
+  public:
+    /// Create a new name view that refers to no name.
+    NameView();
+
+    /// Create a new name view that refers to the name encoded at the
+    /// specified 'offset' within the message defined by the specified
+    /// 'data' having the specified 'size'.
+    NameView(const bsl::uint8_t* data, bsl::size_t size, bsl::size_t offset);
+
+    /// Refer to the name at the current position of the specified
+    /// 'decoder' and advance the 'decoder' past its encoding, without
+    /// following any compression pointer. Return the error.
+    ntsa::Error decode(MemoryDecoder* decoder);
+
+    /// Load into the specified 'result' the dot-separated domain name
+    /// referred to by this view. Return the error.
+    ntsa::Error load(bsl::string* result) const;
+
+    /// Return true if the domain name referred to by this view equals the
+    /// specified dot-separated 'name', ignoring case and any trailing dot,
+    /// otherwise return false.
+    bool equals(const bslstl::StringRef& name) const;
+
+    /// Return true if this view refers to no name, otherwise return false.
+    bool isNull() const;
+};
+
+/// @internal @brief
+/// Provide a view of a resource record encoded within a DNS message.
+///
+/// @details
+/// A resource record view decodes the fixed-size fields of a resource record
+/// and refers to its owner name and its "RDATA" in place. The memory of the
+/// message must outlive the view.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcdns
+class ResourceRecordView
+{
+    ntcdns::NameView    d_name;
+    bsl::uint16_t       d_type;
+    bsl::uint16_t       d_class;
+    bsl::uint32_t       d_ttl;
+    const bsl::uint8_t* d_begin;
+    const bsl::uint8_t* d_end;
+    bsl::size_t         d_rdataOffset;
+    bsl::size_t         d_rdataLength;
+
+  public:
+    /// Create a new resource record view that refers to no record.
+    ResourceRecordView();
+
+    /// Refer to the resource record at the current position of the
+    /// specified 'decoder' and advance the 'decoder' past its encoding.
+    /// Return the error.
+    ntsa::Error decode(MemoryDecoder* decoder);
+
+    /// Load into the specified 'result' the IP address described by the
+    /// "RDATA" of an "A" or "AAAA" record. Return the error.
+    ntsa::Error loadIpAddress(ntsa::IpAddress* result) const;
+
+    /// Load into the specified 'result' a view of the domain name described
+    /// by the "RDATA" of a "CNAME", "NS", or "PTR" record. Return the error.
+    ntsa::Error loadDomainName(ntcdns::NameView* result) const;
+
+    /// Return the owner name.
+    const ntcdns::NameView& name() const;
+
+    /// Return the "TYPE" field, which may be a type not enumerated by
+    /// 'ntcdns::Type'.
+    bsl::uint16_t type() const;
+
+    /// Return the "CLASS" field.
+    bsl::uint16_t classification() const;
+
+    /// Return the "TTL" field.
+    bsl::uint32_t ttl() const;
+
+    /// Return the pointer to the "RDATA" field.
+    const bsl::uint8_t* rdata() const;
+
+    /// Return the length of the "RDATA" field.
+    bsl::size_t rdataLength() const;
+
+    /// Return true if this record is an "A" record, otherwise return false.
+    bool isIpv4() const;
+
+    /// Return true if this record is an "AAAA" record, otherwise return
+    /// false.
+    bool isIpv6() const;
+
+    /// Return true if this record is a "PTR" record, otherwise return
+    /// false.
+    bool isPointer() const;
+};
+
 /// @internal @brief
 /// Describe a header in the DNS protocol.
 ///
@@ -1173,6 +1341,105 @@ class Message
     friend bool operator!=(const Message& lhs, const Message& rhs);
 };
 
+/// @internal @brief
+/// Provide a view of a DNS message decoded in place.
+///
+/// @details
+/// A message view decodes the header and walks the question section of a
+/// message without copying it, recording the name of the first question and
+/// the position of the answer section. Answers are then walked in place by
+/// decoding a 'ntcdns::ResourceRecordView' for each from a decoder
+/// positioned at 'answerOffset()'. Unlike 'ntcdns::Message', decoding a
+/// message view never allocates memory. The memory of the message must
+/// outlive the view.
+///
+/// @par Usage Example
+/// The following example illustrates how to walk the addresses in the
+/// answer section of a response in the specified 'data' having the
+/// specified 'size'.
+///
+///     ntcdns::MessageView response;
+///     ntsa::Error error = response.decode(data, size);
+///     if (error) {
+///         return error;
+///     }
+///
+///     ntcdns::MemoryDecoder decoder(response.data(), response.size());
+///     decoder.seek(response.answerOffset());
+///
+///     for (bsl::size_t i = 0; i < response.ancount(); ++i) {
+///         ntcdns::ResourceRecordView answer;
+///         error = answer.decode(&decoder);
+///         if (error) {
+///             return error;
+///         }
+///
+///         ntsa::IpAddress ipAddress;
+///         if (!answer.loadIpAddress(&ipAddress)) {
+///             // Use 'ipAddress' and 'answer.ttl()'.
+///         }
+///     }
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcdns
+class MessageView
+{
+    ntcdns::Header      d_header;
+    ntcdns::NameView    d_question;
+    const bsl::uint8_t* d_data;
+    bsl::size_t         d_size;
+    bsl::size_t         d_answerOffset;
+
+  public:
+    /// Create a new message view that refers to no message.
+    MessageView();
+
+    /// Decode the header and question section of the message defined by
+    /// the specified 'data' having the specified 'size'. Return the error.
+    ntsa::Error decode(const bsl::uint8_t* data, bsl::size_t size);
+
+    /// Return the header.
+    const ntcdns::Header& header() const;
+
+    /// Return the name of the first question, or a null view if the
+    /// message contains no questions.
+    const ntcdns::NameView& question() const;
+
+    /// Return the "ID" field.
+    bsl::uint16_t id() const;
+
+    /// Return the "TC" field.
+    bool tc() const;
+
+    /// Return the "RCODE" field.
+    ntcdns::Error::Value error() const;
+
+    /// Return the "QDCOUNT" field.
+    bsl::size_t qdcount() const;
+
+    /// Return the "ANCOUNT" field.
+    bsl::size_t ancount() const;
+
+    /// Return the offset from the start of the message to the answer
+    /// section.
+    bsl::size_t answerOffset() const;
+
+    /// Return the pointer to the start of the message.
+    const bsl::uint8_t* data() const;
+
+    /// Return the size of the message.
+    bsl::size_t size() const;
+
+    // FRIENDS
+
+    /// Write a formatted, human-readable description of the specified
+    /// 'object' to the specified 'stream'.
+    friend bsl::ostream& operator<<(bsl::ostream&              stream,
+                                    const ntcdns::MessageView& object);
+};
+
 }  // close package namespace
 }  // close enterprise namespace
 #endif
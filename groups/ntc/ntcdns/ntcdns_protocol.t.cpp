@@ -24,6 +24,10 @@ BSLS_IDENT_RCSID(ntcdns_protocol_t_cpp, "$Id$ $CSID$")
 #include <ntsa_ipv4address.h>
 #include <ntsa_ipv6address.h>
 
+#include <bsls_stopwatch.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
 using namespace BloombergLP;
 
 namespace BloombergLP {
@@ -67,6 +71,16 @@ class ProtocolTest
 
     // TODO
     static void verifyWks();
+
+    // Verify domain names are compressed when encoded.
+    static void verifyNameCompression();
+
+    // Verify a response may be decoded in-place by a message view.
+    static void verifyMessageView();
+
+    // Measure the cost of decoding a response into a message versus a
+    // message view.
+    static void verifyDecodeThroughput();
 };
 
 NTSCFG_TEST_FUNCTION(ntcdns::ProtocolTest::verifyCase1)
@@ -611,5 +625,303 @@ NTSCFG_TEST_FUNCTION(ntcdns::ProtocolTest::verifyWks)
     }
 }
 
+NTSCFG_TEST_FUNCTION(ntcdns::ProtocolTest::verifyNameCompression)
+{
+    // Concern: Domain names that repeat a name, or a suffix of a name,
+    // already encoded in the message are encoded as pointers, and the
+    // compressed message decodes to the same value.
+
+    ntsa::Error error;
+
+    ntcdns::Message message(NTSCFG_TEST_ALLOCATOR);
+    message.setId(12345);
+    message.setDirection(ntcdns::Direction::e_RESPONSE);
+
+    ntcdns::Question& question = message.addQd();
+    question.setName("www.example.com");
+    question.setType(ntcdns::Type::e_A);
+    question.setClassification(ntcdns::Classification::e_INTERNET);
+
+    {
+        ntcdns::ResourceRecordData rdata;
+        rdata.makeCanonicalName().cname() = "cdn.example.com";
+
+        ntcdns::ResourceRecord& answer = message.addAn();
+        answer.setName("www.example.com");
+        answer.setClassification(ntcdns::Classification::e_INTERNET);
+        answer.setTtl(60);
+        answer.setRdata(rdata);
+    }
+
+    for (bsl::size_t i = 0; i < 4; ++i) {
+        ntsa::Ipv4Address ipv4Address("10.0.0.1");
+
+        ntcdns::ResourceRecordData rdata;
+        ipv4Address.copyTo(&rdata.makeIpv4(), sizeof rdata.ipv4());
+
+        ntcdns::ResourceRecord& answer = message.addAn();
+        answer.setName("cdn.example.com");
+        answer.setClassification(ntcdns::Classification::e_INTERNET);
+        answer.setTtl(60);
+        answer.setRdata(rdata);
+    }
+
+    bsl::vector<bsl::uint8_t> compressed(512, NTSCFG_TEST_ALLOCATOR);
+    bsl::size_t               compressedSize = 0;
+    {
+        ntcdns::MemoryEncoder encoder(&compressed[0], compressed.size());
+
+        error = message.encode(&encoder);
+        NTSCFG_TEST_OK(error);
+
+        compressedSize = encoder.position();
+    }
+
+    bsl::vector<bsl::uint8_t> uncompressed(512, NTSCFG_TEST_ALLOCATOR);
+    bsl::size_t               uncompressedSize = 0;
+    {
+        ntcdns::MemoryEncoder encoder(&uncompressed[0], uncompressed.size());
+        encoder.setCompressionEnabled(false);
+
+        error = message.encode(&encoder);
+        NTSCFG_TEST_OK(error);
+
+        uncompressedSize = encoder.position();
+    }
+
+    NTSCFG_TEST_LT(compressedSize, uncompressedSize);
+
+    {
+        ntcdns::MemoryDecoder decoder(&compressed[0], compressedSize);
+
+        ntcdns::Message other(NTSCFG_TEST_ALLOCATOR);
+        error = other.decode(&decoder);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(message, other);
+    }
+
+    {
+        ntcdns::MemoryDecoder decoder(&uncompressed[0], uncompressedSize);
+
+        ntcdns::Message other(NTSCFG_TEST_ALLOCATOR);
+        error = other.decode(&decoder);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(message, other);
+    }
+
+    // Re-encoding a response captured from a real name server reproduces
+    // the pointer that name server used for the answer name.
+
+    // clang-format off
+    const bsl::uint8_t RESPONSE[] = {
+        0x33, 0x7b, 0x81, 0x80, 0x00, 0x01, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x06, 0x67, 0x6f, 0x6f,
+        0x67, 0x6c, 0x65, 0x03, 0x63, 0x6f, 0x6d, 0x00,
+        0x00, 0x01, 0x00, 0x01, 0xc0, 0x0c, 0x00, 0x01,
+        0x00, 0x01, 0x00, 0x00, 0x00, 0x77, 0x00, 0x04,
+        0xac, 0xd9, 0x06, 0xee
+    };
+    // clang-format on
+
+    {
+        ntcdns::Message response(NTSCFG_TEST_ALLOCATOR);
+
+        ntcdns::MemoryDecoder decoder(RESPONSE, sizeof RESPONSE);
+        error = response.decode(&decoder);
+        NTSCFG_TEST_OK(error);
+
+        bsl::vector<bsl::uint8_t> buffer(512, NTSCFG_TEST_ALLOCATOR);
+
+        ntcdns::MemoryEncoder encoder(&buffer[0], buffer.size());
+        error = response.encode(&encoder);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(encoder.position(), sizeof RESPONSE);
+        NTSCFG_TEST_EQ(bsl::memcmp(&buffer[0], RESPONSE, sizeof RESPONSE),
+                       0);
+    }
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::ProtocolTest::verifyMessageView)
+{
+    // Concern: A message view decodes the header and question of a real
+    // response, and its answers may be walked in-place to yield the same
+    // values as a fully-decoded message.
+
+    ntsa::Error error;
+
+    // clang-format off
+    const bsl::uint8_t RESPONSE[] = {
+        0x33, 0x7b, 0x81, 0x80, 0x00, 0x01, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x06, 0x67, 0x6f, 0x6f,
+        0x67, 0x6c, 0x65, 0x03, 0x63, 0x6f, 0x6d, 0x00,
+        0x00, 0x01, 0x00, 0x01, 0xc0, 0x0c, 0x00, 0x01,
+        0x00, 0x01, 0x00, 0x00, 0x00, 0x77, 0x00, 0x04,
+        0xac, 0xd9, 0x06, 0xee
+    };
+    // clang-format on
+
+    ntcdns::MessageView view;
+    error = view.decode(RESPONSE, sizeof RESPONSE);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(view.id(), 13179);
+    NTSCFG_TEST_EQ(view.tc(), false);
+    NTSCFG_TEST_EQ(view.error(), ntcdns::Error::e_OK);
+    NTSCFG_TEST_EQ(view.qdcount(), 1);
+    NTSCFG_TEST_EQ(view.ancount(), 1);
+
+    NTSCFG_TEST_FALSE(view.question().isNull());
+    NTSCFG_TEST_TRUE(view.question().equals("google.com"));
+    NTSCFG_TEST_TRUE(view.question().equals("GOOGLE.com."));
+    NTSCFG_TEST_FALSE(view.question().equals("google.co"));
+    NTSCFG_TEST_FALSE(view.question().equals("www.google.com"));
+
+    ntcdns::MemoryDecoder decoder(view.data(), view.size());
+    decoder.seek(view.answerOffset());
+
+    ntcdns::ResourceRecordView answer;
+    error = answer.decode(&decoder);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_TRUE(answer.isIpv4());
+    NTSCFG_TEST_FALSE(answer.isIpv6());
+    NTSCFG_TEST_FALSE(answer.isPointer());
+    NTSCFG_TEST_EQ(answer.ttl(), 119);
+    NTSCFG_TEST_EQ(answer.rdataLength(), 4);
+
+    ntsa::IpAddress ipAddress;
+    error = answer.loadIpAddress(&ipAddress);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(ipAddress, ntsa::IpAddress("172.217.6.238"));
+
+    // The answer name is a pointer to the question name: following it
+    // yields the same name a fully-decoded message reports.
+
+    ntcdns::Message message(NTSCFG_TEST_ALLOCATOR);
+    {
+        ntcdns::MemoryDecoder messageDecoder(RESPONSE, sizeof RESPONSE);
+        error = message.decode(&messageDecoder);
+        NTSCFG_TEST_OK(error);
+    }
+
+    bsl::string answerName(NTSCFG_TEST_ALLOCATOR);
+    error = answer.name().load(&answerName);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(answerName, message.an(0).name());
+
+    bsl::string questionName(NTSCFG_TEST_ALLOCATOR);
+    error = view.question().load(&questionName);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(questionName, message.qd(0).name());
+
+    // A truncated payload is rejected.
+
+    {
+        ntcdns::MessageView truncated;
+        error = truncated.decode(RESPONSE, 20);
+        NTSCFG_TEST_TRUE(error);
+    }
+
+    // A pointer that refers to itself is rejected rather than followed
+    // indefinitely.
+
+    // clang-format off
+    const bsl::uint8_t LOOP[] = {
+        0x00, 0x01, 0x81, 0x80, 0x00, 0x01, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0xc0, 0x0c, 0x00, 0x01,
+        0x00, 0x01
+    };
+    // clang-format on
+
+    {
+        ntcdns::MessageView loop;
+        error = loop.decode(LOOP, sizeof LOOP);
+        NTSCFG_TEST_OK(error);
+
+        bsl::string name(NTSCFG_TEST_ALLOCATOR);
+        error = loop.question().load(&name);
+        NTSCFG_TEST_TRUE(error);
+
+        NTSCFG_TEST_FALSE(loop.question().equals("google.com"));
+    }
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::ProtocolTest::verifyDecodeThroughput)
+{
+    // Concern: Decoding a response into a message view is cheaper than
+    // decoding it into a message. The timings are informational and are
+    // only printed when the test is run verbosely.
+
+    ntsa::Error error;
+
+    // clang-format off
+    const bsl::uint8_t RESPONSE[] = {
+        0x33, 0x7b, 0x81, 0x80, 0x00, 0x01, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x06, 0x67, 0x6f, 0x6f,
+        0x67, 0x6c, 0x65, 0x03, 0x63, 0x6f, 0x6d, 0x00,
+        0x00, 0x01, 0x00, 0x01, 0xc0, 0x0c, 0x00, 0x01,
+        0x00, 0x01, 0x00, 0x00, 0x00, 0x77, 0x00, 0x04,
+        0xac, 0xd9, 0x06, 0xee
+    };
+    // clang-format on
+
+    const bsl::size_t NUM_ITERATIONS = 10000;
+
+    bsls::Stopwatch messageStopwatch;
+    messageStopwatch.start();
+
+    for (bsl::size_t i = 0; i < NUM_ITERATIONS; ++i) {
+        ntcdns::Message message(NTSCFG_TEST_ALLOCATOR);
+
+        ntcdns::MemoryDecoder decoder(RESPONSE, sizeof RESPONSE);
+        error = message.decode(&decoder);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(message.an(0).rdata().isIpv4Value(), true);
+    }
+
+    messageStopwatch.stop();
+
+    bsls::Stopwatch viewStopwatch;
+    viewStopwatch.start();
+
+    for (bsl::size_t i = 0; i < NUM_ITERATIONS; ++i) {
+        ntcdns::MessageView view;
+        error = view.decode(RESPONSE, sizeof RESPONSE);
+        NTSCFG_TEST_OK(error);
+
+        ntcdns::MemoryDecoder decoder(view.data(), view.size());
+        decoder.seek(view.answerOffset());
+
+        ntcdns::ResourceRecordView answer;
+        error = answer.decode(&decoder);
+        NTSCFG_TEST_OK(error);
+
+        ntsa::IpAddress ipAddress;
+        error = answer.loadIpAddress(&ipAddress);
+        NTSCFG_TEST_OK(error);
+    }
+
+    viewStopwatch.stop();
+
+    if (NTSCFG_TEST_VERBOSITY > 0) {
+        bsl::cout << "Decoded " << NUM_ITERATIONS
+                  << " responses into a message in "
+                  << messageStopwatch.accumulatedWallTime() << " seconds"
+                  << bsl::endl;
+
+        bsl::cout << "Decoded " << NUM_ITERATIONS
+                  << " responses into a message view in "
+                  << viewStopwatch.accumulatedWallTime() << " seconds"
+                  << bsl::endl;
+    }
+}
+
 }  // close namespace ntcdns
 }  // close namespace BloombergLP
@@ -18,6 +18,7 @@
 #include <ntcdns_compat.h>
 #include <ntcdns_utility.h>
 #include <ntci_log.h>
+#include <ntcs_monitorable.h>
 
 #include <ntsa_endpointoptions.h>
 #include <ntsa_ipaddressoptions.h>
@@ -54,6 +55,8 @@ const bool Resolver::k_DEFAULT_PORT_DATABASE_ENABLED = false;
 const bool Resolver::k_DEFAULT_POSITIVE_CACHE_ENABLED = false;
 const bool Resolver::k_DEFAULT_NEGATIVE_CACHE_ENABLED = false;
 
+const bool Resolver::k_DEFAULT_ENDPOINT_CACHE_ENABLED = false;
+
 const bool Resolver::k_DEFAULT_CLIENT_ENABLED = false;
 
 const int Resolver::k_DEFAULT_SYSTEM_MIN_THREADS   = 0;
@@ -61,13 +64,15 @@ const int Resolver::k_DEFAULT_SYSTEM_MAX_THREADS   = 1;
 const int Resolver::k_DEFAULT_SYSTEM_MAX_IDLE_TIME = 10;
 
 void Resolver::processGetIpAddressResult(
-    const bsl::shared_ptr<ntci::Resolver>& resolver,
-    const bsl::string&                     authority,
-    const bsls::TimeInterval&              startTime,
-    const bsl::vector<ntsa::IpAddress>&    ipAddressList,
-    const bsl::vector<ntsa::Port>          portList,
-    const ntca::GetIpAddressEvent&         event,
-    const ntci::GetEndpointCallback&       callback)
+    const bsl::shared_ptr<ntci::Resolver>&        resolver,
+    const bsl::string&                            authority,
+    const ntca::GetEndpointOptions&               options,
+    const bsl::shared_ptr<ntcdns::EndpointCache>& endpointCache,
+    const bsls::TimeInterval&                     startTime,
+    const bsl::vector<ntsa::IpAddress>&           ipAddressList,
+    const bsl::vector<ntsa::Port>                 portList,
+    const ntca::GetIpAddressEvent&                event,
+    const ntci::GetEndpointCallback&              callback)
 {
     ntsa::Endpoint              endpoint;
     bsl::vector<ntsa::Endpoint> endpointVector;
@@ -125,6 +130,13 @@ void Resolver::processGetIpAddressResult(
 
         getEndpointContext.setEndpointList(endpointVector);
 
+        if (endpointCache) {
+            endpointCache->update(authority,
+                                  options,
+                                  getEndpointContext,
+                                  endTime);
+        }
+
         getEndpointEvent.setType(ntca::GetEndpointEventType::e_COMPLETE);
         getEndpointEvent.setContext(getEndpointContext);
 
@@ -141,6 +153,134 @@ void Resolver::processGetIpAddressResult(
     }
 }
 
+void Resolver::refreshIpAddress(const bsl::string&               domainName,
+                                const ntca::GetIpAddressOptions& options)
+{
+    if (!d_client_sp) {
+        return;
+    }
+
+    bsl::shared_ptr<Resolver> self = this->getSelf(this);
+
+    ntci::GetIpAddressCallback callback = this->createGetIpAddressCallback(
+        &Resolver::processRefreshIpAddressResult,
+        d_allocator_p);
+
+    // The response updates the cache, if successful; otherwise, the cached
+    // entries simply expire.
+
+    ntsa::Error error =
+        d_client_sp->getIpAddress(self, domainName, options, callback);
+    if (error) {
+        NTCI_LOG_CONTEXT();
+
+        NTCI_LOG_STREAM_TRACE << "Failed to refresh the IP addresses "
+                              << "assigned to domain name '" << domainName
+                              << "': " << error << NTCI_LOG_STREAM_END;
+    }
+}
+
+void Resolver::processRefreshIpAddressResult(
+    const bsl::shared_ptr<ntci::Resolver>& resolver,
+    const bsl::vector<ntsa::IpAddress>&    ipAddressList,
+    const ntca::GetIpAddressEvent&         event)
+{
+    NTCCFG_WARNING_UNUSED(resolver);
+    NTCCFG_WARNING_UNUSED(ipAddressList);
+    NTCCFG_WARNING_UNUSED(event);
+}
+
+void Resolver::processCacheSnapshotTimer(
+    const bsl::shared_ptr<ntcdns::Cache>& cache,
+    const bsl::string&                    path,
+    const bsl::shared_ptr<ntci::Timer>&   timer,
+    const ntca::TimerEvent&               event)
+{
+    NTCCFG_WARNING_UNUSED(timer);
+
+    if (event.type() != ntca::TimerEventType::e_DEADLINE) {
+        return;
+    }
+
+    cache->saveSnapshot(path, bdlt::CurrentTime::now());
+}
+
+void Resolver::processDatabaseReloadTimer(
+    const bsl::shared_ptr<bdlmt::ThreadPool>&     threadPool,
+    const bsl::shared_ptr<ntcdns::HostDatabase>&  hostDatabase,
+    const bsl::shared_ptr<ntcdns::PortDatabase>&  portDatabase,
+    const bsl::shared_ptr<ntcdns::EndpointCache>& endpointCache,
+    const bsl::shared_ptr<ntci::Timer>&           timer,
+    const ntca::TimerEvent&                       event)
+{
+    NTCCFG_WARNING_UNUSED(timer);
+
+    NTCI_LOG_CONTEXT();
+
+    if (event.type() != ntca::TimerEventType::e_DEADLINE) {
+        return;
+    }
+
+    // Do not queue another reload behind one that has not yet started: it
+    // would find the same files.
+
+    if (threadPool->numPendingJobs() > 0) {
+        return;
+    }
+
+    int rc = threadPool->enqueueJob(
+        bdlf::BindUtil::bind(&Resolver::reloadDatabases,
+                             hostDatabase,
+                             portDatabase,
+                             endpointCache));
+    if (rc != 0) {
+        NTCI_LOG_STREAM_WARN << "Failed to enqueue database reload"
+                             << NTCI_LOG_STREAM_END;
+    }
+}
+
+void Resolver::reloadDatabases(
+    const bsl::shared_ptr<ntcdns::HostDatabase>&  hostDatabase,
+    const bsl::shared_ptr<ntcdns::PortDatabase>&  portDatabase,
+    const bsl::shared_ptr<ntcdns::EndpointCache>& endpointCache)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+    bool        reloaded    = false;
+    bool        anyReloaded = false;
+
+    if (hostDatabase) {
+        error = hostDatabase->reload(&reloaded);
+        if (error) {
+            NTCI_LOG_STREAM_WARN << "Failed to reload host database: "
+                                 << error << NTCI_LOG_STREAM_END;
+        }
+        else if (reloaded) {
+            NTCI_LOG_STREAM_DEBUG << "Reloaded host database"
+                                  << NTCI_LOG_STREAM_END;
+            anyReloaded = true;
+        }
+    }
+
+    if (portDatabase) {
+        error = portDatabase->reload(&reloaded);
+        if (error) {
+            NTCI_LOG_STREAM_WARN << "Failed to reload port database: "
+                                 << error << NTCI_LOG_STREAM_END;
+        }
+        else if (reloaded) {
+            NTCI_LOG_STREAM_DEBUG << "Reloaded port database"
+                                  << NTCI_LOG_STREAM_END;
+            anyReloaded = true;
+        }
+    }
+
+    if (anyReloaded && endpointCache) {
+        endpointCache->clear();
+    }
+}
+
 ntsa::Error Resolver::initialize()
 {
     // Avoid redundant initialization.
@@ -164,9 +304,48 @@ ntsa::Error Resolver::initialize()
 
     // MRM: d_strand_sp = d_strandFactory_sp->createStrand(d_allocator_p);
 
+    // When blocking system functions may not be called, every resolution
+    // must be answered by the databases, the cache, or the DNS client, and
+    // completed on the threads driving the interface. Enable the host
+    // database and the DNS client according to the host lookup sources
+    // configured for the system, unless configured explicitly.
+
+    bool blockingEnabled = true;
+    if (!d_config.blockingEnabled().isNull()) {
+        blockingEnabled = d_config.blockingEnabled().value();
+    }
+
+    bool hostLookupFiles = true;
+    bool hostLookupDns   = true;
+
+    if (!blockingEnabled) {
+        if (!d_executor_sp) {
+            NTCI_LOG_STREAM_ERROR << "Failed to initialize resolver: "
+                                     "non-blocking resolution requires an "
+                                     "interface or executor"
+                                  << NTCI_LOG_STREAM_END;
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        bsl::vector<bsl::string> hostLookupOrder;
+        error = ntcdns::Utility::loadHostLookupOrder(&hostLookupOrder);
+        if (error) {
+            return error;
+        }
+
+        hostLookupFiles = bsl::find(hostLookupOrder.begin(),
+                                    hostLookupOrder.end(),
+                                    "files") != hostLookupOrder.end();
+
+        hostLookupDns = bsl::find(hostLookupOrder.begin(),
+                                  hostLookupOrder.end(),
+                                  "dns") != hostLookupOrder.end();
+    }
+
     // Load the host database, if enabled.
 
-    bool hostDatabaseEnabled = k_DEFAULT_HOST_DATABASE_ENABLED;
+    bool hostDatabaseEnabled =
+        blockingEnabled ? k_DEFAULT_HOST_DATABASE_ENABLED : hostLookupFiles;
     if (!d_config.hostDatabaseEnabled().isNull()) {
         hostDatabaseEnabled = d_config.hostDatabaseEnabled().value();
     }
@@ -193,7 +372,8 @@ ntsa::Error Resolver::initialize()
 
     // Load the port database, if enabled.
 
-    bool portDatabaseEnabled = k_DEFAULT_PORT_DATABASE_ENABLED;
+    bool portDatabaseEnabled =
+        blockingEnabled ? k_DEFAULT_PORT_DATABASE_ENABLED : true;
     if (!d_config.portDatabaseEnabled().isNull()) {
         portDatabaseEnabled = d_config.portDatabaseEnabled().value();
     }
@@ -234,6 +414,18 @@ ntsa::Error Resolver::initialize()
         if (!d_cache_sp) {
             d_cache_sp.createInplace(d_allocator_p, d_allocator_p);
 
+            if (!d_config.cacheMaxEntries().isNull()) {
+                d_cache_sp->setMaxEntries(d_config.cacheMaxEntries().value());
+            }
+
+            // The cache is owned by this object and only invokes its refresh
+            // callback from within lookups made by this object, so the
+            // callback need not hold a reference to this object.
+
+            d_cache_sp->setRefreshCallback(
+                bdlf::MemFnUtil::memFunction(&Resolver::refreshIpAddress,
+                                             this));
+
             d_cache_sp->setPositiveCacheEnabled(positiveCacheEnabled);
 
             if (!d_config.positiveCacheMinTimeToLive().isNull()) {
@@ -257,12 +449,58 @@ ntsa::Error Resolver::initialize()
                 d_cache_sp->setNegativeCacheMaxTimeToLive(
                     d_config.negativeCacheMaxTimeToLive().value());
             }
+
+            // Warm the cache from the snapshot saved by a previous process,
+            // if any, so that the first resolutions need not wait for the
+            // name servers.
+
+            if (positiveCacheEnabled &&
+                !d_config.cacheSnapshotPath().isNull())
+            {
+                bsl::size_t numEntries = 0;
+                error                  = d_cache_sp->loadSnapshot(
+                    &numEntries,
+                    d_config.cacheSnapshotPath().value(),
+                    bdlt::CurrentTime::now());
+                if (error) {
+                    NTCI_LOG_STREAM_DEBUG
+                        << "DNS cache snapshot '"
+                        << d_config.cacheSnapshotPath().value()
+                        << "' not loaded: " << error << NTCI_LOG_STREAM_END;
+                }
+            }
+
+            ntcs::MonitorableUtil::registerMonitorable(d_cache_sp);
+        }
+    }
+
+    // Create the endpoint cache, if enabled.
+
+    bool endpointCacheEnabled = k_DEFAULT_ENDPOINT_CACHE_ENABLED;
+    if (!d_config.endpointCacheEnabled().isNull()) {
+        endpointCacheEnabled = d_config.endpointCacheEnabled().value();
+    }
+
+    if (endpointCacheEnabled) {
+        if (!d_endpointCache_sp) {
+            d_endpointCache_sp.createInplace(d_allocator_p, d_allocator_p);
+
+            if (!d_config.endpointCacheMaxEntries().isNull()) {
+                d_endpointCache_sp->setMaxEntries(
+                    d_config.endpointCacheMaxEntries().value());
+            }
+
+            if (!d_config.endpointCacheMaxTimeToLive().isNull()) {
+                d_endpointCache_sp->setMaxTimeToLive(
+                    d_config.endpointCacheMaxTimeToLive().value());
+            }
         }
     }
 
     // Create and start the client, if enabled.
 
-    bool clientEnabled = k_DEFAULT_CLIENT_ENABLED;
+    bool clientEnabled =
+        blockingEnabled ? k_DEFAULT_CLIENT_ENABLED : hostLookupDns;
     if (!d_config.clientEnabled().isNull()) {
         clientEnabled = d_config.clientEnabled().value();
     }
@@ -343,6 +581,18 @@ ntsa::Error Resolver::initialize()
                 clientConfig.debug() = d_config.clientDebug().value();
             }
 
+            if (!d_config.clientHedgeDelay().isNull()) {
+                clientConfig.hedgeDelay() =
+                    NTCCFG_WARNING_NARROW(unsigned int,
+                                          d_config.clientHedgeDelay().value());
+            }
+
+            if (!d_config.clientHedgePercentile().isNull()) {
+                clientConfig.hedgePercentile() = NTCCFG_WARNING_NARROW(
+                    unsigned int,
+                    d_config.clientHedgePercentile().value());
+            }
+
             if (!d_datagramSocketFactory_sp || !d_streamSocketFactory_sp) {
                 // MRM: Log
                 return ntsa::Error(ntsa::Error::e_INVALID);
@@ -369,6 +619,16 @@ ntsa::Error Resolver::initialize()
         systemEnabled = d_config.systemEnabled().value();
     }
 
+    if (!blockingEnabled) {
+        if (systemEnabled && !d_config.systemEnabled().isNull()) {
+            NTCI_LOG_STREAM_WARN << "Resolution by the system is disabled "
+                                    "because blocking is disabled"
+                                 << NTCI_LOG_STREAM_END;
+        }
+
+        systemEnabled = false;
+    }
+
     if (systemEnabled) {
         if (!d_system_sp) {
             int minThreads = k_DEFAULT_SYSTEM_MIN_THREADS;
@@ -398,7 +658,7 @@ ntsa::Error Resolver::initialize()
         }
     }
 
-    if (!clientEnabled && !systemEnabled) {
+    if (!clientEnabled && !systemEnabled && !d_executor_sp) {
         bslmt::ThreadAttributes threadAttributes;
         threadAttributes.setThreadName("dns-resolver");
 
@@ -415,7 +675,8 @@ ntsa::Error Resolver::initialize()
         }
     }
 
-    d_initialized = true;
+    d_blockingEnabled = blockingEnabled;
+    d_initialized     = true;
 
     return ntsa::Error();
 }
@@ -437,11 +698,16 @@ Resolver::Resolver(const ntca::ResolverConfig& configuration,
 , d_hostDatabase_sp()
 , d_portDatabase_sp()
 , d_cache_sp()
+, d_endpointCache_sp()
+, d_cacheSnapshotTimer_sp()
+, d_databaseReloadTimer_sp()
 , d_client_sp()
 , d_system_sp()
 , d_threadPool_sp()
+, d_databaseThreadPool_sp()
 , d_state(e_STATE_STOPPED)
 , d_initialized(false)
+, d_blockingEnabled(true)
 , d_config(configuration, basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
@@ -466,11 +732,16 @@ Resolver::Resolver(const ntca::ResolverConfig&             configuration,
 , d_hostDatabase_sp()
 , d_portDatabase_sp()
 , d_cache_sp()
+, d_endpointCache_sp()
+, d_cacheSnapshotTimer_sp()
+, d_databaseReloadTimer_sp()
 , d_client_sp()
 , d_system_sp()
 , d_threadPool_sp()
+, d_databaseThreadPool_sp()
 , d_state(e_STATE_STOPPED)
 , d_initialized(false)
+, d_blockingEnabled(true)
 , d_config(configuration, basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
@@ -500,11 +771,16 @@ Resolver::Resolver(
 , d_hostDatabase_sp()
 , d_portDatabase_sp()
 , d_cache_sp()
+, d_endpointCache_sp()
+, d_cacheSnapshotTimer_sp()
+, d_databaseReloadTimer_sp()
 , d_client_sp()
 , d_system_sp()
 , d_threadPool_sp()
+, d_databaseThreadPool_sp()
 , d_state(e_STATE_STOPPED)
 , d_initialized(false)
+, d_blockingEnabled(true)
 , d_config(configuration, basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
@@ -514,6 +790,10 @@ Resolver::~Resolver()
 {
     this->shutdown();
     this->linger();
+
+    if (d_cache_sp) {
+        ntcs::MonitorableUtil::deregisterMonitorable(d_cache_sp);
+    }
 }
 
 ntsa::Error Resolver::start()
@@ -532,6 +812,101 @@ ntsa::Error Resolver::start()
         return error;
     }
 
+    // Periodically save a snapshot of the cache, if configured.
+
+    if (d_cache_sp && d_timerFactory_sp &&
+        !d_config.cacheSnapshotPath().isNull() &&
+        !d_config.cacheSnapshotInterval().isNull() &&
+        d_config.cacheSnapshotInterval().value() > 0 &&
+        !d_cacheSnapshotTimer_sp)
+    {
+        const bsls::TimeInterval interval(
+            static_cast<bsls::Types::Int64>(
+                d_config.cacheSnapshotInterval().value()),
+            0);
+
+        ntca::TimerOptions timerOptions;
+        timerOptions.setOneShot(false);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+
+        ntci::TimerCallback timerCallback =
+            d_timerFactory_sp->createTimerCallback(
+                bdlf::BindUtil::bind(&Resolver::processCacheSnapshotTimer,
+                                     d_cache_sp,
+                                     d_config.cacheSnapshotPath().value(),
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2),
+                d_allocator_p);
+
+        d_cacheSnapshotTimer_sp =
+            d_timerFactory_sp->createTimer(timerOptions,
+                                           timerCallback,
+                                           d_allocator_p);
+
+        d_cacheSnapshotTimer_sp->schedule(
+            bdlt::CurrentTime::now() + interval,
+            interval);
+    }
+
+    // Periodically reload the host and port databases from their files, if
+    // configured and those files have been modified.
+
+    if ((d_hostDatabase_sp || d_portDatabase_sp) && d_timerFactory_sp &&
+        !d_config.databaseReloadInterval().isNull() &&
+        d_config.databaseReloadInterval().value() > 0 &&
+        !d_databaseReloadTimer_sp)
+    {
+        // Reload on a dedicated thread, created on demand, so that reading
+        // and parsing a large file never delays the timers and sockets
+        // driven by the interface's threads.
+
+        bslmt::ThreadAttributes threadAttributes;
+        threadAttributes.setThreadName("dns-database");
+
+        d_databaseThreadPool_sp.createInplace(d_allocator_p,
+                                              threadAttributes,
+                                              0,
+                                              1,
+                                              1000,
+                                              d_allocator_p);
+
+        int rc = d_databaseThreadPool_sp->start();
+        if (rc != 0) {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        const bsls::TimeInterval interval(
+            static_cast<bsls::Types::Int64>(
+                d_config.databaseReloadInterval().value()),
+            0);
+
+        ntca::TimerOptions timerOptions;
+        timerOptions.setOneShot(false);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+
+        ntci::TimerCallback timerCallback =
+            d_timerFactory_sp->createTimerCallback(
+                bdlf::BindUtil::bind(&Resolver::processDatabaseReloadTimer,
+                                     d_databaseThreadPool_sp,
+                                     d_hostDatabase_sp,
+                                     d_portDatabase_sp,
+                                     d_endpointCache_sp,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2),
+                d_allocator_p);
+
+        d_databaseReloadTimer_sp =
+            d_timerFactory_sp->createTimer(timerOptions,
+                                           timerCallback,
+                                           d_allocator_p);
+
+        d_databaseReloadTimer_sp->schedule(
+            bdlt::CurrentTime::now() + interval,
+            interval);
+    }
+
     d_state = e_STATE_STARTED;
 
     return ntsa::Error();
@@ -541,6 +916,9 @@ void Resolver::shutdown()
 {
     bsl::shared_ptr<ntcdns::Client> client;
     bsl::shared_ptr<ntcdns::System> system;
+    bsl::shared_ptr<ntcdns::Cache>  cache;
+    bsl::shared_ptr<ntci::Timer>    cacheSnapshotTimer;
+    bsl::shared_ptr<ntci::Timer>    databaseReloadTimer;
 
     {
         LockGuard lock(&d_mutex);
@@ -552,9 +930,24 @@ void Resolver::shutdown()
         client = d_client_sp;
         system = d_system_sp;
 
+        if (!d_config.cacheSnapshotPath().isNull()) {
+            cache = d_cache_sp;
+        }
+
+        cacheSnapshotTimer.swap(d_cacheSnapshotTimer_sp);
+        databaseReloadTimer.swap(d_databaseReloadTimer_sp);
+
         d_state = e_STATE_STOPPING;
     }
 
+    if (cacheSnapshotTimer) {
+        cacheSnapshotTimer->close();
+    }
+
+    if (databaseReloadTimer) {
+        databaseReloadTimer->close();
+    }
+
     if (system) {
         system->shutdown();
     }
@@ -562,11 +955,17 @@ void Resolver::shutdown()
     if (client) {
         client->shutdown();
     }
+
+    if (cache) {
+        cache->saveSnapshot(d_config.cacheSnapshotPath().value(),
+                            bdlt::CurrentTime::now());
+    }
 }
 
 void Resolver::linger()
 {
     bsl::shared_ptr<bdlmt::ThreadPool> threadPool;
+    bsl::shared_ptr<bdlmt::ThreadPool> databaseThreadPool;
     bsl::shared_ptr<ntcdns::Client>    client;
     bsl::shared_ptr<ntcdns::System>    system;
     bsl::shared_ptr<ntci::Interface>   interface;
@@ -578,16 +977,21 @@ void Resolver::linger()
             return;
         }
 
-        threadPool = d_threadPool_sp;
-        client     = d_client_sp;
-        system     = d_system_sp;
-        interface  = d_interface_sp;
+        threadPool         = d_threadPool_sp;
+        databaseThreadPool = d_databaseThreadPool_sp;
+        client             = d_client_sp;
+        system             = d_system_sp;
+        interface          = d_interface_sp;
     }
 
     if (threadPool) {
         threadPool->stop();
     }
 
+    if (databaseThreadPool) {
+        databaseThreadPool->stop();
+    }
+
     if (system) {
         system->linger();
     }
@@ -621,6 +1025,10 @@ ntsa::Error Resolver::setIpAddress(
         return error;
     }
 
+    if (d_endpointCache_sp) {
+        d_endpointCache_sp->clear();
+    }
+
     return ntsa::Error();
 }
 
@@ -641,6 +1049,10 @@ ntsa::Error Resolver::addIpAddress(
         return error;
     }
 
+    if (d_endpointCache_sp) {
+        d_endpointCache_sp->clear();
+    }
+
     return ntsa::Error();
 }
 
@@ -660,6 +1072,10 @@ ntsa::Error Resolver::addIpAddress(const bslstl::StringRef& domainName,
         return error;
     }
 
+    if (d_endpointCache_sp) {
+        d_endpointCache_sp->clear();
+    }
+
     return ntsa::Error();
 }
 
@@ -680,6 +1096,10 @@ ntsa::Error Resolver::setPort(const bslstl::StringRef&       serviceName,
         return error;
     }
 
+    if (d_endpointCache_sp) {
+        d_endpointCache_sp->clear();
+    }
+
     return ntsa::Error();
 }
 
@@ -700,6 +1120,10 @@ ntsa::Error Resolver::addPort(const bslstl::StringRef&       serviceName,
         return error;
     }
 
+    if (d_endpointCache_sp) {
+        d_endpointCache_sp->clear();
+    }
+
     return ntsa::Error();
 }
 
@@ -720,6 +1144,10 @@ ntsa::Error Resolver::addPort(const bslstl::StringRef& serviceName,
         return error;
     }
 
+    if (d_endpointCache_sp) {
+        d_endpointCache_sp->clear();
+    }
+
     return ntsa::Error();
 }
 
@@ -1246,9 +1674,10 @@ ntsa::Error Resolver::getPort(const bslstl::StringRef&     serviceName,
         }
     }
 
-    // Get the ports assigned to the service name from the system.
+    // Get the ports assigned to the service name from the system, if
+    // blocking is enabled.
 
-    if (d_executor_sp) {
+    if (d_executor_sp && d_blockingEnabled) {
         error =
             ntsu::ResolverUtil::getPort(&portList, serviceName, portOptions);
         if (!error) {
@@ -1442,9 +1871,10 @@ ntsa::Error Resolver::getServiceName(
         }
     }
 
-    // Get the service name to which the port is assigned from the system.
+    // Get the service name to which the port is assigned from the system, if
+    // blocking is enabled.
 
-    if (d_executor_sp) {
+    if (d_executor_sp && d_blockingEnabled) {
         error =
             ntsu::ResolverUtil::getServiceName(&serviceName, port, transport);
         if (!error) {
@@ -1532,6 +1962,33 @@ ntsa::Error Resolver::getEndpoint(const bslstl::StringRef&         text,
         }
     }
 
+    // Complete the resolution from the endpoint cache, if the same text has
+    // been resolved according to the same options and that resolution has
+    // not expired.
+
+    if (d_endpointCache_sp) {
+        ntca::GetEndpointContext getEndpointContext;
+        error = d_endpointCache_sp->getEndpoint(&getEndpointContext,
+                                                text,
+                                                options,
+                                                startTime);
+        if (!error) {
+            ntca::GetEndpointEvent getEndpointEvent;
+            getEndpointEvent.setType(ntca::GetEndpointEventType::e_COMPLETE);
+            getEndpointEvent.setContext(getEndpointContext);
+
+            callback.dispatch(self,
+                              getEndpointContext.endpointList().front(),
+                              getEndpointEvent,
+                              d_strand_sp,
+                              self,
+                              true,
+                              NTCCFG_MUTEX_NULL);
+
+            return ntsa::Error();
+        }
+    }
+
     const char* begin = text.begin();
     const char* end   = text.end();
 
@@ -1767,6 +2224,10 @@ ntsa::Error Resolver::getEndpoint(const bslstl::StringRef&         text,
         }
 
         if (needPort) {
+            if (!d_blockingEnabled) {
+                return ntsa::Error(ntsa::Error::e_EOF);
+            }
+
             error = ntsu::ResolverUtil::getPort(&portList,
                                                 unresolvedPort,
                                                 portOptions);
@@ -1794,6 +2255,8 @@ ntsa::Error Resolver::getEndpoint(const bslstl::StringRef&         text,
                 bdlf::BindUtil::bind(&Resolver::processGetIpAddressResult,
                                      bdlf::PlaceHolders::_1,
                                      bsl::string(text),
+                                     options,
+                                     d_endpointCache_sp,
                                      startTime,
                                      bdlf::PlaceHolders::_2,
                                      portList,
@@ -1881,6 +2344,16 @@ ntsa::Error Resolver::getEndpoint(const bslstl::StringRef&         text,
     getEndpointContext.setAuthority(text);
     getEndpointContext.setEndpointList(endpointVector);
 
+    // Only cache resolutions of a service name: resolutions of literal
+    // addresses and ports are as cheap to repeat as to look up.
+
+    if (d_endpointCache_sp && !unresolvedPort.empty()) {
+        d_endpointCache_sp->update(text,
+                                   options,
+                                   getEndpointContext,
+                                   startTime);
+    }
+
     ntca::GetEndpointEvent getEndpointEvent;
     getEndpointEvent.setType(ntca::GetEndpointEventType::e_COMPLETE);
     getEndpointEvent.setContext(getEndpointContext);
@@ -2068,7 +2541,16 @@ ntsa::Error Resolver::loadHostDatabaseText(const char* data, bsl::size_t size)
         return ntsa::Error(ntsa::Error::e_INVALID);
     }
 
-    return d_hostDatabase_sp->loadText(data, size);
+    error = d_hostDatabase_sp->loadText(data, size);
+    if (error) {
+        return error;
+    }
+
+    if (d_endpointCache_sp) {
+        d_endpointCache_sp->clear();
+    }
+
+    return ntsa::Error();
 }
 
 ntsa::Error Resolver::loadPortDatabaseText(const char* data, bsl::size_t size)
@@ -2093,7 +2575,16 @@ ntsa::Error Resolver::loadPortDatabaseText(const char* data, bsl::size_t size)
         return ntsa::Error(ntsa::Error::e_INVALID);
     }
 
-    return d_portDatabase_sp->loadText(data, size);
+    error = d_portDatabase_sp->loadText(data, size);
+    if (error) {
+        return error;
+    }
+
+    if (d_endpointCache_sp) {
+        d_endpointCache_sp->clear();
+    }
+
+    return ntsa::Error();
 }
 
 ntsa::Error Resolver::cacheHost(const bsl::string&        domainName,
@@ -2136,5 +2627,11 @@ bsls::TimeInterval Resolver::currentTime() const
     return bdlt::CurrentTime::now();
 }
 
+bool Resolver::hasBlockingThreads() const
+{
+    LockGuard lock(&d_mutex);
+    return d_system_sp.get() != 0 || d_threadPool_sp.get() != 0;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
@@ -20,6 +20,7 @@
 #include <ntcdns_cache.h>
 #include <ntcdns_client.h>
 #include <ntcdns_database.h>
+#include <ntcdns_endpointcache.h>
 #include <ntcdns_system.h>
 #include <ntcdns_vocabulary.h>
 #include <ntci_resolver.h>
@@ -76,11 +77,16 @@ class Resolver : public ntci::Resolver, public ntccfg::Shared<Resolver>
     bsl::shared_ptr<ntcdns::HostDatabase>        d_hostDatabase_sp;
     bsl::shared_ptr<ntcdns::PortDatabase>        d_portDatabase_sp;
     bsl::shared_ptr<ntcdns::Cache>               d_cache_sp;
+    bsl::shared_ptr<ntcdns::EndpointCache>       d_endpointCache_sp;
+    bsl::shared_ptr<ntci::Timer>                 d_cacheSnapshotTimer_sp;
+    bsl::shared_ptr<ntci::Timer>                 d_databaseReloadTimer_sp;
     bsl::shared_ptr<ntcdns::Client>              d_client_sp;
     bsl::shared_ptr<ntcdns::System>              d_system_sp;
     bsl::shared_ptr<bdlmt::ThreadPool>           d_threadPool_sp;
+    bsl::shared_ptr<bdlmt::ThreadPool>           d_databaseThreadPool_sp;
     bsls::AtomicInt                              d_state;
     bool                                         d_initialized;
+    bool                                         d_blockingEnabled;
     ntca::ResolverConfig                         d_config;
     bslma::Allocator*                            d_allocator_p;
 
@@ -89,16 +95,67 @@ class Resolver : public ntci::Resolver, public ntccfg::Shared<Resolver>
     /// system, according to whether each are enabled. Return the error.
     ntsa::Error initialize();
 
-    /// Process the completion of an operation to resolve a domain name to
-    /// an IP address. Invoke the specified 'callback'.
-    static void processGetIpAddressResult(
+    /// Resolve the specified 'domainName' according to the specified
+    /// 'options' using the DNS client, if enabled, so that the cached IP
+    /// addresses assigned to 'domainName' are updated before they expire.
+    void refreshIpAddress(const bsl::string&               domainName,
+                          const ntca::GetIpAddressOptions& options);
+
+    /// Process the completion of an operation to refresh the cached IP
+    /// addresses assigned to a domain name. Note that the result has
+    /// already been stored in the cache.
+    static void processRefreshIpAddressResult(
         const bsl::shared_ptr<ntci::Resolver>& resolver,
-        const bsl::string&                     authority,
-        const bsls::TimeInterval&              startTime,
         const bsl::vector<ntsa::IpAddress>&    ipAddressList,
-        const bsl::vector<ntsa::Port>          portList,
-        const ntca::GetIpAddressEvent&         event,
-        const ntci::GetEndpointCallback&       callback);
+        const ntca::GetIpAddressEvent&         event);
+
+    /// Process the expiration of the specified 'timer' according to the
+    /// specified 'event' by saving a snapshot of the specified 'cache' to
+    /// the file at the specified 'path'.
+    static void processCacheSnapshotTimer(
+        const bsl::shared_ptr<ntcdns::Cache>& cache,
+        const bsl::string&                    path,
+        const bsl::shared_ptr<ntci::Timer>&   timer,
+        const ntca::TimerEvent&               event);
+
+    /// Process the expiration of the specified 'timer' according to the
+    /// specified 'event' by enqueuing a job on the specified 'threadPool'
+    /// to reload the specified 'hostDatabase' and 'portDatabase', unless
+    /// such a job is already pending. The timer thread never reads or
+    /// parses a file.
+    static void processDatabaseReloadTimer(
+        const bsl::shared_ptr<bdlmt::ThreadPool>&     threadPool,
+        const bsl::shared_ptr<ntcdns::HostDatabase>&  hostDatabase,
+        const bsl::shared_ptr<ntcdns::PortDatabase>&  portDatabase,
+        const bsl::shared_ptr<ntcdns::EndpointCache>& endpointCache,
+        const bsl::shared_ptr<ntci::Timer>&           timer,
+        const ntca::TimerEvent&                       event);
+
+    /// Reload the specified 'hostDatabase' and 'portDatabase', if either is
+    /// defined, from their files if those files have been modified, and
+    /// clear the specified 'endpointCache', if defined, if either database
+    /// was reloaded. Each reloaded database publishes its new entries only
+    /// once they are completely parsed.
+    static void reloadDatabases(
+        const bsl::shared_ptr<ntcdns::HostDatabase>&  hostDatabase,
+        const bsl::shared_ptr<ntcdns::PortDatabase>&  portDatabase,
+        const bsl::shared_ptr<ntcdns::EndpointCache>& endpointCache);
+
+    /// Process the completion of an operation to resolve a domain name to
+    /// an IP address. Store the resolved endpoints in the specified
+    /// 'endpointCache', if defined, as the resolution of the specified
+    /// 'authority' according to the specified 'options'. Invoke the
+    /// specified 'callback'.
+    static void processGetIpAddressResult(
+        const bsl::shared_ptr<ntci::Resolver>&        resolver,
+        const bsl::string&                            authority,
+        const ntca::GetEndpointOptions&               options,
+        const bsl::shared_ptr<ntcdns::EndpointCache>& endpointCache,
+        const bsls::TimeInterval&                     startTime,
+        const bsl::vector<ntsa::IpAddress>&           ipAddressList,
+        const bsl::vector<ntsa::Port>                 portList,
+        const ntca::GetIpAddressEvent&                event,
+        const ntci::GetEndpointCallback&              callback);
 
     static const bool k_DEFAULT_HOST_DATABASE_ENABLED;
     static const bool k_DEFAULT_PORT_DATABASE_ENABLED;
@@ -106,6 +163,8 @@ class Resolver : public ntci::Resolver, public ntccfg::Shared<Resolver>
     static const bool k_DEFAULT_POSITIVE_CACHE_ENABLED;
     static const bool k_DEFAULT_NEGATIVE_CACHE_ENABLED;
 
+    static const bool k_DEFAULT_ENDPOINT_CACHE_ENABLED;
+
     static const bool k_DEFAULT_CLIENT_ENABLED;
 
     static const int k_DEFAULT_SYSTEM_MIN_THREADS;
@@ -421,6 +480,11 @@ class Resolver : public ntci::Resolver, public ntccfg::Shared<Resolver>
 
     /// Return the current elapsed time since the Unix epoch.
     bsls::TimeInterval currentTime() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return true if this object has created threads on which to call
+    /// blocking system functions, either directly or through its system
+    /// resolver, otherwise return false.
+    bool hasBlockingThreads() const;
 };
 
 }  // close package namespace
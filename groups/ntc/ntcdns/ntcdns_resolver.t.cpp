@@ -22,6 +22,10 @@ BSLS_IDENT_RCSID(ntcdns_resolver_t_cpp, "$Id$ $CSID$")
 
 #include <ntci_log.h>
 
+#include <bsls_stopwatch.h>
+
+#include <bsl_iostream.h>
+
 using namespace BloombergLP;
 
 namespace BloombergLP {
@@ -30,6 +34,27 @@ namespace ntcdns {
 // Provide tests for 'ntcdns::Resolver'.
 class ResolverTest
 {
+    // Provide an executor that defers functors until drained.
+    class Executor;
+
+    // Load the specified 'ipAddressList' and 'event' into the specified
+    // 'resultIpAddressList' and 'resultEvent'.
+    static void saveGetIpAddressResult(
+        bsl::vector<ntsa::IpAddress>*          resultIpAddressList,
+        ntca::GetIpAddressEvent*               resultEvent,
+        const bsl::shared_ptr<ntci::Resolver>& resolver,
+        const bsl::vector<ntsa::IpAddress>&    ipAddressList,
+        const ntca::GetIpAddressEvent&         event);
+
+    // Load the specified 'portList' and 'event' into the specified
+    // 'resultPortList' and 'resultEvent'.
+    static void saveGetPortResult(
+        bsl::vector<ntsa::Port>*               resultPortList,
+        ntca::GetPortEvent*                    resultEvent,
+        const bsl::shared_ptr<ntci::Resolver>& resolver,
+        const bsl::vector<ntsa::Port>&         portList,
+        const ntca::GetPortEvent&              event);
+
     static void processGetIpAddressResult(
         const bsl::shared_ptr<ntci::Resolver>& resolver,
         const bsl::vector<ntsa::IpAddress>&    ipAddressList,
@@ -128,8 +153,142 @@ class ResolverTest
 
     // TODO
     static void verifyCase21();
+
+    // Concern: A resolver that may not call blocking system functions
+    // cannot be started without an interface or executor on which to
+    // complete its resolutions.
+    static void verifyNonBlocking();
+
+    // Concern: A resolver that may not call blocking system functions, but
+    // is given an executor, resolves names and services from its host and
+    // port databases on that executor, fails to resolve services not in its
+    // port database instead of calling 'getservbyname', and never creates
+    // threads on which to call blocking system functions.
+    static void verifyNonBlockingDatabase();
+
+    // Concern: Repeated resolutions of the same text are completed from the
+    // endpoint cache, until the overrides change. Measure the throughput of
+    // 'getEndpoint' with and without the endpoint cache.
+    static void verifyEndpointCache();
+};
+
+/// Provide an executor that defers functors until drained.
+class ResolverTest::Executor : public ntci::Executor
+{
+    ntccfg::Mutex     d_mutex;
+    FunctorSequence   d_functorQueue;
+    bslma::Allocator* d_allocator_p;
+
+  private:
+    Executor(const Executor&) BSLS_KEYWORD_DELETED;
+    Executor& operator=(const Executor&) BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Create a new executor. Optionally specify a 'basicAllocator' used
+    /// to supply memory. If 'basicAllocator' is 0, the currently installed
+    /// default allocator is used.
+    explicit Executor(bslma::Allocator* basicAllocator = 0);
+
+    /// Destroy this object.
+    ~Executor() BSLS_KEYWORD_OVERRIDE;
+
+    /// Execute each deferred functor, including those deferred while
+    /// draining, on the calling thread. Return the number of functors
+    /// executed.
+    bsl::size_t drain();
+
+    /// Defer the execution of the specified 'functor'.
+    void execute(const Functor& functor) BSLS_KEYWORD_OVERRIDE;
+
+    /// Atomically defer the execution of the specified 'functorSequence'
+    /// immediately followed by the specified 'functor', then clear the
+    /// 'functorSequence'.
+    void moveAndExecute(FunctorSequence* functorSequence,
+                        const Functor&   functor) BSLS_KEYWORD_OVERRIDE;
 };
 
+ResolverTest::Executor::Executor(bslma::Allocator* basicAllocator)
+: d_mutex()
+, d_functorQueue(basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+ResolverTest::Executor::~Executor()
+{
+}
+
+bsl::size_t ResolverTest::Executor::drain()
+{
+    bsl::size_t numExecuted = 0;
+
+    while (true) {
+        FunctorSequence functorQueue(d_allocator_p);
+
+        {
+            ntccfg::LockGuard guard(&d_mutex);
+            functorQueue.swap(d_functorQueue);
+        }
+
+        if (functorQueue.empty()) {
+            break;
+        }
+
+        for (FunctorSequence::iterator it = functorQueue.begin();
+             it != functorQueue.end();
+             ++it)
+        {
+            (*it)();
+            ++numExecuted;
+        }
+    }
+
+    return numExecuted;
+}
+
+void ResolverTest::Executor::execute(const Functor& functor)
+{
+    ntccfg::LockGuard guard(&d_mutex);
+    d_functorQueue.push_back(functor);
+}
+
+void ResolverTest::Executor::moveAndExecute(FunctorSequence* functorSequence,
+                                            const Functor&   functor)
+{
+    ntccfg::LockGuard guard(&d_mutex);
+
+    d_functorQueue.splice(d_functorQueue.end(), *functorSequence);
+    if (functor) {
+        d_functorQueue.push_back(functor);
+    }
+}
+
+void ResolverTest::saveGetIpAddressResult(
+    bsl::vector<ntsa::IpAddress>*          resultIpAddressList,
+    ntca::GetIpAddressEvent*               resultEvent,
+    const bsl::shared_ptr<ntci::Resolver>& resolver,
+    const bsl::vector<ntsa::IpAddress>&    ipAddressList,
+    const ntca::GetIpAddressEvent&         event)
+{
+    NTCCFG_WARNING_UNUSED(resolver);
+
+    *resultIpAddressList = ipAddressList;
+    *resultEvent         = event;
+}
+
+void ResolverTest::saveGetPortResult(
+    bsl::vector<ntsa::Port>*               resultPortList,
+    ntca::GetPortEvent*                    resultEvent,
+    const bsl::shared_ptr<ntci::Resolver>& resolver,
+    const bsl::vector<ntsa::Port>&         portList,
+    const ntca::GetPortEvent&              event)
+{
+    NTCCFG_WARNING_UNUSED(resolver);
+
+    *resultPortList = portList;
+    *resultEvent    = event;
+}
+
 void ResolverTest::processGetIpAddressResult(
     const bsl::shared_ptr<ntci::Resolver>& resolver,
     const bsl::vector<ntsa::IpAddress>&    ipAddressList,
@@ -2192,5 +2351,312 @@ NTSCFG_TEST_FUNCTION(ntcdns::ResolverTest::verifyCase21)
 #endif
 }
 
+NTSCFG_TEST_FUNCTION(ntcdns::ResolverTest::verifyNonBlocking)
+{
+    ntsa::Error error;
+
+    ntca::ResolverConfig resolverConfig;
+    resolverConfig.setBlockingEnabled(false);
+    resolverConfig.setPositiveCacheEnabled(false);
+    resolverConfig.setNegativeCacheEnabled(false);
+
+    bsl::shared_ptr<ntcdns::Resolver> resolver;
+    resolver.createInplace(NTSCFG_TEST_ALLOCATOR,
+                           resolverConfig,
+                           NTSCFG_TEST_ALLOCATOR);
+
+    error = resolver->start();
+    NTSCFG_TEST_EQ(error, ntsa::Error(ntsa::Error::e_INVALID));
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::ResolverTest::verifyNonBlockingDatabase)
+{
+#if NTC_BUILD_FROM_CONTINUOUS_INTEGRATION == 0
+
+    if (!ntscfg::Platform::hasHostDatabase()) {
+        return;
+    }
+
+    if (!ntscfg::Platform::hasPortDatabase()) {
+        return;
+    }
+
+    ntsa::Error error;
+
+    // Define a resolver configuration that may not call blocking system
+    // functions, with the DNS client disabled.
+
+    ntca::ResolverConfig resolverConfig;
+    resolverConfig.setBlockingEnabled(false);
+    resolverConfig.setClientEnabled(false);
+    resolverConfig.setHostDatabaseEnabled(true);
+    resolverConfig.setPortDatabaseEnabled(true);
+    resolverConfig.setPositiveCacheEnabled(false);
+    resolverConfig.setNegativeCacheEnabled(false);
+
+    // Create and start a resolver that completes its resolutions on the
+    // executor.
+
+    bsl::shared_ptr<ResolverTest::Executor> executor;
+    executor.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcdns::Resolver> resolver;
+    resolver.createInplace(NTSCFG_TEST_ALLOCATOR,
+                           resolverConfig,
+                           bsl::shared_ptr<ntci::DatagramSocketFactory>(),
+                           bsl::shared_ptr<ntci::ListenerSocketFactory>(),
+                           bsl::shared_ptr<ntci::StreamSocketFactory>(),
+                           bsl::shared_ptr<ntci::TimerFactory>(),
+                           bsl::shared_ptr<ntci::StrandFactory>(),
+                           executor,
+                           NTSCFG_TEST_ALLOCATOR);
+
+    error = resolver->start();
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_FALSE(resolver->hasBlockingThreads());
+
+    // Set database.
+
+    // clang-format off
+    const char HOST_DATABASE[] = ""
+    "192.168.0.100 test.example.net\n"
+    "\n";
+
+    const char PORT_DATABASE[] = ""
+    "ntsp 6245/tcp\n"
+    "ntsp 6245/udp\n"
+    "\n";
+    // clang-format on
+
+    error = resolver->loadHostDatabaseText(HOST_DATABASE,
+                                           sizeof HOST_DATABASE - 1);
+    NTSCFG_TEST_OK(error);
+
+    error = resolver->loadPortDatabaseText(PORT_DATABASE,
+                                           sizeof PORT_DATABASE - 1);
+    NTSCFG_TEST_OK(error);
+
+    // Get the IP addresses assigned to "test.example.net" from the host
+    // database.
+
+    {
+        bsl::vector<ntsa::IpAddress> ipAddressList(NTSCFG_TEST_ALLOCATOR);
+        ntca::GetIpAddressEvent      event;
+
+        ntci::GetIpAddressCallback callback =
+            resolver->createGetIpAddressCallback(
+                bdlf::BindUtil::bind(&ResolverTest::saveGetIpAddressResult,
+                                     &ipAddressList,
+                                     &event,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2,
+                                     bdlf::PlaceHolders::_3),
+                NTSCFG_TEST_ALLOCATOR);
+
+        ntca::GetIpAddressOptions options;
+        options.setIpAddressType(ntsa::IpAddressType::e_V4);
+
+        error = resolver->getIpAddress("test.example.net", options, callback);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(executor->drain(), 1);
+
+        NTSCFG_TEST_EQ(event.type(), ntca::GetIpAddressEventType::e_COMPLETE);
+        NTSCFG_TEST_EQ(event.context().source(),
+                       ntca::ResolverSource::e_DATABASE);
+        NTSCFG_TEST_EQ(ipAddressList.size(), 1);
+        NTSCFG_TEST_EQ(ipAddressList[0], ntsa::IpAddress("192.168.0.100"));
+    }
+
+    // Get the ports assigned to "ntsp" from the port database.
+
+    {
+        bsl::vector<ntsa::Port> portList(NTSCFG_TEST_ALLOCATOR);
+        ntca::GetPortEvent      event;
+
+        ntci::GetPortCallback callback = resolver->createGetPortCallback(
+            bdlf::BindUtil::bind(&ResolverTest::saveGetPortResult,
+                                 &portList,
+                                 &event,
+                                 bdlf::PlaceHolders::_1,
+                                 bdlf::PlaceHolders::_2,
+                                 bdlf::PlaceHolders::_3),
+            NTSCFG_TEST_ALLOCATOR);
+
+        ntca::GetPortOptions options;
+        options.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+
+        error = resolver->getPort("ntsp", options, callback);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(executor->drain(), 1);
+
+        NTSCFG_TEST_EQ(event.type(), ntca::GetPortEventType::e_COMPLETE);
+        NTSCFG_TEST_EQ(event.context().source(),
+                       ntca::ResolverSource::e_DATABASE);
+        NTSCFG_TEST_EQ(portList.size(), 1);
+        NTSCFG_TEST_EQ(portList[0], 6245);
+    }
+
+    // Get the ports assigned to a service not in the port database. The
+    // resolution fails rather than calling 'getservbyname'.
+
+    {
+        bsl::vector<ntsa::Port> portList(NTSCFG_TEST_ALLOCATOR);
+        ntca::GetPortEvent      event;
+
+        ntci::GetPortCallback callback = resolver->createGetPortCallback(
+            bdlf::BindUtil::bind(&ResolverTest::saveGetPortResult,
+                                 &portList,
+                                 &event,
+                                 bdlf::PlaceHolders::_1,
+                                 bdlf::PlaceHolders::_2,
+                                 bdlf::PlaceHolders::_3),
+            NTSCFG_TEST_ALLOCATOR);
+
+        ntca::GetPortOptions options;
+        options.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+
+        error = resolver->getPort("ntsp-unknown", options, callback);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(executor->drain(), 1);
+
+        NTSCFG_TEST_EQ(event.type(), ntca::GetPortEventType::e_ERROR);
+        NTSCFG_TEST_TRUE(portList.empty());
+    }
+
+    NTSCFG_TEST_FALSE(resolver->hasBlockingThreads());
+
+    // Stop the resolver.
+
+    resolver->shutdown();
+    resolver->linger();
+
+    executor->drain();
+
+    NTSCFG_TEST_FALSE(resolver->hasBlockingThreads());
+
+#endif
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::ResolverTest::verifyEndpointCache)
+{
+    ntsa::Error error;
+
+    const bsl::size_t k_NUM_RESOLUTIONS = 10000;
+
+    for (bsl::size_t variation = 0; variation < 2; ++variation) {
+        const bool endpointCacheEnabled = variation == 1;
+
+        ntca::ResolverConfig resolverConfig;
+        resolverConfig.setClientEnabled(false);
+        resolverConfig.setHostDatabaseEnabled(false);
+        resolverConfig.setPortDatabaseEnabled(false);
+        resolverConfig.setPositiveCacheEnabled(false);
+        resolverConfig.setNegativeCacheEnabled(false);
+        resolverConfig.setSystemEnabled(false);
+        resolverConfig.setEndpointCacheEnabled(endpointCacheEnabled);
+
+        bsl::shared_ptr<ntcdns::Resolver> resolver;
+        resolver.createInplace(NTSCFG_TEST_ALLOCATOR,
+                               resolverConfig,
+                               NTSCFG_TEST_ALLOCATOR);
+
+        error = resolver->start();
+        NTSCFG_TEST_OK(error);
+
+        error = resolver->addIpAddress("test.example.net",
+                                       ntsa::IpAddress("192.168.0.100"));
+        NTSCFG_TEST_OK(error);
+
+        error = resolver->addPort("ntsp",
+                                  6245,
+                                  ntsa::Transport::e_TCP_IPV4_STREAM);
+        NTSCFG_TEST_OK(error);
+
+        bslmt::Semaphore semaphore;
+
+        ntci::GetEndpointCallback overrideCallback =
+            resolver->createGetEndpointCallback(
+                bdlf::BindUtil::bind(&ResolverTest::processGetEndpointResult,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2,
+                                     bdlf::PlaceHolders::_3,
+                                     ntca::ResolverSource::e_OVERRIDE,
+                                     &semaphore),
+                NTSCFG_TEST_ALLOCATOR);
+
+        ntci::GetEndpointCallback cacheCallback =
+            resolver->createGetEndpointCallback(
+                bdlf::BindUtil::bind(&ResolverTest::processGetEndpointResult,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2,
+                                     bdlf::PlaceHolders::_3,
+                                     ntca::ResolverSource::e_CACHE,
+                                     &semaphore),
+                NTSCFG_TEST_ALLOCATOR);
+
+        const ntci::GetEndpointCallback& repeatCallback =
+            endpointCacheEnabled ? cacheCallback : overrideCallback;
+
+        ntca::GetEndpointOptions options;
+        options.setIpAddressType(ntsa::IpAddressType::e_V4);
+
+        // The first resolution is always completed from the overrides.
+
+        error = resolver->getEndpoint("test.example.net:ntsp",
+                                      options,
+                                      overrideCallback);
+        NTSCFG_TEST_OK(error);
+
+        semaphore.wait();
+
+        bsls::Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (bsl::size_t i = 0; i < k_NUM_RESOLUTIONS; ++i) {
+            error = resolver->getEndpoint("test.example.net:ntsp",
+                                          options,
+                                          repeatCallback);
+            NTSCFG_TEST_OK(error);
+
+            semaphore.wait();
+        }
+
+        stopwatch.stop();
+
+        if (NTSCFG_TEST_VERBOSITY > 0) {
+            bsl::cout << "Resolved " << k_NUM_RESOLUTIONS
+                      << " endpoints with the endpoint cache "
+                      << (endpointCacheEnabled ? "enabled" : "disabled")
+                      << " in " << stopwatch.elapsedTime() << " seconds ("
+                      << static_cast<double>(k_NUM_RESOLUTIONS) /
+                             stopwatch.elapsedTime()
+                      << " resolutions per second)" << bsl::endl;
+        }
+
+        // Changing the overrides invalidates the endpoint cache.
+
+        error = resolver->addIpAddress("test.example.net",
+                                       ntsa::IpAddress("192.168.0.101"));
+        NTSCFG_TEST_OK(error);
+
+        error = resolver->getEndpoint("test.example.net:ntsp",
+                                      options,
+                                      overrideCallback);
+        NTSCFG_TEST_OK(error);
+
+        semaphore.wait();
+
+        overrideCallback.reset();
+        cacheCallback.reset();
+
+        resolver->shutdown();
+        resolver->linger();
+    }
+}
+
 }  // close namespace ntcdns
 }  // close namespace BloombergLP
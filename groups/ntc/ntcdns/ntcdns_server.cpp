@@ -15,30 +15,930 @@
 
 #include <ntcdns_server.h>
 
+#include <ntci_log.h>
+#include <ntca_acceptoptions.h>
+#include <ntca_getipaddresscontext.h>
+#include <ntca_getipaddressoptions.h>
+#include <ntca_listenersocketoptions.h>
+#include <ntca_receiveoptions.h>
+#include <ntca_sendoptions.h>
+#include <ntca_timeroptions.h>
+#include <ntsa_ipaddress.h>
+
+#include <bdlbb_blob.h>
+#include <bdlbb_blobutil.h>
+#include <bdlf_bind.h>
+#include <bdlf_placeholder.h>
+
 #include <bslma_allocator.h>
 #include <bslma_default.h>
 #include <bsls_assert.h>
 
+#define NTCDNS_SERVER_LOG_RECEIVE_FAILURE(error)                              \
+    do {                                                                      \
+        NTCI_LOG_STREAM_DEBUG << "Failed to receive: " << (error)             \
+                              << NTCI_LOG_STREAM_END;                         \
+    } while (false)
+
+#define NTCDNS_SERVER_LOG_DECODE_FAILURE(error)                               \
+    do {                                                                      \
+        NTCI_LOG_STREAM_DEBUG << "Failed to decode request: " << (error)      \
+                              << NTCI_LOG_STREAM_END;                         \
+    } while (false)
+
+#define NTCDNS_SERVER_LOG_ENCODE_FAILURE(response, error)                     \
+    do {                                                                      \
+        NTCI_LOG_STREAM_DEBUG << "Failed to encode response " << (response)   \
+                              << ": " << (error) << NTCI_LOG_STREAM_END;      \
+    } while (false)
+
+#define NTCDNS_SERVER_LOG_SEND_FAILURE(response, endpoint, error)             \
+    do {                                                                      \
+        NTCI_LOG_STREAM_DEBUG << "Failed to send response " << (response)     \
+                              << " to " << (endpoint) << ": " << (error)      \
+                              << NTCI_LOG_STREAM_END;                         \
+    } while (false)
+
+#define NTCDNS_SERVER_LOG_ACCEPT_FAILURE(error)                               \
+    do {                                                                      \
+        NTCI_LOG_STREAM_DEBUG << "Failed to accept: " << (error)              \
+                              << NTCI_LOG_STREAM_END;                         \
+    } while (false)
+
 namespace BloombergLP {
 namespace ntcdns {
 
-Server::Server(bslma::Allocator* basicAllocator)
-: d_allocator_p(bslma::Default::allocator(basicAllocator))
+const bsl::size_t Server::k_UDP_MAX_PAYLOAD_SIZE = 65527;
+
+const bsl::uint32_t Server::k_DEFAULT_TTL = 60;
+
+namespace {
+
+/// The size of the length prefix of each DNS message sent over TCP.
+const int k_TCP_LENGTH_PREFIX_SIZE = 2;
+
+}  // close unnamed namespace
+
+void Server::processReadQueueLowWatermark(
+    const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket,
+    const ntca::ReadQueueEvent&                  event)
+{
+    NTCCFG_WARNING_UNUSED(event);
+
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    bsl::shared_ptr<Server> self = this->getSelf(this);
+
+    while (true) {
+        ntca::ReceiveContext receiveContext;
+        ntca::ReceiveOptions receiveOptions;
+
+        bsl::shared_ptr<bdlbb::Blob> requestBlob =
+            datagramSocket->createIncomingBlob();
+
+        error = datagramSocket->receive(&receiveContext,
+                                        requestBlob.get(),
+                                        receiveOptions);
+        if (error) {
+            if (error != ntsa::Error(ntsa::Error::e_WOULD_BLOCK) &&
+                error != ntsa::Error(ntsa::Error::e_EOF))
+            {
+                NTCDNS_SERVER_LOG_RECEIVE_FAILURE(error);
+            }
+            return;
+        }
+
+        if (receiveContext.endpoint().isNull()) {
+            continue;
+        }
+
+        const ntsa::Endpoint endpoint = receiveContext.endpoint().value();
+
+        ++d_numRequests;
+
+        bsl::vector<char> requestData(d_allocator_p);
+        requestData.resize(static_cast<bsl::size_t>(requestBlob->length()));
+        if (!requestData.empty()) {
+            bdlbb::BlobUtil::copy(&requestData.front(),
+                                  *requestBlob,
+                                  0,
+                                  requestBlob->length());
+        }
+
+        ntcdns::Message request(d_allocator_p);
+
+        ntcdns::MemoryDecoder decoder(
+            reinterpret_cast<const bsl::uint8_t*>(requestData.data()),
+            requestData.size());
+
+        error = request.decode(&decoder);
+        if (error) {
+            NTCDNS_SERVER_LOG_DECODE_FAILURE(error);
+            continue;
+        }
+
+        bsl::shared_ptr<ntcdns::Message> response;
+        response.createInplace(d_allocator_p, d_allocator_p);
+
+        bsls::TimeInterval responseDelay;
+        bool               truncate = false;
+        {
+            LockGuard lock(&d_mutex);
+            responseDelay = d_responseDelay;
+            truncate      = d_truncationEnabled;
+        }
+
+        this->processRequest(response.get(), request, truncate);
+
+        if (responseDelay == bsls::TimeInterval()) {
+            this->sendResponse(*response, endpoint);
+            continue;
+        }
+
+        ntca::TimerOptions timerOptions;
+        timerOptions.setOneShot(true);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+
+        ntci::TimerCallback timerCallback =
+            datagramSocket->createTimerCallback(
+                bdlf::BindUtil::bind(&Server::processResponseTimer,
+                                     self,
+                                     bdlf::PlaceHolders::_1,
+                                     bdlf::PlaceHolders::_2,
+                                     response,
+                                     endpoint),
+                d_allocator_p);
+
+        bsl::shared_ptr<ntci::Timer> timer =
+            datagramSocket->createTimer(timerOptions,
+                                        timerCallback,
+                                        d_allocator_p);
+
+        {
+            LockGuard lock(&d_mutex);
+            d_timerSet.insert(timer);
+        }
+
+        timer->schedule(datagramSocket->currentTime() + responseDelay);
+    }
+}
+
+void Server::processRequest(ntcdns::Message*       response,
+                            const ntcdns::Message& request,
+                            bool                   truncate)
 {
+    response->setId(request.id());
+    response->setDirection(ntcdns::Direction::e_RESPONSE);
+    response->setOperation(request.operation());
+    response->setAa(true);
+    response->setRd(request.rd());
+    response->setRa(false);
+    response->setError(ntcdns::Error::e_OK);
+
+    if (request.qdcount() != 1) {
+        response->setError(ntcdns::Error::e_FORMAT_ERROR);
+        return;
+    }
+
+    const ntcdns::Question& question = request.qd(0);
+
+    response->addQd(question);
+
+    if (truncate) {
+        response->setTc(true);
+        return;
+    }
+
+    ntca::GetIpAddressOptions options;
+
+    if (question.type() == ntcdns::Type::e_A) {
+        options.setIpAddressType(ntsa::IpAddressType::e_V4);
+    }
+    else if (question.type() == ntcdns::Type::e_AAAA) {
+        options.setIpAddressType(ntsa::IpAddressType::e_V6);
+    }
+    else {
+        response->setError(ntcdns::Error::e_NOT_IMPLEMENTED);
+        return;
+    }
+
+    bsl::shared_ptr<ntcdns::HostDatabase> hostDatabase;
+    {
+        LockGuard lock(&d_mutex);
+        hostDatabase = d_hostDatabase_sp;
+    }
+
+    bsl::vector<ntsa::IpAddress> ipAddressList(d_allocator_p);
+
+    if (hostDatabase) {
+        ntca::GetIpAddressContext context;
+        hostDatabase->getIpAddress(&context,
+                                   &ipAddressList,
+                                   question.name(),
+                                   options);
+    }
+
+    if (ipAddressList.empty()) {
+        response->setError(ntcdns::Error::e_NAME_ERROR);
+        return;
+    }
+
+    for (bsl::size_t i = 0; i < ipAddressList.size(); ++i) {
+        const ntsa::IpAddress& ipAddress = ipAddressList[i];
+
+        ntcdns::ResourceRecordData rdata;
+
+        if (ipAddress.isV4()) {
+            ipAddress.v4().copyTo(&rdata.makeIpv4(), sizeof rdata.ipv4());
+        }
+        else if (ipAddress.isV6()) {
+            ipAddress.v6().copyTo(&rdata.makeIpv6(), sizeof rdata.ipv6());
+        }
+        else {
+            continue;
+        }
+
+        ntcdns::ResourceRecord& answer = response->addAn();
+        answer.setName(question.name());
+        answer.setType(question.type());
+        answer.setClassification(ntcdns::Classification::e_INTERNET);
+        answer.setTtl(k_DEFAULT_TTL);
+        answer.setRdata(rdata);
+    }
+}
+
+void Server::processResponseTimer(
+    const bsl::shared_ptr<ntci::Timer>&     timer,
+    const ntca::TimerEvent&                 event,
+    const bsl::shared_ptr<ntcdns::Message>& response,
+    const ntsa::Endpoint&                   endpoint)
+{
+    if (event.type() != ntca::TimerEventType::e_DEADLINE) {
+        return;
+    }
+
+    {
+        LockGuard lock(&d_mutex);
+        if (d_timerSet.erase(timer) == 0) {
+            return;
+        }
+    }
+
+    timer->close();
+
+    this->sendResponse(*response, endpoint);
+}
+
+ntsa::Error Server::sendResponse(const ntcdns::Message& response,
+                                 const ntsa::Endpoint&  endpoint)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    bsl::shared_ptr<ntci::DatagramSocket> datagramSocket;
+    {
+        LockGuard lock(&d_mutex);
+        datagramSocket = d_datagramSocket_sp;
+    }
+
+    if (!datagramSocket) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    bsl::shared_ptr<bdlbb::Blob> responseBlob =
+        datagramSocket->createOutgoingBlob();
+
+    error = this->encodeResponse(responseBlob.get(), response, false);
+    if (error) {
+        return error;
+    }
+
+    ntca::SendOptions sendOptions;
+    sendOptions.setEndpoint(endpoint);
+
+    error = datagramSocket->send(*responseBlob, sendOptions);
+    if (error) {
+        NTCDNS_SERVER_LOG_SEND_FAILURE(response, endpoint, error);
+        return error;
+    }
+
+    return ntsa::Error();
+}
+
+ntsa::Error Server::encodeResponse(bdlbb::Blob*           result,
+                                   const ntcdns::Message& response,
+                                   bool                   stream)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    bsl::vector<bsl::uint8_t> responseData(d_allocator_p);
+    responseData.resize(k_UDP_MAX_PAYLOAD_SIZE);
+
+    ntcdns::MemoryEncoder encoder(&responseData.front(), responseData.size());
+
+    error = response.encode(&encoder);
+    if (error) {
+        NTCDNS_SERVER_LOG_ENCODE_FAILURE(response, error);
+        return error;
+    }
+
+    if (stream) {
+        const char prefix[k_TCP_LENGTH_PREFIX_SIZE] = {
+            static_cast<char>((encoder.position() >> 8) & 0xFF),
+            static_cast<char>((encoder.position() >> 0) & 0xFF)};
+
+        bdlbb::BlobUtil::append(result, prefix, k_TCP_LENGTH_PREFIX_SIZE);
+    }
+
+    bdlbb::BlobUtil::append(
+        result,
+        reinterpret_cast<const char*>(&responseData.front()),
+        static_cast<int>(encoder.position()));
+
+    return ntsa::Error();
+}
+
+void Server::accept(
+    const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntci::AcceptCallback acceptCallback = listenerSocket->createAcceptCallback(
+        bdlf::BindUtil::bind(&Server::processAccept,
+                             this->getSelf(this),
+                             listenerSocket,
+                             bdlf::PlaceHolders::_1,
+                             bdlf::PlaceHolders::_2,
+                             bdlf::PlaceHolders::_3),
+        d_allocator_p);
+
+    ntsa::Error error =
+        listenerSocket->accept(ntca::AcceptOptions(), acceptCallback);
+    if (error) {
+        NTCDNS_SERVER_LOG_ACCEPT_FAILURE(error);
+    }
+}
+
+void Server::processAccept(
+    const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket,
+    const bsl::shared_ptr<ntci::Acceptor>&       acceptor,
+    const bsl::shared_ptr<ntci::StreamSocket>&   streamSocket,
+    const ntca::AcceptEvent&                     event)
+{
+    NTCCFG_WARNING_UNUSED(acceptor);
+
+    if (event.type() != ntca::AcceptEventType::e_COMPLETE) {
+        return;
+    }
+
+    {
+        LockGuard lock(&d_mutex);
+
+        if (listenerSocket != d_listenerSocket_sp) {
+            streamSocket->close();
+            return;
+        }
+
+        d_streamSocketSet.insert(streamSocket);
+    }
+
+    ++d_numStreamConnections;
+
+    bsl::shared_ptr<MessageList> pending;
+    pending.createInplace(d_allocator_p, d_allocator_p);
+
+    this->receiveStream(streamSocket, pending);
+    this->accept(listenerSocket);
+}
+
+void Server::receiveStream(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const bsl::shared_ptr<MessageList>&        pending)
+{
+    ntca::ReceiveOptions receiveOptions;
+    receiveOptions.setSize(k_TCP_LENGTH_PREFIX_SIZE);
+
+    ntci::ReceiveCallback receiveCallback =
+        streamSocket->createReceiveCallback(
+            bdlf::BindUtil::bind(&Server::processStreamLength,
+                                 this->getSelf(this),
+                                 streamSocket,
+                                 pending,
+                                 bdlf::PlaceHolders::_1,
+                                 bdlf::PlaceHolders::_2,
+                                 bdlf::PlaceHolders::_3),
+            d_allocator_p);
+
+    ntsa::Error error = streamSocket->receive(receiveOptions, receiveCallback);
+    if (error) {
+        this->closeStream(streamSocket);
+    }
+}
+
+void Server::processStreamLength(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const bsl::shared_ptr<MessageList>&        pending,
+    const bsl::shared_ptr<ntci::Receiver>&     receiver,
+    const bsl::shared_ptr<bdlbb::Blob>&        data,
+    const ntca::ReceiveEvent&                  event)
+{
+    NTCCFG_WARNING_UNUSED(receiver);
+
+    if (event.type() != ntca::ReceiveEventType::e_COMPLETE) {
+        this->closeStream(streamSocket);
+        return;
+    }
+
+    unsigned char prefix[k_TCP_LENGTH_PREFIX_SIZE];
+    bdlbb::BlobUtil::copy(reinterpret_cast<char*>(prefix),
+                          *data,
+                          0,
+                          k_TCP_LENGTH_PREFIX_SIZE);
+
+    const bsl::size_t length = (static_cast<bsl::size_t>(prefix[0]) << 8) |
+                               (static_cast<bsl::size_t>(prefix[1]) << 0);
+
+    if (length == 0) {
+        this->closeStream(streamSocket);
+        return;
+    }
+
+    ntca::ReceiveOptions receiveOptions;
+    receiveOptions.setSize(length);
+
+    ntci::ReceiveCallback receiveCallback =
+        streamSocket->createReceiveCallback(
+            bdlf::BindUtil::bind(&Server::processStreamRequest,
+                                 this->getSelf(this),
+                                 streamSocket,
+                                 pending,
+                                 bdlf::PlaceHolders::_1,
+                                 bdlf::PlaceHolders::_2,
+                                 bdlf::PlaceHolders::_3),
+            d_allocator_p);
+
+    ntsa::Error error = streamSocket->receive(receiveOptions, receiveCallback);
+    if (error) {
+        this->closeStream(streamSocket);
+    }
+}
+
+void Server::processStreamRequest(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const bsl::shared_ptr<MessageList>&        pending,
+    const bsl::shared_ptr<ntci::Receiver>&     receiver,
+    const bsl::shared_ptr<bdlbb::Blob>&        data,
+    const ntca::ReceiveEvent&                  event)
+{
+    NTCCFG_WARNING_UNUSED(receiver);
+
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    if (event.type() != ntca::ReceiveEventType::e_COMPLETE) {
+        this->closeStream(streamSocket);
+        return;
+    }
+
+    ++d_numStreamRequests;
+
+    bool        closeEnabled  = false;
+    bsl::size_t pipelineDepth = 1;
+    {
+        LockGuard lock(&d_mutex);
+        closeEnabled  = d_streamCloseEnabled;
+        pipelineDepth = d_streamPipelineDepth;
+    }
+
+    if (closeEnabled) {
+        this->closeStream(streamSocket);
+        return;
+    }
+
+    bsl::vector<char> requestData(d_allocator_p);
+    requestData.resize(static_cast<bsl::size_t>(data->length()));
+    bdlbb::BlobUtil::copy(&requestData.front(), *data, 0, data->length());
+
+    ntcdns::Message request(d_allocator_p);
+
+    ntcdns::MemoryDecoder decoder(
+        reinterpret_cast<const bsl::uint8_t*>(requestData.data()),
+        requestData.size());
+
+    error = request.decode(&decoder);
+    if (error) {
+        NTCDNS_SERVER_LOG_DECODE_FAILURE(error);
+        this->closeStream(streamSocket);
+        return;
+    }
+
+    bsl::shared_ptr<ntcdns::Message> response;
+    response.createInplace(d_allocator_p, d_allocator_p);
+
+    this->processRequest(response.get(), request, false);
+
+    pending->push_back(response);
+
+    if (pending->size() >= pipelineDepth) {
+        // Answer the pending requests in the reverse order in which they
+        // were received, so that a client must match each answer to its
+        // request by its transaction ID.
+
+        bsl::shared_ptr<bdlbb::Blob> responseBlob =
+            streamSocket->createOutgoingBlob();
+
+        for (MessageList::const_reverse_iterator it = pending->rbegin();
+             it != pending->rend();
+             ++it)
+        {
+            error = this->encodeResponse(responseBlob.get(), **it, true);
+            if (error) {
+                this->closeStream(streamSocket);
+                return;
+            }
+        }
+
+        pending->clear();
+
+        this->sendStream(streamSocket, responseBlob);
+    }
+
+    this->receiveStream(streamSocket, pending);
+}
+
+void Server::sendStream(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const bsl::shared_ptr<bdlbb::Blob>&        data)
+{
+    ntsa::Error error;
+
+    bsl::shared_ptr<Server> self = this->getSelf(this);
+
+    bsl::size_t        fragmentSize = 0;
+    bsls::TimeInterval fragmentDelay;
+    {
+        LockGuard lock(&d_mutex);
+        fragmentSize  = d_streamFragmentSize;
+        fragmentDelay = d_streamFragmentDelay;
+    }
+
+    if (fragmentSize == 0 ||
+        static_cast<bsl::size_t>(data->length()) <= fragmentSize)
+    {
+        error = streamSocket->send(*data, ntca::SendOptions());
+        if (error) {
+            this->closeStream(streamSocket);
+        }
+        return;
+    }
+
+    bsl::shared_ptr<bdlbb::Blob> fragment = streamSocket->createOutgoingBlob();
+    bdlbb::BlobUtil::append(fragment.get(),
+                            *data,
+                            0,
+                            static_cast<int>(fragmentSize));
+
+    bsl::shared_ptr<bdlbb::Blob> remaining =
+        streamSocket->createOutgoingBlob();
+    bdlbb::BlobUtil::append(remaining.get(),
+                            *data,
+                            static_cast<int>(fragmentSize),
+                            data->length() - static_cast<int>(fragmentSize));
+
+    error = streamSocket->send(*fragment, ntca::SendOptions());
+    if (error) {
+        this->closeStream(streamSocket);
+        return;
+    }
+
+    ntca::TimerOptions timerOptions;
+    timerOptions.setOneShot(true);
+    timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+    timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+
+    ntci::TimerCallback timerCallback = streamSocket->createTimerCallback(
+        bdlf::BindUtil::bind(&Server::processStreamFragmentTimer,
+                             self,
+                             bdlf::PlaceHolders::_1,
+                             bdlf::PlaceHolders::_2,
+                             streamSocket,
+                             remaining),
+        d_allocator_p);
+
+    bsl::shared_ptr<ntci::Timer> timer =
+        streamSocket->createTimer(timerOptions, timerCallback, d_allocator_p);
+
+    {
+        LockGuard lock(&d_mutex);
+        d_timerSet.insert(timer);
+    }
+
+    timer->schedule(streamSocket->currentTime() + fragmentDelay);
+}
+
+void Server::processStreamFragmentTimer(
+    const bsl::shared_ptr<ntci::Timer>&        timer,
+    const ntca::TimerEvent&                    event,
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const bsl::shared_ptr<bdlbb::Blob>&        data)
+{
+    if (event.type() != ntca::TimerEventType::e_DEADLINE) {
+        return;
+    }
+
+    {
+        LockGuard lock(&d_mutex);
+        if (d_timerSet.erase(timer) == 0) {
+            return;
+        }
+    }
+
+    timer->close();
+
+    this->sendStream(streamSocket, data);
+}
+
+void Server::closeStream(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket)
+{
+    {
+        LockGuard lock(&d_mutex);
+        if (d_streamSocketSet.erase(streamSocket) == 0) {
+            return;
+        }
+    }
+
+    streamSocket->close();
+}
+
+Server::Server(const ntcdns::ServerConfig& configuration,
+               const bsl::shared_ptr<ntci::DatagramSocketFactory>&
+                                 datagramSocketFactory,
+               bslma::Allocator* basicAllocator)
+: d_object("ntcdns::Server")
+, d_mutex()
+, d_datagramSocket_sp()
+, d_datagramSocketFactory_sp(datagramSocketFactory)
+, d_listenerSocket_sp()
+, d_listenerSocketFactory_sp()
+, d_streamSocketSet(basicAllocator)
+, d_hostDatabase_sp()
+, d_responseDelay()
+, d_truncationEnabled(false)
+, d_streamCloseEnabled(false)
+, d_streamPipelineDepth(1)
+, d_streamFragmentSize(0)
+, d_streamFragmentDelay()
+, d_timerSet(basicAllocator)
+, d_numRequests(0)
+, d_numStreamRequests(0)
+, d_numStreamConnections(0)
+, d_config(configuration, basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT_OPT(d_datagramSocketFactory_sp);
+}
+
+Server::Server(const ntcdns::ServerConfig& configuration,
+               const bsl::shared_ptr<ntci::DatagramSocketFactory>&
+                   datagramSocketFactory,
+               const bsl::shared_ptr<ntci::ListenerSocketFactory>&
+                                 listenerSocketFactory,
+               bslma::Allocator* basicAllocator)
+: d_object("ntcdns::Server")
+, d_mutex()
+, d_datagramSocket_sp()
+, d_datagramSocketFactory_sp(datagramSocketFactory)
+, d_listenerSocket_sp()
+, d_listenerSocketFactory_sp(listenerSocketFactory)
+, d_streamSocketSet(basicAllocator)
+, d_hostDatabase_sp()
+, d_responseDelay()
+, d_truncationEnabled(false)
+, d_streamCloseEnabled(false)
+, d_streamPipelineDepth(1)
+, d_streamFragmentSize(0)
+, d_streamFragmentDelay()
+, d_timerSet(basicAllocator)
+, d_numRequests(0)
+, d_numStreamRequests(0)
+, d_numStreamConnections(0)
+, d_config(configuration, basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT_OPT(d_datagramSocketFactory_sp);
+    BSLS_ASSERT_OPT(d_listenerSocketFactory_sp);
 }
 
 Server::~Server()
 {
 }
 
-int Server::manipulator()
+void Server::setHostDatabase(
+    const bsl::shared_ptr<ntcdns::HostDatabase>& hostDatabase)
+{
+    LockGuard lock(&d_mutex);
+    d_hostDatabase_sp = hostDatabase;
+}
+
+void Server::setResponseDelay(const bsls::TimeInterval& responseDelay)
+{
+    LockGuard lock(&d_mutex);
+    d_responseDelay = responseDelay;
+}
+
+void Server::setTruncationEnabled(bool value)
+{
+    LockGuard lock(&d_mutex);
+    d_truncationEnabled = value;
+}
+
+void Server::setStreamPipelineDepth(bsl::size_t value)
+{
+    LockGuard lock(&d_mutex);
+    d_streamPipelineDepth = value > 0 ? value : 1;
+}
+
+void Server::setStreamFragmentation(bsl::size_t               fragmentSize,
+                                    const bsls::TimeInterval& fragmentDelay)
+{
+    LockGuard lock(&d_mutex);
+    d_streamFragmentSize  = fragmentSize;
+    d_streamFragmentDelay = fragmentDelay;
+}
+
+void Server::setStreamCloseEnabled(bool value)
+{
+    LockGuard lock(&d_mutex);
+    d_streamCloseEnabled = value;
+}
+
+ntsa::Error Server::start()
+{
+    ntsa::Error error;
+
+    bsl::shared_ptr<Server> self = this->getSelf(this);
+
+    LockGuard lock(&d_mutex);
+
+    if (d_datagramSocket_sp) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    ntsa::IpAddress ipAddress;
+    if (!ipAddress.parse(d_config.nameServer().address().host())) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    ntsa::Endpoint sourceEndpoint(
+        ntsa::IpEndpoint(ipAddress,
+                         d_config.nameServer().address().port().valueOr(0)));
+
+    ntca::DatagramSocketOptions datagramSocketOptions;
+    datagramSocketOptions.setSourceEndpoint(sourceEndpoint);
+    datagramSocketOptions.setMaxDatagramSize(k_UDP_MAX_PAYLOAD_SIZE);
+
+    bsl::shared_ptr<ntci::DatagramSocket> datagramSocket =
+        d_datagramSocketFactory_sp->createDatagramSocket(datagramSocketOptions,
+                                                         d_allocator_p);
+
+    error = datagramSocket->registerSession(self);
+    if (error) {
+        datagramSocket->close();
+        return error;
+    }
+
+    error = datagramSocket->open();
+    if (error) {
+        datagramSocket->close();
+        return error;
+    }
+
+    error = datagramSocket->relaxFlowControl(ntca::FlowControlType::e_RECEIVE);
+    if (error) {
+        datagramSocket->close();
+        return error;
+    }
+
+    if (d_listenerSocketFactory_sp) {
+        ntca::ListenerSocketOptions listenerSocketOptions;
+        listenerSocketOptions.setTransport(
+            ntsa::Transport::e_TCP_IPV4_STREAM);
+        listenerSocketOptions.setSourceEndpoint(
+            datagramSocket->sourceEndpoint());
+
+        if (ipAddress.isV6()) {
+            listenerSocketOptions.setTransport(
+                ntsa::Transport::e_TCP_IPV6_STREAM);
+        }
+
+        bsl::shared_ptr<ntci::ListenerSocket> listenerSocket =
+            d_listenerSocketFactory_sp->createListenerSocket(
+                listenerSocketOptions,
+                d_allocator_p);
+
+        error = listenerSocket->open();
+        if (!error) {
+            error = listenerSocket->listen();
+        }
+
+        if (error) {
+            listenerSocket->close();
+            datagramSocket->close();
+            return error;
+        }
+
+        d_listenerSocket_sp = listenerSocket;
+    }
+
+    d_datagramSocket_sp = datagramSocket;
+
+    if (d_listenerSocket_sp) {
+        bsl::shared_ptr<ntci::ListenerSocket> listenerSocket =
+            d_listenerSocket_sp;
+
+        lock.release()->unlock();
+
+        this->accept(listenerSocket);
+    }
+
+    return ntsa::Error();
+}
+
+void Server::shutdown()
+{
+    bsl::shared_ptr<ntci::DatagramSocket> datagramSocket;
+    bsl::shared_ptr<ntci::ListenerSocket> listenerSocket;
+    StreamSocketSet                       streamSocketSet(d_allocator_p);
+    TimerSet                              timerSet(d_allocator_p);
+    {
+        LockGuard lock(&d_mutex);
+        datagramSocket.swap(d_datagramSocket_sp);
+        listenerSocket.swap(d_listenerSocket_sp);
+        streamSocketSet.swap(d_streamSocketSet);
+        timerSet.swap(d_timerSet);
+    }
+
+    for (TimerSet::iterator it = timerSet.begin(); it != timerSet.end(); ++it)
+    {
+        (*it)->close();
+    }
+
+    if (listenerSocket) {
+        listenerSocket->close();
+    }
+
+    for (StreamSocketSet::iterator it = streamSocketSet.begin();
+         it != streamSocketSet.end();
+         ++it)
+    {
+        (*it)->close();
+    }
+
+    if (datagramSocket) {
+        datagramSocket->registerSession(
+            bsl::shared_ptr<ntci::DatagramSocketSession>());
+        datagramSocket->close();
+    }
+}
+
+ntsa::Endpoint Server::sourceEndpoint() const
+{
+    LockGuard lock(&d_mutex);
+
+    if (d_datagramSocket_sp) {
+        return d_datagramSocket_sp->sourceEndpoint();
+    }
+
+    return ntsa::Endpoint();
+}
+
+bsl::uint64_t Server::numRequests() const
+{
+    return d_numRequests.load();
+}
+
+bsl::uint64_t Server::numStreamRequests() const
+{
+    return d_numStreamRequests.load();
+}
+
+bsl::uint64_t Server::numStreamConnections() const
 {
-    return 0;
+    return d_numStreamConnections.load();
 }
 
-int Server::accessor() const
+bsl::size_t Server::numStreamConnectionsOpen() const
 {
-    return 0;
+    LockGuard lock(&d_mutex);
+    return d_streamSocketSet.size();
 }
 
 }  // close package namespace
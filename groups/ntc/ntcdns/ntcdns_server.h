@@ -18,7 +18,32 @@
 
 #include <ntcscm_version.h>
 
+#include <ntcdns_database.h>
+#include <ntcdns_protocol.h>
+#include <ntcdns_vocabulary.h>
+
+#include <ntca_acceptevent.h>
+#include <ntca_receiveevent.h>
+#include <ntccfg_platform.h>
+#include <ntci_acceptor.h>
+#include <ntci_datagramsocket.h>
+#include <ntci_datagramsocketfactory.h>
+#include <ntci_datagramsocketsession.h>
+#include <ntci_listenersocket.h>
+#include <ntci_listenersocketfactory.h>
+#include <ntci_receiver.h>
+#include <ntci_streamsocket.h>
+#include <ntci_timer.h>
+#include <ntsa_endpoint.h>
+#include <ntsa_error.h>
+
+#include <bdlbb_blob.h>
+#include <bsls_atomic.h>
+#include <bsls_keyword.h>
+#include <bsls_timeinterval.h>
+
 #include <bsl_memory.h>
+#include <bsl_set.h>
 #include <bsl_string.h>
 #include <bsl_vector.h>
 
@@ -28,34 +53,248 @@ namespace ntcdns {
 /// @internal @brief
 /// Provide a DNS server.
 ///
+/// @details
+/// Provide a mechanism that answers DNS queries received over UDP for the
+/// IPv4 and IPv6 addresses assigned to a domain name from a host database.
+/// Queries for domain names not found in the host database are answered with
+/// a name error; queries of any other type are answered as not implemented.
+/// Answers may be artificially delayed to emulate a slow name server.
+///
+/// If the server is created with a listener socket factory, it also answers
+/// queries received over TCP on the same port, each message preceded by its
+/// two byte length. To exercise the fallback of clients from UDP to TCP, the
+/// server may truncate each answer sent over UDP, defer its answers over a
+/// TCP connection until several queries are outstanding and then answer
+/// them in reverse order, send its answers over TCP in small fragments
+/// spaced apart in time, or close each TCP connection on which a query is
+/// received without answering it.
+///
 /// @par Thread Safety
 /// This class is thread safe.
 ///
 /// @ingroup module_ntcdns
-class Server
+class Server : public ntci::DatagramSocketSession,
+               public ntccfg::Shared<Server>
 {
-    bslma::Allocator* d_allocator_p;
+    /// Define a type alias for a mutex.
+    typedef ntccfg::Mutex Mutex;
+
+    /// Define a type alias for a mutex lock guard.
+    typedef ntccfg::LockGuard LockGuard;
+
+    /// Define a type alias for a set of timers.
+    typedef bsl::set<bsl::shared_ptr<ntci::Timer> > TimerSet;
+
+    /// Define a type alias for a set of stream sockets.
+    typedef bsl::set<bsl::shared_ptr<ntci::StreamSocket> > StreamSocketSet;
+
+    /// Define a type alias for a list of responses.
+    typedef bsl::vector<bsl::shared_ptr<ntcdns::Message> > MessageList;
+
+    ntccfg::Object                               d_object;
+    mutable Mutex                                d_mutex;
+    bsl::shared_ptr<ntci::DatagramSocket>        d_datagramSocket_sp;
+    bsl::shared_ptr<ntci::DatagramSocketFactory> d_datagramSocketFactory_sp;
+    bsl::shared_ptr<ntci::ListenerSocket>        d_listenerSocket_sp;
+    bsl::shared_ptr<ntci::ListenerSocketFactory> d_listenerSocketFactory_sp;
+    StreamSocketSet                              d_streamSocketSet;
+    bsl::shared_ptr<ntcdns::HostDatabase>        d_hostDatabase_sp;
+    bsls::TimeInterval                           d_responseDelay;
+    bool                                         d_truncationEnabled;
+    bool                                         d_streamCloseEnabled;
+    bsl::size_t                                  d_streamPipelineDepth;
+    bsl::size_t                                  d_streamFragmentSize;
+    bsls::TimeInterval                           d_streamFragmentDelay;
+    TimerSet                                     d_timerSet;
+    bsls::AtomicUint64                           d_numRequests;
+    bsls::AtomicUint64                           d_numStreamRequests;
+    bsls::AtomicUint64                           d_numStreamConnections;
+    const ntcdns::ServerConfig                   d_config;
+    bslma::Allocator*                            d_allocator_p;
+
+    /// The maximum UDP payload size.
+    static const bsl::size_t k_UDP_MAX_PAYLOAD_SIZE;
+
+    /// The time to live, in seconds, of each answer.
+    static const bsl::uint32_t k_DEFAULT_TTL;
 
   private:
     Server(const Server&) BSLS_KEYWORD_DELETED;
     Server& operator=(const Server&) BSLS_KEYWORD_DELETED;
 
+  private:
+    /// Process the condition that the size of the read queue is greater
+    /// than or equal to the read queue low watermark.
+    void processReadQueueLowWatermark(
+        const bsl::shared_ptr<ntci::DatagramSocket>& datagramSocket,
+        const ntca::ReadQueueEvent& event) BSLS_KEYWORD_OVERRIDE;
+
+    /// Load into the specified 'response' the answer to the specified
+    /// 'request'. If the specified 'truncate' flag is true, answer with
+    /// only the question and the truncation flag set.
+    void processRequest(ntcdns::Message*       response,
+                        const ntcdns::Message& request,
+                        bool                   truncate);
+
+    /// Process the expiration of the specified 'timer' according to the
+    /// specified 'event' by sending the specified 'response' to the
+    /// specified 'endpoint'.
+    void processResponseTimer(
+        const bsl::shared_ptr<ntci::Timer>&     timer,
+        const ntca::TimerEvent&                 event,
+        const bsl::shared_ptr<ntcdns::Message>& response,
+        const ntsa::Endpoint&                   endpoint);
+
+    /// Send the specified 'response' to the specified 'endpoint'. Return
+    /// the error.
+    ntsa::Error sendResponse(const ntcdns::Message& response,
+                             const ntsa::Endpoint&  endpoint);
+
+    /// Append the specified 'response' to the specified 'result', preceded
+    /// by its two byte length if the specified 'stream' flag is true.
+    /// Return the error.
+    ntsa::Error encodeResponse(bdlbb::Blob*           result,
+                               const ntcdns::Message& response,
+                               bool                   stream);
+
+    /// Accept the next connection to the specified 'listenerSocket'.
+    void accept(const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket);
+
+    /// Process the acceptance of the specified 'streamSocket' from the
+    /// specified 'listenerSocket' according to the specified 'event'.
+    void processAccept(
+        const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket,
+        const bsl::shared_ptr<ntci::Acceptor>&       acceptor,
+        const bsl::shared_ptr<ntci::StreamSocket>&   streamSocket,
+        const ntca::AcceptEvent&                     event);
+
+    /// Receive the length of the next request from the specified
+    /// 'streamSocket', on which the specified 'pending' responses have not
+    /// yet been sent.
+    void receiveStream(const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+                       const bsl::shared_ptr<MessageList>&        pending);
+
+    /// Process the receipt of the specified 'data' containing the length of
+    /// the next request from the specified 'streamSocket' according to the
+    /// specified 'event'.
+    void processStreamLength(
+        const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+        const bsl::shared_ptr<MessageList>&        pending,
+        const bsl::shared_ptr<ntci::Receiver>&     receiver,
+        const bsl::shared_ptr<bdlbb::Blob>&        data,
+        const ntca::ReceiveEvent&                  event);
+
+    /// Process the receipt of the specified 'data' containing the next
+    /// request from the specified 'streamSocket' according to the specified
+    /// 'event'.
+    void processStreamRequest(
+        const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+        const bsl::shared_ptr<MessageList>&        pending,
+        const bsl::shared_ptr<ntci::Receiver>&     receiver,
+        const bsl::shared_ptr<bdlbb::Blob>&        data,
+        const ntca::ReceiveEvent&                  event);
+
+    /// Send the specified 'data' through the specified 'streamSocket',
+    /// either entirely or, if fragmentation is configured, one fragment at
+    /// a time.
+    void sendStream(const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+                    const bsl::shared_ptr<bdlbb::Blob>&        data);
+
+    /// Process the expiration of the specified 'timer' according to the
+    /// specified 'event' by sending the next fragment of the specified
+    /// 'data' through the specified 'streamSocket'.
+    void processStreamFragmentTimer(
+        const bsl::shared_ptr<ntci::Timer>&        timer,
+        const ntca::TimerEvent&                    event,
+        const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+        const bsl::shared_ptr<bdlbb::Blob>&        data);
+
+    /// Close the specified 'streamSocket', if it is still open.
+    void closeStream(const bsl::shared_ptr<ntci::StreamSocket>& streamSocket);
+
   public:
-    /// Create a new object. Optionally specify a 'basicAllocator' used to
-    /// supply memory. If 'basicAllocator' is 0, the currently installed
+    /// Create a new server having the specified 'configuration' that
+    /// receives requests using datagram sockets created by the specified
+    /// 'datagramSocketFactory'. Optionally specify a 'basicAllocator' used
+    /// to supply memory. If 'basicAllocator' is 0, the currently installed
     /// default allocator is used.
-    explicit Server(bslma::Allocator* basicAllocator = 0);
+    Server(const ntcdns::ServerConfig& configuration,
+           const bsl::shared_ptr<ntci::DatagramSocketFactory>&
+                             datagramSocketFactory,
+           bslma::Allocator* basicAllocator = 0);
+
+    /// Create a new server having the specified 'configuration' that
+    /// receives requests using datagram sockets created by the specified
+    /// 'datagramSocketFactory' and connections accepted by listener sockets
+    /// created by the specified 'listenerSocketFactory'. Optionally specify
+    /// a 'basicAllocator' used to supply memory. If 'basicAllocator' is 0,
+    /// the currently installed default allocator is used.
+    Server(const ntcdns::ServerConfig& configuration,
+           const bsl::shared_ptr<ntci::DatagramSocketFactory>&
+               datagramSocketFactory,
+           const bsl::shared_ptr<ntci::ListenerSocketFactory>&
+                             listenerSocketFactory,
+           bslma::Allocator* basicAllocator = 0);
 
     /// Destroy this object.
-    ~Server();
+    ~Server() BSLS_KEYWORD_OVERRIDE;
+
+    /// Set the host database from which queries are answered to the
+    /// specified 'hostDatabase'.
+    void setHostDatabase(
+        const bsl::shared_ptr<ntcdns::HostDatabase>& hostDatabase);
+
+    /// Set the delay after which each query is answered to the specified
+    /// 'responseDelay'. The default value is zero, indicating each query is
+    /// answered immediately.
+    void setResponseDelay(const bsls::TimeInterval& responseDelay);
+
+    /// Set the flag that indicates each answer sent over UDP is truncated
+    /// to the specified 'value'. The default value is false.
+    void setTruncationEnabled(bool value);
+
+    /// Set the number of queries that must be received over a TCP
+    /// connection before they are answered, in reverse order, to the
+    /// specified 'value'. The default value is 1, indicating each query is
+    /// answered when received.
+    void setStreamPipelineDepth(bsl::size_t value);
+
+    /// Send the answers over TCP in fragments of at most the specified
+    /// 'fragmentSize', each sent the specified 'fragmentDelay' after the
+    /// previous one. The default fragment size is zero, indicating the
+    /// answers are not fragmented.
+    void setStreamFragmentation(bsl::size_t               fragmentSize,
+                                const bsls::TimeInterval& fragmentDelay);
+
+    /// Set the flag that indicates each TCP connection is closed, without
+    /// answering, when a query is received on it to the specified 'value'.
+    /// The default value is false.
+    void setStreamCloseEnabled(bool value);
+
+    /// Start the server: open a datagram socket bound to the endpoint of
+    /// the name server in the configuration and, if the server was created
+    /// with a listener socket factory, a listener socket bound to the same
+    /// endpoint, and begin answering queries. Return the error.
+    ntsa::Error start();
+
+    /// Stop the server: close its sockets and discard each answer not yet
+    /// sent.
+    void shutdown();
+
+    /// Return the endpoint to which the server is bound.
+    ntsa::Endpoint sourceEndpoint() const;
+
+    /// Return the number of requests received over UDP.
+    bsl::uint64_t numRequests() const;
+
+    /// Return the number of requests received over TCP.
+    bsl::uint64_t numStreamRequests() const;
 
-    /// What the function does. What the function returns. More about
-    /// essential behavior. Conditions leading to undefined behavior. Notes.
-    int manipulator();
+    /// Return the number of TCP connections accepted.
+    bsl::uint64_t numStreamConnections() const;
 
-    /// What the function does. What the function returns. More about
-    /// essential behavior. Conditions leading to undefined behavior. Notes.
-    int accessor() const;
+    /// Return the number of TCP connections accepted that are still open.
+    bsl::size_t numStreamConnectionsOpen() const;
 };
 
 }  // close package namespace
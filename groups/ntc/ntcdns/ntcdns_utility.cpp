@@ -57,6 +57,8 @@
 #endif
 
 // Uncomment or set to 0 to 'read' files instead of memory-mapping them.
+// Files are read by default: a database index holds its file while lookups
+// may search it, and a mapped file truncated in place would fault them.
 // #define NTCDNS_UTILITY_MEMORY_MAP_FILES 1
 
 // Uncomment or set to to zero to avoid forcibilly trimming leading and
@@ -115,6 +117,17 @@ class Utility::Impl
     static ntsa::Error parsePortLine(ntcdns::PortDatabaseConfig* config,
                                      const bslstl::StringRef&    line);
 
+    // Load into the specified 'result' the host lookup sources parsed from
+    // the specified 'line', if the line is the "hosts" entry of a name
+    // service switch configuration. Return true if the line is the "hosts"
+    // entry, and false otherwise.
+    static bool parseHostLookupLine(bsl::vector<bsl::string>* result,
+                                    const bslstl::StringRef&  line);
+
+    // Load into the specified 'result' the host lookup sources consulted
+    // when no name service switch configuration defines them.
+    static void loadDefaultHostLookupOrder(bsl::vector<bsl::string>* result);
+
 #if defined(BSLS_PLATFORM_OS_WINDOWS)
 
     /// Load into the specified 'destination' string the specified
@@ -142,6 +155,10 @@ class Utility::Impl
     /// generated.
     static const bool k_DEFAULT_DEBUG;
 
+    /// The default flag that indicates whether queries should be sent over
+    /// TCP rather than UDP.
+    static const bool k_DEFAULT_USE_VC;
+
     /// The default dot count threshold before a name is assumed to be an
     /// absolute name.
     static const bsl::size_t k_DEFAULT_NDOTS;
@@ -166,6 +183,7 @@ class Utility::Impl
 const bsl::size_t Utility::Impl::k_DEFAULT_TIMEOUT = 5;
 const bool        Utility::Impl::k_DEFAULT_ROTATE  = false;
 const bool        Utility::Impl::k_DEFAULT_DEBUG   = false;
+const bool        Utility::Impl::k_DEFAULT_USE_VC  = false;
 const bsl::size_t Utility::Impl::k_DEFAULT_NDOTS   = 1;
 const ntsa::Port  Utility::Impl::k_DEFAULT_PORT    = 53;
 // const bsl::size_t Utility::Impl::k_MAX_SEARCH_ENTRIES = 6;
@@ -422,6 +440,12 @@ ntsa::Error Utility::Impl::parseClientConfigLine(ntcdns::ClientConfig* config,
                     {
                         config->rotate() = true;
                     }
+                    else if (bdlb::StringRefUtil::areEqualCaseless(
+                                 key,
+                                 bslstl::StringRef("use-vc", 6)))
+                    {
+                        config->useVc() = true;
+                    }
                     else if (bdlb::StringRefUtil::areEqualCaseless(
                                  key,
                                  bslstl::StringRef("ndots", 5)))
@@ -503,6 +527,60 @@ ntsa::Error Utility::Impl::parseClientConfigLine(ntcdns::ClientConfig* config,
                             }
                         }
                     }
+                    else if (bdlb::StringRefUtil::areEqualCaseless(
+                                 key,
+                                 bslstl::StringRef("hedge-delay", 11)))
+                    {
+                        ++subtokenizer;
+
+                        if (subtokenizer.isValid()) {
+                            bslstl::StringRef value =
+                                bdlb::StringRefUtil::trim(
+                                    subtokenizer.token());
+
+                            error = parseUnsignedInteger(
+                                &config->hedgeDelay().makeValue(),
+                                value);
+
+                            if (error) {
+                                NTCI_LOG_STREAM_WARN
+                                    << "Unsupported DNS resolver "
+                                       "configuration option '"
+                                    << "hedge-delay"
+                                    << "' value: " << value
+                                    << NTCI_LOG_STREAM_END;
+
+                                config->hedgeDelay().reset();
+                            }
+                        }
+                    }
+                    else if (bdlb::StringRefUtil::areEqualCaseless(
+                                 key,
+                                 bslstl::StringRef("hedge-percentile", 16)))
+                    {
+                        ++subtokenizer;
+
+                        if (subtokenizer.isValid()) {
+                            bslstl::StringRef value =
+                                bdlb::StringRefUtil::trim(
+                                    subtokenizer.token());
+
+                            error = parseUnsignedInteger(
+                                &config->hedgePercentile().makeValue(),
+                                value);
+
+                            if (error) {
+                                NTCI_LOG_STREAM_WARN
+                                    << "Unsupported DNS resolver "
+                                       "configuration option '"
+                                    << "hedge-percentile"
+                                    << "' value: " << value
+                                    << NTCI_LOG_STREAM_END;
+
+                                config->hedgePercentile().reset();
+                            }
+                        }
+                    }
                     else {
                         NTCI_LOG_STREAM_WARN << "Unsupported DNS resolver "
                                                 "configuration option '"
@@ -740,6 +818,84 @@ ntsa::Error Utility::Impl::parsePortLine(ntcdns::PortDatabaseConfig* config,
     return ntsa::Error();
 }
 
+bool Utility::Impl::parseHostLookupLine(bsl::vector<bsl::string>* result,
+                                        const bslstl::StringRef&  line)
+{
+    bslstl::StringRef uncommentedLine = line;
+    for (bsl::size_t i = 0; i < uncommentedLine.size(); ++i) {
+        if (uncommentedLine[i] == '#') {
+            uncommentedLine.assign(line.data(), line.data() + i);
+            break;
+        }
+    }
+
+    uncommentedLine = bdlb::StringRefUtil::trim(uncommentedLine);
+
+    bsl::size_t colon = 0;
+    while (colon < uncommentedLine.size() && uncommentedLine[colon] != ':') {
+        ++colon;
+    }
+
+    if (colon == uncommentedLine.size()) {
+        return false;
+    }
+
+    bslstl::StringRef database = bdlb::StringRefUtil::trim(
+        bslstl::StringRef(uncommentedLine.data(), colon));
+
+    if (!bdlb::StringRefUtil::areEqualCaseless(database,
+                                               bslstl::StringRef("hosts", 5)))
+    {
+        return false;
+    }
+
+    result->clear();
+
+    bslstl::StringRef sources(uncommentedLine.data() + colon + 1,
+                              uncommentedLine.size() - colon - 1);
+
+    bdlb::Tokenizer tokenizer(sources, " \t", "");
+
+    bool withinAction = false;
+
+    while (tokenizer.isValid()) {
+        bslstl::StringRef token = tokenizer.token();
+        ++tokenizer;
+
+        // Skip the actions, e.g. "[NOTFOUND=return]", that follow a source.
+
+        if (withinAction || (!token.empty() && token[0] == '[')) {
+            withinAction = token.empty() || token[token.size() - 1] != ']';
+            continue;
+        }
+
+        bsl::string source(token);
+        for (bsl::size_t i = 0; i < source.size(); ++i) {
+            source[i] = bdlb::CharType::toLower(source[i]);
+        }
+
+        result->push_back(source);
+    }
+
+    return true;
+}
+
+void Utility::Impl::loadDefaultHostLookupOrder(
+    bsl::vector<bsl::string>* result)
+{
+    result->clear();
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+    result->push_back("files");
+    result->push_back("dns");
+#else
+    // The order consulted by glibc when no "hosts" entry is defined.
+
+    result->push_back("dns");
+    result->push_back("files");
+#endif
+}
+
 #if defined(BSLS_PLATFORM_OS_WINDOWS)
 
 ntsa::Error Utility::Impl::convertWideString(bsl::string* destination,
@@ -971,6 +1127,18 @@ void Utility::Impl::sanitizeClientConfig(ntcdns::ClientConfig* config)
     if (config->debug().isNull()) {
         config->debug() = k_DEFAULT_DEBUG;
     }
+
+    if (config->useVc().isNull()) {
+        config->useVc() = k_DEFAULT_USE_VC;
+    }
+
+    if (!config->hedgePercentile().isNull()) {
+        if (config->hedgePercentile().value() == 0 ||
+            config->hedgePercentile().value() >= 100)
+        {
+            config->hedgePercentile().reset();
+        }
+    }
 }
 
 File::File(bslma::Allocator* basicAllocator)
@@ -1663,6 +1831,72 @@ ntsa::Error Utility::loadPortDatabaseConfigFromText(
     return ntsa::Error();
 }
 
+ntsa::Error Utility::loadHostLookupOrder(bsl::vector<bsl::string>* result)
+{
+#if defined(BSLS_PLATFORM_OS_UNIX)
+
+    const bsl::string path = "/etc/nsswitch.conf";
+
+    if (bdls::FilesystemUtil::exists(path)) {
+        return loadHostLookupOrderFromPath(result, path);
+    }
+    else {
+        Utility::Impl::loadDefaultHostLookupOrder(result);
+        return ntsa::Error();
+    }
+
+#elif defined(BSLS_PLATFORM_OS_WINDOWS)
+
+    Utility::Impl::loadDefaultHostLookupOrder(result);
+    return ntsa::Error();
+
+#else
+#error Not implemented
+#endif
+}
+
+ntsa::Error Utility::loadHostLookupOrderFromPath(
+    bsl::vector<bsl::string>* result,
+    const bsl::string&        path)
+{
+    ntsa::Error error;
+
+    ntcdns::File file;
+    error = file.load(path);
+    if (error) {
+        return error;
+    }
+
+    if (file.size() == 0) {
+        Utility::Impl::loadDefaultHostLookupOrder(result);
+        return ntsa::Error();
+    }
+
+    return loadHostLookupOrderFromText(result, file.data(), file.size());
+}
+
+ntsa::Error Utility::loadHostLookupOrderFromText(
+    bsl::vector<bsl::string>* result,
+    const char*               data,
+    bsl::size_t               size)
+{
+    bslstl::StringRef text(data, size);
+    bdlb::Tokenizer   tokenizer(text, "\r\n", "");
+
+    while (tokenizer.isValid()) {
+        bslstl::StringRef line = tokenizer.token();
+
+        if (Utility::Impl::parseHostLookupLine(result, line)) {
+            return ntsa::Error();
+        }
+
+        ++tokenizer;
+    }
+
+    Utility::Impl::loadDefaultHostLookupOrder(result);
+    return ntsa::Error();
+}
+
 void Utility::sanitize(ntcdns::ResolverConfig* config)
 {
     if (config->client().isNull()) {
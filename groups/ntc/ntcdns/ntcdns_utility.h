@@ -150,6 +150,29 @@ struct Utility {
         const char*                 data,
         bsl::size_t                 size);
 
+    /// Load into the specified 'result' the sources, in order, consulted
+    /// to resolve host names as defined by the "hosts" entry of
+    /// "/etc/nsswitch.conf", for example "files" and "dns". If the file
+    /// does not exist, or has no "hosts" entry, load the sources consulted
+    /// by the system by default. Return the error.
+    static ntsa::Error loadHostLookupOrder(bsl::vector<bsl::string>* result);
+
+    /// Load into the specified 'result' the sources, in order, consulted
+    /// to resolve host names as defined by the "hosts" entry of the file
+    /// at the specified 'path'. Return the error.
+    static ntsa::Error loadHostLookupOrderFromPath(
+        bsl::vector<bsl::string>* result,
+        const bsl::string&        path);
+
+    /// Load into the specified 'result' the sources, in order, consulted
+    /// to resolve host names as defined by the "hosts" entry of the
+    /// specified 'data' having the specified 'size'. Actions following a
+    /// source, e.g. "[NOTFOUND=return]", are ignored. Return the error.
+    static ntsa::Error loadHostLookupOrderFromText(
+        bsl::vector<bsl::string>* result,
+        const char*               data,
+        bsl::size_t               size);
+
     /// Ensure sensible defaults for the specified 'config'.
     static void sanitize(ntcdns::ResolverConfig* config);
 
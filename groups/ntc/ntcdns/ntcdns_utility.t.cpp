@@ -48,6 +48,17 @@ class UtilityTest
 
     // TODO
     static void verifyCase6();
+
+    // Concern: The 'use-vc' option selects TCP as the primary transport,
+    // and UDP is used by default.
+    static void verifyClientConfigUseVc();
+
+    // Concern: The options to hedge queries are parsed and sanitized.
+    static void verifyClientConfigHedge();
+
+    // Concern: The host lookup order is parsed from the "hosts" entry of a
+    // name service switch configuration, ignoring actions and comments.
+    static void verifyHostLookupOrder();
 };
 
 NTSCFG_TEST_FUNCTION(ntcdns::UtilityTest::verifyCase1)
@@ -517,5 +528,137 @@ NTSCFG_TEST_FUNCTION(ntcdns::UtilityTest::verifyCase6)
     }
 }
 
+NTSCFG_TEST_FUNCTION(ntcdns::UtilityTest::verifyClientConfigUseVc)
+{
+    ntsa::Error error;
+
+    {
+        const char TEXT[] = "nameserver 10.0.0.1\n";
+
+        ntcdns::ClientConfig clientConfig(NTSCFG_TEST_ALLOCATOR);
+        error = ntcdns::Utility::loadClientConfigFromText(&clientConfig,
+                                                          TEXT,
+                                                          sizeof TEXT - 1);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_FALSE(clientConfig.useVc().isNull());
+        NTSCFG_TEST_FALSE(clientConfig.useVc().value());
+    }
+
+    {
+        const char TEXT[] = "nameserver 10.0.0.1\n"
+                            "options rotate use-vc\n";
+
+        ntcdns::ClientConfig clientConfig(NTSCFG_TEST_ALLOCATOR);
+        error = ntcdns::Utility::loadClientConfigFromText(&clientConfig,
+                                                          TEXT,
+                                                          sizeof TEXT - 1);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_FALSE(clientConfig.useVc().isNull());
+        NTSCFG_TEST_TRUE(clientConfig.useVc().value());
+        NTSCFG_TEST_TRUE(clientConfig.rotate().value());
+    }
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::UtilityTest::verifyClientConfigHedge)
+{
+    ntsa::Error error;
+
+    {
+        const char TEXT[] = "nameserver 10.0.0.1\n";
+
+        ntcdns::ClientConfig clientConfig(NTSCFG_TEST_ALLOCATOR);
+        error = ntcdns::Utility::loadClientConfigFromText(&clientConfig,
+                                                          TEXT,
+                                                          sizeof TEXT - 1);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_TRUE(clientConfig.hedgeDelay().isNull());
+        NTSCFG_TEST_TRUE(clientConfig.hedgePercentile().isNull());
+    }
+
+    {
+        const char TEXT[] = "nameserver 10.0.0.1\n"
+                            "nameserver 10.0.0.2\n"
+                            "options hedge-delay:50 hedge-percentile:95\n";
+
+        ntcdns::ClientConfig clientConfig(NTSCFG_TEST_ALLOCATOR);
+        error = ntcdns::Utility::loadClientConfigFromText(&clientConfig,
+                                                          TEXT,
+                                                          sizeof TEXT - 1);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_FALSE(clientConfig.hedgeDelay().isNull());
+        NTSCFG_TEST_EQ(clientConfig.hedgeDelay().value(), 50);
+
+        NTSCFG_TEST_FALSE(clientConfig.hedgePercentile().isNull());
+        NTSCFG_TEST_EQ(clientConfig.hedgePercentile().value(), 95);
+    }
+
+    {
+        const char TEXT[] = "nameserver 10.0.0.1\n"
+                            "options hedge-percentile:100\n";
+
+        ntcdns::ClientConfig clientConfig(NTSCFG_TEST_ALLOCATOR);
+        error = ntcdns::Utility::loadClientConfigFromText(&clientConfig,
+                                                          TEXT,
+                                                          sizeof TEXT - 1);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_TRUE(clientConfig.hedgePercentile().isNull());
+    }
+}
+
+NTSCFG_TEST_FUNCTION(ntcdns::UtilityTest::verifyHostLookupOrder)
+{
+    ntsa::Error error;
+
+    {
+        const char TEXT[] = "# /etc/nsswitch.conf\n"
+                            "passwd:     files sss\n"
+                            "hosts:      files dns myhostname\n"
+                            "services:   files\n";
+
+        bsl::vector<bsl::string> order(NTSCFG_TEST_ALLOCATOR);
+        error = ntcdns::Utility::loadHostLookupOrderFromText(&order,
+                                                             TEXT,
+                                                             sizeof TEXT - 1);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(order.size(), 3);
+        NTSCFG_TEST_EQ(order[0], "files");
+        NTSCFG_TEST_EQ(order[1], "dns");
+        NTSCFG_TEST_EQ(order[2], "myhostname");
+    }
+
+    {
+        const char TEXT[] =
+            "hosts: DNS [!UNAVAIL=return] files # comment\n";
+
+        bsl::vector<bsl::string> order(NTSCFG_TEST_ALLOCATOR);
+        error = ntcdns::Utility::loadHostLookupOrderFromText(&order,
+                                                             TEXT,
+                                                             sizeof TEXT - 1);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_EQ(order.size(), 2);
+        NTSCFG_TEST_EQ(order[0], "dns");
+        NTSCFG_TEST_EQ(order[1], "files");
+    }
+
+    {
+        const char TEXT[] = "passwd: files\n";
+
+        bsl::vector<bsl::string> order(NTSCFG_TEST_ALLOCATOR);
+        error = ntcdns::Utility::loadHostLookupOrderFromText(&order,
+                                                             TEXT,
+                                                             sizeof TEXT - 1);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_FALSE(order.empty());
+    }
+}
+
 }  // close namespace ntcdns
 }  // close namespace BloombergLP
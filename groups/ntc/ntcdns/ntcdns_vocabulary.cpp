@@ -3550,6 +3550,10 @@ ClientConfig::ClientConfig(bslma::Allocator* basicAllocator)
 , d_ndots()
 , d_rotate()
 , d_debug()
+, d_useVc()
+, d_hedgeDelay()
+, d_hedgePercentile()
+, d_idleTimeout()
 {
 }
 
@@ -3564,6 +3568,10 @@ ClientConfig::ClientConfig(const ClientConfig& original,
 , d_ndots(original.d_ndots)
 , d_rotate(original.d_rotate)
 , d_debug(original.d_debug)
+, d_useVc(original.d_useVc)
+, d_hedgeDelay(original.d_hedgeDelay)
+, d_hedgePercentile(original.d_hedgePercentile)
+, d_idleTimeout(original.d_idleTimeout)
 {
 }
 
@@ -3578,7 +3586,11 @@ ClientConfig::ClientConfig(ClientConfig&& original) noexcept
   d_timeout(bsl::move(original.d_timeout)),
   d_ndots(bsl::move(original.d_ndots)),
   d_rotate(bsl::move(original.d_rotate)),
-  d_debug(bsl::move(original.d_debug))
+  d_debug(bsl::move(original.d_debug)),
+  d_useVc(bsl::move(original.d_useVc)),
+  d_hedgeDelay(bsl::move(original.d_hedgeDelay)),
+  d_hedgePercentile(bsl::move(original.d_hedgePercentile)),
+  d_idleTimeout(bsl::move(original.d_idleTimeout))
 {
 }
 
@@ -3593,6 +3605,10 @@ ClientConfig::ClientConfig(ClientConfig&&    original,
 , d_ndots(bsl::move(original.d_ndots))
 , d_rotate(bsl::move(original.d_rotate))
 , d_debug(bsl::move(original.d_debug))
+, d_useVc(bsl::move(original.d_useVc))
+, d_hedgeDelay(bsl::move(original.d_hedgeDelay))
+, d_hedgePercentile(bsl::move(original.d_hedgePercentile))
+, d_idleTimeout(bsl::move(original.d_idleTimeout))
 {
 }
 #endif
@@ -3604,15 +3620,19 @@ ClientConfig::~ClientConfig()
 ClientConfig& ClientConfig::operator=(const ClientConfig& rhs)
 {
     if (this != &rhs) {
-        d_nameServer = rhs.d_nameServer;
-        d_domain     = rhs.d_domain;
-        d_search     = rhs.d_search;
-        d_sortList   = rhs.d_sortList;
-        d_attempts   = rhs.d_attempts;
-        d_timeout    = rhs.d_timeout;
-        d_rotate     = rhs.d_rotate;
-        d_ndots      = rhs.d_ndots;
-        d_debug      = rhs.d_debug;
+        d_nameServer      = rhs.d_nameServer;
+        d_domain          = rhs.d_domain;
+        d_search          = rhs.d_search;
+        d_sortList        = rhs.d_sortList;
+        d_attempts        = rhs.d_attempts;
+        d_timeout         = rhs.d_timeout;
+        d_rotate          = rhs.d_rotate;
+        d_ndots           = rhs.d_ndots;
+        d_debug           = rhs.d_debug;
+        d_useVc           = rhs.d_useVc;
+        d_hedgeDelay      = rhs.d_hedgeDelay;
+        d_hedgePercentile = rhs.d_hedgePercentile;
+        d_idleTimeout     = rhs.d_idleTimeout;
     }
 
     return *this;
@@ -3623,15 +3643,19 @@ ClientConfig& ClientConfig::operator=(const ClientConfig& rhs)
 ClientConfig& ClientConfig::operator=(ClientConfig&& rhs)
 {
     if (this != &rhs) {
-        d_nameServer = bsl::move(rhs.d_nameServer);
-        d_domain     = bsl::move(rhs.d_domain);
-        d_search     = bsl::move(rhs.d_search);
-        d_sortList   = bsl::move(rhs.d_sortList);
-        d_attempts   = bsl::move(rhs.d_attempts);
-        d_timeout    = bsl::move(rhs.d_timeout);
-        d_rotate     = bsl::move(rhs.d_rotate);
-        d_ndots      = bsl::move(rhs.d_ndots);
-        d_debug      = bsl::move(rhs.d_debug);
+        d_nameServer      = bsl::move(rhs.d_nameServer);
+        d_domain          = bsl::move(rhs.d_domain);
+        d_search          = bsl::move(rhs.d_search);
+        d_sortList        = bsl::move(rhs.d_sortList);
+        d_attempts        = bsl::move(rhs.d_attempts);
+        d_timeout         = bsl::move(rhs.d_timeout);
+        d_rotate          = bsl::move(rhs.d_rotate);
+        d_ndots           = bsl::move(rhs.d_ndots);
+        d_debug           = bsl::move(rhs.d_debug);
+        d_useVc           = bsl::move(rhs.d_useVc);
+        d_hedgeDelay      = bsl::move(rhs.d_hedgeDelay);
+        d_hedgePercentile = bsl::move(rhs.d_hedgePercentile);
+        d_idleTimeout     = bsl::move(rhs.d_idleTimeout);
     }
 
     return *this;
@@ -3649,6 +3673,10 @@ void ClientConfig::reset()
     bdlat_ValueTypeFunctions::reset(&d_rotate);
     bdlat_ValueTypeFunctions::reset(&d_ndots);
     bdlat_ValueTypeFunctions::reset(&d_debug);
+    bdlat_ValueTypeFunctions::reset(&d_useVc);
+    bdlat_ValueTypeFunctions::reset(&d_hedgeDelay);
+    bdlat_ValueTypeFunctions::reset(&d_hedgePercentile);
+    bdlat_ValueTypeFunctions::reset(&d_idleTimeout);
 }
 
 bsl::ostream& ClientConfig::print(bsl::ostream& stream,
@@ -3666,6 +3694,10 @@ bsl::ostream& ClientConfig::print(bsl::ostream& stream,
     printer.printAttribute("rotate", this->rotate());
     printer.printAttribute("ndots", this->ndots());
     printer.printAttribute("debug", this->debug());
+    printer.printAttribute("useVc", this->useVc());
+    printer.printAttribute("hedgeDelay", this->hedgeDelay());
+    printer.printAttribute("hedgePercentile", this->hedgePercentile());
+    printer.printAttribute("idleTimeout", this->idleTimeout());
     printer.end();
     return stream;
 }
@@ -3943,6 +3943,28 @@ class ClientConfig
     // unspecified, the default value is false.
     bdlb::NullableValue<bool> d_debug;
 
+    // Flag indicating that queries should be sent to each name server over
+    // a persistent TCP connection rather than as UDP datagrams.  If
+    // unspecified, the default value is false.
+    bdlb::NullableValue<bool> d_useVc;
+
+    // The delay, in milliseconds, after which a query that has not yet been
+    // answered is also sent to the next name server, with the first answer
+    // received from either taken as the result.  If unspecified, or zero,
+    // queries are not hedged.
+    bdlb::NullableValue<unsigned int> d_hedgeDelay;
+
+    // The percentile, from 1 to 99, of the latencies observed from each name
+    // server after which a query sent to that name server is hedged to the
+    // next name server.  If unspecified, or if too few latencies have yet
+    // been observed, the hedge delay is used.
+    bdlb::NullableValue<unsigned int> d_hedgePercentile;
+
+    // The duration, in milliseconds, after which a TCP connection to a name
+    // server on which no queries are outstanding is closed.  If
+    // unspecified, the default value is 10 seconds.
+    bdlb::NullableValue<unsigned int> d_idleTimeout;
+
   public:
   public:
     /// Create an object of type 'ClientConfig' having the default value.
@@ -4028,6 +4050,22 @@ class ClientConfig
     /// object.
     bdlb::NullableValue<bool>& debug();
 
+    /// Return a reference to the modifiable "UseVc" attribute of this
+    /// object.
+    bdlb::NullableValue<bool>& useVc();
+
+    /// Return a reference to the modifiable "HedgeDelay" attribute of this
+    /// object.
+    bdlb::NullableValue<unsigned int>& hedgeDelay();
+
+    /// Return a reference to the modifiable "HedgePercentile" attribute of
+    /// this object.
+    bdlb::NullableValue<unsigned int>& hedgePercentile();
+
+    /// Return a reference to the modifiable "IdleTimeout" attribute of this
+    /// object.
+    bdlb::NullableValue<unsigned int>& idleTimeout();
+
     /// Format this object to the specified output 'stream' at the
     /// optionally specified indentation 'level' and return a reference to
     /// the modifiable 'stream'.  If 'level' is specified, optionally
@@ -4078,6 +4116,22 @@ class ClientConfig
     /// Return a reference offering non-modifiable access to the "Debug"
     /// attribute of this object.
     const bdlb::NullableValue<bool>& debug() const;
+
+    /// Return a reference offering non-modifiable access to the "UseVc"
+    /// attribute of this object.
+    const bdlb::NullableValue<bool>& useVc() const;
+
+    /// Return a reference offering non-modifiable access to the
+    /// "HedgeDelay" attribute of this object.
+    const bdlb::NullableValue<unsigned int>& hedgeDelay() const;
+
+    /// Return a reference offering non-modifiable access to the
+    /// "HedgePercentile" attribute of this object.
+    const bdlb::NullableValue<unsigned int>& hedgePercentile() const;
+
+    /// Return a reference offering non-modifiable access to the
+    /// "IdleTimeout" attribute of this object.
+    const bdlb::NullableValue<unsigned int>& idleTimeout() const;
 };
 
 // FREE OPERATORS
@@ -6061,6 +6115,26 @@ inline bdlb::NullableValue<bool>& ClientConfig::debug()
     return d_debug;
 }
 
+inline bdlb::NullableValue<bool>& ClientConfig::useVc()
+{
+    return d_useVc;
+}
+
+inline bdlb::NullableValue<unsigned int>& ClientConfig::hedgeDelay()
+{
+    return d_hedgeDelay;
+}
+
+inline bdlb::NullableValue<unsigned int>& ClientConfig::hedgePercentile()
+{
+    return d_hedgePercentile;
+}
+
+inline bdlb::NullableValue<unsigned int>& ClientConfig::idleTimeout()
+{
+    return d_idleTimeout;
+}
+
 inline const bsl::vector<NameServerConfig>& ClientConfig::nameServer() const
 {
     return d_nameServer;
@@ -6106,6 +6180,29 @@ inline const bdlb::NullableValue<bool>& ClientConfig::debug() const
     return d_debug;
 }
 
+inline const bdlb::NullableValue<bool>& ClientConfig::useVc() const
+{
+    return d_useVc;
+}
+
+inline const bdlb::NullableValue<unsigned int>& ClientConfig::hedgeDelay()
+    const
+{
+    return d_hedgeDelay;
+}
+
+inline const bdlb::NullableValue<unsigned int>& ClientConfig::
+    hedgePercentile() const
+{
+    return d_hedgePercentile;
+}
+
+inline const bdlb::NullableValue<unsigned int>& ClientConfig::idleTimeout()
+    const
+{
+    return d_idleTimeout;
+}
+
 template <typename HASH_ALGORITHM>
 void hashAppend(HASH_ALGORITHM& hashAlg, const ntcdns::ClientConfig& object)
 {
@@ -6121,6 +6218,10 @@ void hashAppend(HASH_ALGORITHM& hashAlg, const ntcdns::ClientConfig& object)
     hashAppend(hashAlg, object.rotate());
     hashAppend(hashAlg, object.ndots());
     hashAppend(hashAlg, object.debug());
+    hashAppend(hashAlg, object.useVc());
+    hashAppend(hashAlg, object.hedgeDelay());
+    hashAppend(hashAlg, object.hedgePercentile());
+    hashAppend(hashAlg, object.idleTimeout());
 }
 
 inline HostDatabaseConfigSpec::HostDatabaseConfigSpec(
@@ -6934,7 +7035,11 @@ inline bool ntcdns::operator==(const ntcdns::ClientConfig& lhs,
            lhs.sortList() == rhs.sortList() &&
            lhs.attempts() == rhs.attempts() &&
            lhs.timeout() == rhs.timeout() && lhs.rotate() == rhs.rotate() &&
-           lhs.ndots() == rhs.ndots() && lhs.debug() == rhs.debug();
+           lhs.ndots() == rhs.ndots() && lhs.debug() == rhs.debug() &&
+           lhs.useVc() == rhs.useVc() &&
+           lhs.hedgeDelay() == rhs.hedgeDelay() &&
+           lhs.hedgePercentile() == rhs.hedgePercentile() &&
+           lhs.idleTimeout() == rhs.idleTimeout();
 }
 
 inline bool ntcdns::operator!=(const ntcdns::ClientConfig& lhs,
@@ -28,6 +28,7 @@ BSLS_IDENT_RCSID(ntcf_system_cpp, "$Id$ $CSID$")
 #include <ntcs_datapool.h>
 #include <ntcs_global.h>
 #include <ntcs_interactable.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_metrics.h>
 #include <ntcs_monitorable.h>
 #include <ntcs_plugin.h>
@@ -36,6 +37,7 @@ BSLS_IDENT_RCSID(ntcf_system_cpp, "$Id$ $CSID$")
 #include <ntcs_ratelimiter.h>
 #include <ntcs_reactormetrics.h>
 #include <ntcs_reservation.h>
+#include <ntcs_tracer.h>
 
 #include <ntcr_datagramsocket.h>
 #include <ntcr_interface.h>
@@ -731,6 +733,11 @@ bsl::shared_ptr<ntci::Driver> System::createDriver(
                     configuration.maxCyclesPerWait().value());
             }
 
+            if (!configuration.stallThreshold().isNull()) {
+                reactorConfig.setStallThreshold(
+                    configuration.stallThreshold().value());
+            }
+
             if (reactorConfig.maxThreads() > 1) {
                 reactorConfig.setOneShot(true);
             }
@@ -786,6 +793,11 @@ bsl::shared_ptr<ntci::Driver> System::createDriver(
                     configuration.maxCyclesPerWait().value());
             }
 
+            if (!configuration.stallThreshold().isNull()) {
+                proactorConfig.setStallThreshold(
+                    configuration.stallThreshold().value());
+            }
+
             return proactorFactory->createProactor(
                 proactorConfig,
                 bsl::shared_ptr<ntci::User>(),
@@ -2847,6 +2859,56 @@ void System::disableProcessMetrics()
     ntcs::MonitorableUtil::deregisterMonitorableProcess();
 }
 
+void System::enableLoopTracing()
+{
+    ntcs::LoopProfiler::setTracing(true);
+}
+
+void System::disableLoopTracing()
+{
+    ntcs::LoopProfiler::setTracing(false);
+}
+
+void System::enableTracing()
+{
+    ntcs::Tracer::enable();
+}
+
+void System::disableTracing()
+{
+    ntcs::Tracer::disable();
+}
+
+void System::clearTrace()
+{
+    ntcs::Tracer::clear();
+}
+
+void System::exportTrace(bsl::ostream& stream)
+{
+    bsl::vector<ntcs::TraceRecord> records;
+    ntcs::Tracer::load(&records);
+
+    ntcs::Tracer::exportChromeTrace(stream, records);
+}
+
+ntsa::Error System::exportTrace(const bsl::string& path)
+{
+    bsl::ofstream stream(path.c_str());
+    if (!stream) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    ntcf::System::exportTrace(stream);
+
+    stream.flush();
+    if (!stream) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    return ntsa::Error();
+}
+
 void System::registerMonitorable(
     const bsl::shared_ptr<ntci::Monitorable>& monitorable)
 {
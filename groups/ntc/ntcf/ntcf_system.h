@@ -23,6 +23,7 @@ BSLS_IDENT("$Id: $")
 #include <ntcf_api.h>
 #include <ntcscm_version.h>
 #include <bdlbb_blob.h>
+#include <bsl_iosfwd.h>
 #include <bsl_memory.h>
 
 namespace BloombergLP {
@@ -1245,6 +1246,37 @@ struct System {
     /// Disable the periodic collection of process-wide metrics.
     static void disableProcessMetrics();
 
+    /// Enable the tracing of the phases of each iteration of the event loop
+    /// of each waiter of each driver that collects metrics. The most recent
+    /// iterations are retained in a bounded ring buffer per waiter.
+    static void enableLoopTracing();
+
+    /// Disable the tracing of the phases of each iteration of the event loop
+    /// of each waiter.
+    static void disableLoopTracing();
+
+    /// Enable the recording of socket, timer, strand, and deferred function
+    /// events into a bounded ring buffer per thread.
+    static void enableTracing();
+
+    /// Disable the recording of socket, timer, strand, and deferred
+    /// function events. Events already recorded are retained.
+    static void disableTracing();
+
+    /// Discard all recorded socket, timer, strand, and deferred function
+    /// events.
+    static void clearTrace();
+
+    /// Write a snapshot of the events recorded by all threads to the
+    /// specified 'stream' in the Chrome trace event format, which may be
+    /// viewed in Perfetto or 'chrome://tracing'.
+    static void exportTrace(bsl::ostream& stream);
+
+    /// Write a snapshot of the events recorded by all threads to the file
+    /// at the specified 'path' in the Chrome trace event format. Return the
+    /// error.
+    static ntsa::Error exportTrace(const bsl::string& path);
+
     /// Add the specified 'monitorable' to the default monitorable object
     /// registry, if a default monitorable object registry has been enabled.
     static void registerMonitorable(
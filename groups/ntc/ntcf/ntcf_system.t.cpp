@@ -24,14 +24,21 @@ BSLS_IDENT_RCSID(ntcf_system_t_cpp, "$Id$ $CSID$")
 #include <ntccfg_config.h>
 #include <ntccfg_platform.h>
 #include <ntcd_datautil.h>
+#include <ntcdns_client.h>
+#include <ntcdns_database.h>
+#include <ntcdns_server.h>
+#include <ntcdns_vocabulary.h>
 #include <ntci_concurrent.h>
 #include <ntci_log.h>
 #include <ntcs_blobutil.h>
 #include <ntcs_datapool.h>
+#include <ntcs_metrics.h>
+#include <ntcs_openmetrics.h>
 #include <ntcs_ratelimiter.h>
 #include <ntcscm_version.h>
 #include <ntcu_datagramsocketeventqueue.h>
 #include <ntcu_listenersocketeventqueue.h>
+#include <ntcu_openmetricsendpoint.h>
 #include <ntcu_streamsocketeventqueue.h>
 #include <ntsa_adapter.h>
 #include <ntsa_endpoint.h>
@@ -46,6 +53,7 @@ BSLS_IDENT_RCSID(ntcf_system_t_cpp, "$Id$ $CSID$")
 #include <ntsi_datagramsocket.h>
 #include <ntsi_streamsocket.h>
 #include <ntsu_adapterutil.h>
+#include <bdld_manageddatum.h>
 #include <bdlt_iso8601util.h>
 
 using namespace BloombergLP;
@@ -156,6 +164,10 @@ class SystemTest
     /// test driver.
     class ResolverUtil;
 
+    /// Provide utilities for issuing HTTP requests to an OpenMetrics
+    /// endpoint in this test driver.
+    class OpenMetricsUtil;
+
     /// Provide callbacks used in examples.
     class ExampleUtil;
 
@@ -274,6 +286,14 @@ class SystemTest
         const bsl::shared_ptr<ntci::Scheduler>& scheduler,
         bslma::Allocator*                       allocator);
 
+    static void concernConnectNameHappyEyeballs(
+        const bsl::shared_ptr<ntci::Scheduler>& scheduler,
+        bslma::Allocator*                       allocator);
+
+    static void concernConnectNameHappyEyeballsStalled(
+        const bsl::shared_ptr<ntci::Scheduler>& scheduler,
+        bslma::Allocator*                       allocator);
+
     static void concernConnectLimitActive(bslma::Allocator* allocator);
     static void concernConnectLimitPassive(bslma::Allocator* allocator);
 
@@ -419,6 +439,12 @@ class SystemTest
 
     static void verifyResolverGetIpAddressSystem();
     static void verifyResolverGetIpAddressClient();
+    static void verifyResolverGetIpAddressClientHedged();
+    static void verifyResolverClientTruncatedRetry();
+    static void verifyResolverClientStreamFragmented();
+    static void verifyResolverClientStreamPipelined();
+    static void verifyResolverClientStreamIdle();
+    static void verifyResolverClientStreamFailover();
     static void verifyResolverGetIpAddressOverride();
     static void verifyResolverGetDomainNameSystem();
     static void verifyResolverGetDomainNameClient();
@@ -433,6 +459,9 @@ class SystemTest
     static void verifyResolverGetEndpointClient();
     static void verifyResolverGetEndpointOverride();
 
+    static void verifyOpenMetricsEndpoint();
+    static void verifyOpenMetricsEndpointTimeout();
+
     static void verifyDataExchange();
 
     static void verifyClose();
@@ -461,6 +490,17 @@ class SystemTest
     static void verifyConnectName7();
     static void verifyConnectName8();
 
+    // Concern: Connecting to a name according to the "Happy Eyeballs"
+    // strategy falls back from addresses that fail to connect, and reports
+    // the address family of the endpoint to which the socket connected.
+    static void verifyConnectNameHappyEyeballs();
+
+    // Concern: Connecting to a name according to the "Happy Eyeballs"
+    // strategy does not abandon an attempt that is slow to complete when
+    // the connection attempt delay elapses, but races the next endpoint
+    // against it.
+    static void verifyConnectNameHappyEyeballsStalled();
+
     static void verifyConnectLimitActive();
     static void verifyConnectLimitPassive();
 
@@ -1876,6 +1916,19 @@ class SystemTest::ResolverUtil
         const ntca::GetIpAddressEvent&         event,
         bslmt::Semaphore*                      semaphore);
 
+    /// Process the resolution of a domain name to the specified
+    /// 'ipAddressList' by the specified 'resolver' according to the
+    /// specified 'event'. Load the 'ipAddressList' into the specified
+    /// 'resultIpAddressList' and the 'event' into the specified
+    /// 'resultEvent', then post to the specified 'semaphore'.
+    static void processGetIpAddressResultCapture(
+        const bsl::shared_ptr<ntci::Resolver>& resolver,
+        const bsl::vector<ntsa::IpAddress>&    ipAddressList,
+        const ntca::GetIpAddressEvent&         event,
+        bsl::vector<ntsa::IpAddress>*          resultIpAddressList,
+        ntca::GetIpAddressEvent*               resultEvent,
+        bslmt::Semaphore*                      semaphore);
+
     /// Process the resolution of an IP address to the specified
     /// 'domainName' by the specified 'resolver' according to the specified
     /// 'event'. Post to the specified 'semaphore'.
@@ -1935,6 +1988,53 @@ class SystemTest::ResolverUtil
     /// service name.
     static void filterPortList(bsl::vector<ntsa::Port>* portList,
                                bslmt::Semaphore*        semaphore);
+
+    /// Load into the specified 'result' a new, started name server that
+    /// answers queries over both UDP and TCP from the specified
+    /// 'hostDatabase' using sockets created by the specified 'interface'.
+    static void createServer(
+        bsl::shared_ptr<ntcdns::Server>*             result,
+        const bsl::shared_ptr<ntci::Interface>&      interface,
+        const bsl::shared_ptr<ntcdns::HostDatabase>& hostDatabase);
+
+    /// Load into the specified 'result' a new, started DNS client that
+    /// sends queries to the specified 'nameServerList', in order, using
+    /// sockets created by the specified 'interface'. Close each idle TCP
+    /// connection after the specified 'idleTimeout', in milliseconds, if
+    /// not null.
+    static void createClient(
+        bsl::shared_ptr<ntcdns::Client>*        result,
+        const bsl::shared_ptr<ntci::Interface>& interface,
+        const bsl::vector<ntsa::Endpoint>&      nameServerList,
+        const bdlb::NullableValue<unsigned int>& idleTimeout);
+
+    /// Resolve the specified IPv4 'domainName' using the specified
+    /// 'client'. Load the resulting IP addresses into the specified
+    /// 'resultIpAddressList' and the resulting event into the specified
+    /// 'resultEvent', then post to the specified 'semaphore'.
+    static void getIpAddress(
+        const bsl::shared_ptr<ntcdns::Client>& client,
+        const bsl::string&                     domainName,
+        bsl::vector<ntsa::IpAddress>*          resultIpAddressList,
+        ntca::GetIpAddressEvent*               resultEvent,
+        bslmt::Semaphore*                      semaphore);
+};
+
+/// Provide utilities for issuing HTTP requests to an OpenMetrics endpoint
+/// in this test driver.
+class SystemTest::OpenMetricsUtil
+{
+  public:
+    /// Connect a blocking socket to the specified 'endpoint', send the
+    /// specified 'request', if not empty, then load into the specified
+    /// 'response' everything received until the peer shuts down the
+    /// connection. Optionally specify a 'basicAllocator' used to supply
+    /// memory. If 'basicAllocator' is 0, the currently installed default
+    /// allocator is used.
+    static void request(bsl::string*          response,
+                        const ntsa::Endpoint& endpoint,
+                        const bsl::string&    request,
+                        bslma::Allocator*     basicAllocator = 0);
 };
 
 /// Provide callbacks used in examples.
@@ -5525,6 +5625,27 @@ void SystemTest::ResolverUtil::processGetIpAddressResult(
     semaphore->post();
 }
 
+void SystemTest::ResolverUtil::processGetIpAddressResultCapture(
+    const bsl::shared_ptr<ntci::Resolver>& resolver,
+    const bsl::vector<ntsa::IpAddress>&    ipAddressList,
+    const ntca::GetIpAddressEvent&         event,
+    bsl::vector<ntsa::IpAddress>*          resultIpAddressList,
+    ntca::GetIpAddressEvent*               resultEvent,
+    bslmt::Semaphore*                      semaphore)
+{
+    NTCCFG_WARNING_UNUSED(resolver);
+
+    NTCI_LOG_CONTEXT();
+
+    NTCI_LOG_STREAM_DEBUG << "Processing get IP address event " << event
+                          << NTCI_LOG_STREAM_END;
+
+    *resultIpAddressList = ipAddressList;
+    *resultEvent         = event;
+
+    semaphore->post();
+}
+
 void SystemTest::ResolverUtil::processGetDomainNameResult(
     const bsl::shared_ptr<ntci::Resolver>& resolver,
     const bsl::string&                     domainName,
@@ -5693,6 +5814,144 @@ void SystemTest::ResolverUtil::filterPortList(
     semaphore->post();
 }
 
+void SystemTest::ResolverUtil::createServer(
+    bsl::shared_ptr<ntcdns::Server>*             result,
+    const bsl::shared_ptr<ntci::Interface>&      interface,
+    const bsl::shared_ptr<ntcdns::HostDatabase>& hostDatabase)
+{
+    ntsa::Error error;
+
+    ntcdns::ServerConfig serverConfig;
+    serverConfig.nameServer().address().host() = "127.0.0.1";
+    serverConfig.nameServer().address().port() = 0;
+
+    result->createInplace(NTSCFG_TEST_ALLOCATOR,
+                          serverConfig,
+                          interface,
+                          interface,
+                          NTSCFG_TEST_ALLOCATOR);
+
+    (*result)->setHostDatabase(hostDatabase);
+
+    error = (*result)->start();
+    NTSCFG_TEST_OK(error);
+}
+
+void SystemTest::ResolverUtil::createClient(
+    bsl::shared_ptr<ntcdns::Client>*         result,
+    const bsl::shared_ptr<ntci::Interface>&  interface,
+    const bsl::vector<ntsa::Endpoint>&       nameServerList,
+    const bdlb::NullableValue<unsigned int>& idleTimeout)
+{
+    ntsa::Error error;
+
+    ntcdns::ClientConfig clientConfig;
+
+    for (bsl::size_t i = 0; i < nameServerList.size(); ++i) {
+        ntcdns::NameServerConfig nameServerConfig;
+        nameServerConfig.address().host() =
+            nameServerList[i].ip().host().text();
+        nameServerConfig.address().port() = nameServerList[i].ip().port();
+
+        clientConfig.nameServer().push_back(nameServerConfig);
+    }
+
+    clientConfig.domain()      = "example.test";
+    clientConfig.idleTimeout() = idleTimeout;
+
+    result->createInplace(NTSCFG_TEST_ALLOCATOR,
+                          clientConfig,
+                          bsl::shared_ptr<ntcdns::Cache>(),
+                          interface,
+                          interface,
+                          NTSCFG_TEST_ALLOCATOR);
+
+    error = (*result)->start();
+    NTSCFG_TEST_OK(error);
+}
+
+void SystemTest::ResolverUtil::getIpAddress(
+    const bsl::shared_ptr<ntcdns::Client>& client,
+    const bsl::string&                     domainName,
+    bsl::vector<ntsa::IpAddress>*          resultIpAddressList,
+    ntca::GetIpAddressEvent*               resultEvent,
+    bslmt::Semaphore*                      semaphore)
+{
+    ntsa::Error error;
+
+    ntci::GetIpAddressCallback callback(
+        bdlf::BindUtil::bind(
+            &test::ResolverUtil::processGetIpAddressResultCapture,
+            bdlf::PlaceHolders::_1,
+            bdlf::PlaceHolders::_2,
+            bdlf::PlaceHolders::_3,
+            resultIpAddressList,
+            resultEvent,
+            semaphore),
+        NTSCFG_TEST_ALLOCATOR);
+
+    ntca::GetIpAddressOptions options;
+    options.setIpAddressType(ntsa::IpAddressType::e_V4);
+
+    error = client->getIpAddress(bsl::shared_ptr<ntci::Resolver>(),
+                                 domainName,
+                                 options,
+                                 callback);
+    NTSCFG_TEST_OK(error);
+}
+
+void SystemTest::OpenMetricsUtil::request(bsl::string*          response,
+                                          const ntsa::Endpoint& endpoint,
+                                          const bsl::string&    request,
+                                          bslma::Allocator*     basicAllocator)
+{
+    ntsa::Error error;
+
+    response->clear();
+
+    bsl::shared_ptr<ntsi::StreamSocket> streamSocket =
+        ntsf::System::createStreamSocket(basicAllocator);
+
+    error =
+        streamSocket->open(endpoint.transport(ntsa::TransportMode::e_STREAM));
+    NTSCFG_TEST_OK(error);
+
+    error = streamSocket->connect(endpoint);
+    NTSCFG_TEST_OK(error);
+
+    if (!request.empty()) {
+        ntsa::SendContext sendContext;
+        error = streamSocket->send(&sendContext,
+                                   request.data(),
+                                   request.size(),
+                                   ntsa::SendOptions());
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_EQ(sendContext.bytesSent(), request.size());
+    }
+
+    while (true) {
+        char buffer[4096];
+
+        ntsa::ReceiveContext receiveContext;
+        error = streamSocket->receive(&receiveContext,
+                                      buffer,
+                                      sizeof buffer,
+                                      ntsa::ReceiveOptions());
+        if (error) {
+            NTSCFG_TEST_EQ(error, ntsa::Error(ntsa::Error::e_EOF));
+            break;
+        }
+
+        if (receiveContext.bytesReceived() == 0) {
+            break;
+        }
+
+        response->append(buffer, receiveContext.bytesReceived());
+    }
+
+    streamSocket->close();
+}
+
 void SystemTest::ExampleUtil::processConnect(
     const bsl::shared_ptr<ntci::Connector>& connector,
     const ntca::ConnectEvent&               event,
@@ -9594,42 +9853,29 @@ void SystemTest::concernConnectName8(
     }
 }
 
-void SystemTest::concernConnectLimitActive(bslma::Allocator* allocator)
+void SystemTest::concernConnectNameHappyEyeballs(
+    const bsl::shared_ptr<ntci::Scheduler>& scheduler,
+    bslma::Allocator*                       allocator)
 {
-    // Concern: Connection limit reached on active side.
-    // Plan:
-
-    ntsa::Error error;
-
-    // Create an scheduler that only allows one connection at a time.
-
-    ntca::SchedulerConfig schedulerConfig;
-    schedulerConfig.setThreadName("test");
-    schedulerConfig.setMinThreads(2);
-    schedulerConfig.setMaxThreads(2);
-    schedulerConfig.setMaxConnections(1);
+    // Concern: Connect to name according to the "Happy Eyeballs" strategy
+    // Testing: IPv6 refused or unavailable, IPv4 connection established
 
-    bsl::shared_ptr<ntci::Scheduler> scheduler =
-        ntcf::System::createScheduler(schedulerConfig, allocator);
+    NTCI_LOG_CONTEXT();
 
-    error = scheduler->start();
-    NTSCFG_TEST_OK(error);
+    BSLS_LOG_DEBUG("Happy Eyeballs, connection up");
 
-    // Create two stream sockets.
+    ntsa::Error error;
 
-    ntca::StreamSocketOptions streamSocketOptionsA;
-    streamSocketOptionsA.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+    // Create the stream socket.
 
-    bsl::shared_ptr<ntci::StreamSocket> streamSocketA =
-        scheduler->createStreamSocket(streamSocketOptionsA, allocator);
+    ntca::StreamSocketOptions streamSocketOptions;
 
-    ntca::StreamSocketOptions streamSocketOptionsB;
-    streamSocketOptionsB.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+    bsl::shared_ptr<ntci::StreamSocket> streamSocket =
+        scheduler->createStreamSocket(streamSocketOptions, allocator);
 
-    bsl::shared_ptr<ntci::StreamSocket> streamSocketB =
-        scheduler->createStreamSocket(streamSocketOptionsB, allocator);
+    ntci::StreamSocketCloseGuard closeGuard(streamSocket);
 
-    // Create the listener socket.
+    // Create a listener socket listening only on the IPv4 loopback address.
 
     bsl::shared_ptr<ntsi::ListenerSocket> listenerSocket =
         ntsf::System::createListenerSocket(allocator);
@@ -9637,129 +9883,387 @@ void SystemTest::concernConnectLimitActive(bslma::Allocator* allocator)
     error = listenerSocket->open(ntsa::Transport::e_TCP_IPV4_STREAM);
     NTSCFG_TEST_OK(error);
 
-    // Bind the listener socket.
-
     error =
         listenerSocket->bind(ntsa::Endpoint(ntsa::Ipv4Address::loopback(), 0),
                              true);
     NTSCFG_TEST_OK(error);
 
-    ntsa::Endpoint endpoint;
-    error = listenerSocket->sourceEndpoint(&endpoint);
-    NTSCFG_TEST_OK(error);
-
-    // Begin listening.
-
     error = listenerSocket->listen(100);
     NTSCFG_TEST_OK(error);
 
-    // Connect stream socket A to the listener socket and ensure the
-    // connection completes successfully.
-
-    ntca::ConnectOptions connectOptionsA;
-    connectOptionsA.setRetryCount(100);
-    connectOptionsA.setRetryInterval(bsls::TimeInterval(1));
-
-    ntci::ConnectFuture connectFutureA(allocator);
-    error = streamSocketA->connect(endpoint, connectOptionsA, connectFutureA);
-    NTSCFG_TEST_OK(error);
-
-    ntci::ConnectResult connectResultA;
-    error = connectFutureA.wait(&connectResultA);
+    ntsa::Endpoint endpoint;
+    error = listenerSocket->sourceEndpoint(&endpoint);
     NTSCFG_TEST_OK(error);
 
-    NTSCFG_TEST_EQ(connectResultA.event().type(),
-                   ntca::ConnectEventType::e_COMPLETE);
+    // Connect the stream socket to the listener socket by a name that may
+    // resolve to both the IPv6 and IPv4 loopback addresses. Any attempt to
+    // connect to the IPv6 loopback address fails, so the stream socket must
+    // fall back to the IPv4 loopback address.
 
-    // Connect stream socket B to the listener socket, and ensure that
-    // the first several connection attempts fail because the connection
-    // limit has already been reached.
+    ntca::ConnectOptions connectOptions;
+    connectOptions.setStrategy(
+        ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS);
+    connectOptions.setDeadline(streamSocket->currentTime() +
+                               bsls::TimeInterval(10));
 
-    ntca::ConnectOptions connectOptionsB;
-    connectOptionsB.setRetryCount(100);
-    connectOptionsB.setRetryInterval(bsls::TimeInterval(1));
+    const bsl::string connectName =
+        "localhost:" + bsl::to_string(endpoint.ip().port());
 
-    ntci::ConnectFuture connectFutureB(allocator);
-    error = streamSocketB->connect(endpoint, connectOptionsB, connectFutureB);
+    ntci::ConnectFuture connectFuture(allocator);
+    error = streamSocket->connect(connectName, connectOptions, connectFuture);
     NTSCFG_TEST_OK(error);
 
-    for (bsl::size_t i = 0; i < 4; ++i) {
-        ntci::ConnectResult connectResultB;
-        error = connectFutureB.wait(&connectResultB);
+    while (true) {
+        ntci::ConnectResult connectResult;
+        error = connectFuture.wait(&connectResult);
         NTSCFG_TEST_OK(error);
 
         NTSCFG_TEST_LOG_INFO << "Processing connect event "
-                             << connectResultB.event() << NTSCFG_TEST_LOG_END;
+                             << connectResult.event() << NTSCFG_TEST_LOG_END;
 
-        NTSCFG_TEST_EQ(connectResultB.event().type(),
-                       ntca::ConnectEventType::e_ERROR);
+        if (connectResult.event().type() == ntca::ConnectEventType::e_ERROR) {
+            NTSCFG_TEST_FALSE(
+                connectResult.event().context().endpoint().isUndefined());
+            NTSCFG_TEST_TRUE(
+                connectResult.event().context().endpoint().ip().host().isV6());
+            NTSCFG_TEST_GT(
+                connectResult.event().context().attemptsRemaining(),
+                0);
+            continue;
+        }
 
-        NTSCFG_TEST_EQ(connectResultB.event().context().error(),
-                       ntsa::Error(ntsa::Error::e_LIMIT));
-    }
+        NTSCFG_TEST_EQ(connectResult.event().type(),
+                       ntca::ConnectEventType::e_COMPLETE);
 
-    // Close the first stream socket.
+        NTSCFG_TEST_OK(connectResult.event().context().error());
 
-    {
-        ntci::StreamSocketCloseGuard guard(streamSocketA);
+        NTSCFG_TEST_EQ(connectResult.event().context().name(), connectName);
+        NTSCFG_TEST_EQ(connectResult.event().context().endpoint(), endpoint);
+
+        NTSCFG_TEST_FALSE(
+            connectResult.event().context().ipAddressType().isNull());
+        NTSCFG_TEST_EQ(
+            connectResult.event().context().ipAddressType().value(),
+            ntsa::IpAddressType::e_V4);
+
+        break;
     }
+}
 
-    // Now that the first stream socket is closed, the second stream socket
-    // should eventually connect.
+void SystemTest::concernConnectNameHappyEyeballsStalled(
+    const bsl::shared_ptr<ntci::Scheduler>& scheduler,
+    bslma::Allocator*                       allocator)
+{
+    // Concern: Connect to name according to the "Happy Eyeballs" strategy
+    // Testing: IPv6 stalled beyond the connection attempt delay, IPv4
+    // refused, IPv6 connection established
 
-    while (true) {
-        ntci::ConnectResult connectResultB;
-        error = connectFutureB.wait(&connectResultB);
-        NTSCFG_TEST_OK(error);
+    NTCI_LOG_CONTEXT();
 
-        NTSCFG_TEST_LOG_INFO << "Processing connect event "
-                             << connectResultB.event() << NTSCFG_TEST_LOG_END;
+    BSLS_LOG_DEBUG("Happy Eyeballs, first attempt stalled");
 
-        if (connectResultB.event().type() == ntca::ConnectEventType::e_ERROR) {
-            NTSCFG_TEST_EQ(connectResultB.event().context().error(),
-                           ntsa::Error(ntsa::Error::e_LIMIT));
-        }
-        else {
-            NTSCFG_TEST_EQ(connectResultB.event().type(),
-                           ntca::ConnectEventType::e_COMPLETE);
-            break;
-        }
-    }
+#if defined(BSLS_PLATFORM_OS_LINUX)
 
-    // Close the second stream socket.
+    // This test relies on Linux silently dropping connection requests to a
+    // listener whose backlog is full, which leaves the connection attempt
+    // in progress until the request is retransmitted, about one second
+    // later.
 
-    {
-        ntci::StreamSocketCloseGuard guard(streamSocketB);
+    if (!ntsu::AdapterUtil::supportsIpv6Loopback()) {
+        return;
     }
 
-    // Stop the scheduler.
+    ntsa::Error error;
 
-    scheduler->shutdown();
-    scheduler->linger();
-}
+    // Create the stream socket.
 
-void SystemTest::concernConnectLimitPassive(bslma::Allocator* allocator)
-{
-    // Concern: Connection limit reached on passive side.
-    // Plan:
+    ntca::StreamSocketOptions streamSocketOptions;
 
-    ntsa::Error error;
+    bsl::shared_ptr<ntci::StreamSocket> streamSocket =
+        scheduler->createStreamSocket(streamSocketOptions, allocator);
 
-    // Create an scheduler that only allows one connection at a time.
+    ntci::StreamSocketCloseGuard closeGuard(streamSocket);
 
-    ntca::SchedulerConfig schedulerConfig;
-    schedulerConfig.setThreadName("test");
-    schedulerConfig.setMinThreads(2);
-    schedulerConfig.setMaxThreads(2);
-    schedulerConfig.setMaxConnections(1);
+    // Create a listener socket listening only on the IPv6 loopback address
+    // with the smallest possible backlog.
 
-    bsl::shared_ptr<ntci::Scheduler> scheduler =
-        ntcf::System::createScheduler(schedulerConfig, allocator);
+    bsl::shared_ptr<ntsi::ListenerSocket> listenerSocket =
+        ntsf::System::createListenerSocket(allocator);
 
-    error = scheduler->start();
+    error = listenerSocket->open(ntsa::Transport::e_TCP_IPV6_STREAM);
     NTSCFG_TEST_OK(error);
 
-    bsl::shared_ptr<ntcu::ListenerSocketEventQueue> listenerSocketEventQueue;
+    error = listenerSocket->bind(
+        ntsa::Endpoint(
+            ntsa::IpEndpoint(ntsa::Ipv6Address::loopback(), 0)),
+        false);
+    NTSCFG_TEST_OK(error);
+
+    error = listenerSocket->listen(0);
+    NTSCFG_TEST_OK(error);
+
+    ntsa::Endpoint endpoint;
+    error = listenerSocket->sourceEndpoint(&endpoint);
+    NTSCFG_TEST_OK(error);
+
+    // Fill the backlog so that the next connection request is dropped.
+
+    bsl::shared_ptr<ntsi::StreamSocket> fillerSocket =
+        ntsf::System::createStreamSocket(allocator);
+
+    error = fillerSocket->open(ntsa::Transport::e_TCP_IPV6_STREAM);
+    NTSCFG_TEST_OK(error);
+
+    error = fillerSocket->connect(endpoint);
+    NTSCFG_TEST_OK(error);
+
+    // Resolve a name to both the IPv6 and IPv4 loopback addresses. Nothing
+    // listens on the IPv4 loopback address at the listener's port, so the
+    // attempt raced to it is refused.
+
+    const bsl::string name = "happy-eyeballs-stalled.test";
+
+    error = scheduler->resolver()->addIpAddress(
+        name,
+        ntsa::IpAddress(ntsa::Ipv6Address::loopback()));
+    NTSCFG_TEST_OK(error);
+
+    error = scheduler->resolver()->addIpAddress(
+        name,
+        ntsa::IpAddress(ntsa::Ipv4Address::loopback()));
+    NTSCFG_TEST_OK(error);
+
+    ntca::ConnectOptions connectOptions;
+    connectOptions.setStrategy(
+        ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS);
+    connectOptions.setDeadline(streamSocket->currentTime() +
+                               bsls::TimeInterval(10));
+
+    const bsl::string connectName =
+        name + ":" + bsl::to_string(endpoint.ip().port());
+
+    ntci::ConnectFuture connectFuture(allocator);
+    error = streamSocket->connect(connectName, connectOptions, connectFuture);
+    NTSCFG_TEST_OK(error);
+
+    // Drain the backlog well after the connection attempt delay has
+    // elapsed, so that the retransmitted IPv6 connection request succeeds.
+
+    bslmt::ThreadUtil::microSleep(500 * 1000);
+
+    bsl::shared_ptr<ntsi::StreamSocket> acceptedSocket;
+    error = listenerSocket->accept(&acceptedSocket, allocator);
+    NTSCFG_TEST_OK(error);
+
+    while (true) {
+        ntci::ConnectResult connectResult;
+        error = connectFuture.wait(&connectResult);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_LOG_INFO << "Processing connect event "
+                             << connectResult.event() << NTSCFG_TEST_LOG_END;
+
+        if (connectResult.event().type() == ntca::ConnectEventType::e_ERROR) {
+            NTSCFG_TEST_GT(
+                connectResult.event().context().attemptsRemaining(),
+                0);
+            continue;
+        }
+
+        NTSCFG_TEST_EQ(connectResult.event().type(),
+                       ntca::ConnectEventType::e_COMPLETE);
+
+        NTSCFG_TEST_OK(connectResult.event().context().error());
+
+        NTSCFG_TEST_EQ(connectResult.event().context().endpoint(), endpoint);
+
+        NTSCFG_TEST_FALSE(
+            connectResult.event().context().ipAddressType().isNull());
+        NTSCFG_TEST_EQ(
+            connectResult.event().context().ipAddressType().value(),
+            ntsa::IpAddressType::e_V6);
+
+        break;
+    }
+
+    acceptedSocket->close();
+    fillerSocket->close();
+    listenerSocket->close();
+
+#else
+
+    NTCCFG_WARNING_UNUSED(scheduler);
+    NTCCFG_WARNING_UNUSED(allocator);
+
+#endif
+}
+
+void SystemTest::concernConnectLimitActive(bslma::Allocator* allocator)
+{
+    // Concern: Connection limit reached on active side.
+    // Plan:
+
+    ntsa::Error error;
+
+    // Create an scheduler that only allows one connection at a time.
+
+    ntca::SchedulerConfig schedulerConfig;
+    schedulerConfig.setThreadName("test");
+    schedulerConfig.setMinThreads(2);
+    schedulerConfig.setMaxThreads(2);
+    schedulerConfig.setMaxConnections(1);
+
+    bsl::shared_ptr<ntci::Scheduler> scheduler =
+        ntcf::System::createScheduler(schedulerConfig, allocator);
+
+    error = scheduler->start();
+    NTSCFG_TEST_OK(error);
+
+    // Create two stream sockets.
+
+    ntca::StreamSocketOptions streamSocketOptionsA;
+    streamSocketOptionsA.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+
+    bsl::shared_ptr<ntci::StreamSocket> streamSocketA =
+        scheduler->createStreamSocket(streamSocketOptionsA, allocator);
+
+    ntca::StreamSocketOptions streamSocketOptionsB;
+    streamSocketOptionsB.setTransport(ntsa::Transport::e_TCP_IPV4_STREAM);
+
+    bsl::shared_ptr<ntci::StreamSocket> streamSocketB =
+        scheduler->createStreamSocket(streamSocketOptionsB, allocator);
+
+    // Create the listener socket.
+
+    bsl::shared_ptr<ntsi::ListenerSocket> listenerSocket =
+        ntsf::System::createListenerSocket(allocator);
+
+    error = listenerSocket->open(ntsa::Transport::e_TCP_IPV4_STREAM);
+    NTSCFG_TEST_OK(error);
+
+    // Bind the listener socket.
+
+    error =
+        listenerSocket->bind(ntsa::Endpoint(ntsa::Ipv4Address::loopback(), 0),
+                             true);
+    NTSCFG_TEST_OK(error);
+
+    ntsa::Endpoint endpoint;
+    error = listenerSocket->sourceEndpoint(&endpoint);
+    NTSCFG_TEST_OK(error);
+
+    // Begin listening.
+
+    error = listenerSocket->listen(100);
+    NTSCFG_TEST_OK(error);
+
+    // Connect stream socket A to the listener socket and ensure the
+    // connection completes successfully.
+
+    ntca::ConnectOptions connectOptionsA;
+    connectOptionsA.setRetryCount(100);
+    connectOptionsA.setRetryInterval(bsls::TimeInterval(1));
+
+    ntci::ConnectFuture connectFutureA(allocator);
+    error = streamSocketA->connect(endpoint, connectOptionsA, connectFutureA);
+    NTSCFG_TEST_OK(error);
+
+    ntci::ConnectResult connectResultA;
+    error = connectFutureA.wait(&connectResultA);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(connectResultA.event().type(),
+                   ntca::ConnectEventType::e_COMPLETE);
+
+    // Connect stream socket B to the listener socket, and ensure that
+    // the first several connection attempts fail because the connection
+    // limit has already been reached.
+
+    ntca::ConnectOptions connectOptionsB;
+    connectOptionsB.setRetryCount(100);
+    connectOptionsB.setRetryInterval(bsls::TimeInterval(1));
+
+    ntci::ConnectFuture connectFutureB(allocator);
+    error = streamSocketB->connect(endpoint, connectOptionsB, connectFutureB);
+    NTSCFG_TEST_OK(error);
+
+    for (bsl::size_t i = 0; i < 4; ++i) {
+        ntci::ConnectResult connectResultB;
+        error = connectFutureB.wait(&connectResultB);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_LOG_INFO << "Processing connect event "
+                             << connectResultB.event() << NTSCFG_TEST_LOG_END;
+
+        NTSCFG_TEST_EQ(connectResultB.event().type(),
+                       ntca::ConnectEventType::e_ERROR);
+
+        NTSCFG_TEST_EQ(connectResultB.event().context().error(),
+                       ntsa::Error(ntsa::Error::e_LIMIT));
+    }
+
+    // Close the first stream socket.
+
+    {
+        ntci::StreamSocketCloseGuard guard(streamSocketA);
+    }
+
+    // Now that the first stream socket is closed, the second stream socket
+    // should eventually connect.
+
+    while (true) {
+        ntci::ConnectResult connectResultB;
+        error = connectFutureB.wait(&connectResultB);
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_LOG_INFO << "Processing connect event "
+                             << connectResultB.event() << NTSCFG_TEST_LOG_END;
+
+        if (connectResultB.event().type() == ntca::ConnectEventType::e_ERROR) {
+            NTSCFG_TEST_EQ(connectResultB.event().context().error(),
+                           ntsa::Error(ntsa::Error::e_LIMIT));
+        }
+        else {
+            NTSCFG_TEST_EQ(connectResultB.event().type(),
+                           ntca::ConnectEventType::e_COMPLETE);
+            break;
+        }
+    }
+
+    // Close the second stream socket.
+
+    {
+        ntci::StreamSocketCloseGuard guard(streamSocketB);
+    }
+
+    // Stop the scheduler.
+
+    scheduler->shutdown();
+    scheduler->linger();
+}
+
+void SystemTest::concernConnectLimitPassive(bslma::Allocator* allocator)
+{
+    // Concern: Connection limit reached on passive side.
+    // Plan:
+
+    ntsa::Error error;
+
+    // Create an scheduler that only allows one connection at a time.
+
+    ntca::SchedulerConfig schedulerConfig;
+    schedulerConfig.setThreadName("test");
+    schedulerConfig.setMinThreads(2);
+    schedulerConfig.setMaxThreads(2);
+    schedulerConfig.setMaxConnections(1);
+
+    bsl::shared_ptr<ntci::Scheduler> scheduler =
+        ntcf::System::createScheduler(schedulerConfig, allocator);
+
+    error = scheduler->start();
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcu::ListenerSocketEventQueue> listenerSocketEventQueue;
     listenerSocketEventQueue.createInplace(NTSCFG_TEST_ALLOCATOR,
                                            NTSCFG_TEST_ALLOCATOR);
 
@@ -13331,39 +13835,595 @@ NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyResolverGetIpAddressClient)
 #endif
 }
 
-NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyResolverGetIpAddressOverride)
+NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyResolverGetIpAddressClientHedged)
 {
-    // Concern: Test 'Resolver::getIpAddress' using an override.
+    // Concern: Test 'Resolver::getIpAddress' from the DNS client configured
+    // to hedge queries: when the first name server is slow to answer, the
+    // query is raced on the next name server and the first answer wins.
 
     NTCI_LOG_CONTEXT();
 
     ntsa::Error error;
 
-    // Define a resolver configuration with the DNS client disabled and the
-    // operating system name service functions disabled.
+    const char k_HOSTS[] = "10.0.0.1 hedge.example.test\n";
 
-    ntca::ResolverConfig resolverConfig;
+    // Create and start an interface to run the name servers.
 
-    resolverConfig.setHostDatabaseEnabled(false);
-    resolverConfig.setPortDatabaseEnabled(false);
-    resolverConfig.setPositiveCacheEnabled(false);
-    resolverConfig.setNegativeCacheEnabled(false);
-    resolverConfig.setClientEnabled(false);
-    resolverConfig.setSystemEnabled(false);
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setThreadName("test");
+    interfaceConfig.setMinThreads(1);
+    interfaceConfig.setMaxThreads(1);
 
-    // Define an scheduler configuration that uses the resolver configuration.
+    bsl::shared_ptr<ntci::Interface> interface =
+        ntcf::System::createInterface(interfaceConfig, NTSCFG_TEST_ALLOCATOR);
 
-    ntca::SchedulerConfig schedulerConfig;
+    error = interface->start();
+    NTSCFG_TEST_OK(error);
 
-    schedulerConfig.setThreadName("test");
-    schedulerConfig.setMinThreads(1);
-    schedulerConfig.setMaxThreads(1);
-    schedulerConfig.setResolverConfig(resolverConfig);
+    bsl::shared_ptr<ntcdns::HostDatabase> hostDatabase;
+    hostDatabase.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
 
-    // Create and start an scheduler.
+    error = hostDatabase->loadText(k_HOSTS, sizeof k_HOSTS - 1);
+    NTSCFG_TEST_OK(error);
 
-    bsl::shared_ptr<ntci::Scheduler> scheduler =
-        ntcf::System::createScheduler(schedulerConfig, NTSCFG_TEST_ALLOCATOR);
+    ntcdns::ServerConfig serverConfig;
+    serverConfig.nameServer().address().host() = "127.0.0.1";
+    serverConfig.nameServer().address().port() = 0;
+
+    // Create a slow name server that answers only after a delay much longer
+    // than the hedge delay.
+
+    bsl::shared_ptr<ntcdns::Server> slowServer;
+    slowServer.createInplace(NTSCFG_TEST_ALLOCATOR,
+                             serverConfig,
+                             interface,
+                             NTSCFG_TEST_ALLOCATOR);
+
+    slowServer->setHostDatabase(hostDatabase);
+    slowServer->setResponseDelay(bsls::TimeInterval(5, 0));
+
+    error = slowServer->start();
+    NTSCFG_TEST_OK(error);
+
+    // Create a fast name server that answers immediately.
+
+    bsl::shared_ptr<ntcdns::Server> fastServer;
+    fastServer.createInplace(NTSCFG_TEST_ALLOCATOR,
+                             serverConfig,
+                             interface,
+                             NTSCFG_TEST_ALLOCATOR);
+
+    fastServer->setHostDatabase(hostDatabase);
+
+    error = fastServer->start();
+    NTSCFG_TEST_OK(error);
+
+    // Define a resolver configuration with the DNS client enabled, listing
+    // the slow name server first, hedging queries after 50 milliseconds.
+
+    bsl::vector<ntsa::Endpoint> remoteEndpointList;
+    remoteEndpointList.push_back(slowServer->sourceEndpoint());
+    remoteEndpointList.push_back(fastServer->sourceEndpoint());
+
+    ntca::ResolverConfig resolverConfig;
+    resolverConfig.setHostDatabaseEnabled(false);
+    resolverConfig.setPortDatabaseEnabled(false);
+    resolverConfig.setPositiveCacheEnabled(false);
+    resolverConfig.setNegativeCacheEnabled(false);
+    resolverConfig.setClientEnabled(true);
+    resolverConfig.setClientRemoteEndpointList(remoteEndpointList);
+    resolverConfig.setClientHedgeDelay(50);
+    resolverConfig.setSystemEnabled(false);
+
+    bsl::shared_ptr<ntci::Resolver> resolver =
+        ntcf::System::createResolver(resolverConfig, NTSCFG_TEST_ALLOCATOR);
+
+    error = resolver->start();
+    NTSCFG_TEST_OK(error);
+
+    // Get the IP addresses assigned to the name and ensure the answer is
+    // received from the fast name server well before the slow name server
+    // would have answered.
+
+    bslmt::Semaphore             semaphore;
+    bsl::vector<ntsa::IpAddress> ipAddressList(NTSCFG_TEST_ALLOCATOR);
+    ntca::GetIpAddressEvent      event;
+
+    ntci::GetIpAddressCallback callback =
+        resolver->createGetIpAddressCallback(
+            bdlf::BindUtil::bind(
+                &test::ResolverUtil::processGetIpAddressResultCapture,
+                bdlf::PlaceHolders::_1,
+                bdlf::PlaceHolders::_2,
+                bdlf::PlaceHolders::_3,
+                &ipAddressList,
+                &event,
+                &semaphore),
+            NTSCFG_TEST_ALLOCATOR);
+
+    ntca::GetIpAddressOptions options;
+    options.setIpAddressType(ntsa::IpAddressType::e_V4);
+
+    const bsls::TimeInterval startTime = bdlt::CurrentTime::now();
+
+    error = resolver->getIpAddress("hedge.example.test", options, callback);
+    NTSCFG_TEST_OK(error);
+
+    semaphore.wait();
+
+    const bsls::TimeInterval elapsed = bdlt::CurrentTime::now() - startTime;
+
+    NTSCFG_TEST_EQ(event.type(), ntca::GetIpAddressEventType::e_COMPLETE);
+    NTSCFG_TEST_EQ(ipAddressList.size(), 1);
+    NTSCFG_TEST_EQ(ipAddressList[0], ntsa::IpAddress("10.0.0.1"));
+
+    NTSCFG_TEST_FALSE(event.context().nameServer().isNull());
+    NTSCFG_TEST_EQ(event.context().nameServer().value(),
+                   fastServer->sourceEndpoint());
+
+    NTSCFG_TEST_LT(elapsed, bsls::TimeInterval(5, 0));
+
+    NTSCFG_TEST_EQ(slowServer->numRequests(), 1);
+    NTSCFG_TEST_EQ(fastServer->numRequests(), 1);
+
+    // Stop the resolver and the name servers.
+
+    resolver->shutdown();
+    resolver->linger();
+
+    fastServer->shutdown();
+    slowServer->shutdown();
+
+    interface->shutdown();
+    interface->linger();
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyResolverClientTruncatedRetry)
+{
+    // Concern: Test the DNS client retries a query over TCP when the answer
+    // received over UDP is truncated.
+
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    const char k_HOSTS[] = "10.0.0.1 tcp.example.test\n";
+
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setThreadName("test");
+    interfaceConfig.setMinThreads(1);
+    interfaceConfig.setMaxThreads(1);
+
+    bsl::shared_ptr<ntci::Interface> interface =
+        ntcf::System::createInterface(interfaceConfig, NTSCFG_TEST_ALLOCATOR);
+
+    error = interface->start();
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcdns::HostDatabase> hostDatabase;
+    hostDatabase.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    error = hostDatabase->loadText(k_HOSTS, sizeof k_HOSTS - 1);
+    NTSCFG_TEST_OK(error);
+
+    // Create a name server that truncates every answer sent over UDP.
+
+    bsl::shared_ptr<ntcdns::Server> server;
+    test::ResolverUtil::createServer(&server, interface, hostDatabase);
+
+    server->setTruncationEnabled(true);
+
+    bsl::vector<ntsa::Endpoint> nameServerList;
+    nameServerList.push_back(server->sourceEndpoint());
+
+    bsl::shared_ptr<ntcdns::Client> client;
+    test::ResolverUtil::createClient(&client,
+                                     interface,
+                                     nameServerList,
+                                     bdlb::NullableValue<unsigned int>());
+
+    // Resolve the name and ensure the answer is received over TCP after the
+    // truncated answer is received over UDP.
+
+    bslmt::Semaphore             semaphore;
+    bsl::vector<ntsa::IpAddress> ipAddressList(NTSCFG_TEST_ALLOCATOR);
+    ntca::GetIpAddressEvent      event;
+
+    test::ResolverUtil::getIpAddress(client,
+                                     "tcp.example.test",
+                                     &ipAddressList,
+                                     &event,
+                                     &semaphore);
+
+    semaphore.wait();
+
+    NTSCFG_TEST_EQ(event.type(), ntca::GetIpAddressEventType::e_COMPLETE);
+    NTSCFG_TEST_EQ(ipAddressList.size(), 1);
+    NTSCFG_TEST_EQ(ipAddressList[0], ntsa::IpAddress("10.0.0.1"));
+
+    NTSCFG_TEST_EQ(server->numRequests(), 1);
+    NTSCFG_TEST_EQ(server->numStreamRequests(), 1);
+    NTSCFG_TEST_EQ(server->numStreamConnections(), 1);
+
+    client->shutdown();
+    client->linger();
+
+    server->shutdown();
+
+    interface->shutdown();
+    interface->linger();
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyResolverClientStreamFragmented)
+{
+    // Concern: Test the DNS client reassembles each length-prefixed answer
+    // received over TCP when it arrives one byte at a time.
+
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    const char k_HOSTS[] = "10.0.0.2 fragment.example.test\n";
+
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setThreadName("test");
+    interfaceConfig.setMinThreads(1);
+    interfaceConfig.setMaxThreads(1);
+
+    bsl::shared_ptr<ntci::Interface> interface =
+        ntcf::System::createInterface(interfaceConfig, NTSCFG_TEST_ALLOCATOR);
+
+    error = interface->start();
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcdns::HostDatabase> hostDatabase;
+    hostDatabase.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    error = hostDatabase->loadText(k_HOSTS, sizeof k_HOSTS - 1);
+    NTSCFG_TEST_OK(error);
+
+    // Create a name server that truncates every answer sent over UDP and
+    // sends every answer over TCP one byte every millisecond, so that both
+    // the length prefix and the message are split across many reads.
+
+    bsl::shared_ptr<ntcdns::Server> server;
+    test::ResolverUtil::createServer(&server, interface, hostDatabase);
+
+    server->setTruncationEnabled(true);
+    server->setStreamFragmentation(1, bsls::TimeInterval(0, 1000000));
+
+    bsl::vector<ntsa::Endpoint> nameServerList;
+    nameServerList.push_back(server->sourceEndpoint());
+
+    bsl::shared_ptr<ntcdns::Client> client;
+    test::ResolverUtil::createClient(&client,
+                                     interface,
+                                     nameServerList,
+                                     bdlb::NullableValue<unsigned int>());
+
+    bslmt::Semaphore             semaphore;
+    bsl::vector<ntsa::IpAddress> ipAddressList(NTSCFG_TEST_ALLOCATOR);
+    ntca::GetIpAddressEvent      event;
+
+    test::ResolverUtil::getIpAddress(client,
+                                     "fragment.example.test",
+                                     &ipAddressList,
+                                     &event,
+                                     &semaphore);
+
+    semaphore.wait();
+
+    NTSCFG_TEST_EQ(event.type(), ntca::GetIpAddressEventType::e_COMPLETE);
+    NTSCFG_TEST_EQ(ipAddressList.size(), 1);
+    NTSCFG_TEST_EQ(ipAddressList[0], ntsa::IpAddress("10.0.0.2"));
+
+    NTSCFG_TEST_EQ(server->numStreamRequests(), 1);
+
+    client->shutdown();
+    client->linger();
+
+    server->shutdown();
+
+    interface->shutdown();
+    interface->linger();
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyResolverClientStreamPipelined)
+{
+    // Concern: Test the DNS client pipelines concurrent queries over a
+    // single TCP connection and matches each answer to its query by its
+    // transaction ID, regardless of the order in which answers arrive.
+
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    const bsl::size_t k_NUM_QUERIES = 3;
+
+    const char k_HOSTS[] = "10.0.0.1 one.example.test\n"
+                           "10.0.0.2 two.example.test\n"
+                           "10.0.0.3 three.example.test\n";
+
+    const char* k_NAMES[k_NUM_QUERIES] = {"one.example.test",
+                                          "two.example.test",
+                                          "three.example.test"};
+
+    const char* k_ADDRESSES[k_NUM_QUERIES] = {"10.0.0.1",
+                                              "10.0.0.2",
+                                              "10.0.0.3"};
+
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setThreadName("test");
+    interfaceConfig.setMinThreads(1);
+    interfaceConfig.setMaxThreads(1);
+
+    bsl::shared_ptr<ntci::Interface> interface =
+        ntcf::System::createInterface(interfaceConfig, NTSCFG_TEST_ALLOCATOR);
+
+    error = interface->start();
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcdns::HostDatabase> hostDatabase;
+    hostDatabase.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    error = hostDatabase->loadText(k_HOSTS, sizeof k_HOSTS - 1);
+    NTSCFG_TEST_OK(error);
+
+    // Create a name server that truncates every answer sent over UDP and
+    // answers queries received over TCP only once all of them have been
+    // received, in the reverse order in which they were received.
+
+    bsl::shared_ptr<ntcdns::Server> server;
+    test::ResolverUtil::createServer(&server, interface, hostDatabase);
+
+    server->setTruncationEnabled(true);
+    server->setStreamPipelineDepth(k_NUM_QUERIES);
+
+    bsl::vector<ntsa::Endpoint> nameServerList;
+    nameServerList.push_back(server->sourceEndpoint());
+
+    bsl::shared_ptr<ntcdns::Client> client;
+    test::ResolverUtil::createClient(&client,
+                                     interface,
+                                     nameServerList,
+                                     bdlb::NullableValue<unsigned int>());
+
+    bslmt::Semaphore             semaphore;
+    bsl::vector<ntsa::IpAddress> ipAddressList[k_NUM_QUERIES];
+    ntca::GetIpAddressEvent      event[k_NUM_QUERIES];
+
+    for (bsl::size_t i = 0; i < k_NUM_QUERIES; ++i) {
+        test::ResolverUtil::getIpAddress(client,
+                                         k_NAMES[i],
+                                         &ipAddressList[i],
+                                         &event[i],
+                                         &semaphore);
+    }
+
+    for (bsl::size_t i = 0; i < k_NUM_QUERIES; ++i) {
+        semaphore.wait();
+    }
+
+    for (bsl::size_t i = 0; i < k_NUM_QUERIES; ++i) {
+        NTSCFG_TEST_EQ(event[i].type(),
+                       ntca::GetIpAddressEventType::e_COMPLETE);
+        NTSCFG_TEST_EQ(ipAddressList[i].size(), 1);
+        NTSCFG_TEST_EQ(ipAddressList[i][0], ntsa::IpAddress(k_ADDRESSES[i]));
+    }
+
+    NTSCFG_TEST_EQ(server->numStreamConnections(), 1);
+    NTSCFG_TEST_EQ(server->numStreamRequests(), k_NUM_QUERIES);
+
+    client->shutdown();
+    client->linger();
+
+    server->shutdown();
+
+    interface->shutdown();
+    interface->linger();
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyResolverClientStreamIdle)
+{
+    // Concern: Test the DNS client closes its TCP connection to a name
+    // server once no queries have been outstanding on it for the idle
+    // timeout.
+
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    const char k_HOSTS[] = "10.0.0.1 idle.example.test\n";
+
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setThreadName("test");
+    interfaceConfig.setMinThreads(1);
+    interfaceConfig.setMaxThreads(1);
+
+    bsl::shared_ptr<ntci::Interface> interface =
+        ntcf::System::createInterface(interfaceConfig, NTSCFG_TEST_ALLOCATOR);
+
+    error = interface->start();
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcdns::HostDatabase> hostDatabase;
+    hostDatabase.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    error = hostDatabase->loadText(k_HOSTS, sizeof k_HOSTS - 1);
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcdns::Server> server;
+    test::ResolverUtil::createServer(&server, interface, hostDatabase);
+
+    server->setTruncationEnabled(true);
+
+    bsl::vector<ntsa::Endpoint> nameServerList;
+    nameServerList.push_back(server->sourceEndpoint());
+
+    // Create a client that closes idle TCP connections after 100
+    // milliseconds.
+
+    bsl::shared_ptr<ntcdns::Client> client;
+    test::ResolverUtil::createClient(&client,
+                                     interface,
+                                     nameServerList,
+                                     bdlb::NullableValue<unsigned int>(100));
+
+    bslmt::Semaphore             semaphore;
+    bsl::vector<ntsa::IpAddress> ipAddressList(NTSCFG_TEST_ALLOCATOR);
+    ntca::GetIpAddressEvent      event;
+
+    test::ResolverUtil::getIpAddress(client,
+                                     "idle.example.test",
+                                     &ipAddressList,
+                                     &event,
+                                     &semaphore);
+
+    semaphore.wait();
+
+    NTSCFG_TEST_EQ(event.type(), ntca::GetIpAddressEventType::e_COMPLETE);
+    NTSCFG_TEST_EQ(server->numStreamConnections(), 1);
+
+    // Wait for the server to observe the client close the connection.
+
+    const bsls::TimeInterval deadline =
+        bdlt::CurrentTime::now() + bsls::TimeInterval(5, 0);
+
+    while (server->numStreamConnectionsOpen() != 0) {
+        NTSCFG_TEST_LT(bdlt::CurrentTime::now(), deadline);
+        bslmt::ThreadUtil::microSleep(10000);
+    }
+
+    client->shutdown();
+    client->linger();
+
+    server->shutdown();
+
+    interface->shutdown();
+    interface->linger();
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyResolverClientStreamFailover)
+{
+    // Concern: Test the DNS client fails over to the next name server when
+    // a name server closes the TCP connection on which a query retried
+    // after a truncated answer is outstanding.
+
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    const char k_HOSTS[] = "10.0.0.1 failover.example.test\n";
+
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setThreadName("test");
+    interfaceConfig.setMinThreads(1);
+    interfaceConfig.setMaxThreads(1);
+
+    bsl::shared_ptr<ntci::Interface> interface =
+        ntcf::System::createInterface(interfaceConfig, NTSCFG_TEST_ALLOCATOR);
+
+    error = interface->start();
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcdns::HostDatabase> hostDatabase;
+    hostDatabase.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    error = hostDatabase->loadText(k_HOSTS, sizeof k_HOSTS - 1);
+    NTSCFG_TEST_OK(error);
+
+    // Create a name server that truncates every answer sent over UDP and
+    // closes every TCP connection as soon as it receives a query.
+
+    bsl::shared_ptr<ntcdns::Server> brokenServer;
+    test::ResolverUtil::createServer(&brokenServer, interface, hostDatabase);
+
+    brokenServer->setTruncationEnabled(true);
+    brokenServer->setStreamCloseEnabled(true);
+
+    // Create a name server that answers normally.
+
+    bsl::shared_ptr<ntcdns::Server> server;
+    test::ResolverUtil::createServer(&server, interface, hostDatabase);
+
+    bsl::vector<ntsa::Endpoint> nameServerList;
+    nameServerList.push_back(brokenServer->sourceEndpoint());
+    nameServerList.push_back(server->sourceEndpoint());
+
+    bsl::shared_ptr<ntcdns::Client> client;
+    test::ResolverUtil::createClient(&client,
+                                     interface,
+                                     nameServerList,
+                                     bdlb::NullableValue<unsigned int>());
+
+    bslmt::Semaphore             semaphore;
+    bsl::vector<ntsa::IpAddress> ipAddressList(NTSCFG_TEST_ALLOCATOR);
+    ntca::GetIpAddressEvent      event;
+
+    test::ResolverUtil::getIpAddress(client,
+                                     "failover.example.test",
+                                     &ipAddressList,
+                                     &event,
+                                     &semaphore);
+
+    semaphore.wait();
+
+    NTSCFG_TEST_EQ(event.type(), ntca::GetIpAddressEventType::e_COMPLETE);
+    NTSCFG_TEST_EQ(ipAddressList.size(), 1);
+    NTSCFG_TEST_EQ(ipAddressList[0], ntsa::IpAddress("10.0.0.1"));
+
+    NTSCFG_TEST_FALSE(event.context().nameServer().isNull());
+    NTSCFG_TEST_EQ(event.context().nameServer().value(),
+                   server->sourceEndpoint());
+
+    NTSCFG_TEST_EQ(brokenServer->numRequests(), 1);
+    NTSCFG_TEST_EQ(brokenServer->numStreamRequests(), 1);
+    NTSCFG_TEST_EQ(server->numRequests(), 1);
+    NTSCFG_TEST_EQ(server->numStreamRequests(), 0);
+
+    client->shutdown();
+    client->linger();
+
+    server->shutdown();
+    brokenServer->shutdown();
+
+    interface->shutdown();
+    interface->linger();
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyResolverGetIpAddressOverride)
+{
+    // Concern: Test 'Resolver::getIpAddress' using an override.
+
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    // Define a resolver configuration with the DNS client disabled and the
+    // operating system name service functions disabled.
+
+    ntca::ResolverConfig resolverConfig;
+
+    resolverConfig.setHostDatabaseEnabled(false);
+    resolverConfig.setPortDatabaseEnabled(false);
+    resolverConfig.setPositiveCacheEnabled(false);
+    resolverConfig.setNegativeCacheEnabled(false);
+    resolverConfig.setClientEnabled(false);
+    resolverConfig.setSystemEnabled(false);
+
+    // Define an scheduler configuration that uses the resolver configuration.
+
+    ntca::SchedulerConfig schedulerConfig;
+
+    schedulerConfig.setThreadName("test");
+    schedulerConfig.setMinThreads(1);
+    schedulerConfig.setMaxThreads(1);
+    schedulerConfig.setResolverConfig(resolverConfig);
+
+    // Create and start an scheduler.
+
+    bsl::shared_ptr<ntci::Scheduler> scheduler =
+        ntcf::System::createScheduler(schedulerConfig, NTSCFG_TEST_ALLOCATOR);
 
     error = scheduler->start();
     NTSCFG_TEST_OK(error);
@@ -14108,6 +15168,154 @@ NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyResolverGetEndpointOverride)
 #endif
 }
 
+NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyOpenMetricsEndpoint)
+{
+    // Concern: An HTTP GET of the metrics resource over a loopback
+    // connection is answered with the most recent OpenMetrics snapshot,
+    // and the connection is closed after the response.
+
+    ntsa::Error error;
+
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setThreadName("test");
+    interfaceConfig.setMinThreads(1);
+    interfaceConfig.setMaxThreads(1);
+
+    bsl::shared_ptr<ntci::Interface> interface =
+        ntcf::System::createInterface(interfaceConfig, NTSCFG_TEST_ALLOCATOR);
+
+    error = interface->start();
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcs::OpenMetricsPublisher> publisher;
+    publisher.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    {
+        bsl::shared_ptr<ntcs::Metrics> metrics;
+        metrics.createInplace(NTSCFG_TEST_ALLOCATOR,
+                              "socket",
+                              "test",
+                              NTSCFG_TEST_ALLOCATOR);
+
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        metrics->getStats(&stats);
+
+        publisher->publish(metrics,
+                           stats.datum(),
+                           bdlt::CurrentTime::now(),
+                           true);
+    }
+
+    bsl::shared_ptr<const bsl::string> snapshot = publisher->snapshot();
+    NTSCFG_TEST_TRUE(snapshot);
+
+    bsl::shared_ptr<ntcu::OpenMetricsEndpoint> endpoint;
+    endpoint.createInplace(NTSCFG_TEST_ALLOCATOR,
+                           publisher,
+                           interface,
+                           NTSCFG_TEST_ALLOCATOR);
+
+    error = endpoint->open(ntsa::Endpoint(
+        ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)));
+    NTSCFG_TEST_OK(error);
+
+    bsl::string response(NTSCFG_TEST_ALLOCATOR);
+    test::OpenMetricsUtil::request(
+        &response,
+        endpoint->sourceEndpoint(),
+        "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n",
+        NTSCFG_TEST_ALLOCATOR);
+
+    const bsl::string k_STATUS_LINE = "HTTP/1.1 200 OK\r\n";
+    NTSCFG_TEST_EQ(response.compare(0, k_STATUS_LINE.size(), k_STATUS_LINE),
+                   0);
+
+    bsl::string contentType(NTSCFG_TEST_ALLOCATOR);
+    contentType.append("Content-Type: ");
+    contentType.append(ntcs::OpenMetricsPublisher::contentType());
+    contentType.append("\r\n");
+    NTSCFG_TEST_NE(response.find(contentType), bsl::string::npos);
+
+    const bsl::size_t headerEnd = response.find("\r\n\r\n");
+    NTSCFG_TEST_NE(headerEnd, bsl::string::npos);
+
+    const bsl::string body = response.substr(headerEnd + 4);
+    NTSCFG_TEST_EQ(body, *snapshot);
+    NTSCFG_TEST_EQ(body.compare(body.size() - 6, 6, "# EOF\n"), 0);
+
+    test::OpenMetricsUtil::request(&response,
+                                   endpoint->sourceEndpoint(),
+                                   "GET / HTTP/1.1\r\n\r\n",
+                                   NTSCFG_TEST_ALLOCATOR);
+
+    const bsl::string k_NOT_FOUND = "HTTP/1.1 404 Not Found\r\n";
+    NTSCFG_TEST_EQ(response.compare(0, k_NOT_FOUND.size(), k_NOT_FOUND), 0);
+
+    endpoint->close();
+
+    interface->shutdown();
+    interface->linger();
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyOpenMetricsEndpointTimeout)
+{
+    // Concern: A connection whose request is not completely received within
+    // the request timeout is closed without a response.
+
+    ntsa::Error error;
+
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setThreadName("test");
+    interfaceConfig.setMinThreads(1);
+    interfaceConfig.setMaxThreads(1);
+
+    bsl::shared_ptr<ntci::Interface> interface =
+        ntcf::System::createInterface(interfaceConfig, NTSCFG_TEST_ALLOCATOR);
+
+    error = interface->start();
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcs::OpenMetricsPublisher> publisher;
+    publisher.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcu::OpenMetricsEndpoint> endpoint;
+    endpoint.createInplace(NTSCFG_TEST_ALLOCATOR,
+                           publisher,
+                           interface,
+                           NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_EQ(endpoint->requestTimeout(),
+                   bsls::TimeInterval(
+                       ntcu::OpenMetricsEndpoint::k_DEFAULT_REQUEST_TIMEOUT,
+                       0));
+
+    endpoint->setRequestTimeout(bsls::TimeInterval(0, 100 * 1000 * 1000));
+
+    error = endpoint->open(ntsa::Endpoint(
+        ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)));
+    NTSCFG_TEST_OK(error);
+
+    const bsls::TimeInterval startTime = bdlt::CurrentTime::now();
+
+    // Send only the request line, never the end of the header.
+
+    bsl::string response(NTSCFG_TEST_ALLOCATOR);
+    test::OpenMetricsUtil::request(&response,
+                                   endpoint->sourceEndpoint(),
+                                   "GET /metrics HTTP/1.1\r\n",
+                                   NTSCFG_TEST_ALLOCATOR);
+
+    const bsls::TimeInterval elapsed = bdlt::CurrentTime::now() - startTime;
+
+    NTSCFG_TEST_TRUE(response.empty());
+    NTSCFG_TEST_LT(elapsed, bsls::TimeInterval(5, 0));
+
+    endpoint->close();
+
+    interface->shutdown();
+    interface->linger();
+}
+
 NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyDataExchange)
 {
     test::concern(&test::concernDataExchange, NTSCFG_TEST_ALLOCATOR);
@@ -14221,6 +15429,19 @@ NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyConnectName8)
     test::concern(&test::concernConnectName8, NTSCFG_TEST_ALLOCATOR);
 }
 
+NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyConnectNameHappyEyeballs)
+{
+    test::concern(&test::concernConnectNameHappyEyeballs,
+                  NTSCFG_TEST_ALLOCATOR);
+}
+
+NTSCFG_TEST_FUNCTION(
+    ntcf::SystemTest::verifyConnectNameHappyEyeballsStalled)
+{
+    test::concern(&test::concernConnectNameHappyEyeballsStalled,
+                  NTSCFG_TEST_ALLOCATOR);
+}
+
 NTSCFG_TEST_FUNCTION(ntcf::SystemTest::verifyConnectLimitActive)
 {
     test::concernConnectLimitActive(NTSCFG_TEST_ALLOCATOR);
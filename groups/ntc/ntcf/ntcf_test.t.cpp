@@ -160,4 +160,8 @@ NTSCFG_TEST_FUNCTION(ntcf::TestTest::verify)
 #include <ntcf_testfixture.cpp>
 #include <ntcf_testfixture.t.cpp>
 
+#include <ntcf_testloadgenerator.h>
+#include <ntcf_testloadgenerator.cpp>
+#include <ntcf_testloadgenerator.t.cpp>
+
 #endif
@@ -0,0 +1,764 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCF_TESTLOADGENERATOR_CPP
+#define INCLUDED_NTCF_TESTLOADGENERATOR_CPP
+
+#include <ntcf_testloadgenerator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcf_testloadgenerator_cpp, "$Id$ $CSID$")
+
+#include <bdlb_string.h>
+#include <bslim_printer.h>
+#include <bslma_default.h>
+#include <bslmt_condition.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+#include <bsls_assert.h>
+#include <bsls_systemclocktype.h>
+#include <bsls_systemtime.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+#include <bsl_cmath.h>
+#include <bsl_memory.h>
+#include <bsl_ostream.h>
+
+namespace BloombergLP {
+namespace ntcf {
+
+namespace {
+
+/// The duration before the scheduled time of a request, in nanoseconds,
+/// at which the generator stops sleeping and yields until the scheduled
+/// time, to compensate for the coarse granularity of sleeping.
+const bsls::Types::Int64 k_SPIN_THRESHOLD = 200 * 1000;
+
+/// Provide a generator of a pseudo-random sequence of uniformly distributed
+/// numbers.
+///
+/// @details
+/// This class implements the SplitMix64 generator, which is fast, has a
+/// full period of 2^64, and is fully determined by its seed, so that a
+/// Poisson schedule may be exactly reproduced.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+class RandomSequence
+{
+    bsl::uint64_t d_state;
+
+  public:
+    /// Create a new sequence determined by the specified 'seed'.
+    explicit RandomSequence(bsl::uint64_t seed)
+    : d_state(seed)
+    {
+    }
+
+    /// Return the next number in the sequence, uniformly distributed in the
+    /// range [0, 1).
+    double next()
+    {
+        d_state += 0x9E3779B97F4A7C15ULL;
+
+        bsl::uint64_t z = d_state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z = z ^ (z >> 31);
+
+        return static_cast<double>(z >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+/// Return the specified 'nanoseconds' as a time interval.
+bsls::TimeInterval toTimeInterval(double nanoseconds)
+{
+    bsls::TimeInterval result;
+    result.addNanoseconds(static_cast<bsls::Types::Int64>(nanoseconds));
+    return result;
+}
+
+}  // close unnamed namespace
+
+/// Provide the state of a single run, shared with the callback of each
+/// outstanding request.
+///
+/// @par Thread Safety
+/// This class is thread safe.
+class TestLoadGenerator::Run
+{
+    bslmt::Mutex          d_mutex;
+    bslmt::Condition      d_condition;
+    bsl::uint64_t         d_numOutstanding;
+    bsl::uint64_t         d_numCompleted;
+    bsl::uint64_t         d_numFailed;
+    bsl::uint64_t         d_latencyTotal;
+    bsl::uint64_t         d_latencyMax;
+    bool                  d_closed;
+    ntci::MetricHistogram d_latency;
+
+  private:
+    Run(const Run&) BSLS_KEYWORD_DELETED;
+    Run& operator=(const Run&) BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Create a new run. Latencies are recorded in nanoseconds from 2^6
+    /// nanoseconds.
+    Run();
+
+    /// Destroy this object.
+    ~Run();
+
+    /// Record the initiation of a request.
+    void initiate();
+
+    /// Record the failure to initiate a request.
+    void abandon();
+
+    /// Record the completion of a request scheduled at the specified
+    /// 'scheduledTime', according to the high-resolution timer, having the
+    /// specified 'result'. Ignore the completion if the run is closed.
+    void complete(const ntcf::TestEchoResult& result,
+                  bsls::Types::Int64          scheduledTime);
+
+    /// Block until no requests are outstanding or the specified 'timeout'
+    /// elapses.
+    void wait(const bsls::TimeInterval& timeout);
+
+    /// Close the run, count each outstanding request as failed, and load
+    /// the results into the specified 'result'.
+    void close(ntcf::TestLoadResult* result);
+};
+
+TestLoadGenerator::Run::Run()
+: d_mutex()
+, d_condition(bsls::SystemClockType::e_MONOTONIC)
+, d_numOutstanding(0)
+, d_numCompleted(0)
+, d_numFailed(0)
+, d_latencyTotal(0)
+, d_latencyMax(0)
+, d_closed(false)
+, d_latency(6)
+{
+}
+
+TestLoadGenerator::Run::~Run()
+{
+}
+
+void TestLoadGenerator::Run::initiate()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    ++d_numOutstanding;
+}
+
+void TestLoadGenerator::Run::abandon()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    BSLS_ASSERT(d_numOutstanding > 0);
+    --d_numOutstanding;
+    ++d_numFailed;
+
+    if (d_numOutstanding == 0) {
+        d_condition.signal();
+    }
+}
+
+void TestLoadGenerator::Run::complete(const ntcf::TestEchoResult& result,
+                                      bsls::Types::Int64 scheduledTime)
+{
+    const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (d_closed) {
+        return;
+    }
+
+    BSLS_ASSERT(d_numOutstanding > 0);
+    --d_numOutstanding;
+
+    if (result.value.isSuccessValue()) {
+        const bsl::uint64_t latency =
+            now > scheduledTime ? static_cast<bsl::uint64_t>(now -
+                                                             scheduledTime)
+                                : 0;
+
+        ++d_numCompleted;
+        d_latencyTotal += latency;
+
+        if (latency > d_latencyMax) {
+            d_latencyMax = latency;
+        }
+
+        d_latency.update(static_cast<double>(latency));
+    }
+    else {
+        ++d_numFailed;
+    }
+
+    if (d_numOutstanding == 0) {
+        d_condition.signal();
+    }
+}
+
+void TestLoadGenerator::Run::wait(const bsls::TimeInterval& timeout)
+{
+    const bsls::TimeInterval deadline =
+        bsls::SystemTime::nowMonotonicClock() + timeout;
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    while (d_numOutstanding > 0) {
+        int rc = d_condition.timedWait(&d_mutex, deadline);
+        if (rc == bslmt::Condition::e_TIMED_OUT) {
+            break;
+        }
+    }
+}
+
+void TestLoadGenerator::Run::close(ntcf::TestLoadResult* result)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    d_closed = true;
+
+    d_numFailed      += d_numOutstanding;
+    d_numOutstanding  = 0;
+
+    result->setNumCompleted(d_numCompleted);
+    result->setNumFailed(d_numFailed);
+
+    const double k_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+    double quantiles[4] = {0, 0, 0, 0};
+
+    const bsl::uint64_t numLatencies =
+        d_latency.load(quantiles, k_QUANTILES, 4);
+
+    if (numLatencies > 0) {
+        result->setLatencyMean(
+            toTimeInterval(static_cast<double>(d_latencyTotal) /
+                           static_cast<double>(numLatencies)));
+        result->setLatencyP50(toTimeInterval(quantiles[0]));
+        result->setLatencyP90(toTimeInterval(quantiles[1]));
+        result->setLatencyP99(toTimeInterval(quantiles[2]));
+        result->setLatencyP999(toTimeInterval(quantiles[3]));
+        result->setLatencyMax(
+            toTimeInterval(static_cast<double>(d_latencyMax)));
+    }
+}
+
+const char* TestArrivalProcess::toString(Value value)
+{
+    switch (value) {
+    case e_CONSTANT: {
+        return "CONSTANT";
+    } break;
+    case e_POISSON: {
+        return "POISSON";
+    } break;
+    }
+
+    BSLS_ASSERT(!"invalid enumerator");
+    return 0;
+}
+
+int TestArrivalProcess::fromString(Value*                   result,
+                                   const bslstl::StringRef& string)
+{
+    if (bdlb::String::areEqualCaseless(string, "CONSTANT")) {
+        *result = e_CONSTANT;
+        return 0;
+    }
+    if (bdlb::String::areEqualCaseless(string, "POISSON")) {
+        *result = e_POISSON;
+        return 0;
+    }
+
+    return -1;
+}
+
+bsl::ostream& TestArrivalProcess::print(bsl::ostream& stream, Value value)
+{
+    return stream << toString(value);
+}
+
+bsl::ostream& operator<<(bsl::ostream& stream, TestArrivalProcess::Value rhs)
+{
+    return TestArrivalProcess::print(stream, rhs);
+}
+
+TestLoadGeneratorConfig::TestLoadGeneratorConfig()
+: d_arrivalProcess(ntcf::TestArrivalProcess::e_POISSON)
+, d_rate(1000)
+, d_duration(1, 0)
+, d_drainTimeout(5, 0)
+, d_requestSize(32)
+, d_responseSize(32)
+, d_seed(1)
+{
+}
+
+void TestLoadGeneratorConfig::setArrivalProcess(
+    ntcf::TestArrivalProcess::Value value)
+{
+    d_arrivalProcess = value;
+}
+
+void TestLoadGeneratorConfig::setRate(double value)
+{
+    d_rate = value;
+}
+
+void TestLoadGeneratorConfig::setDuration(const bsls::TimeInterval& value)
+{
+    d_duration = value;
+}
+
+void TestLoadGeneratorConfig::setDrainTimeout(const bsls::TimeInterval& value)
+{
+    d_drainTimeout = value;
+}
+
+void TestLoadGeneratorConfig::setRequestSize(bsl::size_t value)
+{
+    d_requestSize = value;
+}
+
+void TestLoadGeneratorConfig::setResponseSize(bsl::size_t value)
+{
+    d_responseSize = value;
+}
+
+void TestLoadGeneratorConfig::setSeed(bsl::uint64_t value)
+{
+    d_seed = value;
+}
+
+ntcf::TestArrivalProcess::Value TestLoadGeneratorConfig::arrivalProcess()
+    const
+{
+    return d_arrivalProcess;
+}
+
+double TestLoadGeneratorConfig::rate() const
+{
+    return d_rate;
+}
+
+const bsls::TimeInterval& TestLoadGeneratorConfig::duration() const
+{
+    return d_duration;
+}
+
+const bsls::TimeInterval& TestLoadGeneratorConfig::drainTimeout() const
+{
+    return d_drainTimeout;
+}
+
+bsl::size_t TestLoadGeneratorConfig::requestSize() const
+{
+    return d_requestSize;
+}
+
+bsl::size_t TestLoadGeneratorConfig::responseSize() const
+{
+    return d_responseSize;
+}
+
+bsl::uint64_t TestLoadGeneratorConfig::seed() const
+{
+    return d_seed;
+}
+
+TestLoadResult::TestLoadResult()
+: d_targetRate(0)
+, d_achievedRate(0)
+, d_numScheduled(0)
+, d_numCompleted(0)
+, d_numFailed(0)
+, d_latencyMean()
+, d_latencyP50()
+, d_latencyP90()
+, d_latencyP99()
+, d_latencyP999()
+, d_latencyMax()
+, d_scheduleLagMax()
+{
+}
+
+void TestLoadResult::setTargetRate(double value)
+{
+    d_targetRate = value;
+}
+
+void TestLoadResult::setAchievedRate(double value)
+{
+    d_achievedRate = value;
+}
+
+void TestLoadResult::setNumScheduled(bsl::uint64_t value)
+{
+    d_numScheduled = value;
+}
+
+void TestLoadResult::setNumCompleted(bsl::uint64_t value)
+{
+    d_numCompleted = value;
+}
+
+void TestLoadResult::setNumFailed(bsl::uint64_t value)
+{
+    d_numFailed = value;
+}
+
+void TestLoadResult::setLatencyMean(const bsls::TimeInterval& value)
+{
+    d_latencyMean = value;
+}
+
+void TestLoadResult::setLatencyP50(const bsls::TimeInterval& value)
+{
+    d_latencyP50 = value;
+}
+
+void TestLoadResult::setLatencyP90(const bsls::TimeInterval& value)
+{
+    d_latencyP90 = value;
+}
+
+void TestLoadResult::setLatencyP99(const bsls::TimeInterval& value)
+{
+    d_latencyP99 = value;
+}
+
+void TestLoadResult::setLatencyP999(const bsls::TimeInterval& value)
+{
+    d_latencyP999 = value;
+}
+
+void TestLoadResult::setLatencyMax(const bsls::TimeInterval& value)
+{
+    d_latencyMax = value;
+}
+
+void TestLoadResult::setScheduleLagMax(const bsls::TimeInterval& value)
+{
+    d_scheduleLagMax = value;
+}
+
+double TestLoadResult::targetRate() const
+{
+    return d_targetRate;
+}
+
+double TestLoadResult::achievedRate() const
+{
+    return d_achievedRate;
+}
+
+bsl::uint64_t TestLoadResult::numScheduled() const
+{
+    return d_numScheduled;
+}
+
+bsl::uint64_t TestLoadResult::numCompleted() const
+{
+    return d_numCompleted;
+}
+
+bsl::uint64_t TestLoadResult::numFailed() const
+{
+    return d_numFailed;
+}
+
+const bsls::TimeInterval& TestLoadResult::latencyMean() const
+{
+    return d_latencyMean;
+}
+
+const bsls::TimeInterval& TestLoadResult::latencyP50() const
+{
+    return d_latencyP50;
+}
+
+const bsls::TimeInterval& TestLoadResult::latencyP90() const
+{
+    return d_latencyP90;
+}
+
+const bsls::TimeInterval& TestLoadResult::latencyP99() const
+{
+    return d_latencyP99;
+}
+
+const bsls::TimeInterval& TestLoadResult::latencyP999() const
+{
+    return d_latencyP999;
+}
+
+const bsls::TimeInterval& TestLoadResult::latencyMax() const
+{
+    return d_latencyMax;
+}
+
+const bsls::TimeInterval& TestLoadResult::scheduleLagMax() const
+{
+    return d_scheduleLagMax;
+}
+
+bsl::ostream& TestLoadResult::print(bsl::ostream& stream,
+                                    int           level,
+                                    int           spacesPerLevel) const
+{
+    bslim::Printer printer(&stream, level, spacesPerLevel);
+    printer.start();
+    printer.printAttribute("targetRate", d_targetRate);
+    printer.printAttribute("achievedRate", d_achievedRate);
+    printer.printAttribute("numScheduled", d_numScheduled);
+    printer.printAttribute("numCompleted", d_numCompleted);
+    printer.printAttribute("numFailed", d_numFailed);
+    printer.printAttribute("latencyMean", d_latencyMean);
+    printer.printAttribute("latencyP50", d_latencyP50);
+    printer.printAttribute("latencyP90", d_latencyP90);
+    printer.printAttribute("latencyP99", d_latencyP99);
+    printer.printAttribute("latencyP999", d_latencyP999);
+    printer.printAttribute("latencyMax", d_latencyMax);
+    printer.printAttribute("scheduleLagMax", d_scheduleLagMax);
+    printer.end();
+    return stream;
+}
+
+bsl::ostream& operator<<(bsl::ostream& stream, const TestLoadResult& object)
+{
+    return object.print(stream, 0, -1);
+}
+
+TestLoadGenerator::TestLoadGenerator(
+    const ntcf::TestLoadGeneratorConfig& configuration,
+    const ntcf::TestClientVector&        clients,
+    bslma::Allocator*                    basicAllocator)
+: d_config(configuration)
+, d_clientVector(clients, basicAllocator)
+, d_signalId(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+TestLoadGenerator::~TestLoadGenerator()
+{
+}
+
+ntsa::Error TestLoadGenerator::run(ntcf::TestLoadResult* result)
+{
+    return this->run(result, d_config.rate());
+}
+
+ntsa::Error TestLoadGenerator::run(ntcf::TestLoadResult* result,
+                                   double                rate)
+{
+    *result = ntcf::TestLoadResult();
+
+    if (d_clientVector.empty() || !(rate > 0)) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    bsl::shared_ptr<Run> run;
+    run.createInplace(d_allocator_p);
+
+    ntcf::TestSignal signal(d_allocator_p);
+    signal.value.assign(d_config.requestSize(), 'X');
+    signal.reflect = static_cast<bsl::uint32_t>(d_config.responseSize());
+
+    ntcf::TestOptions options;
+
+    RandomSequence randomSequence(d_config.seed());
+
+    const double meanInterval = 1000000000.0 / rate;
+    const double duration =
+        static_cast<double>(d_config.duration().totalNanoseconds());
+
+    bsls::Types::Int64 scheduleLagMax = 0;
+    bsl::uint64_t      numScheduled   = 0;
+    double             offset         = 0;
+
+    const bsls::Types::Int64 startTime = bsls::TimeUtil::getTimer();
+
+    while (true) {
+        if (d_config.arrivalProcess() == ntcf::TestArrivalProcess::e_POISSON)
+        {
+            offset += -bsl::log(1.0 - randomSequence.next()) * meanInterval;
+        }
+        else {
+            offset += meanInterval;
+        }
+
+        if (offset >= duration) {
+            break;
+        }
+
+        // Wait until the scheduled time of the request. If the generator is
+        // already late, send immediately: the lateness is measured as part
+        // of the latency of the request, since its latency is measured from
+        // its scheduled time.
+
+        const bsls::Types::Int64 scheduledTime =
+            startTime + static_cast<bsls::Types::Int64>(offset);
+
+        bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+
+        if (scheduledTime - now > k_SPIN_THRESHOLD) {
+            bsls::TimeInterval sleepDuration;
+            sleepDuration.addNanoseconds(scheduledTime - now -
+                                         k_SPIN_THRESHOLD);
+            bslmt::ThreadUtil::sleep(sleepDuration);
+            now = bsls::TimeUtil::getTimer();
+        }
+
+        while (now < scheduledTime) {
+            bslmt::ThreadUtil::yield();
+            now = bsls::TimeUtil::getTimer();
+        }
+
+        if (now - scheduledTime > scheduleLagMax) {
+            scheduleLagMax = now - scheduledTime;
+        }
+
+        const bsl::shared_ptr<ntcf::TestClient>& client =
+            d_clientVector[numScheduled % d_clientVector.size()];
+
+        signal.id = ++d_signalId;
+
+        ntcf::TestEchoCallback callback = client->createEchoCallback(
+            NTCCFG_BIND(&Run::complete,
+                        run,
+                        NTCCFG_BIND_PLACEHOLDER_1,
+                        scheduledTime),
+            d_allocator_p);
+
+        run->initiate();
+
+        ntsa::Error error = client->signal(signal, options, callback);
+        if (error) {
+            run->abandon();
+        }
+
+        ++numScheduled;
+    }
+
+    run->wait(d_config.drainTimeout());
+
+    const bsls::Types::Int64 stopTime = bsls::TimeUtil::getTimer();
+
+    run->close(result);
+
+    // The achieved rate is measured over the time from the first scheduled
+    // request until the last request completes, so that a server that
+    // falls behind the target rate, and must drain a backlog of requests
+    // after the schedule ends, achieves proportionally less than the
+    // target.
+
+    double elapsed = static_cast<double>(stopTime - startTime);
+    if (elapsed < duration) {
+        elapsed = duration;
+    }
+
+    result->setTargetRate(rate);
+    result->setNumScheduled(numScheduled);
+    result->setAchievedRate(static_cast<double>(result->numCompleted()) *
+                            1000000000.0 / elapsed);
+    result->setScheduleLagMax(
+        toTimeInterval(static_cast<double>(scheduleLagMax)));
+
+    BALL_LOG_DEBUG << "Load generator run complete: " << *result
+                   << BALL_LOG_END;
+
+    return ntsa::Error();
+}
+
+ntsa::Error TestLoadGenerator::ramp(
+    bsl::vector<ntcf::TestLoadResult>* result,
+    double                             minimumRate,
+    double                             maximumRate,
+    double                             rateStep)
+{
+    if (!(minimumRate > 0) || !(rateStep > 0) || maximumRate < minimumRate) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    const bsl::size_t numSteps = static_cast<bsl::size_t>(
+        bsl::floor((maximumRate - minimumRate) / rateStep + 1e-9)) + 1;
+
+    for (bsl::size_t i = 0; i < numSteps; ++i) {
+        const double rate = minimumRate + static_cast<double>(i) * rateStep;
+
+        ntcf::TestLoadResult stepResult;
+        ntsa::Error          error = this->run(&stepResult, rate);
+        if (error) {
+            return error;
+        }
+
+        result->push_back(stepResult);
+    }
+
+    return ntsa::Error();
+}
+
+bsl::size_t TestLoadUtil::findKnee(
+    const bsl::vector<ntcf::TestLoadResult>& results,
+    double                                   throughputTolerance,
+    double                                   latencyFactor)
+{
+    BSLS_ASSERT(throughputTolerance > 0 && throughputTolerance <= 1);
+    BSLS_ASSERT(latencyFactor >= 1);
+
+    if (results.empty()) {
+        return 0;
+    }
+
+    const double baselineLatency =
+        results.front().latencyP99().totalSecondsAsDouble();
+
+    for (bsl::size_t i = 0; i < results.size(); ++i) {
+        const ntcf::TestLoadResult& result = results[i];
+
+        if (result.achievedRate() <
+            result.targetRate() * throughputTolerance)
+        {
+            return i;
+        }
+
+        if (result.numFailed() > 0) {
+            return i;
+        }
+
+        if (baselineLatency > 0 &&
+            result.latencyP99().totalSecondsAsDouble() >
+                baselineLatency * latencyFactor)
+        {
+            return i;
+        }
+    }
+
+    return results.size();
+}
+
+}  // close namespace ntcf
+}  // close namespace BloombergLP
+#endif
@@ -0,0 +1,411 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCF_TESTLOADGENERATOR
+#define INCLUDED_NTCF_TESTLOADGENERATOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntcf_testclient.h>
+#include <ntcf_testmessage.h>
+#include <ntcf_testvocabulary.h>
+#include <ntci_metric.h>
+#include <ball_log.h>
+#include <bslma_allocator.h>
+#include <bsls_atomic.h>
+#include <bsls_timeinterval.h>
+#include <bsl_cstddef.h>
+#include <bsl_cstdint.h>
+#include <bsl_iosfwd.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ntcf {
+
+/// Enumerate the processes by which an open-loop load generator schedules
+/// the arrival of each request.
+///
+/// @par Thread Safety
+/// This struct is thread safe.
+struct TestArrivalProcess {
+  public:
+    /// Enumerate the processes by which an open-loop load generator
+    /// schedules the arrival of each request.
+    enum Value {
+        /// Requests arrive at a constant interval of the reciprocal of the
+        /// rate.
+        e_CONSTANT = 0,
+
+        /// Requests arrive as a Poisson process: the interval between
+        /// successive requests is exponentially distributed with a mean of
+        /// the reciprocal of the rate.
+        e_POISSON = 1
+    };
+
+    /// Return the string representation exactly matching the enumerator
+    /// name corresponding to the specified enumeration 'value'.
+    static const char* toString(Value value);
+
+    /// Load into the specified 'result' the enumerator matching the
+    /// specified 'string'. Return 0 on success, and a non-zero value with
+    /// no effect on 'result' otherwise (i.e., 'string' does not match any
+    /// enumerator).
+    static int fromString(Value* result, const bslstl::StringRef& string);
+
+    /// Write to the specified 'stream' the string representation of the
+    /// specified enumeration 'value'. Return a reference to the modifiable
+    /// 'stream'.
+    static bsl::ostream& print(bsl::ostream& stream, Value value);
+};
+
+/// Format the specified 'rhs' to the specified output 'stream' and return a
+/// reference to the modifiable 'stream'.
+///
+/// @related ntcf::TestArrivalProcess
+bsl::ostream& operator<<(bsl::ostream& stream, TestArrivalProcess::Value rhs);
+
+/// Describe the configuration of an open-loop load generator.
+///
+/// @details
+/// Provide a value-semantic type that describes the schedule of the requests
+/// issued by an open-loop load generator, and the content of each request.
+///
+/// @par Attributes
+/// This class is composed of the following attributes.
+///
+/// @li @b arrivalProcess:
+/// The process by which each request is scheduled. The default value is
+/// 'ntcf::TestArrivalProcess::e_POISSON'.
+///
+/// @li @b rate:
+/// The mean number of requests scheduled per second. The default value is
+/// 1000.
+///
+/// @li @b duration:
+/// The duration of the schedule. The default value is one second.
+///
+/// @li @b drainTimeout:
+/// The maximum duration to wait, after the last request is scheduled, for
+/// each outstanding request to complete. Requests that do not complete
+/// within this duration are counted as failed. The default value is five
+/// seconds.
+///
+/// @li @b requestSize:
+/// The number of bytes in the payload of each request. The default value is
+/// 32.
+///
+/// @li @b responseSize:
+/// The number of bytes in the payload of each response. The default value
+/// is 32.
+///
+/// @li @b seed:
+/// The seed of the pseudo-random sequence of arrivals of a Poisson process.
+/// The default value is 1.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+class TestLoadGeneratorConfig
+{
+    ntcf::TestArrivalProcess::Value d_arrivalProcess;
+    double                          d_rate;
+    bsls::TimeInterval              d_duration;
+    bsls::TimeInterval              d_drainTimeout;
+    bsl::size_t                     d_requestSize;
+    bsl::size_t                     d_responseSize;
+    bsl::uint64_t                   d_seed;
+
+  public:
+    /// Create a new load generator configuration having the default value.
+    TestLoadGeneratorConfig();
+
+    /// Set the arrival process to the specified 'value'.
+    void setArrivalProcess(ntcf::TestArrivalProcess::Value value);
+
+    /// Set the mean number of requests scheduled per second to the
+    /// specified 'value'.
+    void setRate(double value);
+
+    /// Set the duration of the schedule to the specified 'value'.
+    void setDuration(const bsls::TimeInterval& value);
+
+    /// Set the maximum duration to wait for each outstanding request to
+    /// complete after the last request is scheduled to the specified
+    /// 'value'.
+    void setDrainTimeout(const bsls::TimeInterval& value);
+
+    /// Set the number of bytes in the payload of each request to the
+    /// specified 'value'.
+    void setRequestSize(bsl::size_t value);
+
+    /// Set the number of bytes in the payload of each response to the
+    /// specified 'value'.
+    void setResponseSize(bsl::size_t value);
+
+    /// Set the seed of the pseudo-random sequence of arrivals to the
+    /// specified 'value'.
+    void setSeed(bsl::uint64_t value);
+
+    /// Return the arrival process.
+    ntcf::TestArrivalProcess::Value arrivalProcess() const;
+
+    /// Return the mean number of requests scheduled per second.
+    double rate() const;
+
+    /// Return the duration of the schedule.
+    const bsls::TimeInterval& duration() const;
+
+    /// Return the maximum duration to wait for each outstanding request to
+    /// complete after the last request is scheduled.
+    const bsls::TimeInterval& drainTimeout() const;
+
+    /// Return the number of bytes in the payload of each request.
+    bsl::size_t requestSize() const;
+
+    /// Return the number of bytes in the payload of each response.
+    bsl::size_t responseSize() const;
+
+    /// Return the seed of the pseudo-random sequence of arrivals.
+    bsl::uint64_t seed() const;
+};
+
+/// Describe the result of running an open-loop load generator at a target
+/// rate.
+///
+/// @details
+/// Each latency is measured from the time at which the request was
+/// scheduled to be sent, not the time at which it was actually sent, so
+/// that any delay in the generator itself, or any queueing in the client,
+/// is included in the latency rather than silently omitted.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+class TestLoadResult
+{
+    double             d_targetRate;
+    double             d_achievedRate;
+    bsl::uint64_t      d_numScheduled;
+    bsl::uint64_t      d_numCompleted;
+    bsl::uint64_t      d_numFailed;
+    bsls::TimeInterval d_latencyMean;
+    bsls::TimeInterval d_latencyP50;
+    bsls::TimeInterval d_latencyP90;
+    bsls::TimeInterval d_latencyP99;
+    bsls::TimeInterval d_latencyP999;
+    bsls::TimeInterval d_latencyMax;
+    bsls::TimeInterval d_scheduleLagMax;
+
+  public:
+    /// Create a new load result having the default value.
+    TestLoadResult();
+
+    /// Set the number of requests scheduled per second to the specified
+    /// 'value'.
+    void setTargetRate(double value);
+
+    /// Set the number of requests completed per second to the specified
+    /// 'value'.
+    void setAchievedRate(double value);
+
+    /// Set the number of requests scheduled to the specified 'value'.
+    void setNumScheduled(bsl::uint64_t value);
+
+    /// Set the number of requests that completed successfully to the
+    /// specified 'value'.
+    void setNumCompleted(bsl::uint64_t value);
+
+    /// Set the number of requests that failed or did not complete to the
+    /// specified 'value'.
+    void setNumFailed(bsl::uint64_t value);
+
+    /// Set the mean latency to the specified 'value'.
+    void setLatencyMean(const bsls::TimeInterval& value);
+
+    /// Set the estimated 50th percentile latency to the specified 'value'.
+    void setLatencyP50(const bsls::TimeInterval& value);
+
+    /// Set the estimated 90th percentile latency to the specified 'value'.
+    void setLatencyP90(const bsls::TimeInterval& value);
+
+    /// Set the estimated 99th percentile latency to the specified 'value'.
+    void setLatencyP99(const bsls::TimeInterval& value);
+
+    /// Set the estimated 99.9th percentile latency to the specified 'value'.
+    void setLatencyP999(const bsls::TimeInterval& value);
+
+    /// Set the maximum latency to the specified 'value'.
+    void setLatencyMax(const bsls::TimeInterval& value);
+
+    /// Set the maximum duration by which the generator sent a request later
+    /// than it was scheduled to the specified 'value'.
+    void setScheduleLagMax(const bsls::TimeInterval& value);
+
+    /// Return the number of requests scheduled per second.
+    double targetRate() const;
+
+    /// Return the number of requests completed per second.
+    double achievedRate() const;
+
+    /// Return the number of requests scheduled.
+    bsl::uint64_t numScheduled() const;
+
+    /// Return the number of requests that completed successfully.
+    bsl::uint64_t numCompleted() const;
+
+    /// Return the number of requests that failed or did not complete.
+    bsl::uint64_t numFailed() const;
+
+    /// Return the mean latency.
+    const bsls::TimeInterval& latencyMean() const;
+
+    /// Return the estimated 50th percentile latency.
+    const bsls::TimeInterval& latencyP50() const;
+
+    /// Return the estimated 90th percentile latency.
+    const bsls::TimeInterval& latencyP90() const;
+
+    /// Return the estimated 99th percentile latency.
+    const bsls::TimeInterval& latencyP99() const;
+
+    /// Return the estimated 99.9th percentile latency.
+    const bsls::TimeInterval& latencyP999() const;
+
+    /// Return the maximum latency.
+    const bsls::TimeInterval& latencyMax() const;
+
+    /// Return the maximum duration by which the generator sent a request
+    /// later than it was scheduled.
+    const bsls::TimeInterval& scheduleLagMax() const;
+
+    /// Format this object to the specified output 'stream' at the
+    /// optionally specified indentation 'level' and return a reference to
+    /// the modifiable 'stream'. If 'level' is specified, optionally specify
+    /// 'spacesPerLevel', the number of spaces per indentation level for
+    /// this and all of its nested objects. Each line is indented by the
+    /// absolute value of 'level * spacesPerLevel'. If 'level' is negative,
+    /// suppress indentation of the first line. If 'spacesPerLevel' is
+    /// negative, suppress line breaks and format the entire output on one
+    /// line. If 'stream' is initially invalid, this operation has no effect.
+    /// Note that a trailing newline is provided in multiline mode only.
+    bsl::ostream& print(bsl::ostream& stream,
+                        int           level          = 0,
+                        int           spacesPerLevel = 4) const;
+};
+
+/// Format the specified 'object' to the specified output 'stream' and
+/// return a reference to the modifiable 'stream'.
+///
+/// @related ntcf::TestLoadResult
+bsl::ostream& operator<<(bsl::ostream& stream, const TestLoadResult& object);
+
+/// Provide an open-loop load generator of test client transactions.
+///
+/// @details
+/// A closed-loop client sends each request only after the response to its
+/// previous request is received, so when the server slows down the client
+/// slows down with it, and the requests that would have queued during the
+/// slowdown are never sent and their latency is never measured. This class
+/// instead schedules each request at a time determined only by the arrival
+/// process and the target rate, independent of the completion of any other
+/// request, round-robins the requests across a set of connected clients,
+/// and measures the latency of each request from its scheduled time. The
+/// latency of each request is recorded in an 'ntci::MetricHistogram', the
+/// same facility used to publish percentiles of latency metrics.
+///
+/// A run may be repeated at successively higher rates to find the
+/// saturation point ("knee") of the server: the highest rate at which the
+/// server still completes requests at the target rate without an explosion
+/// in tail latency.
+///
+/// @par Thread Safety
+/// This class is thread safe, but each run blocks the calling thread, which
+/// is used to schedule the requests of the run.
+class TestLoadGenerator
+{
+    /// Provide the state of a single run, shared with the callback of each
+    /// outstanding request.
+    class Run;
+
+    ntcf::TestLoadGeneratorConfig d_config;
+    ntcf::TestClientVector        d_clientVector;
+    bsls::AtomicUint64            d_signalId;
+    bslma::Allocator*             d_allocator_p;
+
+    BALL_LOG_SET_CLASS_CATEGORY("NTCF.TEST.LOAD.GENERATOR");
+
+  private:
+    TestLoadGenerator(const TestLoadGenerator&) BSLS_KEYWORD_DELETED;
+    TestLoadGenerator& operator=(const TestLoadGenerator&)
+        BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Create a new load generator having the specified 'configuration'
+    /// that issues requests through each of the specified 'clients', each
+    /// of which must already be connected. Optionally specify a
+    /// 'basicAllocator' used to supply memory. If 'basicAllocator' is 0, the
+    /// currently installed default allocator is used.
+    TestLoadGenerator(const ntcf::TestLoadGeneratorConfig& configuration,
+                      const ntcf::TestClientVector&        clients,
+                      bslma::Allocator*                    basicAllocator = 0);
+
+    /// Destroy this object.
+    ~TestLoadGenerator();
+
+    /// Schedule requests at the configured rate for the configured
+    /// duration, block until each request completes or the drain timeout
+    /// elapses, and load the result into the specified 'result'. Return the
+    /// error.
+    ntsa::Error run(ntcf::TestLoadResult* result);
+
+    /// Schedule requests at the specified 'rate' for the configured
+    /// duration, block until each request completes or the drain timeout
+    /// elapses, and load the result into the specified 'result'. Return the
+    /// error.
+    ntsa::Error run(ntcf::TestLoadResult* result, double rate);
+
+    /// Run successively at each rate from the specified 'minimumRate' to the
+    /// specified 'maximumRate', inclusive, in increments of the specified
+    /// 'rateStep', and append the result of each run to the specified
+    /// 'result'. Return the error.
+    ntsa::Error ramp(bsl::vector<ntcf::TestLoadResult>* result,
+                     double                             minimumRate,
+                     double                             maximumRate,
+                     double                             rateStep);
+};
+
+/// Provide utilities for analyzing the results of an open-loop load
+/// generator.
+///
+/// @par Thread Safety
+/// This struct is thread safe.
+struct TestLoadUtil {
+    /// Return the index of the first of the specified 'results', ordered by
+    /// increasing target rate, at which the server is saturated: the
+    /// achieved rate falls below the specified 'throughputTolerance'
+    /// fraction of the target rate, any request fails, or the 99th
+    /// percentile latency exceeds the specified 'latencyFactor' times the
+    /// 99th percentile latency of the first result. Return 'results.size()'
+    /// if no result is saturated. The behavior is undefined unless
+    /// 'throughputTolerance' is in the range (0, 1] and 'latencyFactor' is
+    /// at least 1.
+    static bsl::size_t findKnee(
+        const bsl::vector<ntcf::TestLoadResult>& results,
+        double                                   throughputTolerance,
+        double                                   latencyFactor);
+};
+
+}  // end namespace ntcf
+}  // end namespace BloombergLP
+#endif
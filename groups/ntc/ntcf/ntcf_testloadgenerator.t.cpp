@@ -0,0 +1,240 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCF_TESTLOADGENERATOR_T_CPP
+#define INCLUDED_NTCF_TESTLOADGENERATOR_T_CPP
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcf_testloadgenerator_t_cpp, "$Id$ $CSID$")
+
+#include <ntcf_testfixture.h>
+#include <ntcf_testloadgenerator.h>
+
+namespace BloombergLP {
+namespace ntcf {
+
+// Provide tests for 'ntcf::TestLoadGenerator'.
+class TestLoadGeneratorTest
+{
+    // Return a result having the specified 'targetRate', 'achievedRate',
+    // 'numFailed', and 99th percentile latency of the specified
+    // 'latencyP99Micros' microseconds.
+    static ntcf::TestLoadResult makeResult(double        targetRate,
+                                           double        achievedRate,
+                                           bsl::uint64_t numFailed,
+                                           int           latencyP99Micros);
+
+  public:
+    // Verify the arrival process enumerators round-trip through their
+    // string representations.
+    static void verifyArrivalProcess();
+
+    // Verify requests scheduled at a constant rate each complete, and their
+    // latencies are measured.
+    static void verifyConstant();
+
+    // Verify requests scheduled as a Poisson process each complete, and the
+    // number scheduled approximates the rate times the duration.
+    static void verifyPoisson();
+
+    // Verify a ramp runs once at each rate.
+    static void verifyRamp();
+
+    // Verify the saturation point of a ramp is found by throughput,
+    // failures, and tail latency.
+    static void verifyFindKnee();
+};
+
+ntcf::TestLoadResult TestLoadGeneratorTest::makeResult(
+    double        targetRate,
+    double        achievedRate,
+    bsl::uint64_t numFailed,
+    int           latencyP99Micros)
+{
+    ntcf::TestLoadResult result;
+    result.setTargetRate(targetRate);
+    result.setAchievedRate(achievedRate);
+    result.setNumFailed(numFailed);
+    result.setLatencyP99(
+        bsls::TimeInterval(0, latencyP99Micros * 1000));
+    return result;
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::TestLoadGeneratorTest::verifyArrivalProcess)
+{
+    int rc;
+
+    ntcf::TestArrivalProcess::Value value;
+
+    rc = ntcf::TestArrivalProcess::fromString(&value, "CONSTANT");
+    NTSCFG_TEST_EQ(rc, 0);
+    NTSCFG_TEST_EQ(value, ntcf::TestArrivalProcess::e_CONSTANT);
+
+    rc = ntcf::TestArrivalProcess::fromString(&value, "poisson");
+    NTSCFG_TEST_EQ(rc, 0);
+    NTSCFG_TEST_EQ(value, ntcf::TestArrivalProcess::e_POISSON);
+
+    rc = ntcf::TestArrivalProcess::fromString(&value, "UNIFORM");
+    NTSCFG_TEST_NE(rc, 0);
+    NTSCFG_TEST_EQ(value, ntcf::TestArrivalProcess::e_POISSON);
+
+    NTSCFG_TEST_EQ(bsl::string(ntcf::TestArrivalProcess::toString(
+                       ntcf::TestArrivalProcess::e_CONSTANT)),
+                   "CONSTANT");
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::TestLoadGeneratorTest::verifyConstant)
+{
+    ntsa::Error error;
+
+    ntcf::TestFixtureConfig fixtureConfig;
+    ntcf::TestFixture fixture(fixtureConfig, NTSCFG_TEST_ALLOCATOR);
+
+    ntcf::TestClientVector clients(NTSCFG_TEST_ALLOCATOR);
+    error = fixture.clientConnect(&clients, 2);
+    NTSCFG_TEST_OK(error);
+
+    ntcf::TestLoadGeneratorConfig config;
+    config.setArrivalProcess(ntcf::TestArrivalProcess::e_CONSTANT);
+    config.setRate(500);
+    config.setDuration(bsls::TimeInterval(0, 200 * 1000 * 1000));
+
+    ntcf::TestLoadGenerator generator(config, clients, NTSCFG_TEST_ALLOCATOR);
+
+    ntcf::TestLoadResult result;
+    error = generator.run(&result);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_LOG_DEBUG << "Result: " << result << NTSCFG_TEST_LOG_END;
+
+    // A constant schedule of 500 requests per second for 200 milliseconds
+    // schedules a request every 2 milliseconds, the last of which is
+    // strictly before the end of the schedule.
+
+    NTSCFG_TEST_EQ(result.numScheduled(), 99);
+    NTSCFG_TEST_EQ(result.numCompleted(), result.numScheduled());
+    NTSCFG_TEST_EQ(result.numFailed(), 0);
+    NTSCFG_TEST_EQ(result.targetRate(), 500);
+    NTSCFG_TEST_GT(result.achievedRate(), 0);
+
+    NTSCFG_TEST_GT(result.latencyP50(), bsls::TimeInterval());
+    NTSCFG_TEST_LE(result.latencyP50(), result.latencyP99());
+    NTSCFG_TEST_GT(result.latencyMax(), bsls::TimeInterval());
+    NTSCFG_TEST_GT(result.latencyMean(), bsls::TimeInterval());
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::TestLoadGeneratorTest::verifyPoisson)
+{
+    ntsa::Error error;
+
+    ntcf::TestFixtureConfig fixtureConfig;
+    ntcf::TestFixture fixture(fixtureConfig, NTSCFG_TEST_ALLOCATOR);
+
+    ntcf::TestClientVector clients(NTSCFG_TEST_ALLOCATOR);
+    error = fixture.clientConnect(&clients, 1);
+    NTSCFG_TEST_OK(error);
+
+    ntcf::TestLoadGeneratorConfig config;
+    config.setArrivalProcess(ntcf::TestArrivalProcess::e_POISSON);
+    config.setRate(1000);
+    config.setDuration(bsls::TimeInterval(0, 500 * 1000 * 1000));
+    config.setSeed(12345);
+
+    ntcf::TestLoadGenerator generator(config, clients, NTSCFG_TEST_ALLOCATOR);
+
+    ntcf::TestLoadResult result;
+    error = generator.run(&result);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_LOG_DEBUG << "Result: " << result << NTSCFG_TEST_LOG_END;
+
+    // The number of arrivals of a Poisson process of 1000 per second over
+    // 500 milliseconds has a mean of 500 and a standard deviation of about
+    // 22.
+
+    NTSCFG_TEST_GT(result.numScheduled(), 400);
+    NTSCFG_TEST_LT(result.numScheduled(), 600);
+    NTSCFG_TEST_EQ(result.numCompleted(), result.numScheduled());
+    NTSCFG_TEST_EQ(result.numFailed(), 0);
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::TestLoadGeneratorTest::verifyRamp)
+{
+    ntsa::Error error;
+
+    ntcf::TestFixtureConfig fixtureConfig;
+    ntcf::TestFixture fixture(fixtureConfig, NTSCFG_TEST_ALLOCATOR);
+
+    ntcf::TestClientVector clients(NTSCFG_TEST_ALLOCATOR);
+    error = fixture.clientConnect(&clients, 1);
+    NTSCFG_TEST_OK(error);
+
+    ntcf::TestLoadGeneratorConfig config;
+    config.setArrivalProcess(ntcf::TestArrivalProcess::e_CONSTANT);
+    config.setDuration(bsls::TimeInterval(0, 100 * 1000 * 1000));
+
+    ntcf::TestLoadGenerator generator(config, clients, NTSCFG_TEST_ALLOCATOR);
+
+    bsl::vector<ntcf::TestLoadResult> results(NTSCFG_TEST_ALLOCATOR);
+    error = generator.ramp(&results, 100, 300, 100);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(results.size(), 3);
+    NTSCFG_TEST_EQ(results[0].targetRate(), 100);
+    NTSCFG_TEST_EQ(results[1].targetRate(), 200);
+    NTSCFG_TEST_EQ(results[2].targetRate(), 300);
+
+    for (bsl::size_t i = 0; i < results.size(); ++i) {
+        NTSCFG_TEST_GT(results[i].numScheduled(), 0);
+        NTSCFG_TEST_EQ(results[i].numCompleted(), results[i].numScheduled());
+    }
+
+    error = generator.ramp(&results, 300, 100, 100);
+    NTSCFG_TEST_ERROR(error, ntsa::Error::e_INVALID);
+}
+
+NTSCFG_TEST_FUNCTION(ntcf::TestLoadGeneratorTest::verifyFindKnee)
+{
+    bsl::vector<ntcf::TestLoadResult> results(NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_EQ(ntcf::TestLoadUtil::findKnee(results, 0.95, 10), 0);
+
+    results.push_back(makeResult(1000, 1000, 0, 100));
+    results.push_back(makeResult(2000, 1990, 0, 150));
+    results.push_back(makeResult(3000, 2980, 0, 400));
+
+    NTSCFG_TEST_EQ(ntcf::TestLoadUtil::findKnee(results, 0.95, 10), 3);
+
+    // The achieved rate falls behind the target rate.
+
+    results.push_back(makeResult(4000, 3100, 0, 900));
+    NTSCFG_TEST_EQ(ntcf::TestLoadUtil::findKnee(results, 0.95, 10), 3);
+
+    // The tail latency explodes before the achieved rate falls behind.
+
+    results[2] = makeResult(3000, 2980, 0, 5000);
+    NTSCFG_TEST_EQ(ntcf::TestLoadUtil::findKnee(results, 0.95, 10), 2);
+
+    // Requests fail.
+
+    results[1] = makeResult(2000, 1990, 1, 150);
+    NTSCFG_TEST_EQ(ntcf::TestLoadUtil::findKnee(results, 0.95, 10), 1);
+}
+
+}  // close namespace ntcf
+}  // close namespace BloombergLP
+#endif
@@ -19,6 +19,8 @@
 BSLS_IDENT_RCSID(ntci_callback_t_cpp, "$Id$ $CSID$")
 
 #include <ntci_callback.h>
+#include <bslma_testallocator.h>
+#include <bsl_cstring.h>
 
 using namespace BloombergLP;
 
@@ -47,7 +49,15 @@ class CallbackTest
     // Concern: Callbacks may be invoked multiple times.
     static void verifyCase6();
 
+    // Concern: Reassigning the function of a callback, and copying the
+    // callback, does not accumulate memory.
+    static void verifyCase7();
+
   private:
+    /// Provide a functor larger than the small object buffer of a bindable
+    /// function.
+    class CountingFunctor;
+
     /// Provide a mechanism to authorize the invocation of an operation. This
     /// class is thread safe.
     class Authorization;
@@ -82,6 +92,27 @@ bsl::size_t CallbackTest::callsToTargetFunctionArg1 = 0;
 bsl::size_t CallbackTest::callsToTargetFunctionArg2 = 0;
 bsl::size_t CallbackTest::callsToTargetFunctionArg3 = 0;
 
+class CallbackTest::CountingFunctor
+{
+    bsl::uint64_t d_padding[8];
+    bsl::size_t*  d_counter_p;
+
+  public:
+    /// Create a new functor that increments the specified 'counter' when
+    /// invoked.
+    explicit CountingFunctor(bsl::size_t* counter)
+    : d_counter_p(counter)
+    {
+        bsl::memset(d_padding, 0, sizeof d_padding);
+    }
+
+    /// Increment the counter.
+    void operator()() const
+    {
+        ++(*d_counter_p);
+    }
+};
+
 void CallbackTest::targetFunctionArg0()
 {
     NTSCFG_TEST_LOG_DEBUG << "Executed f0" << NTSCFG_TEST_LOG_END;
@@ -1629,5 +1660,41 @@ NTSCFG_TEST_FUNCTION(ntci::CallbackTest::verifyCase6)
     NTSCFG_TEST_EQ(CallbackTest::callsToTargetFunctionArg0, 3);
 }
 
+NTSCFG_TEST_FUNCTION(ntci::CallbackTest::verifyCase7)
+{
+    typedef ntci::Callback<void()> CallbackArg0;
+
+    ntsa::Error error;
+
+    bslma::TestAllocator ta;
+
+    bsl::size_t counter = 0;
+
+    {
+        CallbackArg0::FunctionType function = CountingFunctor(&counter);
+
+        CallbackArg0 callback(function, &ta);
+
+        const bsls::Types::Int64 numBlocksInUse = ta.numBlocksInUse();
+
+        for (bsl::size_t i = 0; i < 100; ++i) {
+            callback.setFunction(function);
+
+            error = callback.execute(ntci::Strand::unknown());
+            NTSCFG_TEST_EQ(error, ntsa::Error::e_OK);
+
+            CallbackArg0 copy(callback, &ta);
+
+            error = copy.execute(ntci::Strand::unknown());
+            NTSCFG_TEST_EQ(error, ntsa::Error::e_OK);
+        }
+
+        NTSCFG_TEST_EQ(ta.numBlocksInUse(), numBlocksInUse);
+        NTSCFG_TEST_EQ(counter, 200);
+    }
+
+    NTSCFG_TEST_EQ(ta.numBlocksInUse(), 0);
+}
+
 }  // close namespace ntci
 }  // close namespace BloombergLP
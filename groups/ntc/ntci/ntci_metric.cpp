@@ -20,29 +20,76 @@ BSLS_IDENT_RCSID(ntci_metric_cpp, "$Id$ $CSID$")
 
 #include <bslma_allocator.h>
 #include <bslma_default.h>
+#include <bslmt_threadutil.h>
 #include <bsls_assert.h>
+#include <bsl_cmath.h>
 
 namespace BloombergLP {
 namespace ntci {
 
+void MetricValue::collectSummary(bdld::DatumMutableArrayRef* array,
+                                 bsl::size_t*                index) const
+{
+    if (d_count > 0) {
+        array->data()[(*index)++] =
+            bdld::Datum::createDouble(static_cast<double>(d_count));
+        array->data()[(*index)++] = bdld::Datum::createDouble(d_total);
+        array->data()[(*index)++] = bdld::Datum::createDouble(d_minimum);
+        array->data()[(*index)++] = bdld::Datum::createDouble(this->average());
+        array->data()[(*index)++] = bdld::Datum::createDouble(d_maximum);
+    }
+    else {
+        array->data()[(*index)++] = bdld::Datum::createNull();
+        array->data()[(*index)++] = bdld::Datum::createNull();
+        array->data()[(*index)++] = bdld::Datum::createNull();
+        array->data()[(*index)++] = bdld::Datum::createNull();
+        array->data()[(*index)++] = bdld::Datum::createNull();
+    }
+}
+
 void Metric::load(ntci::MetricValue* result)
 {
-    bsls::SpinLockGuard guard(&d_lock);
+    bsls::SpinLockGuard guard(&d_collectLock);
+
+    // Make the other slot active, then wait for each update in progress in
+    // the previously active slot to leave it, so that the slot is loaded
+    // only once every update recorded into it is complete.
+
+    bsls::Types::Uint64 current = d_state.load();
+    while (true) {
+        const bsls::Types::Uint64 previous =
+            d_state.testAndSwap(current, current ^ 1);
+        if (previous == current) {
+            break;
+        }
+        current = previous;
+    }
 
-    *result = d_value;
-    d_value.reset();
+    const bsl::size_t index = static_cast<bsl::size_t>(current & 1);
+
+    while (Metric::numWriters(current, index) != 0) {
+        bslmt::ThreadUtil::yield();
+        current = d_state.load();
+    }
+
+    Slot& slot = d_slot[index];
+
+    const bsl::uint64_t count   = slot.d_count.loadRelaxed();
+    const double        total   = decode(slot.d_total.loadRelaxed());
+    const double        minimum = decode(slot.d_minimum.loadRelaxed());
+    const double        maximum = decode(slot.d_maximum.loadRelaxed());
+    const double        last    = decode(d_last.loadRelaxed());
+
+    Metric::reset(&slot);
+
+    *result = ntci::MetricValue(count, total, minimum, maximum, last);
 }
 
 void Metric::collectCount(bdld::DatumMutableArrayRef* array,
                           bsl::size_t*                index)
 {
     ntci::MetricValue value;
-    {
-        bsls::SpinLockGuard guard(&d_lock);
-
-        value = d_value;
-        d_value.reset();
-    }
+    this->load(&value);
 
     if (value.count() > 0) {
         array->data()[(*index)++] =
@@ -57,12 +104,7 @@ void Metric::collectTotal(bdld::DatumMutableArrayRef* array,
                           bsl::size_t*                index)
 {
     ntci::MetricValue value;
-    {
-        bsls::SpinLockGuard guard(&d_lock);
-
-        value = d_value;
-        d_value.reset();
-    }
+    this->load(&value);
 
     if (value.count() > 0) {
         array->data()[(*index)++] = bdld::Datum::createDouble(value.total());
@@ -75,12 +117,7 @@ void Metric::collectTotal(bdld::DatumMutableArrayRef* array,
 void Metric::collectMin(bdld::DatumMutableArrayRef* array, bsl::size_t* index)
 {
     ntci::MetricValue value;
-    {
-        bsls::SpinLockGuard guard(&d_lock);
-
-        value = d_value;
-        d_value.reset();
-    }
+    this->load(&value);
 
     if (value.count() > 0) {
         array->data()[(*index)++] = bdld::Datum::createDouble(value.minimum());
@@ -93,12 +130,7 @@ void Metric::collectMin(bdld::DatumMutableArrayRef* array, bsl::size_t* index)
 void Metric::collectAvg(bdld::DatumMutableArrayRef* array, bsl::size_t* index)
 {
     ntci::MetricValue value;
-    {
-        bsls::SpinLockGuard guard(&d_lock);
-
-        value = d_value;
-        d_value.reset();
-    }
+    this->load(&value);
 
     if (value.count() > 0) {
         array->data()[(*index)++] = bdld::Datum::createDouble(value.average());
@@ -111,12 +143,7 @@ void Metric::collectAvg(bdld::DatumMutableArrayRef* array, bsl::size_t* index)
 void Metric::collectMax(bdld::DatumMutableArrayRef* array, bsl::size_t* index)
 {
     ntci::MetricValue value;
-    {
-        bsls::SpinLockGuard guard(&d_lock);
-
-        value = d_value;
-        d_value.reset();
-    }
+    this->load(&value);
 
     if (value.count() > 0) {
         array->data()[(*index)++] = bdld::Datum::createDouble(value.maximum());
@@ -129,12 +156,7 @@ void Metric::collectMax(bdld::DatumMutableArrayRef* array, bsl::size_t* index)
 void Metric::collectLast(bdld::DatumMutableArrayRef* array, bsl::size_t* index)
 {
     ntci::MetricValue value;
-    {
-        bsls::SpinLockGuard guard(&d_lock);
-
-        value = d_value;
-        d_value.reset();
-    }
+    this->load(&value);
 
     if (value.count() > 0) {
         array->data()[(*index)++] = bdld::Datum::createDouble(value.last());
@@ -148,30 +170,125 @@ void Metric::collectSummary(bdld::DatumMutableArrayRef* array,
                             bsl::size_t*                index)
 {
     ntci::MetricValue value;
-    {
-        bsls::SpinLockGuard guard(&d_lock);
+    this->load(&value);
 
-        value = d_value;
-        d_value.reset();
+    value.collectSummary(array, index);
+}
+
+bsl::size_t MetricHistogram::bucketIndex(double value) const
+{
+    if (!(value > 0)) {
+        return 0;
     }
 
-    if (value.count() > 0) {
-        array->data()[(*index)++] =
-            bdld::Datum::createDouble(static_cast<double>(value.count()));
-        array->data()[(*index)++] = bdld::Datum::createDouble(value.total());
-        array->data()[(*index)++] = bdld::Datum::createDouble(value.minimum());
-        array->data()[(*index)++] = bdld::Datum::createDouble(value.average());
-        array->data()[(*index)++] = bdld::Datum::createDouble(value.maximum());
+    // Decompose the value as 'fraction * 2^exponent', where 'fraction' is
+    // in the range [0.5, 1), so the value lies in the octave starting at
+    // 2^(exponent - 1).
+
+    int          exponent = 0;
+    const double fraction = bsl::frexp(value, &exponent);
+
+    const int octave = exponent - 1 - d_minimumExponent;
+
+    if (octave < 0) {
+        return 0;
+    }
+
+    if (octave >= k_NUM_OCTAVES) {
+        return k_NUM_BUCKETS - 1;
+    }
+
+    int subBucket = static_cast<int>((fraction - 0.5) * 2 * k_NUM_SUB_BUCKETS);
+    if (subBucket >= k_NUM_SUB_BUCKETS) {
+        subBucket = k_NUM_SUB_BUCKETS - 1;
+    }
+
+    return static_cast<bsl::size_t>(octave * k_NUM_SUB_BUCKETS + subBucket);
+}
+
+double MetricHistogram::bucketMidpoint(bsl::size_t index) const
+{
+    const int octave    = static_cast<int>(index / k_NUM_SUB_BUCKETS);
+    const int subBucket = static_cast<int>(index % k_NUM_SUB_BUCKETS);
+
+    const double lower =
+        bsl::ldexp(1.0 + static_cast<double>(subBucket) / k_NUM_SUB_BUCKETS,
+                   octave + d_minimumExponent);
+
+    const double upper = bsl::ldexp(
+        1.0 + static_cast<double>(subBucket + 1) / k_NUM_SUB_BUCKETS,
+        octave + d_minimumExponent);
+
+    return (lower + upper) / 2;
+}
+
+bsl::uint64_t MetricHistogram::load(double*       result,
+                                    const double* quantiles,
+                                    bsl::size_t   numQuantiles)
+{
+    bsl::uint64_t count[k_NUM_BUCKETS];
+    bsl::uint64_t total = 0;
+
+    for (bsl::size_t i = 0; i < k_NUM_BUCKETS; ++i) {
+        count[i]  = d_bucket[i].swap(0);
+        total    += count[i];
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    for (bsl::size_t q = 0; q < numQuantiles; ++q) {
+        bsl::uint64_t rank = static_cast<bsl::uint64_t>(
+            bsl::ceil(quantiles[q] * static_cast<double>(total)));
+        if (rank == 0) {
+            rank = 1;
+        }
+
+        bsl::uint64_t cumulative = 0;
+        bsl::size_t   i          = 0;
+
+        for (; i < k_NUM_BUCKETS - 1; ++i) {
+            cumulative += count[i];
+            if (cumulative >= rank) {
+                break;
+            }
+        }
+
+        result[q] = this->bucketMidpoint(i);
+    }
+
+    return total;
+}
+
+void MetricHistogram::collectPercentiles(bdld::DatumMutableArrayRef* array,
+                                         bsl::size_t*                index)
+{
+    const double quantiles[k_NUM_PERCENTILES] = {0.5, 0.9, 0.99, 0.999};
+    double       result[k_NUM_PERCENTILES];
+
+    if (this->load(result, quantiles, k_NUM_PERCENTILES) > 0) {
+        for (bsl::size_t i = 0; i < k_NUM_PERCENTILES; ++i) {
+            array->data()[(*index)++] = bdld::Datum::createDouble(result[i]);
+        }
     }
     else {
-        array->data()[(*index)++] = bdld::Datum::createNull();
-        array->data()[(*index)++] = bdld::Datum::createNull();
-        array->data()[(*index)++] = bdld::Datum::createNull();
-        array->data()[(*index)++] = bdld::Datum::createNull();
-        array->data()[(*index)++] = bdld::Datum::createNull();
+        for (bsl::size_t i = 0; i < k_NUM_PERCENTILES; ++i) {
+            array->data()[(*index)++] = bdld::Datum::createNull();
+        }
     }
 }
 
+double MetricHistogram::minimum() const
+{
+    return bsl::ldexp(1.0, d_minimumExponent);
+}
+
+double MetricHistogram::maximum() const
+{
+    return bsl::ldexp(1.0, d_minimumExponent + k_NUM_OCTAVES);
+}
+
 void MetricTotal::load(double* result)
 {
     bsls::SpinLockGuard guard(&d_lock);
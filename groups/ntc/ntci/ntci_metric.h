@@ -22,8 +22,10 @@ BSLS_IDENT("$Id: $")
 #include <ntccfg_platform.h>
 #include <ntci_monitorable.h>
 #include <ntcscm_version.h>
+#include <bsls_atomic.h>
 #include <bsls_spinlock.h>
 #include <bsl_algorithm.h>
+#include <bsl_cstring.h>
 #include <bsl_limits.h>
 #include <bsl_string.h>
 #include <bsl_vector.h>
@@ -60,12 +62,24 @@ class MetricValue
     /// Create a new metric snapshot having default values.
     MetricValue();
 
+    /// Create a new metric snapshot having the specified 'count', 'total',
+    /// 'minimum', 'maximum', and 'last' values.
+    MetricValue(bsl::uint64_t count,
+                double        total,
+                double        minimum,
+                double        maximum,
+                double        last);
+
     /// Reset the values to their defaults.
     void reset();
 
     /// Update the snapshot with the specified measured 'value'.
     void update(double value);
 
+    /// Merge the specified 'other' snapshot into this snapshot, as if each
+    /// of the values measured by 'other' were measured by this snapshot.
+    void merge(const MetricValue& other);
+
     /// Number of times the metric has been collected.
     bsl::uint64_t count() const;
 
@@ -83,19 +97,90 @@ class MetricValue
 
     /// The last update.
     double last() const;
+
+    /// Load the count, total, minimum, average, and maximum value of the
+    /// snapshot into the specified 'array', starting at '*index' and
+    /// modifying the indexes used.
+    void collectSummary(bdld::DatumMutableArrayRef* array,
+                        bsl::size_t*                index) const;
 };
 
 /// Provide a measurement defined by the total, minimum, average, and
 /// maximum of the recorded values.
 ///
+/// @details
+/// Each value is recorded without locking into the active one of two slots,
+/// each holding a count, total, minimum, and maximum updated atomically as
+/// the bit patterns of their floating point representation. A single state
+/// word holds the index of the active slot and the number of updates in
+/// progress in each slot: an update enters the active slot by atomically
+/// incrementing its number of updates in progress, and leaves it by
+/// decrementing that number. A collection makes the other slot active, waits
+/// until no update remains in progress in the previously active slot, then
+/// loads and resets it. Each collection therefore observes either all or
+/// none of the effects of each update. Users that record values from many
+/// threads should shard the metric per thread and merge the shards on
+/// collection, so that concurrent updates do not contend on the same cache
+/// line.
+///
 /// @par Thread Safety
 /// This class is thread safe.
 ///
 /// @ingroup module_ntci_metrics
 class Metric
 {
-    bsls::SpinLock    d_lock;
-    ntci::MetricValue d_value;
+    /// Describe the values recorded into one slot.
+    struct Slot {
+        bsls::AtomicUint64 d_count;
+        bsls::AtomicUint64 d_total;
+        bsls::AtomicUint64 d_minimum;
+        bsls::AtomicUint64 d_maximum;
+    };
+
+    /// Enumerate the constants used by this implementation.
+    enum Constant {
+        /// The number of slots.
+        k_NUM_SLOTS = 2,
+
+        /// The number of bits of the state that count the updates in
+        /// progress in each slot.
+        k_WRITER_BITS = 31
+    };
+
+    Slot               d_slot[k_NUM_SLOTS];
+    bsls::AtomicUint64 d_state;
+    bsls::AtomicUint64 d_last;
+    bsls::SpinLock     d_collectLock;
+
+  private:
+    Metric(const Metric&) BSLS_KEYWORD_DELETED;
+    Metric& operator=(const Metric&) BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Return the bit pattern of the specified 'value'.
+    static bsls::Types::Uint64 encode(double value);
+
+    /// Return the value having the specified 'bits' pattern.
+    static double decode(bsls::Types::Uint64 bits);
+
+    /// Return the amount by which the state is incremented for each update
+    /// in progress in the slot at the specified 'index'.
+    static bsls::Types::Uint64 writer(bsl::size_t index);
+
+    /// Return the number of updates in progress in the slot at the specified
+    /// 'index' according to the specified 'state'.
+    static bsls::Types::Uint64 numWriters(bsls::Types::Uint64 state,
+                                          bsl::size_t         index);
+
+    /// Reset the values recorded into the specified 'slot' to their
+    /// defaults.
+    static void reset(Slot* slot);
+
+    /// Enter the active slot and return its index.
+    bsl::size_t enter();
+
+    /// Leave the slot at the specified 'index'.
+    void leave(bsl::size_t index);
 
   public:
     /// Create a new metric having default values.
@@ -136,6 +221,90 @@ class Metric
     void collectSummary(bdld::DatumMutableArrayRef* array, bsl::size_t* index);
 };
 
+/// Provide a measurement of the distribution of the recorded values.
+///
+/// @details
+/// Values are counted in a log-linear histogram: each power-of-two range
+/// of values, from the power of two specified at construction for
+/// 'k_NUM_OCTAVES' successive powers of two, is divided into
+/// 'k_NUM_SUB_BUCKETS' linear sub-ranges. Values less than the smallest
+/// power of two, including zero and negative values, are counted in the
+/// first bucket, and values greater than the range are counted in the last
+/// bucket. Percentiles are estimated by the midpoint of the bucket in which
+/// they fall, so within the range each estimate is within one half of a
+/// sub-range, or about 6%, of an exact percentile. Each value is recorded
+/// by a single atomic increment.
+///
+/// @par Thread Safety
+/// This class is thread safe.
+///
+/// @ingroup module_ntci_metrics
+class MetricHistogram
+{
+  public:
+    enum Constant {
+        /// The number of linear sub-ranges of each power of two.
+        k_NUM_SUB_BUCKETS = 8,
+
+        /// The number of successive powers of two counted.
+        k_NUM_OCTAVES = 32,
+
+        /// The total number of buckets.
+        k_NUM_BUCKETS = k_NUM_SUB_BUCKETS * k_NUM_OCTAVES,
+
+        /// The number of percentiles published by 'collectPercentiles'.
+        k_NUM_PERCENTILES = 4
+    };
+
+  private:
+    bsls::AtomicUint d_bucket[k_NUM_BUCKETS];
+    int              d_minimumExponent;
+
+  private:
+    MetricHistogram(const MetricHistogram&) BSLS_KEYWORD_DELETED;
+    MetricHistogram& operator=(const MetricHistogram&) BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Return the index of the bucket that counts the specified 'value'.
+    bsl::size_t bucketIndex(double value) const;
+
+    /// Return the midpoint of the range of values counted by the bucket at
+    /// the specified 'index'.
+    double bucketMidpoint(bsl::size_t index) const;
+
+  public:
+    /// Create a new histogram counting values from 2 to the power of the
+    /// specified 'minimumExponent'.
+    explicit MetricHistogram(int minimumExponent);
+
+    /// Update the histogram with the specified measured 'value'.
+    void update(double value);
+
+    /// Load into the specified 'result' the estimates of each of the
+    /// specified 'numQuantiles' 'quantiles', each in the range [0, 1], of
+    /// the values recorded since the last load, then reset the histogram.
+    /// Return the number of values recorded since the last load. If no
+    /// values have been recorded, 'result' is unchanged.
+    bsl::uint64_t load(double*       result,
+                       const double* quantiles,
+                       bsl::size_t   numQuantiles);
+
+    /// Load the estimates of the 50th, 90th, 99th, and 99.9th percentiles of
+    /// the values recorded since the last collection into the specified
+    /// 'array', starting at '*index' and modifying the indexes used, then
+    /// reset the histogram.
+    void collectPercentiles(bdld::DatumMutableArrayRef* array,
+                            bsl::size_t*                index);
+
+    /// Return the minimum value counted by the histogram, other than in the
+    /// first bucket.
+    double minimum() const;
+
+    /// Return the maximum value counted by the histogram, other than in the
+    /// last bucket.
+    double maximum() const;
+};
+
 /// Provide a measurement defined by the last recorded value.
 ///
 /// @par Thread Safety
@@ -235,6 +404,17 @@ class MetricTotal
         NTCI_METRIC_METADATA_MIN(name), NTCI_METRIC_METADATA_AVG(name),       \
         NTCI_METRIC_METADATA_MAX(name)
 
+#define NTCI_METRIC_METADATA_PERCENTILE(name, percentile)                     \
+    {                                                                         \
+        #name "." #percentile, ntci::Monitorable::e_PERCENTILE                \
+    }
+
+#define NTCI_METRIC_METADATA_PERCENTILES(name)                                \
+    NTCI_METRIC_METADATA_PERCENTILE(name, p50),                               \
+        NTCI_METRIC_METADATA_PERCENTILE(name, p90),                           \
+        NTCI_METRIC_METADATA_PERCENTILE(name, p99),                           \
+        NTCI_METRIC_METADATA_PERCENTILE(name, p999)
+
 NTCCFG_INLINE
 MetricValue::MetricValue()
 : d_count(0)
@@ -245,6 +425,20 @@ MetricValue::MetricValue()
 {
 }
 
+NTCCFG_INLINE
+MetricValue::MetricValue(bsl::uint64_t count,
+                         double        total,
+                         double        minimum,
+                         double        maximum,
+                         double        last)
+: d_count(count)
+, d_total(total)
+, d_minimum(minimum)
+, d_maximum(maximum)
+, d_last(last)
+{
+}
+
 NTCCFG_INLINE
 void MetricValue::reset()
 {
@@ -265,6 +459,20 @@ void MetricValue::update(double value)
     d_last     = value;
 }
 
+NTCCFG_INLINE
+void MetricValue::merge(const MetricValue& other)
+{
+    if (other.d_count == 0) {
+        return;
+    }
+
+    d_count   += other.d_count;
+    d_total   += other.d_total;
+    d_minimum  = bsl::min(d_minimum, other.d_minimum);
+    d_maximum  = bsl::max(d_maximum, other.d_maximum);
+    d_last     = other.d_last;
+}
+
 NTCCFG_INLINE
 bsl::uint64_t MetricValue::count() const
 {
@@ -301,18 +509,139 @@ double MetricValue::last() const
     return d_last;
 }
 
+NTCCFG_INLINE
+bsls::Types::Uint64 Metric::encode(double value)
+{
+    bsls::Types::Uint64 result;
+    bsl::memcpy(&result, &value, sizeof result);
+    return result;
+}
+
+NTCCFG_INLINE
+double Metric::decode(bsls::Types::Uint64 bits)
+{
+    double result;
+    bsl::memcpy(&result, &bits, sizeof result);
+    return result;
+}
+
+NTCCFG_INLINE
+bsls::Types::Uint64 Metric::writer(bsl::size_t index)
+{
+    return static_cast<bsls::Types::Uint64>(1)
+           << (1 + index * k_WRITER_BITS);
+}
+
+NTCCFG_INLINE
+bsls::Types::Uint64 Metric::numWriters(bsls::Types::Uint64 state,
+                                       bsl::size_t         index)
+{
+    const bsls::Types::Uint64 mask =
+        (static_cast<bsls::Types::Uint64>(1) << k_WRITER_BITS) - 1;
+
+    return (state >> (1 + index * k_WRITER_BITS)) & mask;
+}
+
+NTCCFG_INLINE
+void Metric::reset(Slot* slot)
+{
+    slot->d_count.storeRelaxed(0);
+    slot->d_total.storeRelaxed(encode(0));
+    slot->d_minimum.storeRelaxed(encode(bsl::numeric_limits<double>::max()));
+    slot->d_maximum.storeRelaxed(encode(bsl::numeric_limits<double>::min()));
+}
+
+NTCCFG_INLINE
+bsl::size_t Metric::enter()
+{
+    bsls::Types::Uint64 current = d_state.load();
+    while (true) {
+        const bsl::size_t index = static_cast<bsl::size_t>(current & 1);
+
+        const bsls::Types::Uint64 previous =
+            d_state.testAndSwap(current, current + writer(index));
+        if (previous == current) {
+            return index;
+        }
+
+        current = previous;
+    }
+}
+
+NTCCFG_INLINE
+void Metric::leave(bsl::size_t index)
+{
+    d_state.subtract(writer(index));
+}
+
 NTCCFG_INLINE
 Metric::Metric()
-: d_lock(bsls::SpinLock::s_unlocked)
+: d_state(0)
+, d_last(encode(0))
+, d_collectLock(bsls::SpinLock::s_unlocked)
 {
+    for (bsl::size_t i = 0; i < k_NUM_SLOTS; ++i) {
+        Metric::reset(&d_slot[i]);
+    }
 }
 
 NTCCFG_INLINE
 void Metric::update(double value)
 {
-    bsls::SpinLockGuard guard(&d_lock);
+    const bsl::size_t index = this->enter();
+
+    Slot& slot = d_slot[index];
+
+    slot.d_count.addRelaxed(1);
+
+    bsls::Types::Uint64 current = slot.d_total.loadRelaxed();
+    while (true) {
+        const bsls::Types::Uint64 previous =
+            slot.d_total.testAndSwap(current, encode(decode(current) + value));
+        if (previous == current) {
+            break;
+        }
+        current = previous;
+    }
+
+    current = slot.d_minimum.loadRelaxed();
+    while (value < decode(current)) {
+        const bsls::Types::Uint64 previous =
+            slot.d_minimum.testAndSwap(current, encode(value));
+        if (previous == current) {
+            break;
+        }
+        current = previous;
+    }
 
-    d_value.update(value);
+    current = slot.d_maximum.loadRelaxed();
+    while (value > decode(current)) {
+        const bsls::Types::Uint64 previous =
+            slot.d_maximum.testAndSwap(current, encode(value));
+        if (previous == current) {
+            break;
+        }
+        current = previous;
+    }
+
+    d_last.storeRelaxed(encode(value));
+
+    this->leave(index);
+}
+
+NTCCFG_INLINE
+MetricHistogram::MetricHistogram(int minimumExponent)
+: d_minimumExponent(minimumExponent)
+{
+    for (bsl::size_t i = 0; i < k_NUM_BUCKETS; ++i) {
+        d_bucket[i].storeRelaxed(0);
+    }
+}
+
+NTCCFG_INLINE
+void MetricHistogram::update(double value)
+{
+    d_bucket[this->bucketIndex(value)].addRelaxed(1);
 }
 
 NTCCFG_INLINE
@@ -20,6 +20,11 @@ BSLS_IDENT_RCSID(ntci_metric_t_cpp, "$Id$ $CSID$")
 
 #include <ntci_metric.h>
 
+#include <bdlf_bind.h>
+#include <bslmt_threadgroup.h>
+#include <bsls_atomic.h>
+#include <bsl_cmath.h>
+
 using namespace BloombergLP;
 
 namespace BloombergLP {
@@ -28,14 +33,234 @@ namespace ntci {
 // Provide tests for 'ntci::Metric'.
 class MetricTest
 {
+    // Update the specified 'metric' with the specified 'numUpdates' values
+    // from 1 to 'numUpdates'.
+    static void updateMetric(ntci::Metric* metric, bsl::size_t numUpdates);
+
+    // Update the specified 'metric' with the value 1 the specified
+    // 'numUpdates' times, then increment the specified 'numDone'.
+    static void updateMetricUnit(ntci::Metric*    metric,
+                                 bsl::size_t      numUpdates,
+                                 bsls::AtomicInt* numDone);
+
   public:
     // TODO
     static void verify();
+
+    // Concern: Metrics summarize the values recorded since the last load.
+    static void verifySummary();
+
+    // Concern: Metrics updated concurrently without locks lose no values.
+    static void verifyConcurrency();
+
+    // Concern: Metrics loaded concurrently with updates observe either all
+    // or none of the effects of each update.
+    static void verifyCollectionConsistency();
+
+    // Concern: Metric snapshots merge.
+    static void verifyMerge();
+
+    // Concern: Histograms estimate percentiles within the resolution of
+    // their buckets.
+    static void verifyHistogram();
+
+    // Concern: Histograms count values outside of their range in their
+    // first and last buckets.
+    static void verifyHistogramRange();
 };
 
+void MetricTest::updateMetric(ntci::Metric* metric, bsl::size_t numUpdates)
+{
+    for (bsl::size_t i = 1; i <= numUpdates; ++i) {
+        metric->update(static_cast<double>(i));
+    }
+}
+
+void MetricTest::updateMetricUnit(ntci::Metric*    metric,
+                                  bsl::size_t      numUpdates,
+                                  bsls::AtomicInt* numDone)
+{
+    for (bsl::size_t i = 0; i < numUpdates; ++i) {
+        metric->update(1);
+    }
+
+    ++(*numDone);
+}
+
 NTSCFG_TEST_FUNCTION(ntci::MetricTest::verify)
 {
 }
 
+NTSCFG_TEST_FUNCTION(ntci::MetricTest::verifySummary)
+{
+    ntci::Metric metric;
+
+    metric.update(3);
+    metric.update(1);
+    metric.update(2);
+
+    ntci::MetricValue value;
+    metric.load(&value);
+
+    NTSCFG_TEST_EQ(value.count(), 3);
+    NTSCFG_TEST_EQ(value.total(), 6);
+    NTSCFG_TEST_EQ(value.minimum(), 1);
+    NTSCFG_TEST_EQ(value.average(), 2);
+    NTSCFG_TEST_EQ(value.maximum(), 3);
+    NTSCFG_TEST_EQ(value.last(), 2);
+
+    metric.load(&value);
+
+    NTSCFG_TEST_EQ(value.count(), 0);
+    NTSCFG_TEST_EQ(value.total(), 0);
+
+    metric.update(5);
+    metric.load(&value);
+
+    NTSCFG_TEST_EQ(value.count(), 1);
+    NTSCFG_TEST_EQ(value.minimum(), 5);
+    NTSCFG_TEST_EQ(value.maximum(), 5);
+}
+
+NTSCFG_TEST_FUNCTION(ntci::MetricTest::verifyConcurrency)
+{
+    const bsl::size_t k_NUM_THREADS = 4;
+    const bsl::size_t k_NUM_UPDATES = 10000;
+
+    ntci::Metric metric;
+
+    bslmt::ThreadGroup threadGroup(NTSCFG_TEST_ALLOCATOR);
+    threadGroup.addThreads(
+        bdlf::BindUtil::bind(&MetricTest::updateMetric,
+                             &metric,
+                             k_NUM_UPDATES),
+        static_cast<int>(k_NUM_THREADS));
+    threadGroup.joinAll();
+
+    ntci::MetricValue value;
+    metric.load(&value);
+
+    NTSCFG_TEST_EQ(value.count(), k_NUM_THREADS * k_NUM_UPDATES);
+    NTSCFG_TEST_EQ(value.total(),
+                   static_cast<double>(k_NUM_THREADS * k_NUM_UPDATES *
+                                       (k_NUM_UPDATES + 1) / 2));
+    NTSCFG_TEST_EQ(value.minimum(), 1);
+    NTSCFG_TEST_EQ(value.maximum(), static_cast<double>(k_NUM_UPDATES));
+}
+
+NTSCFG_TEST_FUNCTION(ntci::MetricTest::verifyCollectionConsistency)
+{
+    const bsl::size_t k_NUM_THREADS = 4;
+    const bsl::size_t k_NUM_UPDATES = 100000;
+
+    ntci::Metric    metric;
+    bsls::AtomicInt numDone(0);
+
+    bslmt::ThreadGroup threadGroup(NTSCFG_TEST_ALLOCATOR);
+    threadGroup.addThreads(
+        bdlf::BindUtil::bind(&MetricTest::updateMetricUnit,
+                             &metric,
+                             k_NUM_UPDATES,
+                             &numDone),
+        static_cast<int>(k_NUM_THREADS));
+
+    // Every value is 1, so each snapshot that counts any update must have a
+    // total equal to its count, and a minimum and maximum of 1.
+
+    bsl::uint64_t numCounted = 0;
+
+    while (true) {
+        const bool done =
+            numDone.load() == static_cast<int>(k_NUM_THREADS);
+
+        ntci::MetricValue value;
+        metric.load(&value);
+
+        if (value.count() > 0) {
+            NTSCFG_TEST_EQ(value.total(), static_cast<double>(value.count()));
+            NTSCFG_TEST_EQ(value.minimum(), 1);
+            NTSCFG_TEST_EQ(value.maximum(), 1);
+        }
+        else {
+            NTSCFG_TEST_EQ(value.total(), 0);
+        }
+
+        numCounted += value.count();
+
+        if (done) {
+            break;
+        }
+    }
+
+    threadGroup.joinAll();
+
+    NTSCFG_TEST_EQ(numCounted, k_NUM_THREADS * k_NUM_UPDATES);
+}
+
+NTSCFG_TEST_FUNCTION(ntci::MetricTest::verifyMerge)
+{
+    ntci::MetricValue value;
+
+    ntci::MetricValue empty;
+    value.merge(empty);
+
+    NTSCFG_TEST_EQ(value.count(), 0);
+
+    value.merge(ntci::MetricValue(2, 10, 4, 6, 6));
+    value.merge(ntci::MetricValue(1, 1, 1, 1, 1));
+
+    NTSCFG_TEST_EQ(value.count(), 3);
+    NTSCFG_TEST_EQ(value.total(), 11);
+    NTSCFG_TEST_EQ(value.minimum(), 1);
+    NTSCFG_TEST_EQ(value.maximum(), 6);
+    NTSCFG_TEST_EQ(value.last(), 1);
+}
+
+NTSCFG_TEST_FUNCTION(ntci::MetricTest::verifyHistogram)
+{
+    ntci::MetricHistogram histogram(0);
+
+    for (bsl::size_t i = 1; i <= 1000; ++i) {
+        histogram.update(static_cast<double>(i));
+    }
+
+    const double quantiles[4] = {0.5, 0.9, 0.99, 0.999};
+    const double expected[4]  = {500, 900, 990, 999};
+    double       result[4];
+
+    NTSCFG_TEST_EQ(histogram.load(result, quantiles, 4), 1000);
+
+    for (bsl::size_t i = 0; i < 4; ++i) {
+        const double error = bsl::fabs(result[i] - expected[i]) / expected[i];
+        NTSCFG_TEST_LE(error, 1.0 / ntci::MetricHistogram::k_NUM_SUB_BUCKETS);
+    }
+
+    NTSCFG_TEST_EQ(histogram.load(result, quantiles, 4), 0);
+}
+
+NTSCFG_TEST_FUNCTION(ntci::MetricTest::verifyHistogramRange)
+{
+    ntci::MetricHistogram histogram(-4);
+
+    NTSCFG_TEST_EQ(histogram.minimum(), 1.0 / 16);
+    NTSCFG_TEST_EQ(histogram.maximum(), 65536.0 * 65536.0 / 16);
+
+    histogram.update(0);
+    histogram.update(-1);
+    histogram.update(1.0 / 1024);
+
+    const double quantile = 1.0;
+    double       result   = 0;
+
+    NTSCFG_TEST_EQ(histogram.load(&result, &quantile, 1), 3);
+    NTSCFG_TEST_LE(result, histogram.minimum() * 2);
+
+    histogram.update(histogram.maximum() * 1024);
+
+    NTSCFG_TEST_EQ(histogram.load(&result, &quantile, 1), 1);
+    NTSCFG_TEST_LE(result, histogram.maximum());
+    NTSCFG_TEST_GT(result, histogram.maximum() / 2);
+}
+
 }  // close namespace ntci
 }  // close namespace BloombergLP
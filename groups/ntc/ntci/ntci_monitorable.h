@@ -118,11 +118,18 @@ class Monitorable : public virtual Identifiable
         // the result is the maximum of the maximums over the aggregated
         // interval.
 
-        e_AVERAGE
+        e_AVERAGE,
         // The statistic represents the average of a number of measurements
         // over an interval. When statistics of this type are aggregated
         // the result is the sum of the averages divided by the number
         // of aggregated averages; i.e., the average of averages.
+
+        e_PERCENTILE
+        // The statistic represents an estimate of a percentile of the
+        // distribution of a number of measurements over an interval. When
+        // statistics of this type are aggregated the result is the maximum
+        // of the percentiles over the aggregated interval, which is an
+        // upper bound of the percentile of the aggregated interval.
     };
 
     enum StatisticTag {
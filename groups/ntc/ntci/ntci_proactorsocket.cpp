@@ -91,5 +91,10 @@ void ProactorSocket::getInfo(ntsa::SocketInfo* result) const
     result->reset();
 }
 
+bsl::string ProactorSocket::metricsName() const
+{
+    return bsl::string();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
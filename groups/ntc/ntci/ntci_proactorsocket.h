@@ -28,6 +28,7 @@ BSLS_IDENT("$Id: $")
 #include <ntsa_socketinfo.h>
 #include <ntsi_descriptor.h>
 #include <ntsi_streamsocket.h>
+#include <bsl_string.h>
 
 namespace BloombergLP {
 namespace ntci {
@@ -127,6 +128,11 @@ class ProactorSocket : public ntci::ProactorSocketBase, public ntsi::Descriptor
     /// Load into the specified 'result' the information describing the
     /// state of this socket.
     virtual void getInfo(ntsa::SocketInfo* result) const;
+
+    /// Return the name under which the statistics of this socket are
+    /// published, or the empty string if the statistics of this socket are
+    /// not published separately from those of its parent.
+    virtual bsl::string metricsName() const;
 };
 
 NTCCFG_INLINE
@@ -56,5 +56,10 @@ void ReactorSocket::getInfo(ntsa::SocketInfo* result) const
     result->reset();
 }
 
+bsl::string ReactorSocket::metricsName() const
+{
+    return bsl::string();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
@@ -28,6 +28,7 @@ BSLS_IDENT("$Id: $")
 #include <ntsa_socketinfo.h>
 #include <ntsi_descriptor.h>
 #include <bsl_memory.h>
+#include <bsl_string.h>
 
 namespace BloombergLP {
 namespace ntci {
@@ -99,6 +100,11 @@ class ReactorSocket : public ntci::ReactorSocketBase, public ntsi::Descriptor
     /// Load into the specified 'result' the information describing the
     /// state of this socket.
     virtual void getInfo(ntsa::SocketInfo* result) const;
+
+    /// Return the name under which the statistics of this socket are
+    /// published, or the empty string if the statistics of this socket are
+    /// not published separately from those of its parent.
+    virtual bsl::string metricsName() const;
 };
 
 NTCCFG_INLINE
@@ -26,6 +26,7 @@ BSLS_IDENT_RCSID(ntco_devpoll_cpp, "$Id$ $CSID$")
 #include <ntcr_streamsocket.h>
 
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
 
 #include <ntci_log.h>
 #include <ntci_mutex.h>
@@ -35,6 +36,7 @@ BSLS_IDENT_RCSID(ntco_devpoll_cpp, "$Id$ $CSID$")
 #include <ntcs_controller.h>
 #include <ntcs_datapool.h>
 #include <ntcs_driver.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_nomenclature.h>
 #include <ntcs_reactormetrics.h>
 #include <ntcs_registry.h>
@@ -639,6 +641,8 @@ struct Devpoll::Result {
   public:
     ntca::WaiterOptions                   d_options;
     bsl::shared_ptr<ntci::ReactorMetrics> d_metrics_sp;
+    bsl::shared_ptr<ntcs::LoopProfiler>   d_profiler_sp;
+    bsl::shared_ptr<ntcs::StallDetector>  d_stallDetector_sp;
 
   private:
     Result(const Result&) BSLS_KEYWORD_DELETED;
@@ -657,6 +661,8 @@ struct Devpoll::Result {
 Devpoll::Result::Result(bslma::Allocator* basicAllocator)
 : d_options(basicAllocator)
 , d_metrics_sp()
+, d_profiler_sp()
+, d_stallDetector_sp()
 {
 }
 
@@ -1233,6 +1239,21 @@ ntci::Waiter Devpoll::registerWaiter(const ntca::WaiterOptions& waiterOptions)
             }
         }
 
+        ntcs::LoopProfilerUtil::createProfiler(
+            &result->d_profiler_sp,
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
+        ntcs::StallDetectorUtil::createStallDetector(
+            &result->d_stallDetector_sp,
+            d_config.stallThreshold(),
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
         d_waiterSet.insert(result);
     }
 
@@ -1273,6 +1294,10 @@ void Devpoll::deregisterWaiter(ntci::Waiter waiter)
         }
     }
 
+    ntcs::LoopProfilerUtil::destroyProfiler(result->d_profiler_sp);
+
+    ntcs::StallDetectorUtil::destroyStallDetector(result->d_stallDetector_sp);
+
     d_allocator_p->deleteObject(result);
 }
 
@@ -1896,8 +1921,13 @@ void Devpoll::run(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
 
     while (d_run) {
+        NTCS_LOOPPROFILER_BEGIN();
+
         if (d_config.maxThreads().value() > 1) {
             d_generationSemaphore.wait();
         }
@@ -1965,6 +1995,7 @@ void Devpoll::run(ntci::Waiter waiter)
         dvp.dp_timeout = (timeout >= 0) ? timeout : -1;
 
         rc = ::ioctl(d_devpoll, DP_POLL, &dvp);
+        NTCS_LOOPPROFILER_ENTER_DISPATCH();
 
         if (rc > 0 && d_config.oneShot().value()) {
             const int numResults = rc;
@@ -2075,6 +2106,8 @@ void Devpoll::run(ntci::Waiter waiter)
                     continue;
                 }
 
+                NTCS_LOOPPROFILER_EVENT();
+
                 ntsa::Handle descriptorHandle = entry->handle();
 
                 if (NTCCFG_UNLIKELY(((e.revents & POLLERR) != 0) ||
@@ -2186,13 +2219,15 @@ void Devpoll::run(ntci::Waiter waiter)
         bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
         while (numCycles != 0) {
             if (d_chronology.hasAnyScheduledOrDeferred()) {
-                d_chronology.announce(d_dynamic);
+                d_chronology.announce(d_dynamic, profiler);
                 --numCycles;
             }
             else {
                 break;
             }
         }
+
+        NTCS_LOOPPROFILER_END();
     }
 }
 
@@ -2208,6 +2243,11 @@ void Devpoll::poll(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
+    NTCS_LOOPPROFILER_BEGIN();
 
     if (d_config.maxThreads().value() > 1) {
         d_generationSemaphore.wait();
@@ -2274,6 +2314,7 @@ void Devpoll::poll(ntci::Waiter waiter)
     dvp.dp_timeout = (timeout >= 0) ? timeout : -1;
 
     rc = ::ioctl(d_devpoll, DP_POLL, &dvp);
+    NTCS_LOOPPROFILER_ENTER_DISPATCH();
 
     if (rc > 0 && d_config.oneShot().value()) {
         const int numResults = rc;
@@ -2385,6 +2426,8 @@ void Devpoll::poll(ntci::Waiter waiter)
                 continue;
             }
 
+            NTCS_LOOPPROFILER_EVENT();
+
             ntsa::Handle descriptorHandle = entry->handle();
 
             if (NTCCFG_UNLIKELY(((e.revents & POLLERR) != 0) ||
@@ -2495,13 +2538,15 @@ void Devpoll::poll(ntci::Waiter waiter)
     bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
     while (numCycles != 0) {
         if (d_chronology.hasAnyScheduledOrDeferred()) {
-            d_chronology.announce(d_dynamic);
+            d_chronology.announce(d_dynamic, profiler);
             --numCycles;
         }
         else {
             break;
         }
     }
+
+    NTCS_LOOPPROFILER_END();
 }
 
 void Devpoll::interruptOne()
@@ -26,6 +26,7 @@ BSLS_IDENT_RCSID(ntco_epoll_cpp, "$Id$ $CSID$")
 #include <ntcr_streamsocket.h>
 
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
 
 #include <ntci_log.h>
 #include <ntci_mutex.h>
@@ -35,6 +36,7 @@ BSLS_IDENT_RCSID(ntco_epoll_cpp, "$Id$ $CSID$")
 #include <ntcs_controller.h>
 #include <ntcs_datapool.h>
 #include <ntcs_driver.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_nomenclature.h>
 #include <ntcs_reactormetrics.h>
 #include <ntcs_registry.h>
@@ -716,6 +718,8 @@ struct Epoll::Result {
   public:
     ntca::WaiterOptions                     d_options;
     bsl::shared_ptr<ntci::ReactorMetrics>   d_metrics_sp;
+    bsl::shared_ptr<ntcs::LoopProfiler>     d_profiler_sp;
+    bsl::shared_ptr<ntcs::StallDetector>    d_stallDetector_sp;
     bdlb::NullableValue<bsls::TimeInterval> d_earliestTimerDue;
 
   private:
@@ -735,6 +739,8 @@ struct Epoll::Result {
 Epoll::Result::Result(bslma::Allocator* basicAllocator)
 : d_options(basicAllocator)
 , d_metrics_sp()
+, d_profiler_sp()
+, d_stallDetector_sp()
 , d_earliestTimerDue()
 {
 }
@@ -1366,6 +1372,21 @@ ntci::Waiter Epoll::registerWaiter(const ntca::WaiterOptions& waiterOptions)
             }
         }
 
+        ntcs::LoopProfilerUtil::createProfiler(
+            &result->d_profiler_sp,
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
+        ntcs::StallDetectorUtil::createStallDetector(
+            &result->d_stallDetector_sp,
+            d_config.stallThreshold(),
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
         d_waiterSet.insert(result);
     }
 
@@ -1406,6 +1427,10 @@ void Epoll::deregisterWaiter(ntci::Waiter waiter)
         }
     }
 
+    ntcs::LoopProfilerUtil::destroyProfiler(result->d_profiler_sp);
+
+    ntcs::StallDetectorUtil::destroyStallDetector(result->d_stallDetector_sp);
+
     d_allocator_p->deleteObject(result);
 }
 
@@ -2171,8 +2196,13 @@ void Epoll::run(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
 
     while (d_run) {
+        NTCS_LOOPPROFILER_BEGIN();
+
         int wait = -1;
 
 #if NTCO_EPOLL_USE_TIMERFD
@@ -2244,6 +2274,8 @@ void Epoll::run(ntci::Waiter waiter)
             rc = ::epoll_wait(d_epoll, results, MAX_EVENTS, wait);
         }
 
+        NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
         if (NTCCFG_LIKELY(rc > 0)) {
             NTCO_EPOLL_LOG_WAIT_RESULT_OR_TIMEOUT(rc, results);
 
@@ -2283,6 +2315,8 @@ void Epoll::run(ntci::Waiter waiter)
                     continue;
                 }
 
+                NTCS_LOOPPROFILER_EVENT();
+
                 BSLS_ASSERT(entry->handle() == descriptorHandle);
 
                 NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(descriptorHandle);
@@ -2441,13 +2475,15 @@ void Epoll::run(ntci::Waiter waiter)
         bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
         while (numCycles != 0) {
             if (d_chronology.hasAnyScheduledOrDeferred()) {
-                d_chronology.announce(d_dynamic);
+                d_chronology.announce(d_dynamic, profiler);
                 --numCycles;
             }
             else {
                 break;
             }
         }
+
+        NTCS_LOOPPROFILER_END();
     }
 }
 
@@ -2463,6 +2499,11 @@ void Epoll::poll(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
+    NTCS_LOOPPROFILER_BEGIN();
 
     int wait = -1;
 
@@ -2535,6 +2576,8 @@ void Epoll::poll(ntci::Waiter waiter)
         rc = ::epoll_wait(d_epoll, results, MAX_EVENTS, wait);
     }
 
+    NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
     if (NTCCFG_LIKELY(rc > 0)) {
         NTCO_EPOLL_LOG_WAIT_RESULT_OR_TIMEOUT(rc, results);
 
@@ -2573,6 +2616,8 @@ void Epoll::poll(ntci::Waiter waiter)
                 continue;
             }
 
+            NTCS_LOOPPROFILER_EVENT();
+
             BSLS_ASSERT(entry->handle() == descriptorHandle);
 
             NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(descriptorHandle);
@@ -2724,13 +2769,15 @@ void Epoll::poll(ntci::Waiter waiter)
     bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
     while (numCycles != 0) {
         if (d_chronology.hasAnyScheduledOrDeferred()) {
-            d_chronology.announce(d_dynamic);
+            d_chronology.announce(d_dynamic, profiler);
             --numCycles;
         }
         else {
             break;
         }
     }
+
+    NTCS_LOOPPROFILER_END();
 }
 
 void Epoll::interruptOne()
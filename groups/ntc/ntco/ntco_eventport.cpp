@@ -26,6 +26,7 @@ BSLS_IDENT_RCSID(ntco_eventport_cpp, "$Id$ $CSID$")
 #include <ntcr_streamsocket.h>
 
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
 
 #include <ntci_log.h>
 #include <ntci_mutex.h>
@@ -35,6 +36,7 @@ BSLS_IDENT_RCSID(ntco_eventport_cpp, "$Id$ $CSID$")
 #include <ntcs_controller.h>
 #include <ntcs_datapool.h>
 #include <ntcs_driver.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_nomenclature.h>
 #include <ntcs_reactormetrics.h>
 #include <ntcs_registry.h>
@@ -643,6 +645,8 @@ struct EventPort::Result {
   public:
     ntca::WaiterOptions                   d_options;
     bsl::shared_ptr<ntci::ReactorMetrics> d_metrics_sp;
+    bsl::shared_ptr<ntcs::LoopProfiler>   d_profiler_sp;
+    bsl::shared_ptr<ntcs::StallDetector>  d_stallDetector_sp;
 
   private:
     Result(const Result&) BSLS_KEYWORD_DELETED;
@@ -661,6 +665,8 @@ struct EventPort::Result {
 EventPort::Result::Result(bslma::Allocator* basicAllocator)
 : d_options(basicAllocator)
 , d_metrics_sp()
+, d_profiler_sp()
+, d_stallDetector_sp()
 {
 }
 
@@ -1129,6 +1135,21 @@ ntci::Waiter EventPort::registerWaiter(
             }
         }
 
+        ntcs::LoopProfilerUtil::createProfiler(
+            &result->d_profiler_sp,
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
+        ntcs::StallDetectorUtil::createStallDetector(
+            &result->d_stallDetector_sp,
+            d_config.stallThreshold(),
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
         d_waiterSet.insert(result);
     }
 
@@ -1169,6 +1190,10 @@ void EventPort::deregisterWaiter(ntci::Waiter waiter)
         }
     }
 
+    ntcs::LoopProfilerUtil::destroyProfiler(result->d_profiler_sp);
+
+    ntcs::StallDetectorUtil::destroyStallDetector(result->d_stallDetector_sp);
+
     d_allocator_p->deleteObject(result);
 }
 
@@ -1795,8 +1820,13 @@ void EventPort::run(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
 
     while (d_run) {
+        NTCS_LOOPPROFILER_BEGIN();
+
         int timeout = d_chronology.timeoutInMilliseconds();
 
         enum { MAX_EVENTS = 128 };
@@ -1830,6 +1860,8 @@ void EventPort::run(ntci::Waiter waiter)
                              timeout >= 0 ? &ts : 0);
         }
 
+        NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
         if (rc == 0 && eventCount > 0) {
             bsl::size_t numReadable    = 0;
             bsl::size_t numWritable    = 0;
@@ -1855,6 +1887,8 @@ void EventPort::run(ntci::Waiter waiter)
                     continue;
                 }
 
+                NTCS_LOOPPROFILER_EVENT();
+
                 BSLS_ASSERT(entry->handle() == descriptorHandle);
 
                 if (descriptorHandle != d_controllerDescriptorHandle) {
@@ -2025,13 +2059,15 @@ void EventPort::run(ntci::Waiter waiter)
         bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
         while (numCycles != 0) {
             if (d_chronology.hasAnyScheduledOrDeferred()) {
-                d_chronology.announce(d_dynamic);
+                d_chronology.announce(d_dynamic, profiler);
                 --numCycles;
             }
             else {
                 break;
             }
         }
+
+        NTCS_LOOPPROFILER_END();
     }
 }
 
@@ -2047,6 +2083,11 @@ void EventPort::poll(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
+    NTCS_LOOPPROFILER_BEGIN();
 
     int timeout = d_chronology.timeoutInMilliseconds();
 
@@ -2081,6 +2122,8 @@ void EventPort::poll(ntci::Waiter waiter)
                          timeout >= 0 ? &ts : 0);
     }
 
+    NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
     if (rc == 0 && eventCount > 0) {
         bsl::size_t numReadable    = 0;
         bsl::size_t numWritable    = 0;
@@ -2104,6 +2147,8 @@ void EventPort::poll(ntci::Waiter waiter)
                 continue;
             }
 
+            NTCS_LOOPPROFILER_EVENT();
+
             BSLS_ASSERT(entry->handle() == descriptorHandle);
 
             if (descriptorHandle != d_controllerDescriptorHandle) {
@@ -2273,13 +2318,15 @@ void EventPort::poll(ntci::Waiter waiter)
     bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
     while (numCycles != 0) {
         if (d_chronology.hasAnyScheduledOrDeferred()) {
-            d_chronology.announce(d_dynamic);
+            d_chronology.announce(d_dynamic, profiler);
             --numCycles;
         }
         else {
             break;
         }
     }
+
+    NTCS_LOOPPROFILER_END();
 }
 
 void EventPort::interruptOne()
@@ -26,6 +26,7 @@ BSLS_IDENT_RCSID(ntco_iocp_cpp, "$Id$ $CSID$")
 #include <ntcp_streamsocket.h>
 
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
 
 #include <ntci_log.h>
 #include <ntcs_async.h>
@@ -34,6 +35,7 @@ BSLS_IDENT_RCSID(ntco_iocp_cpp, "$Id$ $CSID$")
 #include <ntcs_datapool.h>
 #include <ntcs_driver.h>
 #include <ntcs_event.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_nomenclature.h>
 #include <ntcs_proactordetachcontext.h>
 #include <ntcs_proactormetrics.h>
@@ -638,6 +640,8 @@ struct Iocp::Result {
   public:
     ntca::WaiterOptions                    d_options;
     bsl::shared_ptr<ntci::ProactorMetrics> d_metrics_sp;
+    bsl::shared_ptr<ntcs::LoopProfiler>    d_profiler_sp;
+    bsl::shared_ptr<ntcs::StallDetector>   d_stallDetector_sp;
 
   private:
     Result(const Result&) BSLS_KEYWORD_DELETED;
@@ -656,6 +660,8 @@ struct Iocp::Result {
 Iocp::Result::Result(bslma::Allocator* basicAllocator)
 : d_options(basicAllocator)
 , d_metrics_sp()
+, d_profiler_sp()
+, d_stallDetector_sp()
 {
 }
 
@@ -762,10 +768,14 @@ void Iocp::flush()
 
 void Iocp::wait(ntci::Waiter waiter)
 {
-    NTCCFG_WARNING_UNUSED(waiter);
-
     NTCI_LOG_CONTEXT();
 
+    Iocp::Result* result = static_cast<Iocp::Result*>(waiter);
+
+    NTCCFG_WARNING_UNUSED(result);
+
+    NTCS_LOOPPROFILER_GET();
+
     ntsa::Error error;
 
     bslma::ManagedPtr<ntcs::Event> event;
@@ -799,6 +809,8 @@ void Iocp::wait(ntci::Waiter waiter)
 
     lastError = GetLastError();
 
+    NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
     if (!getQueueCompletionStatusResult) {
         if (overlapped) {
             error = ntsa::Error(lastError);
@@ -820,6 +832,8 @@ void Iocp::wait(ntci::Waiter waiter)
     ntcs::Event* eventRaw = reinterpret_cast<ntcs::Event*>(overlapped);
     event.load(eventRaw, &d_eventPool);
 
+    NTCS_LOOPPROFILER_EVENT();
+
     if (error && error == ntsa::Error::e_CANCELLED) {
         BSLS_ASSERT(lastError == ERROR_OPERATION_ABORTED);
         NTCO_IOCP_LOG_EVENT_CANCELLED(event);
@@ -1295,6 +1309,21 @@ ntci::Waiter Iocp::registerWaiter(const ntca::WaiterOptions& waiterOptions)
             }
         }
 
+        ntcs::LoopProfilerUtil::createProfiler(
+            &result->d_profiler_sp,
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
+        ntcs::StallDetectorUtil::createStallDetector(
+            &result->d_stallDetector_sp,
+            d_config.stallThreshold(),
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
         d_waiterSet.insert(result);
     }
 
@@ -1335,6 +1364,10 @@ void Iocp::deregisterWaiter(ntci::Waiter waiter)
         }
     }
 
+    ntcs::LoopProfilerUtil::destroyProfiler(result->d_profiler_sp);
+
+    ntcs::StallDetectorUtil::destroyStallDetector(result->d_stallDetector_sp);
+
     d_allocator_p->deleteObject(result);
 }
 
@@ -2536,7 +2569,17 @@ void Iocp::decrementLoad(const ntca::LoadBalancingOptions& options)
 
 void Iocp::run(ntci::Waiter waiter)
 {
+    Iocp::Result* result = static_cast<Iocp::Result*>(waiter);
+
+    NTCCFG_WARNING_UNUSED(result);
+
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
     while (d_run) {
+        NTCS_LOOPPROFILER_BEGIN();
+
         // Wait for an operation to complete or a timeout.
 
         this->wait(waiter);
@@ -2547,18 +2590,30 @@ void Iocp::run(ntci::Waiter waiter)
         bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
         while (numCycles != 0) {
             if (d_chronology.hasAnyScheduledOrDeferred()) {
-                d_chronology.announce(d_dynamic);
+                d_chronology.announce(d_dynamic, profiler);
                 --numCycles;
             }
             else {
                 break;
             }
         }
+
+        NTCS_LOOPPROFILER_END();
     }
 }
 
 void Iocp::poll(ntci::Waiter waiter)
 {
+    Iocp::Result* result = static_cast<Iocp::Result*>(waiter);
+
+    NTCCFG_WARNING_UNUSED(result);
+
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
+    NTCS_LOOPPROFILER_BEGIN();
+
     // Wait for an operation to complete or a timeout.
 
     this->wait(waiter);
@@ -2569,13 +2624,15 @@ void Iocp::poll(ntci::Waiter waiter)
     bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
     while (numCycles != 0) {
         if (d_chronology.hasAnyScheduledOrDeferred()) {
-            d_chronology.announce(d_dynamic);
+            d_chronology.announce(d_dynamic, profiler);
             --numCycles;
         }
         else {
             break;
         }
     }
+
+    NTCS_LOOPPROFILER_END();
 }
 
 void Iocp::interruptOne()
@@ -47,6 +47,7 @@ BSLS_IDENT_RCSID(ntco_ioring_cpp, "$Id$ $CSID$")
 #include <ntcp_streamsocket.h>
 
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
 
 #include <ntci_log.h>
 #include <ntci_mutex.h>
@@ -56,6 +57,7 @@ BSLS_IDENT_RCSID(ntco_ioring_cpp, "$Id$ $CSID$")
 #include <ntcs_datapool.h>
 #include <ntcs_driver.h>
 #include <ntcs_event.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_nomenclature.h>
 #include <ntcs_proactordetachcontext.h>
 #include <ntcs_proactormetrics.h>
@@ -589,6 +591,8 @@ struct IoRingWaiter {
   public:
     ntca::WaiterOptions                    d_options;
     bsl::shared_ptr<ntci::ProactorMetrics> d_metrics_sp;
+    bsl::shared_ptr<ntcs::LoopProfiler>    d_profiler_sp;
+    bsl::shared_ptr<ntcs::StallDetector>   d_stallDetector_sp;
     struct __kernel_timespec               d_ts;
 
   private:
@@ -1859,6 +1863,8 @@ bsl::ostream& operator<<(bsl::ostream& stream, const IoRingProbe& object)
 IoRingWaiter::IoRingWaiter(bslma::Allocator* basicAllocator)
 : d_options(basicAllocator)
 , d_metrics_sp()
+, d_profiler_sp()
+, d_stallDetector_sp()
 , d_ts()
 {
 }
@@ -4972,10 +4978,14 @@ void IoRing::flush()
 
 void IoRing::wait(ntci::Waiter waiter)
 {
-    NTCCFG_WARNING_UNUSED(waiter);
-
     NTCI_LOG_CONTEXT();
 
+    IoRingWaiter* result = static_cast<IoRingWaiter*>(waiter);
+
+    NTCCFG_WARNING_UNUSED(result);
+
+    NTCS_LOOPPROFILER_GET();
+
     ntsa::Error error;
 
     if (NTCCFG_UNLIKELY(d_config.maxThreads().value() > 1)) {
@@ -5006,6 +5016,8 @@ void IoRing::wait(ntci::Waiter waiter)
                                            1,
                                            earliestTimerDue);
 
+    NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
     if (NTCCFG_UNLIKELY(d_config.maxThreads().value() > 1)) {
         d_semaphore.post();
     }
@@ -5019,6 +5031,8 @@ void IoRing::wait(ntci::Waiter waiter)
             continue;
         }
 
+        NTCS_LOOPPROFILER_EVENT();
+
         bslma::ManagedPtr<ntcs::Event> event(entry.event(), &d_eventPool);
 
         ntsa::Error eventError;
@@ -5514,6 +5528,21 @@ ntci::Waiter IoRing::registerWaiter(const ntca::WaiterOptions& waiterOptions)
             }
         }
 
+        ntcs::LoopProfilerUtil::createProfiler(
+            &result->d_profiler_sp,
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
+        ntcs::StallDetectorUtil::createStallDetector(
+            &result->d_stallDetector_sp,
+            d_config.stallThreshold(),
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
         d_waiterSet.insert(result);
     }
 
@@ -5554,6 +5583,10 @@ void IoRing::deregisterWaiter(ntci::Waiter waiter)
         }
     }
 
+    ntcs::LoopProfilerUtil::destroyProfiler(result->d_profiler_sp);
+
+    ntcs::StallDetectorUtil::destroyStallDetector(result->d_stallDetector_sp);
+
     d_allocator_p->deleteObject(result);
 }
 
@@ -6054,7 +6087,17 @@ void IoRing::decrementLoad(const ntca::LoadBalancingOptions& options)
 
 void IoRing::run(ntci::Waiter waiter)
 {
+    IoRingWaiter* result = static_cast<IoRingWaiter*>(waiter);
+
+    NTCCFG_WARNING_UNUSED(result);
+
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
     while (d_run) {
+        NTCS_LOOPPROFILER_BEGIN();
+
         // Wait for an operation to complete or a timeout.
 
         this->wait(waiter);
@@ -6065,18 +6108,30 @@ void IoRing::run(ntci::Waiter waiter)
         bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
         while (numCycles != 0) {
             if (d_chronology.hasAnyScheduledOrDeferred()) {
-                d_chronology.announce(d_dynamic);
+                d_chronology.announce(d_dynamic, profiler);
                 --numCycles;
             }
             else {
                 break;
             }
         }
+
+        NTCS_LOOPPROFILER_END();
     }
 }
 
 void IoRing::poll(ntci::Waiter waiter)
 {
+    IoRingWaiter* result = static_cast<IoRingWaiter*>(waiter);
+
+    NTCCFG_WARNING_UNUSED(result);
+
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
+    NTCS_LOOPPROFILER_BEGIN();
+
     // Wait for an operation to complete or a timeout.
 
     this->wait(waiter);
@@ -6087,13 +6142,15 @@ void IoRing::poll(ntci::Waiter waiter)
     bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
     while (numCycles != 0) {
         if (d_chronology.hasAnyScheduledOrDeferred()) {
-            d_chronology.announce(d_dynamic);
+            d_chronology.announce(d_dynamic, profiler);
             --numCycles;
         }
         else {
             break;
         }
     }
+
+    NTCS_LOOPPROFILER_END();
 }
 
 void IoRing::interruptOne()
@@ -26,6 +26,7 @@ BSLS_IDENT_RCSID(ntco_kqueue_cpp, "$Id$ $CSID$")
 #include <ntcr_streamsocket.h>
 
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
 
 #include <ntci_log.h>
 #include <ntci_mutex.h>
@@ -35,6 +36,7 @@ BSLS_IDENT_RCSID(ntco_kqueue_cpp, "$Id$ $CSID$")
 #include <ntcs_controller.h>
 #include <ntcs_datapool.h>
 #include <ntcs_driver.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_nomenclature.h>
 #include <ntcs_reactormetrics.h>
 #include <ntcs_registry.h>
@@ -673,6 +675,8 @@ struct Kqueue::Result {
   public:
     ntca::WaiterOptions                   d_options;
     bsl::shared_ptr<ntci::ReactorMetrics> d_metrics_sp;
+    bsl::shared_ptr<ntcs::LoopProfiler>   d_profiler_sp;
+    bsl::shared_ptr<ntcs::StallDetector>  d_stallDetector_sp;
 
   private:
     Result(const Result&) BSLS_KEYWORD_DELETED;
@@ -691,6 +695,8 @@ struct Kqueue::Result {
 Kqueue::Result::Result(bslma::Allocator* basicAllocator)
 : d_options(basicAllocator)
 , d_metrics_sp()
+, d_profiler_sp()
+, d_stallDetector_sp()
 {
 }
 
@@ -1314,6 +1320,21 @@ ntci::Waiter Kqueue::registerWaiter(const ntca::WaiterOptions& waiterOptions)
             }
         }
 
+        ntcs::LoopProfilerUtil::createProfiler(
+            &result->d_profiler_sp,
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
+        ntcs::StallDetectorUtil::createStallDetector(
+            &result->d_stallDetector_sp,
+            d_config.stallThreshold(),
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
         d_waiterSet.insert(result);
     }
 
@@ -1354,6 +1375,10 @@ void Kqueue::deregisterWaiter(ntci::Waiter waiter)
         }
     }
 
+    ntcs::LoopProfilerUtil::destroyProfiler(result->d_profiler_sp);
+
+    ntcs::StallDetectorUtil::destroyStallDetector(result->d_stallDetector_sp);
+
     d_allocator_p->deleteObject(result);
 }
 
@@ -1977,8 +2002,13 @@ void Kqueue::run(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
 
     while (d_run) {
+        NTCS_LOOPPROFILER_BEGIN();
+
         enum { MAX_EVENTS = 128 };
         struct ::kevent results[MAX_EVENTS];
 
@@ -2018,6 +2048,8 @@ void Kqueue::run(ntci::Waiter waiter)
             rc = ::kevent(d_kqueue, 0, 0, results, MAX_EVENTS, tsPtr);
         }
 
+        NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
         if (NTCCFG_LIKELY(rc > 0)) {
             NTCO_KQUEUE_LOG_WAIT_RESULT(rc);
 
@@ -2043,6 +2075,8 @@ void Kqueue::run(ntci::Waiter waiter)
                     continue;
                 }
 
+                NTCS_LOOPPROFILER_EVENT();
+
                 BSLS_ASSERT(entry->handle() == descriptorHandle);
 
                 NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(descriptorHandle);
@@ -2168,13 +2202,15 @@ void Kqueue::run(ntci::Waiter waiter)
         bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
         while (numCycles != 0) {
             if (d_chronology.hasAnyScheduledOrDeferred()) {
-                d_chronology.announce(d_dynamic);
+                d_chronology.announce(d_dynamic, profiler);
                 --numCycles;
             }
             else {
                 break;
             }
         }
+
+        NTCS_LOOPPROFILER_END();
     }
 }
 
@@ -2190,6 +2226,11 @@ void Kqueue::poll(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
+    NTCS_LOOPPROFILER_BEGIN();
 
     enum { MAX_EVENTS = 128 };
     struct ::kevent results[MAX_EVENTS];
@@ -2230,6 +2271,8 @@ void Kqueue::poll(ntci::Waiter waiter)
         rc = ::kevent(d_kqueue, 0, 0, results, MAX_EVENTS, tsPtr);
     }
 
+    NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
     if (NTCCFG_LIKELY(rc > 0)) {
         NTCO_KQUEUE_LOG_WAIT_RESULT(rc);
 
@@ -2254,6 +2297,8 @@ void Kqueue::poll(ntci::Waiter waiter)
                 continue;
             }
 
+            NTCS_LOOPPROFILER_EVENT();
+
             BSLS_ASSERT(entry->handle() == descriptorHandle);
 
             NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(descriptorHandle);
@@ -2378,13 +2423,15 @@ void Kqueue::poll(ntci::Waiter waiter)
     bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
     while (numCycles != 0) {
         if (d_chronology.hasAnyScheduledOrDeferred()) {
-            d_chronology.announce(d_dynamic);
+            d_chronology.announce(d_dynamic, profiler);
             --numCycles;
         }
         else {
             break;
         }
     }
+
+    NTCS_LOOPPROFILER_END();
 }
 
 void Kqueue::interruptOne()
@@ -25,6 +25,7 @@ BSLS_IDENT_RCSID(ntco_poll_cpp, "$Id$ $CSID$")
 #include <ntcr_streamsocket.h>
 
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
 
 #include <ntci_log.h>
 #include <ntci_mutex.h>
@@ -34,6 +35,7 @@ BSLS_IDENT_RCSID(ntco_poll_cpp, "$Id$ $CSID$")
 #include <ntcs_controller.h>
 #include <ntcs_datapool.h>
 #include <ntcs_driver.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_nomenclature.h>
 #include <ntcs_reactormetrics.h>
 #include <ntcs_registry.h>
@@ -687,6 +689,8 @@ struct Poll::Result {
 
     ntca::WaiterOptions                         d_options;
     bsl::shared_ptr<ntci::ReactorMetrics>       d_metrics_sp;
+    bsl::shared_ptr<ntcs::LoopProfiler>         d_profiler_sp;
+    bsl::shared_ptr<ntcs::StallDetector>        d_stallDetector_sp;
     bsls::AtomicUint64                          d_generation;
     DescriptorList                              d_descriptorList;
     ntcs::RegistryEntryCatalog::ForEachCallback d_forEachCallback;
@@ -710,6 +714,8 @@ struct Poll::Result {
 Poll::Result::Result(bslma::Allocator* basicAllocator)
 : d_options(basicAllocator)
 , d_metrics_sp()
+, d_profiler_sp()
+, d_stallDetector_sp()
 , d_generation(0)
 , d_descriptorList(basicAllocator)
 , d_forEachCallback(NTCCFG_FUNCTION_INIT(basicAllocator))
@@ -1203,6 +1209,21 @@ ntci::Waiter Poll::registerWaiter(const ntca::WaiterOptions& waiterOptions)
             }
         }
 
+        ntcs::LoopProfilerUtil::createProfiler(
+            &result->d_profiler_sp,
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
+        ntcs::StallDetectorUtil::createStallDetector(
+            &result->d_stallDetector_sp,
+            d_config.stallThreshold(),
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
         d_waiterSet.insert(result);
     }
 
@@ -1243,6 +1264,10 @@ void Poll::deregisterWaiter(ntci::Waiter waiter)
         }
     }
 
+    ntcs::LoopProfilerUtil::destroyProfiler(result->d_profiler_sp);
+
+    ntcs::StallDetectorUtil::destroyStallDetector(result->d_stallDetector_sp);
+
     d_allocator_p->deleteObject(result);
 }
 
@@ -2005,8 +2030,13 @@ void Poll::run(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
 
     while (d_run) {
+        NTCS_LOOPPROFILER_BEGIN();
+
         if (d_config.maxThreads().value() > 1) {
             d_generationSemaphore.wait();
         }
@@ -2095,6 +2125,8 @@ void Poll::run(ntci::Waiter waiter)
 #error Not implemented
 #endif
 
+        NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
         if (rc > 0 && d_config.oneShot().value()) {
             const int numResults          = rc;
             int       numResultsRemaining = numResults;
@@ -2226,6 +2258,8 @@ void Poll::run(ntci::Waiter waiter)
                     continue;
                 }
 
+                NTCS_LOOPPROFILER_EVENT();
+
                 ntsa::Handle descriptorHandle = entry->handle();
 
                 bool fatalSocketError = false;
@@ -2386,13 +2420,15 @@ void Poll::run(ntci::Waiter waiter)
         bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
         while (numCycles != 0) {
             if (d_chronology.hasAnyScheduledOrDeferred()) {
-                d_chronology.announce(d_dynamic);
+                d_chronology.announce(d_dynamic, profiler);
                 --numCycles;
             }
             else {
                 break;
             }
         }
+
+        NTCS_LOOPPROFILER_END();
     }
 }
 
@@ -2408,6 +2444,11 @@ void Poll::poll(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
+    NTCS_LOOPPROFILER_BEGIN();
 
     if (d_config.maxThreads().value() > 1) {
         d_generationSemaphore.wait();
@@ -2490,6 +2531,8 @@ void Poll::poll(ntci::Waiter waiter)
 #error Not implemented
 #endif
 
+    NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
     if (rc > 0 && d_config.oneShot().value()) {
         const int numResults          = rc;
         int       numResultsRemaining = numResults;
@@ -2617,6 +2660,8 @@ void Poll::poll(ntci::Waiter waiter)
                 continue;
             }
 
+            NTCS_LOOPPROFILER_EVENT();
+
             ntsa::Handle descriptorHandle = entry->handle();
 
             bool fatalSocketError = false;
@@ -2776,13 +2821,15 @@ void Poll::poll(ntci::Waiter waiter)
     bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
     while (numCycles != 0) {
         if (d_chronology.hasAnyScheduledOrDeferred()) {
-            d_chronology.announce(d_dynamic);
+            d_chronology.announce(d_dynamic, profiler);
             --numCycles;
         }
         else {
             break;
         }
     }
+
+    NTCS_LOOPPROFILER_END();
 }
 
 void Poll::interruptOne()
@@ -26,6 +26,7 @@ BSLS_IDENT_RCSID(ntco_pollset_cpp, "$Id$ $CSID$")
 #include <ntcr_streamsocket.h>
 
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
 
 #include <ntci_log.h>
 #include <ntci_mutex.h>
@@ -35,6 +36,7 @@ BSLS_IDENT_RCSID(ntco_pollset_cpp, "$Id$ $CSID$")
 #include <ntcs_controller.h>
 #include <ntcs_datapool.h>
 #include <ntcs_driver.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_nomenclature.h>
 #include <ntcs_reactormetrics.h>
 #include <ntcs_registry.h>
@@ -675,6 +677,8 @@ struct Pollset::Result {
   public:
     ntca::WaiterOptions                   d_options;
     bsl::shared_ptr<ntci::ReactorMetrics> d_metrics_sp;
+    bsl::shared_ptr<ntcs::LoopProfiler>   d_profiler_sp;
+    bsl::shared_ptr<ntcs::StallDetector>  d_stallDetector_sp;
 
   private:
     Result(const Result&) BSLS_KEYWORD_DELETED;
@@ -693,6 +697,8 @@ struct Pollset::Result {
 Pollset::Result::Result(bslma::Allocator* basicAllocator)
 : d_options(basicAllocator)
 , d_metrics_sp()
+, d_profiler_sp()
+, d_stallDetector_sp()
 {
 }
 
@@ -1269,6 +1275,21 @@ ntci::Waiter Pollset::registerWaiter(const ntca::WaiterOptions& waiterOptions)
             }
         }
 
+        ntcs::LoopProfilerUtil::createProfiler(
+            &result->d_profiler_sp,
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
+        ntcs::StallDetectorUtil::createStallDetector(
+            &result->d_stallDetector_sp,
+            d_config.stallThreshold(),
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
         d_waiterSet.insert(result);
     }
 
@@ -1309,6 +1330,10 @@ void Pollset::deregisterWaiter(ntci::Waiter waiter)
         }
     }
 
+    ntcs::LoopProfilerUtil::destroyProfiler(result->d_profiler_sp);
+
+    ntcs::StallDetectorUtil::destroyStallDetector(result->d_stallDetector_sp);
+
     d_allocator_p->deleteObject(result);
 }
 
@@ -1933,8 +1958,13 @@ void Pollset::run(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
 
     while (d_run) {
+        NTCS_LOOPPROFILER_BEGIN();
+
         if (d_config.maxThreads().value() > 1) {
             d_generationSemaphore.wait();
         }
@@ -2021,6 +2051,7 @@ void Pollset::run(ntci::Waiter waiter)
         }
 
         rc = ::pollset_poll(d_pollset, results, MAX_EVENTS, wait);
+        NTCS_LOOPPROFILER_ENTER_DISPATCH();
 
         if (rc > 0 && d_config.oneShot().value()) {
             const int numResults = rc;
@@ -2133,6 +2164,8 @@ void Pollset::run(ntci::Waiter waiter)
                     continue;
                 }
 
+                NTCS_LOOPPROFILER_EVENT();
+
                 ntsa::Handle descriptorHandle = entry->handle();
 
                 if (NTCCFG_UNLIKELY(((e.revents & POLLERR) != 0) ||
@@ -2244,13 +2277,15 @@ void Pollset::run(ntci::Waiter waiter)
         bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
         while (numCycles != 0) {
             if (d_chronology.hasAnyScheduledOrDeferred()) {
-                d_chronology.announce(d_dynamic);
+                d_chronology.announce(d_dynamic, profiler);
                 --numCycles;
             }
             else {
                 break;
             }
         }
+
+        NTCS_LOOPPROFILER_END();
     }
 }
 
@@ -2266,6 +2301,11 @@ void Pollset::poll(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
+    NTCS_LOOPPROFILER_BEGIN();
 
     if (d_config.maxThreads().value() > 1) {
         d_generationSemaphore.wait();
@@ -2354,6 +2394,7 @@ void Pollset::poll(ntci::Waiter waiter)
     }
 
     rc = ::pollset_poll(d_pollset, results, MAX_EVENTS, wait);
+    NTCS_LOOPPROFILER_ENTER_DISPATCH();
 
     if (rc > 0 && d_config.oneShot().value()) {
         const int numResults = rc;
@@ -2465,6 +2506,8 @@ void Pollset::poll(ntci::Waiter waiter)
                 continue;
             }
 
+            NTCS_LOOPPROFILER_EVENT();
+
             ntsa::Handle descriptorHandle = entry->handle();
 
             if (NTCCFG_UNLIKELY(((e.revents & POLLERR) != 0) ||
@@ -2575,13 +2618,15 @@ void Pollset::poll(ntci::Waiter waiter)
     bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
     while (numCycles != 0) {
         if (d_chronology.hasAnyScheduledOrDeferred()) {
-            d_chronology.announce(d_dynamic);
+            d_chronology.announce(d_dynamic, profiler);
             --numCycles;
         }
         else {
             break;
         }
     }
+
+    NTCS_LOOPPROFILER_END();
 }
 
 void Pollset::interruptOne()
@@ -77,6 +77,7 @@ BSLS_IDENT_RCSID(ntco_select_cpp, "$Id$ $CSID$")
 #include <ntcr_streamsocket.h>
 
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
 
 #include <ntci_log.h>
 #include <ntci_mutex.h>
@@ -86,6 +87,7 @@ BSLS_IDENT_RCSID(ntco_select_cpp, "$Id$ $CSID$")
 #include <ntcs_controller.h>
 #include <ntcs_datapool.h>
 #include <ntcs_driver.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_nomenclature.h>
 #include <ntcs_reactormetrics.h>
 #include <ntcs_registry.h>
@@ -666,6 +668,8 @@ struct Select::Result {
   public:
     ntca::WaiterOptions                   d_options;
     bsl::shared_ptr<ntci::ReactorMetrics> d_metrics_sp;
+    bsl::shared_ptr<ntcs::LoopProfiler>   d_profiler_sp;
+    bsl::shared_ptr<ntcs::StallDetector>  d_stallDetector_sp;
     fd_set                                d_readable;
     fd_set                                d_writable;
     fd_set                                d_exceptional;
@@ -687,6 +691,8 @@ struct Select::Result {
 Select::Result::Result(bslma::Allocator* basicAllocator)
 : d_options(basicAllocator)
 , d_metrics_sp()
+, d_profiler_sp()
+, d_stallDetector_sp()
 {
 }
 
@@ -1242,6 +1248,21 @@ ntci::Waiter Select::registerWaiter(const ntca::WaiterOptions& waiterOptions)
             }
         }
 
+        ntcs::LoopProfilerUtil::createProfiler(
+            &result->d_profiler_sp,
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
+        ntcs::StallDetectorUtil::createStallDetector(
+            &result->d_stallDetector_sp,
+            d_config.stallThreshold(),
+            result->d_options.metricName(),
+            d_config.metricName().value(),
+            d_waiterSet.size(),
+            d_allocator_p);
+
         d_waiterSet.insert(result);
     }
 
@@ -1282,6 +1303,10 @@ void Select::deregisterWaiter(ntci::Waiter waiter)
         }
     }
 
+    ntcs::LoopProfilerUtil::destroyProfiler(result->d_profiler_sp);
+
+    ntcs::StallDetectorUtil::destroyStallDetector(result->d_stallDetector_sp);
+
     d_allocator_p->deleteObject(result);
 }
 
@@ -1907,8 +1932,13 @@ void Select::run(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
 
     while (d_run) {
+        NTCS_LOOPPROFILER_BEGIN();
+
         if (d_config.maxThreads().value() > 1) {
             d_generationSemaphore.wait();
         }
@@ -1978,6 +2008,8 @@ void Select::run(ntci::Waiter waiter)
                           timeout >= 0 ? &timeval : 0);
         }
 
+        NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
 #elif defined(BSLS_PLATFORM_OS_WINDOWS)
 
         struct ::timeval timeval;
@@ -2007,6 +2039,8 @@ void Select::run(ntci::Waiter waiter)
                           timeout >= 0 ? &timeval : 0);
         }
 
+        NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
 #else
 #error Not implemented
 #endif
@@ -2197,6 +2231,8 @@ void Select::run(ntci::Waiter waiter)
                     continue;
                 }
 
+                NTCS_LOOPPROFILER_EVENT();
+
                 if (NTCCFG_UNLIKELY(isError)) {
                     ntsa::Error lastError;
                     ntsa::Error error =
@@ -2335,13 +2371,15 @@ void Select::run(ntci::Waiter waiter)
         bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
         while (numCycles != 0) {
             if (d_chronology.hasAnyScheduledOrDeferred()) {
-                d_chronology.announce(d_dynamic);
+                d_chronology.announce(d_dynamic, profiler);
                 --numCycles;
             }
             else {
                 break;
             }
         }
+
+        NTCS_LOOPPROFILER_END();
     }
 }
 
@@ -2357,6 +2395,11 @@ void Select::poll(ntci::Waiter waiter)
     NTCCFG_WARNING_UNUSED(result);
 
     NTCS_METRICS_GET();
+    NTCS_LOOPPROFILER_GET();
+
+    ntcs::StallDetectorScope stallScope(result->d_stallDetector_sp.get());
+
+    NTCS_LOOPPROFILER_BEGIN();
 
     if (d_config.maxThreads().value() > 1) {
         d_generationSemaphore.wait();
@@ -2428,6 +2471,8 @@ void Select::poll(ntci::Waiter waiter)
                       timeout >= 0 ? &timeval : 0);
     }
 
+    NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
 #elif defined(BSLS_PLATFORM_OS_WINDOWS)
 
     struct ::timeval timeval;
@@ -2457,6 +2502,8 @@ void Select::poll(ntci::Waiter waiter)
                       timeout >= 0 ? &timeval : 0);
     }
 
+    NTCS_LOOPPROFILER_ENTER_DISPATCH();
+
 #else
 #error Not implemented
 #endif
@@ -2641,6 +2688,8 @@ void Select::poll(ntci::Waiter waiter)
                 continue;
             }
 
+            NTCS_LOOPPROFILER_EVENT();
+
             if (NTCCFG_UNLIKELY(isError)) {
                 ntsa::Error lastError;
                 ntsa::Error error =
@@ -2778,13 +2827,15 @@ void Select::poll(ntci::Waiter waiter)
     bsl::size_t numCycles = d_config.maxCyclesPerWait().value();
     while (numCycles != 0) {
         if (d_chronology.hasAnyScheduledOrDeferred()) {
-            d_chronology.announce(d_dynamic);
+            d_chronology.announce(d_dynamic, profiler);
             --numCycles;
         }
         else {
             break;
         }
     }
+
+    NTCS_LOOPPROFILER_END();
 }
 
 void Select::interruptOne()
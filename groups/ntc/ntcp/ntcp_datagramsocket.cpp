@@ -28,6 +28,8 @@ BSLS_IDENT_RCSID(ntcp_datagramsocket_cpp, "$Id$ $CSID$")
 #include <ntcs_dispatch.h>
 #include <ntcs_monitorable.h>
 #include <ntcs_plugin.h>
+#include <ntcs_stalldetector.h>
+#include <ntcs_tracer.h>
 #include <ntcu_datagramsocketsession.h>
 #include <ntcu_datagramsocketutil.h>
 #include <ntsa_receivecontext.h>
@@ -174,6 +176,8 @@ void DatagramSocket::processSocketReceived(const ntsa::Error&          error,
 
     NTCCFG_OBJECT_GUARD(&d_object);
 
+    NTCS_TRACE_SCOPE(e_RECEIVED, d_publicHandle, context.bytesReceived());
+
     bsl::shared_ptr<DatagramSocket> self = this->getSelf(this);
 
     LockGuard lock(&d_mutex);
@@ -227,6 +231,8 @@ void DatagramSocket::processSocketSent(const ntsa::Error&       error,
 
     NTCCFG_OBJECT_GUARD(&d_object);
 
+    NTCS_TRACE_SCOPE(e_SENT, d_publicHandle, context.bytesSent());
+
     bsl::shared_ptr<DatagramSocket> self = this->getSelf(this);
 
     LockGuard lock(&d_mutex);
@@ -2288,21 +2294,8 @@ DatagramSocket::DatagramSocket(
     }
 
     if (!d_options.metrics().isNull() && d_options.metrics().value()) {
-        ntsa::Guid guid = ntsa::Guid::generate();
-        char       guidText[ntsa::Guid::SIZE_TEXT];
-        guid.writeText(guidText);
-
-        bsl::string monitorableObjectName;
-        {
-            bsl::stringstream ss;
-            ss << "socket-";
-            ss.write(guidText, ntsa::Guid::SIZE_TEXT);
-            monitorableObjectName = ss.str();
-        }
-
         d_metrics_sp.createInplace(d_allocator_p,
                                    "socket",
-                                   monitorableObjectName,
                                    metrics,
                                    d_allocator_p);
 
@@ -2695,6 +2688,10 @@ ntsa::Error DatagramSocket::send(const bdlbb::Blob&        data,
     NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
     NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
 
+    NTCS_TRACE_EVENT(e_SEND_ENQUEUE,
+                     d_publicHandle,
+                     NTCCFG_WARNING_PROMOTE(bsl::size_t, data.length()));
+
     if (NTCCFG_UNLIKELY(NTCCFG_WARNING_PROMOTE(bsl::size_t, data.length()) >
                         d_maxDatagramSize))
     {
@@ -2869,6 +2866,8 @@ ntsa::Error DatagramSocket::send(const ntsa::Data&         data,
     NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
     NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
 
+    NTCS_TRACE_EVENT(e_SEND_ENQUEUE, d_publicHandle, data.size());
+
     if (NTCCFG_UNLIKELY(data.size() > d_maxDatagramSize)) {
         return ntsa::Error::invalid();
     }
@@ -3096,8 +3095,10 @@ ntsa::Error DatagramSocket::receive(ntca::ReceiveContext*       context,
 ntsa::Error DatagramSocket::receive(const ntca::ReceiveOptions&  options,
                                     const ntci::ReceiveFunction& callback)
 {
-    return this->receive(options,
-                         this->createReceiveCallback(callback, d_allocator_p));
+    return this->receive(
+        options,
+        this->createReceiveCallback(callback,
+                                    d_receiveQueue.callbackAllocator()));
 }
 
 ntsa::Error DatagramSocket::receive(const ntca::ReceiveOptions&  options,
@@ -3967,16 +3968,27 @@ void DatagramSocket::close(const ntci::CloseCallback& callback)
 
 void DatagramSocket::execute(const Functor& functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ProactorSocket> self(this->weak_from_this());
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_proactorStrand_sp) {
-        d_proactorStrand_sp->execute(functor);
+        d_proactorStrand_sp->execute(target);
     }
     else {
         ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
         if (proactorRef) {
-            proactorRef->execute(functor);
+            proactorRef->execute(target);
         }
         else {
-            ntcs::Async::execute(functor);
+            ntcs::Async::execute(target);
         }
     }
 }
@@ -3984,16 +3996,28 @@ void DatagramSocket::execute(const Functor& functor)
 void DatagramSocket::moveAndExecute(FunctorSequence* functorSequence,
                                     const Functor&   functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ProactorSocket> self(this->weak_from_this());
+        ntcs::StallDetectorUtil::attribute(functorSequence, self);
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_proactorStrand_sp) {
-        d_proactorStrand_sp->moveAndExecute(functorSequence, functor);
+        d_proactorStrand_sp->moveAndExecute(functorSequence, target);
     }
     else {
         ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
         if (proactorRef) {
-            proactorRef->moveAndExecute(functorSequence, functor);
+            proactorRef->moveAndExecute(functorSequence, target);
         }
         else {
-            ntcs::Async::moveAndExecute(functorSequence, functor);
+            ntcs::Async::moveAndExecute(functorSequence, target);
         }
     }
 }
@@ -4030,12 +4054,20 @@ bsl::shared_ptr<ntci::Timer> DatagramSocket::createTimer(
     const ntci::TimerCallback& callback,
     bslma::Allocator*          basicAllocator)
 {
+    ntci::TimerCallback attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ProactorSocket> self(this->weak_from_this());
+        attributed = ntcs::StallDetectorUtil::attribute(callback, self);
+    }
+
+    const ntci::TimerCallback& target = attributed ? attributed : callback;
+
     ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
     if (proactorRef) {
-        return proactorRef->createTimer(options, callback, basicAllocator);
+        return proactorRef->createTimer(options, target, basicAllocator);
     }
     else {
-        return ntcs::Async::createTimer(options, callback, basicAllocator);
+        return ntcs::Async::createTimer(options, target, basicAllocator);
     }
 }
 
@@ -4275,5 +4307,16 @@ void DatagramSocket::getInfo(ntsa::SocketInfo* result) const
     result->setReceiveQueueSize(receiveQueueSize);
 }
 
+bsl::string DatagramSocket::metricsName() const
+{
+    if (!d_options.metrics().isNull() && d_options.metrics().value() &&
+        d_metrics_sp)
+    {
+        return bsl::string(d_metrics_sp->objectName());
+    }
+
+    return bsl::string();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
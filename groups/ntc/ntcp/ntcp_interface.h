@@ -23,10 +23,13 @@ BSLS_IDENT("$Id: $")
 #include <ntccfg_platform.h>
 #include <ntci_interface.h>
 #include <ntci_proactorfactory.h>
+#include <ntcp_streamsocket.h>
 #include <ntcs_chronology.h>
 #include <ntcs_metrics.h>
+#include <ntcs_recyclingallocator.h>
 #include <ntcs_proactormetrics.h>
 #include <ntcs_reservation.h>
+#include <ntcs_socketpool.h>
 #include <ntcs_user.h>
 #include <ntcscm_version.h>
 #include <ntsa_endpoint.h>
@@ -96,6 +99,9 @@ class Interface : public ntci::Interface,
     /// Define a type alias for a mutex lock guard.
     typedef ntccfg::LockGuard LockGuard;
 
+    /// Define a type alias for a pool of closed stream sockets.
+    typedef ntcs::SocketPool<ntcp::StreamSocket> StreamSocketPool;
+
     ntccfg::Object                         d_object;
     mutable Mutex                          d_mutex;
     bsl::shared_ptr<ntcs::User>            d_user_sp;
@@ -103,6 +109,8 @@ class Interface : public ntci::Interface,
     bsl::shared_ptr<ntci::Resolver>        d_resolver_sp;
     bsl::shared_ptr<ntci::Reservation>     d_connectionLimiter_sp;
     bsl::shared_ptr<ntcs::Metrics>         d_socketMetrics_sp;
+    ntcs::RecyclingAllocator*              d_socketAllocator_p;
+    bsl::shared_ptr<StreamSocketPool>      d_streamSocketPool_sp;
     bsl::shared_ptr<ntcs::Chronology>      d_chronology_sp;
     bsl::shared_ptr<ntci::ProactorFactory> d_proactorFactory_sp;
     bsl::shared_ptr<ntci::ProactorMetrics> d_proactorMetrics_sp;
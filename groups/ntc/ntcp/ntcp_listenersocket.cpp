@@ -27,6 +27,8 @@ BSLS_IDENT_RCSID(ntcp_listenersocket_cpp, "$Id$ $CSID$")
 #include <ntcs_compat.h>
 #include <ntcs_dispatch.h>
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
+#include <ntcs_tracer.h>
 #include <ntcu_listenersocketsession.h>
 #include <ntcu_listenersocketutil.h>
 #include <ntsf_system.h>
@@ -148,6 +150,8 @@ void ListenerSocket::processSocketAccepted(
 {
     NTCCFG_OBJECT_GUARD(&d_object);
 
+    NTCS_TRACE_SCOPE(e_ACCEPTED, d_publicHandle, 0);
+
     bsl::shared_ptr<ListenerSocket> self = this->getSelf(this);
 
     LockGuard lock(&d_mutex);
@@ -449,13 +453,39 @@ void ListenerSocket::privateCompleteAccept(
     }
 
     bsl::shared_ptr<ntcp::StreamSocket> streamSocket;
-    streamSocket.createInplace(d_allocator_p,
-                               streamSocketOptions,
-                               resolver,
-                               proactor,
-                               proactorPoolRef.getShared(),
-                               metrics,
-                               d_allocator_p);
+    if (d_streamSocketPool_sp) {
+        ntcp::StreamSocket* object = d_streamSocketPool_sp->acquire();
+        if (object) {
+            object->reset(streamSocketOptions,
+                          resolver,
+                          proactor,
+                          proactorPoolRef.getShared(),
+                          metrics);
+        }
+        else {
+            bslma::Allocator* allocator =
+                d_streamSocketPool_sp->objectAllocator();
+
+            object = new (*allocator) ntcp::StreamSocket(
+                streamSocketOptions,
+                resolver,
+                proactor,
+                proactorPoolRef.getShared(),
+                metrics,
+                allocator);
+        }
+
+        d_streamSocketPool_sp->manage(&streamSocket, object);
+    }
+    else {
+        streamSocket.createInplace(d_allocator_p,
+                                   streamSocketOptions,
+                                   resolver,
+                                   proactor,
+                                   proactorPoolRef.getShared(),
+                                   metrics,
+                                   d_allocator_p);
+    }
 
     error = streamSocket->registerManager(d_manager_sp);
     if (error) {
@@ -1606,6 +1636,7 @@ ListenerSocket::ListenerSocket(
 , d_incomingBufferFactory_sp(proactor->incomingBlobBufferFactory())
 , d_outgoingBufferFactory_sp(proactor->outgoingBlobBufferFactory())
 , d_metrics_sp()
+, d_streamSocketPool_sp()
 , d_flowControlState()
 , d_shutdownState()
 , d_acceptQueue(basicAllocator)
@@ -1649,21 +1680,8 @@ ListenerSocket::ListenerSocket(
     }
 
     if (!d_options.metrics().isNull() && d_options.metrics().value()) {
-        ntsa::Guid guid = ntsa::Guid::generate();
-        char       guidText[ntsa::Guid::SIZE_TEXT];
-        guid.writeText(guidText);
-
-        bsl::string monitorableObjectName;
-        {
-            bsl::stringstream ss;
-            ss << "socket-";
-            ss.write(guidText, ntsa::Guid::SIZE_TEXT);
-            monitorableObjectName = ss.str();
-        }
-
         d_metrics_sp.createInplace(d_allocator_p,
                                    "socket",
-                                   monitorableObjectName,
                                    metrics,
                                    d_allocator_p);
 
@@ -1683,6 +1701,13 @@ ListenerSocket::~ListenerSocket()
     }
 }
 
+void ListenerSocket::setStreamSocketPool(
+    const bsl::shared_ptr<StreamSocketPool>& streamSocketPool)
+{
+    LockGuard lock(&d_mutex);
+    d_streamSocketPool_sp = streamSocketPool;
+}
+
 ntsa::Error ListenerSocket::open()
 {
     bsl::shared_ptr<ListenerSocket> self = this->getSelf(this);
@@ -2531,16 +2556,27 @@ void ListenerSocket::close(const ntci::CloseCallback& callback)
 
 void ListenerSocket::execute(const Functor& functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ProactorSocket> self(this->weak_from_this());
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_proactorStrand_sp) {
-        d_proactorStrand_sp->execute(functor);
+        d_proactorStrand_sp->execute(target);
     }
     else {
         ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
         if (proactorRef) {
-            proactorRef->execute(functor);
+            proactorRef->execute(target);
         }
         else {
-            ntcs::Async::execute(functor);
+            ntcs::Async::execute(target);
         }
     }
 }
@@ -2548,16 +2584,28 @@ void ListenerSocket::execute(const Functor& functor)
 void ListenerSocket::moveAndExecute(FunctorSequence* functorSequence,
                                     const Functor&   functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ProactorSocket> self(this->weak_from_this());
+        ntcs::StallDetectorUtil::attribute(functorSequence, self);
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_proactorStrand_sp) {
-        d_proactorStrand_sp->moveAndExecute(functorSequence, functor);
+        d_proactorStrand_sp->moveAndExecute(functorSequence, target);
     }
     else {
         ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
         if (proactorRef) {
-            proactorRef->moveAndExecute(functorSequence, functor);
+            proactorRef->moveAndExecute(functorSequence, target);
         }
         else {
-            ntcs::Async::moveAndExecute(functorSequence, functor);
+            ntcs::Async::moveAndExecute(functorSequence, target);
         }
     }
 }
@@ -2594,12 +2642,20 @@ bsl::shared_ptr<ntci::Timer> ListenerSocket::createTimer(
     const ntci::TimerCallback& callback,
     bslma::Allocator*          basicAllocator)
 {
+    ntci::TimerCallback attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ProactorSocket> self(this->weak_from_this());
+        attributed = ntcs::StallDetectorUtil::attribute(callback, self);
+    }
+
+    const ntci::TimerCallback& target = attributed ? attributed : callback;
+
     ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
     if (proactorRef) {
-        return proactorRef->createTimer(options, callback, basicAllocator);
+        return proactorRef->createTimer(options, target, basicAllocator);
     }
     else {
-        return ntcs::Async::createTimer(options, callback, basicAllocator);
+        return ntcs::Async::createTimer(options, target, basicAllocator);
     }
 }
 
@@ -2773,5 +2829,16 @@ void ListenerSocket::getInfo(ntsa::SocketInfo* result) const
     result->setReceiveQueueSize(receiveQueueSize);
 }
 
+bsl::string ListenerSocket::metricsName() const
+{
+    if (!d_options.metrics().isNull() && d_options.metrics().value() &&
+        d_metrics_sp)
+    {
+        return bsl::string(d_metrics_sp->objectName());
+    }
+
+    return bsl::string();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
@@ -31,6 +31,8 @@ BSLS_IDENT_RCSID(ntcp_streamsocket_cpp, "$Id$ $CSID$")
 #include <ntcs_dispatch.h>
 #include <ntcs_monitorable.h>
 #include <ntcs_plugin.h>
+#include <ntcs_stalldetector.h>
+#include <ntcs_tracer.h>
 #include <ntcu_streamsocketsession.h>
 #include <ntcu_streamsocketutil.h>
 #include <ntsa_distinguishedname.h>
@@ -243,6 +245,8 @@ void StreamSocket::processSocketReceived(const ntsa::Error&          error,
 {
     NTCCFG_OBJECT_GUARD(&d_object);
 
+    NTCS_TRACE_SCOPE(e_RECEIVED, d_publicHandle, context.bytesReceived());
+
     bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
 
     LockGuard lock(&d_mutex);
@@ -281,6 +285,8 @@ void StreamSocket::processSocketSent(const ntsa::Error&       error,
 {
     NTCCFG_OBJECT_GUARD(&d_object);
 
+    NTCS_TRACE_SCOPE(e_SENT, d_publicHandle, context.bytesSent());
+
     bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
 
     LockGuard lock(&d_mutex);
@@ -417,6 +423,52 @@ void StreamSocket::processConnectRetryTimer(
     if (event.type() == ntca::TimerEventType::e_DEADLINE) {
         if (d_connectInProgress) {
             if (d_connectAttempts > 0) {
+                if (d_connectOptions.strategy().value_or(
+                        ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) ==
+                    ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS)
+                {
+                    // The connection attempt delay does not apply to name
+                    // resolution, nor to the last remaining attempt, which
+                    // is bounded only by the deadline, if any.
+
+                    if (!d_connectName.empty() &&
+                        !d_connectHappyEyeballs.isStarted())
+                    {
+                        return;
+                    }
+
+                    if (d_connectOptions.retryCount().valueOr(
+                            bsl::size_t(0)) == 0)
+                    {
+                        return;
+                    }
+
+                    // Race the next endpoint on an auxiliary descriptor
+                    // rather than abandoning an attempt that may merely be
+                    // slow to complete.
+
+                    if (d_openState.value() ==
+                            ntcs::OpenState::e_CONNECTING &&
+                        d_systemHandle != ntsa::k_INVALID_HANDLE &&
+                        d_detachState.mode() !=
+                            ntcs::DetachMode::e_INITIATED &&
+                        d_connectEndpointVector.size() > 1 &&
+                        d_options.sourceEndpoint().isNull())
+                    {
+                        this->privateRaceConnect(self);
+                        return;
+                    }
+
+                    // Do not resolve the name again while attempts to the
+                    // endpoints already resolved remain in progress.
+
+                    if (d_connectEndpointVector.size() <= 1 &&
+                        d_connectHappyEyeballs.numAttempts() > 0)
+                    {
+                        return;
+                    }
+                }
+
                 d_retryConnect =
                     true;  // privateRetryConnect will be called in privateFailConnectComplete
                 if (d_detachState.mode() != ntcs::DetachMode::e_INITIATED) {
@@ -434,6 +486,103 @@ void StreamSocket::processConnectRetryTimer(
     }
 }
 
+void StreamSocket::processConnectResolutionTimer(
+    const bsl::shared_ptr<ntci::Timer>& timer,
+    const ntca::TimerEvent&             event)
+{
+    NTCCFG_OBJECT_GUARD(&d_object);
+
+    bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
+
+    LockGuard lock(&d_mutex);
+
+    NTCI_LOG_CONTEXT();
+
+    NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
+
+    if (event.type() == ntca::TimerEventType::e_DEADLINE) {
+        if (d_connectResolutionTimer_sp != timer) {
+            return;
+        }
+
+        d_connectResolutionTimer_sp.reset();
+
+        if (!d_connectInProgress) {
+            return;
+        }
+
+        if (d_openState.value() != ntcs::OpenState::e_CONNECTING) {
+            return;
+        }
+
+        if (d_connectHappyEyeballs.isStarted()) {
+            return;
+        }
+
+        NTCI_LOG_TRACE("Stream socket timed out waiting for the IPv6 "
+                       "addresses of '%s'",
+                       d_connectName.c_str());
+
+        this->privateStartConnectHappyEyeballs(self);
+    }
+}
+
+void StreamSocket::processConnectAttemptTimer(
+    const bsl::shared_ptr<ntci::Timer>& timer,
+    const ntca::TimerEvent&             event)
+{
+    NTCCFG_OBJECT_GUARD(&d_object);
+
+    bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
+
+    LockGuard lock(&d_mutex);
+
+    NTCI_LOG_CONTEXT();
+
+    NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
+
+    if (event.type() == ntca::TimerEventType::e_DEADLINE) {
+        if (d_connectAttemptTimer_sp != timer) {
+            return;
+        }
+
+        if (!d_connectInProgress) {
+            return;
+        }
+
+        if (d_detachState.mode() == ntcs::DetachMode::e_INITIATED) {
+            return;
+        }
+
+        bsl::shared_ptr<ntsi::StreamSocket> streamSocket;
+        ntsa::Endpoint                      endpoint;
+
+        if (d_connectHappyEyeballs.poll(&streamSocket, &endpoint)) {
+            this->privateAdoptConnectAttempt(self, streamSocket, endpoint);
+            return;
+        }
+
+        if (d_connectHappyEyeballs.numAttempts() == 0) {
+            d_connectAttemptTimer_sp->close();
+            d_connectAttemptTimer_sp.reset();
+
+            // Every attempt has failed if the attempt on the socket's own
+            // descriptor failed while raced attempts remained.
+
+            if (d_openState.value() == ntcs::OpenState::e_WAITING &&
+                d_connectOptions.retryCount().valueOr(bsl::size_t(0)) == 0)
+            {
+                ntsa::Error error = d_connectHappyEyeballs.attemptError();
+                if (!error) {
+                    error = ntsa::Error(ntsa::Error::e_CONNECTION_REFUSED);
+                }
+
+                this->privateFailConnect(self, error, false, true);
+            }
+        }
+    }
+}
+
 void StreamSocket::processUpgradeTimer(
     const bsl::shared_ptr<ntci::Timer>& timer,
     const ntca::TimerEvent&             event)
@@ -601,6 +750,32 @@ void StreamSocket::processReceiveRateTimer(
     }
 }
 
+void StreamSocket::processTcpInfoTimer(
+    const bsl::shared_ptr<ntci::Timer>& timer,
+    const ntca::TimerEvent&             event)
+{
+    NTCCFG_WARNING_UNUSED(timer);
+
+    NTCCFG_OBJECT_GUARD(&d_object);
+
+    LockGuard lock(&d_mutex);
+
+    if (event.type() != ntca::TimerEventType::e_DEADLINE) {
+        return;
+    }
+
+    if (d_openState.value() != ntcs::OpenState::e_CONNECTED) {
+        return;
+    }
+
+    NTCS_METRICS_UPDATE_TCP_INFO(d_tcpInfoSampler, d_publicHandle);
+
+    if (!d_tcpInfoSampler.isEnabled() && d_tcpInfoTimer_sp) {
+        d_tcpInfoTimer_sp->close();
+        d_tcpInfoTimer_sp.reset();
+    }
+}
+
 void StreamSocket::processReceiveDeadlineTimer(
     const bsl::shared_ptr<ntci::Timer>&                     timer,
     const ntca::TimerEvent&                                 event,
@@ -806,11 +981,18 @@ void StreamSocket::privateCompleteConnect(
         }
     }
 
+    if (d_systemRemoteEndpoint.isIp()) {
+        d_connectContext.setIpAddressType(
+            d_systemRemoteEndpoint.ip().host().type());
+    }
+
     d_connectOptions.setRetryCount(0);
     d_connectInProgress = false;
 
     d_openState.set(ntcs::OpenState::e_CONNECTED);
 
+    this->privateTcpInfoArm(self);
+
     ntci::ConnectCallback connectCallback = d_connectCallback;
     d_connectCallback.reset();
 
@@ -831,6 +1013,13 @@ void StreamSocket::privateCompleteConnect(
         d_connectRetryTimer_sp.reset();
     }
 
+    if (d_connectAttemptTimer_sp) {
+        d_connectAttemptTimer_sp->close();
+        d_connectAttemptTimer_sp.reset();
+    }
+
+    d_connectHappyEyeballs.cancel();
+
     NTCI_LOG_TRACE("Connection attempt succeeded");
 
     if (d_session_sp) {
@@ -896,7 +1085,8 @@ void StreamSocket::privateFailConnect(
 
         d_connectContext.setError(error);
         d_connectContext.setAttemptsRemaining(
-            d_connectOptions.retryCount().valueOr(bsl::size_t(0)));
+            d_connectOptions.retryCount().valueOr(bsl::size_t(0)) +
+            (close ? 0 : d_connectHappyEyeballs.numAttempts()));
 
         if (d_connectContext.name().isNull()) {
             if (!d_connectName.empty()) {
@@ -917,7 +1107,12 @@ void StreamSocket::privateFailConnect(
         connectEvent.setType(ntca::ConnectEventType::e_ERROR);
         connectEvent.setContext(connectContext);
 
-        if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) == 0) {
+        // Keep waiting for the attempts raced on auxiliary descriptors, if
+        // any, unless the connection is being abandoned.
+
+        if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) == 0 &&
+            (close || d_connectHappyEyeballs.numAttempts() == 0))
+        {
             d_openState.set(ntcs::OpenState::e_CLOSED);
             d_connectInProgress = false;
 
@@ -934,6 +1129,18 @@ void StreamSocket::privateFailConnect(
                 d_connectRetryTimer_sp.reset();
             }
 
+            if (d_connectResolutionTimer_sp) {
+                d_connectResolutionTimer_sp->close();
+                d_connectResolutionTimer_sp.reset();
+            }
+
+            if (d_connectAttemptTimer_sp) {
+                d_connectAttemptTimer_sp->close();
+                d_connectAttemptTimer_sp.reset();
+            }
+
+            d_connectHappyEyeballs.cancel();
+
             d_flowControlState.close();
             d_shutdownState.close();
 
@@ -968,6 +1175,18 @@ void StreamSocket::privateFailConnect(
             }
         }
         else {
+            if (d_connectOptions.strategy().value_or(
+                    ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) ==
+                    ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS &&
+                d_connectEndpointVector.size() > 1 &&
+                d_connectOptions.retryCount().valueOr(bsl::size_t(0)) > 0)
+            {
+                // Try the next endpoint immediately rather than waiting
+                // for the connection attempt delay to elapse.
+
+                d_retryConnect = true;
+            }
+
             if (d_systemHandle != ntsa::k_INVALID_HANDLE) {
                 ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
                 if (proactorRef) {
@@ -1058,7 +1277,9 @@ void StreamSocket::privateFailConnectComplete(
                                  &d_mutex);
     }
 
-    if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) == 0) {
+    if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) == 0 &&
+        d_connectHappyEyeballs.numAttempts() == 0)
+    {
         d_resolver.reset();
 
         d_sendDeflater_sp.reset();
@@ -1232,6 +1453,8 @@ void StreamSocket::privateCompleteReceive(
         d_receiveRateLimiter_sp->submit(numBytesReceived);
     }
 
+    NTCS_METRICS_UPDATE_TCP_INFO(d_tcpInfoSampler, d_publicHandle);
+
     BSLS_ASSERT(
         NTCCFG_WARNING_PROMOTE(bsl::size_t, d_receiveBlob_sp->length()) ==
         numBytesReceived);
@@ -1728,6 +1951,8 @@ void StreamSocket::privateCompleteSend(
         d_sendRateLimiter_sp->submit(numBytesSent);
     }
 
+    NTCS_METRICS_UPDATE_TCP_INFO(d_tcpInfoSampler, d_publicHandle);
+
     if (!d_sendQueue.hasEntry()) {
         return;
     }
@@ -2330,6 +2555,11 @@ void StreamSocket::privateShutdownSequenceComplete(
         // Note that detachment from the proactor is handled earlier in this
         // function.
 
+        if (d_tcpInfoTimer_sp) {
+            d_tcpInfoTimer_sp->close();
+            d_tcpInfoTimer_sp.reset();
+        }
+
         ntcs::ObserverRef<ntci::ProactorPool> proactorPoolRef(&d_proactorPool);
         if (proactorPoolRef) {
             ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
@@ -3256,6 +3486,8 @@ ntsa::Error StreamSocket::privateOpen(
     d_socket_sp            = streamSocket;
     d_acceptor_sp          = acceptor;
 
+    d_tcpInfoSampler.reset();
+
     NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
     NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
     NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
@@ -3265,9 +3497,14 @@ ntsa::Error StreamSocket::privateOpen(
 
     proactorRef->attachSocket(self);
 
-    if (!d_systemRemoteEndpoint.isUndefined()) {
+    // A descriptor adopted from a connection attempt completes the
+    // connection in progress rather than being imported as established.
+
+    if (!d_systemRemoteEndpoint.isUndefined() && !d_connectInProgress) {
         d_openState.set(ntcs::OpenState::e_CONNECTED);
 
+        this->privateTcpInfoArm(self);
+
         ntcs::Dispatch::announceEstablished(d_manager_sp,
                                             self,
                                             d_managerStrand_sp,
@@ -3492,6 +3729,89 @@ void StreamSocket::processRemoteEndpointResolution(
     }
 }
 
+void StreamSocket::processRemoteEndpointFamilyResolution(
+    const bsl::shared_ptr<ntci::Resolver>& resolver,
+    const ntsa::Endpoint&                  endpoint,
+    const ntca::GetEndpointEvent&          getEndpointEvent,
+    bsl::uint64_t                          generation,
+    ntsa::IpAddressType::Value             ipAddressType)
+{
+    NTCCFG_WARNING_UNUSED(resolver);
+    NTCCFG_WARNING_UNUSED(endpoint);
+
+    NTCI_LOG_CONTEXT();
+
+    bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
+
+    LockGuard lock(&d_mutex);
+
+    if (NTCCFG_UNLIKELY(d_detachState.mode() == ntcs::DetachMode::e_INITIATED))
+    {
+        return;
+    }
+
+    if (!d_connectInProgress) {
+        NTCI_LOG_STREAM_TRACE
+            << "Stream socket ignored remote endpoint resolution "
+            << getEndpointEvent
+            << " because a connection is no longer in progress"
+            << NTCI_LOG_STREAM_END;
+        return;
+    }
+
+    if (generation != d_connectHappyEyeballs.generation()) {
+        NTCI_LOG_STREAM_TRACE
+            << "Stream socket ignored remote endpoint resolution "
+            << getEndpointEvent << " because it has been superseded"
+            << NTCI_LOG_STREAM_END;
+        return;
+    }
+
+    const bool ready =
+        d_connectHappyEyeballs.process(ipAddressType, getEndpointEvent);
+
+    if (d_connectHappyEyeballs.isStarted()) {
+        d_connectHappyEyeballs.merge(&d_connectEndpointVector, ipAddressType);
+
+        if (!d_connectEndpointVector.empty()) {
+            const bsl::size_t retryCount = d_connectEndpointVector.size() - 1;
+            if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) <
+                retryCount)
+            {
+                d_connectOptions.setRetryCount(retryCount);
+            }
+        }
+
+        return;
+    }
+
+    if (d_openState.value() != ntcs::OpenState::e_CONNECTING) {
+        return;
+    }
+
+    if (ready) {
+        this->privateStartConnectHappyEyeballs(self);
+    }
+    else if (!d_connectResolutionTimer_sp) {
+        ntca::TimerOptions timerOptions;
+        timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+        timerOptions.setOneShot(true);
+
+        ntci::TimerCallback timerCallback = this->createTimerCallback(
+            bdlf::MemFnUtil::memFn(
+                &StreamSocket::processConnectResolutionTimer,
+                self),
+            d_allocator_p);
+
+        d_connectResolutionTimer_sp =
+            this->createTimer(timerOptions, timerCallback, d_allocator_p);
+
+        d_connectResolutionTimer_sp->schedule(
+            this->currentTime() + ntcs::HappyEyeballs::resolutionDelay());
+    }
+}
+
 ntsa::Error StreamSocket::privateUpgrade(
     const bsl::shared_ptr<StreamSocket>& self,
     const ntca::UpgradeOptions&          upgradeOptions)
@@ -3824,8 +4144,14 @@ void StreamSocket::privateRetryConnect(
         }
     }
     else {
-        BSLS_ASSERT(connectStrategy ==
-                    ntca::ConnectStrategy::e_RESOLVE_INTO_LIST);
+        BSLS_ASSERT(
+            connectStrategy == ntca::ConnectStrategy::e_RESOLVE_INTO_LIST ||
+            connectStrategy ==
+                ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS);
+
+        const bool happyEyeballs =
+            connectStrategy ==
+            ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS;
 
         if (!d_connectName.empty() && !d_connectEndpointVector.empty()) {
             d_connectEndpointVector.erase(d_connectEndpointVector.begin());
@@ -3833,9 +4159,24 @@ void StreamSocket::privateRetryConnect(
 
         if (d_connectEndpointVector.empty()) {
             BSLS_ASSERT(!d_connectName.empty());
-            error = this->privateRetryConnectToName();
+            if (happyEyeballs) {
+                error = this->privateRetryConnectToNameHappyEyeballs();
+            }
+            else {
+                error = this->privateRetryConnectToName();
+            }
         }
         else {
+            if (happyEyeballs && d_connectRetryTimer_sp) {
+                const bsls::TimeInterval connectionAttemptDelay =
+                    d_connectOptions.retryInterval().valueOr(
+                        ntcs::HappyEyeballs::connectionAttemptDelay());
+
+                d_connectRetryTimer_sp->schedule(
+                    this->currentTime() + connectionAttemptDelay,
+                    connectionAttemptDelay);
+            }
+
             if (connectContext.source().has_value()) {
                 d_connectContext.setSource(connectContext.source().value());
             }
@@ -3858,6 +4199,38 @@ void StreamSocket::privateRetryConnect(
     }
 }
 
+void StreamSocket::privateTcpInfoArm(const bsl::shared_ptr<StreamSocket>& self)
+{
+#if NTC_BUILD_WITH_METRICS
+    if (!d_metrics_sp || !d_tcpInfoSampler.isEnabled() || d_tcpInfoTimer_sp) {
+        return;
+    }
+
+    if (d_transport != ntsa::Transport::e_TCP_IPV4_STREAM &&
+        d_transport != ntsa::Transport::e_TCP_IPV6_STREAM)
+    {
+        return;
+    }
+
+    ntca::TimerOptions timerOptions;
+    timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+    timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+
+    ntci::TimerCallback timerCallback = this->createTimerCallback(
+        bdlf::MemFnUtil::memFn(&StreamSocket::processTcpInfoTimer, self),
+        d_allocator_p);
+
+    d_tcpInfoTimer_sp =
+        this->createTimer(timerOptions, timerCallback, d_allocator_p);
+
+    const bsls::TimeInterval interval = d_tcpInfoSampler.interval();
+
+    d_tcpInfoTimer_sp->schedule(this->currentTime() + interval, interval);
+#else
+    NTCCFG_WARNING_UNUSED(self);
+#endif
+}
+
 ntsa::Error StreamSocket::privateRetryConnectToName()
 {
     struct WeakBinder {
@@ -3913,41 +4286,366 @@ ntsa::Error StreamSocket::privateRetryConnectToName()
     return ntsa::Error();
 }
 
-ntsa::Error StreamSocket::privateRetryConnectToEndpoint(
-    const bsl::shared_ptr<StreamSocket>& self)
+ntsa::Error StreamSocket::privateRetryConnectToNameHappyEyeballs()
 {
+    struct WeakBinder {
+        static void invoke(const bsl::weak_ptr<StreamSocket>&     socket,
+                           const bsl::shared_ptr<ntci::Resolver>& resolver,
+                           const ntsa::Endpoint&                  endpoint,
+                           const ntca::GetEndpointEvent& getEndpointEvent,
+                           bsl::uint64_t                 generation,
+                           ntsa::IpAddressType::Value    ipAddressType)
+        {
+            const bsl::shared_ptr<StreamSocket> strongRef = socket.lock();
+            if (strongRef) {
+                strongRef->execute(NTCCFG_BIND(
+                    &StreamSocket::processRemoteEndpointFamilyResolution,
+                    strongRef,
+                    resolver,
+                    endpoint,
+                    getEndpointEvent,
+                    generation,
+                    ipAddressType));
+            }
+        }
+    };
+
     ntsa::Error error;
 
-    BSLS_ASSERT(!d_connectEndpointVector.empty());
+    ntcs::ObserverRef<ntci::Resolver> resolverRef(&d_resolver);
+    if (!resolverRef) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
 
-    error = this->privateOpen(self, d_connectEndpointVector.front());
-    if (error) {
-        return error;
+    if (d_connectResolutionTimer_sp) {
+        d_connectResolutionTimer_sp->close();
+        d_connectResolutionTimer_sp.reset();
     }
 
-    if (d_transport == ntsa::Transport::e_LOCAL_STREAM) {
-        if (d_systemSourceEndpoint.isImplicit()) {
-            error =
-                d_socket_sp->bindAny(d_transport, d_options.reuseAddress());
-            if (error) {
-                return error;
-            }
+    ntca::GetEndpointOptions getEndpointOptions;
+    ntcs::Compat::convert(&getEndpointOptions, d_connectOptions);
 
-            error = d_socket_sp->sourceEndpoint(&d_systemSourceEndpoint);
-            if (error) {
-                return error;
-            }
+    d_connectHappyEyeballs.reset(getEndpointOptions.ipAddressType());
 
-            d_publicSourceEndpoint = d_systemSourceEndpoint;
-        }
+    bsl::vector<ntsa::IpAddressType::Value> ipAddressTypeList;
+    if (getEndpointOptions.ipAddressType().isNull()) {
+        ipAddressTypeList.push_back(ntsa::IpAddressType::e_V6);
+        ipAddressTypeList.push_back(ntsa::IpAddressType::e_V4);
     }
-
-    ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
-    if (!proactorRef) {
-        return ntsa::Error(ntsa::Error::e_INVALID);
+    else {
+        ipAddressTypeList.push_back(
+            getEndpointOptions.ipAddressType().value());
     }
 
-    error = proactorRef->connect(self, d_connectEndpointVector.front());
+    const bsl::uint64_t generation = d_connectHappyEyeballs.generation();
+
+    for (bsl::size_t i = 0; i < ipAddressTypeList.size(); ++i) {
+        getEndpointOptions.setIpAddressType(ipAddressTypeList[i]);
+
+        ntci::GetEndpointCallback getEndpointCallback =
+            resolverRef->createGetEndpointCallback(
+                NTCCFG_BIND(&WeakBinder::invoke,
+                            this->weak_from_this(),
+                            NTCCFG_BIND_PLACEHOLDER_1,
+                            NTCCFG_BIND_PLACEHOLDER_2,
+                            NTCCFG_BIND_PLACEHOLDER_3,
+                            generation,
+                            ipAddressTypeList[i]),
+                d_proactorStrand_sp,
+                d_allocator_p);
+
+        error = resolverRef->getEndpoint(d_connectName,
+                                         getEndpointOptions,
+                                         getEndpointCallback);
+
+        if (error) {
+            // Supersede any resolution already initiated.
+
+            d_connectHappyEyeballs.reset(getEndpointOptions.ipAddressType());
+            return error;
+        }
+    }
+
+    return ntsa::Error();
+}
+
+void StreamSocket::privateStartConnectHappyEyeballs(
+    const bsl::shared_ptr<StreamSocket>& self)
+{
+    if (d_connectResolutionTimer_sp) {
+        d_connectResolutionTimer_sp->close();
+        d_connectResolutionTimer_sp.reset();
+    }
+
+    ntsa::Error error =
+        d_connectHappyEyeballs.start(&d_connectEndpointVector);
+    if (error) {
+        this->privateFailConnect(self, error, false, false);
+        return;
+    }
+
+    const ntca::GetEndpointContext& getEndpointContext =
+        d_connectHappyEyeballs.context();
+
+    if (!getEndpointContext.authority().empty()) {
+        d_connectContext.setName(getEndpointContext.authority());
+    }
+
+    if (getEndpointContext.latency() != bsls::TimeInterval()) {
+        d_connectContext.setLatency(getEndpointContext.latency());
+    }
+
+    if (!getEndpointContext.nameServer().isNull()) {
+        d_connectContext.setNameServer(
+            getEndpointContext.nameServer().value());
+    }
+
+    if (getEndpointContext.source() != ntca::ResolverSource::e_UNKNOWN) {
+        d_connectContext.setSource(getEndpointContext.source());
+    }
+
+    // Allow at least one attempt to each resolved endpoint.
+
+    const bsl::size_t retryCount = d_connectEndpointVector.size() - 1;
+    if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) < retryCount) {
+        d_connectOptions.setRetryCount(retryCount);
+    }
+
+    if (d_connectRetryTimer_sp) {
+        const bsls::TimeInterval connectionAttemptDelay =
+            d_connectOptions.retryInterval().valueOr(
+                ntcs::HappyEyeballs::connectionAttemptDelay());
+
+        d_connectRetryTimer_sp->schedule(
+            this->currentTime() + connectionAttemptDelay,
+            connectionAttemptDelay);
+    }
+
+    error = this->privateRetryConnectToEndpoint(self);
+    if (error) {
+        this->privateFailConnect(self, error, false, false);
+    }
+}
+
+void StreamSocket::privateRaceConnect(
+    const bsl::shared_ptr<StreamSocket>& self)
+{
+    NTCI_LOG_CONTEXT();
+
+    while (d_connectEndpointVector.size() > 1 &&
+           d_connectOptions.retryCount().valueOr(bsl::size_t(0)) > 0)
+    {
+        const ntsa::Endpoint endpoint = d_connectEndpointVector[1];
+        d_connectEndpointVector.erase(d_connectEndpointVector.begin() + 1);
+
+        d_connectOptions.setRetryCount(
+            d_connectOptions.retryCount().value() - 1);
+
+        const ntsa::Error error = d_connectHappyEyeballs.race(
+            endpoint,
+            ntsf::System::createStreamSocket(d_allocator_p),
+            d_options);
+        if (!error) {
+            NTCI_LOG_TRACE("Stream socket racing connection attempt to %s",
+                           endpoint.text().c_str());
+            break;
+        }
+
+        NTCI_LOG_TRACE("Stream socket failed to race connection attempt "
+                       "to %s: %s",
+                       endpoint.text().c_str(),
+                       error.text().c_str());
+    }
+
+    if (d_connectHappyEyeballs.numAttempts() == 0) {
+        return;
+    }
+
+    if (!d_connectAttemptTimer_sp) {
+        ntca::TimerOptions timerOptions;
+        timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+        timerOptions.setOneShot(false);
+
+        ntci::TimerCallback timerCallback = this->createTimerCallback(
+            bdlf::MemFnUtil::memFn(&StreamSocket::processConnectAttemptTimer,
+                                   self),
+            d_allocator_p);
+
+        d_connectAttemptTimer_sp =
+            this->createTimer(timerOptions, timerCallback, d_allocator_p);
+
+        const bsls::TimeInterval attemptPollInterval =
+            ntcs::HappyEyeballs::attemptPollInterval();
+
+        d_connectAttemptTimer_sp->schedule(
+            this->currentTime() + attemptPollInterval,
+            attemptPollInterval);
+    }
+}
+
+void StreamSocket::privateAdoptConnectAttempt(
+    const bsl::shared_ptr<StreamSocket>&       self,
+    const bsl::shared_ptr<ntsi::StreamSocket>& streamSocket,
+    const ntsa::Endpoint&                      endpoint)
+{
+    NTCI_LOG_CONTEXT();
+
+    NTCI_LOG_TRACE("Stream socket adopting connection attempt to %s",
+                   endpoint.text().c_str());
+
+    if (d_systemHandle != ntsa::k_INVALID_HANDLE) {
+        ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
+        if (proactorRef) {
+            proactorRef->cancel(self);
+            const ntsa::Error error = proactorRef->detachSocket(self);
+            if (NTCCFG_LIKELY(!error)) {
+                d_detachState.setMode(ntcs::DetachMode::e_INITIATED);
+                BSLS_ASSERT(!d_deferredCall);
+                d_deferredCall = NTCCFG_BIND(
+                    &StreamSocket::privateAdoptConnectAttemptComplete,
+                    this,
+                    self,
+                    streamSocket,
+                    endpoint);
+                return;
+            }
+        }
+    }
+
+    this->privateAdoptConnectAttemptComplete(self, streamSocket, endpoint);
+}
+
+void StreamSocket::privateAdoptConnectAttemptComplete(
+    const bsl::shared_ptr<StreamSocket>&       self,
+    const bsl::shared_ptr<ntsi::StreamSocket>& streamSocket,
+    const ntsa::Endpoint&                      endpoint)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    if (d_systemHandle != ntsa::k_INVALID_HANDLE) {
+        if (d_socket_sp) {
+            ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
+            if (proactorRef) {
+                proactorRef->releaseHandleReservation();
+            }
+
+            d_socket_sp->close();
+
+            NTCI_LOG_TRACE("Stream socket closed descriptor %d",
+                           (int)(d_publicHandle));
+
+            d_publicHandle = ntsa::k_INVALID_HANDLE;
+            d_systemHandle = ntsa::k_INVALID_HANDLE;
+        }
+    }
+
+    // The adopted attempt supersedes any retry requested while the
+    // abandoned attempt was being detached.
+
+    d_retryConnect = false;
+
+    if (!d_connectInProgress) {
+        streamSocket->close();
+    }
+    else {
+        ntca::ConnectContext connectContext = d_connectContext;
+
+        d_systemSourceEndpoint.reset();
+        d_systemRemoteEndpoint.reset();
+        d_publicSourceEndpoint.reset();
+        d_publicRemoteEndpoint.reset();
+
+        d_flowControlState.reset();
+        d_shutdownState.reset();
+
+        d_connectContext.reset();
+
+        if (connectContext.name().has_value()) {
+            d_connectContext.setName(connectContext.name().value());
+        }
+
+        if (connectContext.source().has_value()) {
+            d_connectContext.setSource(connectContext.source().value());
+        }
+
+        if (connectContext.nameServer().has_value()) {
+            d_connectContext.setNameServer(
+                connectContext.nameServer().value());
+        }
+
+        if (connectContext.latency().has_value()) {
+            d_connectContext.setLatency(connectContext.latency().value());
+        }
+
+        d_openState.set(ntcs::OpenState::e_CONNECTING);
+        ++d_connectAttempts;
+
+        if (d_connectEndpointVector.empty()) {
+            d_connectEndpointVector.push_back(endpoint);
+        }
+        else {
+            d_connectEndpointVector.front() = endpoint;
+        }
+
+        // The descriptor is associated with the proactor for the first
+        // time here, and is already connected, so the connection completes
+        // immediately.
+
+        error = this->privateOpen(
+            self,
+            endpoint.transport(ntsa::TransportMode::e_STREAM),
+            streamSocket);
+        if (error) {
+            streamSocket->close();
+            this->privateFailConnect(self, error, false, false);
+        }
+        else {
+            this->privateCompleteConnect(self);
+        }
+    }
+
+    this->moveAndExecute(&d_deferredCalls, ntci::Executor::Functor());
+    d_deferredCalls.clear();
+}
+
+ntsa::Error StreamSocket::privateRetryConnectToEndpoint(
+    const bsl::shared_ptr<StreamSocket>& self)
+{
+    ntsa::Error error;
+
+    BSLS_ASSERT(!d_connectEndpointVector.empty());
+
+    error = this->privateOpen(self, d_connectEndpointVector.front());
+    if (error) {
+        return error;
+    }
+
+    if (d_transport == ntsa::Transport::e_LOCAL_STREAM) {
+        if (d_systemSourceEndpoint.isImplicit()) {
+            error =
+                d_socket_sp->bindAny(d_transport, d_options.reuseAddress());
+            if (error) {
+                return error;
+            }
+
+            error = d_socket_sp->sourceEndpoint(&d_systemSourceEndpoint);
+            if (error) {
+                return error;
+            }
+
+            d_publicSourceEndpoint = d_systemSourceEndpoint;
+        }
+    }
+
+    ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
+    if (!proactorRef) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    error = proactorRef->connect(self, d_connectEndpointVector.front());
     if (error) {
         return error;
     }
@@ -4017,6 +4715,79 @@ void StreamSocket::privateClose(const bsl::shared_ptr<StreamSocket>& self,
     }
 }
 
+void StreamSocket::privateInitialize(
+    const bsl::shared_ptr<ntci::Proactor>& proactor,
+    const bsl::shared_ptr<ntcs::Metrics>&  metrics)
+{
+    d_sendQueue.setData(d_dataPool_sp->createOutgoingBlob());
+    d_receiveQueue.setData(d_dataPool_sp->createIncomingBlob());
+    d_receiveBlob_sp = d_dataPool_sp->createIncomingBlob();
+
+    d_receiveOptions.hideEndpoint();
+
+    if (!d_options.writeQueueLowWatermark().isNull()) {
+        d_sendQueue.setLowWatermark(
+            d_options.writeQueueLowWatermark().value());
+    }
+
+    if (!d_options.writeQueueHighWatermark().isNull()) {
+        d_sendQueue.setHighWatermark(
+            d_options.writeQueueHighWatermark().value());
+    }
+
+    if (!d_options.sendGreedily().isNull()) {
+        d_sendGreedily = d_options.sendGreedily().value();
+    }
+
+    if (proactor->maxThreads() > 1) {
+        d_receiveQueue.setTrigger(ntca::ReactorEventTrigger::e_EDGE);
+    }
+
+    if (!d_options.readQueueLowWatermark().isNull()) {
+        d_receiveQueue.setLowWatermark(
+            d_options.readQueueLowWatermark().value());
+    }
+
+    if (!d_options.readQueueHighWatermark().isNull()) {
+        d_receiveQueue.setHighWatermark(
+            d_options.readQueueHighWatermark().value());
+    }
+
+    if (!d_options.minIncomingStreamTransferSize().isNull()) {
+        d_receiveFeedback.setMinimum(
+            d_options.minIncomingStreamTransferSize().value());
+    }
+
+    if (!d_options.maxIncomingStreamTransferSize().isNull()) {
+        d_receiveFeedback.setMaximum(
+            d_options.maxIncomingStreamTransferSize().value());
+    }
+
+    if (!d_options.receiveGreedily().isNull()) {
+        d_receiveGreedily = d_options.receiveGreedily().value();
+    }
+
+    if (proactor->maxThreads() > 1) {
+        d_proactorStrand_sp = proactor->createStrand(d_allocator_p);
+    }
+
+    if (!d_managerStrand_sp) {
+        d_managerStrand_sp = d_proactorStrand_sp;
+    }
+
+    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
+        d_metrics_sp.createInplace(d_allocator_p,
+                                   "socket",
+                                   metrics,
+                                   d_allocator_p);
+
+        ntcs::MonitorableUtil::registerMonitorable(d_metrics_sp);
+    }
+    else {
+        d_metrics_sp = metrics;
+    }
+}
+
 StreamSocket::StreamSocket(
     const ntca::StreamSocketOptions&           options,
     const bsl::shared_ptr<ntci::Resolver>&     resolver,
@@ -4054,6 +4825,8 @@ StreamSocket::StreamSocket(
 , d_incomingBufferFactory_sp(proactor->incomingBlobBufferFactory())
 , d_outgoingBufferFactory_sp(proactor->outgoingBlobBufferFactory())
 , d_metrics_sp()
+, d_tcpInfoSampler()
+, d_tcpInfoTimer_sp()
 , d_openState()
 , d_flowControlState()
 , d_shutdownState()
@@ -4085,6 +4858,9 @@ StreamSocket::StreamSocket(
 , d_connectCallback(basicAllocator)
 , d_connectDeadlineTimer_sp()
 , d_connectRetryTimer_sp()
+, d_connectResolutionTimer_sp()
+, d_connectAttemptTimer_sp()
+, d_connectHappyEyeballs(basicAllocator)
 , d_connectRateLimiter_sp()
 , d_connectRateTimer_sp()
 , d_connectInProgress(false)
@@ -4100,95 +4876,139 @@ StreamSocket::StreamSocket(
 , d_deferredCalls(bslma::Default::allocator(basicAllocator))
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
-    d_sendQueue.setData(d_dataPool_sp->createOutgoingBlob());
-    d_receiveQueue.setData(d_dataPool_sp->createIncomingBlob());
-    d_receiveBlob_sp = d_dataPool_sp->createIncomingBlob();
-
-    d_receiveOptions.hideEndpoint();
+    this->privateInitialize(proactor, metrics);
+}
 
-    if (!d_options.writeQueueLowWatermark().isNull()) {
-        d_sendQueue.setLowWatermark(
-            d_options.writeQueueLowWatermark().value());
+StreamSocket::~StreamSocket()
+{
+    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
+        if (d_metrics_sp) {
+            ntcs::MonitorableUtil::deregisterMonitorable(d_metrics_sp);
+        }
     }
+}
 
-    if (!d_options.writeQueueHighWatermark().isNull()) {
-        d_sendQueue.setHighWatermark(
-            d_options.writeQueueHighWatermark().value());
-    }
+void StreamSocket::reset(
+    const ntca::StreamSocketOptions&           options,
+    const bsl::shared_ptr<ntci::Resolver>&     resolver,
+    const bsl::shared_ptr<ntci::Proactor>&     proactor,
+    const bsl::shared_ptr<ntci::ProactorPool>& proactorPool,
+    const bsl::shared_ptr<ntcs::Metrics>&      metrics)
+{
+#if NTCP_STREAMSOCKET_OBSERVE_BY_WEAK_PTR
+    d_resolver     = bsl::weak_ptr<ntci::Resolver>(resolver);
+    d_proactor     = bsl::weak_ptr<ntci::Proactor>(proactor);
+    d_proactorPool = bsl::weak_ptr<ntci::ProactorPool>(proactorPool);
+#else
+    d_resolver     = resolver.get();
+    d_proactor     = proactor.get();
+    d_proactorPool = proactorPool.get();
+#endif
 
-    if (!d_options.sendGreedily().isNull()) {
-        d_sendGreedily = d_options.sendGreedily().value();
-    }
+    d_dataPool_sp              = proactor->dataPool();
+    d_incomingBufferFactory_sp = proactor->incomingBlobBufferFactory();
+    d_outgoingBufferFactory_sp = proactor->outgoingBlobBufferFactory();
 
-    if (proactor->maxThreads() > 1) {
-        d_receiveQueue.setTrigger(ntca::ReactorEventTrigger::e_EDGE);
-    }
+    d_creationTime = bdlt::CurrentTime::now();
+    d_options      = options;
 
-    if (!d_options.readQueueLowWatermark().isNull()) {
-        d_receiveQueue.setLowWatermark(
-            d_options.readQueueLowWatermark().value());
-    }
+    this->privateInitialize(proactor, metrics);
+}
 
-    if (!d_options.readQueueHighWatermark().isNull()) {
-        d_receiveQueue.setHighWatermark(
-            d_options.readQueueHighWatermark().value());
+void StreamSocket::clear()
+{
+    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
+        if (d_metrics_sp) {
+            ntcs::MonitorableUtil::deregisterMonitorable(d_metrics_sp);
+        }
     }
 
-    if (!d_options.minIncomingStreamTransferSize().isNull()) {
-        d_receiveFeedback.setMinimum(
-            d_options.minIncomingStreamTransferSize().value());
-    }
+    this->setProactorContext(bsl::shared_ptr<void>());
 
-    if (!d_options.maxIncomingStreamTransferSize().isNull()) {
-        d_receiveFeedback.setMaximum(
-            d_options.maxIncomingStreamTransferSize().value());
-    }
+    d_transport    = ntsa::Transport::e_UNDEFINED;
+    d_systemHandle = ntsa::k_INVALID_HANDLE;
+    d_systemSourceEndpoint.reset();
+    d_systemRemoteEndpoint.reset();
+    d_publicHandle = ntsa::k_INVALID_HANDLE;
+    d_publicSourceEndpoint.reset();
+    d_publicRemoteEndpoint.reset();
 
-    if (!d_options.receiveGreedily().isNull()) {
-        d_receiveGreedily = d_options.receiveGreedily().value();
-    }
+    d_socket_sp.reset();
+    d_acceptor_sp.reset();
+    d_encryption_sp.reset();
 
-    if (proactor->maxThreads() > 1) {
-        d_proactorStrand_sp = proactor->createStrand(d_allocator_p);
-    }
+    d_resolver.reset();
+    d_proactor.reset();
+    d_proactorPool.reset();
 
-    if (!d_managerStrand_sp) {
-        d_managerStrand_sp = d_proactorStrand_sp;
-    }
+    d_proactorStrand_sp.reset();
+    d_manager_sp.reset();
+    d_managerStrand_sp.reset();
+    d_session_sp.reset();
+    d_sessionStrand_sp.reset();
+    d_dataPool_sp.reset();
+    d_incomingBufferFactory_sp.reset();
+    d_outgoingBufferFactory_sp.reset();
+    d_metrics_sp.reset();
 
-    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
-        ntsa::Guid guid = ntsa::Guid::generate();
-        char       guidText[ntsa::Guid::SIZE_TEXT];
-        guid.writeText(guidText);
+    d_tcpInfoSampler.reset();
+    d_tcpInfoTimer_sp.reset();
 
-        bsl::string monitorableObjectName;
-        {
-            bsl::stringstream ss;
-            ss << "socket-";
-            ss.write(guidText, ntsa::Guid::SIZE_TEXT);
-            monitorableObjectName = ss.str();
-        }
+    d_openState.set(ntcs::OpenState::e_DEFAULT);
+    d_flowControlState.reset();
+    d_shutdownState.reset();
 
-        d_metrics_sp.createInplace(d_allocator_p,
-                                   "socket",
-                                   monitorableObjectName,
-                                   metrics,
-                                   d_allocator_p);
+    d_sendOptions.reset();
+    d_sendQueue.reset();
+    d_sendDeflater_sp.reset();
+    d_sendRateLimiter_sp.reset();
+    d_sendRateTimer_sp.reset();
+    d_sendPending  = false;
+    d_sendGreedily = NTCCFG_DEFAULT_STREAM_SOCKET_WRITE_GREEDILY;
+    d_sendComplete.reset();
+    d_sendCount = 0;
+
+    d_receiveOptions.reset();
+    d_receiveQueue.reset();
+    d_receiveFeedback.reset();
+    d_receiveInflater_sp.reset();
+    d_receiveRateLimiter_sp.reset();
+    d_receiveRateTimer_sp.reset();
+    d_receivePending  = false;
+    d_receiveGreedily = NTCCFG_DEFAULT_STREAM_SOCKET_READ_GREEDILY;
+    d_receiveCount    = 0;
+    d_receiveBlob_sp.reset();
+
+    d_connectEndpointVector.clear();
+    d_connectName.clear();
+    d_connectStartTime = bsls::TimeInterval();
+    d_connectAttempts  = 0;
+    d_connectOptions.reset();
+    d_connectContext.reset();
+    d_connectCallback.reset();
+    d_connectDeadlineTimer_sp.reset();
+    d_connectRetryTimer_sp.reset();
+    d_connectResolutionTimer_sp.reset();
+    d_connectAttemptTimer_sp.reset();
+    d_connectHappyEyeballs.reset(
+        bdlb::NullableValue<ntsa::IpAddressType::Value>());
+    d_connectRateLimiter_sp.reset();
+    d_connectRateTimer_sp.reset();
+    d_connectInProgress = false;
 
-        ntcs::MonitorableUtil::registerMonitorable(d_metrics_sp);
-    }
-    else {
-        d_metrics_sp = metrics;
-    }
-}
+    d_upgradeOptions.reset();
+    d_upgradeCallback.reset();
+    d_upgradeTimer_sp.reset();
+    d_upgradeInProgress = false;
 
-StreamSocket::~StreamSocket()
-{
-    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
-        if (d_metrics_sp) {
-            ntcs::MonitorableUtil::deregisterMonitorable(d_metrics_sp);
-        }
-    }
+    d_options = ntca::StreamSocketOptions();
+
+    d_retryConnect = false;
+    d_detachState.setMode(ntcs::DetachMode::e_IDLE);
+    d_detachState.setGoal(ntcs::DetachGoal::e_CLOSE);
+    d_deferredCall = bsl::function<void()>();
+    d_closeCallback.reset();
+    d_deferredCalls.clear();
 }
 
 ntsa::Error StreamSocket::open()
@@ -4436,6 +5256,16 @@ ntsa::Error StreamSocket::connect(const ntsa::Endpoint&        endpoint,
         }
     }
 
+    if (d_connectOptions.strategy().value_or(
+            ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) ==
+        ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS)
+    {
+        if (d_connectOptions.retryInterval().isNull()) {
+            d_connectOptions.setRetryInterval(
+                ntcs::HappyEyeballs::connectionAttemptDelay());
+        }
+    }
+
     if (d_connectOptions.retryCount().value() > 1) {
         if (d_connectOptions.retryInterval().isNull()) {
             d_connectOptions.setRetryInterval(bsls::TimeInterval(0));
@@ -4462,7 +5292,11 @@ ntsa::Error StreamSocket::connect(const ntsa::Endpoint&        endpoint,
             d_connectOptions.deadline().value());
     }
 
-    if (d_connectOptions.retryCount().value() == 1) {
+    if (d_connectOptions.retryCount().value() == 1 &&
+        d_connectOptions.strategy().value_or(
+            ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) !=
+            ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS)
+    {
         ntca::TimerOptions timerOptions;
         timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
         timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
@@ -4567,6 +5401,16 @@ ntsa::Error StreamSocket::connect(const bsl::string&           name,
                                        1);
     }
 
+    if (d_connectOptions.strategy().value_or(
+            ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) ==
+        ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS)
+    {
+        if (d_connectOptions.retryInterval().isNull()) {
+            d_connectOptions.setRetryInterval(
+                ntcs::HappyEyeballs::connectionAttemptDelay());
+        }
+    }
+
     if (d_connectOptions.retryCount().value() > 1) {
         if (d_connectOptions.retryInterval().isNull()) {
             d_connectOptions.setRetryInterval(bsls::TimeInterval(0));
@@ -4593,7 +5437,11 @@ ntsa::Error StreamSocket::connect(const bsl::string&           name,
             d_connectOptions.deadline().value());
     }
 
-    if (d_connectOptions.retryCount().value() == 1) {
+    if (d_connectOptions.retryCount().value() == 1 &&
+        d_connectOptions.strategy().value_or(
+            ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) !=
+            ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS)
+    {
         ntca::TimerOptions timerOptions;
         timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
         timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
@@ -4822,6 +5670,10 @@ ntsa::Error StreamSocket::send(const bdlbb::Blob&        data,
     NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
     NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
 
+    NTCS_TRACE_EVENT(e_SEND_ENQUEUE,
+                     d_publicHandle,
+                     NTCCFG_WARNING_PROMOTE(bsl::size_t, data.length()));
+
     ntsa::Error error;
 
     if (NTCCFG_UNLIKELY(!d_openState.canSend())) {
@@ -4942,6 +5794,8 @@ ntsa::Error StreamSocket::send(const ntsa::Data&         data,
     NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
     NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
 
+    NTCS_TRACE_EVENT(e_SEND_ENQUEUE, d_publicHandle, data.size());
+
     ntsa::Error error;
 
     if (NTCCFG_UNLIKELY(!d_openState.canSend())) {
@@ -5158,8 +6012,10 @@ ntsa::Error StreamSocket::receive(ntca::ReceiveContext*       context,
 ntsa::Error StreamSocket::receive(const ntca::ReceiveOptions&  options,
                                   const ntci::ReceiveFunction& callback)
 {
-    return this->receive(options,
-                         this->createReceiveCallback(callback, d_allocator_p));
+    return this->receive(
+        options,
+        this->createReceiveCallback(callback,
+                                    d_receiveQueue.callbackAllocator()));
 }
 
 ntsa::Error StreamSocket::receive(const ntca::ReceiveOptions&  options,
@@ -6157,16 +7013,27 @@ void StreamSocket::close(const ntci::CloseCallback& callback)
 
 void StreamSocket::execute(const Functor& functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ProactorSocket> self(this->weak_from_this());
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_proactorStrand_sp) {
-        d_proactorStrand_sp->execute(functor);
+        d_proactorStrand_sp->execute(target);
     }
     else {
         ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
         if (proactorRef) {
-            proactorRef->execute(functor);
+            proactorRef->execute(target);
         }
         else {
-            ntcs::Async::execute(functor);
+            ntcs::Async::execute(target);
         }
     }
 }
@@ -6174,16 +7041,28 @@ void StreamSocket::execute(const Functor& functor)
 void StreamSocket::moveAndExecute(FunctorSequence* functorSequence,
                                   const Functor&   functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ProactorSocket> self(this->weak_from_this());
+        ntcs::StallDetectorUtil::attribute(functorSequence, self);
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_proactorStrand_sp) {
-        d_proactorStrand_sp->moveAndExecute(functorSequence, functor);
+        d_proactorStrand_sp->moveAndExecute(functorSequence, target);
     }
     else {
         ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
         if (proactorRef) {
-            proactorRef->moveAndExecute(functorSequence, functor);
+            proactorRef->moveAndExecute(functorSequence, target);
         }
         else {
-            ntcs::Async::moveAndExecute(functorSequence, functor);
+            ntcs::Async::moveAndExecute(functorSequence, target);
         }
     }
 }
@@ -6220,12 +7099,20 @@ bsl::shared_ptr<ntci::Timer> StreamSocket::createTimer(
     const ntci::TimerCallback& callback,
     bslma::Allocator*          basicAllocator)
 {
+    ntci::TimerCallback attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ProactorSocket> self(this->weak_from_this());
+        attributed = ntcs::StallDetectorUtil::attribute(callback, self);
+    }
+
+    const ntci::TimerCallback& target = attributed ? attributed : callback;
+
     ntcs::ObserverRef<ntci::Proactor> proactorRef(&d_proactor);
     if (proactorRef) {
-        return proactorRef->createTimer(options, callback, basicAllocator);
+        return proactorRef->createTimer(options, target, basicAllocator);
     }
     else {
-        return ntcs::Async::createTimer(options, callback, basicAllocator);
+        return ntcs::Async::createTimer(options, target, basicAllocator);
     }
 }
 
@@ -6509,5 +7396,16 @@ void StreamSocket::getInfo(ntsa::SocketInfo* result) const
     result->setReceiveQueueSize(receiveQueueSize);
 }
 
+bsl::string StreamSocket::metricsName() const
+{
+    if (!d_options.metrics().isNull() && d_options.metrics().value() &&
+        d_metrics_sp)
+    {
+        return bsl::string(d_metrics_sp->objectName());
+    }
+
+    return bsl::string();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
@@ -39,11 +39,13 @@ BSLS_IDENT("$Id: $")
 #include <ntcs_detachstate.h>
 #include <ntcs_flowcontrolcontext.h>
 #include <ntcs_flowcontrolstate.h>
+#include <ntcs_happyeyeballs.h>
 #include <ntcs_metrics.h>
 #include <ntcs_observer.h>
 #include <ntcs_openstate.h>
 #include <ntcs_shutdowncontext.h>
 #include <ntcs_shutdownstate.h>
+#include <ntcs_tcpinfosampler.h>
 #include <ntcscm_version.h>
 #include <ntsa_buffer.h>
 #include <ntsa_endpoint.h>
@@ -111,6 +113,8 @@ class StreamSocket : public ntci::StreamSocket,
     BlobBufferFactoryPtr                       d_incomingBufferFactory_sp;
     BlobBufferFactoryPtr                       d_outgoingBufferFactory_sp;
     bsl::shared_ptr<ntcs::Metrics>             d_metrics_sp;
+    ntcs::TcpInfoSampler                       d_tcpInfoSampler;
+    bsl::shared_ptr<ntci::Timer>               d_tcpInfoTimer_sp;
     ntcs::OpenState                            d_openState;
     ntcs::FlowControlState                     d_flowControlState;
     ntcs::ShutdownState                        d_shutdownState;
@@ -142,6 +146,9 @@ class StreamSocket : public ntci::StreamSocket,
     ntci::ConnectCallback                      d_connectCallback;
     bsl::shared_ptr<ntci::Timer>               d_connectDeadlineTimer_sp;
     bsl::shared_ptr<ntci::Timer>               d_connectRetryTimer_sp;
+    bsl::shared_ptr<ntci::Timer>               d_connectResolutionTimer_sp;
+    bsl::shared_ptr<ntci::Timer>               d_connectAttemptTimer_sp;
+    ntcs::HappyEyeballs                        d_connectHappyEyeballs;
     bsl::shared_ptr<ntci::RateLimiter>         d_connectRateLimiter_sp;
     bsl::shared_ptr<ntci::Timer>               d_connectRateTimer_sp;
     bool                                       d_connectInProgress;
@@ -194,6 +201,18 @@ class StreamSocket : public ntci::StreamSocket,
     void processConnectRetryTimer(const bsl::shared_ptr<ntci::Timer>& timer,
                                   const ntca::TimerEvent&             event);
 
+    /// Begin the "Happy Eyeballs" connection attempts with the IPv4
+    /// addresses resolved so far, having waited the resolution delay for
+    /// the IPv6 addresses.
+    void processConnectResolutionTimer(
+        const bsl::shared_ptr<ntci::Timer>& timer,
+        const ntca::TimerEvent&             event);
+
+    /// Poll the "Happy Eyeballs" connection attempts raced on auxiliary
+    /// descriptors, adopting the first to connect.
+    void processConnectAttemptTimer(const bsl::shared_ptr<ntci::Timer>& timer,
+                                    const ntca::TimerEvent& event);
+
     /// Fail the current upgrade attempt unless it has already completed.
     void processUpgradeTimer(const bsl::shared_ptr<ntci::Timer>& timer,
                              const ntca::TimerEvent&             event);
@@ -215,6 +234,12 @@ class StreamSocket : public ntci::StreamSocket,
     void processReceiveRateTimer(const bsl::shared_ptr<ntci::Timer>& timer,
                                  const ntca::TimerEvent&             event);
 
+    /// Sample the TCP state of the connection, if the sampling interval has
+    /// elapsed since the previous sample, so that an idle connection is
+    /// sampled even though no send or receive completes.
+    void processTcpInfoTimer(const bsl::shared_ptr<ntci::Timer>& timer,
+                             const ntca::TimerEvent&             event);
+
     /// Fail the specified 'entry' because the operation did not complete
     /// within the deadline.
     void processReceiveDeadlineTimer(
@@ -506,6 +531,19 @@ class StreamSocket : public ntci::StreamSocket,
         const ntca::GetEndpointEvent&          getEndpointEvent,
         bsl::size_t                            connectAttempts);
 
+    /// Process the resolution of the remote name into its addresses of the
+    /// specified 'ipAddressType' by the specified 'resolver' according to
+    /// the specified 'getEndpointEvent', as part of the "Happy Eyeballs"
+    /// resolutions of the specified 'generation'. Begin the connection
+    /// attempts, if appropriate, or merge the resolved endpoints into the
+    /// endpoints remaining to be tried, if attempts have already begun.
+    void processRemoteEndpointFamilyResolution(
+        const bsl::shared_ptr<ntci::Resolver>& resolver,
+        const ntsa::Endpoint&                  endpoint,
+        const ntca::GetEndpointEvent&          getEndpointEvent,
+        bsl::uint64_t                          generation,
+        ntsa::IpAddressType::Value             ipAddressType);
+
     /// Initiate the upgrade. Return the error.
     ntsa::Error privateUpgrade(const bsl::shared_ptr<StreamSocket>& self,
                                const ntca::UpgradeOptions& upgradeOptions);
@@ -523,6 +561,12 @@ class StreamSocket : public ntci::StreamSocket,
     /// Retry connecting to the remote peer.
     void privateRetryConnect(const bsl::shared_ptr<StreamSocket>& self);
 
+    /// Schedule the TCP state of the connection to be sampled periodically,
+    /// creating the timer if necessary. The behavior is a no-op if the
+    /// socket has no metrics, is not a TCP socket, or the TCP state of the
+    /// connection cannot be sampled.
+    void privateTcpInfoArm(const bsl::shared_ptr<StreamSocket>& self);
+
     /// Retry connecting to the remote name. Return the error.
     ntsa::Error privateRetryConnectToName();
 
@@ -530,11 +574,50 @@ class StreamSocket : public ntci::StreamSocket,
     ntsa::Error privateRetryConnectToEndpoint(
         const bsl::shared_ptr<StreamSocket>& self);
 
+    /// Retry connecting to the remote name by resolving its IPv6 and IPv4
+    /// addresses in parallel, according to the "Happy Eyeballs" strategy.
+    /// Return the error.
+    ntsa::Error privateRetryConnectToNameHappyEyeballs();
+
+    /// Begin the "Happy Eyeballs" connection attempts to the endpoints
+    /// resolved so far, interleaved by address family.
+    void privateStartConnectHappyEyeballs(
+        const bsl::shared_ptr<StreamSocket>& self);
+
+    /// Begin a connection attempt to the next "Happy Eyeballs" endpoint on
+    /// an auxiliary descriptor, leaving the attempt in progress undisturbed.
+    /// Auxiliary descriptors are not associated with the proactor until
+    /// adopted, since some proactors cannot re-associate a descriptor.
+    void privateRaceConnect(const bsl::shared_ptr<StreamSocket>& self);
+
+    /// Abandon the connection attempt in progress, if any, and continue
+    /// with the specified 'streamSocket' connected to the specified
+    /// 'endpoint' on an auxiliary descriptor. If it is required to detach
+    /// the socket from the proactor then part of described functionality
+    /// will be executed asynchronously using the next method.
+    void privateAdoptConnectAttempt(
+        const bsl::shared_ptr<StreamSocket>&       self,
+        const bsl::shared_ptr<ntsi::StreamSocket>& streamSocket,
+        const ntsa::Endpoint&                      endpoint);
+
+    /// Execute the second part of adopting a connection attempt when the
+    /// socket is detached. See also "privateAdoptConnectAttempt".
+    void privateAdoptConnectAttemptComplete(
+        const bsl::shared_ptr<StreamSocket>&       self,
+        const bsl::shared_ptr<ntsi::StreamSocket>& streamSocket,
+        const ntsa::Endpoint&                      endpoint);
+
     /// Close the socket and invoke the specified 'callback' when the socket
     /// is closed.
     void privateClose(const bsl::shared_ptr<StreamSocket>& self,
                       const ntci::CloseCallback&           callback);
 
+    /// Initialize the queues, strands, and metrics of this object according
+    /// to its options, driven by the specified 'proactor' and aggregating
+    /// metrics into the specified 'metrics'.
+    void privateInitialize(const bsl::shared_ptr<ntci::Proactor>& proactor,
+                           const bsl::shared_ptr<ntcs::Metrics>&  metrics);
+
   public:
     /// Create a new, initially uninitilialized stream socket. Optionally
     /// specify a 'basicAllocator' used to supply memory. If
@@ -551,6 +634,22 @@ class StreamSocket : public ntci::StreamSocket,
     /// Destroy this object.
     ~StreamSocket() BSLS_KEYWORD_OVERRIDE;
 
+    /// Reinitialize this object, previously cleared, as if it were newly
+    /// constructed with the specified 'options', 'resolver', 'proactor',
+    /// 'proactorPool', and 'metrics'. The behavior is undefined unless
+    /// 'clear' has been called since this object was last used.
+    void reset(const ntca::StreamSocketOptions&           options,
+               const bsl::shared_ptr<ntci::Resolver>&     resolver,
+               const bsl::shared_ptr<ntci::Proactor>&     proactor,
+               const bsl::shared_ptr<ntci::ProactorPool>& proactorPool,
+               const bsl::shared_ptr<ntcs::Metrics>&      metrics);
+
+    /// Release every resource held by this object, as its destructor would,
+    /// leaving this object ready to be reinitialized by 'reset'. The
+    /// behavior is undefined unless no other reference to this object
+    /// remains.
+    void clear();
+
     /// Open the stream socket. Return the error.
     ntsa::Error open() BSLS_KEYWORD_OVERRIDE;
 
@@ -1415,6 +1514,11 @@ class StreamSocket : public ntci::StreamSocket,
     /// Load into the specified 'result' the information describing the
     /// state of this socket.
     void getInfo(ntsa::SocketInfo* result) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the name under which the statistics of this socket are
+    /// published, or the empty string if the statistics of this socket are
+    /// not published separately from those of its parent.
+    bsl::string metricsName() const BSLS_KEYWORD_OVERRIDE;
 };
 
 }  // close package namespace
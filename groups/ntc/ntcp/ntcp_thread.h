@@ -30,6 +30,7 @@ BSLS_IDENT("$Id: $")
 #include <ntci_thread.h>
 #include <ntci_timer.h>
 #include <ntcs_metrics.h>
+#include <ntcs_threadmetrics.h>
 #include <ntcs_user.h>
 #include <ntcscm_version.h>
 #include <ntsi_descriptor.h>
@@ -66,15 +67,16 @@ class Thread : public ntci::Thread, public ntccfg::Shared<Thread>
         k_RUN_STATE_STOPPING = 2
     };
 
-    ntccfg::Object                  d_object;
-    bsl::shared_ptr<ntci::Proactor> d_proactor_sp;
-    bslmt::ThreadUtil::Handle       d_threadHandle;
-    bslmt::ThreadAttributes         d_threadAttributes;
-    ntccfg::ConditionMutex          d_runMutex;
-    ntccfg::Condition               d_runCondition;
-    bsls::AtomicInt                 d_runState;
-    ntca::ThreadConfig              d_config;
-    bslma::Allocator*               d_allocator_p;
+    ntccfg::Object                       d_object;
+    bsl::shared_ptr<ntci::Proactor>      d_proactor_sp;
+    bslmt::ThreadUtil::Handle            d_threadHandle;
+    bslmt::ThreadAttributes              d_threadAttributes;
+    mutable ntccfg::ConditionMutex       d_runMutex;
+    ntccfg::Condition                    d_runCondition;
+    bsls::AtomicInt                      d_runState;
+    bsl::shared_ptr<ntcs::ThreadMetrics> d_threadMetrics_sp;
+    ntca::ThreadConfig                   d_config;
+    bslma::Allocator*                    d_allocator_p;
 
   private:
     Thread(const Thread&) BSLS_KEYWORD_DELETED;
@@ -193,6 +195,11 @@ class Thread : public ntci::Thread, public ntccfg::Shared<Thread>
     /// Return the thread index.
     bsl::size_t threadIndex() const BSLS_KEYWORD_OVERRIDE;
 
+    /// Return the fraction of one CPU consumed by this thread between the
+    /// two most recent collections of its metrics, or 0 if metrics are not
+    /// collected for this thread.
+    double utilization() const;
+
     /// Return the strand that guarantees sequential, non-current execution
     /// of arbitrary functors on the unspecified threads processing events
     /// for this object.
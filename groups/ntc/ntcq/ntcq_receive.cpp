@@ -39,6 +39,7 @@ ReceiveCallbackQueueEntry::ReceiveCallbackQueueEntry(
 , d_callback(basicAllocator)
 , d_options()
 , d_timer_sp()
+, d_next_sp()
 {
 }
 
@@ -46,6 +47,7 @@ ReceiveCallbackQueueEntry::~ReceiveCallbackQueueEntry()
 {
     BSLS_ASSERT(!d_callback);
     BSLS_ASSERT(!d_timer_sp);
+    BSLS_ASSERT(!d_next_sp);
 }
 
 void ReceiveCallbackQueueEntry::clear()
@@ -57,6 +59,7 @@ void ReceiveCallbackQueueEntry::clear()
         d_timer_sp->close();
         d_timer_sp.reset();
     }
+    d_next_sp.reset();
 }
 
 void ReceiveCallbackQueueEntry::dispatch(
@@ -112,15 +115,21 @@ ReceiveCallbackQueueEntryPool::~ReceiveCallbackQueueEntryPool()
 }
 
 ReceiveCallbackQueue::ReceiveCallbackQueue(bslma::Allocator* basicAllocator)
-: d_entryList(basicAllocator)
-, d_entryPool(basicAllocator)
+: d_entryPool(basicAllocator)
+, d_callbackAllocator_p(ntcs::RecyclingAllocator::create(basicAllocator))
+, d_head_sp()
+, d_tail_p(0)
+, d_size(0)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
 
 ReceiveCallbackQueue::~ReceiveCallbackQueue()
 {
-    BSLS_ASSERT(d_entryList.empty());
+    BSLS_ASSERT(!d_head_sp);
+    BSLS_ASSERT(d_size == 0);
+
+    d_callbackAllocator_p->release();
 }
 
 ReceiveQueue::ReceiveQueue(bslma::Allocator* basicAllocator)
@@ -143,5 +152,26 @@ ReceiveQueue::~ReceiveQueue()
 {
 }
 
+void ReceiveQueue::reset()
+{
+    bsl::vector<bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> >
+        callbackEntryList(d_allocator_p);
+    d_callbackQueue.removeAll(&callbackEntryList);
+
+    d_entryList.clear();
+    d_data_sp.reset();
+    d_size = 0;
+
+    d_watermarkLow  = NTCCFG_DEFAULT_STREAM_SOCKET_READ_QUEUE_LOW_WATERMARK;
+    d_watermarkHigh = NTCCFG_DEFAULT_STREAM_SOCKET_READ_QUEUE_HIGH_WATERMARK;
+
+    d_watermarkLowWanted  = true;
+    d_watermarkHighWanted = true;
+    d_trigger             = ntca::ReactorEventTrigger::e_LEVEL;
+
+    ntcs::WatermarkUtil::sanitizeIncomingQueueWatermarks(&d_watermarkLow,
+                                                         &d_watermarkHigh);
+}
+
 }  // close package namespace
 }  // close enterprise namespace
@@ -30,6 +30,7 @@ BSLS_IDENT("$Id: $")
 #include <ntci_strand.h>
 #include <ntci_timer.h>
 #include <ntcs_callbackstate.h>
+#include <ntcs_recyclingallocator.h>
 #include <ntcs_watermarkutil.h>
 #include <ntcscm_version.h>
 #include <ntsa_error.h>
@@ -52,17 +53,25 @@ namespace ntcq {
 /// @internal @brief
 /// Describe an entry in a receive callback queue.
 ///
+/// @details
+/// Entries are linked intrusively into the queue that owns them, so that
+/// pushing and popping an entry drawn from the entry pool of the queue
+/// requires no memory allocation.
+///
 /// @par Thread Safety
 /// This class is thread safe.
 ///
 /// @ingroup module_ntcq
 class ReceiveCallbackQueueEntry
 {
-    ntccfg::Object               d_object;
-    ntcs::CallbackState          d_state;
-    ntci::ReceiveCallback        d_callback;
-    ntca::ReceiveOptions         d_options;
-    bsl::shared_ptr<ntci::Timer> d_timer_sp;
+    ntccfg::Object                                   d_object;
+    ntcs::CallbackState                              d_state;
+    ntci::ReceiveCallback                            d_callback;
+    ntca::ReceiveOptions                             d_options;
+    bsl::shared_ptr<ntci::Timer>                     d_timer_sp;
+    bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> d_next_sp;
+
+    friend class ReceiveCallbackQueue;
 
   private:
     ReceiveCallbackQueueEntry(const ReceiveCallbackQueueEntry&)
@@ -174,30 +183,44 @@ class ReceiveCallbackQueueEntryPool
 /// @internal @brief
 /// Provide a receive callback queue.
 ///
+/// @details
+/// Entries are drawn from a pool and linked intrusively, and the callbacks
+/// queued by the socket that owns this queue are allocated from a
+/// recycling allocator owned by this queue, so that a steady-state cycle of
+/// creating, queueing, and dispatching a receive callback allocates no
+/// memory from the allocator supplied at construction. The recycling
+/// allocator outlives this queue until every callback allocated from it is
+/// destroyed.
+///
 /// @par Thread Safety
 /// This class is not thread safe.
 ///
 /// @ingroup module_ntcq
 class ReceiveCallbackQueue
 {
-    /// Define a type alias for a linked list of callback
-    /// entries.
-    typedef bsl::list<bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> >
-        EntryList;
-
     /// Define a type alias for a pool of shared pointers to
     /// callback entries.
     typedef ntcq::ReceiveCallbackQueueEntryPool EntryPool;
 
-    EntryList         d_entryList;
-    EntryPool         d_entryPool;
-    bslma::Allocator* d_allocator_p;
+    EntryPool                                        d_entryPool;
+    ntcs::RecyclingAllocator*                        d_callbackAllocator_p;
+    bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> d_head_sp;
+    ntcq::ReceiveCallbackQueueEntry*                 d_tail_p;
+    bsl::size_t                                      d_size;
+    bslma::Allocator*                                d_allocator_p;
 
   private:
     ReceiveCallbackQueue(const ReceiveCallbackQueue&) BSLS_KEYWORD_DELETED;
     ReceiveCallbackQueue& operator=(const ReceiveCallbackQueue&)
         BSLS_KEYWORD_DELETED;
 
+  private:
+    /// Unlink the entry following the specified 'previous' entry, or the
+    /// entry at the front of the queue if 'previous' is null, and load it
+    /// into the specified 'result'.
+    void unlink(bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry>* result,
+                ntcq::ReceiveCallbackQueueEntry*                  previous);
+
   public:
     /// Create a new receive callback queue having an unlimited size.
     /// Optionally specify a 'basicAllocator' used to supply memory. If
@@ -238,6 +261,11 @@ class ReceiveCallbackQueue
         bsl::vector<bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> >*
             result);
 
+    /// Return the allocator from which to allocate the callbacks queued
+    /// onto this queue. Memory returned to this allocator is recycled by
+    /// subsequently allocated callbacks.
+    bslma::Allocator* callbackAllocator() const;
+
     /// Return the number of callbacks in the queue.
     bsl::size_t size() const;
 
@@ -362,6 +390,10 @@ class ReceiveFeedback
     /// Destroy this object.
     ~ReceiveFeedback();
 
+    /// Reset the value of this object to its value upon default
+    /// construction.
+    void reset();
+
     /// Set the minimum amount of data that should be attempted to be
     /// copied from the receive buffer to the specified 'minimum'.
     void setMinimum(bsl::size_t minimum);
@@ -456,6 +488,11 @@ class ReceiveQueue
     /// Destroy this object.
     ~ReceiveQueue();
 
+    /// Remove all entries and callback entries from the queue, without
+    /// invoking their callbacks, and reset the value of this object to its
+    /// value upon default construction.
+    void reset();
+
     /// Push the specified 'entry' onto the queue. Return true if queue
     /// becomes non-empty as a result of this operation, otherwise return
     /// false.
@@ -527,6 +564,10 @@ class ReceiveQueue
     /// Return the data stored in the queue.
     const bsl::shared_ptr<bdlbb::Blob>& data() const;
 
+    /// Return the allocator from which to allocate the callbacks queued
+    /// onto this queue.
+    bslma::Allocator* callbackAllocator() const;
+
     /// Return the low watermark.
     bsl::size_t lowWatermark() const;
 
@@ -612,11 +653,43 @@ bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> ReceiveCallbackQueue::create()
     return d_entryPool.create();
 }
 
+NTCCFG_INLINE
+void ReceiveCallbackQueue::unlink(
+    bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry>* result,
+    ntcq::ReceiveCallbackQueueEntry*                  previous)
+{
+    bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry>& link =
+        previous ? previous->d_next_sp : d_head_sp;
+
+    *result = link;
+    link    = (*result)->d_next_sp;
+
+    (*result)->d_next_sp.reset();
+
+    if (d_tail_p == result->get()) {
+        d_tail_p = previous;
+    }
+
+    BSLS_ASSERT(d_size > 0);
+    --d_size;
+}
+
 NTCCFG_INLINE
 ntsa::Error ReceiveCallbackQueue::push(
     const bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry>& entry)
 {
-    d_entryList.push_back(entry);
+    BSLS_ASSERT(!entry->d_next_sp);
+
+    if (d_tail_p) {
+        d_tail_p->d_next_sp = entry;
+    }
+    else {
+        d_head_sp = entry;
+    }
+
+    d_tail_p = entry.get();
+    ++d_size;
+
     return ntsa::Error();
 }
 
@@ -625,10 +698,9 @@ ntsa::Error ReceiveCallbackQueue::pop(
     bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry>* result,
     bsl::size_t                                       numBytesAvailable)
 {
-    if (!d_entryList.empty()) {
-        if (numBytesAvailable >= d_entryList.front()->options().minSize()) {
-            *result = d_entryList.front();
-            d_entryList.pop_front();
+    if (d_head_sp) {
+        if (numBytesAvailable >= d_head_sp->options().minSize()) {
+            this->unlink(result, 0);
             return ntsa::Error();
         }
         else {
@@ -644,14 +716,18 @@ NTCCFG_INLINE
 ntsa::Error ReceiveCallbackQueue::remove(
     const bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry>& entry)
 {
-    for (EntryList::iterator it = d_entryList.begin(); it != d_entryList.end();
-         ++it)
-    {
-        const bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry>& target = *it;
-        if (entry == target) {
-            d_entryList.erase(it);
+    ntcq::ReceiveCallbackQueueEntry* previous = 0;
+    ntcq::ReceiveCallbackQueueEntry* current  = d_head_sp.get();
+
+    while (current) {
+        if (current == entry.get()) {
+            bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> target;
+            this->unlink(&target, previous);
             return ntsa::Error();
         }
+
+        previous = current;
+        current  = current->d_next_sp.get();
     }
 
     return ntsa::Error(ntsa::Error::e_EOF);
@@ -664,18 +740,19 @@ ntsa::Error ReceiveCallbackQueue::remove(
 {
     result->reset();
 
-    for (EntryList::iterator it = d_entryList.begin(); it != d_entryList.end();
-         ++it)
-    {
-        const bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry>& entry = *it;
+    ntcq::ReceiveCallbackQueueEntry* previous = 0;
+    ntcq::ReceiveCallbackQueueEntry* current  = d_head_sp.get();
 
-        if (!entry->options().token().isNull()) {
-            if (entry->options().token().value() == token) {
-                *result = entry;
-                d_entryList.erase(it);
+    while (current) {
+        if (!current->options().token().isNull()) {
+            if (current->options().token().value() == token) {
+                this->unlink(result, previous);
                 return ntsa::Error();
             }
         }
+
+        previous = current;
+        current  = current->d_next_sp.get();
     }
 
     return ntsa::Error(ntsa::Error::e_EOF);
@@ -685,20 +762,34 @@ NTCCFG_INLINE
 void ReceiveCallbackQueue::removeAll(
     bsl::vector<bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> >* result)
 {
-    result->insert(result->end(), d_entryList.begin(), d_entryList.end());
-    d_entryList.clear();
+    result->reserve(result->size() + d_size);
+
+    while (d_head_sp) {
+        bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> entry;
+        this->unlink(&entry, 0);
+        result->push_back(entry);
+    }
+
+    BSLS_ASSERT(d_tail_p == 0);
+    BSLS_ASSERT(d_size == 0);
+}
+
+NTCCFG_INLINE
+bslma::Allocator* ReceiveCallbackQueue::callbackAllocator() const
+{
+    return d_callbackAllocator_p;
 }
 
 NTCCFG_INLINE
 bsl::size_t ReceiveCallbackQueue::size() const
 {
-    return d_entryList.size();
+    return d_size;
 }
 
 NTCCFG_INLINE
 bool ReceiveCallbackQueue::empty() const
 {
-    return d_entryList.empty();
+    return d_size == 0;
 }
 
 NTCCFG_INLINE
@@ -821,6 +912,17 @@ ReceiveFeedback::~ReceiveFeedback()
 {
 }
 
+NTCCFG_INLINE
+void ReceiveFeedback::reset()
+{
+    d_minimum        = NTCCFG_DEFAULT_STREAM_SOCKET_MIN_INCOMING_TRANSFER_SIZE;
+    d_current        = NTCCFG_DEFAULT_STREAM_SOCKET_MIN_INCOMING_TRANSFER_SIZE;
+    d_maximum        = NTCCFG_DEFAULT_STREAM_SOCKET_MAX_INCOMING_TRANSFER_SIZE;
+    d_increaseFactor = k_INCREASE_FACTOR;
+    d_decreaseFactor = k_DECREASE_FACTOR;
+    d_count          = 0;
+}
+
 NTCCFG_INLINE
 void ReceiveFeedback::setMinimum(bsl::size_t minimum)
 {
@@ -1108,6 +1210,12 @@ const bsl::shared_ptr<bdlbb::Blob>& ReceiveQueue::data() const
     return d_data_sp;
 }
 
+NTCCFG_INLINE
+bslma::Allocator* ReceiveQueue::callbackAllocator() const
+{
+    return d_callbackQueue.callbackAllocator();
+}
+
 NTCCFG_INLINE
 bsl::size_t ReceiveQueue::lowWatermark() const
 {
@@ -19,6 +19,8 @@
 BSLS_IDENT_RCSID(ntcq_receive_t_cpp, "$Id$ $CSID$")
 
 #include <ntcq_receive.h>
+#include <ntccfg_bind.h>
+#include <bslma_testallocator.h>
 
 using namespace BloombergLP;
 
@@ -28,14 +30,265 @@ namespace ntcq {
 // Provide tests for 'ntcq::ReceiveQueue'.
 class ReceiveQueueTest
 {
+    static void processReceive(bsl::size_t*                           counter,
+                               const bsl::shared_ptr<ntci::Receiver>& receiver,
+                               const bsl::shared_ptr<bdlbb::Blob>&    data,
+                               const ntca::ReceiveEvent&              event);
+
   public:
     // TODO
     static void verify();
+
+    // Concern: Callback queue entries are pushed, removed, and popped in
+    // order.
+    static void verifyCallbackQueue();
+
+    // Concern: Pushing, popping, and dispatching a callback queue entry
+    // allocates no memory in the steady state.
+    static void verifyCallbackQueueAllocation();
+
+    // Concern: Creating a callback, then pushing, popping, and dispatching
+    // it, allocates no memory in the steady state.
+    static void verifyCallbackCycleAllocation();
 };
 
+void ReceiveQueueTest::processReceive(
+    bsl::size_t*                           counter,
+    const bsl::shared_ptr<ntci::Receiver>& receiver,
+    const bsl::shared_ptr<bdlbb::Blob>&    data,
+    const ntca::ReceiveEvent&              event)
+{
+    NTCCFG_WARNING_UNUSED(receiver);
+    NTCCFG_WARNING_UNUSED(data);
+    NTCCFG_WARNING_UNUSED(event);
+
+    ++(*counter);
+}
+
 NTSCFG_TEST_FUNCTION(ntcq::ReceiveQueueTest::verify)
 {
 }
 
+NTSCFG_TEST_FUNCTION(ntcq::ReceiveQueueTest::verifyCallbackQueue)
+{
+    ntsa::Error error;
+
+    ntcq::ReceiveCallbackQueue queue(NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> entry1 = queue.create();
+    bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> entry2 = queue.create();
+    bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> entry3 = queue.create();
+
+    ntca::ReceiveOptions options;
+    options.setMinSize(10);
+
+    entry1->assign(ntci::ReceiveCallback(NTSCFG_TEST_ALLOCATOR), options);
+
+    ntca::ReceiveToken token;
+    token.setValue(2);
+
+    options.setToken(token);
+    entry2->assign(ntci::ReceiveCallback(NTSCFG_TEST_ALLOCATOR), options);
+
+    error = queue.push(entry1);
+    NTSCFG_TEST_OK(error);
+
+    error = queue.push(entry2);
+    NTSCFG_TEST_OK(error);
+
+    error = queue.push(entry3);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(queue.size(), 3);
+
+    bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> result;
+
+    error = queue.pop(&result, 9);
+    NTSCFG_TEST_EQ(error, ntsa::Error::e_WOULD_BLOCK);
+
+    error = queue.remove(&result, token);
+    NTSCFG_TEST_OK(error);
+    NTSCFG_TEST_EQ(result, entry2);
+    NTSCFG_TEST_EQ(queue.size(), 2);
+
+    error = queue.remove(entry3);
+    NTSCFG_TEST_OK(error);
+    NTSCFG_TEST_EQ(queue.size(), 1);
+
+    error = queue.remove(entry3);
+    NTSCFG_TEST_EQ(error, ntsa::Error::e_EOF);
+
+    error = queue.push(entry3);
+    NTSCFG_TEST_OK(error);
+
+    error = queue.pop(&result, 10);
+    NTSCFG_TEST_OK(error);
+    NTSCFG_TEST_EQ(result, entry1);
+
+    error = queue.pop(&result, 0);
+    NTSCFG_TEST_OK(error);
+    NTSCFG_TEST_EQ(result, entry3);
+
+    error = queue.pop(&result, 0);
+    NTSCFG_TEST_EQ(error, ntsa::Error::e_INVALID);
+    NTSCFG_TEST_TRUE(queue.empty());
+
+    error = queue.push(entry1);
+    NTSCFG_TEST_OK(error);
+
+    error = queue.push(entry2);
+    NTSCFG_TEST_OK(error);
+
+    bsl::vector<bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> > entries(
+        NTSCFG_TEST_ALLOCATOR);
+    queue.removeAll(&entries);
+
+    NTSCFG_TEST_EQ(entries.size(), 2);
+    NTSCFG_TEST_EQ(entries[0], entry1);
+    NTSCFG_TEST_EQ(entries[1], entry2);
+    NTSCFG_TEST_TRUE(queue.empty());
+}
+
+NTSCFG_TEST_FUNCTION(ntcq::ReceiveQueueTest::verifyCallbackQueueAllocation)
+{
+    const bsl::size_t k_NUM_ITERATIONS = 1000;
+
+    ntsa::Error error;
+
+    bslma::TestAllocator ta;
+
+    {
+        ntcq::ReceiveCallbackQueue queue(&ta);
+
+        bsl::size_t counter = 0;
+
+        ntci::ReceiveCallback callback(
+            NTCCFG_BIND(&ReceiveQueueTest::processReceive,
+                        &counter,
+                        NTCCFG_BIND_PLACEHOLDER_1,
+                        NTCCFG_BIND_PLACEHOLDER_2,
+                        NTCCFG_BIND_PLACEHOLDER_3),
+            &ta);
+
+        ntca::ReceiveOptions options;
+        ntca::ReceiveEvent   event;
+        ntccfg::Mutex        mutex;
+
+        bsls::Types::Int64 numAllocations = 0;
+
+        for (bsl::size_t i = 0; i <= k_NUM_ITERATIONS; ++i) {
+            // Warm up the entry pool during the first iteration, then
+            // measure the allocations made by every subsequent iteration.
+
+            if (i == 1) {
+                numAllocations = ta.numAllocations();
+            }
+
+            bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> entry =
+                queue.create();
+
+            entry->assign(callback, options);
+
+            error = queue.push(entry);
+            NTSCFG_TEST_OK(error);
+
+            entry.reset();
+
+            error = queue.pop(&entry, 0);
+            NTSCFG_TEST_OK(error);
+
+            ntccfg::LockGuard lock(&mutex);
+
+            ntcq::ReceiveCallbackQueueEntry::dispatch(
+                entry,
+                bsl::shared_ptr<ntci::Receiver>(),
+                bsl::shared_ptr<bdlbb::Blob>(),
+                event,
+                ntci::Strand::unknown(),
+                bsl::shared_ptr<ntci::Executor>(),
+                false,
+                &mutex);
+        }
+
+        NTSCFG_TEST_EQ(ta.numAllocations(), numAllocations);
+        NTSCFG_TEST_EQ(counter, k_NUM_ITERATIONS + 1);
+    }
+
+    NTSCFG_TEST_EQ(ta.numBlocksInUse(), 0);
+}
+
+NTSCFG_TEST_FUNCTION(ntcq::ReceiveQueueTest::verifyCallbackCycleAllocation)
+{
+    const bsl::size_t k_NUM_ITERATIONS = 1000;
+
+    ntsa::Error error;
+
+    bslma::TestAllocator ta;
+
+    {
+        ntcq::ReceiveCallbackQueue queue(&ta);
+
+        bsl::size_t counter = 0;
+
+        ntca::ReceiveOptions options;
+        ntca::ReceiveEvent   event;
+        ntccfg::Mutex        mutex;
+
+        bsls::Types::Int64 numAllocations = 0;
+
+        for (bsl::size_t i = 0; i <= k_NUM_ITERATIONS; ++i) {
+            // Warm up the entry pool and the callback allocator during the
+            // first iteration, then measure the allocations made by every
+            // subsequent iteration.
+
+            if (i == 1) {
+                numAllocations = ta.numAllocations();
+            }
+
+            // Create a new callback each iteration, as does each call to
+            // 'receive' through a socket, from the allocator of the queue
+            // that recycles the memory of previously dispatched callbacks.
+
+            ntci::ReceiveCallback callback(
+                NTCCFG_BIND(&ReceiveQueueTest::processReceive,
+                            &counter,
+                            NTCCFG_BIND_PLACEHOLDER_1,
+                            NTCCFG_BIND_PLACEHOLDER_2,
+                            NTCCFG_BIND_PLACEHOLDER_3),
+                queue.callbackAllocator());
+
+            bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> entry =
+                queue.create();
+
+            entry->assign(callback, options);
+
+            error = queue.push(entry);
+            NTSCFG_TEST_OK(error);
+
+            entry.reset();
+
+            error = queue.pop(&entry, 0);
+            NTSCFG_TEST_OK(error);
+
+            ntccfg::LockGuard lock(&mutex);
+
+            ntcq::ReceiveCallbackQueueEntry::dispatch(
+                entry,
+                bsl::shared_ptr<ntci::Receiver>(),
+                bsl::shared_ptr<bdlbb::Blob>(),
+                event,
+                ntci::Strand::unknown(),
+                bsl::shared_ptr<ntci::Executor>(),
+                false,
+                &mutex);
+        }
+
+        NTSCFG_TEST_EQ(ta.numAllocations(), numAllocations);
+        NTSCFG_TEST_EQ(counter, k_NUM_ITERATIONS + 1);
+    }
+
+    NTSCFG_TEST_EQ(ta.numBlocksInUse(), 0);
+}
+
 }  // close namespace ntcq
 }  // close namespace BloombergLP
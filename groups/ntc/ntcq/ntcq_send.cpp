@@ -274,6 +274,23 @@ SendQueue::~SendQueue()
 {
 }
 
+void SendQueue::reset()
+{
+    d_entryList.clear();
+    d_data_sp.reset();
+    d_size = 0;
+
+    d_watermarkLow  = NTCCFG_DEFAULT_STREAM_SOCKET_WRITE_QUEUE_LOW_WATERMARK;
+    d_watermarkHigh = NTCCFG_DEFAULT_STREAM_SOCKET_WRITE_QUEUE_HIGH_WATERMARK;
+
+    d_watermarkLowWanted  = false;
+    d_watermarkHighWanted = true;
+    d_nextEntryId         = 1;
+
+    ntcs::WatermarkUtil::sanitizeOutgoingQueueWatermarks(&d_watermarkLow,
+                                                         &d_watermarkHigh);
+}
+
 bool SendQueue::batchNext(ntsa::ConstBufferArray*  result,
                           const ntsa::SendOptions& options) const
 {
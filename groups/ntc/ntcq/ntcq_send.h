@@ -360,6 +360,11 @@ class SendQueue
     /// Destroy this object.
     ~SendQueue();
 
+    /// Remove all entries from the queue, without closing their timers or
+    /// invoking their callbacks, and reset the value of this object to its
+    /// value upon default construction.
+    void reset();
+
     /// Return the next entry identifier.
     bsl::uint64_t generateEntryId();
 
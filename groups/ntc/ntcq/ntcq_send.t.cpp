@@ -68,6 +68,10 @@ class SendQueueTest
     // Concern: Batching next suitable entries: limit maximum buffers to the
     // maximum number sendable per system call (to avoid EMSGBUF).
     static void verifyCase6();
+
+    // Concern: Resetting the queue removes all entries and restores the
+    // watermarks and entry identifiers to their initial values.
+    static void verifyReset();
 };
 
 /// Provide an interface to guarantee sequential, non-concurrent
@@ -643,5 +647,55 @@ NTSCFG_TEST_FUNCTION(ntcq::SendQueueTest::verifyCase6)
     NTSCFG_TEST_TRUE(ntsa::DataUtil::equals(batch, batchExpected));
 }
 
+NTSCFG_TEST_FUNCTION(ntcq::SendQueueTest::verifyReset)
+{
+    // Concern: Resetting the queue removes all entries and restores the
+    // watermarks and entry identifiers to their initial values.
+
+    const bsl::size_t k_BLOB_BUFFER_SIZE = 32;
+    const bsl::size_t k_MESSAGE_SIZE     = 1024;
+
+    bdlbb::SimpleBlobBufferFactory blobBufferFactory(k_BLOB_BUFFER_SIZE,
+                                                     NTSCFG_TEST_ALLOCATOR);
+
+    ntcq::SendQueue sendQueue(NTSCFG_TEST_ALLOCATOR);
+
+    const bsl::size_t   initialLowWatermark  = sendQueue.lowWatermark();
+    const bsl::size_t   initialHighWatermark = sendQueue.highWatermark();
+    const bsl::uint64_t initialEntryId       = sendQueue.generateEntryId();
+
+    sendQueue.setLowWatermark(k_MESSAGE_SIZE / 4);
+    sendQueue.setHighWatermark(k_MESSAGE_SIZE / 2);
+
+    bdlbb::Blob blob(&blobBufferFactory, NTSCFG_TEST_ALLOCATOR);
+    ntsd::DataUtil::generateData(&blob, k_MESSAGE_SIZE, 0, 0);
+
+    {
+        bsl::shared_ptr<ntsa::Data> data;
+        data.createInplace(NTSCFG_TEST_ALLOCATOR,
+                           blob,
+                           &blobBufferFactory,
+                           NTSCFG_TEST_ALLOCATOR);
+
+        ntcq::SendQueueEntry sendQueueEntry;
+        sendQueueEntry.setId(sendQueue.generateEntryId());
+        sendQueueEntry.setData(data);
+        sendQueueEntry.setLength(data->size());
+
+        sendQueue.pushEntry(sendQueueEntry);
+    }
+
+    NTSCFG_TEST_TRUE(sendQueue.hasEntry());
+    NTSCFG_TEST_TRUE(sendQueue.authorizeHighWatermarkEvent());
+
+    sendQueue.reset();
+
+    NTSCFG_TEST_FALSE(sendQueue.hasEntry());
+    NTSCFG_TEST_EQ(sendQueue.size(), 0);
+    NTSCFG_TEST_EQ(sendQueue.lowWatermark(), initialLowWatermark);
+    NTSCFG_TEST_EQ(sendQueue.highWatermark(), initialHighWatermark);
+    NTSCFG_TEST_EQ(sendQueue.generateEntryId(), initialEntryId);
+}
+
 }  // close namespace ntcq
 }  // close namespace BloombergLP
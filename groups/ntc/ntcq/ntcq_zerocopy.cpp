@@ -419,6 +419,13 @@ void ZeroCopyQueue::clear()
     d_doneList.clear();
 }
 
+void ZeroCopyQueue::reset()
+{
+    d_waitList.clear();
+    d_doneList.clear();
+    d_generator.configure(0, 0);
+}
+
 void ZeroCopyQueue::clear(bsl::vector<ntci::SendCallback>* result)
 {
     if (!d_doneList.empty()) {
@@ -434,6 +434,11 @@ class ZeroCopyQueue
     /// Remove all entries from the queue.
     void clear();
 
+    /// Remove all entries from the queue, without invoking their callbacks,
+    /// and restart the zero-copy counters from zero, as for a newly opened
+    /// socket.
+    void reset();
+
     /// Remove all entries from the queue and load the callback, if any, for
     /// each entry into the specified 'result'.
     void clear(bsl::vector<ntci::SendCallback>* result);
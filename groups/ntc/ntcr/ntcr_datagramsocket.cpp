@@ -28,6 +28,8 @@ BSLS_IDENT_RCSID(ntcr_datagramsocket_cpp, "$Id$ $CSID$")
 #include <ntcs_dispatch.h>
 #include <ntcs_monitorable.h>
 #include <ntcs_plugin.h>
+#include <ntcs_stalldetector.h>
+#include <ntcs_tracer.h>
 #include <ntcu_datagramsocketsession.h>
 #include <ntcu_datagramsocketutil.h>
 #include <ntsa_receivecontext.h>
@@ -230,6 +232,8 @@ void DatagramSocket::processSocketReadable(const ntca::ReactorEvent& event)
 
     NTCCFG_OBJECT_GUARD(&d_object);
 
+    NTCS_TRACE_SCOPE(e_READABLE, d_publicHandle, 0);
+
     bsl::shared_ptr<DatagramSocket> self = this->getSelf(this);
 
     LockGuard lock(&d_mutex);
@@ -287,6 +291,8 @@ void DatagramSocket::processSocketWritable(const ntca::ReactorEvent& event)
 
     NTCCFG_OBJECT_GUARD(&d_object);
 
+    NTCS_TRACE_SCOPE(e_WRITABLE, d_publicHandle, 0);
+
     bsl::shared_ptr<DatagramSocket> self = this->getSelf(this);
 
     LockGuard lock(&d_mutex);
@@ -385,6 +391,10 @@ void DatagramSocket::processNotifications(
         const ntsa::Notification& notification = *it;
 
         if (notification.isZeroCopy()) {
+            NTCS_TRACE_EVENT(e_SEND_COMPLETE,
+                             d_publicHandle,
+                             notification.zeroCopy().thru() -
+                                 notification.zeroCopy().from() + 1);
             this->privateZeroCopyUpdate(self, notification.zeroCopy());
         }
         else if (notification.isTimestamp()) {
@@ -3285,21 +3295,8 @@ DatagramSocket::DatagramSocket(
     }
 
     if (!d_options.metrics().isNull() && d_options.metrics().value()) {
-        ntsa::Guid guid = ntsa::Guid::generate();
-        char       guidText[ntsa::Guid::SIZE_TEXT];
-        guid.writeText(guidText);
-
-        bsl::string monitorableObjectName;
-        {
-            bsl::stringstream ss;
-            ss << "socket-";
-            ss.write(guidText, ntsa::Guid::SIZE_TEXT);
-            monitorableObjectName = ss.str();
-        }
-
         d_metrics_sp.createInplace(d_allocator_p,
                                    "socket",
-                                   monitorableObjectName,
                                    metrics,
                                    d_allocator_p);
 
@@ -3694,6 +3691,10 @@ ntsa::Error DatagramSocket::send(const bdlbb::Blob&        data,
     NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
     NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
 
+    NTCS_TRACE_EVENT(e_SEND_ENQUEUE,
+                     d_publicHandle,
+                     NTCCFG_WARNING_PROMOTE(bsl::size_t, data.length()));
+
     ntcq::SendState state;
     state.setCounter(d_sendCounter++);
 
@@ -3798,6 +3799,8 @@ ntsa::Error DatagramSocket::send(const ntsa::Data&         data,
     NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
     NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
 
+    NTCS_TRACE_EVENT(e_SEND_ENQUEUE, d_publicHandle, data.size());
+
     ntcq::SendState state;
     state.setCounter(d_sendCounter++);
 
@@ -3984,8 +3987,10 @@ ntsa::Error DatagramSocket::receive(ntca::ReceiveContext*       context,
 ntsa::Error DatagramSocket::receive(const ntca::ReceiveOptions&  options,
                                     const ntci::ReceiveFunction& callback)
 {
-    return this->receive(options,
-                         this->createReceiveCallback(callback, d_allocator_p));
+    return this->receive(
+        options,
+        this->createReceiveCallback(callback,
+                                    d_receiveQueue.callbackAllocator()));
 }
 
 ntsa::Error DatagramSocket::receive(const ntca::ReceiveOptions&  options,
@@ -4971,16 +4976,27 @@ void DatagramSocket::close(const ntci::CloseCallback& callback)
 
 void DatagramSocket::execute(const Functor& functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ReactorSocket> self(this->weak_from_this());
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_reactorStrand_sp) {
-        d_reactorStrand_sp->execute(functor);
+        d_reactorStrand_sp->execute(target);
     }
     else {
         ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
         if (reactorRef) {
-            reactorRef->execute(functor);
+            reactorRef->execute(target);
         }
         else {
-            ntcs::Async::execute(functor);
+            ntcs::Async::execute(target);
         }
     }
 }
@@ -4988,16 +5004,28 @@ void DatagramSocket::execute(const Functor& functor)
 void DatagramSocket::moveAndExecute(FunctorSequence* functorSequence,
                                     const Functor&   functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ReactorSocket> self(this->weak_from_this());
+        ntcs::StallDetectorUtil::attribute(functorSequence, self);
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_reactorStrand_sp) {
-        d_reactorStrand_sp->moveAndExecute(functorSequence, functor);
+        d_reactorStrand_sp->moveAndExecute(functorSequence, target);
     }
     else {
         ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
         if (reactorRef) {
-            reactorRef->moveAndExecute(functorSequence, functor);
+            reactorRef->moveAndExecute(functorSequence, target);
         }
         else {
-            ntcs::Async::moveAndExecute(functorSequence, functor);
+            ntcs::Async::moveAndExecute(functorSequence, target);
         }
     }
 }
@@ -5034,12 +5062,20 @@ bsl::shared_ptr<ntci::Timer> DatagramSocket::createTimer(
     const ntci::TimerCallback& callback,
     bslma::Allocator*          basicAllocator)
 {
+    ntci::TimerCallback attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ReactorSocket> self(this->weak_from_this());
+        attributed = ntcs::StallDetectorUtil::attribute(callback, self);
+    }
+
+    const ntci::TimerCallback& target = attributed ? attributed : callback;
+
     ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
     if (reactorRef) {
-        return reactorRef->createTimer(options, callback, basicAllocator);
+        return reactorRef->createTimer(options, target, basicAllocator);
     }
     else {
-        return ntcs::Async::createTimer(options, callback, basicAllocator);
+        return ntcs::Async::createTimer(options, target, basicAllocator);
     }
 }
 
@@ -5279,5 +5315,16 @@ void DatagramSocket::getInfo(ntsa::SocketInfo* result) const
     result->setReceiveQueueSize(receiveQueueSize);
 }
 
+bsl::string DatagramSocket::metricsName() const
+{
+    if (!d_options.metrics().isNull() && d_options.metrics().value() &&
+        d_metrics_sp)
+    {
+        return bsl::string(d_metrics_sp->objectName());
+    }
+
+    return bsl::string();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
@@ -1244,6 +1244,11 @@ class DatagramSocket : public ntci::DatagramSocket,
     /// Load into the specified 'result' the information describing the
     /// state of this socket.
     void getInfo(ntsa::SocketInfo* result) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the name under which the statistics of this socket are
+    /// published, or the empty string if the statistics of this socket are
+    /// not published separately from those of its parent.
+    bsl::string metricsName() const BSLS_KEYWORD_OVERRIDE;
 };
 
 }  // close package namespace
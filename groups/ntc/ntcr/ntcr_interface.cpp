@@ -29,6 +29,7 @@ BSLS_IDENT_RCSID(ntcr_interface_cpp, "$Id$ $CSID$")
 #include <ntcs_plugin.h>
 #include <ntcs_ratelimiter.h>
 #include <ntcs_strand.h>
+#include <ntcs_threadmetrics.h>
 #include <ntcs_threadutil.h>
 #include <ntcs_user.h>
 
@@ -110,6 +111,19 @@ void* Interface::run(void* context)
 
     ntci::Waiter waiter = reactor->registerWaiter(waiterOptions);
 
+    bsl::shared_ptr<ntcs::ThreadMetrics> threadMetrics;
+    if (interface->d_config.driverMetrics().valueOr(
+            NTCCFG_DEFAULT_DRIVER_METRICS))
+    {
+        threadMetrics.createInplace(
+            interface->d_allocator_p,
+            "thread.usage",
+            interface->d_config.metricName() + "-" + metricName,
+            interface->d_allocator_p);
+
+        ntcs::MonitorableUtil::registerMonitorable(threadMetrics);
+    }
+
     NTCI_LOG_TRACE("Thread has started");
 
     BSLS_ASSERT_OPT(runner->d_semaphore_p);
@@ -120,6 +134,10 @@ void* Interface::run(void* context)
 
     reactor->deregisterWaiter(waiter);
 
+    if (threadMetrics) {
+        ntcs::MonitorableUtil::deregisterMonitorable(threadMetrics);
+    }
+
     return 0;
 }
 
@@ -191,6 +209,10 @@ bsl::shared_ptr<ntci::Reactor> Interface::addReactor()
         reactorConfig.setMaxCyclesPerWait(d_config.maxCyclesPerWait().value());
     }
 
+    if (!d_config.stallThreshold().isNull()) {
+        reactorConfig.setStallThreshold(d_config.stallThreshold().value());
+    }
+
     if (!d_config.driverMetrics().isNull()) {
         reactorConfig.setMetricCollection(d_config.driverMetrics().value());
     }
@@ -510,6 +532,8 @@ Interface::Interface(
 , d_resolver_sp()
 , d_connectionLimiter_sp()
 , d_socketMetrics_sp()
+, d_socketAllocator_p(0)
+, d_streamSocketPool_sp()
 , d_chronology_sp()
 , d_reactorFactory_sp(reactorFactory)
 , d_reactorMetrics_sp()
@@ -541,6 +565,16 @@ Interface::Interface(
         ntcs::MonitorableUtil::registerMonitorable(d_socketMetrics_sp);
     }
 
+    if (d_config.socketRecycling().valueOr(NTCCFG_DEFAULT_SOCKET_RECYCLING)) {
+        d_socketAllocator_p = ntcs::RecyclingAllocator::create(d_allocator_p);
+
+        d_streamSocketPool_sp.createInplace(
+            d_allocator_p,
+            NTCCFG_DEFAULT_SOCKET_POOL_CAPACITY,
+            d_socketAllocator_p,
+            d_allocator_p);
+    }
+
     if (d_config.driverMetrics().valueOr(NTCCFG_DEFAULT_DRIVER_METRICS)) {
         bsl::shared_ptr<ntcs::ReactorMetrics> reactorMetrics;
         reactorMetrics.createInplace(d_allocator_p,
@@ -604,6 +638,18 @@ Interface::~Interface()
     if (d_socketMetrics_sp) {
         ntcs::MonitorableUtil::deregisterMonitorable(d_socketMetrics_sp);
     }
+
+    // Sockets allocated from the recycling allocator may outlive this
+    // object: the allocator is destroyed when the last of them is. The
+    // stream socket pool is shared with the listener sockets created by this
+    // object, and destroys the sockets it retains when the last of them is.
+
+    d_streamSocketPool_sp.reset();
+
+    if (d_socketAllocator_p) {
+        d_socketAllocator_p->release();
+        d_socketAllocator_p = 0;
+    }
 }
 
 ntsa::Error Interface::start()
@@ -823,6 +869,9 @@ bsl::shared_ptr<ntci::ListenerSocket> Interface::createListenerSocket(
     NTCI_LOG_CONTEXT_GUARD_OWNER(d_config.metricName().c_str());
 
     bslma::Allocator* allocator = bslma::Default::allocator(basicAllocator);
+    if (basicAllocator == 0 && d_socketAllocator_p != 0) {
+        allocator = d_socketAllocator_p;
+    }
 
     ntca::ListenerSocketOptions effectiveOptions;
     ntcs::Compat::convert(&effectiveOptions, options, d_config);
@@ -843,6 +892,10 @@ bsl::shared_ptr<ntci::ListenerSocket> Interface::createListenerSocket(
                                  d_socketMetrics_sp,
                                  allocator);
 
+    if (basicAllocator == 0 && d_streamSocketPool_sp) {
+        listenerSocket->setStreamSocketPool(d_streamSocketPool_sp);
+    }
+
     return listenerSocket;
 }
 
@@ -855,6 +908,9 @@ bsl::shared_ptr<ntci::StreamSocket> Interface::createStreamSocket(
     NTCI_LOG_CONTEXT_GUARD_OWNER(d_config.metricName().c_str());
 
     bslma::Allocator* allocator = bslma::Default::allocator(basicAllocator);
+    if (basicAllocator == 0 && d_socketAllocator_p != 0) {
+        allocator = d_socketAllocator_p;
+    }
 
     ntca::StreamSocketOptions effectiveOptions;
     ntcs::Compat::convert(&effectiveOptions, options, d_config);
@@ -867,13 +923,35 @@ bsl::shared_ptr<ntci::StreamSocket> Interface::createStreamSocket(
     BSLS_ASSERT_OPT(reactorPool);
 
     bsl::shared_ptr<ntcr::StreamSocket> streamSocket;
-    streamSocket.createInplace(allocator,
-                               effectiveOptions,
-                               d_resolver_sp,
-                               reactor,
-                               reactorPool,
-                               d_socketMetrics_sp,
-                               allocator);
+    if (basicAllocator == 0 && d_streamSocketPool_sp) {
+        ntcr::StreamSocket* object = d_streamSocketPool_sp->acquire();
+        if (object) {
+            object->reset(effectiveOptions,
+                          d_resolver_sp,
+                          reactor,
+                          reactorPool,
+                          d_socketMetrics_sp);
+        }
+        else {
+            object = new (*allocator) ntcr::StreamSocket(effectiveOptions,
+                                                          d_resolver_sp,
+                                                          reactor,
+                                                          reactorPool,
+                                                          d_socketMetrics_sp,
+                                                          allocator);
+        }
+
+        d_streamSocketPool_sp->manage(&streamSocket, object);
+    }
+    else {
+        streamSocket.createInplace(allocator,
+                                   effectiveOptions,
+                                   d_resolver_sp,
+                                   reactor,
+                                   reactorPool,
+                                   d_socketMetrics_sp,
+                                   allocator);
+    }
 
     return streamSocket;
 }
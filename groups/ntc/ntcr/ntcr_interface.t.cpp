@@ -51,6 +51,11 @@ class InterfaceTest
 
     // TODO
     static void verifyCase2();
+
+    // Concern: Stream sockets released by their users are returned to the
+    // pool of an interface that recycles sockets, and are reused, cleared,
+    // by the next stream socket created.
+    static void verifyStreamSocketRecycling();
 };
 
 void InterfaceTest::run(const bsl::shared_ptr<ntcr::Interface>& interface,
@@ -373,5 +378,80 @@ NTSCFG_TEST_FUNCTION(ntcr::InterfaceTest::verifyCase2)
     simulation->stop();
 }
 
+NTSCFG_TEST_FUNCTION(ntcr::InterfaceTest::verifyStreamSocketRecycling)
+{
+    ntsa::Error error;
+
+    // Create the simulation.
+
+    bsl::shared_ptr<ntcd::Simulation> simulation;
+    simulation.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    error = simulation->run();
+    NTSCFG_TEST_OK(error);
+
+    // Create the data pool.
+
+    bsl::shared_ptr<ntcs::DataPool> dataPool;
+    dataPool.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    // Create the reactor factory.
+
+    bsl::shared_ptr<ntcd::ReactorFactory> reactorFactory;
+    reactorFactory.createInplace(NTSCFG_TEST_ALLOCATOR, NTSCFG_TEST_ALLOCATOR);
+
+    // Create the interface, recycling closed sockets.
+
+    ntca::InterfaceConfig interfaceConfig;
+    interfaceConfig.setMetricName("test");
+    interfaceConfig.setMinThreads(1);
+    interfaceConfig.setMaxThreads(1);
+    interfaceConfig.setSocketRecycling(true);
+
+    bsl::shared_ptr<ntcr::Interface> interface;
+    interface.createInplace(NTSCFG_TEST_ALLOCATOR,
+                            interfaceConfig,
+                            dataPool,
+                            reactorFactory,
+                            NTSCFG_TEST_ALLOCATOR);
+
+    error = interface->start();
+    NTSCFG_TEST_OK(error);
+
+    // Create a stream socket, then release it.
+
+    ntci::StreamSocket* object = 0;
+    {
+        bsl::shared_ptr<ntci::StreamSocket> streamSocket =
+            interface->createStreamSocket(ntca::StreamSocketOptions());
+        NTSCFG_TEST_TRUE(streamSocket);
+
+        object = streamSocket.get();
+    }
+
+    // Create another stream socket. Ensure the released stream socket is
+    // reused, and that it has been cleared.
+
+    {
+        bsl::shared_ptr<ntci::StreamSocket> streamSocket =
+            interface->createStreamSocket(ntca::StreamSocketOptions());
+        NTSCFG_TEST_TRUE(streamSocket);
+
+        NTSCFG_TEST_EQ(streamSocket.get(), object);
+        NTSCFG_TEST_EQ(streamSocket->handle(), ntsa::k_INVALID_HANDLE);
+        NTSCFG_TEST_EQ(streamSocket->transport(),
+                       ntsa::Transport::e_UNDEFINED);
+    }
+
+    // Stop the interface.
+
+    interface->shutdown();
+    interface->linger();
+
+    // Stop the simulation.
+
+    simulation->stop();
+}
+
 }  // close namespace ntcr
 }  // close namespace BloombergLP
@@ -27,6 +27,8 @@ BSLS_IDENT_RCSID(ntcr_listenersocket_cpp, "$Id$ $CSID$")
 #include <ntcs_compat.h>
 #include <ntcs_dispatch.h>
 #include <ntcs_monitorable.h>
+#include <ntcs_stalldetector.h>
+#include <ntcs_tracer.h>
 #include <ntcu_listenersocketsession.h>
 #include <ntcu_listenersocketutil.h>
 #include <ntsf_system.h>
@@ -154,6 +156,8 @@ void ListenerSocket::processSocketReadable(const ntca::ReactorEvent& event)
 
     NTCCFG_OBJECT_GUARD(&d_object);
 
+    NTCS_TRACE_SCOPE(e_READABLE, d_publicHandle, 0);
+
     bsl::shared_ptr<ListenerSocket> self = this->getSelf(this);
 
     LockGuard lock(&d_mutex);
@@ -1244,13 +1248,39 @@ ntsa::Error ListenerSocket::privateDequeueBacklog(
     }
 
     bsl::shared_ptr<ntcr::StreamSocket> streamSocket;
-    streamSocket.createInplace(d_allocator_p,
-                               streamSocketOptions,
-                               resolver,
-                               reactor,
-                               reactorPoolRef.getShared(),
-                               metrics,
-                               d_allocator_p);
+    if (d_streamSocketPool_sp) {
+        ntcr::StreamSocket* object = d_streamSocketPool_sp->acquire();
+        if (object) {
+            object->reset(streamSocketOptions,
+                          resolver,
+                          reactor,
+                          reactorPoolRef.getShared(),
+                          metrics);
+        }
+        else {
+            bslma::Allocator* allocator =
+                d_streamSocketPool_sp->objectAllocator();
+
+            object = new (*allocator) ntcr::StreamSocket(
+                streamSocketOptions,
+                resolver,
+                reactor,
+                reactorPoolRef.getShared(),
+                metrics,
+                allocator);
+        }
+
+        d_streamSocketPool_sp->manage(&streamSocket, object);
+    }
+    else {
+        streamSocket.createInplace(d_allocator_p,
+                                   streamSocketOptions,
+                                   resolver,
+                                   reactor,
+                                   reactorPoolRef.getShared(),
+                                   metrics,
+                                   d_allocator_p);
+    }
 
     error = streamSocket->registerManager(d_manager_sp);
     if (error) {
@@ -1656,6 +1686,7 @@ ListenerSocket::ListenerSocket(
 , d_incomingBufferFactory_sp(reactor->incomingBlobBufferFactory())
 , d_outgoingBufferFactory_sp(reactor->outgoingBlobBufferFactory())
 , d_metrics_sp()
+, d_streamSocketPool_sp()
 , d_flowControlState()
 , d_shutdownState()
 , d_acceptQueue(basicAllocator)
@@ -1704,21 +1735,8 @@ ListenerSocket::ListenerSocket(
     }
 
     if (!d_options.metrics().isNull() && d_options.metrics().value()) {
-        ntsa::Guid guid = ntsa::Guid::generate();
-        char       guidText[ntsa::Guid::SIZE_TEXT];
-        guid.writeText(guidText);
-
-        bsl::string monitorableObjectName;
-        {
-            bsl::stringstream ss;
-            ss << "socket-";
-            ss.write(guidText, ntsa::Guid::SIZE_TEXT);
-            monitorableObjectName = ss.str();
-        }
-
         d_metrics_sp.createInplace(d_allocator_p,
                                    "socket",
-                                   monitorableObjectName,
                                    metrics,
                                    d_allocator_p);
 
@@ -1738,6 +1756,13 @@ ListenerSocket::~ListenerSocket()
     }
 }
 
+void ListenerSocket::setStreamSocketPool(
+    const bsl::shared_ptr<StreamSocketPool>& streamSocketPool)
+{
+    LockGuard lock(&d_mutex);
+    d_streamSocketPool_sp = streamSocketPool;
+}
+
 ntsa::Error ListenerSocket::open()
 {
     bsl::shared_ptr<ListenerSocket> self = this->getSelf(this);
@@ -2653,16 +2678,27 @@ void ListenerSocket::close(const ntci::CloseCallback& callback)
 
 void ListenerSocket::execute(const Functor& functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ReactorSocket> self(this->weak_from_this());
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_reactorStrand_sp) {
-        d_reactorStrand_sp->execute(functor);
+        d_reactorStrand_sp->execute(target);
     }
     else {
         ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
         if (reactorRef) {
-            reactorRef->execute(functor);
+            reactorRef->execute(target);
         }
         else {
-            ntcs::Async::execute(functor);
+            ntcs::Async::execute(target);
         }
     }
 }
@@ -2670,16 +2706,28 @@ void ListenerSocket::execute(const Functor& functor)
 void ListenerSocket::moveAndExecute(FunctorSequence* functorSequence,
                                     const Functor&   functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ReactorSocket> self(this->weak_from_this());
+        ntcs::StallDetectorUtil::attribute(functorSequence, self);
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_reactorStrand_sp) {
-        d_reactorStrand_sp->moveAndExecute(functorSequence, functor);
+        d_reactorStrand_sp->moveAndExecute(functorSequence, target);
     }
     else {
         ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
         if (reactorRef) {
-            reactorRef->moveAndExecute(functorSequence, functor);
+            reactorRef->moveAndExecute(functorSequence, target);
         }
         else {
-            ntcs::Async::moveAndExecute(functorSequence, functor);
+            ntcs::Async::moveAndExecute(functorSequence, target);
         }
     }
 }
@@ -2716,12 +2764,20 @@ bsl::shared_ptr<ntci::Timer> ListenerSocket::createTimer(
     const ntci::TimerCallback& callback,
     bslma::Allocator*          basicAllocator)
 {
+    ntci::TimerCallback attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ReactorSocket> self(this->weak_from_this());
+        attributed = ntcs::StallDetectorUtil::attribute(callback, self);
+    }
+
+    const ntci::TimerCallback& target = attributed ? attributed : callback;
+
     ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
     if (reactorRef) {
-        return reactorRef->createTimer(options, callback, basicAllocator);
+        return reactorRef->createTimer(options, target, basicAllocator);
     }
     else {
-        return ntcs::Async::createTimer(options, callback, basicAllocator);
+        return ntcs::Async::createTimer(options, target, basicAllocator);
     }
 }
 
@@ -2896,5 +2952,16 @@ void ListenerSocket::getInfo(ntsa::SocketInfo* result) const
     result->setReceiveQueueSize(receiveQueueSize);
 }
 
+bsl::string ListenerSocket::metricsName() const
+{
+    if (!d_options.metrics().isNull() && d_options.metrics().value() &&
+        d_metrics_sp)
+    {
+        return bsl::string(d_metrics_sp->objectName());
+    }
+
+    return bsl::string();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
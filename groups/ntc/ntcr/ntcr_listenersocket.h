@@ -32,6 +32,7 @@ BSLS_IDENT("$Id: $")
 #include <ntci_strand.h>
 #include <ntci_timer.h>
 #include <ntcq_accept.h>
+#include <ntcr_streamsocket.h>
 #include <ntcs_detachstate.h>
 #include <ntcs_flowcontrolcontext.h>
 #include <ntcs_flowcontrolstate.h>
@@ -39,6 +40,7 @@ BSLS_IDENT("$Id: $")
 #include <ntcs_observer.h>
 #include <ntcs_shutdowncontext.h>
 #include <ntcs_shutdownstate.h>
+#include <ntcs_socketpool.h>
 #include <ntcscm_version.h>
 #include <ntsa_endpoint.h>
 #include <ntsa_error.h>
@@ -73,6 +75,9 @@ class ListenerSocket : public ntci::ListenerSocket,
     /// Define a type alias for a mutex lock guard.
     typedef ntccfg::LockGuard LockGuard;
 
+    /// Define a type alias for a pool of closed stream sockets.
+    typedef ntcs::SocketPool<ntcr::StreamSocket> StreamSocketPool;
+
     ntccfg::Object                               d_object;
     mutable Mutex                                d_mutex;
     ntsa::Transport::Value                       d_transport;
@@ -93,6 +98,7 @@ class ListenerSocket : public ntci::ListenerSocket,
     BlobBufferFactoryPtr                         d_incomingBufferFactory_sp;
     BlobBufferFactoryPtr                         d_outgoingBufferFactory_sp;
     bsl::shared_ptr<ntcs::Metrics>               d_metrics_sp;
+    bsl::shared_ptr<StreamSocketPool>            d_streamSocketPool_sp;
     ntcs::FlowControlState                       d_flowControlState;
     ntcs::ShutdownState                          d_shutdownState;
     ntcq::AcceptQueue                            d_acceptQueue;
@@ -308,6 +314,12 @@ class ListenerSocket : public ntci::ListenerSocket,
     /// Destroy this object.
     ~ListenerSocket() BSLS_KEYWORD_OVERRIDE;
 
+    /// Reuse the closed stream sockets retained by the specified
+    /// 'streamSocketPool' for accepted connections, and return accepted
+    /// sockets to 'streamSocketPool' when they are destroyed.
+    void setStreamSocketPool(
+        const bsl::shared_ptr<StreamSocketPool>& streamSocketPool);
+
     /// Open the listener socket. Return the error.
     ntsa::Error open() BSLS_KEYWORD_OVERRIDE;
 
@@ -698,6 +710,11 @@ class ListenerSocket : public ntci::ListenerSocket,
     /// Load into the specified 'result' the information describing the
     /// state of this socket.
     void getInfo(ntsa::SocketInfo* result) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the name under which the statistics of this socket are
+    /// published, or the empty string if the statistics of this socket are
+    /// not published separately from those of its parent.
+    bsl::string metricsName() const BSLS_KEYWORD_OVERRIDE;
 };
 
 }  // close package namespace
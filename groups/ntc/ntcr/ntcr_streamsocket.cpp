@@ -30,6 +30,8 @@ BSLS_IDENT_RCSID(ntcr_streamsocket_cpp, "$Id$ $CSID$")
 #include <ntcs_dispatch.h>
 #include <ntcs_monitorable.h>
 #include <ntcs_plugin.h>
+#include <ntcs_stalldetector.h>
+#include <ntcs_tracer.h>
 #include <ntcu_streamsocketsession.h>
 #include <ntcu_streamsocketutil.h>
 #include <ntsa_data.h>
@@ -266,6 +268,18 @@ BSLS_IDENT_RCSID(ntcr_streamsocket_cpp, "$Id$ $CSID$")
                    type,                                                      \
                    ntsu::TimestampUtil::describeDelay(delay).c_str())
 
+#define NTCR_STREAMSOCKET_LOG_HIBERNATION_STARTED(residentBefore,             \
+                                                  residentAfter)              \
+    NTCI_LOG_TRACE("Stream socket "                                           \
+                   "is hibernating: resident bytes reduced from %zu to %zu",  \
+                   residentBefore,                                            \
+                   residentAfter)
+
+#define NTCR_STREAMSOCKET_LOG_HIBERNATION_STOPPED(residentBytes)              \
+    NTCI_LOG_TRACE("Stream socket "                                           \
+                   "has resumed from hibernation with %zu resident bytes",    \
+                   residentBytes)
+
 // Some versions of GCC erroneously warn ntcs::ObserverRef::d_shared may be
 // uninitialized.
 #if defined(BSLS_PLATFORM_CMP_GNU)
@@ -286,6 +300,8 @@ void StreamSocket::processSocketReadable(const ntca::ReactorEvent& event)
 
     NTCCFG_OBJECT_GUARD(&d_object);
 
+    NTCS_TRACE_SCOPE(e_READABLE, d_publicHandle, 0);
+
     bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
 
     LockGuard lock(&d_mutex);
@@ -305,6 +321,10 @@ void StreamSocket::processSocketReadable(const ntca::ReactorEvent& event)
         return;
     }
 
+    if (NTCCFG_UNLIKELY(d_hibernating)) {
+        this->privateHibernationLeave(self);
+    }
+
     ntsa::Error error;
     bsl::size_t numIterations = 0;
 
@@ -343,6 +363,8 @@ void StreamSocket::processSocketWritable(const ntca::ReactorEvent& event)
 
     NTCCFG_OBJECT_GUARD(&d_object);
 
+    NTCS_TRACE_SCOPE(e_WRITABLE, d_publicHandle, 0);
+
     bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
 
     LockGuard lock(&d_mutex);
@@ -453,6 +475,10 @@ void StreamSocket::processNotifications(
         const ntsa::Notification& notification = *it;
 
         if (notification.isZeroCopy()) {
+            NTCS_TRACE_EVENT(e_SEND_COMPLETE,
+                             d_publicHandle,
+                             notification.zeroCopy().thru() -
+                                 notification.zeroCopy().from() + 1);
             this->privateZeroCopyUpdate(self, notification.zeroCopy());
         }
         else if (notification.isTimestamp()) {
@@ -528,6 +554,52 @@ void StreamSocket::processConnectRetryTimer(
     if (event.type() == ntca::TimerEventType::e_DEADLINE) {
         if (d_connectInProgress) {
             if (d_connectAttempts > 0) {
+                if (d_connectOptions.strategy().value_or(
+                        ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) ==
+                    ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS)
+                {
+                    // The connection attempt delay does not apply to name
+                    // resolution, nor to the last remaining attempt, which
+                    // is bounded only by the deadline, if any.
+
+                    if (!d_connectName.empty() &&
+                        !d_connectHappyEyeballs.isStarted())
+                    {
+                        return;
+                    }
+
+                    if (d_connectOptions.retryCount().valueOr(
+                            bsl::size_t(0)) == 0)
+                    {
+                        return;
+                    }
+
+                    // Race the next endpoint on an auxiliary descriptor
+                    // rather than abandoning an attempt that may merely be
+                    // slow to complete.
+
+                    if (d_openState.value() ==
+                            ntcs::OpenState::e_CONNECTING &&
+                        d_systemHandle != ntsa::k_INVALID_HANDLE &&
+                        d_detachState.mode() !=
+                            ntcs::DetachMode::e_INITIATED &&
+                        d_connectEndpointVector.size() > 1 &&
+                        d_options.sourceEndpoint().isNull())
+                    {
+                        this->privateRaceConnect(self);
+                        return;
+                    }
+
+                    // Do not resolve the name again while attempts to the
+                    // endpoints already resolved remain in progress.
+
+                    if (d_connectEndpointVector.size() <= 1 &&
+                        d_connectHappyEyeballs.numAttempts() > 0)
+                    {
+                        return;
+                    }
+                }
+
                 d_retryConnect = true;
 
                 if (d_detachState.mode() != ntcs::DetachMode::e_INITIATED) {
@@ -545,6 +617,103 @@ void StreamSocket::processConnectRetryTimer(
     }
 }
 
+void StreamSocket::processConnectResolutionTimer(
+    const bsl::shared_ptr<ntci::Timer>& timer,
+    const ntca::TimerEvent&             event)
+{
+    NTCCFG_OBJECT_GUARD(&d_object);
+
+    bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
+
+    LockGuard lock(&d_mutex);
+
+    NTCI_LOG_CONTEXT();
+
+    NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
+
+    if (event.type() == ntca::TimerEventType::e_DEADLINE) {
+        if (d_connectResolutionTimer_sp != timer) {
+            return;
+        }
+
+        d_connectResolutionTimer_sp.reset();
+
+        if (!d_connectInProgress) {
+            return;
+        }
+
+        if (d_openState.value() != ntcs::OpenState::e_CONNECTING) {
+            return;
+        }
+
+        if (d_connectHappyEyeballs.isStarted()) {
+            return;
+        }
+
+        NTCI_LOG_TRACE("Stream socket timed out waiting for the IPv6 "
+                       "addresses of '%s'",
+                       d_connectName.c_str());
+
+        this->privateStartConnectHappyEyeballs(self);
+    }
+}
+
+void StreamSocket::processConnectAttemptTimer(
+    const bsl::shared_ptr<ntci::Timer>& timer,
+    const ntca::TimerEvent&             event)
+{
+    NTCCFG_OBJECT_GUARD(&d_object);
+
+    bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
+
+    LockGuard lock(&d_mutex);
+
+    NTCI_LOG_CONTEXT();
+
+    NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
+
+    if (event.type() == ntca::TimerEventType::e_DEADLINE) {
+        if (d_connectAttemptTimer_sp != timer) {
+            return;
+        }
+
+        if (!d_connectInProgress) {
+            return;
+        }
+
+        if (d_detachState.mode() == ntcs::DetachMode::e_INITIATED) {
+            return;
+        }
+
+        bsl::shared_ptr<ntsi::StreamSocket> streamSocket;
+        ntsa::Endpoint                      endpoint;
+
+        if (d_connectHappyEyeballs.poll(&streamSocket, &endpoint)) {
+            this->privateAdoptConnectAttempt(self, streamSocket, endpoint);
+            return;
+        }
+
+        if (d_connectHappyEyeballs.numAttempts() == 0) {
+            d_connectAttemptTimer_sp->close();
+            d_connectAttemptTimer_sp.reset();
+
+            // Every attempt has failed if the attempt on the socket's own
+            // descriptor failed while raced attempts remained.
+
+            if (d_openState.value() == ntcs::OpenState::e_WAITING &&
+                d_connectOptions.retryCount().valueOr(bsl::size_t(0)) == 0)
+            {
+                ntsa::Error error = d_connectHappyEyeballs.attemptError();
+                if (!error) {
+                    error = ntsa::Error(ntsa::Error::e_CONNECTION_REFUSED);
+                }
+
+                this->privateFailConnect(self, error, false, true);
+            }
+        }
+    }
+}
+
 void StreamSocket::processUpgradeTimer(
     const bsl::shared_ptr<ntci::Timer>& timer,
     const ntca::TimerEvent&             event)
@@ -710,6 +879,83 @@ void StreamSocket::processReceiveRateTimer(
     }
 }
 
+void StreamSocket::processTcpInfoTimer(
+    const bsl::shared_ptr<ntci::Timer>& timer,
+    const ntca::TimerEvent&             event)
+{
+    NTCCFG_WARNING_UNUSED(timer);
+
+    NTCCFG_OBJECT_GUARD(&d_object);
+
+    LockGuard lock(&d_mutex);
+
+    if (event.type() != ntca::TimerEventType::e_DEADLINE) {
+        return;
+    }
+
+    if (d_openState.value() != ntcs::OpenState::e_CONNECTED) {
+        return;
+    }
+
+    NTCS_METRICS_UPDATE_TCP_INFO(d_tcpInfoSampler, d_publicHandle);
+
+    if (!d_tcpInfoSampler.isEnabled() && d_tcpInfoTimer_sp) {
+        d_tcpInfoTimer_sp->close();
+        d_tcpInfoTimer_sp.reset();
+    }
+}
+
+void StreamSocket::processHibernationTimer(
+    const bsl::shared_ptr<ntci::Timer>& timer,
+    const ntca::TimerEvent&             event)
+{
+    NTCCFG_WARNING_UNUSED(timer);
+
+    NTCCFG_OBJECT_GUARD(&d_object);
+
+    bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
+
+    LockGuard lock(&d_mutex);
+
+    NTCI_LOG_CONTEXT();
+
+    NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
+    NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
+    NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
+
+    if (event.type() != ntca::TimerEventType::e_DEADLINE) {
+        return;
+    }
+
+    if (d_hibernating) {
+        return;
+    }
+
+    if (d_openState.value() != ntcs::OpenState::e_CONNECTED) {
+        return;
+    }
+
+    if (d_detachState.mode() == ntcs::DetachMode::e_INITIATED) {
+        return;
+    }
+
+    const bsl::size_t activity = d_totalBytesSent + d_totalBytesReceived;
+
+    const bool idle = activity == d_hibernationActivity &&
+                      !d_connectInProgress && !d_upgradeInProgress &&
+                      d_sendQueue.size() == 0 && !d_sendQueue.hasEntry() &&
+                      d_receiveQueue.size() == 0 &&
+                      !d_flowControlState.lockSend() &&
+                      !d_flowControlState.lockReceive();
+
+    if (idle) {
+        this->privateHibernationEnter(self);
+    }
+    else {
+        this->privateHibernationArm(self);
+    }
+}
+
 void StreamSocket::processReceiveDeadlineTimer(
     const bsl::shared_ptr<ntci::Timer>&                     timer,
     const ntca::TimerEvent&                                 event,
@@ -1086,12 +1332,20 @@ ntsa::Error StreamSocket::privateSocketWritableConnection(
         }
     }
 
+    if (d_systemRemoteEndpoint.isIp()) {
+        d_connectContext.setIpAddressType(
+            d_systemRemoteEndpoint.ip().host().type());
+    }
+
     d_connectOptions.setRetryCount(0);
     d_connectInProgress = false;
     d_connectEndpointVector.clear();
 
     d_openState.set(ntcs::OpenState::e_CONNECTED);
 
+    this->privateHibernationArm(self);
+    this->privateTcpInfoArm(self);
+
     if (d_options.timestampOutgoingData().has_value()) {
         this->privateTimestampOutgoingData(
             self,
@@ -1129,6 +1383,13 @@ ntsa::Error StreamSocket::privateSocketWritableConnection(
         d_connectRetryTimer_sp.reset();
     }
 
+    if (d_connectAttemptTimer_sp) {
+        d_connectAttemptTimer_sp->close();
+        d_connectAttemptTimer_sp.reset();
+    }
+
+    d_connectHappyEyeballs.cancel();
+
     {
         ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
         if (reactorRef) {
@@ -1506,7 +1767,8 @@ void StreamSocket::privateFailConnect(
 
         d_connectContext.setError(error);
         d_connectContext.setAttemptsRemaining(
-            d_connectOptions.retryCount().valueOr(bsl::size_t(0)));
+            d_connectOptions.retryCount().valueOr(bsl::size_t(0)) +
+            (close ? 0 : d_connectHappyEyeballs.numAttempts()));
 
         if (d_connectContext.name().isNull()) {
             if (!d_connectName.empty()) {
@@ -1527,7 +1789,12 @@ void StreamSocket::privateFailConnect(
         connectEvent.setType(ntca::ConnectEventType::e_ERROR);
         connectEvent.setContext(connectContext);
 
-        if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) == 0) {
+        // Keep waiting for the attempts raced on auxiliary descriptors, if
+        // any, unless the connection is being abandoned.
+
+        if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) == 0 &&
+            (close || d_connectHappyEyeballs.numAttempts() == 0))
+        {
             d_openState.set(ntcs::OpenState::e_CLOSED);
             d_connectInProgress = false;
 
@@ -1544,6 +1811,18 @@ void StreamSocket::privateFailConnect(
                 d_connectRetryTimer_sp.reset();
             }
 
+            if (d_connectResolutionTimer_sp) {
+                d_connectResolutionTimer_sp->close();
+                d_connectResolutionTimer_sp.reset();
+            }
+
+            if (d_connectAttemptTimer_sp) {
+                d_connectAttemptTimer_sp->close();
+                d_connectAttemptTimer_sp.reset();
+            }
+
+            d_connectHappyEyeballs.cancel();
+
             d_flowControlState.close();
             d_shutdownState.close();
 
@@ -1581,6 +1860,18 @@ void StreamSocket::privateFailConnect(
             }
         }
         else {
+            if (d_connectOptions.strategy().value_or(
+                    ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) ==
+                    ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS &&
+                d_connectEndpointVector.size() > 1 &&
+                d_connectOptions.retryCount().valueOr(bsl::size_t(0)) > 0)
+            {
+                // Try the next endpoint immediately rather than waiting
+                // for the connection attempt delay to elapse.
+
+                d_retryConnect = true;
+            }
+
             if (d_systemHandle != ntsa::k_INVALID_HANDLE) {
                 ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
                 if (reactorRef) {
@@ -1692,7 +1983,9 @@ void StreamSocket::privateFailConnectPart2(
         d_closeCallback.reset();
     }
 
-    if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) == 0) {
+    if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) == 0 &&
+        d_connectHappyEyeballs.numAttempts() == 0)
+    {
         d_resolver.reset();
 
         d_sendDeflater_sp.reset();
@@ -2308,6 +2601,16 @@ void StreamSocket::privateShutdownSequenceComplete(
         // Note that detachment from the reactor is handled earlier in this
         // function.
 
+        if (d_hibernationTimer_sp) {
+            d_hibernationTimer_sp->close();
+            d_hibernationTimer_sp.reset();
+        }
+
+        if (d_tcpInfoTimer_sp) {
+            d_tcpInfoTimer_sp->close();
+            d_tcpInfoTimer_sp.reset();
+        }
+
         ntcs::ObserverRef<ntci::ReactorPool> reactorPoolRef(&d_reactorPool);
         if (reactorPoolRef) {
             ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
@@ -2859,6 +3162,7 @@ ntsa::Error StreamSocket::privateEnqueueSendBuffer(
 
     NTCR_STREAMSOCKET_LOG_SEND_RESULT(*context);
     NTCS_METRICS_UPDATE_SEND_COMPLETE(*context);
+    NTCS_METRICS_UPDATE_TCP_INFO(d_tcpInfoSampler, d_publicHandle);
 
     d_totalBytesSent += context->bytesSent();
 
@@ -2971,6 +3275,7 @@ ntsa::Error StreamSocket::privateEnqueueSendBuffer(
 
     NTCR_STREAMSOCKET_LOG_SEND_RESULT(*context);
     NTCS_METRICS_UPDATE_SEND_COMPLETE(*context);
+    NTCS_METRICS_UPDATE_TCP_INFO(d_tcpInfoSampler, d_publicHandle);
 
     d_totalBytesSent += context->bytesSent();
 
@@ -3413,6 +3718,7 @@ ntsa::Error StreamSocket::privateDequeueReceiveBufferRaw(
     if (NTCCFG_LIKELY(context->bytesReceived() > 0)) {
         NTCR_STREAMSOCKET_LOG_RECEIVE_RESULT(*context);
         NTCS_METRICS_UPDATE_RECEIVE_COMPLETE(*context);
+        NTCS_METRICS_UPDATE_TCP_INFO(d_tcpInfoSampler, d_publicHandle);
 
         d_totalBytesReceived += context->bytesReceived();
     }
@@ -4126,6 +4432,8 @@ ntsa::Error StreamSocket::privateOpen(
     d_socket_sp            = streamSocket;
     d_acceptor_sp          = acceptor;
 
+    d_tcpInfoSampler.reset();
+
     NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
     NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
     NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
@@ -4133,7 +4441,10 @@ ntsa::Error StreamSocket::privateOpen(
     NTCI_LOG_TRACE("Stream socket opened descriptor %d",
                    (int)(d_publicHandle));
 
-    if (!d_systemRemoteEndpoint.isUndefined()) {
+    // A descriptor adopted from a connection attempt completes the
+    // connection in progress rather than being imported as established.
+
+    if (!d_systemRemoteEndpoint.isUndefined() && !d_connectInProgress) {
         ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
         if (!reactorRef) {
             return ntsa::Error(ntsa::Error::e_INVALID);
@@ -4143,6 +4454,9 @@ ntsa::Error StreamSocket::privateOpen(
 
         d_openState.set(ntcs::OpenState::e_CONNECTED);
 
+        this->privateHibernationArm(self);
+        this->privateTcpInfoArm(self);
+
         if (d_options.timestampOutgoingData().has_value()) {
             this->privateTimestampOutgoingData(
                 self,
@@ -4404,6 +4718,89 @@ void StreamSocket::processRemoteEndpointResolution(
     }
 }
 
+void StreamSocket::processRemoteEndpointFamilyResolution(
+    const bsl::shared_ptr<ntci::Resolver>& resolver,
+    const ntsa::Endpoint&                  endpoint,
+    const ntca::GetEndpointEvent&          getEndpointEvent,
+    bsl::uint64_t                          generation,
+    ntsa::IpAddressType::Value             ipAddressType)
+{
+    NTCCFG_WARNING_UNUSED(resolver);
+    NTCCFG_WARNING_UNUSED(endpoint);
+
+    NTCI_LOG_CONTEXT();
+
+    bsl::shared_ptr<StreamSocket> self = this->getSelf(this);
+
+    LockGuard lock(&d_mutex);
+
+    if (NTCCFG_UNLIKELY(d_detachState.mode() == ntcs::DetachMode::e_INITIATED))
+    {
+        return;
+    }
+
+    if (!d_connectInProgress) {
+        NTCI_LOG_STREAM_TRACE
+            << "Stream socket ignored remote endpoint resolution "
+            << getEndpointEvent
+            << " because a connection is no longer in progress"
+            << NTCI_LOG_STREAM_END;
+        return;
+    }
+
+    if (generation != d_connectHappyEyeballs.generation()) {
+        NTCI_LOG_STREAM_TRACE
+            << "Stream socket ignored remote endpoint resolution "
+            << getEndpointEvent << " because it has been superseded"
+            << NTCI_LOG_STREAM_END;
+        return;
+    }
+
+    const bool ready =
+        d_connectHappyEyeballs.process(ipAddressType, getEndpointEvent);
+
+    if (d_connectHappyEyeballs.isStarted()) {
+        d_connectHappyEyeballs.merge(&d_connectEndpointVector, ipAddressType);
+
+        if (!d_connectEndpointVector.empty()) {
+            const bsl::size_t retryCount = d_connectEndpointVector.size() - 1;
+            if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) <
+                retryCount)
+            {
+                d_connectOptions.setRetryCount(retryCount);
+            }
+        }
+
+        return;
+    }
+
+    if (d_openState.value() != ntcs::OpenState::e_CONNECTING) {
+        return;
+    }
+
+    if (ready) {
+        this->privateStartConnectHappyEyeballs(self);
+    }
+    else if (!d_connectResolutionTimer_sp) {
+        ntca::TimerOptions timerOptions;
+        timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+        timerOptions.setOneShot(true);
+
+        ntci::TimerCallback timerCallback = this->createTimerCallback(
+            bdlf::MemFnUtil::memFn(
+                &StreamSocket::processConnectResolutionTimer,
+                self),
+            d_allocator_p);
+
+        d_connectResolutionTimer_sp =
+            this->createTimer(timerOptions, timerCallback, d_allocator_p);
+
+        d_connectResolutionTimer_sp->schedule(
+            this->currentTime() + ntcs::HappyEyeballs::resolutionDelay());
+    }
+}
+
 ntsa::Error StreamSocket::privateUpgrade(
     const bsl::shared_ptr<StreamSocket>& self,
     const ntca::UpgradeOptions&          upgradeOptions)
@@ -4742,8 +5139,14 @@ void StreamSocket::privateRetryConnect(
         }
     }
     else {
-        BSLS_ASSERT(connectStrategy ==
-                    ntca::ConnectStrategy::e_RESOLVE_INTO_LIST);
+        BSLS_ASSERT(
+            connectStrategy == ntca::ConnectStrategy::e_RESOLVE_INTO_LIST ||
+            connectStrategy ==
+                ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS);
+
+        const bool happyEyeballs =
+            connectStrategy ==
+            ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS;
 
         if (!d_connectName.empty() && !d_connectEndpointVector.empty()) {
             d_connectEndpointVector.erase(d_connectEndpointVector.begin());
@@ -4751,9 +5154,24 @@ void StreamSocket::privateRetryConnect(
 
         if (d_connectEndpointVector.empty()) {
             BSLS_ASSERT(!d_connectName.empty());
-            this->privateRetryConnectToName(self);
+            if (happyEyeballs) {
+                this->privateRetryConnectToNameHappyEyeballs(self);
+            }
+            else {
+                this->privateRetryConnectToName(self);
+            }
         }
         else {
+            if (happyEyeballs && d_connectRetryTimer_sp) {
+                const bsls::TimeInterval connectionAttemptDelay =
+                    d_connectOptions.retryInterval().valueOr(
+                        ntcs::HappyEyeballs::connectionAttemptDelay());
+
+                d_connectRetryTimer_sp->schedule(
+                    this->currentTime() + connectionAttemptDelay,
+                    connectionAttemptDelay);
+            }
+
             if (connectContext.source().has_value()) {
                 d_connectContext.setSource(connectContext.source().value());
             }
@@ -4772,6 +5190,38 @@ void StreamSocket::privateRetryConnect(
     }
 }
 
+void StreamSocket::privateTcpInfoArm(const bsl::shared_ptr<StreamSocket>& self)
+{
+#if NTC_BUILD_WITH_METRICS
+    if (!d_metrics_sp || !d_tcpInfoSampler.isEnabled() || d_tcpInfoTimer_sp) {
+        return;
+    }
+
+    if (d_transport != ntsa::Transport::e_TCP_IPV4_STREAM &&
+        d_transport != ntsa::Transport::e_TCP_IPV6_STREAM)
+    {
+        return;
+    }
+
+    ntca::TimerOptions timerOptions;
+    timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+    timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+
+    ntci::TimerCallback timerCallback = this->createTimerCallback(
+        bdlf::MemFnUtil::memFn(&StreamSocket::processTcpInfoTimer, self),
+        d_allocator_p);
+
+    d_tcpInfoTimer_sp =
+        this->createTimer(timerOptions, timerCallback, d_allocator_p);
+
+    const bsls::TimeInterval interval = d_tcpInfoSampler.interval();
+
+    d_tcpInfoTimer_sp->schedule(this->currentTime() + interval, interval);
+#else
+    NTCCFG_WARNING_UNUSED(self);
+#endif
+}
+
 void StreamSocket::privateRetryConnectToName(
     const bsl::shared_ptr<StreamSocket>& self)
 {
@@ -4932,9 +5382,367 @@ void StreamSocket::privateRetryConnectToEndpoint(
     }
 }
 
-ntsa::Error StreamSocket::privateTimestampOutgoingData(
-    const bsl::shared_ptr<StreamSocket>& self,
-    bool                                 enable)
+void StreamSocket::privateRetryConnectToNameHappyEyeballs(
+    const bsl::shared_ptr<StreamSocket>& self)
+{
+    struct WeakBinder {
+        static void invoke(const bsl::weak_ptr<StreamSocket>&     socket,
+                           const bsl::shared_ptr<ntci::Resolver>& resolver,
+                           const ntsa::Endpoint&                  endpoint,
+                           const ntca::GetEndpointEvent& getEndpointEvent,
+                           bsl::uint64_t                 generation,
+                           ntsa::IpAddressType::Value    ipAddressType)
+        {
+            const bsl::shared_ptr<StreamSocket> strongRef = socket.lock();
+            if (strongRef) {
+                strongRef->execute(NTCCFG_BIND(
+                    &StreamSocket::processRemoteEndpointFamilyResolution,
+                    strongRef,
+                    resolver,
+                    endpoint,
+                    getEndpointEvent,
+                    generation,
+                    ipAddressType));
+            }
+        }
+    };
+
+    ntsa::Error error;
+
+    ntcs::ObserverRef<ntci::Resolver> resolverRef(&d_resolver);
+    if (!resolverRef) {
+        this->privateFailConnect(self, error, false, false);
+        return;
+    }
+
+    if (d_connectResolutionTimer_sp) {
+        d_connectResolutionTimer_sp->close();
+        d_connectResolutionTimer_sp.reset();
+    }
+
+    ntca::GetEndpointOptions getEndpointOptions;
+    ntcs::Compat::convert(&getEndpointOptions, d_connectOptions);
+
+    d_connectHappyEyeballs.reset(getEndpointOptions.ipAddressType());
+
+    bsl::vector<ntsa::IpAddressType::Value> ipAddressTypeList;
+    if (getEndpointOptions.ipAddressType().isNull()) {
+        ipAddressTypeList.push_back(ntsa::IpAddressType::e_V6);
+        ipAddressTypeList.push_back(ntsa::IpAddressType::e_V4);
+    }
+    else {
+        ipAddressTypeList.push_back(
+            getEndpointOptions.ipAddressType().value());
+    }
+
+    const bsl::uint64_t generation = d_connectHappyEyeballs.generation();
+
+    for (bsl::size_t i = 0; i < ipAddressTypeList.size(); ++i) {
+        getEndpointOptions.setIpAddressType(ipAddressTypeList[i]);
+
+        ntci::GetEndpointCallback getEndpointCallback =
+            resolverRef->createGetEndpointCallback(
+                NTCCFG_BIND(&WeakBinder::invoke,
+                            this->weak_from_this(),
+                            NTCCFG_BIND_PLACEHOLDER_1,
+                            NTCCFG_BIND_PLACEHOLDER_2,
+                            NTCCFG_BIND_PLACEHOLDER_3,
+                            generation,
+                            ipAddressTypeList[i]),
+                d_reactorStrand_sp,
+                d_allocator_p);
+
+        error = resolverRef->getEndpoint(d_connectName,
+                                         getEndpointOptions,
+                                         getEndpointCallback);
+
+        if (error) {
+            // Supersede any resolution already initiated.
+
+            d_connectHappyEyeballs.reset(getEndpointOptions.ipAddressType());
+
+            this->privateFailConnect(self, error, false, false);
+            return;
+        }
+    }
+}
+
+void StreamSocket::privateStartConnectHappyEyeballs(
+    const bsl::shared_ptr<StreamSocket>& self)
+{
+    if (d_connectResolutionTimer_sp) {
+        d_connectResolutionTimer_sp->close();
+        d_connectResolutionTimer_sp.reset();
+    }
+
+    ntsa::Error error =
+        d_connectHappyEyeballs.start(&d_connectEndpointVector);
+    if (error) {
+        this->privateFailConnect(self, error, false, false);
+        return;
+    }
+
+    const ntca::GetEndpointContext& getEndpointContext =
+        d_connectHappyEyeballs.context();
+
+    if (!getEndpointContext.authority().empty()) {
+        d_connectContext.setName(getEndpointContext.authority());
+    }
+
+    if (getEndpointContext.latency() != bsls::TimeInterval()) {
+        d_connectContext.setLatency(getEndpointContext.latency());
+    }
+
+    if (!getEndpointContext.nameServer().isNull()) {
+        d_connectContext.setNameServer(
+            getEndpointContext.nameServer().value());
+    }
+
+    if (getEndpointContext.source() != ntca::ResolverSource::e_UNKNOWN) {
+        d_connectContext.setSource(getEndpointContext.source());
+    }
+
+    // Allow at least one attempt to each resolved endpoint.
+
+    const bsl::size_t retryCount = d_connectEndpointVector.size() - 1;
+    if (d_connectOptions.retryCount().valueOr(bsl::size_t(0)) < retryCount) {
+        d_connectOptions.setRetryCount(retryCount);
+    }
+
+    if (d_connectRetryTimer_sp) {
+        const bsls::TimeInterval connectionAttemptDelay =
+            d_connectOptions.retryInterval().valueOr(
+                ntcs::HappyEyeballs::connectionAttemptDelay());
+
+        d_connectRetryTimer_sp->schedule(
+            this->currentTime() + connectionAttemptDelay,
+            connectionAttemptDelay);
+    }
+
+    this->privateRetryConnectToEndpoint(self);
+}
+
+void StreamSocket::privateRaceConnect(
+    const bsl::shared_ptr<StreamSocket>& self)
+{
+    NTCI_LOG_CONTEXT();
+
+    while (d_connectEndpointVector.size() > 1 &&
+           d_connectOptions.retryCount().valueOr(bsl::size_t(0)) > 0)
+    {
+        const ntsa::Endpoint endpoint = d_connectEndpointVector[1];
+        d_connectEndpointVector.erase(d_connectEndpointVector.begin() + 1);
+
+        d_connectOptions.setRetryCount(
+            d_connectOptions.retryCount().value() - 1);
+
+        const ntsa::Error error = d_connectHappyEyeballs.race(
+            endpoint,
+            ntsf::System::createStreamSocket(d_allocator_p),
+            d_options);
+        if (!error) {
+            NTCI_LOG_TRACE("Stream socket racing connection attempt to %s",
+                           endpoint.text().c_str());
+            break;
+        }
+
+        NTCI_LOG_TRACE("Stream socket failed to race connection attempt "
+                       "to %s: %s",
+                       endpoint.text().c_str(),
+                       error.text().c_str());
+    }
+
+    if (d_connectHappyEyeballs.numAttempts() == 0) {
+        return;
+    }
+
+    if (!d_connectAttemptTimer_sp) {
+        ntca::TimerOptions timerOptions;
+        timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+        timerOptions.setOneShot(false);
+
+        ntci::TimerCallback timerCallback = this->createTimerCallback(
+            bdlf::MemFnUtil::memFn(&StreamSocket::processConnectAttemptTimer,
+                                   self),
+            d_allocator_p);
+
+        d_connectAttemptTimer_sp =
+            this->createTimer(timerOptions, timerCallback, d_allocator_p);
+
+        const bsls::TimeInterval attemptPollInterval =
+            ntcs::HappyEyeballs::attemptPollInterval();
+
+        d_connectAttemptTimer_sp->schedule(
+            this->currentTime() + attemptPollInterval,
+            attemptPollInterval);
+    }
+}
+
+void StreamSocket::privateAdoptConnectAttempt(
+    const bsl::shared_ptr<StreamSocket>&       self,
+    const bsl::shared_ptr<ntsi::StreamSocket>& streamSocket,
+    const ntsa::Endpoint&                      endpoint)
+{
+    NTCI_LOG_CONTEXT();
+
+    NTCI_LOG_TRACE("Stream socket adopting connection attempt to %s",
+                   endpoint.text().c_str());
+
+    if (d_systemHandle != ntsa::k_INVALID_HANDLE) {
+        ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
+        if (reactorRef) {
+            ntci::SocketDetachedCallback detachCallback(
+                NTCCFG_BIND(&StreamSocket::privateAdoptConnectAttemptPart2,
+                            this,
+                            self,
+                            streamSocket,
+                            endpoint,
+                            true),
+                this->strand(),
+                d_allocator_p);
+
+            const ntsa::Error error =
+                reactorRef->detachSocket(self, detachCallback);
+            if (!error) {
+                d_detachState.setMode(ntcs::DetachMode::e_INITIATED);
+                return;
+            }
+        }
+    }
+
+    this->privateAdoptConnectAttemptPart2(self, streamSocket, endpoint, false);
+}
+
+void StreamSocket::privateAdoptConnectAttemptPart2(
+    const bsl::shared_ptr<StreamSocket>&       self,
+    const bsl::shared_ptr<ntsi::StreamSocket>& streamSocket,
+    const ntsa::Endpoint&                      endpoint,
+    bool                                       lock)
+{
+    NTCI_LOG_CONTEXT();
+
+    ntsa::Error error;
+
+    if (lock) {
+        d_mutex.lock();
+        BSLS_ASSERT(d_detachState.mode() == ntcs::DetachMode::e_INITIATED);
+        d_detachState.setMode(ntcs::DetachMode::e_IDLE);
+    }
+    else {
+        BSLS_ASSERT(d_detachState.mode() != ntcs::DetachMode::e_INITIATED);
+    }
+
+    if (d_systemHandle != ntsa::k_INVALID_HANDLE) {
+        if (d_socket_sp) {
+            ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
+            if (reactorRef) {
+                reactorRef->releaseHandleReservation();
+            }
+
+            d_socket_sp->close();
+
+            NTCI_LOG_TRACE("Stream socket closed descriptor %d",
+                           (int)(d_publicHandle));
+
+            d_publicHandle = ntsa::k_INVALID_HANDLE;
+            d_systemHandle = ntsa::k_INVALID_HANDLE;
+        }
+    }
+
+    // The adopted attempt supersedes any retry requested while the
+    // abandoned attempt was being detached.
+
+    d_retryConnect = false;
+
+    if (!d_connectInProgress) {
+        streamSocket->close();
+    }
+    else {
+        ntca::ConnectContext connectContext = d_connectContext;
+
+        d_systemSourceEndpoint.reset();
+        d_systemRemoteEndpoint.reset();
+        d_publicSourceEndpoint.reset();
+        d_publicRemoteEndpoint.reset();
+
+        d_flowControlState.reset();
+        d_shutdownState.reset();
+
+        d_connectContext.reset();
+
+        if (connectContext.name().has_value()) {
+            d_connectContext.setName(connectContext.name().value());
+        }
+
+        if (connectContext.source().has_value()) {
+            d_connectContext.setSource(connectContext.source().value());
+        }
+
+        if (connectContext.nameServer().has_value()) {
+            d_connectContext.setNameServer(
+                connectContext.nameServer().value());
+        }
+
+        if (connectContext.latency().has_value()) {
+            d_connectContext.setLatency(connectContext.latency().value());
+        }
+
+        d_openState.set(ntcs::OpenState::e_CONNECTING);
+        ++d_connectAttempts;
+
+        if (d_connectEndpointVector.empty()) {
+            d_connectEndpointVector.push_back(endpoint);
+        }
+        else {
+            d_connectEndpointVector.front() = endpoint;
+        }
+
+        error = this->privateOpen(
+            self,
+            endpoint.transport(ntsa::TransportMode::e_STREAM),
+            streamSocket);
+        if (error) {
+            streamSocket->close();
+            this->privateFailConnect(self, error, false, false);
+        }
+        else {
+            // The descriptor is already connected, so it is immediately
+            // writable and the connection completes as if the attempt had
+            // been made on this descriptor all along.
+
+            ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
+            if (!reactorRef) {
+                error = ntsa::Error(ntsa::Error::e_INVALID);
+            }
+            else {
+                error = reactorRef->attachSocket(self);
+                if (!error) {
+                    error = reactorRef->showWritable(
+                        self,
+                        ntca::ReactorEventOptions());
+                }
+            }
+
+            if (error) {
+                this->privateFailConnect(self, error, false, false);
+            }
+        }
+    }
+
+    if (!d_deferredCalls.empty()) {
+        this->moveAndExecute(&d_deferredCalls, ntci::Executor::Functor());
+    }
+    d_deferredCalls.clear();
+
+    if (lock) {
+        d_mutex.unlock();
+    }
+}
+
+ntsa::Error StreamSocket::privateTimestampOutgoingData(
+    const bsl::shared_ptr<StreamSocket>& self,
+    bool                                 enable)
 {
     NTCCFG_WARNING_UNUSED(self);
 
@@ -5190,87 +5998,311 @@ ntsa::Error StreamSocket::privateZeroCopyEngage(
     d_options.setZeroCopyThreshold(threshold);
     d_zeroCopyThreshold = threshold;
 
-    return ntsa::Error();
-}
+    return ntsa::Error();
+}
+
+void StreamSocket::privateZeroCopyUpdate(
+    const bsl::shared_ptr<StreamSocket>& self,
+    const ntsa::ZeroCopy&                zeroCopy)
+{
+    NTCI_LOG_CONTEXT();
+
+    NTCR_STREAMSOCKET_LOG_ZERO_COPY_COMPLETE(zeroCopy);
+
+    if (zeroCopy.type() != ntsa::ZeroCopyType::e_AVOIDED) {
+        if (d_zeroCopyThreshold != k_ZERO_COPY_NEVER) {
+            NTCR_STREAMSOCKET_LOG_ZERO_COPY_DISABLED();
+            d_zeroCopyThreshold = k_ZERO_COPY_NEVER;
+        }
+    }
+
+    d_zeroCopyQueue.update(zeroCopy);
+
+    if (d_zeroCopyQueue.ready()) {
+        while (true) {
+            ntca::SendContext  setting;
+            ntci::SendCallback callback;
+
+            bool found = d_zeroCopyQueue.pop(&setting, &callback);
+            if (!found) {
+                break;
+            }
+
+            if (callback) {
+                ntca::SendEvent event;
+                event.setType(ntca::SendEventType::e_COMPLETE);
+                event.setContext(setting);
+
+                callback.dispatch(self,
+                                  event,
+                                  d_reactorStrand_sp,
+                                  self,
+                                  false,
+                                  &d_mutex);
+            }
+        }
+    }
+}
+
+void StreamSocket::privateClose(const bsl::shared_ptr<StreamSocket>& self,
+                                const ntci::CloseCallback&           callback)
+{
+    NTCI_LOG_CONTEXT();
+
+    NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
+    NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
+    NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
+
+    if (d_detachState.mode() == ntcs::DetachMode::e_INITIATED) {
+        d_deferredCalls.push_back(NTCCFG_BIND(
+            static_cast<void (StreamSocket::*)(
+                const ntci::CloseCallback& callback)>(&StreamSocket::close),
+            self,
+            callback));
+
+        return;
+    }
+
+    BSLS_ASSERT(!d_closeCallback);
+    d_closeCallback = callback;
+
+    if (d_connectInProgress) {
+        this->privateFailConnect(self,
+                                 ntsa::Error(ntsa::Error::e_CANCELLED),
+                                 true,
+                                 true);
+    }
+    else {
+        // TODO: Announce discarded.
+
+        this->privateShutdown(self,
+                              ntsa::ShutdownType::e_BOTH,
+                              ntsa::ShutdownMode::e_IMMEDIATE,
+                              true);
+    }
+}
+
+void StreamSocket::privateHibernationArm(
+    const bsl::shared_ptr<StreamSocket>& self)
+{
+    if (d_options.hibernationTimeout().isNull()) {
+        return;
+    }
+
+    if (NTCCFG_UNLIKELY(!d_hibernationTimer_sp)) {
+        ntca::TimerOptions timerOptions;
+        timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+        timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+
+        ntci::TimerCallback timerCallback = this->createTimerCallback(
+            bdlf::MemFnUtil::memFn(&StreamSocket::processHibernationTimer,
+                                   self),
+            d_allocator_p);
+
+        d_hibernationTimer_sp =
+            this->createTimer(timerOptions, timerCallback, d_allocator_p);
+    }
+
+    d_hibernationActivity = d_totalBytesSent + d_totalBytesReceived;
+
+    d_hibernationTimer_sp->schedule(this->currentTime() +
+                                    d_options.hibernationTimeout().value());
+}
+
+void StreamSocket::privateHibernationEnter(
+    const bsl::shared_ptr<StreamSocket>& self)
+{
+    NTCCFG_WARNING_UNUSED(self);
+
+    NTCI_LOG_CONTEXT();
+
+    const bsl::size_t residentBefore = this->privateResidentBytes();
+
+    // Release the capacity reserved in the empty queues. Each blob buffer
+    // returns to the pool from which it was allocated, and the queues
+    // re-reserve capacity on demand when data next arrives or is sent.
+
+    if (d_receiveQueue.data()) {
+        d_receiveQueue.data()->removeAll();
+    }
+
+    if (d_receiveBlob_sp) {
+        d_receiveBlob_sp->removeAll();
+    }
+
+    if (d_sendQueue.data()) {
+        d_sendQueue.data()->removeAll();
+    }
+
+    // The rate timers are lazily created when a rate limit is first
+    // breached, and are not scheduled while flow control is not locked.
+
+    if (d_sendRateTimer_sp) {
+        d_sendRateTimer_sp->close();
+        d_sendRateTimer_sp.reset();
+    }
+
+    if (d_receiveRateTimer_sp) {
+        d_receiveRateTimer_sp->close();
+        d_receiveRateTimer_sp.reset();
+    }
+
+    if (d_hibernationTimer_sp) {
+        d_hibernationTimer_sp->close();
+        d_hibernationTimer_sp.reset();
+    }
+
+    if (d_tcpInfoTimer_sp) {
+        d_tcpInfoTimer_sp->close();
+        d_tcpInfoTimer_sp.reset();
+    }
+
+    // Per-socket metrics aggregate every update into their parent, so
+    // dropping them loses no interface-level statistics.
+
+    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
+        if (d_metrics_sp) {
+            ntcs::MonitorableUtil::deregisterMonitorable(d_metrics_sp);
+            bsl::shared_ptr<ntcs::Metrics> parent = d_metrics_sp->parent();
+            d_metrics_sp = parent;
+        }
+    }
+
+    d_hibernating = true;
+
+    NTCR_STREAMSOCKET_LOG_HIBERNATION_STARTED(residentBefore,
+                                              this->privateResidentBytes());
+}
+
+void StreamSocket::privateHibernationLeave(
+    const bsl::shared_ptr<StreamSocket>& self)
+{
+    NTCI_LOG_CONTEXT();
+
+    d_hibernating = false;
+
+    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
+        bsl::shared_ptr<ntcs::Metrics> parent = d_metrics_sp;
+        this->privateMetricsCreate(parent);
+    }
+
+    this->privateHibernationArm(self);
+    this->privateTcpInfoArm(self);
+
+    NTCR_STREAMSOCKET_LOG_HIBERNATION_STOPPED(this->privateResidentBytes());
+}
+
+void StreamSocket::privateMetricsCreate(
+    const bsl::shared_ptr<ntcs::Metrics>& parent)
+{
+    d_metrics_sp.createInplace(d_allocator_p,
+                               "socket",
+                               parent,
+                               d_allocator_p);
+
+    ntcs::MonitorableUtil::registerMonitorable(d_metrics_sp);
+}
+
+bsl::size_t StreamSocket::privateResidentBytes() const
+{
+    bsl::size_t result = 0;
+
+    if (d_receiveQueue.data()) {
+        result += static_cast<bsl::size_t>(d_receiveQueue.data()->totalSize());
+    }
+
+    if (d_receiveBlob_sp) {
+        result += static_cast<bsl::size_t>(d_receiveBlob_sp->totalSize());
+    }
+
+    if (d_sendQueue.data()) {
+        result += static_cast<bsl::size_t>(d_sendQueue.data()->totalSize());
+    }
+
+    if (!d_options.metrics().isNull() && d_options.metrics().value() &&
+        !d_hibernating && d_metrics_sp)
+    {
+        result += sizeof(ntcs::Metrics);
+    }
+
+    return result;
+}
+
+void StreamSocket::privateInitialize(
+    const bsl::shared_ptr<ntci::Reactor>& reactor,
+    const bsl::shared_ptr<ntcs::Metrics>& metrics)
+{
+    if (reactor->maxThreads() > 1) {
+        if (!reactor->oneShot()) {
+            BSLS_ASSERT(!"Dynamic load balancing requires one-shot mode");
+        }
+    }
+
+    d_sendQueue.setData(d_dataPool_sp->createOutgoingBlob());
+
+    d_sendData_sp = d_dataPool_sp->createOutgoingData();
+    d_sendData_sp->makeConstBufferArray();
 
-void StreamSocket::privateZeroCopyUpdate(
-    const bsl::shared_ptr<StreamSocket>& self,
-    const ntsa::ZeroCopy&                zeroCopy)
-{
-    NTCI_LOG_CONTEXT();
+    d_receiveQueue.setData(d_dataPool_sp->createIncomingBlob());
+    d_receiveBlob_sp = d_dataPool_sp->createIncomingBlob();
 
-    NTCR_STREAMSOCKET_LOG_ZERO_COPY_COMPLETE(zeroCopy);
+    d_receiveOptions.hideEndpoint();
 
-    if (zeroCopy.type() != ntsa::ZeroCopyType::e_AVOIDED) {
-        if (d_zeroCopyThreshold != k_ZERO_COPY_NEVER) {
-            NTCR_STREAMSOCKET_LOG_ZERO_COPY_DISABLED();
-            d_zeroCopyThreshold = k_ZERO_COPY_NEVER;
-        }
+    if (!d_options.writeQueueLowWatermark().isNull()) {
+        d_sendQueue.setLowWatermark(
+            d_options.writeQueueLowWatermark().value());
     }
 
-    d_zeroCopyQueue.update(zeroCopy);
+    if (!d_options.writeQueueHighWatermark().isNull()) {
+        d_sendQueue.setHighWatermark(
+            d_options.writeQueueHighWatermark().value());
+    }
 
-    if (d_zeroCopyQueue.ready()) {
-        while (true) {
-            ntca::SendContext  setting;
-            ntci::SendCallback callback;
+    if (!d_options.sendGreedily().isNull()) {
+        d_sendGreedily = d_options.sendGreedily().value();
+    }
 
-            bool found = d_zeroCopyQueue.pop(&setting, &callback);
-            if (!found) {
-                break;
-            }
+    if (reactor->maxThreads() > 1) {
+        d_receiveQueue.setTrigger(ntca::ReactorEventTrigger::e_EDGE);
+    }
 
-            if (callback) {
-                ntca::SendEvent event;
-                event.setType(ntca::SendEventType::e_COMPLETE);
-                event.setContext(setting);
+    if (!d_options.readQueueLowWatermark().isNull()) {
+        d_receiveQueue.setLowWatermark(
+            d_options.readQueueLowWatermark().value());
+    }
 
-                callback.dispatch(self,
-                                  event,
-                                  d_reactorStrand_sp,
-                                  self,
-                                  false,
-                                  &d_mutex);
-            }
-        }
+    if (!d_options.readQueueHighWatermark().isNull()) {
+        d_receiveQueue.setHighWatermark(
+            d_options.readQueueHighWatermark().value());
     }
-}
 
-void StreamSocket::privateClose(const bsl::shared_ptr<StreamSocket>& self,
-                                const ntci::CloseCallback&           callback)
-{
-    NTCI_LOG_CONTEXT();
+    if (!d_options.minIncomingStreamTransferSize().isNull()) {
+        d_receiveFeedback.setMinimum(
+            d_options.minIncomingStreamTransferSize().value());
+    }
 
-    NTCI_LOG_CONTEXT_GUARD_DESCRIPTOR(d_publicHandle);
-    NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
-    NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
+    if (!d_options.maxIncomingStreamTransferSize().isNull()) {
+        d_receiveFeedback.setMaximum(
+            d_options.maxIncomingStreamTransferSize().value());
+    }
 
-    if (d_detachState.mode() == ntcs::DetachMode::e_INITIATED) {
-        d_deferredCalls.push_back(NTCCFG_BIND(
-            static_cast<void (StreamSocket::*)(
-                const ntci::CloseCallback& callback)>(&StreamSocket::close),
-            self,
-            callback));
+    if (!d_options.receiveGreedily().isNull()) {
+        d_receiveGreedily = d_options.receiveGreedily().value();
+    }
 
-        return;
+    if (reactor->maxThreads() > 1) {
+        d_reactorStrand_sp = reactor->createStrand(d_allocator_p);
     }
 
-    BSLS_ASSERT(!d_closeCallback);
-    d_closeCallback = callback;
+    if (!d_managerStrand_sp) {
+        d_managerStrand_sp = d_reactorStrand_sp;
+    }
 
-    if (d_connectInProgress) {
-        this->privateFailConnect(self,
-                                 ntsa::Error(ntsa::Error::e_CANCELLED),
-                                 true,
-                                 true);
+    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
+        this->privateMetricsCreate(metrics);
     }
     else {
-        // TODO: Announce discarded.
-
-        this->privateShutdown(self,
-                              ntsa::ShutdownType::e_BOTH,
-                              ntsa::ShutdownMode::e_IMMEDIATE,
-                              true);
+        d_metrics_sp = metrics;
     }
 }
 
@@ -5311,6 +6343,8 @@ StreamSocket::StreamSocket(
 , d_incomingBufferFactory_sp(reactor->incomingBlobBufferFactory())
 , d_outgoingBufferFactory_sp(reactor->outgoingBlobBufferFactory())
 , d_metrics_sp()
+, d_tcpInfoSampler()
+, d_tcpInfoTimer_sp()
 , d_openState()
 , d_flowControlState()
 , d_shutdownState()
@@ -5342,6 +6376,9 @@ StreamSocket::StreamSocket(
 , d_connectCallback(basicAllocator)
 , d_connectDeadlineTimer_sp()
 , d_connectRetryTimer_sp()
+, d_connectResolutionTimer_sp()
+, d_connectAttemptTimer_sp()
+, d_connectHappyEyeballs(basicAllocator)
 , d_connectRateLimiter_sp()
 , d_connectRateTimer_sp()
 , d_connectInProgress(false)
@@ -5362,108 +6399,158 @@ StreamSocket::StreamSocket(
 , d_totalBytesSent(0)
 , d_totalBytesReceived(0)
 , d_creationTime(bdlt::CurrentTime::now())
+, d_hibernationTimer_sp()
+, d_hibernationActivity(0)
+, d_hibernating(false)
 , d_options(options)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
-    if (reactor->maxThreads() > 1) {
-        if (!reactor->oneShot()) {
-            BSLS_ASSERT(!"Dynamic load balancing requires one-shot mode");
+    this->privateInitialize(reactor, metrics);
+}
+
+StreamSocket::~StreamSocket()
+{
+    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
+        if (d_metrics_sp && !d_hibernating) {
+            ntcs::MonitorableUtil::deregisterMonitorable(d_metrics_sp);
         }
     }
+}
 
-    d_sendQueue.setData(d_dataPool_sp->createOutgoingBlob());
+void StreamSocket::reset(
+    const ntca::StreamSocketOptions&          options,
+    const bsl::shared_ptr<ntci::Resolver>&    resolver,
+    const bsl::shared_ptr<ntci::Reactor>&     reactor,
+    const bsl::shared_ptr<ntci::ReactorPool>& reactorPool,
+    const bsl::shared_ptr<ntcs::Metrics>&     metrics)
+{
+#if NTCR_STREAMSOCKET_OBSERVE_BY_WEAK_PTR
+    d_resolver    = bsl::weak_ptr<ntci::Resolver>(resolver);
+    d_reactor     = bsl::weak_ptr<ntci::Reactor>(reactor);
+    d_reactorPool = bsl::weak_ptr<ntci::ReactorPool>(reactorPool);
+#else
+    d_resolver    = resolver.get();
+    d_reactor     = reactor.get();
+    d_reactorPool = reactorPool.get();
+#endif
 
-    d_sendData_sp = d_dataPool_sp->createOutgoingData();
-    d_sendData_sp->makeConstBufferArray();
+    d_dataPool_sp              = reactor->dataPool();
+    d_incomingBufferFactory_sp = reactor->incomingBlobBufferFactory();
+    d_outgoingBufferFactory_sp = reactor->outgoingBlobBufferFactory();
 
-    d_receiveQueue.setData(d_dataPool_sp->createIncomingBlob());
-    d_receiveBlob_sp = d_dataPool_sp->createIncomingBlob();
+    d_oneShot      = reactor->oneShot();
+    d_creationTime = bdlt::CurrentTime::now();
+    d_options      = options;
 
-    d_receiveOptions.hideEndpoint();
+    this->privateInitialize(reactor, metrics);
+}
 
-    if (!d_options.writeQueueLowWatermark().isNull()) {
-        d_sendQueue.setLowWatermark(
-            d_options.writeQueueLowWatermark().value());
+void StreamSocket::clear()
+{
+    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
+        if (d_metrics_sp && !d_hibernating) {
+            ntcs::MonitorableUtil::deregisterMonitorable(d_metrics_sp);
+        }
     }
 
-    if (!d_options.writeQueueHighWatermark().isNull()) {
-        d_sendQueue.setHighWatermark(
-            d_options.writeQueueHighWatermark().value());
-    }
+    this->setReactorContext(bsl::shared_ptr<void>());
 
-    if (!d_options.sendGreedily().isNull()) {
-        d_sendGreedily = d_options.sendGreedily().value();
-    }
+    d_transport    = ntsa::Transport::e_UNDEFINED;
+    d_systemHandle = ntsa::k_INVALID_HANDLE;
+    d_systemSourceEndpoint.reset();
+    d_systemRemoteEndpoint.reset();
+    d_publicHandle = ntsa::k_INVALID_HANDLE;
+    d_publicSourceEndpoint.reset();
+    d_publicRemoteEndpoint.reset();
 
-    if (reactor->maxThreads() > 1) {
-        d_receiveQueue.setTrigger(ntca::ReactorEventTrigger::e_EDGE);
-    }
+    d_socket_sp.reset();
+    d_acceptor_sp.reset();
+    d_encryption_sp.reset();
 
-    if (!d_options.readQueueLowWatermark().isNull()) {
-        d_receiveQueue.setLowWatermark(
-            d_options.readQueueLowWatermark().value());
-    }
+    d_resolver.reset();
+    d_reactor.reset();
+    d_reactorPool.reset();
 
-    if (!d_options.readQueueHighWatermark().isNull()) {
-        d_receiveQueue.setHighWatermark(
-            d_options.readQueueHighWatermark().value());
-    }
+    d_reactorStrand_sp.reset();
+    d_manager_sp.reset();
+    d_managerStrand_sp.reset();
+    d_session_sp.reset();
+    d_sessionStrand_sp.reset();
+    d_dataPool_sp.reset();
+    d_incomingBufferFactory_sp.reset();
+    d_outgoingBufferFactory_sp.reset();
+    d_metrics_sp.reset();
 
-    if (!d_options.minIncomingStreamTransferSize().isNull()) {
-        d_receiveFeedback.setMinimum(
-            d_options.minIncomingStreamTransferSize().value());
-    }
+    d_tcpInfoSampler.reset();
+    d_tcpInfoTimer_sp.reset();
 
-    if (!d_options.maxIncomingStreamTransferSize().isNull()) {
-        d_receiveFeedback.setMaximum(
-            d_options.maxIncomingStreamTransferSize().value());
-    }
+    d_openState.set(ntcs::OpenState::e_DEFAULT);
+    d_flowControlState.reset();
+    d_shutdownState.reset();
 
-    if (!d_options.receiveGreedily().isNull()) {
-        d_receiveGreedily = d_options.receiveGreedily().value();
-    }
+    d_zeroCopyQueue.reset();
+    d_zeroCopyThreshold = k_ZERO_COPY_DEFAULT;
+
+    d_sendOptions.reset();
+    d_sendQueue.reset();
+    d_sendDeflater_sp.reset();
+    d_sendRateLimiter_sp.reset();
+    d_sendRateTimer_sp.reset();
+    d_sendGreedily = NTCCFG_DEFAULT_STREAM_SOCKET_WRITE_GREEDILY;
+    d_sendComplete.reset();
+    d_sendCounter = 0;
+    d_sendData_sp.reset();
+
+    d_receiveOptions.reset();
+    d_receiveQueue.reset();
+    d_receiveFeedback.reset();
+    d_receiveInflater_sp.reset();
+    d_receiveRateLimiter_sp.reset();
+    d_receiveRateTimer_sp.reset();
+    d_receiveGreedily = NTCCFG_DEFAULT_STREAM_SOCKET_READ_GREEDILY;
+    d_receiveBlob_sp.reset();
 
-    if (reactor->maxThreads() > 1) {
-        d_reactorStrand_sp = reactor->createStrand(d_allocator_p);
-    }
+    d_connectEndpointVector.clear();
+    d_connectName.clear();
+    d_connectStartTime = bsls::TimeInterval();
+    d_connectAttempts  = 0;
+    d_connectOptions.reset();
+    d_connectContext.reset();
+    d_connectCallback.reset();
+    d_connectDeadlineTimer_sp.reset();
+    d_connectRetryTimer_sp.reset();
+    d_connectResolutionTimer_sp.reset();
+    d_connectAttemptTimer_sp.reset();
+    d_connectHappyEyeballs.reset(
+        bdlb::NullableValue<ntsa::IpAddressType::Value>());
+    d_connectRateLimiter_sp.reset();
+    d_connectRateTimer_sp.reset();
+    d_connectInProgress = false;
 
-    if (!d_managerStrand_sp) {
-        d_managerStrand_sp = d_reactorStrand_sp;
-    }
+    d_upgradeOptions.reset();
+    d_upgradeCallback.reset();
+    d_upgradeTimer_sp.reset();
+    d_upgradeInProgress = false;
 
-    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
-        ntsa::Guid guid = ntsa::Guid::generate();
-        char       guidText[ntsa::Guid::SIZE_TEXT];
-        guid.writeText(guidText);
+    d_timestampOutgoingData = false;
+    d_timestampIncomingData = false;
+    d_timestampCorrelator.reset();
+    d_timestampCounter = 0;
 
-        bsl::string monitorableObjectName;
-        {
-            bsl::stringstream ss;
-            ss << "socket-";
-            ss.write(guidText, ntsa::Guid::SIZE_TEXT);
-            monitorableObjectName = ss.str();
-        }
+    d_retryConnect = false;
+    d_detachState.setMode(ntcs::DetachMode::e_IDLE);
+    d_detachState.setGoal(ntcs::DetachGoal::e_CLOSE);
+    d_closeCallback.reset();
+    d_deferredCalls.clear();
 
-        d_metrics_sp.createInplace(d_allocator_p,
-                                   "socket",
-                                   monitorableObjectName,
-                                   metrics,
-                                   d_allocator_p);
+    d_totalBytesSent     = 0;
+    d_totalBytesReceived = 0;
 
-        ntcs::MonitorableUtil::registerMonitorable(d_metrics_sp);
-    }
-    else {
-        d_metrics_sp = metrics;
-    }
-}
+    d_hibernationTimer_sp.reset();
+    d_hibernationActivity = 0;
+    d_hibernating         = false;
 
-StreamSocket::~StreamSocket()
-{
-    if (!d_options.metrics().isNull() && d_options.metrics().value()) {
-        if (d_metrics_sp) {
-            ntcs::MonitorableUtil::deregisterMonitorable(d_metrics_sp);
-        }
-    }
+    d_options = ntca::StreamSocketOptions();
 }
 
 ntsa::Error StreamSocket::open()
@@ -5716,6 +6803,16 @@ ntsa::Error StreamSocket::connect(const ntsa::Endpoint&        endpoint,
         }
     }
 
+    if (d_connectOptions.strategy().value_or(
+            ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) ==
+        ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS)
+    {
+        if (d_connectOptions.retryInterval().isNull()) {
+            d_connectOptions.setRetryInterval(
+                ntcs::HappyEyeballs::connectionAttemptDelay());
+        }
+    }
+
     if (d_connectOptions.retryCount().value() > 1) {
         if (d_connectOptions.retryInterval().isNull()) {
             d_connectOptions.setRetryInterval(bsls::TimeInterval(0));
@@ -5742,7 +6839,11 @@ ntsa::Error StreamSocket::connect(const ntsa::Endpoint&        endpoint,
             d_connectOptions.deadline().value());
     }
 
-    if (d_connectOptions.retryCount().value() == 1) {
+    if (d_connectOptions.retryCount().value() == 1 &&
+        d_connectOptions.strategy().value_or(
+            ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) !=
+            ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS)
+    {
         ntca::TimerOptions timerOptions;
         timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
         timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
@@ -5847,6 +6948,16 @@ ntsa::Error StreamSocket::connect(const bsl::string&           name,
                                        1);
     }
 
+    if (d_connectOptions.strategy().value_or(
+            ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) ==
+        ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS)
+    {
+        if (d_connectOptions.retryInterval().isNull()) {
+            d_connectOptions.setRetryInterval(
+                ntcs::HappyEyeballs::connectionAttemptDelay());
+        }
+    }
+
     if (d_connectOptions.retryCount().value() > 1) {
         if (d_connectOptions.retryInterval().isNull()) {
             d_connectOptions.setRetryInterval(bsls::TimeInterval(0));
@@ -5873,7 +6984,11 @@ ntsa::Error StreamSocket::connect(const bsl::string&           name,
             d_connectOptions.deadline().value());
     }
 
-    if (d_connectOptions.retryCount().value() == 1) {
+    if (d_connectOptions.retryCount().value() == 1 &&
+        d_connectOptions.strategy().value_or(
+            ntca::ConnectStrategy::e_RESOLVE_INTO_SINGLE) !=
+            ntca::ConnectStrategy::e_RESOLVE_INTO_HAPPY_EYEBALLS)
+    {
         ntca::TimerOptions timerOptions;
         timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
         timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
@@ -6102,6 +7217,10 @@ ntsa::Error StreamSocket::send(const bdlbb::Blob&        data,
     NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
     NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
 
+    NTCS_TRACE_EVENT(e_SEND_ENQUEUE,
+                     d_publicHandle,
+                     NTCCFG_WARNING_PROMOTE(bsl::size_t, data.length()));
+
     ntsa::Error error;
 
     ntcq::SendState state;
@@ -6111,6 +7230,10 @@ ntsa::Error StreamSocket::send(const bdlbb::Blob&        data,
         return ntsa::Error(ntsa::Error::e_INVALID);
     }
 
+    if (NTCCFG_UNLIKELY(d_hibernating)) {
+        this->privateHibernationLeave(self);
+    }
+
     bsl::size_t effectiveHighWatermark = d_sendQueue.highWatermark();
     if (!options.highWatermark().isNull()) {
         effectiveHighWatermark = options.highWatermark().value();
@@ -6229,6 +7352,8 @@ ntsa::Error StreamSocket::send(const ntsa::Data&         data,
     NTCI_LOG_CONTEXT_GUARD_SOURCE_ENDPOINT(d_systemSourceEndpoint);
     NTCI_LOG_CONTEXT_GUARD_REMOTE_ENDPOINT(d_systemRemoteEndpoint);
 
+    NTCS_TRACE_EVENT(e_SEND_ENQUEUE, d_publicHandle, data.size());
+
     ntsa::Error error;
 
     ntcq::SendState state;
@@ -6238,6 +7363,10 @@ ntsa::Error StreamSocket::send(const ntsa::Data&         data,
         return ntsa::Error(ntsa::Error::e_INVALID);
     }
 
+    if (NTCCFG_UNLIKELY(d_hibernating)) {
+        this->privateHibernationLeave(self);
+    }
+
     bsl::size_t effectiveHighWatermark = d_sendQueue.highWatermark();
     if (!options.highWatermark().isNull()) {
         effectiveHighWatermark = options.highWatermark().value();
@@ -6361,6 +7490,10 @@ ntsa::Error StreamSocket::receive(ntca::ReceiveContext*       context,
         return ntsa::Error(ntsa::Error::e_EOF);
     }
 
+    if (NTCCFG_UNLIKELY(d_hibernating)) {
+        this->privateHibernationLeave(self);
+    }
+
     if (NTCCFG_LIKELY(d_receiveQueue.size() >= options.minSize())) {
         BSLS_ASSERT(d_receiveQueue.hasEntry());
         BSLS_ASSERT(d_receiveQueue.size() ==
@@ -6465,8 +7598,10 @@ ntsa::Error StreamSocket::receive(ntca::ReceiveContext*       context,
 ntsa::Error StreamSocket::receive(const ntca::ReceiveOptions&  options,
                                   const ntci::ReceiveFunction& callback)
 {
-    return this->receive(options,
-                         this->createReceiveCallback(callback, d_allocator_p));
+    return this->receive(
+        options,
+        this->createReceiveCallback(callback,
+                                    d_receiveQueue.callbackAllocator()));
 }
 
 ntsa::Error StreamSocket::receive(const ntca::ReceiveOptions&  options,
@@ -6494,6 +7629,10 @@ ntsa::Error StreamSocket::receive(const ntca::ReceiveOptions&  options,
         return ntsa::Error(ntsa::Error::e_EOF);
     }
 
+    if (NTCCFG_UNLIKELY(d_hibernating)) {
+        this->privateHibernationLeave(self);
+    }
+
     bsl::shared_ptr<ntcq::ReceiveCallbackQueueEntry> callbackEntry =
         d_receiveQueue.createCallbackEntry();
     callbackEntry->assign(callback, options);
@@ -7502,16 +8641,27 @@ void StreamSocket::close(const ntci::CloseCallback& callback)
 
 void StreamSocket::execute(const Functor& functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ReactorSocket> self(this->weak_from_this());
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_reactorStrand_sp) {
-        d_reactorStrand_sp->execute(functor);
+        d_reactorStrand_sp->execute(target);
     }
     else {
         ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
         if (reactorRef) {
-            reactorRef->execute(functor);
+            reactorRef->execute(target);
         }
         else {
-            ntcs::Async::execute(functor);
+            ntcs::Async::execute(target);
         }
     }
 }
@@ -7519,16 +8669,28 @@ void StreamSocket::execute(const Functor& functor)
 void StreamSocket::moveAndExecute(FunctorSequence* functorSequence,
                                   const Functor&   functor)
 {
+    Functor attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ReactorSocket> self(this->weak_from_this());
+        ntcs::StallDetectorUtil::attribute(functorSequence, self);
+        attributed =
+            ntcs::StallDetectorUtil::attribute(ntcs::StallDetector::e_FUNCTION,
+                                               functor,
+                                               self);
+    }
+
+    const Functor& target = attributed ? attributed : functor;
+
     if (d_reactorStrand_sp) {
-        d_reactorStrand_sp->moveAndExecute(functorSequence, functor);
+        d_reactorStrand_sp->moveAndExecute(functorSequence, target);
     }
     else {
         ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
         if (reactorRef) {
-            reactorRef->moveAndExecute(functorSequence, functor);
+            reactorRef->moveAndExecute(functorSequence, target);
         }
         else {
-            ntcs::Async::moveAndExecute(functorSequence, functor);
+            ntcs::Async::moveAndExecute(functorSequence, target);
         }
     }
 }
@@ -7565,12 +8727,20 @@ bsl::shared_ptr<ntci::Timer> StreamSocket::createTimer(
     const ntci::TimerCallback& callback,
     bslma::Allocator*          basicAllocator)
 {
+    ntci::TimerCallback attributed;
+    if (NTCCFG_UNLIKELY(ntcs::StallDetector::isEnabled())) {
+        bsl::weak_ptr<ntci::ReactorSocket> self(this->weak_from_this());
+        attributed = ntcs::StallDetectorUtil::attribute(callback, self);
+    }
+
+    const ntci::TimerCallback& target = attributed ? attributed : callback;
+
     ntcs::ObserverRef<ntci::Reactor> reactorRef(&d_reactor);
     if (reactorRef) {
-        return reactorRef->createTimer(options, callback, basicAllocator);
+        return reactorRef->createTimer(options, target, basicAllocator);
     }
     else {
-        return ntcs::Async::createTimer(options, callback, basicAllocator);
+        return ntcs::Async::createTimer(options, target, basicAllocator);
     }
 }
 
@@ -7856,5 +9026,30 @@ void StreamSocket::getInfo(ntsa::SocketInfo* result) const
     result->setReceiveQueueSize(receiveQueueSize);
 }
 
+bsl::string StreamSocket::metricsName() const
+{
+    LockGuard lock(&d_mutex);
+
+    if (!d_options.metrics().isNull() && d_options.metrics().value() &&
+        !d_hibernating && d_metrics_sp)
+    {
+        return bsl::string(d_metrics_sp->objectName());
+    }
+
+    return bsl::string();
+}
+
+bsl::size_t StreamSocket::residentBytes() const
+{
+    LockGuard lock(&d_mutex);
+    return this->privateResidentBytes();
+}
+
+bool StreamSocket::isHibernating() const
+{
+    LockGuard lock(&d_mutex);
+    return d_hibernating;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
@@ -40,11 +40,13 @@ BSLS_IDENT("$Id: $")
 #include <ntcs_detachstate.h>
 #include <ntcs_flowcontrolcontext.h>
 #include <ntcs_flowcontrolstate.h>
+#include <ntcs_happyeyeballs.h>
 #include <ntcs_metrics.h>
 #include <ntcs_observer.h>
 #include <ntcs_openstate.h>
 #include <ntcs_shutdowncontext.h>
 #include <ntcs_shutdownstate.h>
+#include <ntcs_tcpinfosampler.h>
 #include <ntcscm_version.h>
 #include <ntcu_timestampcorrelator.h>
 #include <ntsa_buffer.h>
@@ -114,6 +116,8 @@ class StreamSocket : public ntci::StreamSocket,
     BlobBufferFactoryPtr                       d_incomingBufferFactory_sp;
     BlobBufferFactoryPtr                       d_outgoingBufferFactory_sp;
     bsl::shared_ptr<ntcs::Metrics>             d_metrics_sp;
+    ntcs::TcpInfoSampler                       d_tcpInfoSampler;
+    bsl::shared_ptr<ntci::Timer>               d_tcpInfoTimer_sp;
     ntcs::OpenState                            d_openState;
     ntcs::FlowControlState                     d_flowControlState;
     ntcs::ShutdownState                        d_shutdownState;
@@ -145,6 +149,9 @@ class StreamSocket : public ntci::StreamSocket,
     ntci::ConnectCallback                      d_connectCallback;
     bsl::shared_ptr<ntci::Timer>               d_connectDeadlineTimer_sp;
     bsl::shared_ptr<ntci::Timer>               d_connectRetryTimer_sp;
+    bsl::shared_ptr<ntci::Timer>               d_connectResolutionTimer_sp;
+    bsl::shared_ptr<ntci::Timer>               d_connectAttemptTimer_sp;
+    ntcs::HappyEyeballs                        d_connectHappyEyeballs;
     bsl::shared_ptr<ntci::RateLimiter>         d_connectRateLimiter_sp;
     bsl::shared_ptr<ntci::Timer>               d_connectRateTimer_sp;
     bool                                       d_connectInProgress;
@@ -156,7 +163,7 @@ class StreamSocket : public ntci::StreamSocket,
     bool                                       d_timestampIncomingData;
     ntcu::TimestampCorrelator                  d_timestampCorrelator;
     bsl::uint32_t                              d_timestampCounter;
-    const bool                                 d_oneShot;
+    bool                                       d_oneShot;
     bool                                       d_retryConnect;
     ntcs::DetachState                          d_detachState;
     ntci::CloseCallback                        d_closeCallback;
@@ -164,6 +171,9 @@ class StreamSocket : public ntci::StreamSocket,
     bsl::size_t                                d_totalBytesSent;
     bsl::size_t                                d_totalBytesReceived;
     bsls::TimeInterval                         d_creationTime;
+    bsl::shared_ptr<ntci::Timer>               d_hibernationTimer_sp;
+    bsl::size_t                                d_hibernationActivity;
+    bool                                       d_hibernating;
     ntca::StreamSocketOptions                  d_options;
     bslma::Allocator*                          d_allocator_p;
 
@@ -203,6 +213,18 @@ class StreamSocket : public ntci::StreamSocket,
     void processConnectRetryTimer(const bsl::shared_ptr<ntci::Timer>& timer,
                                   const ntca::TimerEvent&             event);
 
+    /// Begin the "Happy Eyeballs" connection attempts with the IPv4
+    /// addresses resolved so far, having waited the resolution delay for
+    /// the IPv6 addresses.
+    void processConnectResolutionTimer(
+        const bsl::shared_ptr<ntci::Timer>& timer,
+        const ntca::TimerEvent&             event);
+
+    /// Poll the "Happy Eyeballs" connection attempts raced on auxiliary
+    /// descriptors, adopting the first to connect.
+    void processConnectAttemptTimer(const bsl::shared_ptr<ntci::Timer>& timer,
+                                    const ntca::TimerEvent& event);
+
     /// Fail the current upgrade operation.
     void processUpgradeTimer(const bsl::shared_ptr<ntci::Timer>& timer,
                              const ntca::TimerEvent&             event);
@@ -224,6 +246,18 @@ class StreamSocket : public ntci::StreamSocket,
     void processReceiveRateTimer(const bsl::shared_ptr<ntci::Timer>& timer,
                                  const ntca::TimerEvent&             event);
 
+    /// Sample the TCP state of the connection, if the sampling interval has
+    /// elapsed since the previous sample, so that an idle connection is
+    /// sampled even though no send or receive completes.
+    void processTcpInfoTimer(const bsl::shared_ptr<ntci::Timer>& timer,
+                             const ntca::TimerEvent&             event);
+
+    /// Hibernate the socket if no data has been sent or received since the
+    /// hibernation timer was last scheduled and the socket is otherwise
+    /// idle, or reschedule the hibernation timer.
+    void processHibernationTimer(const bsl::shared_ptr<ntci::Timer>& timer,
+                                 const ntca::TimerEvent&             event);
+
     /// Fail the specified 'entry' because the operation did not complete
     /// within the deadline.
     void processReceiveDeadlineTimer(
@@ -541,6 +575,19 @@ class StreamSocket : public ntci::StreamSocket,
         const ntca::GetEndpointEvent&          getEndpointEvent,
         bsl::size_t                            connectAttempts);
 
+    /// Process the resolution of the remote name into its addresses of the
+    /// specified 'ipAddressType' by the specified 'resolver' according to
+    /// the specified 'getEndpointEvent', as part of the "Happy Eyeballs"
+    /// resolutions of the specified 'generation'. Begin the connection
+    /// attempts, if appropriate, or merge the resolved endpoints into the
+    /// endpoints remaining to be tried, if attempts have already begun.
+    void processRemoteEndpointFamilyResolution(
+        const bsl::shared_ptr<ntci::Resolver>& resolver,
+        const ntsa::Endpoint&                  endpoint,
+        const ntca::GetEndpointEvent&          getEndpointEvent,
+        bsl::uint64_t                          generation,
+        ntsa::IpAddressType::Value             ipAddressType);
+
     /// Initiate the upgrade. Return the error.
     ntsa::Error privateUpgrade(const bsl::shared_ptr<StreamSocket>& self,
                                const ntca::UpgradeOptions& upgradeOptions);
@@ -558,6 +605,12 @@ class StreamSocket : public ntci::StreamSocket,
     /// Retry connecting to the remote peer.
     void privateRetryConnect(const bsl::shared_ptr<StreamSocket>& self);
 
+    /// Schedule the TCP state of the connection to be sampled periodically,
+    /// creating the timer if necessary. The behavior is a no-op if the
+    /// socket has no metrics, is not a TCP socket, or the TCP state of the
+    /// connection cannot be sampled.
+    void privateTcpInfoArm(const bsl::shared_ptr<StreamSocket>& self);
+
     /// Retry connecting to the remote name.
     void privateRetryConnectToName(const bsl::shared_ptr<StreamSocket>& self);
 
@@ -565,6 +618,38 @@ class StreamSocket : public ntci::StreamSocket,
     void privateRetryConnectToEndpoint(
         const bsl::shared_ptr<StreamSocket>& self);
 
+    /// Retry connecting to the remote name by resolving its IPv6 and IPv4
+    /// addresses in parallel, according to the "Happy Eyeballs" strategy.
+    void privateRetryConnectToNameHappyEyeballs(
+        const bsl::shared_ptr<StreamSocket>& self);
+
+    /// Begin the "Happy Eyeballs" connection attempts to the endpoints
+    /// resolved so far, interleaved by address family.
+    void privateStartConnectHappyEyeballs(
+        const bsl::shared_ptr<StreamSocket>& self);
+
+    /// Begin a connection attempt to the next "Happy Eyeballs" endpoint on
+    /// an auxiliary descriptor, leaving the attempt in progress undisturbed.
+    void privateRaceConnect(const bsl::shared_ptr<StreamSocket>& self);
+
+    /// Abandon the connection attempt in progress, if any, and continue
+    /// with the specified 'streamSocket' connected to the specified
+    /// 'endpoint' on an auxiliary descriptor. If it is required to detach
+    /// the socket from the reactor then part of described functionality
+    /// will be executed asynchronously using the next method.
+    void privateAdoptConnectAttempt(
+        const bsl::shared_ptr<StreamSocket>&       self,
+        const bsl::shared_ptr<ntsi::StreamSocket>& streamSocket,
+        const ntsa::Endpoint&                      endpoint);
+
+    /// Execute the second part of adopting a connection attempt when the
+    /// socket is detached. See also "privateAdoptConnectAttempt".
+    void privateAdoptConnectAttemptPart2(
+        const bsl::shared_ptr<StreamSocket>&       self,
+        const bsl::shared_ptr<ntsi::StreamSocket>& streamSocket,
+        const ntsa::Endpoint&                      endpoint,
+        bool                                       lock);
+
     /// Enable or disable timestamping of outgoing data according to the
     /// specified 'enable' flag. Return the error.
     ntsa::Error privateTimestampOutgoingData(
@@ -597,6 +682,36 @@ class StreamSocket : public ntci::StreamSocket,
     void privateClose(const bsl::shared_ptr<StreamSocket>& self,
                       const ntci::CloseCallback&           callback);
 
+    /// Schedule the hibernation timer to fire after the configured period of
+    /// inactivity, creating the timer if necessary. The behavior is a no-op
+    /// if hibernation is not enabled.
+    void privateHibernationArm(const bsl::shared_ptr<StreamSocket>& self);
+
+    /// Release the blob buffers retained by the empty read and write queues
+    /// back to their pools, close the idle rate timers, the hibernation
+    /// timer, and the TCP state sampling timer, and collapse per-socket
+    /// metrics into their parent.
+    void privateHibernationEnter(const bsl::shared_ptr<StreamSocket>& self);
+
+    /// Restore the per-socket metrics and re-arm the hibernation timer and
+    /// the TCP state sampling timer. The released blob buffers are lazily
+    /// re-acquired when next needed.
+    void privateHibernationLeave(const bsl::shared_ptr<StreamSocket>& self);
+
+    /// Create and register per-socket metrics that aggregate into the
+    /// specified 'parent', if any.
+    void privateMetricsCreate(const bsl::shared_ptr<ntcs::Metrics>& parent);
+
+    /// Return the number of bytes of blob buffer capacity and per-socket
+    /// metrics retained by this socket.
+    bsl::size_t privateResidentBytes() const;
+
+    /// Initialize the queues, strands, and metrics of this object according
+    /// to its options, driven by the specified 'reactor' and aggregating
+    /// metrics into the specified 'metrics'.
+    void privateInitialize(const bsl::shared_ptr<ntci::Reactor>& reactor,
+                           const bsl::shared_ptr<ntcs::Metrics>& metrics);
+
   public:
     /// Create a new, initially uninitilialized stream socket. Optionally
     /// specify a 'basicAllocator' used to supply memory. If
@@ -613,6 +728,24 @@ class StreamSocket : public ntci::StreamSocket,
     /// Destroy this object.
     ~StreamSocket() BSLS_KEYWORD_OVERRIDE;
 
+    /// Reinitialize this object, previously cleared, as if it were newly
+    /// constructed with the specified 'options', 'resolver', 'reactor',
+    /// 'reactorPool', and 'metrics'. The behavior is undefined unless
+    /// 'clear' has been called since this object was last used and
+    /// 'reactor' supplies the same data pool as the reactor with which this
+    /// object was constructed.
+    void reset(const ntca::StreamSocketOptions&          options,
+               const bsl::shared_ptr<ntci::Resolver>&    resolver,
+               const bsl::shared_ptr<ntci::Reactor>&     reactor,
+               const bsl::shared_ptr<ntci::ReactorPool>& reactorPool,
+               const bsl::shared_ptr<ntcs::Metrics>&     metrics);
+
+    /// Release every resource held by this object, as its destructor would,
+    /// leaving this object ready to be reinitialized by 'reset'. The
+    /// behavior is undefined unless no other reference to this object
+    /// remains.
+    void clear();
+
     /// Open the stream socket. Return the error.
     ntsa::Error open() BSLS_KEYWORD_OVERRIDE;
 
@@ -1491,6 +1624,21 @@ class StreamSocket : public ntci::StreamSocket,
     /// Load into the specified 'result' the information describing the
     /// state of this socket.
     void getInfo(ntsa::SocketInfo* result) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the name under which the statistics of this socket are
+    /// published, or the empty string if the statistics of this socket are
+    /// not published separately from those of its parent.
+    bsl::string metricsName() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the number of bytes of blob buffer capacity retained by the
+    /// read and write queues of this socket, plus the footprint of its
+    /// per-socket metrics, if any.
+    bsl::size_t residentBytes() const;
+
+    /// Return true if the socket has been idle for the configured
+    /// hibernation timeout and has released its idle resources, otherwise
+    /// return false.
+    bool isHibernating() const;
 };
 
 }  // close package namespace
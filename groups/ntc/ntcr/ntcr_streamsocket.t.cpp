@@ -40,6 +40,7 @@ BSLS_IDENT_RCSID(ntcr_streamsocket_t_cpp, "$Id$ $CSID$")
 #include <ntsa_transport.h>
 #include <ntscfg_mock.h>
 #include <ntsi_streamsocket.h>
+#include <bdlbb_blobutil.h>
 
 using namespace BloombergLP;
 
@@ -123,6 +124,22 @@ class StreamSocketTest
         const StreamSocketTest::Parameters&   parameters,
         bslma::Allocator*                     allocator);
 
+    // Execute the concern with the specified 'parameters' for the specified
+    // 'transport' using the specified 'reactor'.
+    static void verifyHibernationVariation(
+        ntsa::Transport::Value                transport,
+        const bsl::shared_ptr<ntci::Reactor>& reactor,
+        const StreamSocketTest::Parameters&   parameters,
+        bslma::Allocator*                     allocator);
+
+    // Receive exactly the specified 'size' bytes from the specified
+    // 'streamSocket' into the specified 'result', polling until the data
+    // arrives.
+    static void receiveExactly(
+        bdlbb::Blob*                               result,
+        const bsl::shared_ptr<ntcr::StreamSocket>& streamSocket,
+        bsl::size_t                                size);
+
     // Process the expected send timeout.
     static void processSendTimeout(
         const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
@@ -269,6 +286,10 @@ class StreamSocketTest
     // Concern: Receive cancellation.
     static void verifyReceiveCancellation();
 
+    // Concern: Idle sockets hibernate and wake transparently on activity,
+    // collapsing their per-socket metrics into their parent.
+    static void verifyHibernation();
+
     // Concern: Write queue high watermark event can be overriden on a
     // per-send basis.
     static void verifyWriteQueueHighWatermarkOverride();
@@ -2462,6 +2483,144 @@ void StreamSocketTest::verifyReceiveDeadlineVariation(
     reactor->stop();
 }
 
+void StreamSocketTest::receiveExactly(
+    bdlbb::Blob*                               result,
+    const bsl::shared_ptr<ntcr::StreamSocket>& streamSocket,
+    bsl::size_t                                size)
+{
+    while (true) {
+        ntca::ReceiveOptions receiveOptions;
+        receiveOptions.setMinSize(size);
+        receiveOptions.setMaxSize(size);
+
+        ntca::ReceiveContext receiveContext;
+
+        ntsa::Error error =
+            streamSocket->receive(&receiveContext, result, receiveOptions);
+        if (error == ntsa::Error::e_WOULD_BLOCK) {
+            bslmt::ThreadUtil::microSleep(1000);
+            continue;
+        }
+
+        NTSCFG_TEST_OK(error);
+        NTSCFG_TEST_EQ(static_cast<bsl::size_t>(result->length()), size);
+        break;
+    }
+}
+
+void StreamSocketTest::verifyHibernationVariation(
+    ntsa::Transport::Value                transport,
+    const bsl::shared_ptr<ntci::Reactor>& reactor,
+    const StreamSocketTest::Parameters&   parameters,
+    bslma::Allocator*                     allocator)
+{
+    // Concern: Idle sockets hibernate and wake transparently on activity,
+    // collapsing their per-socket metrics into their parent.
+
+    NTCI_LOG_CONTEXT();
+
+    NTCI_LOG_DEBUG("Stream socket hibernation test starting");
+
+    const int         k_HIBERNATION_TIMEOUT_IN_MILLISECONDS = 50;
+    const bsl::size_t k_MESSAGE_SIZE                        = 1024;
+
+    ntsa::Error                     error;
+    bsl::shared_ptr<ntcs::Metrics>  metrics;
+    bsl::shared_ptr<ntci::Resolver> resolver;
+
+    bsls::TimeInterval hibernationTimeout;
+    hibernationTimeout.setTotalMilliseconds(
+        k_HIBERNATION_TIMEOUT_IN_MILLISECONDS);
+
+    metrics.createInplace(allocator, "test", "test", allocator);
+
+    bsl::shared_ptr<ntcr::StreamSocket> clientStreamSocket;
+    bsl::shared_ptr<ntcr::StreamSocket> serverStreamSocket;
+    {
+        ntca::StreamSocketOptions options;
+        options.setTransport(transport);
+        options.setHibernationTimeout(hibernationTimeout);
+        options.setMetrics(true);
+
+        bsl::shared_ptr<ntcd::StreamSocket> basicClientSocket;
+        bsl::shared_ptr<ntcd::StreamSocket> basicServerSocket;
+
+        error = ntcd::Simulation::createStreamSocketPair(&basicClientSocket,
+                                                         &basicServerSocket,
+                                                         transport);
+        NTSCFG_TEST_FALSE(error);
+
+        clientStreamSocket.createInplace(allocator,
+                                         options,
+                                         resolver,
+                                         reactor,
+                                         reactor,
+                                         metrics,
+                                         allocator);
+
+        error = clientStreamSocket->open(transport, basicClientSocket);
+        NTSCFG_TEST_FALSE(error);
+
+        serverStreamSocket.createInplace(allocator,
+                                         options,
+                                         resolver,
+                                         reactor,
+                                         reactor,
+                                         metrics,
+                                         allocator);
+
+        error = serverStreamSocket->open(transport, basicServerSocket);
+        NTSCFG_TEST_FALSE(error);
+    }
+
+    for (bsl::size_t round = 0; round < 2; ++round) {
+        bdlbb::Blob data(clientStreamSocket->outgoingBlobBufferFactory().get(),
+                         allocator);
+        ntcd::DataUtil::generateData(&data, k_MESSAGE_SIZE);
+
+        error = clientStreamSocket->send(data, ntca::SendOptions());
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_FALSE(clientStreamSocket->isHibernating());
+
+        bdlbb::Blob received(
+            serverStreamSocket->incomingBlobBufferFactory().get(),
+            allocator);
+
+        StreamSocketTest::receiveExactly(&received,
+                                         serverStreamSocket,
+                                         k_MESSAGE_SIZE);
+
+        NTSCFG_TEST_EQ(bdlbb::BlobUtil::compare(data, received), 0);
+
+        const bsl::size_t residentBytes = serverStreamSocket->residentBytes();
+
+        while (!clientStreamSocket->isHibernating() ||
+               !serverStreamSocket->isHibernating())
+        {
+            bslmt::ThreadUtil::microSleep(
+                k_HIBERNATION_TIMEOUT_IN_MILLISECONDS * 1000 / 5);
+        }
+
+        // The per-socket metrics of a hibernating socket are collapsed into
+        // the parent, so the resident bytes strictly decrease.
+
+        NTSCFG_TEST_LT(serverStreamSocket->residentBytes(), residentBytes);
+    }
+
+    {
+        ntci::StreamSocketCloseGuard clientStreamSocketCloseGuard(
+            clientStreamSocket);
+
+        ntci::StreamSocketCloseGuard serverStreamSocketCloseGuard(
+            serverStreamSocket);
+    }
+
+    NTCI_LOG_DEBUG("Stream socket hibernation test complete");
+
+    reactor->stop();
+}
+
 void StreamSocketTest::verifyReceiveCancellationVariation(
     ntsa::Transport::Value                transport,
     const bsl::shared_ptr<ntci::Reactor>& reactor,
@@ -3194,6 +3353,18 @@ NTSCFG_TEST_FUNCTION(ntcr::StreamSocketTest::verifyReceiveDeadline)
                     NTCCFG_BIND_PLACEHOLDER_3));
 }
 
+NTSCFG_TEST_FUNCTION(ntcr::StreamSocketTest::verifyHibernation)
+{
+    StreamSocketTest::Parameters parameters;
+
+    StreamSocketTest::Framework::execute(
+        NTCCFG_BIND(&StreamSocketTest::verifyHibernationVariation,
+                    NTCCFG_BIND_PLACEHOLDER_1,
+                    NTCCFG_BIND_PLACEHOLDER_2,
+                    parameters,
+                    NTCCFG_BIND_PLACEHOLDER_3));
+}
+
 NTSCFG_TEST_FUNCTION(ntcr::StreamSocketTest::verifySendCancellation)
 {
     StreamSocketTest::Parameters parameters;
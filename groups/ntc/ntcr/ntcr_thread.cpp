@@ -30,6 +30,7 @@ BSLS_IDENT_RCSID(ntcr_thread_cpp, "$Id$ $CSID$")
 #include <ntcs_metrics.h>
 #include <ntcs_nomenclature.h>
 #include <ntcs_reactormetrics.h>
+#include <ntcs_threadmetrics.h>
 #include <ntcs_threadutil.h>
 
 #include <bdlf_bind.h>
@@ -70,9 +71,23 @@ void* Thread::run(ntcr::Thread* thread)
     NTCI_LOG_TRACE("Thread '%s' has started",
                    thread->d_config.threadName().value().c_str());
 
+    // Measure the resource usage of this thread, which must be measured
+    // from the thread itself.
+
+    bsl::shared_ptr<ntcs::ThreadMetrics> threadMetrics;
+    if (thread->d_config.metricCollection().value()) {
+        threadMetrics.createInplace(thread->d_allocator_p,
+                                    "thread.usage",
+                                    thread->d_config.metricName().value(),
+                                    thread->d_allocator_p);
+
+        ntcs::MonitorableUtil::registerMonitorable(threadMetrics);
+    }
+
     {
         ntccfg::ConditionMutexGuard guard(&thread->d_runMutex);
-        thread->d_runState = k_RUN_STATE_STARTED;
+        thread->d_threadMetrics_sp = threadMetrics;
+        thread->d_runState         = k_RUN_STATE_STARTED;
         thread->d_runCondition.signal();
     }
 
@@ -80,6 +95,13 @@ void* Thread::run(ntcr::Thread* thread)
     thread->d_reactor_sp->drainFunctions();
     thread->d_reactor_sp->deregisterWaiter(waiter);
 
+    if (threadMetrics) {
+        ntcs::MonitorableUtil::deregisterMonitorable(threadMetrics);
+
+        ntccfg::ConditionMutexGuard guard(&thread->d_runMutex);
+        thread->d_threadMetrics_sp.reset();
+    }
+
     return 0;
 }
 
@@ -167,6 +189,7 @@ Thread::Thread(const ntca::ThreadConfig&                    configuration,
 , d_runMutex()
 , d_runCondition()
 , d_runState(k_RUN_STATE_STOPPED)
+, d_threadMetrics_sp()
 , d_config(configuration, basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
@@ -195,6 +218,10 @@ Thread::Thread(const ntca::ThreadConfig&                    configuration,
         reactorConfig.setMaxCyclesPerWait(d_config.maxCyclesPerWait().value());
     }
 
+    if (!d_config.stallThreshold().isNull()) {
+        reactorConfig.setStallThreshold(d_config.stallThreshold().value());
+    }
+
     if (!d_config.metricCollection().isNull()) {
         reactorConfig.setMetricCollection(d_config.metricCollection().value());
     }
@@ -229,6 +256,7 @@ Thread::Thread(const ntca::ThreadConfig&             configuration,
 , d_runMutex()
 , d_runCondition()
 , d_runState(k_RUN_STATE_STOPPED)
+, d_threadMetrics_sp()
 , d_config(configuration, basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
@@ -413,6 +441,17 @@ bsl::size_t Thread::threadIndex() const
     return 0;
 }
 
+double Thread::utilization() const
+{
+    ntccfg::ConditionMutexGuard guard(&d_runMutex);
+
+    if (d_threadMetrics_sp) {
+        return d_threadMetrics_sp->utilization();
+    }
+
+    return 0;
+}
+
 const bsl::shared_ptr<ntci::Strand>& Thread::strand() const
 {
     return ntci::Strand::unspecified();
@@ -22,6 +22,7 @@ BSLS_IDENT_RCSID(ntcs_chronology_cpp, "$Id$ $CSID$")
 #include <ntccfg_bind.h>
 #include <ntci_log.h>
 #include <ntcs_dispatch.h>
+#include <ntcs_tracer.h>
 #include <ntsa_error.h>
 #include <bdlt_currenttime.h>
 #include <bdlt_datetime.h>
@@ -1100,6 +1101,11 @@ bsl::shared_ptr<ntci::Timer> Chronology::createTimer(
 }
 
 void Chronology::announce(bool single)
+{
+    this->announce(single, 0);
+}
+
+void Chronology::announce(bool single, ntcs::LoopProfiler* profiler)
 {
     // This method contains a while loop wich iterates over all timers in
     // 'd_deadlineMap' which are due now.  During this iteration non recurring
@@ -1130,6 +1136,10 @@ void Chronology::announce(bool single)
 
     bool done = false;
 
+    if (profiler != 0) {
+        profiler->enter(ntcs::LoopProfilerIteration::e_TIMERS);
+    }
+
     {
         LockGuard lock(&d_mutex);
 
@@ -1248,17 +1258,31 @@ void Chronology::announce(bool single)
     }
 
     if (!functorsDue.isNull()) {
+        if (profiler != 0) {
+            profiler->enter(ntcs::LoopProfilerIteration::e_FUNCTIONS);
+        }
+
         FunctorQueue::iterator it = functorsDue.value().begin();
         FunctorQueue::iterator et = functorsDue.value().end();
 
         while (it != et) {
             Functor& functor = *it;
-            functor();
+            {
+                ntcs::StallDetectorGuard stallGuard(
+                    ntcs::StallDetector::e_FUNCTION,
+                    0);
+                NTCS_TRACE_SCOPE(e_FUNCTION, ntsa::k_INVALID_HANDLE, 0);
+                functor();
+            }
             functor = Functor();
             ++it;
         }
 
         functorsDue.value().clear();
+
+        if (profiler != 0) {
+            profiler->enter(ntcs::LoopProfilerIteration::e_TIMERS);
+        }
     }
 
     if (!timersDue.empty()) {
@@ -1271,6 +1295,10 @@ void Chronology::announce(bool single)
             TimerRep* timerRep = dueEntry.d_node_p->d_storage.address();
             Timer*    timer    = timerRep->getObject();
 
+            ntcs::StallDetectorGuard stallGuard(ntcs::StallDetector::e_TIMER,
+                                                0);
+            NTCS_TRACE_SCOPE(e_TIMER, ntsa::k_INVALID_HANDLE, 0);
+
             timer->arrive(bsl::shared_ptr<ntci::Timer>(
                               static_cast<ntci::Timer*>(timer),
                               static_cast<bslma::SharedPtrRep*>(timerRep)),
@@ -28,7 +28,9 @@ BSLS_IDENT("$Id: $")
 #include <ntci_timercallback.h>
 #include <ntci_timersession.h>
 #include <ntcs_driver.h>
+#include <ntcs_loopprofiler.h>
 #include <ntcs_skiplist.h>
+#include <ntcs_stalldetector.h>
 #include <ntcscm_version.h>
 #include <bdlb_nullablevalue.h>
 #include <bdlma_concurrentmultipoolallocator.h>
@@ -544,6 +546,13 @@ class Chronology NTSCFG_FINAL : public ntci::Chronology
     /// timer whose deadline is earlier than or equal to the current time.
     void announce(bool single = false) BSLS_KEYWORD_OVERRIDE;
 
+    /// Invoke all deferred functions and announce the deadline event of any
+    /// timer whose deadline is earlier than or equal to the current time.
+    /// If the specified 'profiler' is not null, attribute the time spent
+    /// invoking deferred functions and announcing timers to the
+    /// corresponding phases of the current iteration of 'profiler'.
+    void announce(bool single, ntcs::LoopProfiler* profiler);
+
     /// Invoke all deferred functions.
     void drain() BSLS_KEYWORD_OVERRIDE;
 
@@ -172,6 +172,18 @@ void Compat::sanitize(ntca::InterfaceConfig* config)
         }
     }
 
+    if (config->socketRecycling().isNull()) {
+        bool socketRecycling;
+        if (ntccfg::Tune::configure(&socketRecycling, "NTC_SOCKET_RECYCLING"))
+        {
+            config->setSocketRecycling(socketRecycling);
+            NTCI_LOG_WARN("Recycling sockets '%d'", (int)(socketRecycling));
+        }
+        else {
+            config->setSocketRecycling(NTCCFG_DEFAULT_SOCKET_RECYCLING);
+        }
+    }
+
     if (!config->driverMetricsPerWaiter().isNull() &&
         config->driverMetricsPerWaiter().value())
     {
@@ -332,6 +344,10 @@ void Compat::convert(ntca::StreamSocketOptions*         result,
         result->setZeroCopyThreshold(options.zeroCopyThreshold().value());
     }
 
+    if (!options.hibernationTimeout().isNull()) {
+        result->setHibernationTimeout(options.hibernationTimeout().value());
+    }
+
     result->setLoadBalancingOptions(options.loadBalancingOptions());
 
     if (!options.compressionConfig().isNull()) {
@@ -470,6 +486,10 @@ void Compat::convert(ntca::ListenerSocketOptions*     result,
         result->setZeroCopyThreshold(options.zeroCopyThreshold().value());
     }
 
+    if (!options.hibernationTimeout().isNull()) {
+        result->setHibernationTimeout(options.hibernationTimeout().value());
+    }
+
     result->setLoadBalancingOptions(options.loadBalancingOptions());
 
     if (!options.compressionConfig().isNull()) {
@@ -2427,14 +2427,18 @@ void Dispatch::announceAccepted(
     const bsl::shared_ptr<ntci::Strand>&         destination)
 {
     if (NTCCFG_LIKELY(!destination)) {
+        ntcs::StallDetectorGuard stallGuard(ntcs::StallDetector::e_ACCEPTED,
+                                            socket.get());
         socket->processSocketAccepted(error, streamSocket);
     }
     else {
-        destination->execute(
+        destination->execute(ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_ACCEPTED,
             NTCCFG_BIND(&ntci::ProactorSocket::processSocketAccepted,
                         socket,
                         error,
-                        streamSocket));
+                        streamSocket),
+            socket));
     }
 }
 
@@ -2444,13 +2448,17 @@ void Dispatch::announceConnected(
     const bsl::shared_ptr<ntci::Strand>&         destination)
 {
     if (NTCCFG_LIKELY(!destination)) {
+        ntcs::StallDetectorGuard stallGuard(ntcs::StallDetector::e_CONNECTED,
+                                            socket.get());
         socket->processSocketConnected(error);
     }
     else {
-        destination->execute(
+        destination->execute(ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_CONNECTED,
             NTCCFG_BIND(&ntci::ProactorSocket::processSocketConnected,
                         socket,
-                        error));
+                        error),
+            socket));
     }
 }
 
@@ -2461,14 +2469,18 @@ void Dispatch::announceReceived(
     const bsl::shared_ptr<ntci::Strand>&         destination)
 {
     if (NTCCFG_LIKELY(!destination)) {
+        ntcs::StallDetectorGuard stallGuard(ntcs::StallDetector::e_RECEIVED,
+                                            socket.get());
         socket->processSocketReceived(error, context);
     }
     else {
-        destination->execute(
+        destination->execute(ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_RECEIVED,
             NTCCFG_BIND(&ntci::ProactorSocket::processSocketReceived,
                         socket,
                         error,
-                        context));
+                        context),
+            socket));
     }
 }
 
@@ -2479,14 +2491,18 @@ void Dispatch::announceSent(
     const bsl::shared_ptr<ntci::Strand>&         destination)
 {
     if (NTCCFG_LIKELY(!destination)) {
+        ntcs::StallDetectorGuard stallGuard(ntcs::StallDetector::e_SENT,
+                                            socket.get());
         socket->processSocketSent(error, context);
     }
     else {
-        destination->execute(
+        destination->execute(ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_SENT,
             NTCCFG_BIND(&ntci::ProactorSocket::processSocketSent,
                         socket,
                         error,
-                        context));
+                        context),
+            socket));
     }
 }
 
@@ -2496,13 +2512,17 @@ void Dispatch::announceError(
     const bsl::shared_ptr<ntci::Strand>&         destination)
 {
     if (NTCCFG_LIKELY(!destination)) {
+        ntcs::StallDetectorGuard stallGuard(ntcs::StallDetector::e_ERROR,
+                                            socket.get());
         socket->processSocketError(error);
     }
     else {
-        destination->execute(
+        destination->execute(ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_ERROR,
             NTCCFG_BIND(&ntci::ProactorSocket::processSocketError,
                         socket,
-                        error));
+                        error),
+            socket));
     }
 }
 
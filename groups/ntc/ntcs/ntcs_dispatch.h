@@ -34,6 +34,7 @@ BSLS_IDENT("$Id: $")
 #include <ntci_streamsocketsession.h>
 #include <ntci_timer.h>
 #include <ntci_timersession.h>
+#include <ntcs_stalldetector.h>
 #include <ntcscm_version.h>
 #include <bslmt_mutex.h>
 #include <bsl_memory.h>
@@ -1744,13 +1745,17 @@ void Dispatch::announceReadable(
     const bsl::shared_ptr<ntci::Strand>&        destination)
 {
     if (NTCCFG_LIKELY(!destination)) {
+        ntcs::StallDetectorGuard stallGuard(ntcs::StallDetector::e_READABLE,
+                                            socket.get());
         socket->processSocketReadable(event);
     }
     else {
-        destination->execute(
+        destination->execute(ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_READABLE,
             NTCCFG_BIND(&ntci::ReactorSocket::processSocketReadable,
                         socket,
-                        event));
+                        event),
+            socket));
     }
 }
 
@@ -1761,13 +1766,17 @@ void Dispatch::announceWritable(
     const bsl::shared_ptr<ntci::Strand>&        destination)
 {
     if (NTCCFG_LIKELY(!destination)) {
+        ntcs::StallDetectorGuard stallGuard(ntcs::StallDetector::e_WRITABLE,
+                                            socket.get());
         socket->processSocketWritable(event);
     }
     else {
-        destination->execute(
+        destination->execute(ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_WRITABLE,
             NTCCFG_BIND(&ntci::ReactorSocket::processSocketWritable,
                         socket,
-                        event));
+                        event),
+            socket));
     }
 }
 
@@ -1778,13 +1787,17 @@ void Dispatch::announceError(
     const bsl::shared_ptr<ntci::Strand>&        destination)
 {
     if (NTCCFG_LIKELY(!destination)) {
+        ntcs::StallDetectorGuard stallGuard(ntcs::StallDetector::e_ERROR,
+                                            socket.get());
         socket->processSocketError(event);
     }
     else {
-        destination->execute(
+        destination->execute(ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_ERROR,
             NTCCFG_BIND(&ntci::ReactorSocket::processSocketError,
                         socket,
-                        event));
+                        event),
+            socket));
     }
 }
 
@@ -1795,13 +1808,18 @@ void Dispatch::announceNotifications(
     const bsl::shared_ptr<ntci::Strand>&        destination)
 {
     if (NTCCFG_LIKELY(!destination)) {
+        ntcs::StallDetectorGuard stallGuard(
+            ntcs::StallDetector::e_NOTIFICATIONS,
+            socket.get());
         socket->processNotifications(notifications);
     }
     else {
-        destination->execute(
+        destination->execute(ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_NOTIFICATIONS,
             NTCCFG_BIND(&ntci::ReactorSocket::processNotifications,
                         socket,
-                        notifications));
+                        notifications),
+            socket));
     }
 }
 
@@ -0,0 +1,282 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcs_happyeyeballs.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_happyeyeballs_cpp, "$Id$ $CSID$")
+
+#include <ntcs_compat.h>
+#include <bsls_assert.h>
+#include <bsl_algorithm.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+namespace {
+
+// The length of time, in milliseconds, to wait for the IPv6 addresses after
+// the IPv4 addresses have been resolved, as recommended by RFC 8305 section
+// 3.
+const int k_RESOLUTION_DELAY_MILLISECONDS = 50;
+
+// The default length of time, in milliseconds, to wait for a connection
+// attempt to complete before beginning the next attempt, as recommended by
+// RFC 8305 section 5.
+const int k_CONNECTION_ATTEMPT_DELAY_MILLISECONDS = 250;
+
+// The interval, in milliseconds, at which connection attempts raced on
+// auxiliary descriptors are polled for completion.
+const int k_ATTEMPT_POLL_INTERVAL_MILLISECONDS = 10;
+
+}  // close unnamed namespace
+
+HappyEyeballs::HappyEyeballs(bslma::Allocator* basicAllocator)
+: d_ipv6EndpointList(basicAllocator)
+, d_ipv4EndpointList(basicAllocator)
+, d_context(basicAllocator)
+, d_error()
+, d_numPending(0)
+, d_started(false)
+, d_generation(0)
+, d_attemptVector(basicAllocator)
+, d_attemptError()
+{
+}
+
+HappyEyeballs::~HappyEyeballs()
+{
+    this->cancel();
+}
+
+void HappyEyeballs::reset(
+    const bdlb::NullableValue<ntsa::IpAddressType::Value>& ipAddressType)
+{
+    d_ipv6EndpointList.clear();
+    d_ipv4EndpointList.clear();
+    d_context.reset();
+    d_error      = ntsa::Error();
+    d_numPending = ipAddressType.isNull() ? 2 : 1;
+    d_started    = false;
+
+    this->cancel();
+    d_attemptError = ntsa::Error();
+
+    ++d_generation;
+}
+
+bool HappyEyeballs::process(ntsa::IpAddressType::Value    ipAddressType,
+                            const ntca::GetEndpointEvent& event)
+{
+    BSLS_ASSERT(ipAddressType == ntsa::IpAddressType::e_V6 ||
+                ipAddressType == ntsa::IpAddressType::e_V4);
+
+    if (d_numPending > 0) {
+        --d_numPending;
+    }
+
+    if (event.type() == ntca::GetEndpointEventType::e_ERROR) {
+        if (!d_error) {
+            d_error = event.context().error();
+        }
+    }
+    else {
+        bsl::vector<ntsa::Endpoint>& endpointList =
+            ipAddressType == ntsa::IpAddressType::e_V6 ? d_ipv6EndpointList
+                                                       : d_ipv4EndpointList;
+
+        endpointList = event.context().endpointList();
+
+        if (d_context.authority().empty()) {
+            d_context = event.context();
+        }
+    }
+
+    if (d_started) {
+        return false;
+    }
+
+    return ipAddressType == ntsa::IpAddressType::e_V6 || d_numPending == 0;
+}
+
+ntsa::Error HappyEyeballs::start(bsl::vector<ntsa::Endpoint>* result)
+{
+    d_started = true;
+
+    HappyEyeballs::interleave(result, d_ipv6EndpointList, d_ipv4EndpointList);
+
+    if (result->empty()) {
+        if (d_error) {
+            return d_error;
+        }
+
+        return ntsa::Error(ntsa::Error::e_EOF);
+    }
+
+    return ntsa::Error();
+}
+
+void HappyEyeballs::merge(bsl::vector<ntsa::Endpoint>* result,
+                          ntsa::IpAddressType::Value   ipAddressType) const
+{
+    const bsl::vector<ntsa::Endpoint>& endpointList =
+        ipAddressType == ntsa::IpAddressType::e_V6 ? d_ipv6EndpointList
+                                                   : d_ipv4EndpointList;
+
+    if (endpointList.empty()) {
+        return;
+    }
+
+    if (result->empty()) {
+        *result = endpointList;
+        return;
+    }
+
+    bsl::vector<ntsa::Endpoint> remaining(result->begin() + 1,
+                                          result->end(),
+                                          result->get_allocator());
+
+    result->resize(1);
+
+    bsl::vector<ntsa::Endpoint> merged(result->get_allocator());
+    HappyEyeballs::interleave(&merged, endpointList, remaining);
+
+    result->insert(result->end(), merged.begin(), merged.end());
+}
+
+ntsa::Error HappyEyeballs::race(
+    const ntsa::Endpoint&                      endpoint,
+    const bsl::shared_ptr<ntsi::StreamSocket>& socket,
+    const ntca::StreamSocketOptions&           options)
+{
+    ntsa::Error error;
+
+    error = socket->open(endpoint.transport(ntsa::TransportMode::e_STREAM));
+    if (error) {
+        d_attemptError = error;
+        return error;
+    }
+
+    error = ntcs::Compat::configure(socket, options);
+    if (error) {
+        socket->close();
+        d_attemptError = error;
+        return error;
+    }
+
+    error = socket->connect(endpoint);
+    if (error && error != ntsa::Error::e_PENDING &&
+        error != ntsa::Error::e_WOULD_BLOCK)
+    {
+        socket->close();
+        d_attemptError = error;
+        return error;
+    }
+
+    Attempt attempt;
+    attempt.d_endpoint  = endpoint;
+    attempt.d_socket_sp = socket;
+
+    d_attemptVector.push_back(attempt);
+
+    return ntsa::Error();
+}
+
+bool HappyEyeballs::poll(bsl::shared_ptr<ntsi::StreamSocket>* socket,
+                         ntsa::Endpoint*                      endpoint)
+{
+    AttemptVector::iterator it = d_attemptVector.begin();
+    while (it != d_attemptVector.end()) {
+        ntsa::Error lastError;
+        it->d_socket_sp->getLastError(&lastError);
+
+        if (lastError) {
+            d_attemptError = lastError;
+            it->d_socket_sp->close();
+            it = d_attemptVector.erase(it);
+            continue;
+        }
+
+        // A socket whose connection is still in progress has no peer.
+
+        ntsa::Endpoint remoteEndpoint;
+        if (!it->d_socket_sp->remoteEndpoint(&remoteEndpoint)) {
+            *socket   = it->d_socket_sp;
+            *endpoint = it->d_endpoint;
+            d_attemptVector.erase(it);
+            return true;
+        }
+
+        ++it;
+    }
+
+    return false;
+}
+
+void HappyEyeballs::cancel()
+{
+    for (AttemptVector::iterator it = d_attemptVector.begin();
+         it != d_attemptVector.end();
+         ++it)
+    {
+        it->d_socket_sp->close();
+    }
+
+    d_attemptVector.clear();
+}
+
+void HappyEyeballs::interleave(bsl::vector<ntsa::Endpoint>*       result,
+                               const bsl::vector<ntsa::Endpoint>& primary,
+                               const bsl::vector<ntsa::Endpoint>& secondary)
+{
+    result->clear();
+    result->reserve(primary.size() + secondary.size());
+
+    const bsl::size_t size = bsl::max(primary.size(), secondary.size());
+
+    for (bsl::size_t i = 0; i < size; ++i) {
+        if (i < primary.size()) {
+            result->push_back(primary[i]);
+        }
+
+        if (i < secondary.size()) {
+            result->push_back(secondary[i]);
+        }
+    }
+}
+
+bsls::TimeInterval HappyEyeballs::resolutionDelay()
+{
+    bsls::TimeInterval result;
+    result.setTotalMilliseconds(k_RESOLUTION_DELAY_MILLISECONDS);
+    return result;
+}
+
+bsls::TimeInterval HappyEyeballs::connectionAttemptDelay()
+{
+    bsls::TimeInterval result;
+    result.setTotalMilliseconds(k_CONNECTION_ATTEMPT_DELAY_MILLISECONDS);
+    return result;
+}
+
+bsls::TimeInterval HappyEyeballs::attemptPollInterval()
+{
+    bsls::TimeInterval result;
+    result.setTotalMilliseconds(k_ATTEMPT_POLL_INTERVAL_MILLISECONDS);
+    return result;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
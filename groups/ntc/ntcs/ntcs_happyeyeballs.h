@@ -0,0 +1,231 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCS_HAPPYEYEBALLS
+#define INCLUDED_NTCS_HAPPYEYEBALLS
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntca_getendpointcontext.h>
+#include <ntca_getendpointevent.h>
+#include <ntca_streamsocketoptions.h>
+#include <ntccfg_platform.h>
+#include <ntcscm_version.h>
+#include <ntsa_endpoint.h>
+#include <ntsa_error.h>
+#include <ntsa_ipaddresstype.h>
+#include <ntsi_streamsocket.h>
+#include <bdlb_nullablevalue.h>
+#include <bslma_allocator.h>
+#include <bsls_timeinterval.h>
+#include <bsl_cstdint.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+/// @internal @brief
+/// Provide the state of a "Happy Eyeballs" connection attempt.
+///
+/// @details
+/// This class collects the results of resolving a name into its IPv6 and
+/// IPv4 addresses in parallel and determines when connection attempts may
+/// begin and in what order the resolved endpoints should be tried, as
+/// described by RFC 8305. Connection attempts begin as soon as the IPv6
+/// addresses are known, or, if the IPv4 addresses arrive first, when the
+/// IPv6 addresses arrive or the resolution delay elapses, whichever occurs
+/// first. The resolved endpoints are tried in an order that alternates
+/// between address families, starting with IPv6.
+///
+/// A stream socket owns the descriptor of one connection attempt, which is
+/// monitored by its reactor or proactor. When the connection attempt delay
+/// elapses before that attempt completes, the next endpoint is raced on an
+/// auxiliary descriptor held by this object rather than abandoning the
+/// attempt in progress. Auxiliary descriptors are not monitored by the
+/// driver: the socket polls them periodically and adopts the descriptor of
+/// the first to connect.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcs
+class HappyEyeballs
+{
+    /// Describe a connection attempt raced on an auxiliary descriptor.
+    struct Attempt {
+        ntsa::Endpoint                      d_endpoint;
+        bsl::shared_ptr<ntsi::StreamSocket> d_socket_sp;
+    };
+
+    /// Define a type alias for a vector of raced connection attempts.
+    typedef bsl::vector<Attempt> AttemptVector;
+
+    bsl::vector<ntsa::Endpoint> d_ipv6EndpointList;
+    bsl::vector<ntsa::Endpoint> d_ipv4EndpointList;
+    ntca::GetEndpointContext    d_context;
+    ntsa::Error                 d_error;
+    bsl::size_t                 d_numPending;
+    bool                        d_started;
+    bsl::uint64_t               d_generation;
+    AttemptVector               d_attemptVector;
+    ntsa::Error                 d_attemptError;
+
+  private:
+    HappyEyeballs(const HappyEyeballs&) BSLS_KEYWORD_DELETED;
+    HappyEyeballs& operator=(const HappyEyeballs&) BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Create a new "Happy Eyeballs" state expecting no resolution results.
+    /// Optionally specify a 'basicAllocator' used to supply memory. If
+    /// 'basicAllocator' is 0, the currently installed default allocator is
+    /// used.
+    explicit HappyEyeballs(bslma::Allocator* basicAllocator = 0);
+
+    /// Destroy this object. Close the descriptor of each raced connection
+    /// attempt.
+    ~HappyEyeballs();
+
+    /// Forget all recorded results and expect the results of resolving a
+    /// name into its addresses of the specified 'ipAddressType', or into
+    /// both its IPv6 and IPv4 addresses if 'ipAddressType' is null.
+    /// Close the descriptor of each raced connection attempt. Increment
+    /// the generation, so that results of resolutions initiated before
+    /// this call may be recognized as stale.
+    void reset(
+        const bdlb::NullableValue<ntsa::IpAddressType::Value>& ipAddressType);
+
+    /// Record the specified 'event' describing the result of resolving the
+    /// name into its addresses of the specified 'ipAddressType'. Return
+    /// true if connection attempts should begin, that is, if attempts have
+    /// not yet begun and either the IPv6 addresses are now known or no
+    /// resolution remains pending, otherwise return false.
+    bool process(ntsa::IpAddressType::Value    ipAddressType,
+                 const ntca::GetEndpointEvent& event);
+
+    /// Begin the connection attempts: load into the specified 'result' the
+    /// endpoints resolved so far, interleaved by address family. Return the
+    /// error, if any, if no endpoint has been resolved.
+    ntsa::Error start(bsl::vector<ntsa::Endpoint>* result);
+
+    /// Merge the endpoints of the specified 'ipAddressType' resolved after
+    /// connection attempts have begun into the specified 'result' list of
+    /// endpoints remaining to be tried, whose first element, if any, is the
+    /// endpoint of the attempt currently in progress. The merged endpoints
+    /// are interleaved with the endpoints after the first.
+    void merge(bsl::vector<ntsa::Endpoint>* result,
+               ntsa::IpAddressType::Value   ipAddressType) const;
+
+    /// Begin a connection attempt to the specified 'endpoint' on the
+    /// specified unopened 'socket', configured according to the specified
+    /// 'options', to race the attempt in progress. Return the error, which
+    /// is also recorded as the attempt error.
+    ntsa::Error race(const ntsa::Endpoint&                      endpoint,
+                     const bsl::shared_ptr<ntsi::StreamSocket>& socket,
+                     const ntca::StreamSocketOptions&           options);
+
+    /// Close the descriptor of each raced connection attempt that has
+    /// failed. If a raced attempt has connected, stop tracking it, load its
+    /// socket into the specified 'socket' and its endpoint into the
+    /// specified 'endpoint', and return true. Otherwise, return false.
+    bool poll(bsl::shared_ptr<ntsi::StreamSocket>* socket,
+              ntsa::Endpoint*                      endpoint);
+
+    /// Close the descriptor of each raced connection attempt.
+    void cancel();
+
+    /// Return the number of raced connection attempts in progress.
+    bsl::size_t numAttempts() const;
+
+    /// Return the error of the raced connection attempt that most recently
+    /// failed, if any.
+    const ntsa::Error& attemptError() const;
+
+    /// Return true if a resolution remains pending, otherwise return false.
+    bool isPending() const;
+
+    /// Return true if connection attempts have begun, otherwise return
+    /// false.
+    bool isStarted() const;
+
+    /// Return the generation of the resolutions whose results are expected.
+    bsl::uint64_t generation() const;
+
+    /// Return the context of the first successful resolution, which
+    /// describes the resolved name, the source of the resolution, and its
+    /// latency.
+    const ntca::GetEndpointContext& context() const;
+
+    /// Load into the specified 'result' the endpoints in the specified
+    /// 'primary' and 'secondary' lists, alternating between the two lists
+    /// starting with 'primary'. Any endpoints remaining after one list is
+    /// exhausted are appended in order.
+    static void interleave(bsl::vector<ntsa::Endpoint>*       result,
+                           const bsl::vector<ntsa::Endpoint>& primary,
+                           const bsl::vector<ntsa::Endpoint>& secondary);
+
+    /// Return the length of time to wait for the IPv6 addresses after the
+    /// IPv4 addresses have been resolved, before beginning connection
+    /// attempts with only the IPv4 addresses.
+    static bsls::TimeInterval resolutionDelay();
+
+    /// Return the default length of time to wait for a connection attempt
+    /// to complete before beginning the next attempt.
+    static bsls::TimeInterval connectionAttemptDelay();
+
+    /// Return the interval at which raced connection attempts are polled.
+    static bsls::TimeInterval attemptPollInterval();
+};
+
+NTCCFG_INLINE
+bsl::size_t HappyEyeballs::numAttempts() const
+{
+    return d_attemptVector.size();
+}
+
+NTCCFG_INLINE
+const ntsa::Error& HappyEyeballs::attemptError() const
+{
+    return d_attemptError;
+}
+
+NTCCFG_INLINE
+bool HappyEyeballs::isPending() const
+{
+    return d_numPending > 0;
+}
+
+NTCCFG_INLINE
+bool HappyEyeballs::isStarted() const
+{
+    return d_started;
+}
+
+NTCCFG_INLINE
+bsl::uint64_t HappyEyeballs::generation() const
+{
+    return d_generation;
+}
+
+NTCCFG_INLINE
+const ntca::GetEndpointContext& HappyEyeballs::context() const
+{
+    return d_context;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
@@ -0,0 +1,356 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_happyeyeballs_t_cpp, "$Id$ $CSID$")
+
+#include <ntcs_happyeyeballs.h>
+
+#include <ntsf_system.h>
+#include <bslmt_threadutil.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcs {
+
+// Provide tests for 'ntcs::HappyEyeballs'.
+class HappyEyeballsTest
+{
+    // Return a successful resolution event resolving "example.com" to the
+    // specified 'endpointList'.
+    static ntca::GetEndpointEvent makeEvent(
+        const bsl::vector<ntsa::Endpoint>& endpointList);
+
+    // Return an unsuccessful resolution event having the specified
+    // 'error'.
+    static ntca::GetEndpointEvent makeErrorEvent(const ntsa::Error& error);
+
+  public:
+    // Concern: Endpoints are interleaved by address family.
+    static void verifyInterleave();
+
+    // Concern: Attempts begin as soon as the IPv6 addresses are known.
+    static void verifyIpv6First();
+
+    // Concern: Attempts do not begin when the IPv4 addresses arrive first
+    // until the IPv6 addresses arrive, and IPv4 addresses arriving after
+    // attempts have begun are merged into the remaining endpoints.
+    static void verifyIpv4First();
+
+    // Concern: Attempts fail with the resolution error when neither
+    // address family resolves.
+    static void verifyError();
+
+    // Concern: Attempts begin immediately when only one address family is
+    // expected, and resetting the state advances its generation.
+    static void verifySingleFamily();
+
+    // Concern: Connection attempts raced on auxiliary descriptors are
+    // adopted when they connect and discarded when they fail.
+    static void verifyRace();
+};
+
+ntca::GetEndpointEvent HappyEyeballsTest::makeEvent(
+    const bsl::vector<ntsa::Endpoint>& endpointList)
+{
+    ntca::GetEndpointContext context(NTSCFG_TEST_ALLOCATOR);
+    context.setAuthority("example.com");
+    context.setEndpointList(endpointList);
+
+    ntca::GetEndpointEvent event(NTSCFG_TEST_ALLOCATOR);
+    event.setType(ntca::GetEndpointEventType::e_COMPLETE);
+    event.setContext(context);
+
+    return event;
+}
+
+ntca::GetEndpointEvent HappyEyeballsTest::makeErrorEvent(
+    const ntsa::Error& error)
+{
+    ntca::GetEndpointContext context(NTSCFG_TEST_ALLOCATOR);
+    context.setError(error);
+
+    ntca::GetEndpointEvent event(NTSCFG_TEST_ALLOCATOR);
+    event.setType(ntca::GetEndpointEventType::e_ERROR);
+    event.setContext(context);
+
+    return event;
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::HappyEyeballsTest::verifyInterleave)
+{
+    bsl::vector<ntsa::Endpoint> ipv6(NTSCFG_TEST_ALLOCATOR);
+    ipv6.push_back(ntsa::Endpoint("[::1]:80"));
+    ipv6.push_back(ntsa::Endpoint("[::2]:80"));
+    ipv6.push_back(ntsa::Endpoint("[::3]:80"));
+
+    bsl::vector<ntsa::Endpoint> ipv4(NTSCFG_TEST_ALLOCATOR);
+    ipv4.push_back(ntsa::Endpoint("10.0.0.1:80"));
+
+    bsl::vector<ntsa::Endpoint> result(NTSCFG_TEST_ALLOCATOR);
+    ntcs::HappyEyeballs::interleave(&result, ipv6, ipv4);
+
+    NTSCFG_TEST_EQ(result.size(), 4);
+    NTSCFG_TEST_EQ(result[0], ipv6[0]);
+    NTSCFG_TEST_EQ(result[1], ipv4[0]);
+    NTSCFG_TEST_EQ(result[2], ipv6[1]);
+    NTSCFG_TEST_EQ(result[3], ipv6[2]);
+
+    ntcs::HappyEyeballs::interleave(&result, ipv4, ipv6);
+
+    NTSCFG_TEST_EQ(result.size(), 4);
+    NTSCFG_TEST_EQ(result[0], ipv4[0]);
+    NTSCFG_TEST_EQ(result[1], ipv6[0]);
+    NTSCFG_TEST_EQ(result[2], ipv6[1]);
+    NTSCFG_TEST_EQ(result[3], ipv6[2]);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::HappyEyeballsTest::verifyIpv6First)
+{
+    bsl::vector<ntsa::Endpoint> ipv6(NTSCFG_TEST_ALLOCATOR);
+    ipv6.push_back(ntsa::Endpoint("[::1]:80"));
+
+    const bdlb::NullableValue<ntsa::IpAddressType::Value> anyType;
+
+    ntcs::HappyEyeballs happyEyeballs(NTSCFG_TEST_ALLOCATOR);
+    happyEyeballs.reset(anyType);
+
+    NTSCFG_TEST_TRUE(happyEyeballs.isPending());
+    NTSCFG_TEST_FALSE(happyEyeballs.isStarted());
+
+    bool ready =
+        happyEyeballs.process(ntsa::IpAddressType::e_V6, makeEvent(ipv6));
+    NTSCFG_TEST_TRUE(ready);
+    NTSCFG_TEST_TRUE(happyEyeballs.isPending());
+    NTSCFG_TEST_EQ(happyEyeballs.context().authority(), "example.com");
+
+    bsl::vector<ntsa::Endpoint> result(NTSCFG_TEST_ALLOCATOR);
+    ntsa::Error error = happyEyeballs.start(&result);
+    NTSCFG_TEST_OK(error);
+    NTSCFG_TEST_TRUE(happyEyeballs.isStarted());
+
+    NTSCFG_TEST_EQ(result.size(), 1);
+    NTSCFG_TEST_EQ(result[0], ipv6[0]);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::HappyEyeballsTest::verifyIpv4First)
+{
+    bsl::vector<ntsa::Endpoint> ipv6(NTSCFG_TEST_ALLOCATOR);
+    ipv6.push_back(ntsa::Endpoint("[::1]:80"));
+    ipv6.push_back(ntsa::Endpoint("[::2]:80"));
+
+    bsl::vector<ntsa::Endpoint> ipv4(NTSCFG_TEST_ALLOCATOR);
+    ipv4.push_back(ntsa::Endpoint("10.0.0.1:80"));
+    ipv4.push_back(ntsa::Endpoint("10.0.0.2:80"));
+
+    const bdlb::NullableValue<ntsa::IpAddressType::Value> anyType;
+
+    ntcs::HappyEyeballs happyEyeballs(NTSCFG_TEST_ALLOCATOR);
+    happyEyeballs.reset(anyType);
+
+    bool ready =
+        happyEyeballs.process(ntsa::IpAddressType::e_V4, makeEvent(ipv4));
+    NTSCFG_TEST_FALSE(ready);
+
+    // Simulate the resolution delay elapsing before the IPv6 addresses
+    // arrive.
+
+    bsl::vector<ntsa::Endpoint> result(NTSCFG_TEST_ALLOCATOR);
+    ntsa::Error error = happyEyeballs.start(&result);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(result.size(), 2);
+    NTSCFG_TEST_EQ(result[0], ipv4[0]);
+    NTSCFG_TEST_EQ(result[1], ipv4[1]);
+
+    ready = happyEyeballs.process(ntsa::IpAddressType::e_V6, makeEvent(ipv6));
+    NTSCFG_TEST_FALSE(ready);
+    NTSCFG_TEST_FALSE(happyEyeballs.isPending());
+
+    happyEyeballs.merge(&result, ntsa::IpAddressType::e_V6);
+
+    NTSCFG_TEST_EQ(result.size(), 4);
+    NTSCFG_TEST_EQ(result[0], ipv4[0]);
+    NTSCFG_TEST_EQ(result[1], ipv6[0]);
+    NTSCFG_TEST_EQ(result[2], ipv4[1]);
+    NTSCFG_TEST_EQ(result[3], ipv6[1]);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::HappyEyeballsTest::verifyError)
+{
+    const bdlb::NullableValue<ntsa::IpAddressType::Value> anyType;
+
+    ntcs::HappyEyeballs happyEyeballs(NTSCFG_TEST_ALLOCATOR);
+    happyEyeballs.reset(anyType);
+
+    bool ready = happyEyeballs.process(
+        ntsa::IpAddressType::e_V4,
+        makeErrorEvent(ntsa::Error(ntsa::Error::e_CONNECTION_TIMEOUT)));
+    NTSCFG_TEST_FALSE(ready);
+
+    ready = happyEyeballs.process(
+        ntsa::IpAddressType::e_V6,
+        makeErrorEvent(ntsa::Error(ntsa::Error::e_EOF)));
+    NTSCFG_TEST_TRUE(ready);
+    NTSCFG_TEST_FALSE(happyEyeballs.isPending());
+
+    bsl::vector<ntsa::Endpoint> result(NTSCFG_TEST_ALLOCATOR);
+    ntsa::Error error = happyEyeballs.start(&result);
+    NTSCFG_TEST_EQ(error, ntsa::Error(ntsa::Error::e_CONNECTION_TIMEOUT));
+    NTSCFG_TEST_TRUE(result.empty());
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::HappyEyeballsTest::verifySingleFamily)
+{
+    bsl::vector<ntsa::Endpoint> ipv4(NTSCFG_TEST_ALLOCATOR);
+    ipv4.push_back(ntsa::Endpoint("10.0.0.1:80"));
+
+    bdlb::NullableValue<ntsa::IpAddressType::Value> ipAddressType;
+    ipAddressType.makeValue(ntsa::IpAddressType::e_V4);
+
+    ntcs::HappyEyeballs happyEyeballs(NTSCFG_TEST_ALLOCATOR);
+    happyEyeballs.reset(ipAddressType);
+
+    const bsl::uint64_t generation = happyEyeballs.generation();
+
+    bool ready =
+        happyEyeballs.process(ntsa::IpAddressType::e_V4, makeEvent(ipv4));
+    NTSCFG_TEST_TRUE(ready);
+    NTSCFG_TEST_FALSE(happyEyeballs.isPending());
+
+    bsl::vector<ntsa::Endpoint> result(NTSCFG_TEST_ALLOCATOR);
+    ntsa::Error error = happyEyeballs.start(&result);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(result.size(), 1);
+    NTSCFG_TEST_EQ(result[0], ipv4[0]);
+
+    happyEyeballs.reset(ipAddressType);
+
+    NTSCFG_TEST_NE(happyEyeballs.generation(), generation);
+    NTSCFG_TEST_TRUE(happyEyeballs.isPending());
+    NTSCFG_TEST_FALSE(happyEyeballs.isStarted());
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::HappyEyeballsTest::verifyRace)
+{
+    ntsa::Error error;
+
+    bsl::shared_ptr<ntsi::ListenerSocket> listener =
+        ntsf::System::createListenerSocket(NTSCFG_TEST_ALLOCATOR);
+
+    error = listener->open(ntsa::Transport::e_TCP_IPV4_STREAM);
+    NTSCFG_TEST_OK(error);
+
+    error = listener->bind(
+        ntsa::Endpoint(ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)),
+        false);
+    NTSCFG_TEST_OK(error);
+
+    error = listener->listen(1);
+    NTSCFG_TEST_OK(error);
+
+    ntsa::Endpoint listenerEndpoint;
+    error = listener->sourceEndpoint(&listenerEndpoint);
+    NTSCFG_TEST_OK(error);
+
+    // Find a port on which nothing listens by binding, then closing, a
+    // socket.
+
+    ntsa::Endpoint refusedEndpoint;
+    {
+        bsl::shared_ptr<ntsi::ListenerSocket> unused =
+            ntsf::System::createListenerSocket(NTSCFG_TEST_ALLOCATOR);
+
+        error = unused->open(ntsa::Transport::e_TCP_IPV4_STREAM);
+        NTSCFG_TEST_OK(error);
+
+        error = unused->bind(
+            ntsa::Endpoint(
+                ntsa::IpEndpoint(ntsa::Ipv4Address::loopback(), 0)),
+            false);
+        NTSCFG_TEST_OK(error);
+
+        error = unused->sourceEndpoint(&refusedEndpoint);
+        NTSCFG_TEST_OK(error);
+
+        unused->close();
+    }
+
+    ntca::StreamSocketOptions options;
+
+    ntcs::HappyEyeballs happyEyeballs(NTSCFG_TEST_ALLOCATOR);
+
+    // The refusal may be reported by the connect itself.
+
+    error = happyEyeballs.race(
+        refusedEndpoint,
+        ntsf::System::createStreamSocket(NTSCFG_TEST_ALLOCATOR),
+        options);
+    NTSCFG_TEST_TRUE(!error ||
+                     error == ntsa::Error::e_CONNECTION_REFUSED);
+
+    const bool refusedLater = !error;
+
+    error = happyEyeballs.race(
+        listenerEndpoint,
+        ntsf::System::createStreamSocket(NTSCFG_TEST_ALLOCATOR),
+        options);
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(happyEyeballs.numAttempts(), refusedLater ? 2 : 1);
+
+    bsl::shared_ptr<ntsi::StreamSocket> socket;
+    ntsa::Endpoint                      endpoint;
+
+    bool connected = false;
+    for (int i = 0; i < 1000 && !connected; ++i) {
+        connected = happyEyeballs.poll(&socket, &endpoint);
+        if (!connected) {
+            bslmt::ThreadUtil::microSleep(1000);
+        }
+    }
+
+    NTSCFG_TEST_TRUE(connected);
+    NTSCFG_TEST_TRUE(socket);
+    NTSCFG_TEST_EQ(endpoint, listenerEndpoint);
+
+    ntsa::Endpoint remoteEndpoint;
+    error = socket->remoteEndpoint(&remoteEndpoint);
+    NTSCFG_TEST_OK(error);
+    NTSCFG_TEST_EQ(remoteEndpoint, listenerEndpoint);
+
+    for (int i = 0; i < 1000 && happyEyeballs.numAttempts() != 0; ++i) {
+        bsl::shared_ptr<ntsi::StreamSocket> other;
+        NTSCFG_TEST_FALSE(happyEyeballs.poll(&other, &endpoint));
+        bslmt::ThreadUtil::microSleep(1000);
+    }
+
+    NTSCFG_TEST_EQ(happyEyeballs.numAttempts(), 0);
+
+    if (refusedLater) {
+        NTSCFG_TEST_EQ(happyEyeballs.attemptError(),
+                       ntsa::Error(ntsa::Error::e_CONNECTION_REFUSED));
+    }
+
+    socket->close();
+    listener->close();
+}
+
+}  // close namespace ntcs
+}  // close namespace BloombergLP
@@ -0,0 +1,332 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcs_loopprofiler.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_loopprofiler_cpp, "$Id$ $CSID$")
+
+#include <ntcs_monitorable.h>
+
+#include <bslmt_threadutil.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bsls_assert.h>
+#include <bsls_timeutil.h>
+#include <bsl_cstring.h>
+#include <bsl_sstream.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+bsls::AtomicBool LoopProfiler::s_tracing(false);
+
+const ntci::MetricMetadata LoopProfiler::STATISTICS[] = {
+    NTCI_METRIC_METADATA_SUMMARY(waitTime),
+    NTCI_METRIC_METADATA_SUMMARY(dispatchTime),
+    NTCI_METRIC_METADATA_SUMMARY(timerTime),
+    NTCI_METRIC_METADATA_SUMMARY(functionTime),
+    NTCI_METRIC_METADATA_SUMMARY(dispatchLatency),
+
+    NTCI_METRIC_METADATA_PERCENTILES(waitTime),
+    NTCI_METRIC_METADATA_PERCENTILES(dispatchTime),
+    NTCI_METRIC_METADATA_PERCENTILES(timerTime),
+    NTCI_METRIC_METADATA_PERCENTILES(functionTime),
+    NTCI_METRIC_METADATA_PERCENTILES(dispatchLatency)};
+
+void LoopProfiler::record(int measurement, bsls::Types::Int64 duration)
+{
+    // Durations are measured in nanoseconds but published in microseconds,
+    // and counted from 2^-4 microseconds.
+
+    const double value = static_cast<double>(duration) / 1000.0;
+
+    d_metric[measurement].update(value);
+    d_histogram_p[measurement].update(value);
+}
+
+LoopProfiler::LoopProfiler(const bslstl::StringRef& prefix,
+                           const bslstl::StringRef& objectName,
+                           bslma::Allocator*        basicAllocator)
+: d_phase(LoopProfilerIteration::e_WAIT)
+, d_phaseStartTime(0)
+, d_readyTime(0)
+, d_histogram_p(0)
+, d_traceLock(bsls::SpinLock::s_unlocked)
+, d_trace(basicAllocator)
+, d_traceIndex(0)
+, d_prefix(prefix, basicAllocator)
+, d_objectName(objectName, basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    bsl::memset(&d_iteration, 0, sizeof d_iteration);
+
+    ntci::MetricHistogram* histogram = static_cast<ntci::MetricHistogram*>(
+        d_allocator_p->allocate(sizeof(ntci::MetricHistogram) *
+                                k_NUM_MEASUREMENTS));
+
+    for (int i = 0; i < k_NUM_MEASUREMENTS; ++i) {
+        new (histogram + i) ntci::MetricHistogram(-4);
+    }
+
+    d_histogram_p = histogram;
+}
+
+LoopProfiler::~LoopProfiler()
+{
+    for (int i = 0; i < k_NUM_MEASUREMENTS; ++i) {
+        d_histogram_p[i].~MetricHistogram();
+    }
+
+    d_allocator_p->deallocate(d_histogram_p);
+}
+
+void LoopProfiler::begin()
+{
+    const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+
+    bsl::memset(&d_iteration, 0, sizeof d_iteration);
+    d_iteration.d_startTime = now;
+
+    d_phase          = LoopProfilerIteration::e_WAIT;
+    d_phaseStartTime = now;
+    d_readyTime      = now;
+}
+
+void LoopProfiler::enter(Phase phase)
+{
+    const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+
+    d_iteration.d_duration[d_phase] += now - d_phaseStartTime;
+
+    d_phase          = phase;
+    d_phaseStartTime = now;
+
+    if (phase == LoopProfilerIteration::e_DISPATCH) {
+        d_readyTime = now;
+    }
+}
+
+void LoopProfiler::logEvent()
+{
+    const bsls::Types::Int64 latency =
+        bsls::TimeUtil::getTimer() - d_readyTime;
+
+    if (latency > d_iteration.d_maxLatency) {
+        d_iteration.d_maxLatency = latency;
+    }
+
+    ++d_iteration.d_numEvents;
+
+    this->record(k_LATENCY, latency);
+}
+
+void LoopProfiler::end()
+{
+    const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+
+    d_iteration.d_duration[d_phase] += now - d_phaseStartTime;
+
+    for (int i = 0; i < LoopProfilerIteration::k_NUM_PHASES; ++i) {
+        this->record(i, d_iteration.d_duration[i]);
+    }
+
+    if (s_tracing.loadRelaxed()) {
+        d_iteration.d_threadId = bslmt::ThreadUtil::selfIdAsUint64();
+
+        bsls::SpinLockGuard guard(&d_traceLock);
+
+        if (d_trace.size() < k_TRACE_CAPACITY) {
+            d_trace.push_back(d_iteration);
+        }
+        else {
+            d_trace[d_traceIndex] = d_iteration;
+        }
+
+        d_traceIndex = (d_traceIndex + 1) % k_TRACE_CAPACITY;
+    }
+
+    d_phase          = LoopProfilerIteration::e_WAIT;
+    d_phaseStartTime = now;
+}
+
+void LoopProfiler::getStats(bdld::ManagedDatum* result)
+{
+    bdld::DatumMutableArrayRef array;
+    bdld::Datum::createUninitializedArray(&array,
+                                          numOrdinals(),
+                                          result->allocator());
+
+    bsl::size_t index = 0;
+
+    for (int i = 0; i < k_NUM_MEASUREMENTS; ++i) {
+        ntci::MetricValue value;
+        d_metric[i].load(&value);
+
+        value.collectSummary(&array, &index);
+    }
+
+    for (int i = 0; i < k_NUM_MEASUREMENTS; ++i) {
+        d_histogram_p[i].collectPercentiles(&array, &index);
+    }
+
+    *array.length() = numOrdinals();
+
+    result->adopt(bdld::Datum::adoptArray(array));
+}
+
+const char* LoopProfiler::getFieldPrefix(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return d_prefix.c_str();
+}
+
+const char* LoopProfiler::getFieldName(int ordinal) const
+{
+    if (ordinal < numOrdinals()) {
+        return LoopProfiler::STATISTICS[ordinal].d_name;
+    }
+    else {
+        return 0;
+    }
+}
+
+const char* LoopProfiler::getFieldDescription(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return "";
+}
+
+ntci::Monitorable::StatisticType LoopProfiler::getFieldType(
+    int ordinal) const
+{
+    if (ordinal < numOrdinals()) {
+        return LoopProfiler::STATISTICS[ordinal].d_type;
+    }
+    else {
+        return ntci::Monitorable::e_AVERAGE;
+    }
+}
+
+int LoopProfiler::getFieldTags(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return ntci::Monitorable::e_ANONYMOUS;
+}
+
+int LoopProfiler::getFieldOrdinal(const char* fieldName) const
+{
+    int result = 0;
+
+    for (int ordinal = 0; ordinal < numOrdinals(); ++ordinal) {
+        if (bsl::strcmp(LoopProfiler::STATISTICS[ordinal].d_name,
+                        fieldName) == 0)
+        {
+            result = ordinal;
+        }
+    }
+
+    return result;
+}
+
+int LoopProfiler::numOrdinals() const
+{
+    return sizeof LoopProfiler::STATISTICS /
+           sizeof LoopProfiler::STATISTICS[0];
+}
+
+const char* LoopProfiler::objectName() const
+{
+    return d_objectName.c_str();
+}
+
+void LoopProfiler::loadTrace(bsl::vector<Iteration>* result) const
+{
+    bsls::SpinLockGuard guard(&d_traceLock);
+
+    if (d_trace.size() < k_TRACE_CAPACITY) {
+        result->insert(result->end(), d_trace.begin(), d_trace.end());
+    }
+    else {
+        result->insert(result->end(),
+                       d_trace.begin() + d_traceIndex,
+                       d_trace.end());
+        result->insert(result->end(),
+                       d_trace.begin(),
+                       d_trace.begin() + d_traceIndex);
+    }
+}
+
+void LoopProfiler::setTracing(bool enabled)
+{
+    s_tracing.storeRelaxed(enabled);
+}
+
+bool LoopProfiler::isTracing()
+{
+    return s_tracing.loadRelaxed();
+}
+
+void LoopProfiler::loadTraces(bsl::vector<Iteration>* result)
+{
+    bsl::vector<bsl::shared_ptr<ntci::Monitorable> > objects;
+    ntcs::MonitorableUtil::loadRegisteredObjects(&objects);
+
+    for (bsl::size_t i = 0; i < objects.size(); ++i) {
+        const ntcs::LoopProfiler* profiler =
+            dynamic_cast<const ntcs::LoopProfiler*>(objects[i].get());
+        if (profiler != 0) {
+            profiler->loadTrace(result);
+        }
+    }
+}
+
+void LoopProfilerUtil::createProfiler(
+    bsl::shared_ptr<ntcs::LoopProfiler>* result,
+    const bsl::string&                   waiterMetricName,
+    const bsl::string&                   driverMetricName,
+    bsl::size_t                          waiterIndex,
+    bslma::Allocator*                    basicAllocator)
+{
+    bslma::Allocator* allocator = bslma::Default::allocator(basicAllocator);
+
+    bsl::string objectName(allocator);
+    if (!waiterMetricName.empty()) {
+        objectName = waiterMetricName;
+    }
+    else {
+        bsl::stringstream ss;
+        ss << driverMetricName << "-" << waiterIndex;
+        objectName = ss.str();
+    }
+
+    result->createInplace(allocator, "profile", objectName, allocator);
+
+    ntcs::MonitorableUtil::registerMonitorable(*result);
+}
+
+void LoopProfilerUtil::destroyProfiler(
+    const bsl::shared_ptr<ntcs::LoopProfiler>& profiler)
+{
+    if (profiler) {
+        ntcs::MonitorableUtil::deregisterMonitorable(profiler);
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
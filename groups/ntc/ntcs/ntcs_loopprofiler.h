@@ -0,0 +1,299 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCS_LOOPPROFILER
+#define INCLUDED_NTCS_LOOPPROFILER
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntccfg_platform.h>
+#include <ntci_metric.h>
+#include <ntci_monitorable.h>
+#include <ntcscm_version.h>
+#include <bsls_atomic.h>
+#include <bsls_spinlock.h>
+#include <bsls_types.h>
+#include <bsl_cstdint.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+/// @internal @brief
+/// Describe one iteration of an event loop recorded by a loop profiler.
+///
+/// @par Thread Safety
+/// This struct is not thread safe.
+///
+/// @ingroup module_ntcs
+struct LoopProfilerIteration {
+    enum Phase {
+        /// The time blocked waiting for events.
+        e_WAIT,
+
+        /// The time dispatching events to sockets.
+        e_DISPATCH,
+
+        /// The time announcing expired timers.
+        e_TIMERS,
+
+        /// The time invoking deferred functions.
+        e_FUNCTIONS,
+
+        /// The number of phases.
+        k_NUM_PHASES
+    };
+
+    /// The identifier of the thread that ran the iteration.
+    bsl::uint64_t d_threadId;
+
+    /// The time the iteration began, in nanoseconds, as measured by
+    /// 'bsls::TimeUtil::getTimer()'.
+    bsls::Types::Int64 d_startTime;
+
+    /// The duration of each phase, in nanoseconds.
+    bsls::Types::Int64 d_duration[k_NUM_PHASES];
+
+    /// The maximum time between the end of the wait and the dispatch of an
+    /// event, in nanoseconds.
+    bsls::Types::Int64 d_maxLatency;
+
+    /// The number of events dispatched.
+    bsl::uint32_t d_numEvents;
+};
+
+/// @internal @brief
+/// Provide a profiler of the phases of each iteration of an event loop.
+///
+/// @details
+/// A loop profiler measures how each iteration of the event loop of a
+/// reactor or proactor waiter splits between the time blocked waiting for
+/// events, the time dispatching events to sockets, the time announcing
+/// expired timers, and the time invoking deferred functions, and measures
+/// the latency between the end of the wait and the dispatch of each event.
+/// Each phase costs one reading of the high-resolution timer, and each
+/// event dispatched costs one more. The profiler publishes the summary and
+/// the 50th, 90th, 99th, and 99.9th percentiles of each measurement, in
+/// microseconds.
+///
+/// When tracing is enabled at runtime through 'setTracing', each profiler
+/// also records the breakdown of each iteration into a ring buffer of the
+/// most recent 'k_TRACE_CAPACITY' iterations, which may be loaded through
+/// 'loadTrace', or through 'loadTraces' for all registered profilers.
+///
+/// @par Thread Safety
+/// The manipulators that measure an iteration may only be called by the
+/// thread running the event loop. All other functions are thread safe.
+///
+/// @ingroup module_ntcs
+class LoopProfiler : public ntci::Monitorable,
+                     public ntccfg::Shared<LoopProfiler>
+{
+  public:
+    /// Define a type alias for the phases of an iteration.
+    typedef LoopProfilerIteration::Phase Phase;
+
+    /// Define a type alias for an iteration.
+    typedef LoopProfilerIteration Iteration;
+
+    enum {
+        /// The maximum number of iterations retained by the trace.
+        k_TRACE_CAPACITY = 1024
+    };
+
+  private:
+    enum {
+        /// The index of the dispatch latency measurement.
+        k_LATENCY = LoopProfilerIteration::k_NUM_PHASES,
+
+        /// The number of measurements.
+        k_NUM_MEASUREMENTS
+    };
+
+    Iteration              d_iteration;
+    Phase                  d_phase;
+    bsls::Types::Int64     d_phaseStartTime;
+    bsls::Types::Int64     d_readyTime;
+    ntci::Metric           d_metric[k_NUM_MEASUREMENTS];
+    ntci::MetricHistogram* d_histogram_p;
+    mutable bsls::SpinLock d_traceLock;
+    bsl::vector<Iteration> d_trace;
+    bsl::size_t            d_traceIndex;
+    bsl::string            d_prefix;
+    bsl::string            d_objectName;
+    bslma::Allocator*      d_allocator_p;
+
+    static bsls::AtomicBool s_tracing;
+
+    static const struct ntci::MetricMetadata STATISTICS[];
+
+  private:
+    LoopProfiler(const LoopProfiler&) BSLS_KEYWORD_DELETED;
+    LoopProfiler& operator=(const LoopProfiler&) BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Record the specified 'duration', in nanoseconds, of the specified
+    /// 'measurement'.
+    void record(int measurement, bsls::Types::Int64 duration);
+
+  public:
+    /// Create a new loop profiler for the specified 'objectName' whose field
+    /// names have the specified 'prefix'. Optionally specify a
+    /// 'basicAllocator' used to supply memory. If 'basicAllocator' is 0,
+    /// the currently installed default allocator is used.
+    LoopProfiler(const bslstl::StringRef& prefix,
+                 const bslstl::StringRef& objectName,
+                 bslma::Allocator*        basicAllocator = 0);
+
+    /// Destroy this object.
+    ~LoopProfiler() BSLS_KEYWORD_OVERRIDE;
+
+    /// Begin an iteration of the event loop in the wait phase.
+    void begin();
+
+    /// End the current phase of the iteration and enter the specified
+    /// 'phase'. When entering the dispatch phase, remember the current time
+    /// as the time the events to be dispatched became ready.
+    void enter(Phase phase);
+
+    /// Log that an event is about to be dispatched.
+    void logEvent();
+
+    /// End the current phase and the iteration.
+    void end();
+
+    /// Load into the specified 'result' the statistics measured since the
+    /// last call to this function.
+    void getStats(bdld::ManagedDatum* result) BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the prefix corresponding to the field at the specified
+    /// 'ordinal' position, or 0 if no field at the 'ordinal' position
+    /// exists.
+    const char* getFieldPrefix(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the field name corresponding to the field at the specified
+    /// 'ordinal' position, or 0 if no field at the 'ordinal' position
+    /// exists.
+    const char* getFieldName(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the field description corresponding to the field at the
+    /// specified 'ordinal' position, or 0 if no field at the 'ordinal'
+    /// position exists.
+    const char* getFieldDescription(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the type of the statistic at the specified 'ordinal'
+    /// position, or e_AVERAGE if no field at the 'ordinal' position exists
+    /// or the type is unknown.
+    ntci::Monitorable::StatisticType getFieldType(int ordinal) const
+        BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the flags that indicate which indexes to apply to the
+    /// statistics measured by this monitorable object.
+    int getFieldTags(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the ordinal of the specified 'fieldName', or a negative value
+    /// if no field identified by 'fieldName' exists.
+    int getFieldOrdinal(const char* fieldName) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the maximum number of elements in a datum resulting from
+    /// a call to 'getStats()'.
+    int numOrdinals() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the human-readable name of the monitorable object, or 0 or
+    /// the empty string if no such human-readable name has been assigned to
+    /// the monitorable object.
+    const char* objectName() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Append to the specified 'result' the iterations retained by the
+    /// trace of this profiler, oldest first.
+    void loadTrace(bsl::vector<Iteration>* result) const;
+
+    /// Enable or disable tracing of each iteration by all profilers
+    /// according to the specified 'enabled' flag.
+    static void setTracing(bool enabled);
+
+    /// Return true if tracing of each iteration is enabled, otherwise
+    /// return false.
+    static bool isTracing();
+
+    /// Append to the specified 'result' the iterations retained by the
+    /// trace of each profiler registered with the monitorable registry.
+    static void loadTraces(bsl::vector<Iteration>* result);
+};
+
+/// @internal @brief
+/// Provide utilities to manage the loop profiler of a waiter.
+///
+/// @par Thread Safety
+/// This struct is thread safe.
+///
+/// @ingroup module_ntcs
+struct LoopProfilerUtil {
+    /// Load into the specified 'result' a new loop profiler for the waiter
+    /// having the specified 'waiterMetricName' and register it with the
+    /// default monitorable object registry. If 'waiterMetricName' is empty,
+    /// name the profiler after the specified 'driverMetricName' and
+    /// 'waiterIndex'. Optionally specify a 'basicAllocator' used to supply
+    /// memory. If 'basicAllocator' is 0, the currently installed default
+    /// allocator is used.
+    static void createProfiler(bsl::shared_ptr<ntcs::LoopProfiler>* result,
+                               const bsl::string& waiterMetricName,
+                               const bsl::string& driverMetricName,
+                               bsl::size_t        waiterIndex,
+                               bslma::Allocator*  basicAllocator = 0);
+
+    /// Deregister the specified 'profiler', if any, from the default
+    /// monitorable object registry.
+    static void destroyProfiler(
+        const bsl::shared_ptr<ntcs::LoopProfiler>& profiler);
+};
+
+#define NTCS_LOOPPROFILER_GET()                                               \
+    ntcs::LoopProfiler* profiler = result->d_profiler_sp.get()
+
+#define NTCS_LOOPPROFILER_BEGIN()                                             \
+    do {                                                                      \
+        if (profiler) {                                                       \
+            profiler->begin();                                                \
+        }                                                                     \
+    } while (false)
+
+#define NTCS_LOOPPROFILER_ENTER_DISPATCH()                                    \
+    do {                                                                      \
+        if (profiler) {                                                       \
+            profiler->enter(ntcs::LoopProfilerIteration::e_DISPATCH);         \
+        }                                                                     \
+    } while (false)
+
+#define NTCS_LOOPPROFILER_EVENT()                                             \
+    do {                                                                      \
+        if (profiler) {                                                       \
+            profiler->logEvent();                                             \
+        }                                                                     \
+    } while (false)
+
+#define NTCS_LOOPPROFILER_END()                                               \
+    do {                                                                      \
+        if (profiler) {                                                       \
+            profiler->end();                                                  \
+        }                                                                     \
+    } while (false)
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
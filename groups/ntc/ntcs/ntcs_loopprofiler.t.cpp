@@ -0,0 +1,176 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_loopprofiler_t_cpp, "$Id$ $CSID$")
+
+#include <ntcs_loopprofiler.h>
+
+#include <bdld_datum.h>
+#include <bdld_manageddatum.h>
+#include <bsl_cstring.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcs {
+
+// Provide tests for 'ntcs::LoopProfiler'.
+class LoopProfilerTest
+{
+    // Return the ordinal of the field of the specified 'profiler' having
+    // the specified 'fieldName', or -1 if no such field exists.
+    static int findOrdinal(const ntcs::LoopProfiler& profiler,
+                           const char*               fieldName);
+
+    // Run one iteration of a simulated event loop measured by the specified
+    // 'profiler' that dispatches the specified 'numEvents'.
+    static void iterate(ntcs::LoopProfiler* profiler, bsl::size_t numEvents);
+
+  public:
+    // Concern: Each iteration measures the duration of each phase and the
+    // latency of each event dispatched.
+    static void verifyPhases();
+
+    // Concern: Iterations are traced only while tracing is enabled, and the
+    // trace retains only the most recent iterations, oldest first.
+    static void verifyTrace();
+};
+
+int LoopProfilerTest::findOrdinal(const ntcs::LoopProfiler& profiler,
+                                  const char*               fieldName)
+{
+    for (int i = 0; i < profiler.numOrdinals(); ++i) {
+        if (bsl::strcmp(profiler.getFieldName(i), fieldName) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void LoopProfilerTest::iterate(ntcs::LoopProfiler* profiler,
+                               bsl::size_t         numEvents)
+{
+    profiler->begin();
+
+    profiler->enter(ntcs::LoopProfilerIteration::e_DISPATCH);
+    for (bsl::size_t i = 0; i < numEvents; ++i) {
+        profiler->logEvent();
+    }
+
+    profiler->enter(ntcs::LoopProfilerIteration::e_FUNCTIONS);
+    profiler->enter(ntcs::LoopProfilerIteration::e_TIMERS);
+
+    profiler->end();
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::LoopProfilerTest::verifyPhases)
+{
+    ntcs::LoopProfiler profiler("profile", "test", NTSCFG_TEST_ALLOCATOR);
+
+    LoopProfilerTest::iterate(&profiler, 3);
+    LoopProfilerTest::iterate(&profiler, 2);
+
+    const int waitCount = findOrdinal(profiler, "waitTime.count");
+    const int timerCount = findOrdinal(profiler, "timerTime.count");
+    const int latencyCount = findOrdinal(profiler, "dispatchLatency.count");
+    const int latencyP50 = findOrdinal(profiler, "dispatchLatency.p50");
+
+    NTSCFG_TEST_EQ(waitCount, 0);
+    NTSCFG_TEST_GT(timerCount, 0);
+    NTSCFG_TEST_GT(latencyCount, 0);
+    NTSCFG_TEST_GT(latencyP50, 0);
+
+    NTSCFG_TEST_EQ(profiler.getFieldType(latencyP50),
+                   ntci::Monitorable::e_PERCENTILE);
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        profiler.getStats(&stats);
+
+        const bdld::DatumArrayRef array = stats.datum().theArray();
+
+        NTSCFG_TEST_EQ(array.length(),
+                       static_cast<bsl::size_t>(profiler.numOrdinals()));
+
+        NTSCFG_TEST_EQ(array[waitCount].theDouble(), 2);
+        NTSCFG_TEST_EQ(array[timerCount].theDouble(), 2);
+        NTSCFG_TEST_EQ(array[latencyCount].theDouble(), 5);
+        NTSCFG_TEST_TRUE(array[latencyP50].isDouble());
+    }
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        profiler.getStats(&stats);
+
+        const bdld::DatumArrayRef array = stats.datum().theArray();
+
+        NTSCFG_TEST_TRUE(array[latencyP50].isNull());
+    }
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::LoopProfilerTest::verifyTrace)
+{
+    ntcs::LoopProfiler profiler("profile", "test", NTSCFG_TEST_ALLOCATOR);
+
+    LoopProfilerTest::iterate(&profiler, 1);
+
+    {
+        bsl::vector<ntcs::LoopProfiler::Iteration> trace(
+            NTSCFG_TEST_ALLOCATOR);
+        profiler.loadTrace(&trace);
+
+        NTSCFG_TEST_TRUE(trace.empty());
+    }
+
+    ntcs::LoopProfiler::setTracing(true);
+    NTSCFG_TEST_TRUE(ntcs::LoopProfiler::isTracing());
+
+    const bsl::size_t numIterations =
+        ntcs::LoopProfiler::k_TRACE_CAPACITY + 10;
+
+    for (bsl::size_t i = 0; i < numIterations; ++i) {
+        LoopProfilerTest::iterate(&profiler, i);
+    }
+
+    ntcs::LoopProfiler::setTracing(false);
+    NTSCFG_TEST_FALSE(ntcs::LoopProfiler::isTracing());
+
+    LoopProfilerTest::iterate(&profiler, 1);
+
+    {
+        bsl::vector<ntcs::LoopProfiler::Iteration> trace(
+            NTSCFG_TEST_ALLOCATOR);
+        profiler.loadTrace(&trace);
+
+        NTSCFG_TEST_EQ(trace.size(), ntcs::LoopProfiler::k_TRACE_CAPACITY);
+
+        for (bsl::size_t i = 0; i < trace.size(); ++i) {
+            NTSCFG_TEST_EQ(trace[i].d_numEvents, i + 10);
+            NTSCFG_TEST_TRUE(trace[i].d_threadId != 0);
+
+            if (i > 0) {
+                NTSCFG_TEST_LE(trace[i - 1].d_startTime,
+                               trace[i].d_startTime);
+            }
+        }
+    }
+}
+
+}  // close namespace ntcs
+}  // close namespace BloombergLP
@@ -18,11 +18,17 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(ntcs_metrics_cpp, "$Id$ $CSID$")
 
+#include <ntcs_threadutil.h>
+#include <ntsa_guid.h>
+
 #include <bslmt_lockguard.h>
 
 #include <bslma_allocator.h>
 #include <bslma_default.h>
 #include <bsls_assert.h>
+#include <bsls_spinlock.h>
+#include <bsls_types.h>
+#include <bsl_cstring.h>
 
 namespace BloombergLP {
 namespace ntcs {
@@ -61,41 +67,39 @@ const ntci::MetricMetadata Metrics::STATISTICS[] = {
     NTCI_METRIC_METADATA_SUMMARY(txDelayBeforeAcknowledgement),
 
     NTCI_METRIC_METADATA_SUMMARY(rxDelayInHardware),
-    NTCI_METRIC_METADATA_SUMMARY(rxDelay)};
+    NTCI_METRIC_METADATA_SUMMARY(rxDelay),
+
+    NTCI_METRIC_METADATA_SUMMARY(tcpRoundTripTime),
+    NTCI_METRIC_METADATA_SUMMARY(tcpRoundTripTimeVariance),
+    NTCI_METRIC_METADATA_SUMMARY(tcpCongestionWindow),
+    NTCI_METRIC_METADATA_SUMMARY(tcpBytesUnacknowledged),
+    NTCI_METRIC_METADATA_SUMMARY(tcpRetransmissions),
+    NTCI_METRIC_METADATA_SUMMARY(tcpDeliveryRate),
+    NTCI_METRIC_METADATA_SUMMARY(tcpPacingRate),
+
+    NTCI_METRIC_METADATA_PERCENTILES(delayInWriteQueue),
+    NTCI_METRIC_METADATA_PERCENTILES(delayInReadQueue),
+    NTCI_METRIC_METADATA_PERCENTILES(txDelay),
+    NTCI_METRIC_METADATA_PERCENTILES(rxDelay),
+    NTCI_METRIC_METADATA_PERCENTILES(tcpRoundTripTime)};
 
 Metrics::Metrics(const bslstl::StringRef& prefix,
                  const bslstl::StringRef& objectName,
                  bslma::Allocator*        basicAllocator)
 : d_mutex()
-, d_numBytesSendable()
-, d_numBytesSent()
-, d_numBytesReceivable()
-, d_numBytesReceived()
-, d_numAcceptIterations()
-, d_numSendIterations()
-, d_numReceiveIterations()
-, d_acceptQueueSize()
-, d_acceptQueueDelay()
-, d_writeQueueSize()
-, d_writeQueueDelay()
-, d_readQueueSize()
-, d_readQueueDelay()
-, d_numConnectionsAccepted()
-, d_numConnectionsUnacceptable()
-, d_numConnectionsSynchronized()
-, d_numConnectionsUnsynchronizable()
-, d_numBytesAllocated()
-, d_txDelayBeforeScheduling()
-, d_txDelayInSoftware()
-, d_txDelay()
-, d_txDelayBeforeAcknowledgement()
-, d_rxDelayInHardware()
-, d_rxDelay()
+, d_counterLock(bsls::SpinLock::s_unlocked)
+, d_counter_p(0)
+, d_metric_p(0)
+, d_numShards(k_NUM_SHARDS)
+, d_histogram_p(0)
 , d_prefix(prefix, basicAllocator)
 , d_objectName(objectName, basicAllocator)
+, d_named(true)
 , d_parent_sp()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
+    this->privateHistogramCreate();
+    this->materialize();
 }
 
 Metrics::Metrics(const bslstl::StringRef&              prefix,
@@ -103,32 +107,14 @@ Metrics::Metrics(const bslstl::StringRef&              prefix,
                  const bsl::shared_ptr<ntcs::Metrics>& parent,
                  bslma::Allocator*                     basicAllocator)
 : d_mutex()
-, d_numBytesSendable()
-, d_numBytesSent()
-, d_numBytesReceivable()
-, d_numBytesReceived()
-, d_numAcceptIterations()
-, d_numSendIterations()
-, d_numReceiveIterations()
-, d_acceptQueueSize()
-, d_acceptQueueDelay()
-, d_writeQueueSize()
-, d_writeQueueDelay()
-, d_readQueueSize()
-, d_readQueueDelay()
-, d_numConnectionsAccepted()
-, d_numConnectionsUnacceptable()
-, d_numConnectionsSynchronized()
-, d_numConnectionsUnsynchronizable()
-, d_numBytesAllocated()
-, d_txDelayBeforeScheduling()
-, d_txDelayInSoftware()
-, d_txDelay()
-, d_txDelayBeforeAcknowledgement()
-, d_rxDelayInHardware()
-, d_rxDelay()
+, d_counterLock(bsls::SpinLock::s_unlocked)
+, d_counter_p(0)
+, d_metric_p(0)
+, d_numShards(k_NUM_SHARDS)
+, d_histogram_p(0)
 , d_prefix(basicAllocator)
 , d_objectName(basicAllocator)
+, d_named(true)
 , d_parent_sp(parent)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
@@ -142,15 +128,197 @@ Metrics::Metrics(const bslstl::StringRef&              prefix,
 
     d_prefix.append(prefix);
     d_objectName.append(objectName);
+
+    this->privateHistogramCreate();
+    this->materialize();
+}
+
+Metrics::Metrics(const bslstl::StringRef&              prefix,
+                 const bsl::shared_ptr<ntcs::Metrics>& parent,
+                 bslma::Allocator*                     basicAllocator)
+: d_mutex()
+, d_counterLock(bsls::SpinLock::s_unlocked)
+, d_counter_p(0)
+, d_metric_p(0)
+, d_numShards(1)
+, d_histogram_p(0)
+, d_prefix(prefix, basicAllocator)
+, d_objectName(basicAllocator)
+, d_named(false)
+, d_parent_sp(parent)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    d_counter_p = static_cast<Counter*>(
+        d_allocator_p->allocate(sizeof(Counter) * k_NUM_MEASUREMENTS));
+
+    bsl::memset(d_counter_p, 0, sizeof(Counter) * k_NUM_MEASUREMENTS);
 }
 
 Metrics::~Metrics()
 {
+    if (d_counter_p != 0) {
+        d_allocator_p->deallocate(d_counter_p);
+    }
+
+    ntci::Metric* metric = d_metric_p.loadRelaxed();
+    if (metric != 0) {
+        const bsl::size_t numMetrics = d_numShards * k_NUM_MEASUREMENTS;
+        for (bsl::size_t i = 0; i < numMetrics; ++i) {
+            metric[i].~Metric();
+        }
+
+        d_allocator_p->deallocate(metric);
+    }
+
+    if (d_histogram_p != 0) {
+        for (int i = 0; i < k_NUM_DISTRIBUTIONS; ++i) {
+            d_histogram_p[i].~MetricHistogram();
+        }
+
+        d_allocator_p->deallocate(d_histogram_p);
+    }
+}
+
+void Metrics::update(Measurement measurement, double value)
+{
+    ntci::Metric* metric = d_metric_p.loadAcquire();
+    if (metric == 0) {
+        bsls::SpinLockGuard guard(&d_counterLock);
+
+        metric = d_metric_p.loadRelaxed();
+        if (metric == 0) {
+            Counter& counter = d_counter_p[measurement];
+
+            if (counter.d_count == 0) {
+                counter.d_minimum = value;
+                counter.d_maximum = value;
+            }
+            else {
+                if (value < counter.d_minimum) {
+                    counter.d_minimum = value;
+                }
+
+                if (value > counter.d_maximum) {
+                    counter.d_maximum = value;
+                }
+            }
+
+            ++counter.d_count;
+            counter.d_total += value;
+
+            return;
+        }
+    }
+
+    bsl::size_t shard = 0;
+    if (d_numShards > 1) {
+        shard = ntcs::ThreadUtil::shardIndex(d_numShards);
+    }
+
+    metric[shard * k_NUM_MEASUREMENTS + measurement].update(value);
+}
+
+void Metrics::update(Distribution distribution, double value)
+{
+    if (d_histogram_p != 0) {
+        d_histogram_p[distribution].update(value);
+    }
+}
+
+void Metrics::privateHistogramCreate()
+{
+    // Queue delays are measured in seconds, and counted from 2^-24 seconds
+    // (about 60 nanoseconds). Transmit and receive delays are measured in
+    // microseconds, and counted from 2^-4 microseconds. TCP round trip
+    // times are reported by the kernel in whole microseconds.
+
+    ntci::MetricHistogram* histogram = static_cast<ntci::MetricHistogram*>(
+        d_allocator_p->allocate(sizeof(ntci::MetricHistogram) *
+                                k_NUM_DISTRIBUTIONS));
+
+    new (histogram + e_WRITE_QUEUE_DELAY_DISTRIBUTION)
+        ntci::MetricHistogram(-24);
+    new (histogram + e_READ_QUEUE_DELAY_DISTRIBUTION)
+        ntci::MetricHistogram(-24);
+    new (histogram + e_TX_DELAY_DISTRIBUTION) ntci::MetricHistogram(-4);
+    new (histogram + e_RX_DELAY_DISTRIBUTION) ntci::MetricHistogram(-4);
+    new (histogram + e_TCP_ROUND_TRIP_TIME_DISTRIBUTION)
+        ntci::MetricHistogram(0);
+
+    d_histogram_p = histogram;
+}
+
+void Metrics::privateName() const
+{
+    if (d_named) {
+        return;
+    }
+
+    // Lazy metrics defer this formatting, and generating the unique
+    // identifier, until the metrics are first described to a collector or
+    // publisher.
+
+    ntsa::Guid guid = ntsa::Guid::generate();
+    char       guidText[ntsa::Guid::SIZE_TEXT];
+    guid.writeText(guidText);
+
+    bsl::string prefix(d_allocator_p);
+    bsl::string objectName(d_allocator_p);
+
+    if (d_parent_sp) {
+        prefix.append(d_parent_sp->getFieldPrefix(0));
+        prefix.append(1, '.');
+
+        objectName.append(d_parent_sp->objectName());
+        objectName.append(1, '-');
+    }
+
+    prefix.append(d_prefix);
+
+    objectName.append(d_prefix);
+    objectName.append(1, '-');
+    objectName.append(guidText, ntsa::Guid::SIZE_TEXT);
+
+    d_prefix.swap(prefix);
+    d_objectName.swap(objectName);
+
+    d_named = true;
+}
+
+void Metrics::materialize()
+{
+    if (d_metric_p.loadAcquire() != 0) {
+        return;
+    }
+
+    const bsl::size_t numMetrics = d_numShards * k_NUM_MEASUREMENTS;
+
+    ntci::Metric* metric = static_cast<ntci::Metric*>(
+        d_allocator_p->allocate(sizeof(ntci::Metric) * numMetrics));
+
+    for (bsl::size_t i = 0; i < numMetrics; ++i) {
+        new (metric + i) ntci::Metric();
+    }
+
+    {
+        bsls::SpinLockGuard guard(&d_counterLock);
+
+        if (d_metric_p.loadRelaxed() == 0) {
+            d_metric_p.storeRelease(metric);
+            return;
+        }
+    }
+
+    for (bsl::size_t i = 0; i < numMetrics; ++i) {
+        metric[i].~Metric();
+    }
+
+    d_allocator_p->deallocate(metric);
 }
 
 void Metrics::logConnectCompletion()
 {
-    d_numConnectionsSynchronized.update(1);
+    this->update(e_CONNECTIONS_SYNCHRONIZED, 1);
 
     if (d_parent_sp) {
         d_parent_sp->logConnectCompletion();
@@ -159,7 +327,7 @@ void Metrics::logConnectCompletion()
 
 void Metrics::logConnectFailure()
 {
-    d_numConnectionsUnsynchronizable.update(1);
+    this->update(e_CONNECTIONS_UNSYNCHRONIZABLE, 1);
 
     if (d_parent_sp) {
         d_parent_sp->logConnectFailure();
@@ -168,7 +336,7 @@ void Metrics::logConnectFailure()
 
 void Metrics::logAcceptCompletion()
 {
-    d_numConnectionsAccepted.update(1);
+    this->update(e_CONNECTIONS_ACCEPTED, 1);
 
     if (d_parent_sp) {
         d_parent_sp->logAcceptCompletion();
@@ -177,7 +345,7 @@ void Metrics::logAcceptCompletion()
 
 void Metrics::logAcceptFailure()
 {
-    d_numConnectionsUnacceptable.update(1);
+    this->update(e_CONNECTIONS_UNACCEPTABLE, 1);
 
     if (d_parent_sp) {
         d_parent_sp->logAcceptFailure();
@@ -187,7 +355,7 @@ void Metrics::logAcceptFailure()
 void Metrics::logAcceptIterations(bsl::size_t numIterations)
 {
     if (numIterations > 0) {
-        d_numReceiveIterations.update(static_cast<double>(numIterations));
+        this->update(e_RECEIVE_ITERATIONS, static_cast<double>(numIterations));
     }
 
     if (d_parent_sp) {
@@ -198,8 +366,8 @@ void Metrics::logAcceptIterations(bsl::size_t numIterations)
 void Metrics::logSendCompletion(bsl::size_t numBytesSendable,
                                 bsl::size_t numBytesSent)
 {
-    d_numBytesSendable.update(static_cast<double>(numBytesSendable));
-    d_numBytesSent.update(static_cast<double>(numBytesSent));
+    this->update(e_BYTES_SENDABLE, static_cast<double>(numBytesSendable));
+    this->update(e_BYTES_SENT, static_cast<double>(numBytesSent));
 
     if (d_parent_sp) {
         d_parent_sp->logSendCompletion(numBytesSendable, numBytesSent);
@@ -209,7 +377,7 @@ void Metrics::logSendCompletion(bsl::size_t numBytesSendable,
 void Metrics::logSendIterations(bsl::size_t numIterations)
 {
     if (numIterations > 0) {
-        d_numSendIterations.update(static_cast<double>(numIterations));
+        this->update(e_SEND_ITERATIONS, static_cast<double>(numIterations));
     }
 
     if (d_parent_sp) {
@@ -220,8 +388,8 @@ void Metrics::logSendIterations(bsl::size_t numIterations)
 void Metrics::logReceiveCompletion(bsl::size_t numBytesReceivable,
                                    bsl::size_t numBytesReceived)
 {
-    d_numBytesReceivable.update(static_cast<double>(numBytesReceivable));
-    d_numBytesReceived.update(static_cast<double>(numBytesReceived));
+    this->update(e_BYTES_RECEIVABLE, static_cast<double>(numBytesReceivable));
+    this->update(e_BYTES_RECEIVED, static_cast<double>(numBytesReceived));
 
     if (d_parent_sp) {
         d_parent_sp->logReceiveCompletion(numBytesReceivable,
@@ -232,7 +400,7 @@ void Metrics::logReceiveCompletion(bsl::size_t numBytesReceivable,
 void Metrics::logReceiveIterations(bsl::size_t numIterations)
 {
     if (numIterations > 0) {
-        d_numReceiveIterations.update(static_cast<double>(numIterations));
+        this->update(e_RECEIVE_ITERATIONS, static_cast<double>(numIterations));
     }
 
     if (d_parent_sp) {
@@ -242,7 +410,7 @@ void Metrics::logReceiveIterations(bsl::size_t numIterations)
 
 void Metrics::logAcceptQueueSize(bsl::size_t acceptQueueSize)
 {
-    d_acceptQueueSize.update(static_cast<double>(acceptQueueSize));
+    this->update(e_ACCEPT_QUEUE_SIZE, static_cast<double>(acceptQueueSize));
 
     if (d_parent_sp) {
         d_parent_sp->logAcceptQueueSize(acceptQueueSize);
@@ -251,7 +419,8 @@ void Metrics::logAcceptQueueSize(bsl::size_t acceptQueueSize)
 
 void Metrics::logAcceptQueueDelay(const bsls::TimeInterval& acceptQueueDelay)
 {
-    d_acceptQueueDelay.update(acceptQueueDelay.totalSecondsAsDouble());
+    this->update(e_ACCEPT_QUEUE_DELAY,
+                 acceptQueueDelay.totalSecondsAsDouble());
 
     if (d_parent_sp) {
         d_parent_sp->logAcceptQueueDelay(acceptQueueDelay);
@@ -260,7 +429,7 @@ void Metrics::logAcceptQueueDelay(const bsls::TimeInterval& acceptQueueDelay)
 
 void Metrics::logWriteQueueSize(bsl::size_t writeQueueSize)
 {
-    d_writeQueueSize.update(static_cast<double>(writeQueueSize));
+    this->update(e_WRITE_QUEUE_SIZE, static_cast<double>(writeQueueSize));
 
     if (d_parent_sp) {
         d_parent_sp->logWriteQueueSize(writeQueueSize);
@@ -269,7 +438,9 @@ void Metrics::logWriteQueueSize(bsl::size_t writeQueueSize)
 
 void Metrics::logWriteQueueDelay(const bsls::TimeInterval& writeQueueDelay)
 {
-    d_writeQueueDelay.update(writeQueueDelay.totalSecondsAsDouble());
+    this->update(e_WRITE_QUEUE_DELAY, writeQueueDelay.totalSecondsAsDouble());
+    this->update(e_WRITE_QUEUE_DELAY_DISTRIBUTION,
+                 writeQueueDelay.totalSecondsAsDouble());
 
     if (d_parent_sp) {
         d_parent_sp->logWriteQueueDelay(writeQueueDelay);
@@ -278,7 +449,7 @@ void Metrics::logWriteQueueDelay(const bsls::TimeInterval& writeQueueDelay)
 
 void Metrics::logReadQueueSize(bsl::size_t readQueueSize)
 {
-    d_readQueueSize.update(static_cast<double>(readQueueSize));
+    this->update(e_READ_QUEUE_SIZE, static_cast<double>(readQueueSize));
 
     if (d_parent_sp) {
         d_parent_sp->logReadQueueSize(readQueueSize);
@@ -287,7 +458,9 @@ void Metrics::logReadQueueSize(bsl::size_t readQueueSize)
 
 void Metrics::logReadQueueDelay(const bsls::TimeInterval& readQueueDelay)
 {
-    d_readQueueDelay.update(readQueueDelay.totalSecondsAsDouble());
+    this->update(e_READ_QUEUE_DELAY, readQueueDelay.totalSecondsAsDouble());
+    this->update(e_READ_QUEUE_DELAY_DISTRIBUTION,
+                 readQueueDelay.totalSecondsAsDouble());
 
     if (d_parent_sp) {
         d_parent_sp->logReadQueueDelay(readQueueDelay);
@@ -296,7 +469,7 @@ void Metrics::logReadQueueDelay(const bsls::TimeInterval& readQueueDelay)
 
 void Metrics::logBlobBufferAllocation(bsl::size_t blobBufferCapacity)
 {
-    d_numBytesAllocated.update(static_cast<double>(blobBufferCapacity));
+    this->update(e_BYTES_ALLOCATED, static_cast<double>(blobBufferCapacity));
 
     if (d_parent_sp) {
         d_parent_sp->logBlobBufferAllocation(blobBufferCapacity);
@@ -306,7 +479,8 @@ void Metrics::logBlobBufferAllocation(bsl::size_t blobBufferCapacity)
 void Metrics::logTxDelayBeforeScheduling(
     const bsls::TimeInterval& txDelayBeforeScheduling)
 {
-    d_txDelayBeforeScheduling.update(
+    this->update(
+        e_TX_DELAY_BEFORE_SCHEDULING,
         static_cast<double>(txDelayBeforeScheduling.totalMicroseconds()));
 
     if (d_parent_sp) {
@@ -316,8 +490,8 @@ void Metrics::logTxDelayBeforeScheduling(
 
 void Metrics::logTxDelayInSoftware(const bsls::TimeInterval& txDelayInSoftware)
 {
-    d_txDelayInSoftware.update(
-        static_cast<double>(txDelayInSoftware.totalMicroseconds()));
+    this->update(e_TX_DELAY_IN_SOFTWARE,
+                 static_cast<double>(txDelayInSoftware.totalMicroseconds()));
 
     if (d_parent_sp) {
         d_parent_sp->logTxDelayInSoftware(txDelayInSoftware);
@@ -326,7 +500,9 @@ void Metrics::logTxDelayInSoftware(const bsls::TimeInterval& txDelayInSoftware)
 
 void Metrics::logTxDelay(const bsls::TimeInterval& txDelay)
 {
-    d_txDelay.update(static_cast<double>(txDelay.totalMicroseconds()));
+    this->update(e_TX_DELAY, static_cast<double>(txDelay.totalMicroseconds()));
+    this->update(e_TX_DELAY_DISTRIBUTION,
+                 static_cast<double>(txDelay.totalMicroseconds()));
 
     if (d_parent_sp) {
         d_parent_sp->logTxDelay(txDelay);
@@ -336,7 +512,8 @@ void Metrics::logTxDelay(const bsls::TimeInterval& txDelay)
 void Metrics::logTxDelayBeforeAcknowledgement(
     const bsls::TimeInterval& txDelayBeforeAcknowledgement)
 {
-    d_txDelayBeforeAcknowledgement.update(
+    this->update(
+        e_TX_DELAY_BEFORE_ACKNOWLEDGEMENT,
         static_cast<double>(txDelayBeforeAcknowledgement.totalMicroseconds()));
 
     if (d_parent_sp) {
@@ -347,8 +524,8 @@ void Metrics::logTxDelayBeforeAcknowledgement(
 
 void Metrics::logRxDelayInHardware(const bsls::TimeInterval& rxDelayInHardware)
 {
-    d_rxDelayInHardware.update(
-        static_cast<double>(rxDelayInHardware.totalMicroseconds()));
+    this->update(e_RX_DELAY_IN_HARDWARE,
+                 static_cast<double>(rxDelayInHardware.totalMicroseconds()));
 
     if (d_parent_sp) {
         d_parent_sp->logRxDelay(rxDelayInHardware);
@@ -357,17 +534,78 @@ void Metrics::logRxDelayInHardware(const bsls::TimeInterval& rxDelayInHardware)
 
 void Metrics::logRxDelay(const bsls::TimeInterval& rxDelay)
 {
-    d_rxDelay.update(static_cast<double>(rxDelay.totalMicroseconds()));
+    this->update(e_RX_DELAY, static_cast<double>(rxDelay.totalMicroseconds()));
+    this->update(e_RX_DELAY_DISTRIBUTION,
+                 static_cast<double>(rxDelay.totalMicroseconds()));
 
     if (d_parent_sp) {
         d_parent_sp->logRxDelay(rxDelay);
     }
 }
 
+void Metrics::logTcpInfo(const ntsa::TcpInfo& tcpInfo)
+{
+    const double roundTripTime =
+        static_cast<double>(tcpInfo.roundTripTime().totalMicroseconds());
+
+    this->update(e_TCP_ROUND_TRIP_TIME, roundTripTime);
+    this->update(e_TCP_ROUND_TRIP_TIME_DISTRIBUTION, roundTripTime);
+
+    this->update(e_TCP_ROUND_TRIP_TIME_VARIANCE,
+                 static_cast<double>(
+                     tcpInfo.roundTripTimeVariance().totalMicroseconds()));
+
+    this->update(e_TCP_CONGESTION_WINDOW,
+                 static_cast<double>(tcpInfo.congestionWindow()));
+
+    this->update(e_TCP_BYTES_UNACKNOWLEDGED,
+                 static_cast<double>(tcpInfo.unacknowledgedBytes()));
+
+    if (tcpInfo.deliveryRate().has_value()) {
+        this->update(e_TCP_DELIVERY_RATE,
+                     static_cast<double>(tcpInfo.deliveryRate().value()));
+    }
+
+    if (tcpInfo.pacingRate().has_value()) {
+        this->update(e_TCP_PACING_RATE,
+                     static_cast<double>(tcpInfo.pacingRate().value()));
+    }
+
+    if (d_parent_sp) {
+        d_parent_sp->logTcpInfo(tcpInfo);
+    }
+}
+
+void Metrics::logTcpRetransmissions(bsl::uint64_t numRetransmissions)
+{
+    this->update(e_TCP_RETRANSMISSIONS,
+                 static_cast<double>(numRetransmissions));
+
+    if (d_parent_sp) {
+        d_parent_sp->logTcpRetransmissions(numRetransmissions);
+    }
+}
+
 void Metrics::getStats(bdld::ManagedDatum* result)
 {
     LockGuard guard(&d_mutex);
 
+    this->materialize();
+
+    ntci::Metric* metric = d_metric_p.loadAcquire();
+
+    // Lazy metrics record each measurement into the compact counter block
+    // until materialized, so the first collection after materialization
+    // drains those measurements and releases the block, which is no longer
+    // updated once the metrics are materialized.
+
+    Counter* counter = 0;
+    {
+        bsls::SpinLockGuard counterGuard(&d_counterLock);
+        counter     = d_counter_p;
+        d_counter_p = 0;
+    }
+
     bdld::DatumMutableArrayRef array;
     bdld::Datum::createUninitializedArray(&array,
                                           numOrdinals(),
@@ -375,41 +613,41 @@ void Metrics::getStats(bdld::ManagedDatum* result)
 
     bsl::size_t index = 0;
 
-    d_numBytesSendable.collectSummary(&array, &index);
-    d_numBytesSent.collectSummary(&array, &index);
-
-    d_numBytesReceivable.collectSummary(&array, &index);
-    d_numBytesReceived.collectSummary(&array, &index);
-
-    d_numAcceptIterations.collectSummary(&array, &index);
-    d_numSendIterations.collectSummary(&array, &index);
-    d_numReceiveIterations.collectSummary(&array, &index);
-
-    d_acceptQueueSize.collectSummary(&array, &index);
-    d_acceptQueueDelay.collectSummary(&array, &index);
-
-    d_writeQueueSize.collectSummary(&array, &index);
-    d_writeQueueDelay.collectSummary(&array, &index);
-
-    d_readQueueSize.collectSummary(&array, &index);
-    d_readQueueDelay.collectSummary(&array, &index);
-
-    d_numConnectionsAccepted.collectSummary(&array, &index);
+    for (int i = 0; i < k_NUM_MEASUREMENTS; ++i) {
+        ntci::MetricValue value;
+        if (counter != 0 && counter[i].d_count > 0) {
+            value = ntci::MetricValue(counter[i].d_count,
+                                      counter[i].d_total,
+                                      counter[i].d_minimum,
+                                      counter[i].d_maximum,
+                                      0);
+        }
 
-    d_numConnectionsUnacceptable.collectSummary(&array, &index);
+        for (bsl::size_t shard = 0; shard < d_numShards; ++shard) {
+            ntci::MetricValue shardValue;
+            metric[shard * k_NUM_MEASUREMENTS + i].load(&shardValue);
 
-    d_numConnectionsSynchronized.collectSummary(&array, &index);
+            value.merge(shardValue);
+        }
 
-    d_numConnectionsUnsynchronizable.collectSummary(&array, &index);
+        value.collectSummary(&array, &index);
+    }
 
-    d_numBytesAllocated.collectSummary(&array, &index);
+    if (counter != 0) {
+        d_allocator_p->deallocate(counter);
+    }
 
-    d_txDelayBeforeScheduling.collectSummary(&array, &index);
-    d_txDelayInSoftware.collectSummary(&array, &index);
-    d_txDelay.collectSummary(&array, &index);
-    d_txDelayBeforeAcknowledgement.collectSummary(&array, &index);
-    d_rxDelayInHardware.collectSummary(&array, &index);
-    d_rxDelay.collectSummary(&array, &index);
+    for (int i = 0; i < k_NUM_DISTRIBUTIONS; ++i) {
+        if (d_histogram_p != 0) {
+            d_histogram_p[i].collectPercentiles(&array, &index);
+        }
+        else {
+            for (int j = 0; j < ntci::MetricHistogram::k_NUM_PERCENTILES; ++j)
+            {
+                array.data()[index++] = bdld::Datum::createNull();
+            }
+        }
+    }
 
     // TODO: Calculate and publish derivative metrics.
     // double avgBytesSentPerEvent = 0;
@@ -424,6 +662,10 @@ const char* Metrics::getFieldPrefix(int ordinal) const
 {
     NTCCFG_WARNING_UNUSED(ordinal);
 
+    LockGuard guard(&d_mutex);
+
+    this->privateName();
+
     return d_prefix.c_str();
 }
 
@@ -481,6 +723,10 @@ int Metrics::numOrdinals() const
 
 const char* Metrics::objectName() const
 {
+    LockGuard guard(&d_mutex);
+
+    this->privateName();
+
     return d_objectName.c_str();
 }
 
@@ -489,5 +735,10 @@ const bsl::shared_ptr<ntcs::Metrics>& Metrics::parent() const
     return d_parent_sp;
 }
 
+bool Metrics::isMaterialized() const
+{
+    return d_metric_p.loadAcquire() != 0;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
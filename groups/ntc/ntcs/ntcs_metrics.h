@@ -23,8 +23,11 @@ BSLS_IDENT("$Id: $")
 #include <ntci_metric.h>
 #include <ntci_monitorable.h>
 #include <ntcscm_version.h>
+#include <ntsa_tcpinfo.h>
 #include <bslmt_mutex.h>
 #include <bslmt_threadutil.h>
+#include <bsls_atomic.h>
+#include <bsls_spinlock.h>
 #include <bsl_memory.h>
 #include <bsl_string.h>
 #include <bsl_vector.h>
@@ -35,6 +38,27 @@ namespace ntcs {
 /// @internal @brief
 /// Provide statistics for the runtime behavior of sockets.
 ///
+/// @details
+/// Metrics may be created either eagerly or lazily. Eager metrics record each
+/// measurement into sharded, lock-free 'ntci::Metric' objects and have a
+/// fixed object name. Lazy metrics, intended for the metrics of individual sockets,
+/// record measurements into a compact block of counters guarded by a single
+/// lock, and defer formatting their field prefix and object name until
+/// either is first requested. Lazy metrics are materialized into their eager
+/// representation when they are first collected or when 'materialize()' is
+/// explicitly called. The block of counters is allocated only by lazy
+/// metrics, and is released when the measurements recorded into it are
+/// first collected. In both representations, each measurement is also
+/// aggregated into the parent metrics, if any.
+///
+/// Eager metrics, which are typically shared by all the sockets of an
+/// interface and so updated concurrently by many threads, shard their
+/// measurements across a fixed number of blocks selected by the identity of
+/// the updating thread, and merge the shards when collected. Eager metrics
+/// also count the distribution of write queue, read queue, transmit, and
+/// receive delays in log-linear histograms, and publish their 50th, 90th,
+/// 99th, and 99.9th percentiles. Lazy metrics publish null percentiles.
+///
 /// @par Thread Safety
 /// This class is thread safe.
 ///
@@ -47,35 +71,79 @@ class Metrics : public ntci::Monitorable, public ntccfg::Shared<Metrics>
     /// Define a type alias for a mutex lock guard.
     typedef ntccfg::LockGuard LockGuard;
 
-    mutable Mutex                  d_mutex;
-    ntci::Metric                   d_numBytesSendable;
-    ntci::Metric                   d_numBytesSent;
-    ntci::Metric                   d_numBytesReceivable;
-    ntci::Metric                   d_numBytesReceived;
-    ntci::Metric                   d_numAcceptIterations;
-    ntci::Metric                   d_numSendIterations;
-    ntci::Metric                   d_numReceiveIterations;
-    ntci::Metric                   d_acceptQueueSize;
-    ntci::Metric                   d_acceptQueueDelay;
-    ntci::Metric                   d_writeQueueSize;
-    ntci::Metric                   d_writeQueueDelay;
-    ntci::Metric                   d_readQueueSize;
-    ntci::Metric                   d_readQueueDelay;
-    ntci::Metric                   d_numConnectionsAccepted;
-    ntci::Metric                   d_numConnectionsUnacceptable;
-    ntci::Metric                   d_numConnectionsSynchronized;
-    ntci::Metric                   d_numConnectionsUnsynchronizable;
-    ntci::Metric                   d_numBytesAllocated;
-    ntci::Metric                   d_txDelayBeforeScheduling;
-    ntci::Metric                   d_txDelayInSoftware;
-    ntci::Metric                   d_txDelay;
-    ntci::Metric                   d_txDelayBeforeAcknowledgement;
-    ntci::Metric                   d_rxDelayInHardware;
-    ntci::Metric                   d_rxDelay;
-    bsl::string                    d_prefix;
-    bsl::string                    d_objectName;
-    bsl::shared_ptr<ntcs::Metrics> d_parent_sp;
-    bslma::Allocator*              d_allocator_p;
+    /// Enumerate the measurements recorded by these metrics, in the order
+    /// in which they are published.
+    enum Measurement {
+        e_BYTES_SENDABLE,
+        e_BYTES_SENT,
+        e_BYTES_RECEIVABLE,
+        e_BYTES_RECEIVED,
+        e_ACCEPT_ITERATIONS,
+        e_SEND_ITERATIONS,
+        e_RECEIVE_ITERATIONS,
+        e_ACCEPT_QUEUE_SIZE,
+        e_ACCEPT_QUEUE_DELAY,
+        e_WRITE_QUEUE_SIZE,
+        e_WRITE_QUEUE_DELAY,
+        e_READ_QUEUE_SIZE,
+        e_READ_QUEUE_DELAY,
+        e_CONNECTIONS_ACCEPTED,
+        e_CONNECTIONS_UNACCEPTABLE,
+        e_CONNECTIONS_SYNCHRONIZED,
+        e_CONNECTIONS_UNSYNCHRONIZABLE,
+        e_BYTES_ALLOCATED,
+        e_TX_DELAY_BEFORE_SCHEDULING,
+        e_TX_DELAY_IN_SOFTWARE,
+        e_TX_DELAY,
+        e_TX_DELAY_BEFORE_ACKNOWLEDGEMENT,
+        e_RX_DELAY_IN_HARDWARE,
+        e_RX_DELAY,
+        e_TCP_ROUND_TRIP_TIME,
+        e_TCP_ROUND_TRIP_TIME_VARIANCE,
+        e_TCP_CONGESTION_WINDOW,
+        e_TCP_BYTES_UNACKNOWLEDGED,
+        e_TCP_RETRANSMISSIONS,
+        e_TCP_DELIVERY_RATE,
+        e_TCP_PACING_RATE,
+        k_NUM_MEASUREMENTS
+    };
+
+    /// Enumerate the measurements whose distribution is recorded by these
+    /// metrics, in the order in which they are published.
+    enum Distribution {
+        e_WRITE_QUEUE_DELAY_DISTRIBUTION,
+        e_READ_QUEUE_DELAY_DISTRIBUTION,
+        e_TX_DELAY_DISTRIBUTION,
+        e_RX_DELAY_DISTRIBUTION,
+        e_TCP_ROUND_TRIP_TIME_DISTRIBUTION,
+        k_NUM_DISTRIBUTIONS
+    };
+
+    enum {
+        /// The number of shards of eager metrics.
+        k_NUM_SHARDS = 8
+    };
+
+    /// Describe the compact summary of a measurement recorded before these
+    /// metrics are materialized.
+    struct Counter {
+        bsl::uint64_t d_count;
+        double        d_total;
+        double        d_minimum;
+        double        d_maximum;
+    };
+
+    mutable Mutex                     d_mutex;
+    bsls::SpinLock                    d_counterLock;
+    Counter*                          d_counter_p;
+    bsls::AtomicPointer<ntci::Metric> d_metric_p;
+    bsl::size_t                       d_numShards;
+    ntci::MetricHistogram*            d_histogram_p;
+    mutable bsl::string               d_prefix;
+    mutable bsl::string               d_objectName;
+    mutable bool                      d_named;
+    bsl::shared_ptr<ntcs::Metrics>    d_parent_sp;
+    bslma::Allocator*                 d_allocator_p;
 
     static const struct ntci::MetricMetadata STATISTICS[];
 
@@ -83,6 +151,22 @@ class Metrics : public ntci::Monitorable, public ntccfg::Shared<Metrics>
     Metrics(const Metrics&) BSLS_KEYWORD_DELETED;
     Metrics& operator=(const Metrics&) BSLS_KEYWORD_DELETED;
 
+  private:
+    /// Record the specified 'value' of the specified 'measurement'.
+    void update(Measurement measurement, double value);
+
+    /// Record the specified 'value' in the specified 'distribution', if
+    /// distributions are recorded by these metrics.
+    void update(Distribution distribution, double value);
+
+    /// Allocate the histograms recording each distribution.
+    void privateHistogramCreate();
+
+    /// Format the field prefix and object name of these metrics, if not
+    /// already formatted. The behavior is undefined unless 'd_mutex' is
+    /// locked.
+    void privateName() const;
+
   public:
     /// Create new metrics for the specified 'objectName whose field names
     /// have the specified 'prefix'. Optionally specify a 'basicAllocator'
@@ -102,9 +186,23 @@ class Metrics : public ntci::Monitorable, public ntccfg::Shared<Metrics>
             const bsl::shared_ptr<ntcs::Metrics>& parent,
             bslma::Allocator*                     basicAllocator = 0);
 
+    /// Create new lazy metrics whose field names have the specified
+    /// 'prefix' and whose object name is formed from the 'prefix' and a
+    /// unique identifier when first requested. Aggregate updates into the
+    /// specified 'parent'. Optionally specify a 'basicAllocator' used to
+    /// supply memory. If 'basicAllocator' is 0, the currently installed
+    /// default allocator is used.
+    Metrics(const bslstl::StringRef&              prefix,
+            const bsl::shared_ptr<ntcs::Metrics>& parent,
+            bslma::Allocator*                     basicAllocator = 0);
+
     /// Destroy this object.
     ~Metrics() BSLS_KEYWORD_OVERRIDE;
 
+    /// Materialize these metrics into sharded, lock-free measurements, if
+    /// not already materialized.
+    void materialize();
+
     /// Log the synchronization of a connection.
     void logConnectCompletion();
 
@@ -181,6 +279,16 @@ class Metrics : public ntci::Monitorable, public ntccfg::Shared<Metrics>
     /// Log the gauge of the specified 'rxDelay'.
     void logRxDelay(const bsls::TimeInterval& rxDelay);
 
+    /// Log the round trip time, congestion window, unacknowledged bytes,
+    /// and delivery and pacing rates sampled in the specified 'tcpInfo'.
+    /// Note that the retransmissions reported by 'tcpInfo' are cumulative
+    /// and are not logged by this function: see 'logTcpRetransmissions'.
+    void logTcpInfo(const ntsa::TcpInfo& tcpInfo);
+
+    /// Log the specified 'numRetransmissions' observed since the previous
+    /// sample of the connection.
+    void logTcpRetransmissions(bsl::uint64_t numRetransmissions);
+
     /// Load into the specified 'result' the array of statistics from the
     /// specified 'snapshot' for this object based on the specified
     /// 'operation': if 'operation' is e_CUMULATIVE then the statistics are
@@ -232,6 +340,11 @@ class Metrics : public ntci::Monitorable, public ntccfg::Shared<Metrics>
     /// Return the parent metrics object into which these metrics are
     /// aggregated, or null if no such parent object is defined.
     const bsl::shared_ptr<ntcs::Metrics>& parent() const;
+
+    /// Return true if these metrics record measurements into sharded,
+    /// lock-free metrics, and false if these metrics record measurements
+    /// into their compact counter block.
+    bool isMaterialized() const;
 };
 
 #if NTC_BUILD_WITH_METRICS
@@ -20,6 +20,13 @@ BSLS_IDENT_RCSID(ntcs_metrics_t_cpp, "$Id$ $CSID$")
 
 #include <ntcs_metrics.h>
 
+#include <bdld_datum.h>
+#include <bdld_manageddatum.h>
+#include <bdlf_bind.h>
+#include <bslmt_threadgroup.h>
+#include <bsls_timeinterval.h>
+#include <bsl_cstring.h>
+
 using namespace BloombergLP;
 
 namespace BloombergLP {
@@ -28,14 +35,331 @@ namespace ntcs {
 // Provide tests for 'ntcs::Metrics'.
 class MetricsTest
 {
+    // Collect the statistics of the specified 'metrics' and verify the
+    // summary of the number of bytes sendable matches the specified
+    // 'count', 'total', 'minimum', and 'maximum'.
+    static void verifyBytesSendable(ntcs::Metrics* metrics,
+                                    double         count,
+                                    double         total,
+                                    double         minimum,
+                                    double         maximum);
+
+    // Log the specified 'numSends' send completions to the specified
+    // 'metrics'.
+    static void logSends(ntcs::Metrics* metrics, bsl::size_t numSends);
+
   public:
     // TODO
     static void verify();
+
+    // Concern: Lazy metrics record measurements before materialization and
+    // publish them at the first collection.
+    static void verifyLazy();
+
+    // Concern: Explicitly materializing lazy metrics loses no measurements.
+    static void verifyMaterialize();
+
+    // Concern: Lazy metrics format their names only when first requested.
+    static void verifyLazyNomenclature();
+
+    // Concern: Eager metrics updated concurrently from many threads merge
+    // their shards on collection.
+    static void verifySharding();
+
+    // Concern: Eager metrics publish the percentiles of delays.
+    static void verifyPercentiles();
+
+    // Concern: The metrics of an interface aggregate the distribution of
+    // TCP state sampled from each of its sockets.
+    static void verifyTcpInfo();
 };
 
+void MetricsTest::logSends(ntcs::Metrics* metrics, bsl::size_t numSends)
+{
+    for (bsl::size_t i = 0; i < numSends; ++i) {
+        metrics->logSendCompletion(100, 100);
+    }
+}
+
+void MetricsTest::verifyBytesSendable(ntcs::Metrics* metrics,
+                                      double         count,
+                                      double         total,
+                                      double         minimum,
+                                      double         maximum)
+{
+    bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+    metrics->getStats(&stats);
+
+    NTSCFG_TEST_TRUE(stats.datum().isArray());
+    NTSCFG_TEST_EQ(stats.datum().theArray().length(),
+                   static_cast<bsl::size_t>(metrics->numOrdinals()));
+
+    const bdld::DatumArrayRef array = stats.datum().theArray();
+
+    if (count == 0) {
+        NTSCFG_TEST_TRUE(array[0].isNull());
+        NTSCFG_TEST_TRUE(array[4].isNull());
+    }
+    else {
+        NTSCFG_TEST_EQ(array[0].theDouble(), count);
+        NTSCFG_TEST_EQ(array[1].theDouble(), total);
+        NTSCFG_TEST_EQ(array[2].theDouble(), minimum);
+        NTSCFG_TEST_EQ(array[3].theDouble(), total / count);
+        NTSCFG_TEST_EQ(array[4].theDouble(), maximum);
+    }
+}
+
 NTSCFG_TEST_FUNCTION(ntcs::MetricsTest::verify)
 {
 }
 
+NTSCFG_TEST_FUNCTION(ntcs::MetricsTest::verifyLazy)
+{
+    bsl::shared_ptr<ntcs::Metrics> parent;
+    parent.createInplace(NTSCFG_TEST_ALLOCATOR,
+                         "transport",
+                         "test",
+                         NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcs::Metrics> metrics;
+    metrics.createInplace(NTSCFG_TEST_ALLOCATOR,
+                          "socket",
+                          parent,
+                          NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_TRUE(parent->isMaterialized());
+    NTSCFG_TEST_FALSE(metrics->isMaterialized());
+
+    metrics->logSendCompletion(100, 50);
+    metrics->logSendCompletion(300, 150);
+    metrics->logSendCompletion(200, 100);
+
+    NTSCFG_TEST_FALSE(metrics->isMaterialized());
+
+    MetricsTest::verifyBytesSendable(metrics.get(), 3, 600, 100, 300);
+
+    NTSCFG_TEST_TRUE(metrics->isMaterialized());
+
+    MetricsTest::verifyBytesSendable(metrics.get(), 0, 0, 0, 0);
+
+    metrics->logSendCompletion(400, 200);
+
+    MetricsTest::verifyBytesSendable(metrics.get(), 1, 400, 400, 400);
+
+    MetricsTest::verifyBytesSendable(parent.get(), 4, 1000, 100, 400);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::MetricsTest::verifyMaterialize)
+{
+    bsl::shared_ptr<ntcs::Metrics> metrics;
+    metrics.createInplace(NTSCFG_TEST_ALLOCATOR,
+                          "socket",
+                          bsl::shared_ptr<ntcs::Metrics>(),
+                          NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_FALSE(metrics->isMaterialized());
+
+    metrics->logSendCompletion(100, 50);
+
+    metrics->materialize();
+    NTSCFG_TEST_TRUE(metrics->isMaterialized());
+
+    metrics->logSendCompletion(300, 150);
+
+    MetricsTest::verifyBytesSendable(metrics.get(), 2, 400, 100, 300);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::MetricsTest::verifyLazyNomenclature)
+{
+    bsl::shared_ptr<ntcs::Metrics> parent;
+    parent.createInplace(NTSCFG_TEST_ALLOCATOR,
+                         "transport",
+                         "test",
+                         NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcs::Metrics> metrics;
+    metrics.createInplace(NTSCFG_TEST_ALLOCATOR,
+                          "socket",
+                          parent,
+                          NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_EQ(bsl::string(metrics->getFieldPrefix(0)),
+                   bsl::string("transport.socket"));
+
+    const bsl::string objectName = metrics->objectName();
+
+    NTSCFG_TEST_TRUE(objectName.find("test-socket-") == 0);
+    NTSCFG_TEST_GT(objectName.size(), bsl::strlen("test-socket-"));
+
+    NTSCFG_TEST_EQ(bsl::string(metrics->objectName()), objectName);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::MetricsTest::verifySharding)
+{
+    const bsl::size_t k_NUM_THREADS = 4;
+    const bsl::size_t k_NUM_SENDS   = 10000;
+
+    bsl::shared_ptr<ntcs::Metrics> metrics;
+    metrics.createInplace(NTSCFG_TEST_ALLOCATOR,
+                          "transport",
+                          "test",
+                          NTSCFG_TEST_ALLOCATOR);
+
+    bslmt::ThreadGroup threadGroup(NTSCFG_TEST_ALLOCATOR);
+    threadGroup.addThreads(bdlf::BindUtil::bind(&MetricsTest::logSends,
+                                                metrics.get(),
+                                                k_NUM_SENDS),
+                           static_cast<int>(k_NUM_THREADS));
+    threadGroup.joinAll();
+
+    const double count = static_cast<double>(k_NUM_THREADS * k_NUM_SENDS);
+
+    MetricsTest::verifyBytesSendable(metrics.get(),
+                                     count,
+                                     count * 100,
+                                     100,
+                                     100);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::MetricsTest::verifyPercentiles)
+{
+    bsl::shared_ptr<ntcs::Metrics> parent;
+    parent.createInplace(NTSCFG_TEST_ALLOCATOR,
+                         "transport",
+                         "test",
+                         NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcs::Metrics> metrics;
+    metrics.createInplace(NTSCFG_TEST_ALLOCATOR,
+                          "socket",
+                          parent,
+                          NTSCFG_TEST_ALLOCATOR);
+
+    for (bsl::size_t i = 1; i <= 100; ++i) {
+        metrics->logTxDelay(
+            bsls::TimeInterval(0, static_cast<int>(i * 1000)));
+    }
+
+    // Find the ordinal of the median transmit delay.
+
+    int ordinal = -1;
+    for (int i = 0; i < parent->numOrdinals(); ++i) {
+        if (bsl::strcmp(parent->getFieldName(i), "txDelay.p50") == 0) {
+            ordinal = i;
+        }
+    }
+
+    NTSCFG_TEST_GT(ordinal, 0);
+    NTSCFG_TEST_EQ(parent->getFieldType(ordinal),
+                   ntci::Monitorable::e_PERCENTILE);
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        parent->getStats(&stats);
+
+        const bdld::DatumArrayRef array = stats.datum().theArray();
+
+        NTSCFG_TEST_TRUE(array[ordinal].isDouble());
+
+        const double p50 = array[ordinal].theDouble();
+        NTSCFG_TEST_GT(p50, 50 * 0.9);
+        NTSCFG_TEST_LE(p50, 50 * 1.1);
+
+        const double p99 = array[ordinal + 2].theDouble();
+        NTSCFG_TEST_GT(p99, 99 * 0.9);
+        NTSCFG_TEST_LE(p99, 99 * 1.1);
+    }
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        metrics->getStats(&stats);
+
+        const bdld::DatumArrayRef array = stats.datum().theArray();
+
+        NTSCFG_TEST_TRUE(array[ordinal].isNull());
+    }
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::MetricsTest::verifyTcpInfo)
+{
+    bsl::shared_ptr<ntcs::Metrics> parent;
+    parent.createInplace(NTSCFG_TEST_ALLOCATOR,
+                         "transport",
+                         "test",
+                         NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcs::Metrics> metrics1;
+    metrics1.createInplace(NTSCFG_TEST_ALLOCATOR,
+                           "socket",
+                           parent,
+                           NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcs::Metrics> metrics2;
+    metrics2.createInplace(NTSCFG_TEST_ALLOCATOR,
+                           "socket",
+                           parent,
+                           NTSCFG_TEST_ALLOCATOR);
+
+    ntsa::TcpInfo tcpInfo1;
+    tcpInfo1.setRoundTripTime(bsls::TimeInterval(0, 100 * 1000));
+    tcpInfo1.setCongestionWindow(10);
+    tcpInfo1.setDeliveryRate(1000);
+
+    ntsa::TcpInfo tcpInfo2;
+    tcpInfo2.setRoundTripTime(bsls::TimeInterval(0, 300 * 1000));
+    tcpInfo2.setCongestionWindow(30);
+
+    metrics1->logTcpInfo(tcpInfo1);
+    metrics1->logTcpRetransmissions(2);
+
+    metrics2->logTcpInfo(tcpInfo2);
+    metrics2->logTcpRetransmissions(3);
+
+    int rtt = -1;
+    int cwnd = -1;
+    int retransmissions = -1;
+    int deliveryRate = -1;
+    for (int i = 0; i < parent->numOrdinals(); ++i) {
+        const char* name = parent->getFieldName(i);
+        if (bsl::strcmp(name, "tcpRoundTripTime.count") == 0) {
+            rtt = i;
+        }
+        else if (bsl::strcmp(name, "tcpCongestionWindow.count") == 0) {
+            cwnd = i;
+        }
+        else if (bsl::strcmp(name, "tcpRetransmissions.count") == 0) {
+            retransmissions = i;
+        }
+        else if (bsl::strcmp(name, "tcpDeliveryRate.count") == 0) {
+            deliveryRate = i;
+        }
+    }
+
+    NTSCFG_TEST_GT(rtt, 0);
+    NTSCFG_TEST_GT(cwnd, 0);
+    NTSCFG_TEST_GT(retransmissions, 0);
+    NTSCFG_TEST_GT(deliveryRate, 0);
+
+    bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+    parent->getStats(&stats);
+
+    const bdld::DatumArrayRef array = stats.datum().theArray();
+
+    // Each summary is published as its count, total, minimum, average, and
+    // maximum.
+
+    NTSCFG_TEST_EQ(array[rtt].theDouble(), 2);
+    NTSCFG_TEST_EQ(array[rtt + 2].theDouble(), 100);
+    NTSCFG_TEST_EQ(array[rtt + 4].theDouble(), 300);
+
+    NTSCFG_TEST_EQ(array[cwnd + 2].theDouble(), 10);
+    NTSCFG_TEST_EQ(array[cwnd + 3].theDouble(), 20);
+    NTSCFG_TEST_EQ(array[cwnd + 4].theDouble(), 30);
+
+    NTSCFG_TEST_EQ(array[retransmissions + 1].theDouble(), 5);
+
+    NTSCFG_TEST_EQ(array[deliveryRate].theDouble(), 1);
+}
+
 }  // close namespace ntcs
 }  // close namespace BloombergLP
@@ -239,6 +239,9 @@ const char* MonitorableLog::describeStatisticType(
     case ntci::Monitorable::e_AVERAGE:
         return "AVERAGE";
         break;
+    case ntci::Monitorable::e_PERCENTILE:
+        return "PERCENTILE";
+        break;
     }
 
     return "UNKNOWN";
@@ -0,0 +1,600 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcs_openmetrics.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_openmetrics_cpp, "$Id$ $CSID$")
+
+#include <bdlb_string.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bsl_cmath.h>
+#include <bsl_cstdio.h>
+#include <bsl_cstring.h>
+#include <bsl_unordered_set.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+namespace {
+
+/// The suffix of the name of the count of measurements of a distribution.
+const char k_COUNT_SUFFIX[] = ".count";
+
+/// The suffix of the name of the sum of measurements of a distribution.
+const char k_TOTAL_SUFFIX[] = ".total";
+
+/// Return true if the specified 'name' ends with the specified 'suffix',
+/// otherwise return false. Load into the specified 'stem' the characters of
+/// 'name' preceding the 'suffix'.
+bool splitSuffix(bsl::string* stem, const char* name, const char* suffix)
+{
+    const bsl::size_t nameLength   = bsl::strlen(name);
+    const bsl::size_t suffixLength = bsl::strlen(suffix);
+
+    if (nameLength <= suffixLength) {
+        return false;
+    }
+
+    if (0 != bsl::memcmp(name + nameLength - suffixLength,
+                         suffix,
+                         suffixLength))
+    {
+        return false;
+    }
+
+    stem->assign(name, nameLength - suffixLength);
+    return true;
+}
+
+/// Return true if the specified 'name' has the form "<stem>.p<digits>",
+/// otherwise return false. Load into the specified 'stem' the characters of
+/// 'name' preceding the percentile and load into the specified 'quantile'
+/// the percentile expressed as a fraction, e.g. "0.99" for "p99".
+bool splitPercentile(bsl::string* stem,
+                     bsl::string* quantile,
+                     const char*  name)
+{
+    const char* dot = bsl::strrchr(name, '.');
+    if (dot == 0 || dot == name || dot[1] != 'p' || dot[2] == 0) {
+        return false;
+    }
+
+    const char* digits    = dot + 2;
+    const char* digitsEnd = digits;
+    while (*digitsEnd >= '0' && *digitsEnd <= '9') {
+        ++digitsEnd;
+    }
+
+    if (*digitsEnd != 0) {
+        return false;
+    }
+
+    // Trailing zeros are not significant: "p50" is the quantile "0.5".
+
+    while (digitsEnd > digits + 1 && digitsEnd[-1] == '0') {
+        --digitsEnd;
+    }
+
+    stem->assign(name, dot);
+
+    quantile->assign("0.");
+    quantile->append(digits, digitsEnd);
+
+    return true;
+}
+
+}  // close unnamed namespace
+
+void OpenMetricsPublisher::initialize(Entry*                   entry,
+                                      const ntci::Monitorable& monitorable)
+{
+    const int numOrdinals = monitorable.numOrdinals();
+
+    // Determine the measurements whose distribution is described by
+    // percentiles, so that the count and total of those measurements are
+    // described as the count and sum of the same summary.
+
+    bsl::unordered_set<bsl::string> summaries(d_allocator_p);
+
+    bsl::string stem(d_allocator_p);
+    bsl::string quantile(d_allocator_p);
+
+    for (int ordinal = 0; ordinal < numOrdinals; ++ordinal) {
+        const char* fieldName = monitorable.getFieldName(ordinal);
+        if (fieldName == 0) {
+            continue;
+        }
+
+        if (monitorable.getFieldType(ordinal) ==
+            ntci::Monitorable::e_PERCENTILE)
+        {
+            const char* fieldPrefix = monitorable.getFieldPrefix(ordinal);
+
+            if (splitPercentile(&stem, &quantile, fieldName)) {
+                bsl::string key(fieldPrefix ? fieldPrefix : "",
+                                d_allocator_p);
+                key.push_back('.');
+                key.append(stem);
+                summaries.insert(key);
+            }
+        }
+    }
+
+    // Format the labels common to each sample of the object.
+
+    bsl::string labels(d_allocator_p);
+    {
+        const char* objectName = monitorable.objectName();
+        if (objectName != 0 && objectName[0] != 0) {
+            labels.append("object=\"");
+            formatEscaped(&labels, objectName);
+            labels.append("\",");
+        }
+
+        char buffer[16];
+        bsl::snprintf(buffer,
+                      sizeof buffer,
+                      "%d",
+                      monitorable.objectId().value());
+
+        labels.append("id=\"");
+        labels.append(buffer);
+        labels.push_back('"');
+    }
+
+    entry->d_series.resize(numOrdinals);
+
+    for (int ordinal = 0; ordinal < numOrdinals; ++ordinal) {
+        Series& series = entry->d_series[ordinal];
+
+        series.d_prefixLength = 0;
+        series.d_family       = 0;
+        series.d_total        = 0.0;
+        series.d_type         = e_SERIES_NONE;
+        series.d_valid        = false;
+
+        const char* fieldName = monitorable.getFieldName(ordinal);
+        if (fieldName == 0) {
+            continue;
+        }
+
+        const char* fieldPrefix = monitorable.getFieldPrefix(ordinal);
+        if (fieldPrefix == 0) {
+            fieldPrefix = "";
+        }
+
+        const char* fieldDescription =
+            monitorable.getFieldDescription(ordinal);
+
+        const ntci::Monitorable::StatisticType fieldType =
+            monitorable.getFieldType(ordinal);
+
+        bsl::string familyName(d_allocator_p);
+        familyName.append(d_namespace);
+        if (fieldPrefix[0] != 0) {
+            familyName.push_back('_');
+            formatName(&familyName, fieldPrefix);
+        }
+        familyName.push_back('_');
+
+        const char* sampleSuffix   = "";
+        const char* quantileSuffix = 0;
+
+        if (fieldType == ntci::Monitorable::e_PERCENTILE &&
+            splitPercentile(&stem, &quantile, fieldName))
+        {
+            formatName(&familyName, stem.c_str());
+            series.d_family =
+                this->lookupFamily(familyName, e_SUMMARY, fieldDescription);
+            series.d_type  = e_SERIES_QUANTILE;
+            quantileSuffix = quantile.c_str();
+        }
+        else if (fieldType == ntci::Monitorable::e_SUM) {
+            bsl::string key(fieldPrefix, d_allocator_p);
+            key.push_back('.');
+
+            if (splitSuffix(&stem, fieldName, k_COUNT_SUFFIX) &&
+                summaries.count(key + stem) != 0)
+            {
+                formatName(&familyName, stem.c_str());
+                series.d_family =
+                    this->lookupFamily(familyName, e_SUMMARY, 0);
+                series.d_type = e_SERIES_SUMMARY_COUNT;
+                sampleSuffix  = "_count";
+            }
+            else if (splitSuffix(&stem, fieldName, k_TOTAL_SUFFIX) &&
+                     summaries.count(key + stem) != 0)
+            {
+                formatName(&familyName, stem.c_str());
+                series.d_family =
+                    this->lookupFamily(familyName, e_SUMMARY, 0);
+                series.d_type = e_SERIES_SUMMARY_SUM;
+                sampleSuffix  = "_sum";
+            }
+            else {
+                formatName(&familyName, fieldName);
+                series.d_family = this->lookupFamily(familyName,
+                                                     e_COUNTER,
+                                                     fieldDescription);
+                series.d_type   = e_SERIES_COUNTER;
+                sampleSuffix    = "_total";
+            }
+        }
+        else {
+            formatName(&familyName, fieldName);
+            series.d_family =
+                this->lookupFamily(familyName, e_GAUGE, fieldDescription);
+            series.d_type = e_SERIES_GAUGE;
+        }
+
+        series.d_line.assign(familyName);
+        series.d_line.append(sampleSuffix);
+        series.d_line.push_back('{');
+        series.d_line.append(labels);
+        if (quantileSuffix != 0) {
+            series.d_line.append(",quantile=\"");
+            series.d_line.append(quantileSuffix);
+            series.d_line.push_back('"');
+        }
+        series.d_line.append("} ");
+
+        series.d_prefixLength = series.d_line.size();
+    }
+}
+
+bsl::size_t OpenMetricsPublisher::lookupFamily(const bsl::string& name,
+                                               FamilyType         type,
+                                               const char* description)
+{
+    FamilyIndex::iterator it = d_familyIndex.find(name);
+    if (it != d_familyIndex.end()) {
+        Family& family = d_families[it->second];
+
+        // The count and sum of a summary carry no description of their own,
+        // so the description of the summary is that of its first quantile.
+
+        if (description != 0 && description[0] != 0 &&
+            family.d_type == e_SUMMARY &&
+            family.d_header.find("# HELP ") == bsl::string::npos)
+        {
+            family.d_header.append("# HELP ");
+            family.d_header.append(name);
+            family.d_header.push_back(' ');
+            formatEscaped(&family.d_header, description);
+            family.d_header.push_back('\n');
+        }
+
+        return it->second;
+    }
+
+    const bsl::size_t index = d_families.size();
+
+    d_families.resize(index + 1);
+    d_familyText.resize(index + 1);
+
+    Family& family = d_families.back();
+    family.d_type  = type;
+
+    family.d_header.append("# TYPE ");
+    family.d_header.append(name);
+    if (type == e_COUNTER) {
+        family.d_header.append(" counter\n");
+    }
+    else if (type == e_SUMMARY) {
+        family.d_header.append(" summary\n");
+    }
+    else {
+        family.d_header.append(" gauge\n");
+    }
+
+    if (description != 0 && description[0] != 0) {
+        family.d_header.append("# HELP ");
+        family.d_header.append(name);
+        family.d_header.push_back(' ');
+        formatEscaped(&family.d_header, description);
+        family.d_header.push_back('\n');
+    }
+
+    d_familyIndex.insert(FamilyIndex::value_type(name, index));
+
+    return index;
+}
+
+void OpenMetricsPublisher::assemble()
+{
+    // Gather the sample lines of each family. The text of each family
+    // retains its capacity from one sample to the next.
+
+    for (bsl::size_t i = 0; i < d_familyText.size(); ++i) {
+        d_familyText[i].clear();
+    }
+
+    for (EntryMap::const_iterator it = d_entries.begin();
+         it != d_entries.end();
+         ++it)
+    {
+        const Entry& entry = it->second;
+
+        for (bsl::size_t i = 0; i < entry.d_series.size(); ++i) {
+            const Series& series = entry.d_series[i];
+            if (series.d_valid) {
+                d_familyText[series.d_family].append(series.d_line);
+            }
+        }
+    }
+
+    bsl::size_t size = 0;
+    for (bsl::size_t i = 0; i < d_familyText.size(); ++i) {
+        if (!d_familyText[i].empty()) {
+            size += d_families[i].d_header.size() + d_familyText[i].size();
+        }
+    }
+
+    const char k_EOF[] = "# EOF\n";
+
+    bsl::shared_ptr<bsl::string> snapshot;
+    snapshot.createInplace(d_allocator_p, d_allocator_p);
+
+    snapshot->reserve(size + sizeof k_EOF);
+
+    for (bsl::size_t i = 0; i < d_familyText.size(); ++i) {
+        if (!d_familyText[i].empty()) {
+            snapshot->append(d_families[i].d_header);
+            snapshot->append(d_familyText[i]);
+        }
+    }
+
+    snapshot->append(k_EOF);
+
+    bsl::shared_ptr<const bsl::string> result = snapshot;
+
+    {
+        bsls::SpinLockGuard guard(&d_snapshotLock);
+        d_snapshot_sp.swap(result);
+    }
+}
+
+void OpenMetricsPublisher::formatValue(bsl::string* result, double value)
+{
+    if (value != value) {
+        result->append("NaN");
+        return;
+    }
+
+    if (bsl::fabs(value) < 9007199254740992.0 &&
+        value == static_cast<double>(static_cast<bsls::Types::Int64>(value)))
+    {
+        // Format integral values, the common case, without the overhead of
+        // a general-purpose floating point conversion.
+
+        bsls::Types::Int64  integer   = static_cast<bsls::Types::Int64>(value);
+        bsls::Types::Uint64 magnitude = integer < 0 ? -integer : integer;
+
+        char  buffer[24];
+        char* end     = buffer + sizeof buffer;
+        char* current = end;
+
+        do {
+            *--current = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+
+        if (integer < 0) {
+            *--current = '-';
+        }
+
+        result->append(current, end);
+        return;
+    }
+
+    if (bsl::fabs(value) > 1.7976931348623157e308) {
+        result->append(value > 0 ? "+Inf" : "-Inf");
+        return;
+    }
+
+    char buffer[32];
+    int  length = bsl::snprintf(buffer, sizeof buffer, "%.15g", value);
+    if (length > 0) {
+        result->append(buffer, static_cast<bsl::size_t>(length));
+    }
+}
+
+void OpenMetricsPublisher::formatName(bsl::string* result, const char* text)
+{
+    for (const char* current = text; *current != 0; ++current) {
+        const char ch = *current;
+        if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+            (ch >= '0' && ch <= '9') || ch == '_' || ch == ':')
+        {
+            result->push_back(ch);
+        }
+        else {
+            result->push_back('_');
+        }
+    }
+}
+
+void OpenMetricsPublisher::formatEscaped(bsl::string* result,
+                                         const char*  text)
+{
+    for (const char* current = text; *current != 0; ++current) {
+        const char ch = *current;
+        if (ch == '\\') {
+            result->append("\\\\");
+        }
+        else if (ch == '"') {
+            result->append("\\\"");
+        }
+        else if (ch == '\n') {
+            result->append("\\n");
+        }
+        else {
+            result->push_back(ch);
+        }
+    }
+}
+
+OpenMetricsPublisher::OpenMetricsPublisher(bslma::Allocator* basicAllocator)
+: d_mutex()
+, d_namespace("ntc", basicAllocator)
+, d_families(basicAllocator)
+, d_familyIndex(basicAllocator)
+, d_entries(basicAllocator)
+, d_familyText(basicAllocator)
+, d_generation(1)
+, d_snapshotLock(bsls::SpinLock::s_unlocked)
+, d_snapshot_sp()
+, d_numPublications(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    this->assemble();
+}
+
+OpenMetricsPublisher::OpenMetricsPublisher(
+    const bsl::string& metricNamespace,
+    bslma::Allocator*  basicAllocator)
+: d_mutex()
+, d_namespace(basicAllocator)
+, d_families(basicAllocator)
+, d_familyIndex(basicAllocator)
+, d_entries(basicAllocator)
+, d_familyText(basicAllocator)
+, d_generation(1)
+, d_snapshotLock(bsls::SpinLock::s_unlocked)
+, d_snapshot_sp()
+, d_numPublications(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    formatName(&d_namespace, metricNamespace.c_str());
+    this->assemble();
+}
+
+OpenMetricsPublisher::~OpenMetricsPublisher()
+{
+}
+
+void OpenMetricsPublisher::publish(
+    const bsl::shared_ptr<ntci::Monitorable>& monitorable,
+    const bdld::Datum&                        statistics,
+    const bsls::TimeInterval&                 time,
+    bool                                      final)
+{
+    NTCCFG_WARNING_UNUSED(time);
+
+    ++d_numPublications;
+
+    LockGuard guard(&d_mutex);
+
+    if (statistics.isArray()) {
+        Entry& entry = d_entries[monitorable->objectId().value()];
+
+        if (entry.d_generation == 0) {
+            this->initialize(&entry, *monitorable);
+        }
+
+        entry.d_generation = d_generation;
+
+        const bdld::DatumArrayRef array = statistics.theArray();
+
+        bsl::size_t numSeries = entry.d_series.size();
+        if (numSeries > array.length()) {
+            numSeries = array.length();
+        }
+
+        for (bsl::size_t ordinal = 0; ordinal < numSeries; ++ordinal) {
+            Series& series = entry.d_series[ordinal];
+            if (series.d_type == e_SERIES_NONE) {
+                continue;
+            }
+
+            // Determine the value of this statistic. A null value
+            // represents a statistic with no measurement during this
+            // interval: a gauge or quantile is omitted, but a sum
+            // contributes nothing to its total.
+
+            const bdld::Datum& datum = array.data()[ordinal];
+
+            double value = 0.0;
+            if (datum.isDouble()) {
+                value = datum.theDouble();
+            }
+            else if (datum.isInteger64()) {
+                value = static_cast<double>(datum.theInteger64());
+            }
+            else if (datum.isInteger()) {
+                value = static_cast<double>(datum.theInteger());
+            }
+            else if (series.d_type == e_SERIES_GAUGE ||
+                     series.d_type == e_SERIES_QUANTILE)
+            {
+                series.d_valid = false;
+                continue;
+            }
+
+            if (series.d_type == e_SERIES_COUNTER ||
+                series.d_type == e_SERIES_SUMMARY_COUNT ||
+                series.d_type == e_SERIES_SUMMARY_SUM)
+            {
+                series.d_total += value;
+                value           = series.d_total;
+            }
+
+            series.d_line.resize(series.d_prefixLength);
+            formatValue(&series.d_line, value);
+            series.d_line.push_back('\n');
+            series.d_valid = true;
+        }
+    }
+
+    if (final) {
+        // Forget the objects not published during this sample, which
+        // have been deregistered since the previous sample.
+
+        EntryMap::iterator it = d_entries.begin();
+        while (it != d_entries.end()) {
+            if (it->second.d_generation != d_generation) {
+                it = d_entries.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        this->assemble();
+
+        ++d_generation;
+    }
+}
+
+bsl::shared_ptr<const bsl::string> OpenMetricsPublisher::snapshot() const
+{
+    bsls::SpinLockGuard guard(&d_snapshotLock);
+    return d_snapshot_sp;
+}
+
+bsls::Types::Uint64 OpenMetricsPublisher::numPublications() const
+{
+    return d_numPublications.load();
+}
+
+const char* OpenMetricsPublisher::contentType()
+{
+    return "application/openmetrics-text; version=1.0.0; charset=utf-8";
+}
+
+}  // close package namespace
+}  // close enterprise namespace
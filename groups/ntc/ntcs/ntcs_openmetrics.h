@@ -0,0 +1,248 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCS_OPENMETRICS
+#define INCLUDED_NTCS_OPENMETRICS
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntccfg_platform.h>
+#include <ntci_monitorable.h>
+#include <ntcscm_version.h>
+#include <bdld_datum.h>
+#include <bsls_atomic.h>
+#include <bsls_keyword.h>
+#include <bsls_spinlock.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+#include <bsl_map.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_unordered_map.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+/// @internal @brief
+/// Provide a publisher of statistics in the OpenMetrics text format.
+///
+/// @details
+/// This class implements the 'ntci::MonitorablePublisher' interface to
+/// maintain a snapshot of the statistics of every monitorable object in the
+/// OpenMetrics text exposition format, suitable to be scraped by Prometheus
+/// or any other OpenMetrics-compatible collector.
+///
+/// The first time a monitorable object is published, the name of the metric
+/// family, the labels, and the type of each of its statistics are resolved
+/// and formatted once into the prefix of a sample line. Each subsequent
+/// publication of that object only formats the values of its statistics
+/// after those prefixes, reusing their memory. When the final statistics of
+/// a sample are published, objects not published during that sample are
+/// forgotten and the sample lines are assembled by family into an immutable
+/// snapshot, so that 'snapshot' returns the most recently assembled text
+/// without formatting anything.
+///
+/// The name of each metric family is formed from the namespace of this
+/// publisher, the field prefix, and the field name, with each character not
+/// permitted in a metric name replaced by an underscore. Each sample is
+/// labeled by the identifier of the monitorable object and, if assigned,
+/// its name. Statistics are mapped to the OpenMetrics types as follows:
+///
+/// @li @b e_SUM:
+/// Counter. Since monitorable objects report the sum over the interval since
+/// the previous collection, the publisher accumulates each interval into a
+/// monotonically increasing total.
+///
+/// @li @b e_PERCENTILE:
+/// Summary, with the percentile as the 'quantile' label. The '.count' and
+/// '.total' statistics of the same measurement, if any, are accumulated
+/// into the '_count' and '_sum' of the summary.
+///
+/// @li @b e_GAUGE, e_MINIMUM, e_MAXIMUM, e_AVERAGE:
+/// Gauge. A statistic having no value during the most recent interval is
+/// omitted from the snapshot.
+///
+/// @par Thread Safety
+/// This class is thread safe.
+///
+/// @ingroup module_ntcs
+class OpenMetricsPublisher : public ntci::MonitorablePublisher
+{
+    /// Enumerate the OpenMetrics types of metric families.
+    enum FamilyType { e_GAUGE, e_COUNTER, e_SUMMARY };
+
+    /// Enumerate the kinds of samples.
+    enum SeriesType {
+        e_SERIES_NONE,
+        e_SERIES_GAUGE,
+        e_SERIES_COUNTER,
+        e_SERIES_QUANTILE,
+        e_SERIES_SUMMARY_COUNT,
+        e_SERIES_SUMMARY_SUM
+    };
+
+    /// Describe a metric family.
+    struct Family {
+        /// The text describing the family: its type and help.
+        bsl::string d_header;
+
+        /// The type of the family.
+        FamilyType d_type;
+    };
+
+    /// Describe a sample of a statistic of a monitorable object.
+    struct Series {
+        /// The sample line: the name and labels formatted once followed by
+        /// the most recently formatted value.
+        bsl::string d_line;
+
+        /// The length of the name and labels at the start of the line.
+        bsl::size_t d_prefixLength;
+
+        /// The index of the family of the sample.
+        bsl::size_t d_family;
+
+        /// The accumulated value of counters.
+        double d_total;
+
+        /// The kind of sample.
+        SeriesType d_type;
+
+        /// The flag indicating the line contains a value.
+        bool d_valid;
+    };
+
+    /// Describe the samples of a monitorable object.
+    struct Entry {
+        /// The samples, indexed by the ordinal of each statistic.
+        bsl::vector<Series> d_series;
+
+        /// The sample during which the object was last published, or zero if
+        /// the samples of the object have not yet been resolved.
+        bsls::Types::Uint64 d_generation;
+
+        /// Create a new entry having no samples.
+        Entry()
+        : d_series()
+        , d_generation(0)
+        {
+        }
+    };
+
+    /// Define a type alias for a vector of families.
+    typedef bsl::vector<Family> FamilyVector;
+
+    /// Define a type alias for a map of family names to family indexes.
+    typedef bsl::unordered_map<bsl::string, bsl::size_t> FamilyIndex;
+
+    /// Define a type alias for a map of object identifiers to entries,
+    /// ordered so that the samples of each family are assembled in the order
+    /// the objects were created.
+    typedef bsl::map<int, Entry> EntryMap;
+
+    /// Define a type alias for a mutex.
+    typedef ntccfg::Mutex Mutex;
+
+    /// Define a type alias for a mutex lock guard.
+    typedef ntccfg::LockGuard LockGuard;
+
+    Mutex                              d_mutex;
+    bsl::string                        d_namespace;
+    FamilyVector                       d_families;
+    FamilyIndex                        d_familyIndex;
+    EntryMap                           d_entries;
+    bsl::vector<bsl::string>           d_familyText;
+    bsls::Types::Uint64                d_generation;
+    mutable bsls::SpinLock             d_snapshotLock;
+    bsl::shared_ptr<const bsl::string> d_snapshot_sp;
+    bsls::AtomicUint64                 d_numPublications;
+    bslma::Allocator*                  d_allocator_p;
+
+  private:
+    OpenMetricsPublisher(const OpenMetricsPublisher&) BSLS_KEYWORD_DELETED;
+    OpenMetricsPublisher& operator=(const OpenMetricsPublisher&)
+        BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Resolve the samples of the statistics of the specified
+    /// 'monitorable' object into the specified 'entry'.
+    void initialize(Entry* entry, const ntci::Monitorable& monitorable);
+
+    /// Return the index of the family having the specified 'name', creating
+    /// it having the specified 'type' and 'description' if necessary.
+    bsl::size_t lookupFamily(const bsl::string& name,
+                             FamilyType         type,
+                             const char*        description);
+
+    /// Assemble the sample lines of each entry into a new snapshot.
+    void assemble();
+
+    /// Append to the specified 'result' the specified 'value' formatted in
+    /// the OpenMetrics text format.
+    static void formatValue(bsl::string* result, double value);
+
+    /// Append to the specified 'result' the specified 'text' with each
+    /// character not permitted in a metric name replaced by an underscore.
+    static void formatName(bsl::string* result, const char* text);
+
+    /// Append to the specified 'result' the specified 'text' escaped as an
+    /// OpenMetrics label value or help text.
+    static void formatEscaped(bsl::string* result, const char* text);
+
+  public:
+    /// Create a new OpenMetrics publisher whose metric family names begin
+    /// with "ntc". Optionally specify a 'basicAllocator' used to supply
+    /// memory. If 'basicAllocator' is 0, the currently installed default
+    /// allocator is used.
+    explicit OpenMetricsPublisher(bslma::Allocator* basicAllocator = 0);
+
+    /// Create a new OpenMetrics publisher whose metric family names begin
+    /// with the specified 'metricNamespace'. Optionally specify a
+    /// 'basicAllocator' used to supply memory. If 'basicAllocator' is 0,
+    /// the currently installed default allocator is used.
+    explicit OpenMetricsPublisher(const bsl::string& metricNamespace,
+                                  bslma::Allocator*  basicAllocator = 0);
+
+    /// Destroy this object.
+    ~OpenMetricsPublisher() BSLS_KEYWORD_OVERRIDE;
+
+    /// Publish the specified 'statistics' collected from the specified
+    /// 'monitorable' object at the specified 'time'. If the specified
+    /// 'final' flag is true, these 'statistics' are the final statistics
+    /// collected during the same sample at the 'time'.
+    void publish(const bsl::shared_ptr<ntci::Monitorable>& monitorable,
+                 const bdld::Datum&                        statistics,
+                 const bsls::TimeInterval&                 time,
+                 bool final) BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the most recently assembled snapshot of the statistics of
+    /// every monitorable object in the OpenMetrics text format. The
+    /// snapshot is empty of samples until the final statistics of the first
+    /// sample have been published.
+    bsl::shared_ptr<const bsl::string> snapshot() const;
+
+    /// Return the number of publications.
+    bsls::Types::Uint64 numPublications() const;
+
+    /// Return the content type of the OpenMetrics text format, suitable
+    /// for an HTTP 'Content-Type' header.
+    static const char* contentType();
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
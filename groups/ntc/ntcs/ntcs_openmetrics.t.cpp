@@ -0,0 +1,396 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_openmetrics_t_cpp, "$Id$ $CSID$")
+
+#include <ntcs_openmetrics.h>
+
+#include <bdld_datum.h>
+#include <bdld_manageddatum.h>
+#include <bsl_cstring.h>
+#include <bsl_sstream.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcs {
+
+// Provide tests for 'ntcs::OpenMetricsPublisher'.
+class OpenMetricsTest
+{
+    /// This class implements the 'ntci::Monitorable' interface for use by
+    /// this test driver, reporting the statistics assigned by the test.
+    class Object;
+
+    /// Publish the current statistics of the specified 'object' to the
+    /// specified 'publisher' as the final statistics of a sample if the
+    /// specified 'final' flag is true.
+    static void publish(ntcs::OpenMetricsPublisher*    publisher,
+                        const bsl::shared_ptr<Object>& object,
+                        bool                           final);
+
+    /// Return the labels of the samples of the specified 'object'.
+    static bsl::string labels(const bsl::shared_ptr<Object>& object);
+
+  public:
+    // Concern: The snapshot is empty until the first sample is final.
+    static void verifyEmpty();
+
+    // Concern: Statistics are formatted by family in the OpenMetrics text
+    // format, sums are accumulated into counters and percentiles are
+    // described as summary quantiles.
+    static void verifyFormat();
+
+    // Concern: Objects not published during a sample are removed from the
+    // snapshot.
+    static void verifyEviction();
+};
+
+class OpenMetricsTest::Object : public ntci::Monitorable
+{
+    bsl::string         d_name;
+    bsl::vector<double> d_values;
+    bsl::vector<bool>   d_defined;
+
+    static struct StatisticMetadata {
+        const char*                      prefix;
+        const char*                      name;
+        const char*                      description;
+        ntci::Monitorable::StatisticType type;
+    } STATISTICS[];
+
+  private:
+    Object(const Object&) BSLS_KEYWORD_DELETED;
+    Object& operator=(const Object&) BSLS_KEYWORD_DELETED;
+
+  public:
+    enum StatisticOrdinal {
+        STATISTIC_CALLS         = 0,
+        STATISTIC_LATENCY_COUNT = 1,
+        STATISTIC_LATENCY_TOTAL = 2,
+        STATISTIC_LATENCY_P50   = 3,
+        STATISTIC_LATENCY_P99   = 4,
+        STATISTIC_DEPTH         = 5,
+        NUM_STATISTICS          = 6
+    };
+
+    /// Create a new object having the specified 'name' whose statistics
+    /// are initially undefined.
+    explicit Object(const bsl::string& name);
+
+    /// Destroy this object.
+    ~Object() BSLS_KEYWORD_OVERRIDE;
+
+    /// Set the statistic at the specified 'ordinal' to the specified
+    /// 'value'.
+    void setValue(int ordinal, double value);
+
+    /// Set the statistic at the specified 'ordinal' to have no value.
+    void resetValue(int ordinal);
+
+    /// Load into the specified 'result' the array of statistics.
+    void getStats(bdld::ManagedDatum* result) BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the prefix corresponding to the field at the specified
+    /// 'ordinal' position, or 0 if no field at the 'ordinal' position
+    /// exists.
+    const char* getFieldPrefix(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the field name corresponding to the field at the specified
+    /// 'ordinal' position, or 0 if no field at the 'ordinal' position
+    /// exists.
+    const char* getFieldName(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the field description corresponding to the field at the
+    /// specified 'ordinal' position, or 0 if no field at the 'ordinal'
+    /// position exists.
+    const char* getFieldDescription(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the type of the statistic at the specified 'ordinal'
+    /// position, or e_AVERAGE if no field at the 'ordinal' position exists
+    /// or the type is unknown.
+    StatisticType getFieldType(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the flags that indicate which indexes to apply to the
+    /// statistics measured by this monitorable object.
+    int getFieldTags(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the ordinal of the specified 'fieldName', or a negative value
+    /// if no field identified by 'fieldName' exists.
+    int getFieldOrdinal(const char* fieldName) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the maximum number of elements in a datum resulting from
+    /// a call to 'getStats()'.
+    int numOrdinals() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the human-readable name of the monitorable object, or 0 or
+    /// the empty string if no such human-readable name has been assigned to
+    /// the monitorable object.
+    const char* objectName() const BSLS_KEYWORD_OVERRIDE;
+};
+
+// clang-format off
+OpenMetricsTest::Object::StatisticMetadata
+OpenMetricsTest::Object::STATISTICS[] = {
+    { "test", "calls",         "Number of calls",  ntci::Monitorable::e_SUM },
+    { "test", "latency.count", "Latency count",    ntci::Monitorable::e_SUM },
+    { "test", "latency.total", "Latency total",    ntci::Monitorable::e_SUM },
+    { "test", "latency.p50",   "Latency",   ntci::Monitorable::e_PERCENTILE },
+    { "test", "latency.p99",   "Latency",   ntci::Monitorable::e_PERCENTILE },
+    { "test", "depth",         "Current depth",  ntci::Monitorable::e_GAUGE }
+};
+// clang-format on
+
+OpenMetricsTest::Object::Object(const bsl::string& name)
+: d_name(name)
+, d_values(NUM_STATISTICS, 0.0)
+, d_defined(NUM_STATISTICS, false)
+{
+}
+
+OpenMetricsTest::Object::~Object()
+{
+}
+
+void OpenMetricsTest::Object::setValue(int ordinal, double value)
+{
+    d_values[ordinal]  = value;
+    d_defined[ordinal] = true;
+}
+
+void OpenMetricsTest::Object::resetValue(int ordinal)
+{
+    d_values[ordinal]  = 0.0;
+    d_defined[ordinal] = false;
+}
+
+void OpenMetricsTest::Object::getStats(bdld::ManagedDatum* result)
+{
+    bdld::DatumMutableArrayRef array;
+    bdld::Datum::createUninitializedArray(&array,
+                                          NUM_STATISTICS,
+                                          result->allocator());
+
+    for (int ordinal = 0; ordinal < NUM_STATISTICS; ++ordinal) {
+        if (d_defined[ordinal]) {
+            array.data()[ordinal] =
+                bdld::Datum::createDouble(d_values[ordinal]);
+        }
+        else {
+            array.data()[ordinal] = bdld::Datum::createNull();
+        }
+    }
+
+    *array.length() = NUM_STATISTICS;
+
+    result->adopt(bdld::Datum::adoptArray(array));
+}
+
+const char* OpenMetricsTest::Object::getFieldPrefix(int ordinal) const
+{
+    if (ordinal >= 0 && ordinal < NUM_STATISTICS) {
+        return STATISTICS[ordinal].prefix;
+    }
+    return 0;
+}
+
+const char* OpenMetricsTest::Object::getFieldName(int ordinal) const
+{
+    if (ordinal >= 0 && ordinal < NUM_STATISTICS) {
+        return STATISTICS[ordinal].name;
+    }
+    return 0;
+}
+
+const char* OpenMetricsTest::Object::getFieldDescription(int ordinal) const
+{
+    if (ordinal >= 0 && ordinal < NUM_STATISTICS) {
+        return STATISTICS[ordinal].description;
+    }
+    return 0;
+}
+
+ntci::Monitorable::StatisticType OpenMetricsTest::Object::getFieldType(
+    int ordinal) const
+{
+    if (ordinal >= 0 && ordinal < NUM_STATISTICS) {
+        return STATISTICS[ordinal].type;
+    }
+    return ntci::Monitorable::e_AVERAGE;
+}
+
+int OpenMetricsTest::Object::getFieldTags(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+    return ntci::Monitorable::e_ANONYMOUS;
+}
+
+int OpenMetricsTest::Object::getFieldOrdinal(const char* fieldName) const
+{
+    for (int ordinal = 0; ordinal < NUM_STATISTICS; ++ordinal) {
+        if (0 == bsl::strcmp(fieldName, STATISTICS[ordinal].name)) {
+            return ordinal;
+        }
+    }
+    return -1;
+}
+
+int OpenMetricsTest::Object::numOrdinals() const
+{
+    return NUM_STATISTICS;
+}
+
+const char* OpenMetricsTest::Object::objectName() const
+{
+    return d_name.c_str();
+}
+
+void OpenMetricsTest::publish(ntcs::OpenMetricsPublisher*    publisher,
+                              const bsl::shared_ptr<Object>& object,
+                              bool                           final)
+{
+    bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+    object->getStats(&stats);
+
+    publisher->publish(object, stats.datum(), bsls::TimeInterval(), final);
+}
+
+bsl::string OpenMetricsTest::labels(const bsl::shared_ptr<Object>& object)
+{
+    bsl::ostringstream ss;
+    ss << "{object=\"" << object->objectName() << "\",id=\""
+       << object->objectId().value() << "\"";
+    return ss.str();
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::OpenMetricsTest::verifyEmpty)
+{
+    ntcs::OpenMetricsPublisher publisher(NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_EQ(*publisher.snapshot(), "# EOF\n");
+
+    bsl::shared_ptr<Object> object;
+    object.createInplace(NTSCFG_TEST_ALLOCATOR, "alpha");
+
+    object->setValue(Object::STATISTIC_DEPTH, 1);
+
+    OpenMetricsTest::publish(&publisher, object, false);
+
+    NTSCFG_TEST_EQ(*publisher.snapshot(), "# EOF\n");
+    NTSCFG_TEST_EQ(publisher.numPublications(), 1);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::OpenMetricsTest::verifyFormat)
+{
+    ntcs::OpenMetricsPublisher publisher(NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<Object> object;
+    object.createInplace(NTSCFG_TEST_ALLOCATOR, "alpha");
+
+    object->setValue(Object::STATISTIC_CALLS, 3);
+    object->setValue(Object::STATISTIC_LATENCY_COUNT, 2);
+    object->setValue(Object::STATISTIC_LATENCY_TOTAL, 10.5);
+    object->setValue(Object::STATISTIC_LATENCY_P50, 2);
+    object->setValue(Object::STATISTIC_LATENCY_P99, 8.5);
+    object->setValue(Object::STATISTIC_DEPTH, 4);
+
+    OpenMetricsTest::publish(&publisher, object, true);
+
+    object->setValue(Object::STATISTIC_CALLS, 4);
+    object->setValue(Object::STATISTIC_LATENCY_COUNT, 3);
+    object->setValue(Object::STATISTIC_LATENCY_TOTAL, 4);
+    object->setValue(Object::STATISTIC_LATENCY_P50, 1.5);
+    object->resetValue(Object::STATISTIC_LATENCY_P99);
+    object->setValue(Object::STATISTIC_DEPTH, -8);
+
+    OpenMetricsTest::publish(&publisher, object, true);
+
+    const bsl::string l = OpenMetricsTest::labels(object);
+
+    bsl::string expected;
+    expected += "# TYPE ntc_test_calls counter\n";
+    expected += "# HELP ntc_test_calls Number of calls\n";
+    expected += "ntc_test_calls_total" + l + "} 7\n";
+    expected += "# TYPE ntc_test_latency summary\n";
+    expected += "# HELP ntc_test_latency Latency\n";
+    expected += "ntc_test_latency_count" + l + "} 5\n";
+    expected += "ntc_test_latency_sum" + l + "} 14.5\n";
+    expected += "ntc_test_latency" + l + ",quantile=\"0.5\"} 1.5\n";
+    expected += "# TYPE ntc_test_depth gauge\n";
+    expected += "# HELP ntc_test_depth Current depth\n";
+    expected += "ntc_test_depth" + l + "} -8\n";
+    expected += "# EOF\n";
+
+    NTSCFG_TEST_LOG_DEBUG << "Snapshot:\n" << *publisher.snapshot()
+                          << NTSCFG_TEST_LOG_END;
+
+    NTSCFG_TEST_EQ(*publisher.snapshot(), expected);
+    NTSCFG_TEST_EQ(publisher.numPublications(), 2);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::OpenMetricsTest::verifyEviction)
+{
+    ntcs::OpenMetricsPublisher publisher("app", NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<Object> first;
+    first.createInplace(NTSCFG_TEST_ALLOCATOR, "first");
+
+    bsl::shared_ptr<Object> second;
+    second.createInplace(NTSCFG_TEST_ALLOCATOR, "second");
+
+    first->setValue(Object::STATISTIC_DEPTH, 1);
+    second->setValue(Object::STATISTIC_DEPTH, 2);
+
+    OpenMetricsTest::publish(&publisher, first, false);
+    OpenMetricsTest::publish(&publisher, second, true);
+
+    {
+        bsl::string expected;
+        expected += "# TYPE app_test_depth gauge\n";
+        expected += "# HELP app_test_depth Current depth\n";
+        expected += "app_test_depth" + OpenMetricsTest::labels(first) +
+                    "} 1\n";
+        expected += "app_test_depth" + OpenMetricsTest::labels(second) +
+                    "} 2\n";
+        expected += "# EOF\n";
+
+        NTSCFG_TEST_EQ(*publisher.snapshot(), expected);
+    }
+
+    bsl::shared_ptr<const bsl::string> previous = publisher.snapshot();
+
+    OpenMetricsTest::publish(&publisher, second, true);
+
+    {
+        bsl::string expected;
+        expected += "# TYPE app_test_depth gauge\n";
+        expected += "# HELP app_test_depth Current depth\n";
+        expected += "app_test_depth" + OpenMetricsTest::labels(second) +
+                    "} 2\n";
+        expected += "# EOF\n";
+
+        NTSCFG_TEST_EQ(*publisher.snapshot(), expected);
+    }
+
+    // A snapshot previously returned is not modified.
+
+    NTSCFG_TEST_NE(*previous, *publisher.snapshot());
+}
+
+}  // close namespace ntcs
+}  // close namespace BloombergLP
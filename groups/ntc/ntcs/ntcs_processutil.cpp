@@ -24,6 +24,8 @@ BSLS_IDENT_RCSID(ntcs_processutil_cpp, "$Id$ $CSID$")
 #include <bsl_cstdlib.h>
 #include <bsl_cstring.h>
 
+#include <errno.h>
+
 #if defined(BSLS_PLATFORM_OS_UNIX)
 #include <dirent.h>
 #include <fcntl.h>
@@ -43,6 +45,7 @@ BSLS_IDENT_RCSID(ntcs_processutil_cpp, "$Id$ $CSID$")
 #elif defined(BSLS_PLATFORM_OS_LINUX)
 #include <dirent.h>
 #include <sys/procfs.h>
+#include <sys/syscall.h>
 #elif defined(BSLS_PLATFORM_OS_SOLARIS)
 #if BSLS_PLATFORM_CPU_64_BIT
 #include <procfs.h>
@@ -229,6 +232,206 @@ void ProcessUtil::getResourceUsage(ntcs::ProcessStatistics* result)
 #endif
 }
 
+#if defined(BSLS_PLATFORM_OS_LINUX)
+
+namespace {
+
+/// Load into the specified 'result' the scheduling statistics of the thread
+/// in the current process identified by the specified 'threadId'.
+void getThreadSchedulingStatistics(ntcs::ThreadStatistics* result,
+                                   int                     threadId)
+{
+    char path[PATH_MAX];
+    bsl::sprintf(path, "/proc/self/task/%d/schedstat", threadId);
+
+    FILE* file = bsl::fopen(path, "r");
+    if (file != 0) {
+        unsigned long long runTime    = 0;
+        unsigned long long waitTime   = 0;
+        unsigned long long timeslices = 0;
+
+        int rc = bsl::fscanf(file,
+                             "%llu %llu %llu",
+                             &runTime,
+                             &waitTime,
+                             &timeslices);
+        if (rc == 3) {
+            bsls::TimeInterval schedulingDelay;
+            schedulingDelay.setTotalNanoseconds(
+                static_cast<bsls::Types::Int64>(waitTime));
+
+            result->setSchedulingDelay(schedulingDelay);
+            result->setSchedulingTimeslices(
+                static_cast<bsl::size_t>(timeslices));
+        }
+
+        bsl::fclose(file);
+    }
+}
+
+}  // close unnamed namespace
+
+#endif
+
+int ProcessUtil::getThreadId()
+{
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    return static_cast<int>(::syscall(SYS_gettid));
+#else
+    return 0;
+#endif
+}
+
+ntsa::Error ProcessUtil::getThreadResourceUsage(
+    ntcs::ThreadStatistics* result)
+{
+    result->reset();
+
+#if defined(RUSAGE_THREAD)
+
+    struct ::rusage rusage;
+    int             rc = ::getrusage(RUSAGE_THREAD, &rusage);
+    if (rc != 0) {
+        return ntsa::Error(errno);
+    }
+
+    bsls::TimeInterval cpuTimeUser;
+    cpuTimeUser.setInterval(
+        static_cast<bsls::Types::Int64>(rusage.ru_utime.tv_sec),
+        static_cast<int>(rusage.ru_utime.tv_usec * 1000));
+
+    result->setCpuTimeUser(cpuTimeUser);
+
+    bsls::TimeInterval cpuTimeSystem;
+    cpuTimeSystem.setInterval(
+        static_cast<bsls::Types::Int64>(rusage.ru_stime.tv_sec),
+        static_cast<int>(rusage.ru_stime.tv_usec * 1000));
+
+    result->setCpuTimeSystem(cpuTimeSystem);
+
+    result->setContextSwitchesUser(static_cast<bsl::size_t>(rusage.ru_nvcsw));
+
+    result->setContextSwitchesSystem(
+        static_cast<bsl::size_t>(rusage.ru_nivcsw));
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    getThreadSchedulingStatistics(result, ProcessUtil::getThreadId());
+#endif
+
+    return ntsa::Error();
+
+#else
+
+    return ntsa::Error(ntsa::Error::e_NOT_IMPLEMENTED);
+
+#endif
+}
+
+ntsa::Error ProcessUtil::getThreadResourceUsage(
+    ntcs::ThreadStatistics* result,
+    int                     threadId)
+{
+#if defined(BSLS_PLATFORM_OS_LINUX)
+
+    result->reset();
+
+    // Read the counters from the files describing each task of the process,
+    // even when 'threadId' identifies the calling thread, so that every
+    // sample of a thread is measured in the same units: the CPU time in
+    // these files has the resolution of a clock tick, while the CPU time
+    // reported by 'getrusage(RUSAGE_THREAD)' has the resolution of a
+    // microsecond.
+
+    char path[PATH_MAX];
+    bsl::sprintf(path, "/proc/self/task/%d/stat", threadId);
+
+    FILE* file = bsl::fopen(path, "r");
+    if (file == 0) {
+        return ntsa::Error(errno);
+    }
+
+    char buffer[1024];
+    bsl::size_t size = bsl::fread(buffer, 1, sizeof buffer - 1, file);
+    buffer[size] = 0;
+
+    bsl::fclose(file);
+
+    // Skip the command name, which may contain spaces and parentheses, then
+    // the third through thirteenth fields, to the user and system CPU time
+    // measured in clock ticks.
+
+    const char* fields = bsl::strrchr(buffer, ')');
+    if (fields == 0) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    unsigned long ticksUser   = 0;
+    unsigned long ticksSystem = 0;
+
+    int rc = bsl::sscanf(fields + 1,
+                         " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u "
+                         "%lu %lu",
+                         &ticksUser,
+                         &ticksSystem);
+    if (rc != 2) {
+        return ntsa::Error(ntsa::Error::e_INVALID);
+    }
+
+    const long ticksPerSecond = ::sysconf(_SC_CLK_TCK);
+    if (ticksPerSecond > 0) {
+        bsls::TimeInterval cpuTimeUser;
+        cpuTimeUser.setTotalNanoseconds(
+            static_cast<bsls::Types::Int64>(ticksUser) * 1000000000 /
+            ticksPerSecond);
+
+        result->setCpuTimeUser(cpuTimeUser);
+
+        bsls::TimeInterval cpuTimeSystem;
+        cpuTimeSystem.setTotalNanoseconds(
+            static_cast<bsls::Types::Int64>(ticksSystem) * 1000000000 /
+            ticksPerSecond);
+
+        result->setCpuTimeSystem(cpuTimeSystem);
+    }
+
+    bsl::sprintf(path, "/proc/self/task/%d/status", threadId);
+
+    file = bsl::fopen(path, "r");
+    if (file != 0) {
+        char        line[256];
+        bsl::size_t value = 0;
+
+        while (bsl::fgets(line, sizeof line, file) != 0) {
+            if (bsl::sscanf(line, "voluntary_ctxt_switches: %zu", &value) ==
+                1)
+            {
+                result->setContextSwitchesUser(value);
+            }
+            else if (bsl::sscanf(line,
+                                 "nonvoluntary_ctxt_switches: %zu",
+                                 &value) == 1)
+            {
+                result->setContextSwitchesSystem(value);
+            }
+        }
+
+        bsl::fclose(file);
+    }
+
+    getThreadSchedulingStatistics(result, threadId);
+
+    return ntsa::Error();
+
+#else
+
+    NTCCFG_WARNING_UNUSED(threadId);
+
+    result->reset();
+    return ntsa::Error(ntsa::Error::e_NOT_IMPLEMENTED);
+
+#endif
+}
+
 #elif defined(BSLS_PLATFORM_OS_WINDOWS)
 
 void ProcessUtil::getResourceUsage(ntcs::ProcessStatistics* result)
@@ -265,6 +468,28 @@ void ProcessUtil::getResourceUsage(ntcs::ProcessStatistics* result)
 #endif
 }
 
+int ProcessUtil::getThreadId()
+{
+    return static_cast<int>(::GetCurrentThreadId());
+}
+
+ntsa::Error ProcessUtil::getThreadResourceUsage(
+    ntcs::ThreadStatistics* result)
+{
+    result->reset();
+    return ntsa::Error(ntsa::Error::e_NOT_IMPLEMENTED);
+}
+
+ntsa::Error ProcessUtil::getThreadResourceUsage(
+    ntcs::ThreadStatistics* result,
+    int                     threadId)
+{
+    NTCCFG_WARNING_UNUSED(threadId);
+
+    result->reset();
+    return ntsa::Error(ntsa::Error::e_NOT_IMPLEMENTED);
+}
+
 #else
 #error Not implemented
 #endif
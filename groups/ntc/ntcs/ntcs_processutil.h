@@ -21,6 +21,7 @@ BSLS_IDENT("$Id: $")
 
 #include <ntccfg_platform.h>
 #include <ntcs_processstatistics.h>
+#include <ntcs_threadstatistics.h>
 #include <ntcscm_version.h>
 #include <ntsa_error.h>
 #include <bsl_string.h>
@@ -40,6 +41,27 @@ struct ProcessUtil {
     /// Load into the specified 'result' the resource usage of the current
     /// process.
     static void getResourceUsage(ntcs::ProcessStatistics* result);
+
+    /// Return the identifier assigned by the operating system's scheduler to
+    /// the calling thread, or 0 if such identifiers are not supported on
+    /// the current platform.
+    static int getThreadId();
+
+    /// Load into the specified 'result' the resource usage of the calling
+    /// thread. Return the error.
+    static ntsa::Error getThreadResourceUsage(ntcs::ThreadStatistics* result);
+
+    /// Load into the specified 'result' the resource usage of the thread in
+    /// the current process identified by the specified 'threadId', as
+    /// returned by 'getThreadId()' when called on that thread. Return the
+    /// error. Note that the resource usage is always read from the same
+    /// source, whether or not 'threadId' identifies the calling thread, so
+    /// that successive results are comparable. Also note that this function
+    /// is only supported on Linux, and returns 'e_NOT_IMPLEMENTED' on other
+    /// platforms.
+    static ntsa::Error getThreadResourceUsage(
+        ntcs::ThreadStatistics* result,
+        int                     threadId);
 };
 
 }  // end namespace ntcs
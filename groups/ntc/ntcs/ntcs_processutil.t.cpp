@@ -22,6 +22,11 @@ BSLS_IDENT_RCSID(ntcs_processutil_t_cpp, "$Id$ $CSID$")
 
 #include <ntci_log.h>
 #include <ntcs_processstatistics.h>
+#include <ntcs_threadstatistics.h>
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+#include <unistd.h>
+#endif
 
 using namespace BloombergLP;
 
@@ -38,6 +43,12 @@ class ProcessUtilTest
   public:
     // TODO
     static void verify();
+
+    // Concern: The resource usage of a thread identified by its thread
+    // identifier is measured from the same source when the thread is the
+    // calling thread as when it is any other thread, and is not supported
+    // on platforms other than Linux.
+    static void verifyThreadResourceUsage();
 };
 
 bsl::string ProcessUtilTest::format(double value)
@@ -134,5 +145,34 @@ NTSCFG_TEST_FUNCTION(ntcs::ProcessUtilTest::verify)
     }
 }
 
+NTSCFG_TEST_FUNCTION(ntcs::ProcessUtilTest::verifyThreadResourceUsage)
+{
+    ntcs::ThreadStatistics statistics;
+    ntsa::Error            error = ntcs::ProcessUtil::getThreadResourceUsage(
+        &statistics,
+        ntcs::ProcessUtil::getThreadId());
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_FALSE(statistics.cpuTimeUser().isNull());
+    NTSCFG_TEST_FALSE(statistics.cpuTimeSystem().isNull());
+
+    // The CPU time of the calling thread is measured in clock ticks, like
+    // the CPU time of every other thread, rather than in the microseconds
+    // reported by 'getrusage(RUSAGE_THREAD)'.
+
+    const bsls::Types::Int64 tick = 1000000000 / ::sysconf(_SC_CLK_TCK);
+
+    NTSCFG_TEST_EQ(
+        statistics.cpuTimeUser().value().totalNanoseconds() % tick, 0);
+    NTSCFG_TEST_EQ(
+        statistics.cpuTimeSystem().value().totalNanoseconds() % tick, 0);
+#else
+    NTSCFG_TEST_EQ(error, ntsa::Error::e_NOT_IMPLEMENTED);
+    NTSCFG_TEST_TRUE(statistics.cpuTimeUser().isNull());
+#endif
+}
+
 }  // close namespace ntcs
 }  // close namespace BloombergLP
@@ -0,0 +1,101 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcs_recyclingallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_recyclingallocator_cpp, "$Id$ $CSID$")
+
+#include <bslma_default.h>
+#include <bsls_assert.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+RecyclingAllocator::RecyclingAllocator(bslma::Allocator* basicAllocator)
+: d_pool(k_NUM_POOLS, basicAllocator)
+, d_numReferences(1)
+, d_numAllocations(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+RecyclingAllocator::~RecyclingAllocator()
+{
+    BSLS_ASSERT(d_numReferences == 0);
+}
+
+void RecyclingAllocator::releaseReference()
+{
+    if (--d_numReferences == 0) {
+        bslma::Allocator* allocator = d_allocator_p;
+        this->~RecyclingAllocator();
+        allocator->deallocate(this);
+    }
+}
+
+RecyclingAllocator* RecyclingAllocator::create(
+    bslma::Allocator* basicAllocator)
+{
+    bslma::Allocator* allocator = bslma::Default::allocator(basicAllocator);
+
+    return new (*allocator) RecyclingAllocator(allocator);
+}
+
+void RecyclingAllocator::release()
+{
+    this->releaseReference();
+}
+
+void* RecyclingAllocator::allocate(size_type size)
+{
+    if (size == 0) {
+        return 0;
+    }
+
+    void* address = d_pool.allocate(size);
+
+    ++d_numReferences;
+    ++d_numAllocations;
+
+    return address;
+}
+
+void RecyclingAllocator::deallocate(void* address)
+{
+    if (address == 0) {
+        return;
+    }
+
+    d_pool.deallocate(address);
+
+    this->releaseReference();
+}
+
+bsl::uint64_t RecyclingAllocator::numBlocksInUse() const
+{
+    // The creator holds one reference until the allocator is released, and
+    // the allocator is never observed after that reference is released.
+
+    return d_numReferences.load() - 1;
+}
+
+bsl::uint64_t RecyclingAllocator::numAllocations() const
+{
+    return d_numAllocations.load();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
@@ -0,0 +1,123 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCS_RECYCLINGALLOCATOR
+#define INCLUDED_NTCS_RECYCLINGALLOCATOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntccfg_platform.h>
+#include <ntcscm_version.h>
+#include <bdlma_concurrentmultipoolallocator.h>
+#include <bslma_allocator.h>
+#include <bsls_atomic.h>
+#include <bsl_cstdint.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+/// @internal @brief
+/// Provide an allocator that recycles the memory of destroyed sockets.
+///
+/// @details
+/// This class implements the 'bslma::Allocator' protocol by supplying
+/// memory from pools of blocks segregated by size. Memory returned to this
+/// allocator is retained in its pool and reused to satisfy subsequent
+/// allocations of a similar size, so that a workload that repeatedly creates
+/// and destroys objects of the same type, such as the sockets accepted by a
+/// listener under high connection churn, reaches a steady state in which
+/// the underlying allocator is no longer consulted.
+///
+/// The lifetime of this object is reference counted: the creator holds one
+/// reference, released by 'release', and each outstanding block holds
+/// another. The object destroys itself, returning all retained memory to
+/// the underlying allocator, when the last reference is released. Objects
+/// whose memory is supplied by this allocator may therefore safely outlive
+/// the component that created the allocator.
+///
+/// @par Thread Safety
+/// This class is thread safe.
+///
+/// @ingroup module_ntcs
+class RecyclingAllocator : public bslma::Allocator
+{
+    enum {
+        /// The number of pools of blocks segregated by size. The largest
+        /// block size recycled is 8 * 2^(k_NUM_POOLS - 1) bytes; larger
+        /// blocks are supplied directly by the underlying allocator.
+        k_NUM_POOLS = 12
+    };
+
+    bdlma::ConcurrentMultipoolAllocator d_pool;
+    bsls::AtomicUint64                  d_numReferences;
+    bsls::AtomicUint64                  d_numAllocations;
+    bslma::Allocator*                   d_allocator_p;
+
+  private:
+    RecyclingAllocator(const RecyclingAllocator&) BSLS_KEYWORD_DELETED;
+    RecyclingAllocator& operator=(const RecyclingAllocator&)
+        BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Create a new recycling allocator. Optionally specify a
+    /// 'basicAllocator' used to supply memory. If 'basicAllocator' is 0,
+    /// the currently installed default allocator is used.
+    explicit RecyclingAllocator(bslma::Allocator* basicAllocator);
+
+    /// Destroy this object.
+    ~RecyclingAllocator() BSLS_KEYWORD_OVERRIDE;
+
+    /// Release one reference to this object, and destroy this object if
+    /// that reference was the last.
+    void releaseReference();
+
+  public:
+    /// Create a new recycling allocator and return its address. Optionally
+    /// specify a 'basicAllocator' used to supply memory. If
+    /// 'basicAllocator' is 0, the currently installed default allocator is
+    /// used. The caller is responsible for calling 'release' on the result
+    /// when it no longer needs to allocate from it.
+    static RecyclingAllocator* create(bslma::Allocator* basicAllocator = 0);
+
+    /// Release the reference held by the creator of this object. This
+    /// object is destroyed once every block it has supplied has also been
+    /// returned. The behavior is undefined if this function is called more
+    /// than once, or if this object is used by the caller after this
+    /// function returns.
+    void release();
+
+    /// Return a newly allocated block of memory of (at least) the specified
+    /// positive 'size' (in bytes), recycling a previously deallocated block
+    /// of a suitable size if one is available. If 'size' is 0, a null
+    /// pointer is returned with no other effect.
+    void* allocate(size_type size) BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the memory block at the specified 'address' back to this
+    /// allocator for reuse. If 'address' is 0, this function has no effect.
+    /// The behavior is undefined unless 'address' was allocated using this
+    /// allocator object and has not already been deallocated.
+    void deallocate(void* address) BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the number of blocks currently allocated from this object.
+    bsl::uint64_t numBlocksInUse() const;
+
+    /// Return the total number of blocks ever allocated from this object.
+    bsl::uint64_t numAllocations() const;
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
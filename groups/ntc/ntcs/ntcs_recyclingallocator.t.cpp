@@ -0,0 +1,109 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_recyclingallocator_t_cpp, "$Id$ $CSID$")
+
+#include <ntcs_recyclingallocator.h>
+#include <bslma_testallocator.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcs {
+
+// Provide tests for 'ntcs::RecyclingAllocator'.
+class RecyclingAllocatorTest
+{
+  public:
+    // Concern: Memory returned to the allocator is reused for subsequent
+    // allocations without consulting the underlying allocator.
+    static void verifyRecycling();
+
+    // Concern: The allocator outlives its creator while any block it has
+    // supplied remains outstanding.
+    static void verifyLifetime();
+};
+
+NTSCFG_TEST_FUNCTION(ntcs::RecyclingAllocatorTest::verifyRecycling)
+{
+    const bsl::size_t k_NUM_ITERATIONS = 1000;
+
+    bslma::TestAllocator ta;
+
+    {
+        ntcs::RecyclingAllocator* allocator =
+            ntcs::RecyclingAllocator::create(&ta);
+
+        bsls::Types::Int64 numAllocations = 0;
+
+        for (bsl::size_t i = 0; i <= k_NUM_ITERATIONS; ++i) {
+            // Warm up the pools during the first iteration, then measure the
+            // allocations made from the underlying allocator by every
+            // subsequent iteration.
+
+            if (i == 1) {
+                numAllocations = ta.numAllocations();
+            }
+
+            bsl::shared_ptr<bsl::string> object;
+            object.createInplace(allocator,
+                                 "A string too long to be stored inline",
+                                 allocator);
+
+            NTSCFG_TEST_EQ(allocator->numBlocksInUse(), 2);
+        }
+
+        NTSCFG_TEST_EQ(ta.numAllocations(), numAllocations);
+        NTSCFG_TEST_EQ(allocator->numBlocksInUse(), 0);
+        NTSCFG_TEST_EQ(allocator->numAllocations(),
+                       2 * (k_NUM_ITERATIONS + 1));
+
+        allocator->release();
+    }
+
+    NTSCFG_TEST_EQ(ta.numBlocksInUse(), 0);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::RecyclingAllocatorTest::verifyLifetime)
+{
+    bslma::TestAllocator ta;
+
+    {
+        ntcs::RecyclingAllocator* allocator =
+            ntcs::RecyclingAllocator::create(&ta);
+
+        bsl::shared_ptr<bsl::string> object;
+        object.createInplace(allocator,
+                             "A string too long to be stored inline",
+                             allocator);
+
+        allocator->release();
+
+        NTSCFG_TEST_GT(ta.numBlocksInUse(), 0);
+        NTSCFG_TEST_EQ(*object, "A string too long to be stored inline");
+
+        object.reset();
+    }
+
+    NTSCFG_TEST_EQ(ta.numBlocksInUse(), 0);
+}
+
+}  // close namespace ntcs
+}  // close namespace BloombergLP
@@ -0,0 +1,266 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCS_SOCKETPOOL
+#define INCLUDED_NTCS_SOCKETPOOL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntccfg_platform.h>
+#include <ntcscm_version.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bsls_atomic.h>
+#include <bsl_cstddef.h>
+#include <bsl_cstdint.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+/// @internal @brief
+/// Provide a pool of closed sockets available for reuse.
+///
+/// @details
+/// This class template retains objects of the parameterized 'TYPE' after the
+/// last shared pointer to them is released, so that a workload that
+/// repeatedly creates and destroys sockets, such as a listener under high
+/// connection churn, reinitializes a previously closed socket rather than
+/// constructing a new one. The parameterized 'TYPE' must provide a 'clear'
+/// function that releases every resource held by the object, as its
+/// destructor would, leaving the object ready to be reinitialized by its
+/// owner.
+///
+/// Objects are loaded into a shared pointer by 'manage', whose deleter
+/// clears the object and returns it to this pool when the last reference to
+/// the object is released. At most 'capacity' cleared objects are retained;
+/// objects released when this pool is full are destroyed. Objects may
+/// safely outlive this pool: an object released after this pool has been
+/// destroyed is itself destroyed. This pool must therefore be created
+/// through a shared pointer.
+///
+/// @par Thread Safety
+/// This class is thread safe.
+///
+/// @ingroup module_ntcs
+template <typename TYPE>
+class SocketPool : public ntccfg::Shared<SocketPool<TYPE> >
+{
+    /// Define a type alias for a mutex.
+    typedef ntccfg::Mutex Mutex;
+
+    /// Define a type alias for a mutex lock guard.
+    typedef ntccfg::LockGuard LockGuard;
+
+    /// Define a type alias for a vector of cleared objects.
+    typedef bsl::vector<TYPE*> ObjectVector;
+
+    /// Provide a deleter of an object managed by a socket pool.
+    class Deleter;
+
+    mutable Mutex      d_mutex;
+    ObjectVector       d_objects;
+    const bsl::size_t  d_capacity;
+    bsls::AtomicUint64 d_numReused;
+    bslma::Allocator*  d_objectAllocator_p;
+    bslma::Allocator*  d_allocator_p;
+
+  private:
+    SocketPool(const SocketPool&) BSLS_KEYWORD_DELETED;
+    SocketPool& operator=(const SocketPool&) BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Clear the specified 'object' and retain it in this pool if this pool
+    /// is not full, otherwise destroy it.
+    void release(TYPE* object);
+
+  public:
+    /// Create a new socket pool that retains at most the specified
+    /// 'capacity' cleared objects, each of which was allocated from the
+    /// specified 'objectAllocator'. Optionally specify a 'basicAllocator'
+    /// used to supply memory. If 'basicAllocator' is 0, the currently
+    /// installed default allocator is used.
+    SocketPool(bsl::size_t       capacity,
+               bslma::Allocator* objectAllocator,
+               bslma::Allocator* basicAllocator = 0);
+
+    /// Destroy this object and each cleared object it retains.
+    ~SocketPool();
+
+    /// Remove a cleared object from this pool and return its address, or
+    /// return 0 if this pool is empty. The caller is responsible for
+    /// reinitializing the result then loading it into a shared pointer by
+    /// calling 'manage'.
+    TYPE* acquire();
+
+    /// Load into the specified 'result' the specified 'object', allocated
+    /// from the object allocator of this pool, such that the object is
+    /// returned to this pool when the last reference to it is released.
+    void manage(bsl::shared_ptr<TYPE>* result, TYPE* object);
+
+    /// Return the object allocator of this pool.
+    bslma::Allocator* objectAllocator() const;
+
+    /// Return the number of cleared objects retained by this pool.
+    bsl::size_t size() const;
+
+    /// Return the maximum number of cleared objects retained by this pool.
+    bsl::size_t capacity() const;
+
+    /// Return the number of objects removed from this pool for reuse.
+    bsl::uint64_t numReused() const;
+};
+
+/// Provide a deleter of an object managed by a socket pool.
+///
+/// @par Thread Safety
+/// This class is thread safe.
+template <typename TYPE>
+class SocketPool<TYPE>::Deleter
+{
+    bsl::weak_ptr<SocketPool<TYPE> > d_pool;
+    bslma::Allocator*                d_objectAllocator_p;
+
+  public:
+    /// Create a new deleter that returns objects to the specified 'pool',
+    /// or deletes them using the specified 'objectAllocator' if 'pool' has
+    /// been destroyed.
+    Deleter(const bsl::weak_ptr<SocketPool<TYPE> >& pool,
+            bslma::Allocator*                       objectAllocator);
+
+    /// Return the specified 'object' to the pool, if the pool still exists,
+    /// otherwise destroy 'object'.
+    void operator()(TYPE* object) const;
+};
+
+template <typename TYPE>
+NTCCFG_INLINE SocketPool<TYPE>::Deleter::Deleter(
+    const bsl::weak_ptr<SocketPool<TYPE> >& pool,
+    bslma::Allocator*                       objectAllocator)
+: d_pool(pool)
+, d_objectAllocator_p(objectAllocator)
+{
+}
+
+template <typename TYPE>
+NTCCFG_INLINE void SocketPool<TYPE>::Deleter::operator()(TYPE* object) const
+{
+    bsl::shared_ptr<SocketPool<TYPE> > pool = d_pool.lock();
+    if (pool) {
+        pool->release(object);
+    }
+    else {
+        d_objectAllocator_p->deleteObject(object);
+    }
+}
+
+template <typename TYPE>
+void SocketPool<TYPE>::release(TYPE* object)
+{
+    object->clear();
+
+    {
+        LockGuard lock(&d_mutex);
+
+        if (d_objects.size() < d_capacity) {
+            d_objects.push_back(object);
+            return;
+        }
+    }
+
+    d_objectAllocator_p->deleteObject(object);
+}
+
+template <typename TYPE>
+SocketPool<TYPE>::SocketPool(bsl::size_t       capacity,
+                             bslma::Allocator* objectAllocator,
+                             bslma::Allocator* basicAllocator)
+: d_mutex()
+, d_objects(basicAllocator)
+, d_capacity(capacity)
+, d_numReused(0)
+, d_objectAllocator_p(bslma::Default::allocator(objectAllocator))
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <typename TYPE>
+SocketPool<TYPE>::~SocketPool()
+{
+    for (typename ObjectVector::iterator it = d_objects.begin();
+         it != d_objects.end();
+         ++it)
+    {
+        d_objectAllocator_p->deleteObject(*it);
+    }
+
+    d_objects.clear();
+}
+
+template <typename TYPE>
+TYPE* SocketPool<TYPE>::acquire()
+{
+    LockGuard lock(&d_mutex);
+
+    if (d_objects.empty()) {
+        return 0;
+    }
+
+    TYPE* object = d_objects.back();
+    d_objects.pop_back();
+
+    ++d_numReused;
+
+    return object;
+}
+
+template <typename TYPE>
+void SocketPool<TYPE>::manage(bsl::shared_ptr<TYPE>* result, TYPE* object)
+{
+    result->reset(object,
+                  Deleter(this->weak_from_this(), d_objectAllocator_p),
+                  d_allocator_p);
+}
+
+template <typename TYPE>
+NTCCFG_INLINE bslma::Allocator* SocketPool<TYPE>::objectAllocator() const
+{
+    return d_objectAllocator_p;
+}
+
+template <typename TYPE>
+NTCCFG_INLINE bsl::size_t SocketPool<TYPE>::size() const
+{
+    LockGuard lock(&d_mutex);
+    return d_objects.size();
+}
+
+template <typename TYPE>
+NTCCFG_INLINE bsl::size_t SocketPool<TYPE>::capacity() const
+{
+    return d_capacity;
+}
+
+template <typename TYPE>
+NTCCFG_INLINE bsl::uint64_t SocketPool<TYPE>::numReused() const
+{
+    return d_numReused.load();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
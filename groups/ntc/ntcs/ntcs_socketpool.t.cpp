@@ -0,0 +1,206 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_socketpool_t_cpp, "$Id$ $CSID$")
+
+#include <ntcs_socketpool.h>
+#include <bslma_testallocator.h>
+#include <bsl_memory.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcs {
+
+// Provide tests for 'ntcs::SocketPool'.
+class SocketPoolTest
+{
+    // Provide a socket suitable for retention by a socket pool.
+    class Socket;
+
+    // Define a type alias for a pool of sockets.
+    typedef ntcs::SocketPool<Socket> Pool;
+
+  public:
+    // Concern: An object whose last reference is released is cleared and
+    // returned to the pool, then removed from the pool for reuse.
+    static void verifyReuse();
+
+    // Concern: Objects released when the pool is full are destroyed.
+    static void verifyCapacity();
+
+    // Concern: Objects may outlive the pool.
+    static void verifyLifetime();
+};
+
+// Provide a socket suitable for retention by a socket pool.
+class SocketPoolTest::Socket
+{
+    bsl::size_t* d_numCleared_p;
+    bool         d_open;
+
+  public:
+    // Create a new, open socket that increments the specified 'numCleared'
+    // each time it is cleared.
+    explicit Socket(bsl::size_t* numCleared)
+    : d_numCleared_p(numCleared)
+    , d_open(true)
+    {
+    }
+
+    // Reopen this socket.
+    void reset()
+    {
+        d_open = true;
+    }
+
+    // Close this socket.
+    void clear()
+    {
+        d_open = false;
+        ++(*d_numCleared_p);
+    }
+
+    // Return true if this socket is open, otherwise return false.
+    bool isOpen() const
+    {
+        return d_open;
+    }
+};
+
+NTSCFG_TEST_FUNCTION(ntcs::SocketPoolTest::verifyReuse)
+{
+    bslma::TestAllocator ta;
+
+    {
+        bsl::size_t numCleared = 0;
+
+        bsl::shared_ptr<Pool> pool;
+        pool.createInplace(&ta, 1, &ta, &ta);
+
+        NTSCFG_TEST_EQ(pool->capacity(), 1);
+        NTSCFG_TEST_EQ(pool->objectAllocator(), &ta);
+        Socket* empty = pool->acquire();
+        NTSCFG_TEST_EQ(empty, 0);
+
+        Socket* object = new (ta) Socket(&numCleared);
+
+        {
+            bsl::shared_ptr<Socket> socket;
+            pool->manage(&socket, object);
+
+            NTSCFG_TEST_EQ(socket.get(), object);
+            NTSCFG_TEST_EQ(pool->size(), 0);
+        }
+
+        NTSCFG_TEST_EQ(numCleared, 1);
+        NTSCFG_TEST_EQ(pool->size(), 1);
+        NTSCFG_TEST_FALSE(object->isOpen());
+
+        const bsls::Types::Int64 numBlocksInUse = ta.numBlocksInUse();
+
+        Socket* reused = pool->acquire();
+        NTSCFG_TEST_EQ(reused, object);
+        NTSCFG_TEST_EQ(pool->size(), 0);
+        NTSCFG_TEST_EQ(pool->numReused(), 1);
+
+        reused->reset();
+
+        {
+            bsl::shared_ptr<Socket> socket;
+            pool->manage(&socket, reused);
+
+            NTSCFG_TEST_TRUE(socket->isOpen());
+        }
+
+        NTSCFG_TEST_EQ(numCleared, 2);
+        NTSCFG_TEST_EQ(pool->size(), 1);
+        NTSCFG_TEST_EQ(ta.numBlocksInUse(), numBlocksInUse);
+    }
+
+    NTSCFG_TEST_EQ(ta.numBlocksInUse(), 0);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::SocketPoolTest::verifyCapacity)
+{
+    bslma::TestAllocator ta;
+
+    {
+        bsl::size_t numCleared = 0;
+
+        bsl::shared_ptr<Pool> pool;
+        pool.createInplace(&ta, 1, &ta, &ta);
+
+        bsl::shared_ptr<Socket> socket1;
+        pool->manage(&socket1, new (ta) Socket(&numCleared));
+
+        bsl::shared_ptr<Socket> socket2;
+        pool->manage(&socket2, new (ta) Socket(&numCleared));
+
+        Socket* object1 = socket1.get();
+
+        socket1.reset();
+        NTSCFG_TEST_EQ(pool->size(), 1);
+
+        const bsls::Types::Int64 numBlocksInUse = ta.numBlocksInUse();
+
+        socket2.reset();
+        NTSCFG_TEST_EQ(numCleared, 2);
+        NTSCFG_TEST_EQ(pool->size(), 1);
+        NTSCFG_TEST_LT(ta.numBlocksInUse(), numBlocksInUse);
+
+        Socket* reused = pool->acquire();
+        NTSCFG_TEST_EQ(reused, object1);
+
+        Socket* empty = pool->acquire();
+        NTSCFG_TEST_EQ(empty, 0);
+
+        ta.deleteObject(object1);
+    }
+
+    NTSCFG_TEST_EQ(ta.numBlocksInUse(), 0);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::SocketPoolTest::verifyLifetime)
+{
+    bslma::TestAllocator ta;
+
+    {
+        bsl::size_t numCleared = 0;
+
+        bsl::shared_ptr<Socket> socket;
+
+        {
+            bsl::shared_ptr<Pool> pool;
+            pool.createInplace(&ta, 1, &ta, &ta);
+
+            pool->manage(&socket, new (ta) Socket(&numCleared));
+        }
+
+        NTSCFG_TEST_TRUE(socket->isOpen());
+
+        socket.reset();
+
+        NTSCFG_TEST_EQ(numCleared, 0);
+    }
+
+    NTSCFG_TEST_EQ(ta.numBlocksInUse(), 0);
+}
+
+}  // close namespace ntcs
+}  // close namespace BloombergLP
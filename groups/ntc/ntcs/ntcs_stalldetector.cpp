@@ -0,0 +1,568 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcs_stalldetector.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_stalldetector_cpp, "$Id$ $CSID$")
+
+#include <ntci_identifiable.h>
+#include <ntci_log.h>
+#include <ntci_proactorsocket.h>
+#include <ntci_reactorsocket.h>
+#include <ntcs_monitorable.h>
+
+#include <bdlf_bind.h>
+#include <bdlf_placeholder.h>
+#include <bslmt_threadutil.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bsls_assert.h>
+#include <bsls_timeutil.h>
+#include <bsl_cstring.h>
+#include <bsl_sstream.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+namespace {
+
+/// Describe the process-wide stall detector state.
+class StallDetectorState
+{
+  public:
+    /// Create the process-wide state necessary to install stall detectors.
+    StallDetectorState();
+
+    /// Destroy the process-wide state necessary to install stall detectors.
+    ~StallDetectorState();
+
+    /// The process-wide stall detector thread-local key.
+    bslmt::ThreadUtil::Key d_key;
+
+    /// The global stall detector state.
+    static StallDetectorState s_global;
+
+  private:
+    StallDetectorState(const StallDetectorState&);
+    StallDetectorState& operator=(const StallDetectorState&);
+};
+
+StallDetectorState StallDetectorState::s_global;
+
+StallDetectorState::StallDetectorState()
+{
+    int rc = bslmt::ThreadUtil::createKey(&d_key, 0);
+    BSLS_ASSERT_OPT(rc == 0);
+}
+
+StallDetectorState::~StallDetectorState()
+{
+}
+
+/// Invoke the specified 'functor' as a callback of the specified 'callback'
+/// kind dispatched to the specified 'descriptor', if it still exists.
+void invokeAttributedFunction(
+    StallDetector::Callback                callback,
+    const ntci::Executor::Functor&         functor,
+    const bsl::weak_ptr<ntsi::Descriptor>& descriptor)
+{
+    bsl::shared_ptr<ntsi::Descriptor> owner = descriptor.lock();
+
+    ntcs::StallDetectorGuard stallGuard(callback, owner.get());
+    functor();
+}
+
+/// Invoke the specified 'callback' with the specified 'timer' and 'event'
+/// as a timer dispatched to the specified 'descriptor', if it still exists.
+/// The calling thread must be executing on the strand of 'callback', if
+/// any.
+void invokeAttributedTimer(const ntci::TimerCallback&             callback,
+                           const bsl::weak_ptr<ntsi::Descriptor>& descriptor,
+                           const bsl::shared_ptr<ntci::Timer>&    timer,
+                           const ntca::TimerEvent&                event)
+{
+    bsl::shared_ptr<ntsi::Descriptor> owner = descriptor.lock();
+
+    ntcs::StallDetectorGuard stallGuard(StallDetector::e_TIMER, owner.get());
+    callback.execute(timer, event, callback.strand());
+}
+
+}  // close unnamed namespace
+
+const ntci::MetricMetadata StallDetector::STATISTICS[] = {
+    NTCI_METRIC_METADATA_SUMMARY(stallTime),
+    NTCI_METRIC_METADATA_GAUGE(stalled)};
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_THREAD_LOCAL)
+thread_local bool StallDetector::s_threadLocalEnabled = false;
+#else
+bsls::AtomicInt StallDetector::s_threadLocalCount(0);
+#endif
+
+bsls::AtomicInt StallDetector::s_count(0);
+
+void StallDetector::report(bsls::Types::Int64 duration)
+{
+    NTCI_LOG_CONTEXT();
+
+    const double durationInMicroseconds =
+        static_cast<double>(duration) / 1000.0;
+
+    d_stallTime.update(durationInMicroseconds);
+
+    if (d_reported.swap(true)) {
+        return;
+    }
+
+    bsl::string metricsName;
+    int         objectId = 0;
+
+    if (d_descriptor_p != 0) {
+        const ntci::ReactorSocket* reactorSocket =
+            dynamic_cast<const ntci::ReactorSocket*>(d_descriptor_p);
+        if (reactorSocket != 0) {
+            metricsName = reactorSocket->metricsName();
+        }
+        else {
+            const ntci::ProactorSocket* proactorSocket =
+                dynamic_cast<const ntci::ProactorSocket*>(d_descriptor_p);
+            if (proactorSocket != 0) {
+                metricsName = proactorSocket->metricsName();
+            }
+        }
+
+        const ntci::Identifiable* identifiable =
+            dynamic_cast<const ntci::Identifiable*>(d_descriptor_p);
+        if (identifiable != 0) {
+            objectId = identifiable->objectId().value();
+        }
+    }
+
+    if (!metricsName.empty()) {
+        NTCI_LOG_WARN("Event loop '%s' stalled for %d usec by the %s "
+                      "callback to socket '%s' descriptor %d",
+                      d_objectName.c_str(),
+                      static_cast<int>(durationInMicroseconds),
+                      StallDetector::toString(
+                          static_cast<Callback>(d_callback.load())),
+                      metricsName.c_str(),
+                      d_handle.load());
+    }
+    else if (objectId != 0) {
+        NTCI_LOG_WARN("Event loop '%s' stalled for %d usec by the %s "
+                      "callback to socket %d descriptor %d",
+                      d_objectName.c_str(),
+                      static_cast<int>(durationInMicroseconds),
+                      StallDetector::toString(
+                          static_cast<Callback>(d_callback.load())),
+                      objectId,
+                      d_handle.load());
+    }
+    else {
+        NTCI_LOG_WARN("Event loop '%s' stalled for %d usec by the %s "
+                      "callback to descriptor %d",
+                      d_objectName.c_str(),
+                      static_cast<int>(durationInMicroseconds),
+                      StallDetector::toString(
+                          static_cast<Callback>(d_callback.load())),
+                      d_handle.load());
+    }
+}
+
+StallDetector::StallDetector(const bsls::TimeInterval& threshold,
+                             const bslstl::StringRef&  prefix,
+                             const bslstl::StringRef&  objectName,
+                             bslma::Allocator*         basicAllocator)
+: d_threshold(threshold.totalNanoseconds())
+, d_startTime(0)
+, d_callback(e_NONE)
+, d_handle(ntsa::k_INVALID_HANDLE)
+, d_reported(false)
+, d_descriptor_p(0)
+, d_depth(0)
+, d_outerCallback(e_NONE)
+, d_innerStartTime(0)
+, d_innerReported(false)
+, d_stallTime()
+, d_prefix(prefix, basicAllocator)
+, d_objectName(objectName, basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    s_count.addRelaxed(1);
+}
+
+StallDetector::~StallDetector()
+{
+    s_count.addRelaxed(-1);
+}
+
+bool StallDetector::enter(Callback                callback,
+                          const ntsi::Descriptor* descriptor)
+{
+    if (d_depth != 0) {
+        // A callback to a descriptor nested within an outermost callback to
+        // no descriptor, such as a socket's function run by a strand, is
+        // measured separately so that a stall can be attributed to it.
+
+        if (d_depth != 1 || d_descriptor_p != 0 || descriptor == 0) {
+            return false;
+        }
+
+        d_depth          = 2;
+        d_descriptor_p   = descriptor;
+        d_outerCallback  = static_cast<Callback>(d_callback.loadRelaxed());
+        d_innerStartTime = bsls::TimeUtil::getTimer();
+
+        d_callback.storeRelaxed(callback);
+        d_handle.storeRelaxed(descriptor->handle());
+
+        return true;
+    }
+
+    d_depth         = 1;
+    d_descriptor_p  = descriptor;
+    d_innerReported = false;
+
+    d_callback.storeRelaxed(callback);
+    d_handle.storeRelaxed(descriptor != 0 ? descriptor->handle()
+                                          : ntsa::k_INVALID_HANDLE);
+    d_startTime.storeRelease(bsls::TimeUtil::getTimer());
+
+    return true;
+}
+
+void StallDetector::leave()
+{
+    BSLS_ASSERT(d_depth == 1 || d_depth == 2);
+
+    const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+
+    if (d_depth == 2) {
+        const bsls::Types::Int64 duration = now - d_innerStartTime;
+
+        if (NTCCFG_UNLIKELY(duration > d_threshold)) {
+            this->report(duration);
+            d_innerReported = true;
+        }
+
+        d_callback.storeRelaxed(d_outerCallback);
+        d_handle.storeRelaxed(ntsa::k_INVALID_HANDLE);
+
+        d_descriptor_p = 0;
+        d_depth        = 1;
+
+        return;
+    }
+
+    const bsls::Types::Int64 duration = now - d_startTime.loadRelaxed();
+
+    if (NTCCFG_UNLIKELY(duration > d_threshold && !d_innerReported)) {
+        this->report(duration);
+    }
+
+    d_startTime.storeRelease(0);
+    d_reported.storeRelaxed(false);
+
+    d_descriptor_p  = 0;
+    d_depth         = 0;
+    d_innerReported = false;
+}
+
+void StallDetector::getStats(bdld::ManagedDatum* result)
+{
+    bool stalled = false;
+
+    const bsls::Types::Int64 startTime = d_startTime.loadAcquire();
+    if (startTime != 0) {
+        const bsls::Types::Int64 duration =
+            bsls::TimeUtil::getTimer() - startTime;
+
+        if (duration > d_threshold) {
+            stalled = true;
+
+            if (!d_reported.swap(true)) {
+                NTCI_LOG_CONTEXT();
+
+                NTCI_LOG_WARN("Event loop '%s' stalled for at least %d usec "
+                              "by the %s callback to descriptor %d",
+                              d_objectName.c_str(),
+                              static_cast<int>(duration / 1000),
+                              StallDetector::toString(
+                                  static_cast<Callback>(d_callback.load())),
+                              d_handle.load());
+            }
+        }
+    }
+
+    bdld::DatumMutableArrayRef array;
+    bdld::Datum::createUninitializedArray(&array,
+                                          numOrdinals(),
+                                          result->allocator());
+
+    bsl::size_t index = 0;
+
+    ntci::MetricValue value;
+    d_stallTime.load(&value);
+
+    value.collectSummary(&array, &index);
+
+    array.data()[index++] = bdld::Datum::createDouble(stalled ? 1 : 0);
+
+    *array.length() = numOrdinals();
+
+    result->adopt(bdld::Datum::adoptArray(array));
+}
+
+const char* StallDetector::getFieldPrefix(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return d_prefix.c_str();
+}
+
+const char* StallDetector::getFieldName(int ordinal) const
+{
+    if (ordinal < numOrdinals()) {
+        return StallDetector::STATISTICS[ordinal].d_name;
+    }
+    else {
+        return 0;
+    }
+}
+
+const char* StallDetector::getFieldDescription(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return "";
+}
+
+ntci::Monitorable::StatisticType StallDetector::getFieldType(
+    int ordinal) const
+{
+    if (ordinal < numOrdinals()) {
+        return StallDetector::STATISTICS[ordinal].d_type;
+    }
+    else {
+        return ntci::Monitorable::e_AVERAGE;
+    }
+}
+
+int StallDetector::getFieldTags(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return ntci::Monitorable::e_ANONYMOUS;
+}
+
+int StallDetector::getFieldOrdinal(const char* fieldName) const
+{
+    int result = 0;
+
+    for (int ordinal = 0; ordinal < numOrdinals(); ++ordinal) {
+        if (bsl::strcmp(StallDetector::STATISTICS[ordinal].d_name,
+                        fieldName) == 0)
+        {
+            result = ordinal;
+        }
+    }
+
+    return result;
+}
+
+int StallDetector::numOrdinals() const
+{
+    return sizeof StallDetector::STATISTICS /
+           sizeof StallDetector::STATISTICS[0];
+}
+
+const char* StallDetector::objectName() const
+{
+    return d_objectName.c_str();
+}
+
+bsls::TimeInterval StallDetector::threshold() const
+{
+    bsls::TimeInterval result;
+    result.setTotalNanoseconds(d_threshold);
+    return result;
+}
+
+bool StallDetector::isStalled() const
+{
+    const bsls::Types::Int64 startTime = d_startTime.loadAcquire();
+    if (startTime == 0) {
+        return false;
+    }
+
+    return bsls::TimeUtil::getTimer() - startTime > d_threshold;
+}
+
+const char* StallDetector::toString(Callback callback)
+{
+    switch (callback) {
+    case e_NONE:
+        return "NONE";
+    case e_READABLE:
+        return "READABLE";
+    case e_WRITABLE:
+        return "WRITABLE";
+    case e_ERROR:
+        return "ERROR";
+    case e_NOTIFICATIONS:
+        return "NOTIFICATIONS";
+    case e_ACCEPTED:
+        return "ACCEPTED";
+    case e_CONNECTED:
+        return "CONNECTED";
+    case e_RECEIVED:
+        return "RECEIVED";
+    case e_SENT:
+        return "SENT";
+    case e_FUNCTION:
+        return "FUNCTION";
+    case e_TIMER:
+        return "TIMER";
+    }
+
+    return "???";
+}
+
+StallDetector* StallDetector::setThreadLocal(StallDetector* stallDetector)
+{
+    StallDetector* previous = reinterpret_cast<StallDetector*>(
+        bslmt::ThreadUtil::getSpecific(StallDetectorState::s_global.d_key));
+
+    int rc = bslmt::ThreadUtil::setSpecific(
+        StallDetectorState::s_global.d_key,
+        const_cast<const void*>(static_cast<void*>(stallDetector)));
+    BSLS_ASSERT_OPT(rc == 0);
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_THREAD_LOCAL)
+    s_threadLocalEnabled = stallDetector != 0;
+#else
+    if (previous == 0 && stallDetector != 0) {
+        s_threadLocalCount.addRelaxed(1);
+    }
+    else if (previous != 0 && stallDetector == 0) {
+        s_threadLocalCount.addRelaxed(-1);
+    }
+#endif
+
+    return previous;
+}
+
+StallDetector* StallDetector::getThreadLocal()
+{
+    return reinterpret_cast<StallDetector*>(
+        bslmt::ThreadUtil::getSpecific(StallDetectorState::s_global.d_key));
+}
+
+void StallDetectorUtil::createStallDetector(
+    bsl::shared_ptr<ntcs::StallDetector>*          result,
+    const bdlb::NullableValue<bsls::TimeInterval>& threshold,
+    const bsl::string&                             waiterMetricName,
+    const bsl::string&                             driverMetricName,
+    bsl::size_t                                    waiterIndex,
+    bslma::Allocator*                              basicAllocator)
+{
+    if (threshold.isNull()) {
+        return;
+    }
+
+    bslma::Allocator* allocator = bslma::Default::allocator(basicAllocator);
+
+    bsl::string objectName(allocator);
+    if (!waiterMetricName.empty()) {
+        objectName = waiterMetricName;
+    }
+    else {
+        bsl::stringstream ss;
+        ss << driverMetricName << "-" << waiterIndex;
+        objectName = ss.str();
+    }
+
+    result->createInplace(allocator,
+                          threshold.value(),
+                          "stall",
+                          objectName,
+                          allocator);
+
+    ntcs::MonitorableUtil::registerMonitorable(*result);
+}
+
+void StallDetectorUtil::destroyStallDetector(
+    const bsl::shared_ptr<ntcs::StallDetector>& stallDetector)
+{
+    if (stallDetector) {
+        ntcs::MonitorableUtil::deregisterMonitorable(stallDetector);
+    }
+}
+
+ntci::Executor::Functor StallDetectorUtil::attribute(
+    StallDetector::Callback                callback,
+    const ntci::Executor::Functor&         functor,
+    const bsl::weak_ptr<ntsi::Descriptor>& descriptor)
+{
+    if (!StallDetector::isEnabled() || !functor) {
+        return functor;
+    }
+
+    return bdlf::BindUtil::bind(&invokeAttributedFunction,
+                                callback,
+                                functor,
+                                descriptor);
+}
+
+void StallDetectorUtil::attribute(
+    ntci::Executor::FunctorSequence*       functorSequence,
+    const bsl::weak_ptr<ntsi::Descriptor>& descriptor)
+{
+    if (!StallDetector::isEnabled()) {
+        return;
+    }
+
+    for (ntci::Executor::FunctorSequence::iterator it =
+             functorSequence->begin();
+         it != functorSequence->end();
+         ++it)
+    {
+        *it = StallDetectorUtil::attribute(StallDetector::e_FUNCTION,
+                                           *it,
+                                           descriptor);
+    }
+}
+
+ntci::TimerCallback StallDetectorUtil::attribute(
+    const ntci::TimerCallback&             callback,
+    const bsl::weak_ptr<ntsi::Descriptor>& descriptor)
+{
+    if (!StallDetector::isEnabled() || !callback) {
+        return callback;
+    }
+
+    return ntci::TimerCallback(
+        bdlf::BindUtil::bind(&invokeAttributedTimer,
+                             callback,
+                             descriptor,
+                             bdlf::PlaceHolders::_1,
+                             bdlf::PlaceHolders::_2),
+        callback.strand(),
+        callback.allocator());
+}
+
+}  // close package namespace
+}  // close enterprise namespace
@@ -0,0 +1,432 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCS_STALLDETECTOR
+#define INCLUDED_NTCS_STALLDETECTOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntccfg_platform.h>
+#include <ntci_executor.h>
+#include <ntci_metric.h>
+#include <ntci_monitorable.h>
+#include <ntci_timercallback.h>
+#include <ntcscm_version.h>
+#include <ntsa_handle.h>
+#include <ntsi_descriptor.h>
+#include <bdlb_nullablevalue.h>
+#include <bsls_atomic.h>
+#include <bsls_compilerfeatures.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+/// @internal @brief
+/// Provide a detector of callbacks that stall an event loop.
+///
+/// @details
+/// A stall detector measures the duration of each callback dispatched by the
+/// thread running the event loop of a reactor or proactor waiter, and flags
+/// each callback that runs longer than a configurable threshold. Each stall
+/// is logged once, at the warning severity level, identifying the kind of
+/// callback, the handle of the socket to which the callback was dispatched,
+/// if any, the name under which the statistics of that socket are
+/// published, or, if they are not published separately, its object
+/// identifier, the name of the waiter, and the duration of the stall, and
+/// is counted in the statistics published by the stall detector.
+///
+/// Callbacks dispatched while another callback is running are attributed to
+/// the outermost callback, with one exception: the functions and timers of
+/// a socket, and the socket events announced on a strand, are deferred
+/// through the socket's strand or its reactor or proactor, and so are
+/// invoked by a callback to no particular socket. Such callbacks are
+/// wrapped by 'ntcs::StallDetectorUtil::attribute' to identify their
+/// socket, and are measured separately from the enclosing callback, which
+/// is not reported again if one of them stalled.
+///
+/// Callbacks are measured only while a stall detector is installed as the
+/// stall detector of the calling thread by a 'ntcs::StallDetectorScope'.
+/// Dispatch points such as 'ntcs::Dispatch' and 'ntcs::Chronology' guard
+/// each callback with a 'ntcs::StallDetectorGuard', which costs one read of
+/// a flag cached per thread when no stall detector is installed for the
+/// calling thread, and looks up the installed stall detector only when the
+/// flag is set. Where the compiler does not support 'thread_local', the
+/// flag is instead a count of the threads that have installed a stall
+/// detector.
+///
+/// A callback that has not yet returned cannot be logged by the thread
+/// running it, so each collection of the statistics of a stall detector also
+/// checks whether the current callback has exceeded the threshold, and, if
+/// so, logs that the event loop is stalled and publishes a gauge of 1. A
+/// stall logged this way is not logged again when the callback returns, but
+/// its final duration is still counted.
+///
+/// @par Thread Safety
+/// The manipulators that measure callbacks may only be called by the thread
+/// running the event loop. All other functions are thread safe.
+///
+/// @ingroup module_ntcs
+class StallDetector : public ntci::Monitorable,
+                      public ntccfg::Shared<StallDetector>
+{
+  public:
+    /// Enumerate the kinds of callbacks measured.
+    enum Callback {
+        /// No callback is running.
+        e_NONE,
+
+        /// A reactor socket is being notified that it is readable.
+        e_READABLE,
+
+        /// A reactor socket is being notified that it is writable.
+        e_WRITABLE,
+
+        /// A socket is being notified of an error.
+        e_ERROR,
+
+        /// A reactor socket is being notified of notifications.
+        e_NOTIFICATIONS,
+
+        /// A proactor socket is being notified of an accepted connection.
+        e_ACCEPTED,
+
+        /// A proactor socket is being notified of an established connection.
+        e_CONNECTED,
+
+        /// A proactor socket is being notified of received data.
+        e_RECEIVED,
+
+        /// A proactor socket is being notified of sent data.
+        e_SENT,
+
+        /// A deferred function is being invoked.
+        e_FUNCTION,
+
+        /// A timer is being notified of its deadline.
+        e_TIMER
+    };
+
+  private:
+    bsls::Types::Int64      d_threshold;
+    bsls::AtomicInt64       d_startTime;
+    bsls::AtomicInt         d_callback;
+    bsls::AtomicInt         d_handle;
+    bsls::AtomicBool        d_reported;
+    const ntsi::Descriptor* d_descriptor_p;
+    bsl::size_t             d_depth;
+    Callback                d_outerCallback;
+    bsls::Types::Int64      d_innerStartTime;
+    bool                    d_innerReported;
+    ntci::Metric            d_stallTime;
+    bsl::string             d_prefix;
+    bsl::string             d_objectName;
+    bslma::Allocator*       d_allocator_p;
+
+    static const struct ntci::MetricMetadata STATISTICS[];
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_THREAD_LOCAL)
+    static thread_local bool s_threadLocalEnabled;
+#else
+    static bsls::AtomicInt s_threadLocalCount;
+#endif
+
+    static bsls::AtomicInt s_count;
+
+  private:
+    StallDetector(const StallDetector&) BSLS_KEYWORD_DELETED;
+    StallDetector& operator=(const StallDetector&) BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Count a stall of the specified 'duration', in nanoseconds, and log
+    /// it unless it has already been logged.
+    void report(bsls::Types::Int64 duration);
+
+  public:
+    /// Create a new stall detector for the specified 'objectName' whose
+    /// field names have the specified 'prefix' and that flags each callback
+    /// that runs longer than the specified 'threshold'. Optionally specify
+    /// a 'basicAllocator' used to supply memory. If 'basicAllocator' is 0,
+    /// the currently installed default allocator is used.
+    StallDetector(const bsls::TimeInterval& threshold,
+                  const bslstl::StringRef&  prefix,
+                  const bslstl::StringRef&  objectName,
+                  bslma::Allocator*         basicAllocator = 0);
+
+    /// Destroy this object.
+    ~StallDetector() BSLS_KEYWORD_OVERRIDE;
+
+    /// Begin measuring a callback of the specified 'callback' kind
+    /// dispatched to the specified 'descriptor', if any. Return true if the
+    /// callback is the outermost callback, or is dispatched to a
+    /// 'descriptor' from within an outermost callback to no descriptor, and
+    /// so must be ended by a call to 'leave', otherwise return false. The
+    /// behavior is undefined unless 'descriptor', if any, remains valid
+    /// until the corresponding call to 'leave'.
+    bool enter(Callback callback, const ntsi::Descriptor* descriptor);
+
+    /// End measuring the callback most recently begun by a call to 'enter'
+    /// that returned true, and report it if it ran longer than the
+    /// threshold.
+    void leave();
+
+    /// Load into the specified 'result' the statistics measured since the
+    /// last call to this function.
+    void getStats(bdld::ManagedDatum* result) BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the prefix corresponding to the field at the specified
+    /// 'ordinal' position, or 0 if no field at the 'ordinal' position
+    /// exists.
+    const char* getFieldPrefix(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the field name corresponding to the field at the specified
+    /// 'ordinal' position, or 0 if no field at the 'ordinal' position
+    /// exists.
+    const char* getFieldName(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the field description corresponding to the field at the
+    /// specified 'ordinal' position, or 0 if no field at the 'ordinal'
+    /// position exists.
+    const char* getFieldDescription(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the type of the statistic at the specified 'ordinal'
+    /// position, or e_AVERAGE if no field at the 'ordinal' position exists
+    /// or the type is unknown.
+    ntci::Monitorable::StatisticType getFieldType(int ordinal) const
+        BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the flags that indicate which indexes to apply to the
+    /// statistics measured by this monitorable object.
+    int getFieldTags(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the ordinal of the specified 'fieldName', or a negative value
+    /// if no field identified by 'fieldName' exists.
+    int getFieldOrdinal(const char* fieldName) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the maximum number of elements in a datum resulting from
+    /// a call to 'getStats()'.
+    int numOrdinals() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the human-readable name of the monitorable object, or 0 or
+    /// the empty string if no such human-readable name has been assigned to
+    /// the monitorable object.
+    const char* objectName() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the threshold beyond which a callback is flagged as a stall.
+    bsls::TimeInterval threshold() const;
+
+    /// Return true if a callback is currently running longer than the
+    /// threshold, otherwise return false.
+    bool isStalled() const;
+
+    /// Return the string description of the specified 'callback' kind.
+    static const char* toString(Callback callback);
+
+    /// Set the stall detector of the calling thread to the specified
+    /// 'stallDetector'. Return the previous stall detector of the calling
+    /// thread.
+    static StallDetector* setThreadLocal(StallDetector* stallDetector);
+
+    /// Return the stall detector of the calling thread, or null if no stall
+    /// detector is installed for the calling thread.
+    static StallDetector* getThreadLocal();
+
+    /// Return true if a stall detector may be installed for the calling
+    /// thread, otherwise return false. This function is cheaper than
+    /// 'getThreadLocal', which need only be called if this function returns
+    /// true.
+    static bool hasThreadLocal();
+
+    /// Return true if any stall detector exists in this process, otherwise
+    /// return false.
+    static bool isEnabled();
+};
+
+/// @internal @brief
+/// Provide a guard to install a stall detector for the calling thread.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcs
+class StallDetectorScope
+{
+    StallDetector* d_previous_p;
+    bool           d_installed;
+
+  private:
+    StallDetectorScope(const StallDetectorScope&) BSLS_KEYWORD_DELETED;
+    StallDetectorScope& operator=(const StallDetectorScope&)
+        BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Install the specified 'stallDetector' as the stall detector of the
+    /// calling thread, if 'stallDetector' is not null.
+    explicit StallDetectorScope(StallDetector* stallDetector);
+
+    /// Restore the previous stall detector of the calling thread.
+    ~StallDetectorScope();
+};
+
+/// @internal @brief
+/// Provide a guard to measure a callback by the stall detector of the
+/// calling thread.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcs
+class StallDetectorGuard
+{
+    StallDetector* d_stallDetector_p;
+
+  private:
+    StallDetectorGuard(const StallDetectorGuard&) BSLS_KEYWORD_DELETED;
+    StallDetectorGuard& operator=(const StallDetectorGuard&)
+        BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Begin measuring a callback of the specified 'callback' kind
+    /// dispatched to the specified 'descriptor', if any, by the stall
+    /// detector of the calling thread, if any.
+    StallDetectorGuard(StallDetector::Callback callback,
+                       const ntsi::Descriptor* descriptor);
+
+    /// End measuring the callback.
+    ~StallDetectorGuard();
+};
+
+/// @internal @brief
+/// Provide utilities to manage the stall detector of a waiter.
+///
+/// @par Thread Safety
+/// This struct is thread safe.
+///
+/// @ingroup module_ntcs
+struct StallDetectorUtil {
+    /// Load into the specified 'result' a new stall detector flagging
+    /// callbacks that run longer than the specified 'threshold' for the
+    /// waiter having the specified 'waiterMetricName' and register it with
+    /// the default monitorable object registry. If 'waiterMetricName' is
+    /// empty, name the stall detector after the specified 'driverMetricName'
+    /// and 'waiterIndex'. If 'threshold' is null, leave 'result' unchanged.
+    /// Optionally specify a 'basicAllocator' used to supply memory. If
+    /// 'basicAllocator' is 0, the currently installed default allocator is
+    /// used.
+    static void createStallDetector(
+        bsl::shared_ptr<ntcs::StallDetector>*          result,
+        const bdlb::NullableValue<bsls::TimeInterval>& threshold,
+        const bsl::string&                             waiterMetricName,
+        const bsl::string&                             driverMetricName,
+        bsl::size_t                                    waiterIndex,
+        bslma::Allocator*                              basicAllocator = 0);
+
+    /// Deregister the specified 'stallDetector', if any, from the default
+    /// monitorable object registry.
+    static void destroyStallDetector(
+        const bsl::shared_ptr<ntcs::StallDetector>& stallDetector);
+
+    /// Return a function that invokes the specified 'functor' as a callback
+    /// of the specified 'callback' kind dispatched to the specified
+    /// 'descriptor', or to no descriptor once 'descriptor' is destroyed. If
+    /// no stall detector exists, or 'functor' is empty, return 'functor'.
+    static ntci::Executor::Functor attribute(
+        StallDetector::Callback                callback,
+        const ntci::Executor::Functor&         functor,
+        const bsl::weak_ptr<ntsi::Descriptor>& descriptor);
+
+    /// Replace each function in the specified 'functorSequence' with a
+    /// function that invokes it as a deferred function dispatched to the
+    /// specified 'descriptor', or to no descriptor once 'descriptor' is
+    /// destroyed. If no stall detector exists, leave 'functorSequence'
+    /// unchanged.
+    static void attribute(
+        ntci::Executor::FunctorSequence*       functorSequence,
+        const bsl::weak_ptr<ntsi::Descriptor>& descriptor);
+
+    /// Return a callback that invokes the specified 'callback', on the same
+    /// strand, as a timer dispatched to the specified 'descriptor', or to no
+    /// descriptor once 'descriptor' is destroyed. If no stall detector
+    /// exists, return 'callback'.
+    static ntci::TimerCallback attribute(
+        const ntci::TimerCallback&             callback,
+        const bsl::weak_ptr<ntsi::Descriptor>& descriptor);
+};
+
+NTCCFG_INLINE
+bool StallDetector::hasThreadLocal()
+{
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_THREAD_LOCAL)
+    return s_threadLocalEnabled;
+#else
+    return s_threadLocalCount.loadRelaxed() != 0;
+#endif
+}
+
+NTCCFG_INLINE
+bool StallDetector::isEnabled()
+{
+    return s_count.loadRelaxed() != 0;
+}
+
+NTCCFG_INLINE
+StallDetectorScope::StallDetectorScope(StallDetector* stallDetector)
+: d_previous_p(0)
+, d_installed(false)
+{
+    if (stallDetector != 0) {
+        d_previous_p = StallDetector::setThreadLocal(stallDetector);
+        d_installed  = true;
+    }
+}
+
+NTCCFG_INLINE
+StallDetectorScope::~StallDetectorScope()
+{
+    if (d_installed) {
+        StallDetector::setThreadLocal(d_previous_p);
+    }
+}
+
+NTCCFG_INLINE
+StallDetectorGuard::StallDetectorGuard(StallDetector::Callback callback,
+                                       const ntsi::Descriptor* descriptor)
+: d_stallDetector_p(0)
+{
+    if (StallDetector::hasThreadLocal()) {
+        d_stallDetector_p = StallDetector::getThreadLocal();
+        if (d_stallDetector_p != 0) {
+            if (!d_stallDetector_p->enter(callback, descriptor)) {
+                d_stallDetector_p = 0;
+            }
+        }
+    }
+}
+
+NTCCFG_INLINE
+StallDetectorGuard::~StallDetectorGuard()
+{
+    if (d_stallDetector_p != 0) {
+        d_stallDetector_p->leave();
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
@@ -0,0 +1,371 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_stalldetector_t_cpp, "$Id$ $CSID$")
+
+#include <ntcs_stalldetector.h>
+
+#include <ntci_identifiable.h>
+
+#include <bdld_datum.h>
+#include <bdld_manageddatum.h>
+#include <bdlf_bind.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+#include <bsl_cstring.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcs {
+
+// Provide tests for 'ntcs::StallDetector'.
+class StallDetectorTest
+{
+    // Describe a socket to which callbacks are dispatched.
+    class Socket;
+
+    // Return the value of the field of the specified 'stallDetector' having
+    // the specified 'fieldName' in the specified 'stats', or 0 if the value
+    // is null.
+    static double field(const ntcs::StallDetector& stallDetector,
+                        const bdld::ManagedDatum&  stats,
+                        const char*                fieldName);
+
+    // Run a callback dispatched to the specified 'socket' on a thread that
+    // has installed the specified 'stallDetector' that posts to the
+    // specified 'started' semaphore then waits on the specified 'resume'
+    // semaphore.
+    static void runStalledCallback(ntcs::StallDetector* stallDetector,
+                                   const Socket*        socket,
+                                   bslmt::Semaphore*    started,
+                                   bslmt::Semaphore*    resume);
+
+    // Sleep for the specified 'milliseconds'.
+    static void sleep(int milliseconds);
+
+  public:
+    // Concern: Callbacks running longer than the threshold are counted, and
+    // callbacks running shorter than the threshold are not.
+    static void verifyThreshold();
+
+    // Concern: Nested callbacks are attributed to the outermost callback.
+    static void verifyNesting();
+
+    // Concern: Functions attributed to a socket and run by a callback to no
+    // socket are measured separately, and a stall is reported once.
+    static void verifyAttribution();
+
+    // Concern: Callbacks are not measured on threads that have not
+    // installed a stall detector.
+    static void verifyScope();
+
+    // Concern: A callback that has not yet returned is detected by the
+    // collection of statistics.
+    static void verifyInProgress();
+};
+
+class StallDetectorTest::Socket : public ntsi::Descriptor,
+                                  public ntci::Identifiable
+{
+    ntsa::Handle d_handle;
+
+  private:
+    Socket(const Socket&) BSLS_KEYWORD_DELETED;
+    Socket& operator=(const Socket&) BSLS_KEYWORD_DELETED;
+
+  public:
+    // Create a new socket having the specified 'handle'.
+    explicit Socket(ntsa::Handle handle)
+    : d_handle(handle)
+    {
+    }
+
+    // Return the handle of this socket.
+    ntsa::Handle handle() const BSLS_KEYWORD_OVERRIDE
+    {
+        return d_handle;
+    }
+};
+
+double StallDetectorTest::field(const ntcs::StallDetector& stallDetector,
+                                const bdld::ManagedDatum&  stats,
+                                const char*                fieldName)
+{
+    const bdld::DatumArrayRef array = stats.datum().theArray();
+
+    for (int i = 0; i < stallDetector.numOrdinals(); ++i) {
+        if (bsl::strcmp(stallDetector.getFieldName(i), fieldName) == 0) {
+            return array[i].isNull() ? 0 : array[i].theDouble();
+        }
+    }
+
+    NTSCFG_TEST_TRUE(false);
+    return 0;
+}
+
+void StallDetectorTest::runStalledCallback(ntcs::StallDetector* stallDetector,
+                                           const Socket*        socket,
+                                           bslmt::Semaphore*    started,
+                                           bslmt::Semaphore*    resume)
+{
+    ntcs::StallDetectorScope scope(stallDetector);
+
+    ntcs::StallDetectorGuard guard(ntcs::StallDetector::e_READABLE, socket);
+
+    started->post();
+    resume->wait();
+}
+
+void StallDetectorTest::sleep(int milliseconds)
+{
+    bslmt::ThreadUtil::microSleep(milliseconds * 1000);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::StallDetectorTest::verifyThreshold)
+{
+    ntcs::StallDetector stallDetector(bsls::TimeInterval(0.01),
+                                      "stall",
+                                      "test",
+                                      NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_EQ(stallDetector.threshold(), bsls::TimeInterval(0.01));
+
+    Socket socket(10);
+
+    ntcs::StallDetectorScope scope(&stallDetector);
+
+    {
+        ntcs::StallDetectorGuard guard(ntcs::StallDetector::e_READABLE,
+                                       &socket);
+    }
+
+    {
+        ntcs::StallDetectorGuard guard(ntcs::StallDetector::e_WRITABLE,
+                                       &socket);
+        bslmt::ThreadUtil::microSleep(50 * 1000);
+    }
+
+    {
+        ntcs::StallDetectorGuard guard(ntcs::StallDetector::e_FUNCTION, 0);
+        bslmt::ThreadUtil::microSleep(50 * 1000);
+    }
+
+    bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+    stallDetector.getStats(&stats);
+
+    NTSCFG_TEST_EQ(field(stallDetector, stats, "stallTime.count"), 2);
+    NTSCFG_TEST_GT(field(stallDetector, stats, "stallTime.min"), 10 * 1000);
+    NTSCFG_TEST_EQ(field(stallDetector, stats, "stalled.current"), 0);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::StallDetectorTest::verifyNesting)
+{
+    ntcs::StallDetector stallDetector(bsls::TimeInterval(0.01),
+                                      "stall",
+                                      "test",
+                                      NTSCFG_TEST_ALLOCATOR);
+
+    Socket socket(10);
+
+    ntcs::StallDetectorScope scope(&stallDetector);
+
+    {
+        ntcs::StallDetectorGuard outer(ntcs::StallDetector::e_READABLE,
+                                       &socket);
+        {
+            ntcs::StallDetectorGuard inner(ntcs::StallDetector::e_FUNCTION,
+                                           0);
+            bslmt::ThreadUtil::microSleep(50 * 1000);
+        }
+    }
+
+    bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+    stallDetector.getStats(&stats);
+
+    NTSCFG_TEST_EQ(field(stallDetector, stats, "stallTime.count"), 1);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::StallDetectorTest::verifyAttribution)
+{
+    ntcs::StallDetector stallDetector(bsls::TimeInterval(0.01),
+                                      "stall",
+                                      "test",
+                                      NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_TRUE(ntcs::StallDetector::isEnabled());
+
+    bsl::shared_ptr<Socket> socket;
+    socket.createInplace(NTSCFG_TEST_ALLOCATOR, 10);
+
+    ntcs::StallDetectorScope scope(&stallDetector);
+
+    // A stalled function attributed to the socket is reported once, not
+    // again by the enclosing callback.
+
+    {
+        ntci::Executor::Functor functor = ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_FUNCTION,
+            bdlf::BindUtil::bind(&StallDetectorTest::sleep, 50),
+            socket);
+
+        ntcs::StallDetectorGuard outer(ntcs::StallDetector::e_FUNCTION, 0);
+        functor();
+    }
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        stallDetector.getStats(&stats);
+
+        NTSCFG_TEST_EQ(field(stallDetector, stats, "stallTime.count"), 1);
+    }
+
+    // Functions that each run shorter than the threshold are not reported,
+    // but the enclosing callback that runs them all is.
+
+    {
+        ntci::Executor::FunctorSequence functorSequence(NTSCFG_TEST_ALLOCATOR);
+        functorSequence.push_back(
+            bdlf::BindUtil::bind(&StallDetectorTest::sleep, 8));
+        functorSequence.push_back(
+            bdlf::BindUtil::bind(&StallDetectorTest::sleep, 8));
+
+        ntcs::StallDetectorUtil::attribute(&functorSequence, socket);
+
+        ntcs::StallDetectorGuard outer(ntcs::StallDetector::e_FUNCTION, 0);
+        for (ntci::Executor::FunctorSequence::iterator it =
+                 functorSequence.begin();
+             it != functorSequence.end();
+             ++it)
+        {
+            (*it)();
+        }
+    }
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        stallDetector.getStats(&stats);
+
+        NTSCFG_TEST_EQ(field(stallDetector, stats, "stallTime.count"), 1);
+    }
+
+    // A function attributed to a socket that has been destroyed is
+    // attributed to the enclosing callback.
+
+    {
+        ntci::Executor::Functor functor = ntcs::StallDetectorUtil::attribute(
+            ntcs::StallDetector::e_FUNCTION,
+            bdlf::BindUtil::bind(&StallDetectorTest::sleep, 50),
+            socket);
+
+        socket.reset();
+
+        ntcs::StallDetectorGuard outer(ntcs::StallDetector::e_FUNCTION, 0);
+        functor();
+    }
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        stallDetector.getStats(&stats);
+
+        NTSCFG_TEST_EQ(field(stallDetector, stats, "stallTime.count"), 1);
+        NTSCFG_TEST_EQ(field(stallDetector, stats, "stalled.current"), 0);
+    }
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::StallDetectorTest::verifyScope)
+{
+    ntcs::StallDetector stallDetector(bsls::TimeInterval(0.01),
+                                      "stall",
+                                      "test",
+                                      NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_TRUE(ntcs::StallDetector::getThreadLocal() == 0);
+    NTSCFG_TEST_FALSE(ntcs::StallDetector::hasThreadLocal());
+
+    {
+        ntcs::StallDetectorScope scope(&stallDetector);
+        NTSCFG_TEST_TRUE(ntcs::StallDetector::getThreadLocal() ==
+                         &stallDetector);
+        NTSCFG_TEST_TRUE(ntcs::StallDetector::hasThreadLocal());
+    }
+
+    NTSCFG_TEST_TRUE(ntcs::StallDetector::getThreadLocal() == 0);
+    NTSCFG_TEST_FALSE(ntcs::StallDetector::hasThreadLocal());
+
+    {
+        ntcs::StallDetectorGuard guard(ntcs::StallDetector::e_TIMER, 0);
+        bslmt::ThreadUtil::microSleep(50 * 1000);
+    }
+
+    bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+    stallDetector.getStats(&stats);
+
+    NTSCFG_TEST_EQ(field(stallDetector, stats, "stallTime.count"), 0);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::StallDetectorTest::verifyInProgress)
+{
+    ntcs::StallDetector stallDetector(bsls::TimeInterval(0.01),
+                                      "stall",
+                                      "test",
+                                      NTSCFG_TEST_ALLOCATOR);
+
+    Socket socket(10);
+
+    bslmt::Semaphore started;
+    bslmt::Semaphore resume;
+
+    bslmt::ThreadGroup threadGroup(NTSCFG_TEST_ALLOCATOR);
+    threadGroup.addThread(
+        bdlf::BindUtil::bind(&StallDetectorTest::runStalledCallback,
+                             &stallDetector,
+                             &socket,
+                             &started,
+                             &resume));
+
+    started.wait();
+
+    bslmt::ThreadUtil::microSleep(50 * 1000);
+
+    NTSCFG_TEST_TRUE(stallDetector.isStalled());
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        stallDetector.getStats(&stats);
+
+        NTSCFG_TEST_EQ(field(stallDetector, stats, "stalled.current"), 1);
+    }
+
+    resume.post();
+    threadGroup.joinAll();
+
+    NTSCFG_TEST_FALSE(stallDetector.isStalled());
+
+    {
+        bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+        stallDetector.getStats(&stats);
+
+        NTSCFG_TEST_EQ(field(stallDetector, stats, "stallTime.count"), 1);
+        NTSCFG_TEST_EQ(field(stallDetector, stats, "stalled.current"), 0);
+    }
+}
+
+}  // close namespace ntcs
+}  // close namespace BloombergLP
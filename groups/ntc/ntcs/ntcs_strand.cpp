@@ -20,6 +20,7 @@ BSLS_IDENT_RCSID(ntcs_strand_cpp, "$Id$ $CSID$")
 
 #include <ntccfg_bind.h>
 #include <ntcs_async.h>
+#include <ntcs_tracer.h>
 #include <bdlb_nullablevalue.h>
 #include <bdlf_bind.h>
 #include <bdlf_memfn.h>
@@ -134,6 +135,7 @@ void Strand::invoke()
             ntci::StrandGuard strandGuard(this);
 
             while (it != et) {
+                NTCS_TRACE_SCOPE(e_STRAND, ntsa::k_INVALID_HANDLE, 0);
                 (*it)();
                 ++it;
             }
@@ -164,6 +166,7 @@ void Strand::invoke()
     {
         ntci::StrandGuard strandGuard(this);
 
+        NTCS_TRACE_SCOPE(e_STRAND, ntsa::k_INVALID_HANDLE, 0);
         functor();
     }
 
@@ -290,6 +293,7 @@ void Strand::drain()
             ntci::StrandGuard strandGuard(this);
 
             while (it != et) {
+                NTCS_TRACE_SCOPE(e_STRAND, ntsa::k_INVALID_HANDLE, 0);
                 (*it)();
                 ++it;
             }
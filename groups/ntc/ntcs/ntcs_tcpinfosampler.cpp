@@ -0,0 +1,88 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcs_tcpinfosampler.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_tcpinfosampler_cpp, "$Id$ $CSID$")
+
+#include <ntsu_socketoptionutil.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+TcpInfoSampler::TcpInfoSampler()
+: d_interval(static_cast<bsls::Types::Int64>(
+                 NTCCFG_DEFAULT_STREAM_SOCKET_TCP_INFO_INTERVAL) *
+             1000 * 1000)
+, d_deadline(0)
+, d_retransmissions(0)
+, d_enabled(true)
+{
+}
+
+TcpInfoSampler::TcpInfoSampler(const bsls::TimeInterval& interval)
+: d_interval(interval.totalNanoseconds())
+, d_deadline(0)
+, d_retransmissions(0)
+, d_enabled(true)
+{
+}
+
+TcpInfoSampler::~TcpInfoSampler()
+{
+}
+
+void TcpInfoSampler::reset()
+{
+    d_deadline        = 0;
+    d_retransmissions = 0;
+    d_enabled         = true;
+}
+
+ntsa::Error TcpInfoSampler::sample(ntsa::Handle socket, ntcs::Metrics* metrics)
+{
+    ntsa::TcpInfo tcpInfo;
+    ntsa::Error   error = ntsu::SocketOptionUtil::getTcpInfo(&tcpInfo, socket);
+    if (error) {
+        if (error == ntsa::Error::e_NOT_IMPLEMENTED) {
+            d_enabled = false;
+        }
+
+        return error;
+    }
+
+    bsl::uint64_t numRetransmissions = 0;
+    if (tcpInfo.retransmissions() > d_retransmissions) {
+        numRetransmissions = tcpInfo.retransmissions() - d_retransmissions;
+    }
+
+    d_retransmissions = tcpInfo.retransmissions();
+
+    metrics->logTcpInfo(tcpInfo);
+    metrics->logTcpRetransmissions(numRetransmissions);
+
+    return ntsa::Error();
+}
+
+bsls::TimeInterval TcpInfoSampler::interval() const
+{
+    bsls::TimeInterval result;
+    result.setTotalNanoseconds(d_interval);
+    return result;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
@@ -0,0 +1,150 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCS_TCPINFOSAMPLER
+#define INCLUDED_NTCS_TCPINFOSAMPLER
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntccfg_limits.h>
+#include <ntccfg_platform.h>
+#include <ntcs_metrics.h>
+#include <ntcscm_version.h>
+#include <ntsa_error.h>
+#include <ntsa_handle.h>
+#include <ntsa_tcpinfo.h>
+#include <bsls_timeinterval.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+/// @internal @brief
+/// Provide a rate-limited sampler of the TCP state of a stream socket.
+///
+/// @details
+/// Provide a mechanism to periodically sample the round trip time,
+/// congestion window, unacknowledged bytes, retransmissions, and delivery
+/// and pacing rates of a TCP connection and log each sample to the metrics
+/// of the socket, which aggregate the sample into the metrics of their
+/// parent. The sampler is polled from the paths that complete each send and
+/// receive, and from a periodic timer of the socket so that a connection is
+/// also sampled while it is idle or stalled, which is when its round trip
+/// time and retransmissions are most telling. Polling reads the
+/// high-resolution timer and samples the connection at most once per
+/// sampling interval, regardless of which path polls it. Retransmissions
+/// are reported by the operating system as a running total for the lifetime
+/// of the connection; the sampler logs the number of retransmissions since
+/// its previous sample.
+///
+/// If the operating system does not support sampling the connection, or
+/// the socket is not a TCP socket, the first sample fails with
+/// 'ntsa::Error::e_NOT_IMPLEMENTED' and the sampler disables itself so that
+/// subsequent polls have no cost beyond a branch. Any other failure, such
+/// as a transient error reported by the operating system, skips only that
+/// sample.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcs
+class TcpInfoSampler
+{
+    bsls::Types::Int64 d_interval;
+    bsls::Types::Int64 d_deadline;
+    bsl::uint64_t      d_retransmissions;
+    bool               d_enabled;
+
+  private:
+    TcpInfoSampler(const TcpInfoSampler&) BSLS_KEYWORD_DELETED;
+    TcpInfoSampler& operator=(const TcpInfoSampler&) BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Create a new sampler that samples a connection at most once every
+    /// NTCCFG_DEFAULT_STREAM_SOCKET_TCP_INFO_INTERVAL milliseconds.
+    TcpInfoSampler();
+
+    /// Create a new sampler that samples a connection at most once every
+    /// specified 'interval'.
+    explicit TcpInfoSampler(const bsls::TimeInterval& interval);
+
+    /// Destroy this object.
+    ~TcpInfoSampler();
+
+    /// Reset the state of this sampler so that it samples a new connection
+    /// the next time it is polled.
+    void reset();
+
+    /// Sample the specified 'socket' and log the sample to the specified
+    /// 'metrics' if this sampler is enabled and the sampling interval has
+    /// elapsed since the previous sample.
+    void poll(ntsa::Handle socket, ntcs::Metrics* metrics);
+
+    /// Sample the specified 'socket' and log the sample to the specified
+    /// 'metrics'. Return the error. Note that this sampler is disabled if
+    /// the sample fails because sampling is not supported.
+    ntsa::Error sample(ntsa::Handle socket, ntcs::Metrics* metrics);
+
+    /// Return the minimum interval between samples.
+    bsls::TimeInterval interval() const;
+
+    /// Return true if this sampler samples the connection when polled,
+    /// otherwise return false.
+    bool isEnabled() const;
+};
+
+#if NTC_BUILD_WITH_METRICS
+
+#define NTCS_METRICS_UPDATE_TCP_INFO(sampler, socket)                         \
+    do {                                                                      \
+        if (d_metrics_sp) {                                                   \
+            (sampler).poll((socket), d_metrics_sp.get());                     \
+        }                                                                     \
+    } while (false)
+
+#else
+
+#define NTCS_METRICS_UPDATE_TCP_INFO(sampler, socket)
+
+#endif
+
+NTCCFG_INLINE
+void TcpInfoSampler::poll(ntsa::Handle socket, ntcs::Metrics* metrics)
+{
+    if (NTCCFG_UNLIKELY(!d_enabled)) {
+        return;
+    }
+
+    const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+    if (NTCCFG_LIKELY(now < d_deadline)) {
+        return;
+    }
+
+    d_deadline = now + d_interval;
+
+    this->sample(socket, metrics);
+}
+
+NTCCFG_INLINE
+bool TcpInfoSampler::isEnabled() const
+{
+    return d_enabled;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
@@ -0,0 +1,233 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_tcpinfosampler_t_cpp, "$Id$ $CSID$")
+
+#include <ntcs_tcpinfosampler.h>
+
+#include <ntsu_adapterutil.h>
+#include <ntsu_socketutil.h>
+#include <bdld_manageddatum.h>
+#include <bsls_platform.h>
+#include <bsl_cstring.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcs {
+
+// Provide tests for 'ntcs::TcpInfoSampler'.
+class TcpInfoSamplerTest
+{
+    // Return the number of samples of the congestion window recorded by
+    // the specified 'metrics' since their previous collection.
+    static double countSamples(ntcs::Metrics* metrics);
+
+  public:
+    // Concern: Sampling a connected TCP socket logs the sample to the
+    // metrics of the socket and to the metrics of its parent.
+    static void verifySample();
+
+    // Concern: Polling samples a connection at most once per interval.
+    static void verifyPoll();
+
+    // Concern: A failure to sample a socket because sampling is not
+    // supported disables the sampler until it is reset, and any other
+    // failure does not.
+    static void verifyDisable();
+};
+
+double TcpInfoSamplerTest::countSamples(ntcs::Metrics* metrics)
+{
+    int ordinal = -1;
+    for (int i = 0; i < metrics->numOrdinals(); ++i) {
+        if (bsl::strcmp(metrics->getFieldName(i),
+                        "tcpCongestionWindow.count") == 0)
+        {
+            ordinal = i;
+        }
+    }
+
+    NTSCFG_TEST_GE(ordinal, 0);
+
+    bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+    metrics->getStats(&stats);
+
+    const bdld::DatumArrayRef array = stats.datum().theArray();
+
+    if (array[ordinal].isNull()) {
+        return 0;
+    }
+
+    return array[ordinal].theDouble();
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::TcpInfoSamplerTest::verifySample)
+{
+    if (!ntsu::AdapterUtil::supportsIpv4Loopback()) {
+        return;
+    }
+
+    ntsa::Error error;
+
+    ntsa::Handle client = ntsa::k_INVALID_HANDLE;
+    ntsa::Handle server = ntsa::k_INVALID_HANDLE;
+
+    error = ntsu::SocketUtil::pair(&client,
+                                   &server,
+                                   ntsa::Transport::e_TCP_IPV4_STREAM);
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcs::Metrics> parent;
+    parent.createInplace(NTSCFG_TEST_ALLOCATOR,
+                         "transport",
+                         "test",
+                         NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcs::Metrics> clientMetrics;
+    clientMetrics.createInplace(NTSCFG_TEST_ALLOCATOR,
+                                "socket",
+                                parent,
+                                NTSCFG_TEST_ALLOCATOR);
+
+    bsl::shared_ptr<ntcs::Metrics> serverMetrics;
+    serverMetrics.createInplace(NTSCFG_TEST_ALLOCATOR,
+                                "socket",
+                                parent,
+                                NTSCFG_TEST_ALLOCATOR);
+
+    ntcs::TcpInfoSampler clientSampler;
+    ntcs::TcpInfoSampler serverSampler;
+
+    error = clientSampler.sample(client, clientMetrics.get());
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    NTSCFG_TEST_OK(error);
+
+    error = serverSampler.sample(server, serverMetrics.get());
+    NTSCFG_TEST_OK(error);
+
+    NTSCFG_TEST_EQ(countSamples(clientMetrics.get()), 1);
+    NTSCFG_TEST_EQ(countSamples(serverMetrics.get()), 1);
+
+    // The parent aggregates the distribution of samples across each socket.
+
+    NTSCFG_TEST_EQ(countSamples(parent.get()), 2);
+#else
+    NTSCFG_TEST_ERROR(error, ntsa::Error::e_NOT_IMPLEMENTED);
+    NTSCFG_TEST_FALSE(clientSampler.isEnabled());
+#endif
+
+    error = ntsu::SocketUtil::close(client);
+    NTSCFG_TEST_OK(error);
+
+    error = ntsu::SocketUtil::close(server);
+    NTSCFG_TEST_OK(error);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::TcpInfoSamplerTest::verifyPoll)
+{
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    if (!ntsu::AdapterUtil::supportsIpv4Loopback()) {
+        return;
+    }
+
+    ntsa::Error error;
+
+    ntsa::Handle client = ntsa::k_INVALID_HANDLE;
+    ntsa::Handle server = ntsa::k_INVALID_HANDLE;
+
+    error = ntsu::SocketUtil::pair(&client,
+                                   &server,
+                                   ntsa::Transport::e_TCP_IPV4_STREAM);
+    NTSCFG_TEST_OK(error);
+
+    bsl::shared_ptr<ntcs::Metrics> metrics;
+    metrics.createInplace(NTSCFG_TEST_ALLOCATOR,
+                          "socket",
+                          "test",
+                          NTSCFG_TEST_ALLOCATOR);
+
+    ntcs::TcpInfoSampler sampler(bsls::TimeInterval(3600, 0));
+    NTSCFG_TEST_EQ(sampler.interval(), bsls::TimeInterval(3600, 0));
+
+    for (bsl::size_t i = 0; i < 100; ++i) {
+        sampler.poll(client, metrics.get());
+    }
+
+    NTSCFG_TEST_TRUE(sampler.isEnabled());
+    NTSCFG_TEST_EQ(countSamples(metrics.get()), 1);
+
+    sampler.reset();
+    sampler.poll(client, metrics.get());
+
+    NTSCFG_TEST_EQ(countSamples(metrics.get()), 1);
+
+    error = ntsu::SocketUtil::close(client);
+    NTSCFG_TEST_OK(error);
+
+    error = ntsu::SocketUtil::close(server);
+    NTSCFG_TEST_OK(error);
+#endif
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::TcpInfoSamplerTest::verifyDisable)
+{
+    bsl::shared_ptr<ntcs::Metrics> metrics;
+    metrics.createInplace(NTSCFG_TEST_ALLOCATOR,
+                          "socket",
+                          "test",
+                          NTSCFG_TEST_ALLOCATOR);
+
+    ntcs::TcpInfoSampler sampler;
+    NTSCFG_TEST_TRUE(sampler.isEnabled());
+
+    ntsa::Error error = sampler.sample(ntsa::k_INVALID_HANDLE, metrics.get());
+    NTSCFG_TEST_TRUE(error);
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    NTSCFG_TEST_TRUE(sampler.isEnabled());
+
+    if (!ntsu::AdapterUtil::supportsIpv4Loopback()) {
+        return;
+    }
+
+    ntsa::Handle socket = ntsa::k_INVALID_HANDLE;
+
+    error = ntsu::SocketUtil::create(&socket,
+                                     ntsa::Transport::e_UDP_IPV4_DATAGRAM);
+    NTSCFG_TEST_OK(error);
+
+    error = sampler.sample(socket, metrics.get());
+    NTSCFG_TEST_ERROR(error, ntsa::Error::e_NOT_IMPLEMENTED);
+
+    error = ntsu::SocketUtil::close(socket);
+    NTSCFG_TEST_OK(error);
+#endif
+
+    NTSCFG_TEST_FALSE(sampler.isEnabled());
+
+    sampler.poll(ntsa::k_INVALID_HANDLE, metrics.get());
+    NTSCFG_TEST_EQ(countSamples(metrics.get()), 0);
+
+    sampler.reset();
+    NTSCFG_TEST_TRUE(sampler.isEnabled());
+}
+
+}  // close namespace ntcs
+}  // close namespace BloombergLP
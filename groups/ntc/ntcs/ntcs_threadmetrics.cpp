@@ -0,0 +1,255 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcs_threadmetrics.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_threadmetrics_cpp, "$Id$ $CSID$")
+
+#include <ntcs_processutil.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslmt_lockguard.h>
+#include <bsls_assert.h>
+#include <bsls_systemtime.h>
+#include <bsl_cstring.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+namespace {
+
+/// The resolution of the utilization stored as an integer.
+const double k_UTILIZATION_SCALE = 1000000.0;
+
+}  // close unnamed namespace
+
+const ntci::MetricMetadata ThreadMetrics::STATISTICS[] = {
+    NTCI_METRIC_METADATA_TOTAL(cpuTimeUser),
+    NTCI_METRIC_METADATA_TOTAL(cpuTimeSystem),
+    NTCI_METRIC_METADATA_TOTAL(contextSwitchesUser),
+    NTCI_METRIC_METADATA_TOTAL(contextSwitchesSystem),
+    NTCI_METRIC_METADATA_TOTAL(schedulingDelay),
+    NTCI_METRIC_METADATA_GAUGE(utilization),
+};
+
+ntsa::Error ThreadMetrics::collect()
+{
+    ntcs::ThreadStatistics current;
+    ntsa::Error            error =
+        ntcs::ProcessUtil::getThreadResourceUsage(&current, d_threadId);
+    if (error) {
+        return error;
+    }
+
+    const bsls::TimeInterval now = bsls::SystemTime::nowMonotonicClock();
+
+    bsls::TimeInterval cpuTime;
+
+    if (!current.cpuTimeUser().isNull()) {
+        d_cpuTimeUser.update(
+            current.cpuTimeUser().value().totalSecondsAsDouble());
+        cpuTime += current.cpuTimeUser().value();
+    }
+
+    if (!current.cpuTimeSystem().isNull()) {
+        d_cpuTimeSystem.update(
+            current.cpuTimeSystem().value().totalSecondsAsDouble());
+        cpuTime += current.cpuTimeSystem().value();
+    }
+
+    if (!current.contextSwitchesUser().isNull()) {
+        d_contextSwitchesUser.update(
+            static_cast<double>(current.contextSwitchesUser().value()));
+    }
+
+    if (!current.contextSwitchesSystem().isNull()) {
+        d_contextSwitchesSystem.update(
+            static_cast<double>(current.contextSwitchesSystem().value()));
+    }
+
+    if (!current.schedulingDelay().isNull()) {
+        d_schedulingDelay.update(
+            current.schedulingDelay().value().totalSecondsAsDouble());
+    }
+
+    // Derive the fraction of one CPU consumed by the thread since the
+    // previous collection.
+
+    if (d_lastTime != bsls::TimeInterval() && now > d_lastTime &&
+        cpuTime >= d_lastCpuTime)
+    {
+        double utilization = (cpuTime - d_lastCpuTime).totalSecondsAsDouble() /
+                             (now - d_lastTime).totalSecondsAsDouble();
+
+        if (utilization > 1.0) {
+            utilization = 1.0;
+        }
+
+        d_utilization.update(utilization);
+
+        d_lastUtilization.storeRelaxed(
+            static_cast<bsls::Types::Uint64>(utilization *
+                                             k_UTILIZATION_SCALE));
+    }
+
+    d_lastTime    = now;
+    d_lastCpuTime = cpuTime;
+
+    return ntsa::Error();
+}
+
+ThreadMetrics::ThreadMetrics(const bslstl::StringRef& prefix,
+                             const bslstl::StringRef& objectName,
+                             bslma::Allocator*        basicAllocator)
+: d_mutex()
+, d_threadId(ntcs::ProcessUtil::getThreadId())
+, d_supported(true)
+, d_cpuTimeUser()
+, d_cpuTimeSystem()
+, d_contextSwitchesUser()
+, d_contextSwitchesSystem()
+, d_schedulingDelay()
+, d_utilization()
+, d_lastTime()
+, d_lastCpuTime()
+, d_lastUtilization(0)
+, d_prefix(prefix, basicAllocator)
+, d_objectName(objectName, basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    ntsa::Error error = this->collect();
+    if (error == ntsa::Error::e_NOT_IMPLEMENTED) {
+        d_supported = false;
+    }
+}
+
+ThreadMetrics::~ThreadMetrics()
+{
+}
+
+int ThreadMetrics::threadId() const
+{
+    return d_threadId;
+}
+
+bool ThreadMetrics::isSupported() const
+{
+    return d_supported;
+}
+
+double ThreadMetrics::utilization() const
+{
+    return static_cast<double>(d_lastUtilization.loadRelaxed()) /
+           k_UTILIZATION_SCALE;
+}
+
+void ThreadMetrics::getStats(bdld::ManagedDatum* result)
+{
+    LockGuard guard(&d_mutex);
+
+    if (d_supported) {
+        this->collect();
+    }
+
+    bdld::DatumMutableArrayRef array;
+    bdld::Datum::createUninitializedArray(&array,
+                                          numOrdinals(),
+                                          result->allocator());
+
+    bsl::size_t index = 0;
+
+    d_cpuTimeUser.collectTotal(&array, &index);
+    d_cpuTimeSystem.collectTotal(&array, &index);
+    d_contextSwitchesUser.collectTotal(&array, &index);
+    d_contextSwitchesSystem.collectTotal(&array, &index);
+    d_schedulingDelay.collectTotal(&array, &index);
+    d_utilization.collectLast(&array, &index);
+
+    *array.length() = numOrdinals();
+
+    result->adopt(bdld::Datum::adoptArray(array));
+}
+
+const char* ThreadMetrics::getFieldPrefix(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return d_prefix.c_str();
+}
+
+const char* ThreadMetrics::getFieldName(int ordinal) const
+{
+    if (ordinal < numOrdinals()) {
+        return ThreadMetrics::STATISTICS[ordinal].d_name;
+    }
+    else {
+        return 0;
+    }
+}
+
+const char* ThreadMetrics::getFieldDescription(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return "";
+}
+
+ntci::Monitorable::StatisticType ThreadMetrics::getFieldType(
+    int ordinal) const
+{
+    if (ordinal < numOrdinals()) {
+        return ThreadMetrics::STATISTICS[ordinal].d_type;
+    }
+    else {
+        return ntci::Monitorable::e_AVERAGE;
+    }
+}
+
+int ThreadMetrics::getFieldTags(int ordinal) const
+{
+    NTCCFG_WARNING_UNUSED(ordinal);
+
+    return ntci::Monitorable::e_ANONYMOUS;
+}
+
+int ThreadMetrics::getFieldOrdinal(const char* fieldName) const
+{
+    int result = -1;
+
+    for (int ordinal = 0; ordinal < numOrdinals(); ++ordinal) {
+        if (bsl::strcmp(ThreadMetrics::STATISTICS[ordinal].d_name,
+                        fieldName) == 0)
+        {
+            result = ordinal;
+        }
+    }
+
+    return result;
+}
+
+int ThreadMetrics::numOrdinals() const
+{
+    return sizeof ThreadMetrics::STATISTICS /
+           sizeof ThreadMetrics::STATISTICS[0];
+}
+
+const char* ThreadMetrics::objectName() const
+{
+    return d_objectName.c_str();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
@@ -0,0 +1,174 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCS_THREADMETRICS
+#define INCLUDED_NTCS_THREADMETRICS
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntccfg_platform.h>
+#include <ntci_metric.h>
+#include <ntci_monitorable.h>
+#include <ntcs_threadstatistics.h>
+#include <ntcscm_version.h>
+#include <ntsa_error.h>
+#include <bsls_atomic.h>
+#include <bsls_timeinterval.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+/// @internal @brief
+/// Provide metrics for the runtime behavior of a thread.
+///
+/// @details
+/// Provide a monitorable object that measures the CPU time, context
+/// switches, and scheduling delay of the thread that creates it, and derives
+/// the utilization of that thread: the fraction of one CPU the thread has
+/// consumed since the previous collection. A thread that is saturated has a
+/// utilization approaching one; a thread that is frequently preempted has a
+/// high rate of involuntary context switches and a high scheduling delay.
+///
+/// The statistics of the thread are collected from whichever thread
+/// collects the statistics of this object, including the thread that
+/// creates it, always from the files describing the thread in the '/proc'
+/// filesystem, so that every sample is measured in the same units. On
+/// platforms other than Linux, the statistics are not supported: this
+/// object reports zero for each statistic and 'isSupported()' returns
+/// false.
+///
+/// @par Thread Safety
+/// This class is thread safe.
+///
+/// @ingroup module_ntcs
+class ThreadMetrics : public ntci::Monitorable,
+                      public ntccfg::Shared<ThreadMetrics>
+{
+    /// Define a type alias for a mutex.
+    typedef ntccfg::Mutex Mutex;
+
+    /// Define a type alias for a mutex lock guard.
+    typedef ntccfg::LockGuard LockGuard;
+
+    mutable Mutex      d_mutex;
+    int                d_threadId;
+    bool               d_supported;
+    ntci::MetricTotal  d_cpuTimeUser;
+    ntci::MetricTotal  d_cpuTimeSystem;
+    ntci::MetricTotal  d_contextSwitchesUser;
+    ntci::MetricTotal  d_contextSwitchesSystem;
+    ntci::MetricTotal  d_schedulingDelay;
+    ntci::MetricGauge  d_utilization;
+    bsls::TimeInterval d_lastTime;
+    bsls::TimeInterval d_lastCpuTime;
+    bsls::AtomicUint64 d_lastUtilization;
+    bsl::string        d_prefix;
+    bsl::string        d_objectName;
+    bslma::Allocator*  d_allocator_p;
+
+    static const struct ntci::MetricMetadata STATISTICS[];
+
+  private:
+    ThreadMetrics(const ThreadMetrics&) BSLS_KEYWORD_DELETED;
+    ThreadMetrics& operator=(const ThreadMetrics&) BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Collect thread metrics. Return the error.
+    ntsa::Error collect();
+
+  public:
+    /// Create new metrics for the calling thread, for the specified
+    /// 'objectName' whose field names have the specified 'prefix'.
+    /// Optionally specify a 'basicAllocator' used to supply memory. If
+    /// 'basicAllocator' is 0, the currently installed default allocator is
+    /// used.
+    ThreadMetrics(const bslstl::StringRef& prefix,
+                  const bslstl::StringRef& objectName,
+                  bslma::Allocator*        basicAllocator = 0);
+
+    /// Destroy this object.
+    ~ThreadMetrics() BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the identifier assigned by the operating system's scheduler to
+    /// the measured thread, or 0 if such identifiers are not supported on
+    /// the current platform.
+    int threadId() const;
+
+    /// Return true if the statistics of the measured thread may be
+    /// collected on the current platform, otherwise return false.
+    bool isSupported() const;
+
+    /// Return the fraction of one CPU consumed by the measured thread
+    /// between the two most recent collections of its statistics, or 0 if
+    /// the statistics have not been collected at least once since this
+    /// object was created or the statistics are not supported on the
+    /// current platform.
+    double utilization() const;
+
+    /// Load into the specified 'result' the array of statistics from the
+    /// specified 'snapshot' for this object based on the specified
+    /// 'operation': if 'operation' is e_CUMULATIVE then the statistics are
+    /// for the entire life of this object;  otherwise the statistics are
+    /// for the period since the last call to this function. If 'operation'
+    /// is e_INTERVAL_WITH_RESET then reset all internal measurements.  Note
+    /// that 'result->theArray().length()' is expected to have the same
+    /// value each time this function returns.
+    void getStats(bdld::ManagedDatum* result) BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the prefix corresponding to the field at the specified
+    /// 'ordinal' position, or 0 if no field at the 'ordinal' position
+    /// exists.
+    const char* getFieldPrefix(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the field name corresponding to the field at the specified
+    /// 'ordinal' position, or 0 if no field at the 'ordinal' position
+    /// exists.
+    const char* getFieldName(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the field description corresponding to the field at the
+    /// specified 'ordinal' position, or 0 if no field at the 'ordinal'
+    /// position exists.
+    const char* getFieldDescription(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the type of the statistic at the specified 'ordinal'
+    /// position, or e_AVERAGE if no field at the 'ordinal' position exists
+    /// or the type is unknown.
+    ntci::Monitorable::StatisticType getFieldType(int ordinal) const
+        BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the flags that indicate which indexes to apply to the
+    /// statistics measured by this monitorable object.
+    int getFieldTags(int ordinal) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the ordinal of the specified 'fieldName', or a negative value
+    /// if no field identified by 'fieldName' exists.
+    int getFieldOrdinal(const char* fieldName) const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the maximum number of elements in a datum resulting from
+    /// a call to 'getStats()'.
+    int numOrdinals() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the human-readable name of the monitorable object, or 0 or
+    /// the empty string if no such human-readable name has been assigned to
+    /// the monitorable object.
+    const char* objectName() const BSLS_KEYWORD_OVERRIDE;
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
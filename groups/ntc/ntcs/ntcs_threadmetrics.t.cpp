@@ -0,0 +1,181 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_threadmetrics_t_cpp, "$Id$ $CSID$")
+
+#include <ntcs_threadmetrics.h>
+
+#include <bdld_manageddatum.h>
+#include <bdlf_bind.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadgroup.h>
+#include <bsls_atomic.h>
+#include <bsls_platform.h>
+#include <bsls_systemtime.h>
+#include <bsl_cstring.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcs {
+
+// Provide tests for 'ntcs::ThreadMetrics'.
+class ThreadMetricsTest
+{
+    // Return the value of the statistic having the specified 'fieldName' in
+    // the specified 'stats' collected from the specified 'metrics', or -1 if
+    // the statistic has no value.
+    static double field(const ntcs::ThreadMetrics& metrics,
+                        const bdld::ManagedDatum&  stats,
+                        const char*                fieldName);
+
+    // Consume CPU on the calling thread for the specified 'duration'.
+    static void spin(const bsls::TimeInterval& duration);
+
+    // Create metrics for the calling thread and load them into the specified
+    // 'result', post to the specified 'started' semaphore, then consume CPU
+    // until the specified 'stop' flag is set.
+    static void runBusyThread(bsl::shared_ptr<ntcs::ThreadMetrics>* result,
+                              bslmt::Semaphore*                     started,
+                              bsls::AtomicBool*                     stop);
+
+  public:
+    // Concern: The CPU time and utilization of the calling thread are
+    // measured, or reported as unsupported on platforms other than Linux.
+    static void verifyCallingThread();
+
+    // Concern: The CPU time and utilization of a thread are measured when
+    // collected from a different thread.
+    static void verifyOtherThread();
+};
+
+double ThreadMetricsTest::field(const ntcs::ThreadMetrics& metrics,
+                                const bdld::ManagedDatum&  stats,
+                                const char*                fieldName)
+{
+    const bdld::DatumArrayRef array = stats.datum().theArray();
+
+    const int ordinal = metrics.getFieldOrdinal(fieldName);
+    NTSCFG_TEST_GE(ordinal, 0);
+
+    const bdld::Datum& datum = array.data()[ordinal];
+    if (datum.isDouble()) {
+        return datum.theDouble();
+    }
+    else if (datum.isInteger64()) {
+        return static_cast<double>(datum.theInteger64());
+    }
+
+    return -1;
+}
+
+void ThreadMetricsTest::spin(const bsls::TimeInterval& duration)
+{
+    const bsls::TimeInterval deadline =
+        bsls::SystemTime::nowMonotonicClock() + duration;
+
+    while (bsls::SystemTime::nowMonotonicClock() < deadline) {
+    }
+}
+
+void ThreadMetricsTest::runBusyThread(
+    bsl::shared_ptr<ntcs::ThreadMetrics>* result,
+    bslmt::Semaphore*                     started,
+    bsls::AtomicBool*                     stop)
+{
+    result->createInplace(NTSCFG_TEST_ALLOCATOR,
+                          "thread",
+                          "busy",
+                          NTSCFG_TEST_ALLOCATOR);
+
+    started->post();
+
+    while (!stop->load()) {
+        ThreadMetricsTest::spin(bsls::TimeInterval(0, 1000000));
+    }
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::ThreadMetricsTest::verifyCallingThread)
+{
+    ntcs::ThreadMetrics metrics("thread", "test", NTSCFG_TEST_ALLOCATOR);
+
+    ThreadMetricsTest::spin(bsls::TimeInterval(0, 200000000));
+
+    bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+    metrics.getStats(&stats);
+
+    NTSCFG_TEST_EQ(stats.datum().theArray().length(),
+                   static_cast<bsl::size_t>(metrics.numOrdinals()));
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    NTSCFG_TEST_TRUE(metrics.isSupported());
+
+    const double cpuTime = field(metrics, stats, "cpuTimeUser.total") +
+                           field(metrics, stats, "cpuTimeSystem.total");
+
+    NTSCFG_TEST_GT(cpuTime, 0);
+
+    NTSCFG_TEST_GT(metrics.utilization(), 0);
+    NTSCFG_TEST_LE(metrics.utilization(), 1);
+#else
+    NTSCFG_TEST_FALSE(metrics.isSupported());
+
+    NTSCFG_TEST_EQ(field(metrics, stats, "cpuTimeUser.total"), 0);
+    NTSCFG_TEST_EQ(metrics.utilization(), 0);
+#endif
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::ThreadMetricsTest::verifyOtherThread)
+{
+    bsl::shared_ptr<ntcs::ThreadMetrics> metrics;
+    bslmt::Semaphore                     started;
+    bsls::AtomicBool                     stop(false);
+
+    bslmt::ThreadGroup threadGroup(NTSCFG_TEST_ALLOCATOR);
+    threadGroup.addThread(
+        bdlf::BindUtil::bind(&ThreadMetricsTest::runBusyThread,
+                             &metrics,
+                             &started,
+                             &stop));
+
+    started.wait();
+
+    bslmt::ThreadUtil::microSleep(200 * 1000);
+
+    bdld::ManagedDatum stats(NTSCFG_TEST_ALLOCATOR);
+    metrics->getStats(&stats);
+
+    stop.store(true);
+    threadGroup.joinAll();
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    NTSCFG_TEST_TRUE(metrics->isSupported());
+    NTSCFG_TEST_NE(metrics->threadId(), 0);
+
+    const double cpuTime = field(*metrics, stats, "cpuTimeUser.total") +
+                           field(*metrics, stats, "cpuTimeSystem.total");
+
+    NTSCFG_TEST_GT(cpuTime, 0);
+
+    NTSCFG_TEST_GT(metrics->utilization(), 0);
+    NTSCFG_TEST_LE(metrics->utilization(), 1);
+#endif
+}
+
+}  // close namespace ntcs
+}  // close namespace BloombergLP
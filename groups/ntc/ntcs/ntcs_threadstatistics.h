@@ -0,0 +1,311 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCS_THREADSTATISTICS
+#define INCLUDED_NTCS_THREADSTATISTICS
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntccfg_platform.h>
+#include <ntcscm_version.h>
+#include <bdlb_nullablevalue.h>
+#include <bsls_timeinterval.h>
+#include <bsl_iosfwd.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+/// @internal @brief
+/// Describe the resource usage of a thread.
+///
+/// @details
+/// Provide a value-semantic type that describes the resource usage of a
+/// single thread, including user and system CPU time, context switches, and
+/// the time the thread has spent waiting to be scheduled.
+///
+/// @par Attributes
+/// This class is composed of the following attributes.
+///
+/// @li @b cpuTimeUser:
+/// The total amount of time a CPU has spent executing instructions in user
+/// mode on behalf of the thread. This value is a running-total and will only
+/// ever increase monotonically.
+///
+/// @li @b cpuTimeSystem:
+/// The total amount of time a CPU has spent executing instructions in system
+/// mode on behalf of the thread. This value is a running-total and will only
+/// ever increase monotonically.
+///
+/// @li @b contextSwitchesUser:
+/// The number of times a context switch resulted from the thread voluntarily
+/// giving up its processor before its time slice was completed, usually to
+/// wait for I/O. This value is a running-total and will only ever increase
+/// monotonically.
+///
+/// @li @b contextSwitchesSystem:
+/// The number of times a context switch resulted from the thread being
+/// preempted, because a higher priority thread became runnable or because
+/// the thread exceeded its time slice. This value is a running-total and
+/// will only ever increase monotonically.
+///
+/// @li @b schedulingDelay:
+/// The total amount of time the thread has been runnable but waiting on a
+/// run queue for a CPU. This value is a running-total and will only ever
+/// increase monotonically.
+///
+/// @li @b schedulingTimeslices:
+/// The number of timeslices the thread has run on a CPU. This value is a
+/// running-total and will only ever increase monotonically.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcs
+class ThreadStatistics
+{
+    bdlb::NullableValue<bsls::TimeInterval> d_cpuTimeUser;
+    bdlb::NullableValue<bsls::TimeInterval> d_cpuTimeSystem;
+    bdlb::NullableValue<bsl::size_t>        d_contextSwitchesUser;
+    bdlb::NullableValue<bsl::size_t>        d_contextSwitchesSystem;
+    bdlb::NullableValue<bsls::TimeInterval> d_schedulingDelay;
+    bdlb::NullableValue<bsl::size_t>        d_schedulingTimeslices;
+
+  public:
+    /// Create new thread statistics.
+    ThreadStatistics();
+
+    /// Create new thread statistics from the specified 'original' object.
+    ThreadStatistics(const ThreadStatistics& original);
+
+    /// Destroy this object.
+    ~ThreadStatistics();
+
+    /// Assign the value of the specified 'other' object to this object.
+    /// Return a reference to this modifiable object.
+    ThreadStatistics& operator=(const ThreadStatistics& other);
+
+    /// Reset the value of this object to its value upon default
+    /// construction.
+    void reset();
+
+    /// Set the user CPU time to the specified 'value'.
+    void setCpuTimeUser(const bsls::TimeInterval& value);
+
+    /// Set the system CPU time to the specified 'value'.
+    void setCpuTimeSystem(const bsls::TimeInterval& value);
+
+    /// Set the number of voluntary context switches to the specified
+    /// 'value'.
+    void setContextSwitchesUser(bsl::size_t value);
+
+    /// Set the number of involuntary context switches to the specified
+    /// 'value'.
+    void setContextSwitchesSystem(bsl::size_t value);
+
+    /// Set the total time spent runnable but waiting on a run queue to the
+    /// specified 'value'.
+    void setSchedulingDelay(const bsls::TimeInterval& value);
+
+    /// Set the number of timeslices run on a CPU to the specified 'value'.
+    void setSchedulingTimeslices(bsl::size_t value);
+
+    /// Return the user CPU time.
+    const bdlb::NullableValue<bsls::TimeInterval>& cpuTimeUser() const;
+
+    /// Return the system CPU time.
+    const bdlb::NullableValue<bsls::TimeInterval>& cpuTimeSystem() const;
+
+    /// Return the number of voluntary context switches.
+    const bdlb::NullableValue<bsl::size_t>& contextSwitchesUser() const;
+
+    /// Return the number of involuntary context switches.
+    const bdlb::NullableValue<bsl::size_t>& contextSwitchesSystem() const;
+
+    /// Return the total time spent runnable but waiting on a run queue.
+    const bdlb::NullableValue<bsls::TimeInterval>& schedulingDelay() const;
+
+    /// Return the number of timeslices run on a CPU.
+    const bdlb::NullableValue<bsl::size_t>& schedulingTimeslices() const;
+
+    /// Format this object to the specified output 'stream' at the
+    /// optionally specified indentation 'level' and return a reference to
+    /// the modifiable 'stream'.  If 'level' is specified, optionally
+    /// specify 'spacesPerLevel', the number of spaces per indentation level
+    /// for this and all of its nested objects.  Each line is indented by
+    /// the absolute value of 'level * spacesPerLevel'.  If 'level' is
+    /// negative, suppress indentation of the first line.  If
+    /// 'spacesPerLevel' is negative, suppress line breaks and format the
+    /// entire output on one line.  If 'stream' is initially invalid, this
+    /// operation has no effect.  Note that a trailing newline is provided
+    /// in multiline mode only.
+    bsl::ostream& print(bsl::ostream& stream,
+                        int           level          = 0,
+                        int           spacesPerLevel = 4) const;
+
+    /// This type's copy-constructor and copy-assignment operator is equivalent
+    /// to copying each byte of the source object's footprint to each
+    /// corresponding byte of the destination object's footprint.
+    NTSCFG_TYPE_TRAIT_BITWISE_COPYABLE(ThreadStatistics);
+
+    /// This type's move-constructor and move-assignment operator is equivalent
+    /// to copying each byte of the source object's footprint to each
+    /// corresponding byte of the destination object's footprint.
+    NTSCFG_TYPE_TRAIT_BITWISE_MOVABLE(ThreadStatistics);
+};
+
+/// Write the specified 'object' to the specified 'stream'. Return
+/// a modifiable reference to the 'stream'.
+bsl::ostream& operator<<(bsl::ostream&           stream,
+                         const ThreadStatistics& object);
+
+NTCCFG_INLINE
+ThreadStatistics::ThreadStatistics()
+: d_cpuTimeUser()
+, d_cpuTimeSystem()
+, d_contextSwitchesUser()
+, d_contextSwitchesSystem()
+, d_schedulingDelay()
+, d_schedulingTimeslices()
+{
+}
+
+NTCCFG_INLINE
+ThreadStatistics::ThreadStatistics(const ThreadStatistics& original)
+: d_cpuTimeUser(original.d_cpuTimeUser)
+, d_cpuTimeSystem(original.d_cpuTimeSystem)
+, d_contextSwitchesUser(original.d_contextSwitchesUser)
+, d_contextSwitchesSystem(original.d_contextSwitchesSystem)
+, d_schedulingDelay(original.d_schedulingDelay)
+, d_schedulingTimeslices(original.d_schedulingTimeslices)
+{
+}
+
+NTCCFG_INLINE
+ThreadStatistics::~ThreadStatistics()
+{
+}
+
+NTCCFG_INLINE
+ThreadStatistics& ThreadStatistics::operator=(const ThreadStatistics& other)
+{
+    d_cpuTimeUser           = other.d_cpuTimeUser;
+    d_cpuTimeSystem         = other.d_cpuTimeSystem;
+    d_contextSwitchesUser   = other.d_contextSwitchesUser;
+    d_contextSwitchesSystem = other.d_contextSwitchesSystem;
+    d_schedulingDelay       = other.d_schedulingDelay;
+    d_schedulingTimeslices  = other.d_schedulingTimeslices;
+
+    return *this;
+}
+
+NTCCFG_INLINE
+void ThreadStatistics::reset()
+{
+    d_cpuTimeUser.reset();
+    d_cpuTimeSystem.reset();
+    d_contextSwitchesUser.reset();
+    d_contextSwitchesSystem.reset();
+    d_schedulingDelay.reset();
+    d_schedulingTimeslices.reset();
+}
+
+NTCCFG_INLINE
+void ThreadStatistics::setCpuTimeUser(const bsls::TimeInterval& value)
+{
+    d_cpuTimeUser = value;
+}
+
+NTCCFG_INLINE
+void ThreadStatistics::setCpuTimeSystem(const bsls::TimeInterval& value)
+{
+    d_cpuTimeSystem = value;
+}
+
+NTCCFG_INLINE
+void ThreadStatistics::setContextSwitchesUser(bsl::size_t value)
+{
+    d_contextSwitchesUser = value;
+}
+
+NTCCFG_INLINE
+void ThreadStatistics::setContextSwitchesSystem(bsl::size_t value)
+{
+    d_contextSwitchesSystem = value;
+}
+
+NTCCFG_INLINE
+void ThreadStatistics::setSchedulingDelay(const bsls::TimeInterval& value)
+{
+    d_schedulingDelay = value;
+}
+
+NTCCFG_INLINE
+void ThreadStatistics::setSchedulingTimeslices(bsl::size_t value)
+{
+    d_schedulingTimeslices = value;
+}
+
+NTCCFG_INLINE
+const bdlb::NullableValue<bsls::TimeInterval>& ThreadStatistics::
+    cpuTimeUser() const
+{
+    return d_cpuTimeUser;
+}
+
+NTCCFG_INLINE
+const bdlb::NullableValue<bsls::TimeInterval>& ThreadStatistics::
+    cpuTimeSystem() const
+{
+    return d_cpuTimeSystem;
+}
+
+NTCCFG_INLINE
+const bdlb::NullableValue<bsl::size_t>& ThreadStatistics::
+    contextSwitchesUser() const
+{
+    return d_contextSwitchesUser;
+}
+
+NTCCFG_INLINE
+const bdlb::NullableValue<bsl::size_t>& ThreadStatistics::
+    contextSwitchesSystem() const
+{
+    return d_contextSwitchesSystem;
+}
+
+NTCCFG_INLINE
+const bdlb::NullableValue<bsls::TimeInterval>& ThreadStatistics::
+    schedulingDelay() const
+{
+    return d_schedulingDelay;
+}
+
+NTCCFG_INLINE
+const bdlb::NullableValue<bsl::size_t>& ThreadStatistics::
+    schedulingTimeslices() const
+{
+    return d_schedulingTimeslices;
+}
+
+NTCCFG_INLINE
+bsl::ostream& operator<<(bsl::ostream& stream, const ThreadStatistics& object)
+{
+    return object.print(stream, 0, -1);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
@@ -0,0 +1,62 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_threadstatistics_t_cpp, "$Id$ $CSID$")
+
+#include <ntcs_threadstatistics.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcs {
+
+// Provide tests for 'ntcs::ThreadStatistics'.
+class ThreadStatisticsTest
+{
+  public:
+    // Concern: Attributes are null until set, and null again after reset.
+    static void verifyReset();
+};
+
+NTSCFG_TEST_FUNCTION(ntcs::ThreadStatisticsTest::verifyReset)
+{
+    ntcs::ThreadStatistics statistics;
+
+    NTSCFG_TEST_TRUE(statistics.cpuTimeUser().isNull());
+    NTSCFG_TEST_TRUE(statistics.schedulingDelay().isNull());
+
+    statistics.setCpuTimeUser(bsls::TimeInterval(1, 0));
+    statistics.setContextSwitchesSystem(2);
+    statistics.setSchedulingDelay(bsls::TimeInterval(0, 3000));
+
+    ntcs::ThreadStatistics copy(statistics);
+
+    NTSCFG_TEST_EQ(copy.cpuTimeUser().value(), bsls::TimeInterval(1, 0));
+    NTSCFG_TEST_EQ(copy.contextSwitchesSystem().value(), 2);
+    NTSCFG_TEST_EQ(copy.schedulingDelay().value(),
+                   bsls::TimeInterval(0, 3000));
+
+    copy.reset();
+
+    NTSCFG_TEST_TRUE(copy.cpuTimeUser().isNull());
+    NTSCFG_TEST_TRUE(copy.contextSwitchesSystem().isNull());
+    NTSCFG_TEST_TRUE(copy.schedulingDelay().isNull());
+}
+
+}  // close namespace ntcs
+}  // close namespace BloombergLP
@@ -21,6 +21,7 @@ BSLS_IDENT_RCSID(ntcs_threadutil_cpp, "$Id$ $CSID$")
 #include <bslma_allocator.h>
 #include <bslma_default.h>
 #include <bsls_assert.h>
+#include <bsls_types.h>
 
 #if defined(BSLS_PLATFORM_OS_UNIX)
 #include <pthread.h>
@@ -110,6 +111,23 @@ void ThreadUtil::join(bslmt::ThreadUtil::Handle handle)
     BSLS_ASSERT_OPT(threadStatus == 0);
 }
 
+bsl::size_t ThreadUtil::shardIndex(bsl::size_t numShards)
+{
+    BSLS_ASSERT(numShards > 0);
+
+    // Mix the bits of the thread identifier, which is typically the
+    // address of a thread control block, so that threads are distributed
+    // evenly across shards.
+
+    bsls::Types::Uint64 id = bslmt::ThreadUtil::selfIdAsUint64();
+
+    id ^= id >> 33;
+    id *= 0xff51afd7ed558ccdULL;
+    id ^= id >> 33;
+
+    return static_cast<bsl::size_t>(id % numShards);
+}
+
 ThreadContext::ThreadContext(bslma::Allocator* basicAllocator)
 : d_object_p(0)
 , d_driver_p(0)
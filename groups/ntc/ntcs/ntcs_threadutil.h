@@ -34,7 +34,7 @@ namespace BloombergLP {
 namespace ntcs {
 
 /// @internal @brief
-/// Provide utilities for creating threads.
+/// Provide utilities for creating and identifying threads.
 ///
 /// @par Thread Safety
 /// This class is thread safe.
@@ -54,6 +54,12 @@ struct ThreadUtil {
 
     /// Block until the specified 'handle' has completed.
     static void join(bslmt::ThreadUtil::Handle handle);
+
+    /// Return the index of the shard, less than the specified 'numShards',
+    /// assigned to the calling thread. Each thread is always assigned the
+    /// same shard, and threads are distributed evenly across shards. The
+    /// behavior is undefined unless 'numShards > 0'.
+    static bsl::size_t shardIndex(bsl::size_t numShards);
 };
 
 /// @internal @brief
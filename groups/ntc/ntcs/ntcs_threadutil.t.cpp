@@ -35,6 +35,10 @@ class ThreadUtilTest
   public:
     // TODO
     static void verify();
+
+    // Concern: Each thread is always assigned the same shard, which is less
+    // than the number of shards.
+    static void verifyShardIndex();
 };
 
 void* ThreadUtilTest::execute(void* context)
@@ -70,5 +74,18 @@ NTSCFG_TEST_FUNCTION(ntcs::ThreadUtilTest::verify)
     ntcs::ThreadUtil::join(handle);
 }
 
+NTSCFG_TEST_FUNCTION(ntcs::ThreadUtilTest::verifyShardIndex)
+{
+    NTSCFG_TEST_EQ(ntcs::ThreadUtil::shardIndex(1), 0);
+
+    for (bsl::size_t numShards = 1; numShards <= 16; ++numShards) {
+        const bsl::size_t shard = ntcs::ThreadUtil::shardIndex(numShards);
+        NTSCFG_TEST_LT(shard, numShards);
+
+        const bsl::size_t again = ntcs::ThreadUtil::shardIndex(numShards);
+        NTSCFG_TEST_EQ(again, shard);
+    }
+}
+
 }  // close namespace ntcs
 }  // close namespace BloombergLP
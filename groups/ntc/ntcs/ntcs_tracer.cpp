@@ -0,0 +1,425 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcs_tracer.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_tracer_cpp, "$Id$ $CSID$")
+
+#include <bdls_processutil.h>
+#include <bslma_default.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+#include <bsls_assert.h>
+#include <bsl_algorithm.h>
+#include <bsl_iomanip.h>
+#include <bsl_ostream.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+namespace {
+
+/// The maximum number of trace buffers of exited threads retained until
+/// cleared.
+const bsl::size_t k_MAX_DETACHED_BUFFERS = 64;
+
+/// Describe the process-wide tracer state.
+class TracerState
+{
+  public:
+    /// Define a type alias for a vector of trace buffers.
+    typedef bsl::vector<bsl::shared_ptr<TraceBuffer> > BufferVector;
+
+    /// Create the process-wide state necessary to trace events.
+    TracerState();
+
+    /// Destroy the process-wide state necessary to trace events.
+    ~TracerState();
+
+    /// Mark the trace buffer at the specified 'buffer' as detached from its
+    /// exited thread.
+    static void destroyKey(void* buffer);
+
+    /// The mutex synchronizing access to the registered buffers.
+    bslmt::Mutex d_mutex;
+
+    /// The trace buffers of each thread that has recorded an event.
+    BufferVector d_buffers;
+
+    /// The process-wide trace buffer thread-local key.
+    bslmt::ThreadUtil::Key d_key;
+
+    /// The global tracer state.
+    static TracerState s_global;
+
+  private:
+    TracerState(const TracerState&);
+    TracerState& operator=(const TracerState&);
+};
+
+TracerState TracerState::s_global;
+
+TracerState::TracerState()
+: d_mutex()
+, d_buffers(bslma::Default::globalAllocator())
+{
+    int rc = bslmt::ThreadUtil::createKey(&d_key, &TracerState::destroyKey);
+    BSLS_ASSERT_OPT(rc == 0);
+}
+
+TracerState::~TracerState()
+{
+}
+
+void TracerState::destroyKey(void* buffer)
+{
+    if (buffer != 0) {
+        static_cast<TraceBuffer*>(buffer)->detach();
+    }
+}
+
+/// Return true if the specified 'lhs' occurred before the specified 'rhs',
+/// otherwise return false.
+bool isEarlier(const TraceRecord& lhs, const TraceRecord& rhs)
+{
+    return lhs.d_time < rhs.d_time;
+}
+
+/// Write the specified 'nanoseconds' to the specified 'stream' in
+/// microseconds with a fractional part.
+void printMicroseconds(bsl::ostream& stream, bsls::Types::Int64 nanoseconds)
+{
+    if (nanoseconds < 0) {
+        stream << '-';
+        nanoseconds = -nanoseconds;
+    }
+
+    stream << (nanoseconds / 1000) << '.' << bsl::setw(3)
+           << bsl::setfill('0') << (nanoseconds % 1000) << bsl::setfill(' ');
+}
+
+}  // close unnamed namespace
+
+const char* TraceEvent::toString(Value value)
+{
+    switch (value) {
+    case e_READABLE:
+        return "READABLE";
+    case e_WRITABLE:
+        return "WRITABLE";
+    case e_ACCEPTED:
+        return "ACCEPTED";
+    case e_RECEIVED:
+        return "RECEIVED";
+    case e_SENT:
+        return "SENT";
+    case e_SEND_COMPLETE:
+        return "SEND_COMPLETE";
+    case e_SEND_ENQUEUE:
+        return "SEND_ENQUEUE";
+    case e_FUNCTION:
+        return "FUNCTION";
+    case e_TIMER:
+        return "TIMER";
+    case e_STRAND:
+        return "STRAND";
+    }
+
+    return "???";
+}
+
+TraceBuffer::TraceBuffer(bsl::uint64_t     threadId,
+                         bsl::size_t       capacity,
+                         bslma::Allocator* basicAllocator)
+: d_slot_p(0)
+, d_capacity(1)
+, d_mask(0)
+, d_sequence(0)
+, d_floor(0)
+, d_threadId(threadId)
+, d_detached(false)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    while (d_capacity < capacity) {
+        d_capacity <<= 1;
+    }
+
+    d_mask = d_capacity - 1;
+
+    d_slot_p =
+        static_cast<Slot*>(d_allocator_p->allocate(sizeof(Slot) * d_capacity));
+
+    for (bsl::size_t i = 0; i < d_capacity; ++i) {
+        new (d_slot_p + i) Slot();
+    }
+}
+
+TraceBuffer::~TraceBuffer()
+{
+    for (bsl::size_t i = 0; i < d_capacity; ++i) {
+        d_slot_p[i].~Slot();
+    }
+
+    d_allocator_p->deallocate(d_slot_p);
+}
+
+void TraceBuffer::detach()
+{
+    d_detached.storeRelease(true);
+}
+
+void TraceBuffer::clear()
+{
+    // The writer never reads the floor, so the records are discarded by
+    // advancing the floor below which readers ignore records, without
+    // synchronizing with the writer.
+
+    d_floor.storeRelease(d_sequence.loadAcquire());
+}
+
+void TraceBuffer::load(bsl::vector<TraceRecord>* result) const
+{
+    const bsl::uint64_t capacity = d_capacity;
+
+    const bsl::uint64_t first = d_floor.loadAcquire();
+    const bsl::uint64_t end   = d_sequence.loadAcquire();
+
+    bsl::uint64_t begin = end > capacity ? end - capacity : 0;
+    if (begin < first) {
+        begin = first;
+    }
+
+    for (bsl::uint64_t sequence = begin; sequence < end; ++sequence) {
+        const Slot& slot = d_slot_p[sequence & d_mask];
+
+        // The writer may overwrite the slot while it is being copied. The
+        // stamp is odd while the writer stores the fields, and each field
+        // is loaded with acquire semantics, so a field stored for a later
+        // record implies the second load of the stamp observes that the
+        // slot has been reused. Discard the copy in that case.
+
+        const bsl::uint64_t stamp = 2 * sequence + 2;
+
+        if (slot.d_stamp.loadAcquire() != stamp) {
+            continue;
+        }
+
+        TraceRecord record;
+        record.d_time     = slot.d_time.loadAcquire();
+        record.d_duration = slot.d_duration.loadAcquire();
+        record.d_threadId = d_threadId;
+        record.d_handle   = slot.d_handle.loadAcquire();
+        record.d_argument = slot.d_argument.loadAcquire();
+        record.d_event    = static_cast<TraceEvent::Value>(
+            slot.d_event.loadAcquire());
+
+        if (slot.d_stamp.loadAcquire() != stamp) {
+            continue;
+        }
+
+        result->push_back(record);
+    }
+}
+
+bsl::uint64_t TraceBuffer::threadId() const
+{
+    return d_threadId;
+}
+
+bsl::size_t TraceBuffer::capacity() const
+{
+    return d_capacity;
+}
+
+bool TraceBuffer::isDetached() const
+{
+    return d_detached.loadAcquire();
+}
+
+bsls::AtomicBool Tracer::s_enabled(false);
+
+TraceBuffer* Tracer::lookupBuffer()
+{
+    TracerState& state = TracerState::s_global;
+
+    TraceBuffer* buffer = static_cast<TraceBuffer*>(
+        bslmt::ThreadUtil::getSpecific(state.d_key));
+
+    if (NTCCFG_LIKELY(buffer != 0)) {
+        return buffer;
+    }
+
+    bslma::Allocator* allocator = bslma::Default::globalAllocator();
+
+    bsl::shared_ptr<TraceBuffer> bufferSp;
+    bufferSp.createInplace(allocator,
+                           bslmt::ThreadUtil::selfIdAsUint64(),
+                           static_cast<bsl::size_t>(
+                               TraceBuffer::k_DEFAULT_CAPACITY),
+                           allocator);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> lock(&state.d_mutex);
+
+        bsl::size_t numDetached = 0;
+        for (TracerState::BufferVector::const_iterator it =
+                 state.d_buffers.begin();
+             it != state.d_buffers.end();
+             ++it)
+        {
+            if ((*it)->isDetached()) {
+                ++numDetached;
+            }
+        }
+
+        if (numDetached >= k_MAX_DETACHED_BUFFERS) {
+            for (TracerState::BufferVector::iterator it =
+                     state.d_buffers.begin();
+                 it != state.d_buffers.end();
+                 ++it)
+            {
+                if ((*it)->isDetached()) {
+                    state.d_buffers.erase(it);
+                    break;
+                }
+            }
+        }
+
+        state.d_buffers.push_back(bufferSp);
+    }
+
+    int rc = bslmt::ThreadUtil::setSpecific(state.d_key, bufferSp.get());
+    BSLS_ASSERT_OPT(rc == 0);
+
+    return bufferSp.get();
+}
+
+void Tracer::enable()
+{
+    s_enabled.storeRelaxed(true);
+}
+
+void Tracer::disable()
+{
+    s_enabled.storeRelaxed(false);
+}
+
+void Tracer::recordInstant(TraceEvent::Value event,
+                           ntsa::Handle      handle,
+                           bsl::uint64_t     argument)
+{
+    Tracer::lookupBuffer()->push(event,
+                                 bsls::TimeUtil::getTimer(),
+                                 -1,
+                                 static_cast<bsls::Types::Int64>(handle),
+                                 argument);
+}
+
+void Tracer::recordComplete(TraceEvent::Value  event,
+                            bsls::Types::Int64 startTime,
+                            ntsa::Handle       handle,
+                            bsl::uint64_t      argument)
+{
+    const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+
+    Tracer::lookupBuffer()->push(event,
+                                 startTime,
+                                 now - startTime,
+                                 static_cast<bsls::Types::Int64>(handle),
+                                 argument);
+}
+
+void Tracer::clear()
+{
+    TracerState& state = TracerState::s_global;
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&state.d_mutex);
+
+    TracerState::BufferVector::iterator it = state.d_buffers.begin();
+    while (it != state.d_buffers.end()) {
+        if ((*it)->isDetached()) {
+            it = state.d_buffers.erase(it);
+        }
+        else {
+            (*it)->clear();
+            ++it;
+        }
+    }
+}
+
+void Tracer::load(bsl::vector<TraceRecord>* result)
+{
+    TracerState& state = TracerState::s_global;
+
+    result->clear();
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> lock(&state.d_mutex);
+
+        for (TracerState::BufferVector::const_iterator it =
+                 state.d_buffers.begin();
+             it != state.d_buffers.end();
+             ++it)
+        {
+            (*it)->load(result);
+        }
+    }
+
+    bsl::stable_sort(result->begin(), result->end(), &isEarlier);
+}
+
+bsl::ostream& Tracer::exportChromeTrace(
+    bsl::ostream&                   stream,
+    const bsl::vector<TraceRecord>& records)
+{
+    const int processId = bdls::ProcessUtil::getProcessId();
+
+    stream << "{\"traceEvents\":[";
+
+    for (bsl::size_t i = 0; i < records.size(); ++i) {
+        const TraceRecord& record = records[i];
+
+        if (i != 0) {
+            stream << ',';
+        }
+
+        stream << "\n{\"name\":\"" << TraceEvent::toString(record.d_event)
+               << "\",\"cat\":\"ntc\"";
+
+        if (record.d_duration >= 0) {
+            stream << ",\"ph\":\"X\",\"ts\":";
+            printMicroseconds(stream, record.d_time);
+            stream << ",\"dur\":";
+            printMicroseconds(stream, record.d_duration);
+        }
+        else {
+            stream << ",\"ph\":\"i\",\"s\":\"t\",\"ts\":";
+            printMicroseconds(stream, record.d_time);
+        }
+
+        stream << ",\"pid\":" << processId << ",\"tid\":" << record.d_threadId
+               << ",\"args\":{\"handle\":" << record.d_handle
+               << ",\"argument\":" << record.d_argument << "}}";
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    return stream;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
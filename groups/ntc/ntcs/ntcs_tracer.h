@@ -0,0 +1,386 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCS_TRACER
+#define INCLUDED_NTCS_TRACER
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntccfg_likely.h>
+#include <ntccfg_platform.h>
+#include <ntcscm_version.h>
+#include <ntsa_handle.h>
+#include <bslma_allocator.h>
+#include <bsls_atomic.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+#include <bsl_cstdint.h>
+#include <bsl_iosfwd.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ntcs {
+
+/// @internal @brief
+/// Enumerate the events recorded by the tracer.
+///
+/// @par Thread Safety
+/// This struct is thread safe.
+///
+/// @ingroup module_ntcs
+struct TraceEvent {
+  public:
+    /// Enumerate the events recorded by the tracer.
+    enum Value {
+        /// A reactor socket processed its readability.
+        e_READABLE,
+
+        /// A reactor socket processed its writability.
+        e_WRITABLE,
+
+        /// A proactor socket processed the completion of an accept.
+        e_ACCEPTED,
+
+        /// A proactor socket processed the completion of a receive.
+        e_RECEIVED,
+
+        /// A proactor socket processed the completion of a send.
+        e_SENT,
+
+        /// A socket processed the kernel's completion of a zero-copy send.
+        e_SEND_COMPLETE,
+
+        /// A socket enqueued data to send.
+        e_SEND_ENQUEUE,
+
+        /// A chronology invoked a deferred function.
+        e_FUNCTION,
+
+        /// A chronology notified a timer of its deadline.
+        e_TIMER,
+
+        /// A strand invoked a function.
+        e_STRAND
+    };
+
+    /// Return the string representation exactly matching the enumerator
+    /// name corresponding to the specified enumeration 'value'.
+    static const char* toString(Value value);
+};
+
+/// @internal @brief
+/// Describe an event recorded by the tracer.
+///
+/// @details
+/// Each record has a fixed size and is trivially copyable so that a
+/// snapshot of the ring buffers of all threads may be sorted and exported
+/// cheaply.
+///
+/// @par Thread Safety
+/// This struct is not thread safe.
+///
+/// @ingroup module_ntcs
+struct TraceRecord {
+    /// The time the event began, in nanoseconds, as measured by
+    /// 'bsls::TimeUtil::getTimer()'.
+    bsls::Types::Int64 d_time;
+
+    /// The duration of the event, in nanoseconds, or -1 if the event is
+    /// instantaneous.
+    bsls::Types::Int64 d_duration;
+
+    /// The identifier of the thread that recorded the event.
+    bsl::uint64_t d_threadId;
+
+    /// The handle of the socket to which the event pertains, if any.
+    bsls::Types::Int64 d_handle;
+
+    /// The event-specific argument, e.g. the number of bytes.
+    bsl::uint64_t d_argument;
+
+    /// The event.
+    TraceEvent::Value d_event;
+};
+
+/// @internal @brief
+/// Provide a ring buffer of the most recent events recorded by a thread.
+///
+/// @details
+/// A trace buffer is written by exactly one thread and may be read by any
+/// thread. Writing an event stores the record into the next slot and then
+/// publishes the new sequence number; no lock is acquired and no memory is
+/// allocated. Readers copy the most recent records without blocking the
+/// writer and discard any record that the writer may have overwritten while
+/// it was being copied. Each slot is guarded by a sequence lock: the writer
+/// marks the slot's stamp odd, stores each field, then stores the stamp of
+/// the record, and a reader keeps its copy only if the stamp is the
+/// record's stamp both before and after the copy. Each field is an atomic
+/// word stored with release semantics and loaded with acquire semantics, so
+/// a reader racing with the writer never reads plain memory being written,
+/// and its second load of the stamp is ordered after the copy. On x86 these
+/// stores and loads are ordinary moves.
+///
+/// @par Thread Safety
+/// The 'push' function may only be called by one thread. All other functions
+/// are thread safe.
+///
+/// @ingroup module_ntcs
+class TraceBuffer
+{
+    /// This struct describes the storage of a record in the ring buffer.
+    struct Slot {
+        bsls::AtomicUint64 d_stamp;
+        bsls::AtomicInt64  d_time;
+        bsls::AtomicInt64  d_duration;
+        bsls::AtomicInt64  d_handle;
+        bsls::AtomicUint64 d_argument;
+        bsls::AtomicInt    d_event;
+    };
+
+    Slot*              d_slot_p;
+    bsl::size_t        d_capacity;
+    bsl::size_t        d_mask;
+    bsls::AtomicUint64 d_sequence;
+    bsls::AtomicUint64 d_floor;
+    bsl::uint64_t      d_threadId;
+    bsls::AtomicBool   d_detached;
+    bslma::Allocator*  d_allocator_p;
+
+  private:
+    TraceBuffer(const TraceBuffer&) BSLS_KEYWORD_DELETED;
+    TraceBuffer& operator=(const TraceBuffer&) BSLS_KEYWORD_DELETED;
+
+  public:
+    enum {
+        /// The default number of records retained by each trace buffer.
+        k_DEFAULT_CAPACITY = 4096
+    };
+
+    /// Create a new trace buffer written by the thread identified by the
+    /// specified 'threadId' that retains the most recent records up to the
+    /// specified 'capacity', rounded up to the nearest power of two.
+    /// Optionally specify a 'basicAllocator' used to supply memory. If
+    /// 'basicAllocator' is 0, the currently installed default allocator is
+    /// used.
+    TraceBuffer(bsl::uint64_t     threadId,
+                bsl::size_t       capacity,
+                bslma::Allocator* basicAllocator = 0);
+
+    /// Destroy this object.
+    ~TraceBuffer();
+
+    /// Record an event occurring at the specified 'time' for the specified
+    /// 'duration' of the specified 'event' pertaining to the specified
+    /// 'handle' with the specified 'argument'. The behavior is undefined
+    /// unless called by the thread that writes this buffer.
+    void push(TraceEvent::Value  event,
+              bsls::Types::Int64 time,
+              bsls::Types::Int64 duration,
+              bsls::Types::Int64 handle,
+              bsl::uint64_t      argument);
+
+    /// Mark the thread writing this buffer as having exited.
+    void detach();
+
+    /// Remove all records from this buffer. Records concurrently pushed may
+    /// or may not be removed.
+    void clear();
+
+    /// Append the records currently retained by this buffer to the
+    /// specified 'result', oldest first.
+    void load(bsl::vector<TraceRecord>* result) const;
+
+    /// Return the identifier of the thread that writes this buffer.
+    bsl::uint64_t threadId() const;
+
+    /// Return the maximum number of records retained by this buffer.
+    bsl::size_t capacity() const;
+
+    /// Return true if the thread writing this buffer has exited, otherwise
+    /// return false.
+    bool isDetached() const;
+};
+
+/// @internal @brief
+/// Provide a process-wide timeline of socket, timer, and function events.
+///
+/// @details
+/// When tracing is enabled, each thread that records an event lazily
+/// creates and registers a 'ntcs::TraceBuffer' retaining its most recent
+/// events, so recording an event neither locks nor allocates after the first
+/// event recorded by each thread. When tracing is disabled, each trace point
+/// costs the load of a global flag and a branch predicted to not be taken.
+/// The buffers of all threads may be snapshot at any time and exported in
+/// the Chrome trace event format, which may be viewed in Perfetto or
+/// 'chrome://tracing'. Buffers of threads that have exited are retained
+/// until cleared, up to a limit.
+///
+/// @par Thread Safety
+/// This class is thread safe.
+///
+/// @ingroup module_ntcs
+class Tracer
+{
+    static bsls::AtomicBool s_enabled;
+
+    /// Return the trace buffer of the calling thread, creating and
+    /// registering it if necessary.
+    static TraceBuffer* lookupBuffer();
+
+  public:
+    /// Enable tracing.
+    static void enable();
+
+    /// Disable tracing. Events already recorded are retained.
+    static void disable();
+
+    /// Record an instantaneous 'event' occurring now pertaining to the
+    /// specified 'handle' with the specified 'argument'.
+    static void recordInstant(TraceEvent::Value event,
+                              ntsa::Handle      handle,
+                              bsl::uint64_t     argument);
+
+    /// Record the specified 'event' that began at the specified 'startTime'
+    /// and ends now pertaining to the specified 'handle' with the specified
+    /// 'argument'.
+    static void recordComplete(TraceEvent::Value  event,
+                               bsls::Types::Int64 startTime,
+                               ntsa::Handle       handle,
+                               bsl::uint64_t      argument);
+
+    /// Remove all records from the trace buffers of all threads and forget
+    /// the buffers of all threads that have exited. Records concurrently
+    /// recorded by other threads may or may not be removed.
+    static void clear();
+
+    /// Load into the specified 'result' a snapshot of the records retained
+    /// by the trace buffers of all threads, ordered by time.
+    static void load(bsl::vector<TraceRecord>* result);
+
+    /// Write the specified 'records' to the specified 'stream' as a JSON
+    /// object in the Chrome trace event format. Return the 'stream'.
+    static bsl::ostream& exportChromeTrace(
+        bsl::ostream&                   stream,
+        const bsl::vector<TraceRecord>& records);
+
+    /// Return true if tracing is enabled, otherwise return false.
+    static bool isEnabled();
+};
+
+/// @internal @brief
+/// Provide a guard to record the duration of an event.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntcs
+class TracerScope
+{
+    bsls::Types::Int64 d_startTime;
+    TraceEvent::Value  d_event;
+    ntsa::Handle       d_handle;
+    bsl::uint64_t      d_argument;
+
+  private:
+    TracerScope(const TracerScope&) BSLS_KEYWORD_DELETED;
+    TracerScope& operator=(const TracerScope&) BSLS_KEYWORD_DELETED;
+
+  public:
+    /// Begin recording the specified 'event' pertaining to the specified
+    /// 'handle' with the specified 'argument', if tracing is enabled.
+    TracerScope(TraceEvent::Value event,
+                ntsa::Handle      handle,
+                bsl::uint64_t     argument);
+
+    /// Record the event, if tracing was enabled upon construction.
+    ~TracerScope();
+};
+
+/// Record the specified instantaneous 'event' pertaining to the specified
+/// 'handle' with the specified 'argument', if tracing is enabled.
+#define NTCS_TRACE_EVENT(event, handle, argument)                             \
+    do {                                                                      \
+        if (NTCCFG_UNLIKELY(ntcs::Tracer::isEnabled())) {                     \
+            ntcs::Tracer::recordInstant(ntcs::TraceEvent::event,              \
+                                        (handle),                             \
+                                        (argument));                          \
+        }                                                                     \
+    } while (false)
+
+/// Record the specified 'event' pertaining to the specified 'handle' with
+/// the specified 'argument' from this point until the end of the enclosing
+/// scope, if tracing is enabled.
+#define NTCS_TRACE_SCOPE(event, handle, argument)                             \
+    ntcs::TracerScope ntcsTracerScope(ntcs::TraceEvent::event,                \
+                                      (handle),                               \
+                                      (argument))
+
+NTCCFG_INLINE
+void TraceBuffer::push(TraceEvent::Value  event,
+                       bsls::Types::Int64 time,
+                       bsls::Types::Int64 duration,
+                       bsls::Types::Int64 handle,
+                       bsl::uint64_t      argument)
+{
+    const bsl::uint64_t sequence = d_sequence.loadRelaxed();
+
+    Slot& slot = d_slot_p[sequence & d_mask];
+
+    slot.d_stamp.storeRelease(2 * sequence + 1);
+
+    slot.d_time.storeRelease(time);
+    slot.d_duration.storeRelease(duration);
+    slot.d_handle.storeRelease(handle);
+    slot.d_argument.storeRelease(argument);
+    slot.d_event.storeRelease(static_cast<int>(event));
+
+    slot.d_stamp.storeRelease(2 * sequence + 2);
+
+    d_sequence.storeRelease(sequence + 1);
+}
+
+NTCCFG_INLINE
+bool Tracer::isEnabled()
+{
+    return s_enabled.loadRelaxed();
+}
+
+NTCCFG_INLINE
+TracerScope::TracerScope(TraceEvent::Value event,
+                         ntsa::Handle      handle,
+                         bsl::uint64_t     argument)
+: d_startTime(0)
+, d_event(event)
+, d_handle(handle)
+, d_argument(argument)
+{
+    if (NTCCFG_UNLIKELY(Tracer::isEnabled())) {
+        d_startTime = bsls::TimeUtil::getTimer();
+    }
+}
+
+NTCCFG_INLINE
+TracerScope::~TracerScope()
+{
+    if (NTCCFG_UNLIKELY(d_startTime != 0)) {
+        Tracer::recordComplete(d_event, d_startTime, d_handle, d_argument);
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
@@ -0,0 +1,304 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcs_tracer_t_cpp, "$Id$ $CSID$")
+
+#include <ntcs_tracer.h>
+
+#include <bdlf_bind.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+#include <bsls_atomic.h>
+#include <bsl_sstream.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcs {
+
+// Provide tests for 'ntcs::Tracer'.
+class TracerTest
+{
+    // Record the specified 'numEvents' events pertaining to the specified
+    // 'handle'.
+    static void recordEvents(ntsa::Handle handle, bsl::size_t numEvents);
+
+    // Push the specified 'numEvents' records to the specified 'buffer', each
+    // having every field equal to its sequence number, then set the
+    // specified 'done' flag.
+    static void pushEvents(ntcs::TraceBuffer* buffer,
+                           bsl::size_t        numEvents,
+                           bsls::AtomicBool*  done);
+
+    // Return the number of the specified 'records' pertaining to the
+    // specified 'handle'.
+    static bsl::size_t count(const bsl::vector<ntcs::TraceRecord>& records,
+                             ntsa::Handle                          handle);
+
+  public:
+    // Concern: A trace buffer retains the most recent records up to its
+    // capacity, oldest first.
+    static void verifyBuffer();
+
+    // Concern: A trace buffer loaded while its writer overwrites it yields
+    // only records that were not torn by the writer.
+    static void verifyBufferConcurrency();
+
+    // Concern: Events are not recorded while tracing is disabled.
+    static void verifyDisabled();
+
+    // Concern: Events recorded by multiple threads are snapshot together
+    // and ordered by time.
+    static void verifyThreads();
+
+    // Concern: Records are exported in the Chrome trace event format.
+    static void verifyExport();
+};
+
+void TracerTest::recordEvents(ntsa::Handle handle, bsl::size_t numEvents)
+{
+    for (bsl::size_t i = 0; i < numEvents; ++i) {
+        NTCS_TRACE_SCOPE(e_READABLE, handle, i);
+        NTCS_TRACE_EVENT(e_SEND_ENQUEUE, handle, i);
+    }
+}
+
+void TracerTest::pushEvents(ntcs::TraceBuffer* buffer,
+                            bsl::size_t        numEvents,
+                            bsls::AtomicBool*  done)
+{
+    for (bsl::size_t i = 0; i < numEvents; ++i) {
+        const bsls::Types::Int64 value = static_cast<bsls::Types::Int64>(i);
+        buffer->push(ntcs::TraceEvent::e_TIMER, value, value, value, i);
+    }
+
+    done->storeRelease(true);
+}
+
+bsl::size_t TracerTest::count(const bsl::vector<ntcs::TraceRecord>& records,
+                              ntsa::Handle                          handle)
+{
+    bsl::size_t result = 0;
+
+    for (bsl::size_t i = 0; i < records.size(); ++i) {
+        if (records[i].d_handle == static_cast<bsls::Types::Int64>(handle)) {
+            ++result;
+        }
+    }
+
+    return result;
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::TracerTest::verifyBuffer)
+{
+    ntcs::TraceBuffer buffer(1, 5, NTSCFG_TEST_ALLOCATOR);
+
+    NTSCFG_TEST_EQ(buffer.capacity(), 8);
+    NTSCFG_TEST_EQ(buffer.threadId(), 1);
+
+    for (bsl::size_t i = 0; i < 20; ++i) {
+        buffer.push(ntcs::TraceEvent::e_TIMER,
+                    static_cast<bsls::Types::Int64>(i),
+                    -1,
+                    0,
+                    i);
+    }
+
+    bsl::vector<ntcs::TraceRecord> records(NTSCFG_TEST_ALLOCATOR);
+    buffer.load(&records);
+
+    NTSCFG_TEST_EQ(records.size(), 8);
+
+    for (bsl::size_t i = 0; i < records.size(); ++i) {
+        NTSCFG_TEST_EQ(records[i].d_argument, 12 + i);
+        NTSCFG_TEST_EQ(records[i].d_threadId, 1);
+        NTSCFG_TEST_EQ(records[i].d_event, ntcs::TraceEvent::e_TIMER);
+    }
+
+    buffer.clear();
+
+    records.clear();
+    buffer.load(&records);
+
+    NTSCFG_TEST_TRUE(records.empty());
+
+    for (bsl::size_t i = 0; i < 3; ++i) {
+        buffer.push(ntcs::TraceEvent::e_TIMER, 0, -1, 0, 100 + i);
+    }
+
+    records.clear();
+    buffer.load(&records);
+
+    NTSCFG_TEST_EQ(records.size(), 3);
+    NTSCFG_TEST_EQ(records[0].d_argument, 100);
+    NTSCFG_TEST_EQ(records[2].d_argument, 102);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::TracerTest::verifyBufferConcurrency)
+{
+    const bsl::size_t k_NUM_EVENTS = 100000;
+
+    ntcs::TraceBuffer buffer(1, 8, NTSCFG_TEST_ALLOCATOR);
+    bsls::AtomicBool  done(false);
+
+    bslmt::ThreadGroup threadGroup(NTSCFG_TEST_ALLOCATOR);
+
+    threadGroup.addThread(bdlf::BindUtil::bind(&TracerTest::pushEvents,
+                                               &buffer,
+                                               k_NUM_EVENTS,
+                                               &done));
+
+    bsl::vector<ntcs::TraceRecord> records(NTSCFG_TEST_ALLOCATOR);
+
+    bool finished = false;
+    while (!finished) {
+        finished = done.loadAcquire();
+
+        records.clear();
+        buffer.load(&records);
+
+        NTSCFG_TEST_LE(records.size(), buffer.capacity());
+
+        for (bsl::size_t i = 0; i < records.size(); ++i) {
+            const ntcs::TraceRecord& record = records[i];
+
+            NTSCFG_TEST_EQ(record.d_duration, record.d_time);
+            NTSCFG_TEST_EQ(record.d_handle, record.d_time);
+            NTSCFG_TEST_EQ(record.d_argument,
+                           static_cast<bsl::uint64_t>(record.d_time));
+
+            if (i > 0) {
+                NTSCFG_TEST_LT(records[i - 1].d_time, record.d_time);
+            }
+        }
+    }
+
+    threadGroup.joinAll();
+
+    NTSCFG_TEST_EQ(records.size(), buffer.capacity());
+    NTSCFG_TEST_EQ(records.back().d_argument, k_NUM_EVENTS - 1);
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::TracerTest::verifyDisabled)
+{
+    const ntsa::Handle k_HANDLE = 10;
+
+    ntcs::Tracer::disable();
+    ntcs::Tracer::clear();
+
+    NTSCFG_TEST_FALSE(ntcs::Tracer::isEnabled());
+
+    TracerTest::recordEvents(k_HANDLE, 10);
+
+    bsl::vector<ntcs::TraceRecord> records(NTSCFG_TEST_ALLOCATOR);
+    ntcs::Tracer::load(&records);
+
+    NTSCFG_TEST_EQ(count(records, k_HANDLE), 0);
+
+    ntcs::Tracer::enable();
+    TracerTest::recordEvents(k_HANDLE, 10);
+    ntcs::Tracer::disable();
+
+    ntcs::Tracer::load(&records);
+
+    NTSCFG_TEST_EQ(count(records, k_HANDLE), 20);
+
+    ntcs::Tracer::clear();
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::TracerTest::verifyThreads)
+{
+    const bsl::size_t k_NUM_THREADS = 4;
+    const bsl::size_t k_NUM_EVENTS  = 100;
+
+    ntcs::Tracer::clear();
+    ntcs::Tracer::enable();
+
+    bslmt::ThreadGroup threadGroup(NTSCFG_TEST_ALLOCATOR);
+
+    for (bsl::size_t i = 0; i < k_NUM_THREADS; ++i) {
+        threadGroup.addThread(
+            bdlf::BindUtil::bind(&TracerTest::recordEvents,
+                                 static_cast<ntsa::Handle>(100 + i),
+                                 k_NUM_EVENTS));
+    }
+
+    threadGroup.joinAll();
+
+    ntcs::Tracer::disable();
+
+    bsl::vector<ntcs::TraceRecord> records(NTSCFG_TEST_ALLOCATOR);
+    ntcs::Tracer::load(&records);
+
+    for (bsl::size_t i = 0; i < k_NUM_THREADS; ++i) {
+        NTSCFG_TEST_EQ(count(records, static_cast<ntsa::Handle>(100 + i)),
+                       2 * k_NUM_EVENTS);
+    }
+
+    for (bsl::size_t i = 1; i < records.size(); ++i) {
+        NTSCFG_TEST_LE(records[i - 1].d_time, records[i].d_time);
+    }
+
+    ntcs::Tracer::clear();
+
+    ntcs::Tracer::load(&records);
+    NTSCFG_TEST_TRUE(records.empty());
+}
+
+NTSCFG_TEST_FUNCTION(ntcs::TracerTest::verifyExport)
+{
+    bsl::vector<ntcs::TraceRecord> records(NTSCFG_TEST_ALLOCATOR);
+
+    ntcs::TraceRecord record;
+    record.d_time     = 1500;
+    record.d_duration = 2007;
+    record.d_threadId = 7;
+    record.d_handle   = 3;
+    record.d_argument = 64;
+    record.d_event    = ntcs::TraceEvent::e_RECEIVED;
+
+    records.push_back(record);
+
+    record.d_time     = 4000;
+    record.d_duration = -1;
+    record.d_event    = ntcs::TraceEvent::e_SEND_ENQUEUE;
+
+    records.push_back(record);
+
+    bsl::ostringstream ss;
+    ntcs::Tracer::exportChromeTrace(ss, records);
+
+    const bsl::string json = ss.str();
+
+    NTSCFG_TEST_EQ(json.find("{\"traceEvents\":["), 0);
+
+    NTSCFG_TEST_NE(json.find("\"name\":\"RECEIVED\",\"cat\":\"ntc\","
+                             "\"ph\":\"X\",\"ts\":1.500,\"dur\":2.007"),
+                   bsl::string::npos);
+
+    NTSCFG_TEST_NE(json.find("\"name\":\"SEND_ENQUEUE\",\"cat\":\"ntc\","
+                             "\"ph\":\"i\",\"s\":\"t\",\"ts\":4.000"),
+                   bsl::string::npos);
+
+    NTSCFG_TEST_NE(json.find("\"tid\":7,\"args\":{\"handle\":3,"
+                             "\"argument\":64}}"),
+                   bsl::string::npos);
+}
+
+}  // close namespace ntcs
+}  // close namespace BloombergLP
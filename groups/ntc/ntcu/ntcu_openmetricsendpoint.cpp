@@ -0,0 +1,500 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntcu_openmetricsendpoint.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcu_openmetricsendpoint_cpp, "$Id$ $CSID$")
+
+#include <ntca_acceptoptions.h>
+#include <ntca_listenersocketoptions.h>
+#include <ntca_receiveoptions.h>
+#include <ntca_sendoptions.h>
+#include <ntca_timeroptions.h>
+#include <ntci_log.h>
+#include <bdlbb_blobutil.h>
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bsl_cstdio.h>
+#include <bsl_cstring.h>
+
+namespace BloombergLP {
+namespace ntcu {
+
+namespace {
+
+/// The name of the resource exposing the snapshot.
+const char k_RESOURCE[] = "/metrics";
+
+/// The end of the header of an HTTP request.
+const char k_HEADER_END[] = "\r\n\r\n";
+
+/// Return the reason phrase of the specified HTTP 'status'.
+const char* reasonPhrase(int status)
+{
+    switch (status) {
+    case 200:
+        return "OK";
+    case 400:
+        return "Bad Request";
+    case 404:
+        return "Not Found";
+    case 405:
+        return "Method Not Allowed";
+    default:
+        return "Internal Server Error";
+    }
+}
+
+}  // close unnamed namespace
+
+void OpenMetricsEndpoint::accept(
+    const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket)
+{
+    {
+        LockGuard guard(&d_mutex);
+        if (d_listenerSocket_sp != listenerSocket) {
+            return;
+        }
+    }
+
+    ntci::AcceptCallback acceptCallback = listenerSocket->createAcceptCallback(
+        NTCCFG_BIND(&OpenMetricsEndpoint::processAccept,
+                    this->getSelf(this),
+                    listenerSocket,
+                    NTCCFG_BIND_PLACEHOLDER_1,
+                    NTCCFG_BIND_PLACEHOLDER_2,
+                    NTCCFG_BIND_PLACEHOLDER_3),
+        d_allocator_p);
+
+    ntsa::Error error =
+        listenerSocket->accept(ntca::AcceptOptions(), acceptCallback);
+    if (error) {
+        NTCI_LOG_CONTEXT();
+        NTCI_LOG_STREAM_ERROR << "Failed to accept OpenMetrics connection: "
+                              << error << NTCI_LOG_STREAM_END;
+    }
+}
+
+void OpenMetricsEndpoint::acceptAfter(
+    const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket,
+    const bsls::TimeInterval&                    delay)
+{
+    ntca::TimerOptions timerOptions;
+    timerOptions.setOneShot(true);
+    timerOptions.hideEvent(ntca::TimerEventType::e_CANCELED);
+    timerOptions.hideEvent(ntca::TimerEventType::e_CLOSED);
+
+    ntci::TimerCallback timerCallback = listenerSocket->createTimerCallback(
+        NTCCFG_BIND(&OpenMetricsEndpoint::processAcceptTimer,
+                    this->getSelf(this),
+                    listenerSocket,
+                    NTCCFG_BIND_PLACEHOLDER_1,
+                    NTCCFG_BIND_PLACEHOLDER_2),
+        d_allocator_p);
+
+    bsl::shared_ptr<ntci::Timer> timer = listenerSocket->createTimer(
+        timerOptions,
+        timerCallback,
+        d_allocator_p);
+
+    bsl::shared_ptr<ntci::Timer> previousTimer;
+    {
+        LockGuard guard(&d_mutex);
+        if (d_listenerSocket_sp == listenerSocket) {
+            previousTimer.swap(d_acceptTimer_sp);
+            d_acceptTimer_sp = timer;
+        }
+        else {
+            previousTimer = timer;
+            timer.reset();
+        }
+    }
+
+    if (previousTimer) {
+        previousTimer->close();
+    }
+
+    if (timer) {
+        timer->schedule(listenerSocket->currentTime() + delay);
+    }
+}
+
+void OpenMetricsEndpoint::receive(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const bsl::shared_ptr<bsl::string>&        request,
+    const bsls::TimeInterval&                  deadline)
+{
+    ntca::ReceiveOptions receiveOptions;
+    receiveOptions.setMinSize(1);
+    receiveOptions.setMaxSize(k_MAX_REQUEST_SIZE);
+    receiveOptions.setDeadline(deadline);
+
+    ntci::ReceiveCallback receiveCallback =
+        streamSocket->createReceiveCallback(
+            NTCCFG_BIND(&OpenMetricsEndpoint::processReceive,
+                        this->getSelf(this),
+                        streamSocket,
+                        request,
+                        deadline,
+                        NTCCFG_BIND_PLACEHOLDER_1,
+                        NTCCFG_BIND_PLACEHOLDER_2,
+                        NTCCFG_BIND_PLACEHOLDER_3),
+            d_allocator_p);
+
+    ntsa::Error error = streamSocket->receive(receiveOptions, receiveCallback);
+    if (error) {
+        streamSocket->close();
+    }
+}
+
+void OpenMetricsEndpoint::respond(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    int                                        status)
+{
+    bsl::shared_ptr<const bsl::string> body;
+    if (status == 200) {
+        body = d_publisher_sp->snapshot();
+    }
+
+    const char* contentType = body
+                                  ? ntcs::OpenMetricsPublisher::contentType()
+                                  : "text/plain; charset=utf-8";
+
+    const bsl::size_t contentLength = body ? body->size() : 0;
+
+    char header[256];
+    int  headerLength =
+        bsl::snprintf(header,
+                      sizeof header,
+                      "HTTP/1.1 %d %s\r\n"
+                      "Content-Type: %s\r\n"
+                      "Content-Length: %lu\r\n"
+                      "Connection: close\r\n"
+                      "\r\n",
+                      status,
+                      reasonPhrase(status),
+                      contentType,
+                      static_cast<unsigned long>(contentLength));
+
+    if (headerLength <= 0 ||
+        static_cast<bsl::size_t>(headerLength) >= sizeof header)
+    {
+        streamSocket->close();
+        return;
+    }
+
+    bdlbb::Blob response(streamSocket->outgoingBlobBufferFactory().get(),
+                         d_allocator_p);
+
+    bdlbb::BlobUtil::append(&response, header, headerLength);
+
+    if (contentLength > 0) {
+        bdlbb::BlobUtil::append(&response,
+                                body->data(),
+                                static_cast<int>(contentLength));
+    }
+
+    ntci::SendCallback sendCallback = streamSocket->createSendCallback(
+        NTCCFG_BIND(&OpenMetricsEndpoint::processSend,
+                    this->getSelf(this),
+                    streamSocket,
+                    NTCCFG_BIND_PLACEHOLDER_1,
+                    NTCCFG_BIND_PLACEHOLDER_2),
+        d_allocator_p);
+
+    ntsa::Error error =
+        streamSocket->send(response, ntca::SendOptions(), sendCallback);
+    if (error) {
+        streamSocket->close();
+    }
+}
+
+void OpenMetricsEndpoint::processAccept(
+    const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket,
+    const bsl::shared_ptr<ntci::Acceptor>&       acceptor,
+    const bsl::shared_ptr<ntci::StreamSocket>&   streamSocket,
+    const ntca::AcceptEvent&                     event)
+{
+    NTCCFG_WARNING_UNUSED(acceptor);
+
+    if (event.type() != ntca::AcceptEventType::e_COMPLETE) {
+        bsls::TimeInterval delay;
+        if (!OpenMetricsEndpoint::retryAccept(&delay, event)) {
+            // The listener socket has been closed or shut down: stop
+            // accepting connections.
+
+            return;
+        }
+
+        NTCI_LOG_CONTEXT();
+        NTCI_LOG_STREAM_WARN << "Failed to accept OpenMetrics connection: "
+                             << event.context().error()
+                             << NTCI_LOG_STREAM_END;
+
+        if (delay == bsls::TimeInterval()) {
+            this->accept(listenerSocket);
+        }
+        else {
+            this->acceptAfter(listenerSocket, delay);
+        }
+
+        return;
+    }
+
+    bsls::TimeInterval requestTimeout;
+    {
+        LockGuard guard(&d_mutex);
+        requestTimeout = d_requestTimeout;
+    }
+
+    // Bound the time to receive the whole request, not each portion of it,
+    // so that a peer trickling bytes cannot hold the connection open.
+
+    const bsls::TimeInterval deadline =
+        streamSocket->currentTime() + requestTimeout;
+
+    bsl::shared_ptr<bsl::string> request;
+    request.createInplace(d_allocator_p, d_allocator_p);
+
+    this->receive(streamSocket, request, deadline);
+    this->accept(listenerSocket);
+}
+
+void OpenMetricsEndpoint::processAcceptTimer(
+    const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket,
+    const bsl::shared_ptr<ntci::Timer>&          timer,
+    const ntca::TimerEvent&                      event)
+{
+    {
+        LockGuard guard(&d_mutex);
+        if (d_acceptTimer_sp == timer) {
+            d_acceptTimer_sp.reset();
+        }
+    }
+
+    if (event.type() == ntca::TimerEventType::e_DEADLINE) {
+        this->accept(listenerSocket);
+    }
+}
+
+void OpenMetricsEndpoint::processReceive(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const bsl::shared_ptr<bsl::string>&        request,
+    const bsls::TimeInterval&                  deadline,
+    const bsl::shared_ptr<ntci::Receiver>&     receiver,
+    const bsl::shared_ptr<bdlbb::Blob>&        data,
+    const ntca::ReceiveEvent&                  event)
+{
+    NTCCFG_WARNING_UNUSED(receiver);
+
+    if (event.type() != ntca::ReceiveEventType::e_COMPLETE) {
+        // The peer has shut down the connection, the request has not been
+        // received by its deadline, or the socket has failed.
+
+        streamSocket->close();
+        return;
+    }
+
+    const bsl::size_t position = request->size();
+    const bsl::size_t length   = static_cast<bsl::size_t>(data->length());
+
+    request->resize(position + length);
+    bdlbb::BlobUtil::copy(request->data() + position,
+                          *data,
+                          0,
+                          static_cast<int>(length));
+
+    const int status = OpenMetricsEndpoint::parseRequest(*request);
+    if (status != 0) {
+        this->respond(streamSocket, status);
+    }
+    else if (request->size() >= k_MAX_REQUEST_SIZE) {
+        this->respond(streamSocket, 400);
+    }
+    else {
+        this->receive(streamSocket, request, deadline);
+    }
+}
+
+void OpenMetricsEndpoint::processSend(
+    const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+    const bsl::shared_ptr<ntci::Sender>&       sender,
+    const ntca::SendEvent&                     event)
+{
+    NTCCFG_WARNING_UNUSED(sender);
+    NTCCFG_WARNING_UNUSED(event);
+
+    streamSocket->close();
+}
+
+OpenMetricsEndpoint::OpenMetricsEndpoint(
+    const bsl::shared_ptr<ntcs::OpenMetricsPublisher>&  publisher,
+    const bsl::shared_ptr<ntci::ListenerSocketFactory>& factory,
+    bslma::Allocator*                                   basicAllocator)
+: d_mutex()
+, d_publisher_sp(publisher)
+, d_listenerSocketFactory_sp(factory)
+, d_listenerSocket_sp()
+, d_acceptTimer_sp()
+, d_requestTimeout(k_DEFAULT_REQUEST_TIMEOUT, 0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+OpenMetricsEndpoint::~OpenMetricsEndpoint()
+{
+}
+
+ntsa::Error OpenMetricsEndpoint::open(const ntsa::Endpoint& endpoint)
+{
+    ntsa::Error error;
+
+    bsl::shared_ptr<ntci::ListenerSocket> listenerSocket;
+    {
+        LockGuard guard(&d_mutex);
+
+        if (d_listenerSocket_sp) {
+            return ntsa::Error(ntsa::Error::e_INVALID);
+        }
+
+        ntca::ListenerSocketOptions options;
+        options.setTransport(
+            endpoint.transport(ntsa::TransportMode::e_STREAM));
+        options.setSourceEndpoint(endpoint);
+        options.setReuseAddress(true);
+
+        listenerSocket = d_listenerSocketFactory_sp->createListenerSocket(
+            options,
+            d_allocator_p);
+
+        error = listenerSocket->open();
+        if (error) {
+            return error;
+        }
+
+        error = listenerSocket->listen();
+        if (error) {
+            listenerSocket->close();
+            return error;
+        }
+
+        d_listenerSocket_sp = listenerSocket;
+    }
+
+    this->accept(listenerSocket);
+
+    return ntsa::Error();
+}
+
+void OpenMetricsEndpoint::close()
+{
+    bsl::shared_ptr<ntci::ListenerSocket> listenerSocket;
+    bsl::shared_ptr<ntci::Timer>          acceptTimer;
+    {
+        LockGuard guard(&d_mutex);
+        listenerSocket.swap(d_listenerSocket_sp);
+        acceptTimer.swap(d_acceptTimer_sp);
+    }
+
+    if (acceptTimer) {
+        acceptTimer->close();
+    }
+
+    if (listenerSocket) {
+        listenerSocket->close();
+    }
+}
+
+void OpenMetricsEndpoint::setRequestTimeout(const bsls::TimeInterval& value)
+{
+    LockGuard guard(&d_mutex);
+    d_requestTimeout = value;
+}
+
+ntsa::Endpoint OpenMetricsEndpoint::sourceEndpoint() const
+{
+    LockGuard guard(&d_mutex);
+
+    if (d_listenerSocket_sp) {
+        return d_listenerSocket_sp->sourceEndpoint();
+    }
+
+    return ntsa::Endpoint();
+}
+
+bsls::TimeInterval OpenMetricsEndpoint::requestTimeout() const
+{
+    LockGuard guard(&d_mutex);
+    return d_requestTimeout;
+}
+
+int OpenMetricsEndpoint::parseRequest(const bsl::string& request)
+{
+    const bsl::size_t headerEnd = request.find(k_HEADER_END);
+    if (headerEnd == bsl::string::npos) {
+        return 0;
+    }
+
+    const bsl::size_t lineEnd = request.find("\r\n");
+
+    const char k_METHOD[] = "GET ";
+    if (request.compare(0, sizeof k_METHOD - 1, k_METHOD) != 0) {
+        return 405;
+    }
+
+    const bsl::size_t targetBegin = sizeof k_METHOD - 1;
+    bsl::size_t       targetEnd   = request.find(' ', targetBegin);
+    if (targetEnd == bsl::string::npos || targetEnd > lineEnd) {
+        targetEnd = lineEnd;
+    }
+
+    const bsl::size_t query = request.find('?', targetBegin);
+    if (query != bsl::string::npos && query < targetEnd) {
+        targetEnd = query;
+    }
+
+    if (request.compare(targetBegin,
+                        targetEnd - targetBegin,
+                        k_RESOURCE,
+                        sizeof k_RESOURCE - 1) != 0)
+    {
+        return 404;
+    }
+
+    return 200;
+}
+
+bool OpenMetricsEndpoint::retryAccept(bsls::TimeInterval*      result,
+                                      const ntca::AcceptEvent& event)
+{
+    const ntsa::Error error = event.context().error();
+
+    if (error == ntsa::Error::e_CANCELLED || error == ntsa::Error::e_EOF) {
+        return false;
+    }
+
+    if (error == ntsa::Error::e_LIMIT) {
+        result->setTotalMilliseconds(k_ACCEPT_RETRY_DELAY);
+    }
+    else {
+        *result = bsls::TimeInterval();
+    }
+
+    return true;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
@@ -0,0 +1,226 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTCU_OPENMETRICSENDPOINT
+#define INCLUDED_NTCU_OPENMETRICSENDPOINT
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntca_acceptevent.h>
+#include <ntca_receiveevent.h>
+#include <ntca_sendevent.h>
+#include <ntca_timerevent.h>
+#include <ntccfg_platform.h>
+#include <ntci_listenersocket.h>
+#include <ntci_listenersocketfactory.h>
+#include <ntci_streamsocket.h>
+#include <ntci_timer.h>
+#include <ntcs_openmetrics.h>
+#include <ntcscm_version.h>
+#include <ntsa_endpoint.h>
+#include <ntsa_error.h>
+#include <bdlbb_blob.h>
+#include <bsls_timeinterval.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+
+namespace BloombergLP {
+namespace ntcu {
+
+/// @internal @brief
+/// Provide a minimal HTTP endpoint exposing an OpenMetrics snapshot.
+///
+/// @details
+/// Provide a mechanism that listens on a listener socket and answers each HTTP
+/// request for "GET /metrics" with the most recent snapshot assembled by an
+/// 'ntcs::OpenMetricsPublisher', closing each connection after its response is
+/// sent. Each connection whose request is not completely received within the
+/// request timeout is closed without a response. A failure to accept a
+/// connection is logged and the next connection is accepted, after a short
+/// delay if the limit of open files has been reached, until the listener
+/// socket is closed or shut down. The snapshot is assembled
+/// when statistics are collected, not when they are requested, so answering a
+/// request only copies the snapshot text into the response.
+///
+/// This endpoint is intended to be scraped by a Prometheus or other
+/// OpenMetrics-compatible collector on a trusted network: it does not
+/// support persistent connections, request bodies, or TLS.
+///
+/// @par Usage Example
+/// This example shows how to expose the statistics of the monitorable
+/// objects registered with the default monitorable object registry.
+///
+///     bsl::shared_ptr<ntcs::OpenMetricsPublisher> publisher;
+///     publisher.createInplace(allocator, allocator);
+///
+///     ntcf::System::registerMonitorablePublisher(publisher);
+///
+///     bsl::shared_ptr<ntcu::OpenMetricsEndpoint> endpoint;
+///     endpoint.createInplace(allocator, publisher, interface, allocator);
+///
+///     ntsa::Error error = endpoint->open(
+///         ntsa::Endpoint(ntsa::IpEndpoint(ntsa::Ipv4Address::any(), 9100)));
+///
+/// @par Thread Safety
+/// This class is thread safe.
+///
+/// @ingroup module_ntcu
+class OpenMetricsEndpoint : public ntccfg::Shared<OpenMetricsEndpoint>
+{
+    /// Define a type alias for a mutex.
+    typedef ntccfg::Mutex Mutex;
+
+    /// Define a type alias for a mutex lock guard.
+    typedef ntccfg::LockGuard LockGuard;
+
+    mutable Mutex                                d_mutex;
+    bsl::shared_ptr<ntcs::OpenMetricsPublisher>  d_publisher_sp;
+    bsl::shared_ptr<ntci::ListenerSocketFactory> d_listenerSocketFactory_sp;
+    bsl::shared_ptr<ntci::ListenerSocket>        d_listenerSocket_sp;
+    bsl::shared_ptr<ntci::Timer>                 d_acceptTimer_sp;
+    bsls::TimeInterval                           d_requestTimeout;
+    bslma::Allocator*                            d_allocator_p;
+
+  private:
+    OpenMetricsEndpoint(const OpenMetricsEndpoint&) BSLS_KEYWORD_DELETED;
+    OpenMetricsEndpoint& operator=(const OpenMetricsEndpoint&)
+        BSLS_KEYWORD_DELETED;
+
+  private:
+    /// Accept the next connection from the specified 'listenerSocket', if
+    /// it is still the listener socket of this object.
+    void accept(const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket);
+
+    /// Accept the next connection from the specified 'listenerSocket' after
+    /// the specified 'delay'.
+    void acceptAfter(
+        const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket,
+        const bsls::TimeInterval&                    delay);
+
+    /// Receive the next portion of the request from the specified
+    /// 'streamSocket' into the specified 'request' by the specified
+    /// 'deadline'.
+    void receive(const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+                 const bsl::shared_ptr<bsl::string>&        request,
+                 const bsls::TimeInterval&                  deadline);
+
+    /// Send the response to the request having the specified 'status' to
+    /// the specified 'streamSocket'.
+    void respond(const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+                 int                                        status);
+
+    /// Process the acceptance of the specified 'streamSocket' by the
+    /// specified 'acceptor' according to the specified 'event' from the
+    /// specified 'listenerSocket'.
+    void processAccept(
+        const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket,
+        const bsl::shared_ptr<ntci::Acceptor>&       acceptor,
+        const bsl::shared_ptr<ntci::StreamSocket>&   streamSocket,
+        const ntca::AcceptEvent&                     event);
+
+    /// Process the specified 'event' of the specified 'timer' delaying the
+    /// acceptance of the next connection from the specified
+    /// 'listenerSocket'.
+    void processAcceptTimer(
+        const bsl::shared_ptr<ntci::ListenerSocket>& listenerSocket,
+        const bsl::shared_ptr<ntci::Timer>&          timer,
+        const ntca::TimerEvent&                      event);
+
+    /// Process the reception of the specified 'data' by the specified
+    /// 'receiver' according to the specified 'event' as the next portion
+    /// of the specified 'request' from the specified 'streamSocket', which
+    /// must be completely received by the specified 'deadline'.
+    void processReceive(
+        const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+        const bsl::shared_ptr<bsl::string>&        request,
+        const bsls::TimeInterval&                  deadline,
+        const bsl::shared_ptr<ntci::Receiver>&     receiver,
+        const bsl::shared_ptr<bdlbb::Blob>&        data,
+        const ntca::ReceiveEvent&                  event);
+
+    /// Process the completion of the transmission of the response by the
+    /// specified 'sender' according to the specified 'event' to the
+    /// specified 'streamSocket'.
+    void processSend(const bsl::shared_ptr<ntci::StreamSocket>& streamSocket,
+                     const bsl::shared_ptr<ntci::Sender>&       sender,
+                     const ntca::SendEvent&                     event);
+
+  public:
+    /// Enumerate the constants used by this class.
+    enum Constant {
+        /// The maximum size of a request, in bytes.
+        k_MAX_REQUEST_SIZE = 8192,
+
+        /// The default maximum time to receive a request, in seconds.
+        k_DEFAULT_REQUEST_TIMEOUT = 10,
+
+        /// The delay before accepting the next connection after the limit
+        /// of open files has been reached, in milliseconds.
+        k_ACCEPT_RETRY_DELAY = 100
+    };
+
+    /// Create a new endpoint exposing the snapshots assembled by the
+    /// specified 'publisher' through listener sockets created by the
+    /// specified 'factory'. Optionally specify a
+    /// 'basicAllocator' used to supply memory. If 'basicAllocator' is 0,
+    /// the currently installed default allocator is used.
+    OpenMetricsEndpoint(
+        const bsl::shared_ptr<ntcs::OpenMetricsPublisher>&  publisher,
+        const bsl::shared_ptr<ntci::ListenerSocketFactory>& factory,
+        bslma::Allocator*                                   basicAllocator = 0);
+
+    /// Destroy this object.
+    ~OpenMetricsEndpoint();
+
+    /// Listen for HTTP requests at the specified 'endpoint'. Return the
+    /// error.
+    ntsa::Error open(const ntsa::Endpoint& endpoint);
+
+    /// Stop listening for HTTP requests. Responses already in progress are
+    /// unaffected.
+    void close();
+
+    /// Set the maximum time to receive each request, measured from the
+    /// acceptance of its connection, to the specified 'value'. The new
+    /// value applies to connections accepted after this call. The default
+    /// value is 'k_DEFAULT_REQUEST_TIMEOUT' seconds.
+    void setRequestTimeout(const bsls::TimeInterval& value);
+
+    /// Return the endpoint at which this object listens for HTTP requests,
+    /// or the default value if this object is not open.
+    ntsa::Endpoint sourceEndpoint() const;
+
+    /// Return the maximum time to receive each request.
+    bsls::TimeInterval requestTimeout() const;
+
+    /// Return the HTTP status of the response to the specified 'request':
+    /// 200 if the 'request' is for the OpenMetrics snapshot, 404 if the
+    /// 'request' is for any other resource, 405 if the 'request' does not
+    /// use the GET method, or 0 if the 'request' is not yet complete.
+    static int parseRequest(const bsl::string& request);
+
+    /// Load into the specified 'result' the delay before accepting the next
+    /// connection after the failure described by the specified accept
+    /// 'event'. Return true if the next connection should be accepted, or
+    /// false if the failure indicates the listener socket has been closed
+    /// or shut down.
+    static bool retryAccept(bsls::TimeInterval*      result,
+                            const ntca::AcceptEvent& event);
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
@@ -0,0 +1,121 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntcu_openmetricsendpoint_t_cpp, "$Id$ $CSID$")
+
+#include <ntcu_openmetricsendpoint.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntcu {
+
+// Provide tests for 'ntcu::OpenMetricsEndpoint'.
+class OpenMetricsEndpointTest
+{
+  public:
+    // Concern: Requests are classified only once their header is complete,
+    // and only a GET of the metrics resource is answered with the snapshot.
+    static void verifyParseRequest();
+
+    // Concern: Connections continue to be accepted after an accept error,
+    // after a delay if the limit of open files has been reached, unless the
+    // error indicates the listener socket has been closed or shut down.
+    static void verifyRetryAccept();
+
+  private:
+    // Return an accept event describing the specified 'error'.
+    static ntca::AcceptEvent acceptError(ntsa::Error::Code error);
+};
+
+ntca::AcceptEvent OpenMetricsEndpointTest::acceptError(
+    ntsa::Error::Code error)
+{
+    ntca::AcceptContext acceptContext;
+    acceptContext.setError(ntsa::Error(error));
+
+    ntca::AcceptEvent acceptEvent;
+    acceptEvent.setType(ntca::AcceptEventType::e_ERROR);
+    acceptEvent.setContext(acceptContext);
+
+    return acceptEvent;
+}
+
+NTSCFG_TEST_FUNCTION(ntcu::OpenMetricsEndpointTest::verifyParseRequest)
+{
+    NTSCFG_TEST_EQ(OpenMetricsEndpoint::parseRequest(""), 0);
+
+    NTSCFG_TEST_EQ(
+        OpenMetricsEndpoint::parseRequest("GET /metrics HTTP/1.1\r\n"), 0);
+
+    NTSCFG_TEST_EQ(OpenMetricsEndpoint::parseRequest(
+                       "GET /metrics HTTP/1.1\r\nHost: x\r\n\r\n"),
+                   200);
+
+    NTSCFG_TEST_EQ(OpenMetricsEndpoint::parseRequest(
+                       "GET /metrics?name=x HTTP/1.1\r\n\r\n"),
+                   200);
+
+    NTSCFG_TEST_EQ(OpenMetricsEndpoint::parseRequest(
+                       "GET /metricsx HTTP/1.1\r\n\r\n"),
+                   404);
+
+    NTSCFG_TEST_EQ(
+        OpenMetricsEndpoint::parseRequest("GET / HTTP/1.1\r\n\r\n"), 404);
+
+    NTSCFG_TEST_EQ(OpenMetricsEndpoint::parseRequest(
+                       "POST /metrics HTTP/1.1\r\n\r\n"),
+                   405);
+}
+
+NTSCFG_TEST_FUNCTION(ntcu::OpenMetricsEndpointTest::verifyRetryAccept)
+{
+    bsls::TimeInterval delay(1, 0);
+    bool               retry = false;
+
+    retry = OpenMetricsEndpoint::retryAccept(
+        &delay,
+        acceptError(ntsa::Error::e_CONNECTION_RESET));
+    NTSCFG_TEST_TRUE(retry);
+    NTSCFG_TEST_EQ(delay, bsls::TimeInterval());
+
+    retry = OpenMetricsEndpoint::retryAccept(
+        &delay,
+        acceptError(ntsa::Error::e_WOULD_BLOCK));
+    NTSCFG_TEST_TRUE(retry);
+    NTSCFG_TEST_EQ(delay, bsls::TimeInterval());
+
+    retry = OpenMetricsEndpoint::retryAccept(
+        &delay,
+        acceptError(ntsa::Error::e_LIMIT));
+    NTSCFG_TEST_TRUE(retry);
+    NTSCFG_TEST_EQ(delay.totalMilliseconds(),
+                   OpenMetricsEndpoint::k_ACCEPT_RETRY_DELAY);
+
+    retry = OpenMetricsEndpoint::retryAccept(
+        &delay,
+        acceptError(ntsa::Error::e_CANCELLED));
+    NTSCFG_TEST_FALSE(retry);
+
+    retry = OpenMetricsEndpoint::retryAccept(&delay,
+                                             acceptError(ntsa::Error::e_EOF));
+    NTSCFG_TEST_FALSE(retry);
+}
+
+}  // close namespace ntcu
+}  // close namespace BloombergLP
@@ -0,0 +1,125 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntsa_tcpinfo.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntsa_tcpinfo_cpp, "$Id$ $CSID$")
+
+#include <bslim_printer.h>
+
+namespace BloombergLP {
+namespace ntsa {
+
+bool TcpInfo::equals(const TcpInfo& other) const
+{
+    return d_roundTripTime == other.d_roundTripTime &&
+           d_roundTripTimeVariance == other.d_roundTripTimeVariance &&
+           d_congestionWindow == other.d_congestionWindow &&
+           d_maxSegmentSize == other.d_maxSegmentSize &&
+           d_unacknowledgedBytes == other.d_unacknowledgedBytes &&
+           d_retransmissions == other.d_retransmissions &&
+           d_deliveryRate == other.d_deliveryRate &&
+           d_pacingRate == other.d_pacingRate;
+}
+
+bool TcpInfo::less(const TcpInfo& other) const
+{
+    if (d_roundTripTime < other.d_roundTripTime) {
+        return true;
+    }
+
+    if (other.d_roundTripTime < d_roundTripTime) {
+        return false;
+    }
+
+    if (d_roundTripTimeVariance < other.d_roundTripTimeVariance) {
+        return true;
+    }
+
+    if (other.d_roundTripTimeVariance < d_roundTripTimeVariance) {
+        return false;
+    }
+
+    if (d_congestionWindow < other.d_congestionWindow) {
+        return true;
+    }
+
+    if (other.d_congestionWindow < d_congestionWindow) {
+        return false;
+    }
+
+    if (d_maxSegmentSize < other.d_maxSegmentSize) {
+        return true;
+    }
+
+    if (other.d_maxSegmentSize < d_maxSegmentSize) {
+        return false;
+    }
+
+    if (d_unacknowledgedBytes < other.d_unacknowledgedBytes) {
+        return true;
+    }
+
+    if (other.d_unacknowledgedBytes < d_unacknowledgedBytes) {
+        return false;
+    }
+
+    if (d_retransmissions < other.d_retransmissions) {
+        return true;
+    }
+
+    if (other.d_retransmissions < d_retransmissions) {
+        return false;
+    }
+
+    if (d_deliveryRate < other.d_deliveryRate) {
+        return true;
+    }
+
+    if (other.d_deliveryRate < d_deliveryRate) {
+        return false;
+    }
+
+    return d_pacingRate < other.d_pacingRate;
+}
+
+bsl::ostream& TcpInfo::print(bsl::ostream& stream,
+                             int           level,
+                             int           spacesPerLevel) const
+{
+    bslim::Printer printer(&stream, level, spacesPerLevel);
+    printer.start();
+    printer.printAttribute("roundTripTime", d_roundTripTime);
+    printer.printAttribute("roundTripTimeVariance", d_roundTripTimeVariance);
+    printer.printAttribute("congestionWindow", d_congestionWindow);
+    printer.printAttribute("maxSegmentSize", d_maxSegmentSize);
+    printer.printAttribute("unacknowledgedBytes", d_unacknowledgedBytes);
+    printer.printAttribute("retransmissions", d_retransmissions);
+
+    if (d_deliveryRate.has_value()) {
+        printer.printAttribute("deliveryRate", d_deliveryRate.value());
+    }
+
+    if (d_pacingRate.has_value()) {
+        printer.printAttribute("pacingRate", d_pacingRate.value());
+    }
+
+    printer.end();
+    return stream;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
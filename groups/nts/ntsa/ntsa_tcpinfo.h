@@ -0,0 +1,418 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_NTSA_TCPINFO
+#define INCLUDED_NTSA_TCPINFO
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+#include <ntscfg_platform.h>
+#include <ntsscm_version.h>
+#include <bdlb_nullablevalue.h>
+#include <bslh_hash.h>
+#include <bsls_timeinterval.h>
+#include <bsl_iosfwd.h>
+
+namespace BloombergLP {
+namespace ntsa {
+
+/// Provide a sample of the state of a TCP connection in the operating system.
+///
+/// @details
+/// Provide a value-semantic type that describes the state of the congestion
+/// control and loss recovery of a TCP connection, as sampled from the
+/// operating system at a moment in time.
+///
+/// @par Attributes
+/// This class is composed of the following attributes.
+///
+/// @li @b roundTripTime:
+/// The smoothed round trip time estimated by the sender.
+///
+/// @li @b roundTripTimeVariance:
+/// The variance of the smoothed round trip time estimated by the sender.
+///
+/// @li @b congestionWindow:
+/// The size of the congestion window, in segments.
+///
+/// @li @b maxSegmentSize:
+/// The maximum size of each segment sent, in bytes.
+///
+/// @li @b unacknowledgedBytes:
+/// The number of bytes sent but not yet acknowledged by the peer.
+///
+/// @li @b retransmissions:
+/// The total number of segments retransmitted during the lifetime of the
+/// connection.
+///
+/// @li @b deliveryRate:
+/// The most recent estimate of the rate at which data is delivered to the
+/// peer, in bytes per second, if known.
+///
+/// @li @b pacingRate:
+/// The rate at which the sender paces the transmission of segments, in bytes
+/// per second, if pacing is enabled and known.
+///
+/// @par Thread Safety
+/// This class is not thread safe.
+///
+/// @ingroup module_ntsa_system
+class TcpInfo
+{
+    bsls::TimeInterval                 d_roundTripTime;
+    bsls::TimeInterval                 d_roundTripTimeVariance;
+    bsl::uint32_t                      d_congestionWindow;
+    bsl::uint32_t                      d_maxSegmentSize;
+    bsl::uint64_t                      d_unacknowledgedBytes;
+    bsl::uint64_t                      d_retransmissions;
+    bdlb::NullableValue<bsl::uint64_t> d_deliveryRate;
+    bdlb::NullableValue<bsl::uint64_t> d_pacingRate;
+
+  public:
+    /// Create a new TCP connection sample.
+    TcpInfo();
+
+    /// Create a new TCP connection sample having the same value as the
+    /// specified 'original' object.
+    TcpInfo(const TcpInfo& original);
+
+    /// Destroy this object.
+    ~TcpInfo();
+
+    /// Assign the value of the specified 'other' object to this object.
+    /// Return a reference to this modifiable object.
+    TcpInfo& operator=(const TcpInfo& other);
+
+    /// Reset the value of this object to its value upon default
+    /// construction.
+    void reset();
+
+    /// Set the smoothed round trip time to the specified 'value'.
+    void setRoundTripTime(const bsls::TimeInterval& value);
+
+    /// Set the variance of the smoothed round trip time to the specified
+    /// 'value'.
+    void setRoundTripTimeVariance(const bsls::TimeInterval& value);
+
+    /// Set the size of the congestion window, in segments, to the specified
+    /// 'value'.
+    void setCongestionWindow(bsl::uint32_t value);
+
+    /// Set the maximum segment size to the specified 'value'.
+    void setMaxSegmentSize(bsl::uint32_t value);
+
+    /// Set the number of bytes sent but not yet acknowledged to the
+    /// specified 'value'.
+    void setUnacknowledgedBytes(bsl::uint64_t value);
+
+    /// Set the total number of segments retransmitted to the specified
+    /// 'value'.
+    void setRetransmissions(bsl::uint64_t value);
+
+    /// Set the delivery rate, in bytes per second, to the specified 'value'.
+    void setDeliveryRate(bsl::uint64_t value);
+
+    /// Set the pacing rate, in bytes per second, to the specified 'value'.
+    void setPacingRate(bsl::uint64_t value);
+
+    /// Return the smoothed round trip time.
+    const bsls::TimeInterval& roundTripTime() const;
+
+    /// Return the variance of the smoothed round trip time.
+    const bsls::TimeInterval& roundTripTimeVariance() const;
+
+    /// Return the size of the congestion window, in segments.
+    bsl::uint32_t congestionWindow() const;
+
+    /// Return the maximum segment size.
+    bsl::uint32_t maxSegmentSize() const;
+
+    /// Return the number of bytes sent but not yet acknowledged.
+    bsl::uint64_t unacknowledgedBytes() const;
+
+    /// Return the total number of segments retransmitted.
+    bsl::uint64_t retransmissions() const;
+
+    /// Return the delivery rate, in bytes per second, if known.
+    const bdlb::NullableValue<bsl::uint64_t>& deliveryRate() const;
+
+    /// Return the pacing rate, in bytes per second, if known.
+    const bdlb::NullableValue<bsl::uint64_t>& pacingRate() const;
+
+    /// Return true if this object has the same value as the specified
+    /// 'other' object, otherwise return false.
+    bool equals(const TcpInfo& other) const;
+
+    /// Return true if the value of this object is less than the value of
+    /// the specified 'other' object, otherwise return false.
+    bool less(const TcpInfo& other) const;
+
+    /// Format this object to the specified output 'stream' at the
+    /// optionally specified indentation 'level' and return a reference to
+    /// the modifiable 'stream'.  If 'level' is specified, optionally
+    /// specify 'spacesPerLevel', the number of spaces per indentation level
+    /// for this and all of its nested objects.  Each line is indented by
+    /// the absolute value of 'level * spacesPerLevel'.  If 'level' is
+    /// negative, suppress indentation of the first line.  If
+    /// 'spacesPerLevel' is negative, suppress line breaks and format the
+    /// entire output on one line.  If 'stream' is initially invalid, this
+    /// operation has no effect.  Note that a trailing newline is provided
+    /// in multiline mode only.
+    bsl::ostream& print(bsl::ostream& stream,
+                        int           level          = 0,
+                        int           spacesPerLevel = 4) const;
+
+    /// This type's copy-constructor and copy-assignment operator is equivalent
+    /// to copying each byte of the source object's footprint to each
+    /// corresponding byte of the destination object's footprint.
+    NTSCFG_TYPE_TRAIT_BITWISE_COPYABLE(TcpInfo);
+
+    /// This type's move-constructor and move-assignment operator is equivalent
+    /// to copying each byte of the source object's footprint to each
+    /// corresponding byte of the destination object's footprint.
+    NTSCFG_TYPE_TRAIT_BITWISE_MOVABLE(TcpInfo);
+};
+
+/// Write the specified 'object' to the specified 'stream'. Return
+/// a modifiable reference to the 'stream'.
+///
+/// @related ntsa::TcpInfo
+bsl::ostream& operator<<(bsl::ostream& stream, const TcpInfo& object);
+
+/// Return true if the specified 'lhs' has the same value as the specified
+/// 'rhs', otherwise return false.
+///
+/// @related ntsa::TcpInfo
+bool operator==(const TcpInfo& lhs, const TcpInfo& rhs);
+
+/// Return true if the specified 'lhs' does not have the same value as the
+/// specified 'rhs', otherwise return false.
+///
+/// @related ntsa::TcpInfo
+bool operator!=(const TcpInfo& lhs, const TcpInfo& rhs);
+
+/// Return true if the value of the specified 'lhs' is less than the value
+/// of the specified 'rhs', otherwise return false.
+///
+/// @related ntsa::TcpInfo
+bool operator<(const TcpInfo& lhs, const TcpInfo& rhs);
+
+/// Contribute the values of the salient attributes of the specified 'value'
+/// to the specified hash 'algorithm'.
+///
+/// @related ntsa::TcpInfo
+template <typename HASH_ALGORITHM>
+void hashAppend(HASH_ALGORITHM& algorithm, const TcpInfo& value);
+
+NTSCFG_INLINE
+TcpInfo::TcpInfo()
+: d_roundTripTime()
+, d_roundTripTimeVariance()
+, d_congestionWindow(0)
+, d_maxSegmentSize(0)
+, d_unacknowledgedBytes(0)
+, d_retransmissions(0)
+, d_deliveryRate()
+, d_pacingRate()
+{
+}
+
+NTSCFG_INLINE
+TcpInfo::TcpInfo(const TcpInfo& original)
+: d_roundTripTime(original.d_roundTripTime)
+, d_roundTripTimeVariance(original.d_roundTripTimeVariance)
+, d_congestionWindow(original.d_congestionWindow)
+, d_maxSegmentSize(original.d_maxSegmentSize)
+, d_unacknowledgedBytes(original.d_unacknowledgedBytes)
+, d_retransmissions(original.d_retransmissions)
+, d_deliveryRate(original.d_deliveryRate)
+, d_pacingRate(original.d_pacingRate)
+{
+}
+
+NTSCFG_INLINE
+TcpInfo::~TcpInfo()
+{
+}
+
+NTSCFG_INLINE
+TcpInfo& TcpInfo::operator=(const TcpInfo& other)
+{
+    if (this != &other) {
+        d_roundTripTime         = other.d_roundTripTime;
+        d_roundTripTimeVariance = other.d_roundTripTimeVariance;
+        d_congestionWindow      = other.d_congestionWindow;
+        d_maxSegmentSize        = other.d_maxSegmentSize;
+        d_unacknowledgedBytes   = other.d_unacknowledgedBytes;
+        d_retransmissions       = other.d_retransmissions;
+        d_deliveryRate          = other.d_deliveryRate;
+        d_pacingRate            = other.d_pacingRate;
+    }
+
+    return *this;
+}
+
+NTSCFG_INLINE
+void TcpInfo::reset()
+{
+    d_roundTripTime         = bsls::TimeInterval();
+    d_roundTripTimeVariance = bsls::TimeInterval();
+    d_congestionWindow      = 0;
+    d_maxSegmentSize        = 0;
+    d_unacknowledgedBytes   = 0;
+    d_retransmissions       = 0;
+    d_deliveryRate.reset();
+    d_pacingRate.reset();
+}
+
+NTSCFG_INLINE
+void TcpInfo::setRoundTripTime(const bsls::TimeInterval& value)
+{
+    d_roundTripTime = value;
+}
+
+NTSCFG_INLINE
+void TcpInfo::setRoundTripTimeVariance(const bsls::TimeInterval& value)
+{
+    d_roundTripTimeVariance = value;
+}
+
+NTSCFG_INLINE
+void TcpInfo::setCongestionWindow(bsl::uint32_t value)
+{
+    d_congestionWindow = value;
+}
+
+NTSCFG_INLINE
+void TcpInfo::setMaxSegmentSize(bsl::uint32_t value)
+{
+    d_maxSegmentSize = value;
+}
+
+NTSCFG_INLINE
+void TcpInfo::setUnacknowledgedBytes(bsl::uint64_t value)
+{
+    d_unacknowledgedBytes = value;
+}
+
+NTSCFG_INLINE
+void TcpInfo::setRetransmissions(bsl::uint64_t value)
+{
+    d_retransmissions = value;
+}
+
+NTSCFG_INLINE
+void TcpInfo::setDeliveryRate(bsl::uint64_t value)
+{
+    d_deliveryRate = value;
+}
+
+NTSCFG_INLINE
+void TcpInfo::setPacingRate(bsl::uint64_t value)
+{
+    d_pacingRate = value;
+}
+
+NTSCFG_INLINE
+const bsls::TimeInterval& TcpInfo::roundTripTime() const
+{
+    return d_roundTripTime;
+}
+
+NTSCFG_INLINE
+const bsls::TimeInterval& TcpInfo::roundTripTimeVariance() const
+{
+    return d_roundTripTimeVariance;
+}
+
+NTSCFG_INLINE
+bsl::uint32_t TcpInfo::congestionWindow() const
+{
+    return d_congestionWindow;
+}
+
+NTSCFG_INLINE
+bsl::uint32_t TcpInfo::maxSegmentSize() const
+{
+    return d_maxSegmentSize;
+}
+
+NTSCFG_INLINE
+bsl::uint64_t TcpInfo::unacknowledgedBytes() const
+{
+    return d_unacknowledgedBytes;
+}
+
+NTSCFG_INLINE
+bsl::uint64_t TcpInfo::retransmissions() const
+{
+    return d_retransmissions;
+}
+
+NTSCFG_INLINE
+const bdlb::NullableValue<bsl::uint64_t>& TcpInfo::deliveryRate() const
+{
+    return d_deliveryRate;
+}
+
+NTSCFG_INLINE
+const bdlb::NullableValue<bsl::uint64_t>& TcpInfo::pacingRate() const
+{
+    return d_pacingRate;
+}
+
+NTSCFG_INLINE
+bsl::ostream& operator<<(bsl::ostream& stream, const TcpInfo& object)
+{
+    return object.print(stream, 0, -1);
+}
+
+NTSCFG_INLINE
+bool operator==(const TcpInfo& lhs, const TcpInfo& rhs)
+{
+    return lhs.equals(rhs);
+}
+
+NTSCFG_INLINE
+bool operator!=(const TcpInfo& lhs, const TcpInfo& rhs)
+{
+    return !operator==(lhs, rhs);
+}
+
+NTSCFG_INLINE
+bool operator<(const TcpInfo& lhs, const TcpInfo& rhs)
+{
+    return lhs.less(rhs);
+}
+
+template <typename HASH_ALGORITHM>
+void hashAppend(HASH_ALGORITHM& algorithm, const TcpInfo& value)
+{
+    using bslh::hashAppend;
+
+    hashAppend(algorithm, value.roundTripTime());
+    hashAppend(algorithm, value.roundTripTimeVariance());
+    hashAppend(algorithm, value.congestionWindow());
+    hashAppend(algorithm, value.maxSegmentSize());
+    hashAppend(algorithm, value.unacknowledgedBytes());
+    hashAppend(algorithm, value.retransmissions());
+    hashAppend(algorithm, value.deliveryRate());
+    hashAppend(algorithm, value.pacingRate());
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+#endif
@@ -0,0 +1,122 @@
+// Copyright 2020-2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ntscfg_test.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ntsa_tcpinfo_t_cpp, "$Id$ $CSID$")
+
+#include <ntsa_tcpinfo.h>
+
+using namespace BloombergLP;
+
+namespace BloombergLP {
+namespace ntsa {
+
+// Provide tests for 'ntsa::TcpInfo'.
+class TcpInfoTest
+{
+  public:
+    // Test value semantics: default constructor.
+    static void verifyDefaultConstructor();
+
+    // Test value semantics: copy constructor, assignment and equality.
+    static void verifyCopy();
+
+    // Test value semantics: resetting.
+    static void verifyReset();
+
+    // Test value semantics: ordering.
+    static void verifyLess();
+};
+
+NTSCFG_TEST_FUNCTION(ntsa::TcpInfoTest::verifyDefaultConstructor)
+{
+    ntsa::TcpInfo tcpInfo;
+
+    NTSCFG_TEST_EQ(tcpInfo.roundTripTime(), bsls::TimeInterval());
+    NTSCFG_TEST_EQ(tcpInfo.roundTripTimeVariance(), bsls::TimeInterval());
+    NTSCFG_TEST_EQ(tcpInfo.congestionWindow(), 0);
+    NTSCFG_TEST_EQ(tcpInfo.maxSegmentSize(), 0);
+    NTSCFG_TEST_EQ(tcpInfo.unacknowledgedBytes(), 0);
+    NTSCFG_TEST_EQ(tcpInfo.retransmissions(), 0);
+    NTSCFG_TEST_FALSE(tcpInfo.deliveryRate().has_value());
+    NTSCFG_TEST_FALSE(tcpInfo.pacingRate().has_value());
+}
+
+NTSCFG_TEST_FUNCTION(ntsa::TcpInfoTest::verifyCopy)
+{
+    ntsa::TcpInfo tcpInfo;
+    tcpInfo.setRoundTripTime(bsls::TimeInterval(0, 250000));
+    tcpInfo.setRoundTripTimeVariance(bsls::TimeInterval(0, 50000));
+    tcpInfo.setCongestionWindow(10);
+    tcpInfo.setMaxSegmentSize(1448);
+    tcpInfo.setUnacknowledgedBytes(2896);
+    tcpInfo.setRetransmissions(3);
+    tcpInfo.setDeliveryRate(1000000);
+    tcpInfo.setPacingRate(2000000);
+
+    ntsa::TcpInfo copy(tcpInfo);
+    NTSCFG_TEST_EQ(copy, tcpInfo);
+
+    ntsa::TcpInfo assigned;
+    NTSCFG_TEST_NE(assigned, tcpInfo);
+
+    assigned = tcpInfo;
+    NTSCFG_TEST_EQ(assigned, tcpInfo);
+
+    NTSCFG_TEST_EQ(assigned.roundTripTime(), bsls::TimeInterval(0, 250000));
+    NTSCFG_TEST_EQ(assigned.roundTripTimeVariance(),
+                   bsls::TimeInterval(0, 50000));
+    NTSCFG_TEST_EQ(assigned.congestionWindow(), 10);
+    NTSCFG_TEST_EQ(assigned.maxSegmentSize(), 1448);
+    NTSCFG_TEST_EQ(assigned.unacknowledgedBytes(), 2896);
+    NTSCFG_TEST_EQ(assigned.retransmissions(), 3);
+    NTSCFG_TEST_EQ(assigned.deliveryRate().value(), 1000000);
+    NTSCFG_TEST_EQ(assigned.pacingRate().value(), 2000000);
+}
+
+NTSCFG_TEST_FUNCTION(ntsa::TcpInfoTest::verifyReset)
+{
+    ntsa::TcpInfo tcpInfo;
+    tcpInfo.setRoundTripTime(bsls::TimeInterval(0, 250000));
+    tcpInfo.setCongestionWindow(10);
+    tcpInfo.setDeliveryRate(1000000);
+
+    tcpInfo.reset();
+
+    NTSCFG_TEST_EQ(tcpInfo, ntsa::TcpInfo());
+}
+
+NTSCFG_TEST_FUNCTION(ntsa::TcpInfoTest::verifyLess)
+{
+    ntsa::TcpInfo lhs;
+    lhs.setRoundTripTime(bsls::TimeInterval(0, 100));
+
+    ntsa::TcpInfo rhs;
+    rhs.setRoundTripTime(bsls::TimeInterval(0, 200));
+
+    NTSCFG_TEST_TRUE(lhs < rhs);
+    NTSCFG_TEST_FALSE(rhs < lhs);
+
+    rhs = lhs;
+    rhs.setPacingRate(1);
+
+    NTSCFG_TEST_TRUE(lhs < rhs);
+    NTSCFG_TEST_FALSE(lhs < lhs);
+}
+
+}  // close namespace ntsa
+}  // close namespace BloombergLP
@@ -26,6 +26,7 @@ BSLS_IDENT_RCSID(ntsu_socketoptionutil_cpp, "$Id$ $CSID$")
 #include <bsls_assert.h>
 #include <bsls_log.h>
 #include <bsls_platform.h>
+#include <bsl_cstddef.h>
 #include <bsl_cstdlib.h>
 #include <bsl_cstring.h>
 
@@ -1386,6 +1387,85 @@ ntsa::Error SocketOptionUtil::getTcpCongestionControl(
 #endif
 }
 
+ntsa::Error SocketOptionUtil::getTcpInfo(ntsa::TcpInfo* tcpInfo,
+                                         ntsa::Handle   socket)
+{
+    tcpInfo->reset();
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+
+    // The C library declares only the leading fields of 'struct tcp_info'.
+    // Kernels since 4.9 append the pacing and delivery rates after them, so
+    // request the extended layout and use the returned length to detect
+    // which of the trailing fields the kernel filled in.
+
+    struct TcpInfoExtended {
+        struct tcp_info d_base;
+        bsl::uint64_t   d_pacingRate;
+        bsl::uint64_t   d_maxPacingRate;
+        bsl::uint64_t   d_bytesAcked;
+        bsl::uint64_t   d_bytesReceived;
+        bsl::uint32_t   d_segmentsOut;
+        bsl::uint32_t   d_segmentsIn;
+        bsl::uint32_t   d_notSentBytes;
+        bsl::uint32_t   d_minRtt;
+        bsl::uint32_t   d_dataSegmentsIn;
+        bsl::uint32_t   d_dataSegmentsOut;
+        bsl::uint64_t   d_deliveryRate;
+    };
+
+    TcpInfoExtended optionValue;
+    bsl::memset(&optionValue, 0, sizeof optionValue);
+
+    socklen_t optionLength = static_cast<socklen_t>(sizeof optionValue);
+
+    const int rc =
+        getsockopt(socket, IPPROTO_TCP, TCP_INFO, &optionValue, &optionLength);
+    if (rc != 0) {
+        return ntsa::Error(errno);
+    }
+
+    const struct tcp_info& base = optionValue.d_base;
+
+    bsls::TimeInterval roundTripTime;
+    roundTripTime.addMicroseconds(base.tcpi_rtt);
+
+    bsls::TimeInterval roundTripTimeVariance;
+    roundTripTimeVariance.addMicroseconds(base.tcpi_rttvar);
+
+    tcpInfo->setRoundTripTime(roundTripTime);
+    tcpInfo->setRoundTripTimeVariance(roundTripTimeVariance);
+    tcpInfo->setCongestionWindow(base.tcpi_snd_cwnd);
+    tcpInfo->setMaxSegmentSize(base.tcpi_snd_mss);
+    tcpInfo->setUnacknowledgedBytes(
+        static_cast<bsl::uint64_t>(base.tcpi_unacked) * base.tcpi_snd_mss);
+    tcpInfo->setRetransmissions(base.tcpi_total_retrans);
+
+    const bsl::size_t length = static_cast<bsl::size_t>(optionLength);
+
+    // The kernel reports an unlimited pacing rate as all bits set.
+
+    if (length >= offsetof(TcpInfoExtended, d_maxPacingRate)) {
+        if (optionValue.d_pacingRate != ~static_cast<bsl::uint64_t>(0)) {
+            tcpInfo->setPacingRate(optionValue.d_pacingRate);
+        }
+    }
+
+    if (length >= sizeof optionValue) {
+        tcpInfo->setDeliveryRate(optionValue.d_deliveryRate);
+    }
+
+    return ntsa::Error();
+
+#else
+
+    NTSCFG_WARNING_UNUSED(socket);
+
+    return ntsa::Error(ntsa::Error::e_NOT_IMPLEMENTED);
+
+#endif
+}
+
 ntsa::Error SocketOptionUtil::getSendBufferRemaining(bsl::size_t* size,
                                                      ntsa::Handle socket)
 {
@@ -24,6 +24,7 @@ BSLS_IDENT("$Id: $")
 #include <ntsa_handle.h>
 #include <ntsa_socketconfig.h>
 #include <ntsa_socketoption.h>
+#include <ntsa_tcpinfo.h>
 #include <ntscfg_platform.h>
 #include <ntsscm_version.h>
 #include <bsls_timeinterval.h>
@@ -268,6 +269,13 @@ class SocketOptionUtil
         ntsa::TcpCongestionControl* algorithm,
         ntsa::Handle                socket);
 
+    /// Load into the specified 'tcpInfo' a sample of the round trip time,
+    /// congestion window, retransmissions, and delivery and pacing rates of
+    /// the specified TCP 'socket'. Return the error. Note that this
+    /// function is currently only implemented on Linux.
+    static ntsa::Error getTcpInfo(ntsa::TcpInfo* tcpInfo,
+                                  ntsa::Handle   socket);
+
     /// Load into the specified 'size' the option for the specified 'socket'
     /// that indicates the amount of space left in the send buffer. Return
     /// the error.
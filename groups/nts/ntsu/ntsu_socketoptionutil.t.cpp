@@ -71,6 +71,9 @@ class SocketOptionUtilTest
 
     // TODO
     static void verifyCase9();
+
+    // Concern: getTcpInfo samples the state of a connected TCP socket.
+    static void verifyCase10();
 };
 
 // Undefine to test all socket types.
@@ -2325,5 +2328,49 @@ NTSCFG_TEST_FUNCTION(ntsu::SocketOptionUtilTest::verifyCase9)
     NTSCFG_TEST_EQ(ta.numBlocksInUse(), 0);
 }
 
+NTSCFG_TEST_FUNCTION(ntsu::SocketOptionUtilTest::verifyCase10)
+{
+    // Concern: getTcpInfo samples the state of a connected TCP socket.
+
+    ntscfg::TestAllocator ta;
+    {
+        if (!ntsu::AdapterUtil::supportsIpv4Loopback()) {
+            return;
+        }
+
+        ntsa::Error error;
+
+        ntsa::Handle client = ntsa::k_INVALID_HANDLE;
+        ntsa::Handle server = ntsa::k_INVALID_HANDLE;
+
+        error = ntsu::SocketUtil::pair(&client,
+                                       &server,
+                                       ntsa::Transport::e_TCP_IPV4_STREAM);
+        NTSCFG_TEST_OK(error);
+
+        ntsa::TcpInfo tcpInfo;
+        error = ntsu::SocketOptionUtil::getTcpInfo(&tcpInfo, client);
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+        NTSCFG_TEST_OK(error);
+
+        NTSCFG_TEST_LOG_DEBUG << "TCP info: " << tcpInfo
+                              << NTSCFG_TEST_LOG_END;
+
+        NTSCFG_TEST_GT(tcpInfo.congestionWindow(), 0);
+        NTSCFG_TEST_GT(tcpInfo.maxSegmentSize(), 0);
+#else
+        NTSCFG_TEST_ERROR(error, ntsa::Error::e_NOT_IMPLEMENTED);
+#endif
+
+        error = ntsu::SocketUtil::close(client);
+        NTSCFG_TEST_OK(error);
+
+        error = ntsu::SocketUtil::close(server);
+        NTSCFG_TEST_OK(error);
+    }
+    NTSCFG_TEST_EQ(ta.numBlocksInUse(), 0);
+}
+
 }  // close namespace ntsu
 }  // close namespace BloombergLP
@@ -186,6 +186,7 @@ if (${NTF_BUILD_WITH_NTS})
     ntf_component(NAME ntsa_socketstate)
     ntf_component(NAME ntsa_tcpcongestioncontrol)
     ntf_component(NAME ntsa_tcpcongestioncontrolalgorithm)
+    ntf_component(NAME ntsa_tcpinfo)
     ntf_component(NAME ntsa_temporary)
     ntf_component(NAME ntsa_transport)
     ntf_component(NAME ntsa_timestamp)
@@ -718,14 +719,17 @@ if (${NTF_BUILD_WITH_NTC})
     ntf_component(NAME ntcs_global)
     ntf_component(NAME ntcs_globalallocator)
     ntf_component(NAME ntcs_globalexecutor)
+    ntf_component(NAME ntcs_happyeyeballs)
     ntf_component(NAME ntcs_interactable)
     ntf_component(NAME ntcs_interest)
     ntf_component(NAME ntcs_leakybucket)
+    ntf_component(NAME ntcs_loopprofiler)
     ntf_component(NAME ntcs_memorymap)
     ntf_component(NAME ntcs_metrics)
     ntf_component(NAME ntcs_monitorable)
     ntf_component(NAME ntcs_nomenclature)
     ntf_component(NAME ntcs_observer)
+    ntf_component(NAME ntcs_openmetrics)
     ntf_component(NAME ntcs_openstate)
     ntf_component(NAME ntcs_plugin)
     ntf_component(NAME ntcs_proactordetachcontext)
@@ -735,13 +739,20 @@ if (${NTF_BUILD_WITH_NTC})
     ntf_component(NAME ntcs_processstatistics)
     ntf_component(NAME ntcs_ratelimiter)
     ntf_component(NAME ntcs_reactormetrics)
+    ntf_component(NAME ntcs_recyclingallocator)
     ntf_component(NAME ntcs_registry)
     ntf_component(NAME ntcs_reservation)
     ntf_component(NAME ntcs_shutdowncontext)
     ntf_component(NAME ntcs_shutdownstate)
     ntf_component(NAME ntcs_skiplist)
+    ntf_component(NAME ntcs_socketpool)
+    ntf_component(NAME ntcs_stalldetector)
     ntf_component(NAME ntcs_strand)
+    ntf_component(NAME ntcs_tcpinfosampler)
+    ntf_component(NAME ntcs_threadmetrics)
+    ntf_component(NAME ntcs_threadstatistics)
     ntf_component(NAME ntcs_threadutil)
+    ntf_component(NAME ntcs_tracer)
     ntf_component(NAME ntcs_watermarks)
     ntf_component(NAME ntcs_watermarkutil)
     ntf_component(NAME ntcs_user)
@@ -818,6 +829,7 @@ if (${NTF_BUILD_WITH_NTC})
     ntf_component(NAME ntcdns_client)
     ntf_component(NAME ntcdns_compat)
     ntf_component(NAME ntcdns_database)
+    ntf_component(NAME ntcdns_endpointcache)
     ntf_component(NAME ntcdns_protocol)
     ntf_component(NAME ntcdns_resolver)
     ntf_component(NAME ntcdns_server)
@@ -889,6 +901,7 @@ if (${NTF_BUILD_WITH_NTC})
     ntf_component(NAME ntcu_listenersocketsession)
     ntf_component(NAME ntcu_listenersocketeventqueue)
     ntf_component(NAME ntcu_listenersocketutil)
+    ntf_component(NAME ntcu_openmetricsendpoint)
     ntf_component(NAME ntcu_streamsocketsession)
     ntf_component(NAME ntcu_streamsocketeventqueue)
     ntf_component(NAME ntcu_streamsocketutil)
@@ -1027,7 +1040,7 @@ if (${NTF_BUILD_WITH_USAGE_EXAMPLES})
     endif()
 
     if (${NTF_BUILD_WITH_NTC})
-        foreach (suffix 01;02;03;04;05;06;07;08;09;10;11;12;13;14)
+        foreach (suffix 01;02;03;04;05;06;07;08;09;10;11;12;13;14;15;16;17;18)
             ntf_executable(
                 NAME
                     ntcu${suffix}